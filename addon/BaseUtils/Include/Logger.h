@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <string>
 #include <ostream>
+#include <memory>
 #include "BaseUtilsCommon.h"
 
 namespace Logger
@@ -53,4 +54,31 @@ namespace Logger
     BASEUTILS_API std::ostream& Log(Level l);
 
     BASEUTILS_API ALogger* GetLogger(const std::string& name);
+
+    struct LogSink
+    {
+        using Holder = std::shared_ptr<LogSink>;
+        virtual ~LogSink() {}
+        virtual void Write(const char* data, size_t size) = 0;
+        virtual void Flush() = 0;
+    };
+
+    BASEUTILS_API LogSink::Holder CreateStdoutLogSink();
+    // 'path' is renamed to 'path.1', 'path.1' to 'path.2' and so on when it grows over 'maxFileSize'
+    BASEUTILS_API LogSink::Holder CreateRotatingFileLogSink(const std::string& path, uint64_t maxFileSize = 16*1024*1024, uint32_t maxBackupCount = 5);
+
+    enum OverflowPolicy
+    {
+        DROP_WHEN_FULL = 0,
+        BLOCK_WHEN_FULL,
+    };
+
+    // In async mode each thread pushes its log records into its own lock-free ring buffer, a background
+    // thread formats them, adds the prefix and writes them to 'sink' in batches. 'sink' defaults to stdout.
+    // Log(l, fmt, ...) only copies the arguments, the '%s' strings included. With BLOCK_WHEN_FULL a thread
+    // whose ring is full sleeps until the background thread has drained it.
+    BASEUTILS_API bool StartAsyncLogging(LogSink::Holder sink = nullptr, uint32_t ringBufferSize = 256*1024, OverflowPolicy policy = DROP_WHEN_FULL);
+    BASEUTILS_API void StopAsyncLogging();
+    BASEUTILS_API void FlushAsyncLogging();
+    BASEUTILS_API uint64_t GetDroppedLogCount();
 }
\ No newline at end of file
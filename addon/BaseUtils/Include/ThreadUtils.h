@@ -20,7 +20,11 @@
 #include <string>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <memory>
+#include <functional>
+#include <list>
+#include <vector>
 #include "BaseUtilsCommon.h"
 #include "Logger.h"
 
@@ -41,6 +45,13 @@ struct AsyncTask
         CANCELLED = 4,
     };
 
+    enum Priority
+    {
+        LOW = 0,
+        NORMAL = 1,
+        HIGH = 2,
+    };
+
     virtual bool operator() () = 0;
     virtual bool SetState(State eState, bool bForce = false) = 0;
     virtual State GetState() const = 0;
@@ -53,6 +64,10 @@ struct AsyncTask
     virtual bool Cancel() = 0;
     virtual void WaitDone() = 0;
     virtual bool WaitState(State eState, int64_t u64TimeOut = 0) = 0;
+    virtual Priority GetPriority() const { return NORMAL; }
+    // 'callback' is invoked once the task is stopped, or right away if it's already stopped.
+    // Return false if the task can not notify, such task can not be used as a dependency.
+    virtual bool AddStoppedCallback(std::function<void()>) { return false; }
 };
 
 class BaseAsyncTask : public AsyncTask
@@ -60,27 +75,27 @@ class BaseAsyncTask : public AsyncTask
 public:
     bool operator() () override
     {
-        m_bRunning = true;
+        _SetRunning(true);
         if (!_BeforeTaskProc())
         {
             SetState(FAILED);
-            m_bRunning = false;
+            _SetRunning(false);
             return false;
         }
         if (!_TaskProc())
         {
             SetState(FAILED);
-            m_bRunning = false;
+            _SetRunning(false);
             return false;
         }
         if (!_AfterTaskProc())
         {
             SetState(FAILED);
-            m_bRunning = false;
+            _SetRunning(false);
             return false;
         }
         SetState(DONE);
-        m_bRunning = false;
+        _SetRunning(false);
         return true;
     }
 
@@ -102,16 +117,27 @@ public:
     { return (IsDone() || IsFailed() || IsCancelled()) && !m_bRunning; }
     void WaitDone() override;
     bool WaitState(State eState, int64_t i64TimeOut = 0) override;
+    Priority GetPriority() const override
+    { return m_ePriority; }
+    void SetPriority(Priority ePriority)
+    { m_ePriority = ePriority; }
+    bool AddStoppedCallback(std::function<void()> callback) override;
 
 protected:
     virtual bool _BeforeTaskProc() { return true; }
     virtual bool _TaskProc() = 0;
     virtual bool _AfterTaskProc() { return true; }
+    void _SetRunning(bool bRunning);
+    void _NotifyStateChanged(std::unique_lock<std::mutex>& lk);
 
 protected:
     std::mutex m_mtxLock;
+    std::condition_variable m_cvState;
     State m_eState{WAITING};
+    Priority m_ePriority{NORMAL};
     bool m_bRunning{false};
+    bool m_bStopNotified{false};
+    std::list<std::function<void()>> m_aStoppedCallbacks;
 };
 
 struct ThreadPoolExecutor
@@ -122,6 +148,8 @@ struct ThreadPoolExecutor
     static Holder CreateInstance(const std::string& name);
 
     virtual bool EnqueueTask(AsyncTask::Holder hTask, bool bNonblock = false) = 0;
+    // 'hTask' is queued after all the dependencies are done, it's cancelled if any of them fails or is cancelled
+    virtual bool EnqueueTaskAfter(AsyncTask::Holder hTask, const std::vector<AsyncTask::Holder>& aDependencies) = 0;
     virtual void SetMaxWaitingTaskCount(uint32_t cnt) = 0;
     virtual uint32_t GetWaitingTaskCount() const = 0;
     virtual void SetMaxThreadCount(uint32_t cnt) = 0;
@@ -28,6 +28,12 @@
 #include <mutex>
 #include <atomic>
 #include <thread>
+#include <condition_variable>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
 #ifdef _WIN32
 #include <Windows.h>
 #endif
@@ -75,6 +81,764 @@ namespace Logger
     NullBuffer NULL_BUFFER;
     ostream NULL_STREAM(&NULL_BUFFER);
 
+    class StdoutLogSink : public LogSink
+    {
+    public:
+        void Write(const char* data, size_t size) override
+        {
+            cout.write(data, size);
+        }
+
+        void Flush() override
+        {
+            cout.flush();
+        }
+    };
+
+    class RotatingFileLogSink : public LogSink
+    {
+    public:
+        RotatingFileLogSink(const string& path, uint64_t maxFileSize, uint32_t maxBackupCount)
+            : m_path(path), m_maxFileSize(maxFileSize), m_maxBackupCount(maxBackupCount)
+        {
+            Open();
+        }
+
+        ~RotatingFileLogSink()
+        {
+            if (m_fp)
+                fclose(m_fp);
+        }
+
+        void Write(const char* data, size_t size) override
+        {
+            if (m_maxFileSize > 0 && m_fileSize > 0 && m_fileSize+size > m_maxFileSize)
+                Rotate();
+            if (!m_fp)
+                return;
+            m_fileSize += fwrite(data, 1, size, m_fp);
+        }
+
+        void Flush() override
+        {
+            if (m_fp)
+                fflush(m_fp);
+        }
+
+    private:
+        void Open()
+        {
+            m_fp = fopen(m_path.c_str(), "ab");
+            m_fileSize = 0;
+            if (m_fp)
+            {
+                fseek(m_fp, 0, SEEK_END);
+                long pos = ftell(m_fp);
+                m_fileSize = pos > 0 ? (uint64_t)pos : 0;
+            }
+        }
+
+        void Rotate()
+        {
+            if (m_fp)
+            {
+                fclose(m_fp);
+                m_fp = nullptr;
+            }
+            if (m_maxBackupCount > 0)
+            {
+                remove((m_path+"."+to_string(m_maxBackupCount)).c_str());
+                for (uint32_t i = m_maxBackupCount-1; i > 0; i--)
+                    rename((m_path+"."+to_string(i)).c_str(), (m_path+"."+to_string(i+1)).c_str());
+                rename(m_path.c_str(), (m_path+".1").c_str());
+            }
+            else
+            {
+                remove(m_path.c_str());
+            }
+            Open();
+        }
+
+    private:
+        string m_path;
+        uint64_t m_maxFileSize;
+        uint32_t m_maxBackupCount;
+        FILE* m_fp{nullptr};
+        uint64_t m_fileSize{0};
+    };
+
+    LogSink::Holder CreateStdoutLogSink()
+    {
+        return LogSink::Holder(new StdoutLogSink());
+    }
+
+    LogSink::Holder CreateRotatingFileLogSink(const string& path, uint64_t maxFileSize, uint32_t maxBackupCount)
+    {
+        return LogSink::Holder(new RotatingFileLogSink(path, maxFileSize, maxBackupCount));
+    }
+
+    // prefix flags
+    enum
+    {
+        PREFIX_SHOW_TIME        = 0x1,
+        PREFIX_SHOW_LEVEL_NAME  = 0x2,
+        PREFIX_SHOW_LOGGER_NAME = 0x4,
+    };
+
+    static void AppendLogPrefix(string& out, int64_t timeUs, Level l, const char* name, size_t nameSize, uint8_t flags)
+    {
+        bool empty = true;
+        if (flags&PREFIX_SHOW_TIME)
+        {
+            // localtime() is only called once per second
+            static thread_local time_t lastSec = -1;
+            static thread_local char secBuf[16];
+            time_t t = (time_t)(timeUs/1000000);
+            if (t != lastSec)
+            {
+                struct tm tmBuf = *localtime(&t);
+                strftime(secBuf, sizeof(secBuf), "%H:%M:%S", &tmBuf);
+                lastSec = t;
+            }
+            char msBuf[8];
+            snprintf(msBuf, sizeof(msBuf), ".%03d ", (int)(timeUs/1000%1000));
+            out.append(secBuf);
+            out.append(msBuf);
+            empty = false;
+        }
+        if (flags&PREFIX_SHOW_LEVEL_NAME)
+        {
+            out.append("[");
+            out.append(LEVEL_NAME.at(l));
+            out.append("]");
+            empty = false;
+        }
+        if (flags&PREFIX_SHOW_LOGGER_NAME)
+        {
+            out.append("[");
+            out.append(name, nameSize);
+            out.append("]");
+            empty = false;
+        }
+        if (!empty) out.append(" ");
+    }
+
+    // Deferred formatting: the caller copies the format string and its arguments into the record and the writer
+    // thread formats them. Both sides parse the printf conversions the same way.
+    enum
+    {
+        LENGTH_NONE = 0,
+        LENGTH_HH,
+        LENGTH_H,
+        LENGTH_L,
+        LENGTH_LL,
+        LENGTH_LONG_DOUBLE,
+        LENGTH_J,
+        LENGTH_Z,
+        LENGTH_T,
+    };
+
+    struct FormatSpec
+    {
+        const char* end;        // after the conversion character
+        const char* flags;
+        int flagsSize;
+        int width;              // -1 if not given, -2 for '*'
+        int precision;          // -1 if not given, -2 for '*'
+        int length;
+        char conv;
+    };
+
+    // 'p' points to the '%', false for the conversions which can't be deferred
+    static bool ParseFormatSpec(const char* p, FormatSpec& spec)
+    {
+        p++;
+        spec.flags = p;
+        while (*p && strchr("-+ #0'", *p)) p++;
+        spec.flagsSize = (int)(p-spec.flags);
+        spec.width = spec.precision = -1;
+        if (*p == '*')
+        {
+            spec.width = -2;
+            p++;
+        }
+        else if (*p >= '0' && *p <= '9')
+        {
+            for (spec.width = 0; *p >= '0' && *p <= '9'; p++)
+                spec.width = spec.width*10+(*p-'0');
+            // positional arguments
+            if (*p == '$')
+                return false;
+        }
+        if (*p == '.')
+        {
+            p++;
+            if (*p == '*')
+            {
+                spec.precision = -2;
+                p++;
+            }
+            else
+            {
+                for (spec.precision = 0; *p >= '0' && *p <= '9'; p++)
+                    spec.precision = spec.precision*10+(*p-'0');
+            }
+        }
+        spec.length = LENGTH_NONE;
+        switch (*p)
+        {
+        case 'h': spec.length = p[1] == 'h' ? LENGTH_HH : LENGTH_H; p += p[1] == 'h' ? 2 : 1; break;
+        case 'l': spec.length = p[1] == 'l' ? LENGTH_LL : LENGTH_L; p += p[1] == 'l' ? 2 : 1; break;
+        case 'L': spec.length = LENGTH_LONG_DOUBLE; p++; break;
+        case 'j': spec.length = LENGTH_J; p++; break;
+        case 'z': spec.length = LENGTH_Z; p++; break;
+        case 't': spec.length = LENGTH_T; p++; break;
+        }
+        spec.conv = *p;
+        spec.end = p+1;
+        switch (spec.conv)
+        {
+        case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+            return spec.length != LENGTH_LONG_DOUBLE;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            return spec.length == LENGTH_NONE || spec.length == LENGTH_L || spec.length == LENGTH_LONG_DOUBLE;
+        case 'c': case 's': case 'p':
+            // no wide characters
+            return spec.length == LENGTH_NONE;
+        default:
+            // '%n' and the unknown conversions
+            return false;
+        }
+    }
+
+    template<typename T>
+    static void AppendArg(vector<char>& out, const T& v)
+    {
+        const size_t pos = out.size();
+        out.resize(pos+sizeof(T));
+        memcpy(out.data()+pos, &v, sizeof(T));
+    }
+
+    template<typename T>
+    static T ReadArg(const char*& p)
+    {
+        T v;
+        memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return v;
+    }
+
+    // the integers are truncated to their argument type here and printed with 'll' by the writer
+    static int64_t ReadSignedArg(va_list* ap, int length)
+    {
+        switch (length)
+        {
+        case LENGTH_HH: return (signed char)va_arg(*ap, int);
+        case LENGTH_H: return (short)va_arg(*ap, int);
+        case LENGTH_L: return va_arg(*ap, long);
+        case LENGTH_LL: return va_arg(*ap, long long);
+        case LENGTH_J: return va_arg(*ap, intmax_t);
+        case LENGTH_Z: return (make_signed<size_t>::type)va_arg(*ap, size_t);
+        case LENGTH_T: return va_arg(*ap, ptrdiff_t);
+        default: return va_arg(*ap, int);
+        }
+    }
+
+    static uint64_t ReadUnsignedArg(va_list* ap, int length)
+    {
+        switch (length)
+        {
+        case LENGTH_HH: return (unsigned char)va_arg(*ap, unsigned int);
+        case LENGTH_H: return (unsigned short)va_arg(*ap, unsigned int);
+        case LENGTH_L: return va_arg(*ap, unsigned long);
+        case LENGTH_LL: return va_arg(*ap, unsigned long long);
+        case LENGTH_J: return va_arg(*ap, uintmax_t);
+        case LENGTH_Z: return va_arg(*ap, size_t);
+        case LENGTH_T: return (make_unsigned<ptrdiff_t>::type)va_arg(*ap, ptrdiff_t);
+        default: return va_arg(*ap, unsigned int);
+        }
+    }
+
+    // 'out' gets 'fmt' with its terminating zero followed by the arguments, strings are copied as a 32 bits size,
+    // the characters and a zero. Return false if a conversion can't be deferred.
+    static bool SerializeFormatArgs(vector<char>& out, const char* fmt, va_list* ap)
+    {
+        out.assign(fmt, fmt+strlen(fmt)+1);
+        for (const char* p = strchr(fmt, '%'); p; p = strchr(p, '%'))
+        {
+            if (p[1] == '%')
+            {
+                p += 2;
+                continue;
+            }
+            FormatSpec spec;
+            if (!ParseFormatSpec(p, spec))
+                return false;
+            if (spec.width == -2)
+                AppendArg<int64_t>(out, va_arg(*ap, int));
+            int precision = spec.precision;
+            if (precision == -2)
+            {
+                precision = va_arg(*ap, int);
+                AppendArg<int64_t>(out, precision);
+            }
+            switch (spec.conv)
+            {
+            case 'd': case 'i': case 'c':
+                AppendArg<int64_t>(out, ReadSignedArg(ap, spec.length));
+                break;
+            case 'o': case 'u': case 'x': case 'X':
+                AppendArg<uint64_t>(out, ReadUnsignedArg(ap, spec.length));
+                break;
+            case 's':
+            {
+                const char* str = va_arg(*ap, const char*);
+                if (!str)
+                    str = "(null)";
+                const uint32_t size = (uint32_t)(precision >= 0 ? strnlen(str, precision) : strlen(str));
+                AppendArg<uint32_t>(out, size);
+                out.insert(out.end(), str, str+size);
+                out.push_back(0);
+                break;
+            }
+            case 'p':
+                AppendArg<const void*>(out, va_arg(*ap, const void*));
+                break;
+            default:
+                if (spec.length == LENGTH_LONG_DOUBLE)
+                    AppendArg<long double>(out, va_arg(*ap, long double));
+                else
+                    AppendArg<double>(out, va_arg(*ap, double));
+                break;
+            }
+            p = spec.end;
+        }
+        return true;
+    }
+
+    template<typename T>
+    static void AppendFormatted(string& out, const char* conv, T v)
+    {
+        char buf[128];
+        const int size = snprintf(buf, sizeof(buf), conv, v);
+        if (size < 0)
+            return;
+        if (size < (int)sizeof(buf))
+        {
+            out.append(buf, size);
+            return;
+        }
+        const size_t pos = out.size();
+        out.resize(pos+size+1);
+        snprintf(&out[pos], size+1, conv, v);
+        out.resize(pos+size);
+    }
+
+    // format a record serialized by SerializeFormatArgs()
+    static void AppendDeferredFormat(string& out, const char* data)
+    {
+        const char* fmt = data;
+        const char* arg = fmt+strlen(fmt)+1;
+        const char* p = fmt;
+        while (const char* q = strchr(p, '%'))
+        {
+            out.append(p, q-p);
+            if (q[1] == '%')
+            {
+                out.push_back('%');
+                p = q+2;
+                continue;
+            }
+            FormatSpec spec;
+            ParseFormatSpec(q, spec);
+            int width = spec.width == -2 ? (int)ReadArg<int64_t>(arg) : spec.width;
+            int precision = spec.precision == -2 ? (int)ReadArg<int64_t>(arg) : spec.precision;
+            // the conversion with the stored argument type, the '*' replaced by their values
+            char conv[64];
+            int size = snprintf(conv, sizeof(conv), "%%%.*s", min(spec.flagsSize, 16), spec.flags);
+            if (spec.width == -2 && width < 0)
+            {
+                conv[size++] = '-';
+                width = -width;
+            }
+            if (width >= 0)
+                size += snprintf(conv+size, sizeof(conv)-size, "%d", width);
+            if (precision >= 0)
+                size += snprintf(conv+size, sizeof(conv)-size, ".%d", precision);
+            switch (spec.conv)
+            {
+            case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+                snprintf(conv+size, sizeof(conv)-size, "ll%c", spec.conv);
+                if (spec.conv == 'd' || spec.conv == 'i')
+                    AppendFormatted(out, conv, (long long)ReadArg<int64_t>(arg));
+                else
+                    AppendFormatted(out, conv, (unsigned long long)ReadArg<uint64_t>(arg));
+                break;
+            case 'c':
+                snprintf(conv+size, sizeof(conv)-size, "c");
+                AppendFormatted(out, conv, (int)ReadArg<int64_t>(arg));
+                break;
+            case 's':
+            {
+                const uint32_t strSize = ReadArg<uint32_t>(arg);
+                snprintf(conv+size, sizeof(conv)-size, "s");
+                AppendFormatted(out, conv, arg);
+                arg += strSize+1;
+                break;
+            }
+            case 'p':
+                snprintf(conv+size, sizeof(conv)-size, "p");
+                AppendFormatted(out, conv, ReadArg<const void*>(arg));
+                break;
+            default:
+                if (spec.length == LENGTH_LONG_DOUBLE)
+                {
+                    snprintf(conv+size, sizeof(conv)-size, "L%c", spec.conv);
+                    AppendFormatted(out, conv, ReadArg<long double>(arg));
+                }
+                else
+                {
+                    snprintf(conv+size, sizeof(conv)-size, "%c", spec.conv);
+                    AppendFormatted(out, conv, ReadArg<double>(arg));
+                }
+                break;
+            }
+            p = spec.end;
+        }
+        out.append(p);
+    }
+
+    // Single producer single consumer ring of variable size records, a record never wraps around,
+    // the tail space is skipped with a padding record instead.
+    struct LogRecordHeader
+    {
+        uint32_t size;          // whole record size, aligned to 8 bytes
+        uint32_t textSize;      // PADDING_RECORD for the padding record
+        int64_t timeUs;
+        uint16_t nameSize;
+        uint8_t level;
+        uint8_t flags;
+    };
+    static const uint32_t PADDING_RECORD = UINT32_MAX;
+    // record flag besides the prefix flags, the text is serialized by SerializeFormatArgs()
+    static const uint8_t RECORD_DEFERRED_FORMAT = 0x80;
+
+    struct LogRing
+    {
+        LogRing(uint32_t size, uint32_t gen) : buffer(size), capacity(size), generation(gen) {}
+
+        vector<char> buffer;
+        const uint32_t capacity;
+        const uint32_t generation;
+        alignas(64) atomic<uint64_t> head{0};
+        alignas(64) atomic<uint64_t> tail{0};
+        atomic<uint64_t> dropped{0};
+        atomic<bool> writing{false};
+        atomic<bool> orphaned{false};
+    };
+    using LogRingHolder = shared_ptr<LogRing>;
+
+    struct ThreadLogRing
+    {
+        ~ThreadLogRing() { if (ring) ring->orphaned = true; }
+        LogRingHolder ring;
+    };
+    static thread_local ThreadLogRing _THREAD_LOG_RING;
+
+    class AsyncLogWriter
+    {
+    public:
+        ~AsyncLogWriter() { Stop(); }
+
+        bool Start(LogSink::Holder sink, uint32_t ringSize, OverflowPolicy policy)
+        {
+            lock_guard<mutex> lk(m_startLock);
+            if (m_enabled)
+                return false;
+            uint32_t size = 4096;
+            while (size < ringSize && size < (1u<<30)) size <<= 1;
+            m_sink = sink ? sink : CreateStdoutLogSink();
+            m_ringSize = size;
+            m_policy = policy;
+            m_generation++;
+            m_quit = false;
+            m_thread = thread(&AsyncLogWriter::WriterProc, this);
+            m_enabled = true;
+            return true;
+        }
+
+        void Stop()
+        {
+            lock_guard<mutex> lk(m_startLock);
+            if (!m_enabled)
+                return;
+            m_enabled = false;
+            // 'm_quit' first, a producer blocked on a full ring gives up and the writer keeps draining meanwhile
+            {
+                lock_guard<mutex> lk2(m_wakeLock);
+                m_quit = true;
+            }
+            m_wakeCv.notify_all();
+            m_passCv.notify_all();
+            // producers which saw 'm_enabled' still set are finishing their push, don't hold 'm_ringsLock' needed by Drain()
+            vector<LogRingHolder> rings;
+            {
+                lock_guard<mutex> lk2(m_ringsLock);
+                rings = m_rings;
+            }
+            {
+                unique_lock<mutex> lk2(m_wakeLock);
+                m_writingCv.wait(lk2, [&rings] {
+                    return none_of(rings.begin(), rings.end(), [](const LogRingHolder& ring) { return (bool)ring->writing; });
+                });
+            }
+            if (m_thread.joinable())
+                m_thread.join();
+            // the records pushed after the last pass of the writer
+            if (Drain())
+                m_sink->Flush();
+            lock_guard<mutex> lk2(m_ringsLock);
+            m_rings.clear();
+            m_sink = nullptr;
+        }
+
+        void Flush()
+        {
+            if (!m_enabled)
+                return;
+            unique_lock<mutex> lk(m_wakeLock);
+            const uint64_t target = m_passCount+2;
+            m_wakePending = true;
+            m_wakeCv.notify_all();
+            m_passCv.wait(lk, [this, target] { return m_passCount >= target || m_quit; });
+        }
+
+        uint64_t GetDroppedCount() const
+        {
+            return m_droppedTotal;
+        }
+
+        bool IsEnabled() const
+        {
+            return m_enabled;
+        }
+
+        bool Push(const string& name, uint8_t flags, Level l, const char* text, size_t textSize)
+        {
+            ThreadLogRing& tlr = _THREAD_LOG_RING;
+            LogRing* ring = tlr.ring.get();
+            if (ring) ring->writing = true;
+            if (!m_enabled)
+            {
+                if (ring) EndWrite(ring);
+                return false;
+            }
+            if (!ring || ring->generation != m_generation)
+            {
+                if (ring) EndWrite(ring);
+                ring = Register(tlr);
+                if (!ring)
+                    return false;
+            }
+
+            const size_t nameSize = min<size_t>(name.size(), UINT16_MAX);
+            const uint32_t maxTextSize = m_ringSize/2-sizeof(LogRecordHeader)-nameSize-8;
+            if (textSize > maxTextSize)
+            {
+                // a deferred record can't be cut, the caller formats it
+                if (flags&RECORD_DEFERRED_FORMAT)
+                {
+                    EndWrite(ring);
+                    return false;
+                }
+                textSize = maxTextSize;
+            }
+            const uint32_t need = (sizeof(LogRecordHeader)+nameSize+textSize+7)&~7u;
+            const uint32_t capacity = ring->capacity;
+            uint64_t head = ring->head.load(memory_order_relaxed);
+            uint32_t pos = head&(capacity-1);
+            uint32_t padding = capacity-pos < need ? capacity-pos : 0;
+            while (capacity-(head-ring->tail.load(memory_order_acquire)) < padding+need)
+            {
+                if (m_policy == DROP_WHEN_FULL || m_quit)
+                {
+                    ring->dropped.fetch_add(1, memory_order_relaxed);
+                    EndWrite(ring);
+                    m_wakeCv.notify_one();
+                    return true;
+                }
+                // sleep until a pass of the writer releases some space
+                unique_lock<mutex> lk(m_wakeLock);
+                m_wakePending = true;
+                m_wakeCv.notify_one();
+                m_passCv.wait(lk, [&] {
+                    return m_quit || capacity-(head-ring->tail.load(memory_order_acquire)) >= padding+need;
+                });
+            }
+            char* base = ring->buffer.data();
+            if (padding > 0)
+            {
+                LogRecordHeader* pad = (LogRecordHeader*)(base+pos);
+                pad->size = padding;
+                pad->textSize = PADDING_RECORD;
+                head += padding;
+                pos = 0;
+            }
+            LogRecordHeader* hdr = (LogRecordHeader*)(base+pos);
+            hdr->size = need;
+            hdr->textSize = (uint32_t)textSize;
+            hdr->timeUs = chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch()).count();
+            hdr->nameSize = (uint16_t)nameSize;
+            hdr->level = (uint8_t)l;
+            hdr->flags = flags;
+            memcpy(hdr+1, name.data(), nameSize);
+            memcpy((char*)(hdr+1)+nameSize, text, textSize);
+            const uint64_t tail = ring->tail.load(memory_order_relaxed);
+            ring->head.store(head+need, memory_order_release);
+            EndWrite(ring);
+            // wake up the writer early when the ring is getting full
+            if (head+need-tail > capacity/2)
+                m_wakeCv.notify_one();
+            return true;
+        }
+
+    private:
+        void EndWrite(LogRing* ring)
+        {
+            ring->writing = false;
+            // Stop() waits for the producers which saw 'm_enabled' still set
+            if (!m_enabled)
+            {
+                lock_guard<mutex> lk(m_wakeLock);
+                m_writingCv.notify_all();
+            }
+        }
+
+        LogRing* Register(ThreadLogRing& tlr)
+        {
+            lock_guard<mutex> lk(m_ringsLock);
+            if (!m_enabled)
+                return nullptr;
+            tlr.ring = make_shared<LogRing>(m_ringSize, m_generation);
+            tlr.ring->writing = true;
+            m_rings.push_back(tlr.ring);
+            return tlr.ring.get();
+        }
+
+        // drain all rings once, return true if anything is written
+        bool Drain()
+        {
+            vector<LogRingHolder> rings;
+            {
+                lock_guard<mutex> lk(m_ringsLock);
+                rings = m_rings;
+            }
+            bool written = false;
+            for (auto& ring : rings)
+            {
+                uint64_t dropped = ring->dropped.exchange(0, memory_order_relaxed);
+                if (dropped > 0)
+                {
+                    m_droppedTotal += dropped;
+                    m_batch.append("(").append(to_string(dropped)).append(" log records dropped)\n");
+                }
+                uint64_t tail = ring->tail.load(memory_order_relaxed);
+                const uint64_t head = ring->head.load(memory_order_acquire);
+                const char* base = ring->buffer.data();
+                while (tail < head)
+                {
+                    const LogRecordHeader* hdr = (const LogRecordHeader*)(base+(tail&(ring->capacity-1)));
+                    if (hdr->textSize != PADDING_RECORD)
+                    {
+                        const char* name = (const char*)(hdr+1);
+                        const char* text = name+hdr->nameSize;
+                        AppendLogPrefix(m_batch, hdr->timeUs, (Level)hdr->level, name, hdr->nameSize, hdr->flags);
+                        const size_t textPos = m_batch.size();
+                        if (hdr->flags&RECORD_DEFERRED_FORMAT)
+                        {
+                            AppendDeferredFormat(m_batch, text);
+                            if (m_batch.size()-textPos > SINGLE_LOG_MAXSIZE-1)
+                                m_batch.resize(textPos+SINGLE_LOG_MAXSIZE-1);
+                        }
+                        else
+                        {
+                            m_batch.append(text, hdr->textSize);
+                        }
+                        if (m_batch.size() == textPos || m_batch.back() != '\n')
+                            m_batch.push_back('\n');
+                    }
+                    tail += hdr->size;
+                    if (m_batch.size() >= 64*1024)
+                    {
+                        // release the ring space before the slow sink write
+                        ring->tail.store(tail, memory_order_release);
+                        m_sink->Write(m_batch.data(), m_batch.size());
+                        m_batch.clear();
+                        written = true;
+                    }
+                }
+                ring->tail.store(tail, memory_order_release);
+            }
+            if (!m_batch.empty())
+            {
+                m_sink->Write(m_batch.data(), m_batch.size());
+                m_batch.clear();
+                written = true;
+            }
+            // the rings of exited threads are removed once they are empty
+            lock_guard<mutex> lk(m_ringsLock);
+            for (auto it = m_rings.begin(); it != m_rings.end();)
+            {
+                LogRing* ring = it->get();
+                if (ring->orphaned && !ring->writing && ring->tail == ring->head)
+                    it = m_rings.erase(it);
+                else
+                    it++;
+            }
+            return written;
+        }
+
+        void WriterProc()
+        {
+            while (true)
+            {
+                if (Drain())
+                    m_sink->Flush();
+                unique_lock<mutex> lk(m_wakeLock);
+                m_passCount++;
+                m_passCv.notify_all();
+                if (m_quit)
+                    break;
+                m_wakeCv.wait_for(lk, chrono::milliseconds(ASYNC_LOG_WRITE_INTERVAL_MILLISEC), [this] { return m_wakePending || m_quit; });
+                m_wakePending = false;
+            }
+        }
+
+    private:
+        static const int ASYNC_LOG_WRITE_INTERVAL_MILLISEC = 20;
+
+        mutex m_startLock;
+        atomic<bool> m_enabled{false};
+        atomic<bool> m_quit{false};
+        atomic<uint32_t> m_generation{0};
+        uint32_t m_ringSize{0};
+        OverflowPolicy m_policy{DROP_WHEN_FULL};
+        LogSink::Holder m_sink;
+        mutex m_ringsLock;
+        vector<LogRingHolder> m_rings;
+        thread m_thread;
+        mutex m_wakeLock;
+        condition_variable m_wakeCv;
+        condition_variable m_passCv;
+        condition_variable m_writingCv;
+        bool m_wakePending{false};
+        uint64_t m_passCount{0};
+        atomic<uint64_t> m_droppedTotal{0};
+        string m_batch;
+    };
+
+    static AsyncLogWriter ASYNC_LOG_WRITER;
+
     class BaseLogger : public ALogger
     {
     public:
@@ -129,31 +893,26 @@ namespace Logger
             return true;
         }
 
-        virtual string GetLogPrefix() const
+        uint8_t GetPrefixFlags() const
         {
-            ostringstream oss;
-            bool empty = true;
-            if (m_showTime)
-            {
-                auto now = chrono::system_clock::now();
-                time_t t = chrono::system_clock::to_time_t(now);
-                int32_t millisec = chrono::duration_cast<chrono::milliseconds>(now.time_since_epoch()).count()%1000;
-                oss << put_time(localtime(&t), "%H:%M:%S") << "." << setfill('0') << setw(3) << millisec << " ";
-                empty = false;
-            }
-            if (m_showLevelName)
-            {
-                const string& levelName = LEVEL_NAME.at(m_currLevel);
-                oss << "[" << levelName << "]";
-                empty = false;
-            }
-            if (m_showName)
-            {
-                oss << "[" << m_name << "]";
-                empty = false;
-            }
-            if (!empty) oss << " ";
-            return oss.str();
+            uint8_t flags = 0;
+            if (m_showTime) flags |= PREFIX_SHOW_TIME;
+            if (m_showLevelName) flags |= PREFIX_SHOW_LEVEL_NAME;
+            if (m_showName) flags |= PREFIX_SHOW_LOGGER_NAME;
+            return flags;
+        }
+
+        const string& GetNameRef() const
+        {
+            return m_name;
+        }
+
+        virtual string GetLogPrefix(Level l) const
+        {
+            string prefix;
+            int64_t timeUs = chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch()).count();
+            AppendLogPrefix(prefix, timeUs, l, m_name.c_str(), m_name.size(), GetPrefixFlags());
+            return prefix;
         }
 
         void Log(Level l, const string fmt, ...) override
@@ -169,19 +928,30 @@ namespace Logger
 
         void Log(Level l, const char *fmt, va_list *ap)
         {
-            va_list ap2;
-            va_copy(ap2, *ap);
-            int size = vsnprintf(nullptr, 0, fmt, *ap);
+            // in async mode only the arguments are copied here, the writer thread formats the record
+            if (ASYNC_LOG_WRITER.IsEnabled())
+            {
+                static thread_local vector<char> t_argsBuffer;
+                va_list apCopy;
+                va_copy(apCopy, *ap);
+                const bool serialized = SerializeFormatArgs(t_argsBuffer, fmt, &apCopy);
+                va_end(apCopy);
+                if (serialized && ASYNC_LOG_WRITER.Push(m_name, GetPrefixFlags()|RECORD_DEFERRED_FORMAT, l, t_argsBuffer.data(), t_argsBuffer.size()))
+                    return;
+            }
+
+            static thread_local vector<char> t_formatBuffer;
+            if (t_formatBuffer.size() < SINGLE_LOG_MAXSIZE)
+                t_formatBuffer.resize(SINGLE_LOG_MAXSIZE);
+            int size = vsnprintf(t_formatBuffer.data(), SINGLE_LOG_MAXSIZE, fmt, *ap);
+            if (size < 0)
+                return;
             if (size > SINGLE_LOG_MAXSIZE-1)
                 size = SINGLE_LOG_MAXSIZE-1;
-            else if (size < 0)
-                return;
-
-            unique_ptr<char> buf(new char[size+1]);
-            vsnprintf(buf.get(), size+1, fmt, ap2);
-            va_end(ap2);
 
-            GetLogStream(l) << buf.get() << endl;
+            if (ASYNC_LOG_WRITER.Push(m_name, GetPrefixFlags(), l, t_formatBuffer.data(), size))
+                return;
+            GetLogStream(l) << t_formatBuffer.data() << endl;
         }
 
         ostream& Log(Level l) override
@@ -197,7 +967,6 @@ namespace Logger
         int m_N{1};
         bool m_showLevelName{true};
         bool m_showTime{true};
-        Level m_currLevel{VERBOSE};
         string m_name;
         bool m_showName{false};
     };
@@ -231,18 +1000,28 @@ namespace Logger
             m_os = os;
         }
 
+        void SetLevel(Level l)
+        {
+            m_level = l;
+        }
+
     protected:
         int sync() override
         {
             int n = stringbuf::sync();
             char* curr = pptr();
             char* begin = pbase();
-            if (curr > begin)
+            if (curr > begin && m_logger && PushAsync(begin, curr-begin))
+            {
+                seekpos(0);
+                m_overflowChars = 0;
+            }
+            else if (curr > begin)
             {
                 if (m_os)
                 {
                     if (m_logger)
-                        *m_os << m_logger->GetLogPrefix();
+                        *m_os << m_logger->GetLogPrefix(m_level);
                     m_os->write(begin, curr-begin);
                     if (m_overflowChars > 0)
                         *m_os << " (" << m_overflowChars << " bytes overflowed)" << endl;
@@ -261,11 +1040,25 @@ namespace Logger
             return 0;
         }
 
+        bool PushAsync(const char* text, size_t size)
+        {
+            if (m_overflowChars > 0)
+            {
+                string logstr(text, size);
+                while (!logstr.empty() && logstr.back() == '\n')
+                    logstr.pop_back();
+                logstr += " ("+to_string(m_overflowChars)+" bytes overflowed)";
+                return ASYNC_LOG_WRITER.Push(m_logger->GetNameRef(), m_logger->GetPrefixFlags(), m_level, logstr.c_str(), logstr.size());
+            }
+            return ASYNC_LOG_WRITER.Push(m_logger->GetNameRef(), m_logger->GetPrefixFlags(), m_level, text, size);
+        }
+
     protected:
         BaseLogger* m_logger{nullptr};
         ostream* m_os{nullptr};
         unique_ptr<stringbuf::char_type[]> m_buffer;
         uint32_t m_overflowChars{0};
+        Level m_level{VERBOSE};
     };
 
 #ifdef USE_WINOWS_ADDITIONAL_LOG_CONSOLE
@@ -286,7 +1079,7 @@ namespace Logger
             {
                 ostringstream oss;
                 if (m_logger)
-                    oss << m_logger->GetLogPrefix();
+                    oss << m_logger->GetLogPrefix(m_level);
                 oss.write(begin, curr-begin);
                 if (m_overflowChars > 0)
                     oss << " (" << m_overflowChars << " bytes overflowed)" << endl;
@@ -326,36 +1119,36 @@ namespace Logger
             return this;
         }
 
+        LogStream* SetLevel(Level l)
+        {
+            m_pBuf->SetLevel(l);
+            return this;
+        }
+
     private:
         LogBuffer* m_pBuf;
     };
 
-    static unordered_map<thread::id, unique_ptr<LogStream>> _THREAD_LOGSTREAM_TABLE;
-    static mutex _THREAD_LOGSTREAM_TABLE_LOCK;
+    static thread_local unique_ptr<LogStream> _THREAD_LOGSTREAM;
 
-    LogStream& GetThreadLocalLogStream(BaseLogger* logger, ostream* os = nullptr)
+    LogStream& GetThreadLocalLogStream(BaseLogger* logger, Level l, ostream* os = nullptr)
     {
-        LogStream* pLogStream;
-        auto thid = this_thread::get_id();
-        auto iter = _THREAD_LOGSTREAM_TABLE.find(thid);
-        if (iter == _THREAD_LOGSTREAM_TABLE.end())
+        if (!_THREAD_LOGSTREAM)
         {
-            lock_guard<mutex> lk(_THREAD_LOGSTREAM_TABLE_LOCK);
 #ifdef USE_WINOWS_ADDITIONAL_LOG_CONSOLE
             LogBuffer* pBuf = new WinLogBuffer(logger, os, SINGLE_LOG_MAXSIZE);
 #else
             LogBuffer* pBuf = new LogBuffer(logger, os, SINGLE_LOG_MAXSIZE);
 #endif
-            pLogStream = new LogStream(pBuf);
-            _THREAD_LOGSTREAM_TABLE[thid] = unique_ptr<LogStream>(pLogStream);
+            _THREAD_LOGSTREAM = unique_ptr<LogStream>(new LogStream(pBuf));
         }
         else
         {
-            pLogStream = iter->second.get();
-            pLogStream->SetLogger(logger);
-            pLogStream->SetOStream(os);
+            _THREAD_LOGSTREAM->SetLogger(logger);
+            _THREAD_LOGSTREAM->SetOStream(os);
         }
-        return *pLogStream;
+        _THREAD_LOGSTREAM->SetLevel(l);
+        return *_THREAD_LOGSTREAM;
     }
 
     class StdoutLogger final : public BaseLogger
@@ -368,8 +1161,7 @@ namespace Logger
         {
             if (CheckShow(l))
             {
-                m_currLevel = l;
-                return GetThreadLocalLogStream(this, &cout);
+                return GetThreadLocalLogStream(this, l, &cout);
             }
             else
                 return NULL_STREAM;
@@ -387,8 +1179,7 @@ namespace Logger
         {
             if (CheckShow(l))
             {
-                m_currLevel = l;
-                return GetThreadLocalLogStream(this);
+                return GetThreadLocalLogStream(this, l);
             }
             else
                 return NULL_STREAM;
@@ -491,4 +1282,24 @@ namespace Logger
             logger = iter->second.get();
         return logger;
     }
+
+    bool StartAsyncLogging(LogSink::Holder sink, uint32_t ringBufferSize, OverflowPolicy policy)
+    {
+        return ASYNC_LOG_WRITER.Start(sink, ringBufferSize, policy);
+    }
+
+    void StopAsyncLogging()
+    {
+        ASYNC_LOG_WRITER.Stop();
+    }
+
+    void FlushAsyncLogging()
+    {
+        ASYNC_LOG_WRITER.Flush();
+    }
+
+    uint64_t GetDroppedLogCount()
+    {
+        return ASYNC_LOG_WRITER.GetDroppedCount();
+    }
 }
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <list>
 #include <chrono>
+#include <atomic>
 #include "ThreadUtils.h"
 
 using namespace std;
@@ -49,7 +50,7 @@ void SetThreadName(thread& t, const string& name)
 
 bool BaseAsyncTask::SetState(State eState, bool bForce)
 {
-    lock_guard<mutex> _lk(m_mtxLock);
+    unique_lock<mutex> lk(m_mtxLock);
     if (m_eState == eState)
         return true;
 
@@ -78,185 +79,99 @@ bool BaseAsyncTask::SetState(State eState, bool bForce)
     if (bStateTransAllowed)
     {
         m_eState = eState;
+        if (eState == WAITING)
+            m_bStopNotified = false;
+        _NotifyStateChanged(lk);
         return true;
     }
-    Log(Error) << "FAILED to set task state from " << (int)m_eState << " to " << (int)eState << "." << endl;
+    const State eOldState = m_eState;
+    lk.unlock();
+    Log(Error) << "FAILED to set task state from " << (int)eOldState << " to " << (int)eState << "." << endl;
     return false;
 }
 
 bool BaseAsyncTask::Cancel()
 {
-    lock_guard<mutex> _lk(m_mtxLock);
+    unique_lock<mutex> lk(m_mtxLock);
     if (m_eState == CANCELLED)
         return true;
     if (m_eState != WAITING && m_eState != PROCESSING)
         return false;
     m_eState = CANCELLED;
+    _NotifyStateChanged(lk);
     return true;
 }
 
-#define THREAD_IDLE_SLEEP_MILLISEC  2
-
-void BaseAsyncTask::WaitDone()
+void BaseAsyncTask::_SetRunning(bool bRunning)
 {
-    while (!IsStopped())
-        this_thread::sleep_for(chrono::milliseconds(THREAD_IDLE_SLEEP_MILLISEC));
+    unique_lock<mutex> lk(m_mtxLock);
+    m_bRunning = bRunning;
+    _NotifyStateChanged(lk);
 }
 
-bool BaseAsyncTask::WaitState(State eState, int64_t u64TimeOut)
+// wake up the waiters, and invoke the stopped callbacks once the task is stopped.
+// 'lk' must be locked, it is unlocked if any callback is invoked.
+void BaseAsyncTask::_NotifyStateChanged(unique_lock<mutex>& lk)
 {
-    if (u64TimeOut > 0)
-    {
-        const auto startWaitTime = chrono::steady_clock::now();
-        while (m_eState != eState)
-        {
-            const auto elapsedTime = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now()-startWaitTime).count();
-            if (elapsedTime >= u64TimeOut)
-                break;
-            this_thread::sleep_for(chrono::milliseconds(THREAD_IDLE_SLEEP_MILLISEC));
-        }
-    }
-    else
-    {
-        while (m_eState != eState)
-            this_thread::sleep_for(chrono::milliseconds(THREAD_IDLE_SLEEP_MILLISEC));
-    }
-    return m_eState == eState;
+    m_cvState.notify_all();
+    if (m_bStopNotified || m_bRunning || (m_eState != DONE && m_eState != FAILED && m_eState != CANCELLED))
+        return;
+    m_bStopNotified = true;
+    if (m_aStoppedCallbacks.empty())
+        return;
+    list<function<void()>> aCallbacks;
+    aCallbacks.swap(m_aStoppedCallbacks);
+    lk.unlock();
+    for (auto& callback : aCallbacks)
+        callback();
 }
 
-struct ThreadExecutor
-{
-    using Holder = shared_ptr<ThreadExecutor>;
-    virtual bool EnqueueTask(AsyncTask::Holder hTask) = 0;
-    virtual void Terminate(bool bWaitAllTaskDone) = 0;
-    virtual bool CanAcceptTask() const = 0;
-    virtual bool IsIdle() const = 0;
-    virtual bool IsTerminated() const = 0;
-};
-
-class ThreadExecutorImpl : public ThreadExecutor
+bool BaseAsyncTask::AddStoppedCallback(function<void()> callback)
 {
-public:
-    static ThreadExecutor::Holder CreateInstance(const string& name);
-
-    ThreadExecutorImpl(const string& name)
-    {
-        m_pLogger = GetLogger(name);
-        m_thExecutorThread = thread(&ThreadExecutorImpl::_ExecutorProc, this);
-    }
-
-    bool EnqueueTask(AsyncTask::Holder hTask) override
+    if (!callback)
+        return false;
+    unique_lock<mutex> lk(m_mtxLock);
+    if (m_bStopNotified)
     {
-        if (m_aTasks.size() >= m_iMaxWaitTaskCnt || m_bTerminating)
-            return false;
-        m_bIdle = false;
-        lock_guard<mutex> lk(m_mtxTasksLock);
-        m_aTasks.push_back(hTask);
-        // cout << "ThreadExecutor: Added task " << hTask.get() << endl;
+        lk.unlock();
+        callback();
         return true;
     }
+    m_aStoppedCallbacks.push_back(std::move(callback));
+    return true;
+}
 
-    void Terminate(bool bWaitAllTaskDone) override
-    {
-        if (m_bTerminating)
-            return;
-        m_bTerminating = true;
-        if (bWaitAllTaskDone)
-        {
-            while (!m_aTasks.empty())
-                this_thread::sleep_for(chrono::milliseconds(THREAD_IDLE_SLEEP_MILLISEC));
-        }
-        m_bQuit = true;
-        if (m_thExecutorThread.joinable())
-            m_thExecutorThread.join();
-    }
-
-    bool CanAcceptTask() const override
-    {
-        return m_aTasks.size() < m_iMaxWaitTaskCnt && !m_bTerminating;
-    }
-
-    bool IsIdle() const override
-    {
-        return m_bIdle && !m_bTerminating;
-    }
-
-    bool IsTerminated() const override
-    {
-        return m_bTerminating;
-    }
-
-private:
-    void _ExecutorProc()
-    {
-        while (!m_bQuit)
-        {
-            bool bIdleLoop = true;
-
-            AsyncTask::Holder hTask;
-            {
-                if (!m_aTasks.empty())
-                {
-                    lock_guard<mutex> lk(m_mtxTasksLock);
-                    hTask = m_aTasks.front();
-                    m_aTasks.pop_front();
-                }
-            }
-
-            if (hTask && hTask->IsWaiting() && hTask->SetState(AsyncTask::PROCESSING))
-            {
-                // cout << "ThreadExecutor: Processing task " << hTask.get() << endl;
-                (*hTask)();
-                // cout << "ThreadExecutor: Done task " << hTask.get() << endl;
-                if (hTask->IsProcessing())
-                {
-                    if (!hTask->SetState(AsyncTask::DONE))
-                        m_pLogger->Log(WARN) << "FAILED to set task state as 'DONE' after it's been processed." << endl;
-                }
-                bIdleLoop = false;
-            }
-            else if (m_aTasks.empty())
-            {
-                m_bIdle = true;
-            }
-
-            if (bIdleLoop)
-            {
-                // auto nowtp = chrono::system_clock::now();
-                // cout << "[" << chrono::duration_cast<chrono::milliseconds>(nowtp.time_since_epoch()).count() << "] I'm idle" << endl;
-                this_thread::sleep_for(chrono::milliseconds(THREAD_IDLE_SLEEP_MILLISEC));
-            }
-        }
-    }
-
-private:
-    ALogger* m_pLogger;
-    string m_strName;
-    list<AsyncTask::Holder> m_aTasks;
-    mutex m_mtxTasksLock;
-    int m_iMaxWaitTaskCnt{1};
-    thread m_thExecutorThread;
-    bool m_bIdle{true};
-    bool m_bQuit{false}, m_bTerminating{false};
-};
+void BaseAsyncTask::WaitDone()
+{
+    unique_lock<mutex> lk(m_mtxLock);
+    m_cvState.wait(lk, [this] { return IsStopped(); });
+}
 
-ThreadExecutor::Holder ThreadExecutorImpl::CreateInstance(const string& name)
+bool BaseAsyncTask::WaitState(State eState, int64_t u64TimeOut)
 {
-    return ThreadExecutor::Holder(new ThreadExecutorImpl(name), [] (ThreadExecutor* p) {
-        p->Terminate(false);
-        ThreadExecutorImpl* ptr = dynamic_cast<ThreadExecutorImpl*>(p);
-        delete ptr;
-    });
+    unique_lock<mutex> lk(m_mtxLock);
+    if (u64TimeOut > 0)
+        return m_cvState.wait_for(lk, chrono::milliseconds(u64TimeOut), [this, eState] { return m_eState == eState; });
+    m_cvState.wait(lk, [this, eState] { return m_eState == eState; });
+    return true;
 }
 
-class DefaultThreadPoolExecutorImpl : public ThreadPoolExecutor
+#define THREAD_POOL_MAX_WORKER_COUNT    256
+
+// Each worker owns a deque per priority. Tasks enqueued from a worker go to its own deques,
+// other tasks are spread round robin. An idle worker takes the highest priority task from its
+// own deques first, then steals from the others, and parks on a condition variable when there
+// is nothing left. New workers are only started when all the existing ones are busy.
+class DefaultThreadPoolExecutorImpl : public ThreadPoolExecutor, public enable_shared_from_this<DefaultThreadPoolExecutorImpl>
 {
 public:
     DefaultThreadPoolExecutorImpl(const string& name)
     {
         m_strName = name.empty() ? "UnnamedThreadPoolExecutor" : name;
         m_pLogger = GetLogger(m_strName);
-        m_thExecutorThread = thread(&DefaultThreadPoolExecutorImpl::_ExecutorProc, this);
+        m_uHardwareThreadCnt = thread::hardware_concurrency();
+        if (m_uHardwareThreadCnt == 0)
+            m_uHardwareThreadCnt = 1;
     }
 
     ~DefaultThreadPoolExecutorImpl()
@@ -266,33 +181,79 @@ public:
 
     bool EnqueueTask(AsyncTask::Holder hTask, bool bNonblock) override
     {
-        if (m_bTerminating || (bNonblock && m_uMaxWaitingTaskCnt > 0 && m_aTasks.size() >= m_uMaxWaitingTaskCnt))
+        if (!hTask || m_bTerminating)
             return false;
-        if (m_uMaxWaitingTaskCnt > 0)
+        if (m_uMaxWaitingTaskCnt > 0 && m_iPendingTaskCnt >= (int)m_uMaxWaitingTaskCnt)
         {
-            while (!m_bTerminating && m_aTasks.size() >= m_uMaxWaitingTaskCnt)
-                this_thread::sleep_for(chrono::milliseconds(THREAD_IDLE_SLEEP_MILLISEC));
+            if (bNonblock)
+                return false;
+            unique_lock<mutex> lk(m_mtxPark);
+            m_iBlockedEnqueueCnt++;
+            m_cvSpace.wait(lk, [this] { return m_bTerminating || m_uMaxWaitingTaskCnt == 0 || m_iPendingTaskCnt < (int)m_uMaxWaitingTaskCnt; });
+            m_iBlockedEnqueueCnt--;
             if (m_bTerminating)
                 return false;
         }
+        return _PushTask(hTask);
+    }
+
+    bool EnqueueTaskAfter(AsyncTask::Holder hTask, const vector<AsyncTask::Holder>& aDependencies) override
+    {
+        if (!hTask || m_bTerminating)
+            return false;
+        if (aDependencies.empty())
+            return EnqueueTask(hTask, false);
+        struct DependencyState
         {
-            lock_guard<mutex> lk(m_mtxTasksLock);
-            m_aTasks.push_back(hTask);
-            // cout << "DefaultThreadPoolExecutorImpl: Added task " << hTask.get() << endl;
+            atomic<int> iRemainingCnt;
+            atomic<bool> bFailed{false};
+        };
+        auto pState = make_shared<DependencyState>();
+        // one extra count so the task isn't released before all callbacks are added
+        pState->iRemainingCnt = (int)aDependencies.size() + 1;
+        weak_ptr<DefaultThreadPoolExecutorImpl> wpThis = shared_from_this();
+        auto release = [wpThis, hTask, pState] () {
+            if (--pState->iRemainingCnt > 0)
+                return;
+            // a dependency can finish on a worker while the pool terminates, _PushTask() cancels the task once it quits
+            auto hThis = wpThis.lock();
+            if (!hThis || pState->bFailed)
+                hTask->Cancel();
+            else
+                hThis->_PushTask(hTask);
+        };
+        for (auto& hDependency : aDependencies)
+        {
+            AsyncTask* pDependency = hDependency.get();
+            bool bAdded = pDependency && pDependency->AddStoppedCallback([pDependency, pState, release] () {
+                if (!pDependency->IsDone())
+                    pState->bFailed = true;
+                release();
+            });
+            if (!bAdded)
+            {
+                m_pLogger->Log(Error) << "Dependency task " << pDependency << " can NOT notify when it's stopped!" << endl;
+                pState->bFailed = true;
+                release();
+            }
         }
+        release();
         return true;
     }
 
     void SetMaxWaitingTaskCount(uint32_t cnt) override
     {
         m_uMaxWaitingTaskCnt = cnt;
+        lock_guard<mutex> lk(m_mtxPark);
+        m_cvSpace.notify_all();
     }
 
     uint32_t GetWaitingTaskCount() const override
     {
-        return m_aTasks.size();
+        return m_iPendingTaskCnt > 0 ? (uint32_t)m_iPendingTaskCnt : 0;
     }
 
+    // 0 means the hardware thread count, lowering it doesn't stop the workers already started
     void SetMaxThreadCount(uint32_t cnt) override
     {
         m_uMaxExecutorCnt = cnt;
@@ -306,6 +267,9 @@ public:
     void SetMinThreadCount(uint32_t cnt) override
     {
         m_uMinExecutorCnt = cnt;
+        lock_guard<mutex> lk(m_mtxWorkers);
+        while (!m_bTerminating && m_iWorkerCnt < (int)min<uint32_t>(cnt, THREAD_POOL_MAX_WORKER_COUNT))
+            _StartWorker();
     }
 
     uint32_t GetMinThreadCount() const override
@@ -315,20 +279,35 @@ public:
 
     void Terminate(bool bWaitAllTaskDone) override
     {
-        if (m_bTerminating)
+        if (m_bTerminating.exchange(true))
             return;
-        m_bTerminating = true;
-        if (bWaitAllTaskDone)
         {
-            while (!m_aTasks.empty())
-                this_thread::sleep_for(chrono::milliseconds(THREAD_IDLE_SLEEP_MILLISEC));
+            unique_lock<mutex> lk(m_mtxPark);
+            m_cvSpace.notify_all();
+            if (bWaitAllTaskDone)
+                m_cvIdle.wait(lk, [this] { return m_iPendingTaskCnt <= 0 && m_iActiveCnt == 0; });
+            m_bQuit = true;
+            m_cvPark.notify_all();
         }
-        m_bQuit = true;
-        if (m_thExecutorThread.joinable())
-            m_thExecutorThread.join();
-        for (auto& hExecutor : m_aExecutors)
-            hExecutor->Terminate(bWaitAllTaskDone);
-        m_aExecutors.clear();
+        lock_guard<mutex> lk(m_mtxWorkers);
+        const int iWorkerCnt = m_iWorkerCnt;
+        for (int i = 0; i < iWorkerCnt; i++)
+        {
+            if (m_apWorkers[i]->thWorker.joinable())
+                m_apWorkers[i]->thWorker.join();
+        }
+        // wake up whoever waits for the tasks that will never run
+        for (int i = 0; i < iWorkerCnt; i++)
+        {
+            for (auto& aQueue : m_apWorkers[i]->aQueues)
+            {
+                for (auto& hTask : aQueue)
+                    hTask->Cancel();
+                aQueue.clear();
+            }
+            m_apWorkers[i]->iTaskCnt = 0;
+        }
+        m_iPendingTaskCnt = 0;
     }
 
     void SetLoggerLevel(Level l) override
@@ -337,120 +316,176 @@ public:
     }
 
 private:
-    void _ExecutorProc()
+    static constexpr int PRIORITY_COUNT = AsyncTask::HIGH + 1;
+
+    struct Worker
+    {
+        mutex mtxQueue;
+        list<AsyncTask::Holder> aQueues[PRIORITY_COUNT];
+        atomic<int> iTaskCnt{0};
+        thread thWorker;
+    };
+
+    static thread_local DefaultThreadPoolExecutorImpl* t_pCurrentPool;
+    static thread_local int t_iWorkerIndex;
+
+    uint32_t _GetWorkerLimit() const
     {
-        AsyncTask::Holder hTask;
-        while (!m_bQuit)
+        uint32_t uLimit = m_uMaxExecutorCnt > 0 ? (uint32_t)m_uMaxExecutorCnt : m_uHardwareThreadCnt;
+        uLimit = max<uint32_t>(uLimit, m_uMinExecutorCnt);
+        return min<uint32_t>(max<uint32_t>(uLimit, 1), THREAD_POOL_MAX_WORKER_COUNT);
+    }
+
+    // must hold m_mtxWorkers
+    void _StartWorker()
+    {
+        const int index = m_iWorkerCnt;
+        m_apWorkers[index].reset(new Worker());
+        m_apWorkers[index]->thWorker = thread(&DefaultThreadPoolExecutorImpl::_WorkerProc, this, index);
+        ostringstream oss; oss << m_strName << "-" << index;
+        SetThreadName(m_apWorkers[index]->thWorker, oss.str());
+        m_iWorkerCnt = index + 1;
+    }
+
+    // Terminate() sets m_bQuit under m_mtxPark before it joins the workers and cancels the queued tasks,
+    // so a task is either queued before that or cancelled here, and no worker is started while it joins
+    bool _PushTask(AsyncTask::Holder hTask)
+    {
+        unique_lock<mutex> lkPark(m_mtxPark);
+        if (m_bQuit)
         {
-            bool bIdleLoop = true;
+            lkPark.unlock();
+            hTask->Cancel();
+            return false;
+        }
+        int iWorkerCnt = m_iWorkerCnt;
+        if (iWorkerCnt == 0)
+        {
+            lock_guard<mutex> lk(m_mtxWorkers);
+            if (m_iWorkerCnt == 0)
+                _StartWorker();
+            iWorkerCnt = m_iWorkerCnt;
+        }
+        const int index = t_pCurrentPool == this ? t_iWorkerIndex : (int)(m_uRoundRobin++ % (uint32_t)iWorkerCnt);
+        const int priority = max(0, min((int)hTask->GetPriority(), PRIORITY_COUNT - 1));
+        Worker* pWorker = m_apWorkers[index].get();
+        {
+            lock_guard<mutex> lk(pWorker->mtxQueue);
+            pWorker->aQueues[priority].push_back(hTask);
+        }
+        pWorker->iTaskCnt++;
+        m_iPendingTaskCnt++;
+
+        if (m_iSleepingCnt > 0)
+        {
+            m_cvPark.notify_one();
+        }
+        else if (m_iActiveCnt >= m_iWorkerCnt && m_iWorkerCnt < (int)_GetWorkerLimit())
+        {
+            lock_guard<mutex> lk(m_mtxWorkers);
+            if (m_iWorkerCnt < (int)_GetWorkerLimit())
+                _StartWorker();
+        }
+        return true;
+    }
 
-            if (!hTask)
+    AsyncTask::Holder _PopTask(int index)
+    {
+        const int iWorkerCnt = m_iWorkerCnt;
+        for (int priority = PRIORITY_COUNT - 1; priority >= 0; priority--)
+        {
+            // own deque first, then steal from the others
+            for (int i = 0; i < iWorkerCnt; i++)
             {
-                if (!m_aTasks.empty())
-                {
-                    lock_guard<mutex> lk(m_mtxTasksLock);
-                    hTask = m_aTasks.front();
-                    m_aTasks.pop_front();
-                }
+                Worker* pWorker = m_apWorkers[(index + i) % iWorkerCnt].get();
+                if (pWorker->iTaskCnt <= 0)
+                    continue;
+                lock_guard<mutex> lk(pWorker->mtxQueue);
+                auto& aQueue = pWorker->aQueues[priority];
+                if (aQueue.empty())
+                    continue;
+                AsyncTask::Holder hTask = aQueue.front();
+                aQueue.pop_front();
+                pWorker->iTaskCnt--;
+                return hTask;
             }
+        }
+        return nullptr;
+    }
 
-            if (hTask && hTask->IsWaiting())
+    void _WorkerProc(int index)
+    {
+        t_pCurrentPool = this;
+        t_iWorkerIndex = index;
+        while (true)
+        {
+            // once terminating, the queued tasks are left to Terminate() which cancels them
+            if (m_bQuit)
+                break;
+            AsyncTask::Holder hTask = _PopTask(index);
+            if (hTask)
             {
-                ThreadExecutor::Holder hCandidate;
-                for (auto& hExecutor : m_aExecutors)
+                m_iActiveCnt++;
+                m_iPendingTaskCnt--;
+                if (m_iBlockedEnqueueCnt > 0)
                 {
-                    if (hExecutor->IsIdle())
-                    {
-                        hCandidate = hExecutor;
-                        break;
-                    }
-                    if (hExecutor->CanAcceptTask())
-                    {
-                        hCandidate = hExecutor;
-                    }
+                    lock_guard<mutex> lk(m_mtxPark);
+                    m_cvSpace.notify_all();
                 }
-                if (hCandidate)
+                if (hTask->IsWaiting() && hTask->SetState(AsyncTask::PROCESSING))
                 {
-                    bIdleLoop = false;
-                    if (hCandidate->EnqueueTask(hTask))
-                    {
-                        // cout << "DefaultThreadPoolExecutorImpl: Dispatched task " << hTask.get() << endl;
-                        hTask = nullptr;
-                    }
-                    else
+                    (*hTask)();
+                    if (hTask->IsProcessing())
                     {
-                        // cout << "WARNING! FAILED to enqueue task into CANDIDATE EXECUTOR." << endl;
+                        if (!hTask->SetState(AsyncTask::DONE))
+                            m_pLogger->Log(WARN) << "FAILED to set task state as 'DONE' after it's been processed." << endl;
                     }
                 }
-                if (hTask && (m_uMaxExecutorCnt == 0 || (m_uMaxExecutorCnt > m_uMinExecutorCnt && m_aExecutors.size() < m_uMaxExecutorCnt)))
-                {
-                    ostringstream oss; oss << m_strName << "-" << m_aExecutors.size();
-                    auto hNewExecutor = ThreadExecutorImpl::CreateInstance(oss.str());
-                    if (hNewExecutor->EnqueueTask(hTask))
-                    {
-                        hTask = nullptr;
-                        m_aExecutors.push_back(hNewExecutor);
-                        bIdleLoop = false;
-                    }
-                    else
-                    {
-                        m_pLogger->Log(Error) << "Newly created 'ThreadExecutor' instance can NOT enqueue task!" << endl;
-                        hNewExecutor->Terminate(false);
-                    }
-                }
-            }
-            else
-            {
                 hTask = nullptr;
-            }
-
-            if (m_uMinExecutorCnt > 0 && m_aExecutors.size() < m_uMinExecutorCnt)
-            {
-                uint32_t uAddCnt = m_uMinExecutorCnt-m_aExecutors.size();
-                for (uint32_t i = 0; i < uAddCnt; i++)
-                {
-                    ostringstream oss; oss << m_strName << "-" << m_aExecutors.size();
-                    m_aExecutors.push_back(ThreadExecutorImpl::CreateInstance(oss.str()));
-                }
-            }
-            else if (m_aTasks.empty() && m_uMaxExecutorCnt > 0 && m_uMaxExecutorCnt >= m_uMinExecutorCnt && m_aExecutors.size() > m_uMaxExecutorCnt)
-            {
-                uint32_t uRemoveCnt = m_aExecutors.size()-m_uMaxExecutorCnt;
-                auto itDel = m_aExecutors.begin();
-                while (itDel != m_aExecutors.end() && uRemoveCnt > 0)
+                m_iActiveCnt--;
+                if (m_bTerminating && m_iPendingTaskCnt <= 0 && m_iActiveCnt == 0)
                 {
-                    auto& hExecutor = *itDel;
-                    if (hExecutor->IsIdle())
-                    {
-                        hExecutor->Terminate(true);
-                        itDel = m_aExecutors.erase(itDel);
-                        uRemoveCnt--;
-                    }
-                    else
-                    {
-                        itDel++;
-                    }
+                    lock_guard<mutex> lk(m_mtxPark);
+                    m_cvIdle.notify_all();
                 }
+                continue;
             }
 
-            if (bIdleLoop)
-                this_thread::sleep_for(chrono::milliseconds(THREAD_IDLE_SLEEP_MILLISEC));
+            unique_lock<mutex> lk(m_mtxPark);
+            m_iSleepingCnt++;
+            m_cvPark.wait(lk, [this] { return m_bQuit || m_iPendingTaskCnt > 0; });
+            m_iSleepingCnt--;
+            if (m_bQuit)
+                break;
         }
+        t_pCurrentPool = nullptr;
     }
 
 private:
     ALogger* m_pLogger;
     string m_strName;
-    list<ThreadExecutor::Holder> m_aExecutors;
-    uint32_t m_uMaxExecutorCnt{0};
-    uint32_t m_uMinExecutorCnt{0};
-    list<AsyncTask::Holder> m_aTasks;
-    mutex m_mtxTasksLock;
-    uint32_t m_uMaxWaitingTaskCnt{0};
-    thread m_thExecutorThread;
-    bool m_bQuit{false}, m_bTerminating{false};
+    unique_ptr<Worker> m_apWorkers[THREAD_POOL_MAX_WORKER_COUNT];
+    atomic<int> m_iWorkerCnt{0};
+    mutex m_mtxWorkers;
+    atomic<uint32_t> m_uRoundRobin{0};
+    uint32_t m_uHardwareThreadCnt{1};
+    atomic<uint32_t> m_uMaxExecutorCnt{0};
+    atomic<uint32_t> m_uMinExecutorCnt{0};
+    atomic<uint32_t> m_uMaxWaitingTaskCnt{0};
+    atomic<int> m_iPendingTaskCnt{0};
+    atomic<int> m_iActiveCnt{0};
+    atomic<int> m_iSleepingCnt{0};
+    atomic<int> m_iBlockedEnqueueCnt{0};
+    mutex m_mtxPark;
+    condition_variable m_cvPark;
+    condition_variable m_cvSpace;
+    condition_variable m_cvIdle;
+    atomic<bool> m_bQuit{false}, m_bTerminating{false};
 };
 
+thread_local DefaultThreadPoolExecutorImpl* DefaultThreadPoolExecutorImpl::t_pCurrentPool = nullptr;
+thread_local int DefaultThreadPoolExecutorImpl::t_iWorkerIndex = 0;
+
 ThreadPoolExecutor::Holder _DEFAULT_THREAD_POOL_EXECUTOR_HOLDER;
 mutex _DEFAULT_THREAD_POOL_EXECUTOR_HOLDER_LOCK;
 
@@ -1,6 +1,7 @@
 #include "imgui_extra_widget.h"
 #include "imgui_helper.h"
 #include "imgui_fft.h"
+#include "imgui_cpu.h"
 #include <iostream>
 #include <cmath>
 #include <sstream>
@@ -5178,24 +5179,11 @@ void ImGui::DrawLogCircularGraduation( ImDrawList* drawlist, ImVec2 center, floa
 }
 
 // imgInspect
-inline void histogram(const int width, const int height, const unsigned char* const bits)
+inline void histogram(const ImGui::ImMatStats& stats)
 {
-    unsigned int count[4][256] = {0};
-    const unsigned char* ptrCols = bits;
+    const uint32_t (&count)[4][256] = stats.histogram;
     ImGui::InvisibleButton("histogram", ImVec2(256, 128));
-    for (int l = 0; l < height * width; l++)
-    {
-        count[0][*ptrCols++]++;
-        count[1][*ptrCols++]++;
-        count[2][*ptrCols++]++;
-        count[3][*ptrCols++]++;
-    }
-    unsigned int maxv = count[0][0];
-    unsigned int* pCount = &count[0][0];
-    for (int i = 0; i < 3 * 256; i++, pCount++)
-    {
-        maxv = (maxv > *pCount) ? maxv : *pCount;
-    }
+    unsigned int maxv = ImMax(stats.histogram_max, 1u);
     ImDrawList* drawList = ImGui::GetWindowDrawList();
     const ImVec2 rmin = ImGui::GetItemRectMin();
     const ImVec2 rmax = ImGui::GetItemRectMax();
@@ -5250,13 +5238,14 @@ inline void drawNormal(ImDrawList* draw_list, const ImRect& rc, float x, float y
     draw_list->AddLine(rc.GetCenter(), rc.GetCenter() + ImVec2(x, y) * rc.GetWidth() / 2.f, 0xFF0000FF, 2.f);
 }
 
-void ImGui::ImageInspect(const int width,
+static void ImageInspect(const int width,
                         const int height,
                         const unsigned char* const bits,
                         ImVec2 mouseUVCoord,
                         ImVec2 displayedTextureSize,
                         bool histogram_full,
-                        int zoom_size)
+                        int zoom_size,
+                        const ImGui::ImMatStats* full_stats)
 {
     if (ImGui::BeginTooltip())
     {
@@ -5326,7 +5315,11 @@ void ImGui::ImageInspect(const int width,
         ImGui::EndGroup();
         if (histogram_full)
         {
-            histogram(width, height, bits);
+            static ImGui::ImMatStats stats;
+            if (full_stats)
+                histogram(*full_stats);
+            else if (stats.update(ImGui::ImMat(width, height, 4, (void *)bits, 1u, 4)))
+                histogram(stats);
         }
         else
         {
@@ -5335,15 +5328,41 @@ void ImGui::ImageInspect(const int width,
                 for (int x = -zoomSize; x <= zoomSize; x++)
                 {
                     uint32_t texel = ((uint32_t*)bits)[(basey - y) * width + x + basex];
-                    zoomData[(y + zoomSize) * zoomSize * 2 + x + zoomSize] = texel;
+                    zoomData[(y + zoomSize) * (zoomSize * 2 + 1) + x + zoomSize] = texel;
                 }
             }
-            histogram(zoomSize * 2, zoomSize * 2, (const unsigned char*)zoomData);
+            ImGui::ImMatStats stats;
+            if (stats.update(ImGui::ImMat(zoomSize * 2 + 1, zoomSize * 2 + 1, 4, zoomData, 1u, 4)))
+                histogram(stats);
         }
         ImGui::EndTooltip();
     }
 }
 
+void ImGui::ImageInspect(const int width,
+                        const int height,
+                        const unsigned char* const bits,
+                        ImVec2 mouseUVCoord,
+                        ImVec2 displayedTextureSize,
+                        bool histogram_full,
+                        int zoom_size)
+{
+    ::ImageInspect(width, height, bits, mouseUVCoord, displayedTextureSize, histogram_full, zoom_size, nullptr);
+}
+
+void ImGui::ImageInspect(const ImGui::ImMat& mat,
+                        ImVec2 mouseUVCoord,
+                        ImVec2 displayedTextureSize,
+                        bool histogram_full,
+                        int zoom_size)
+{
+    assert(mat.type == IM_DT_INT8 && mat.c == 4 && mat.elempack == 4);
+    // full image statistics are cached on mat time stamp
+    static ImGui::ImMatStats stats;
+    const bool has_stats = histogram_full && stats.update(mat);
+    ::ImageInspect(mat.w, mat.h, (const unsigned char *)mat.data, mouseUVCoord, displayedTextureSize, histogram_full, zoom_size, has_stats ? &stats : nullptr);
+}
+
 // Extensions to ImDrawList
 inline static ImU32 GetVerticalGradient(const ImVec4& ct,const ImVec4& cb,float DH,float H)
 {
@@ -6113,11 +6132,12 @@ void ImGui::AddTextVertical(ImDrawList* drawList,const ImFont* font, float font_
     ImGuiContext& g = *GImGui;
     if (g.Style.TextInternationalize)
     {
-        auto changed = ImGui::InternationalizedText(_text_begin, _text_end);
-        if (changed > 0)
+        const char* localized_end = NULL;
+        const char* localized = ImGui::FindInternationalizedText(_text_begin, _text_end, &localized_end);
+        if (localized)
         {
-            _text_begin = g.InternationalizedBuffer;
-            _text_end = _text_begin + changed;
+            _text_begin = localized;
+            _text_end = localized_end;
         }
     }
     // add by Dicky end
@@ -6217,11 +6237,12 @@ void ImGui::AddTextRolling(ImDrawList* drawList, const ImFont* font, float font_
     ImGuiContext& g = *GImGui;
     if (g.Style.TextInternationalize)
     {
-        auto changed = ImGui::InternationalizedText(_text_begin, _text_end);
-        if (changed > 0)
+        const char* localized_end = NULL;
+        const char* localized = ImGui::FindInternationalizedText(_text_begin, _text_end, &localized_end);
+        if (localized)
         {
-            _text_begin = g.InternationalizedBuffer;
-            _text_end = _text_begin + changed;
+            _text_begin = localized;
+            _text_end = localized_end;
         }
     }
 
@@ -6983,79 +7004,173 @@ void ImGui::Piano::reset()
 void ImGui::ImSpectrogram(const ImGui::ImMat& in_mat, ImGui::ImMat& out_mat, int window, bool bstft, int hope)
 {
     assert(in_mat.c == 1 && in_mat.h == 1 && in_mat.type == IM_DT_FLOAT32);
+    ImGui::ImSpectrogramBuilder builder(window, bstft, hope);
+    builder.append(in_mat);
+    builder.finish();
+    builder.get(out_mat);
+}
+
+ImGui::ImSpectrogramBuilder::ImSpectrogramBuilder(int window, bool bstft, int hope)
+{
     auto powoftwo = [&](int n) { return(n > 0 && !(n & (n - 1))); };
     if (window == 0 || !powoftwo(window)) window = 512;
-    if (bstft) { if (hope == 0 || hope > window) hope = window / 2; }
+    if (bstft) { if (hope <= 0 || hope > window) hope = window / 2; }
+    m_window = window;
+    m_stft = bstft;
+    m_hope = bstft ? hope : window;
+    // ImSTFT emits its first frame once the shift buffer has been filled
+    m_lead = (m_window + m_hope - 1) / m_hope;
+    if (m_stft)
+    {
+        // same normalized hann window as ImSTFT
+        float tmp = 0;
+        m_hann.resize(m_window);
+        for (int i = 0; i < m_window; i++) m_hann[i] = 0.5 * (1.0 - cos(2.0 * M_PI * (i / (float)m_window)));
+        for (int i = 0; i < m_window; i++) tmp += m_hann[i] * m_hann[i];
+        tmp = std::sqrt(tmp / m_hope);
+        for (int i = 0; i < m_window; i++) m_hann[i] /= tmp;
+    }
+    // dB is mapped to 128 hue steps, lightness scales the full value color
+    for (int i = 0; i < 128; i++)
+    {
+        float hue = ((i + 170) % 255) / 255.f;
+        ImGui::ColorConvertHSVtoRGB(hue, 1.f, 1.f, m_colormap[i * 3 + 0], m_colormap[i * 3 + 1], m_colormap[i * 3 + 2]);
+    }
+    m_threads = ImMax(ImGui::get_big_cpu_count(), 1);
+    m_buffers.resize((size_t)m_threads * (m_window + 2));
+}
 
-    int blocks = in_mat.w / window;
-    if (bstft) blocks = in_mat.w / hope - 1;
-    int N_FRQ = (window >> 1) + 1;
-    out_mat.create_type(blocks, N_FRQ, 4, IM_DT_INT8);
-    out_mat.elempack = 4;
-    float* pin = (float *)in_mat.data;
-    float* pin_end =  pin + in_mat.w;
-    if (bstft)
-    {
-        ImGui::ImSTFT stft(window, hope);
-        ImGui::ImMat fft_data, db_data, zero_data;
-        fft_data.create_type(window, IM_DT_FLOAT32);
-        zero_data.create_type(window, IM_DT_FLOAT32);
-        db_data.create_type(N_FRQ, IM_DT_FLOAT32);
-        int current_block = 0;
-        int length = 0;
-        while (length < in_mat.w + window - hope)
-        {
-            float * in_data;
-            if (length < in_mat.w - hope)
-                in_data = pin + length;
-            else
-                in_data = (float *)zero_data.data;
+void ImGui::ImSpectrogramBuilder::reset()
+{
+    m_columns = 0;
+    m_total = 0;
+    m_offset = 0;
+    m_finished = false;
+    m_samples.clear();
+    m_mat.release();
+}
 
-            stft.stft(in_data, (float *)fft_data.data);
-            ImGui::ImReComposeDB((float*)fft_data.data, (float *)db_data.data, fft_data.w, false);
+int ImGui::ImSpectrogramBuilder::append(const ImGui::ImMat& in_mat)
+{
+    assert(in_mat.c == 1 && in_mat.h == 1 && in_mat.type == IM_DT_FLOAT32);
+    return append((const float *)in_mat.data, in_mat.w);
+}
 
-            if (length >= window - hope)
-            {
-                for (int n = 0; n < out_mat.h; n++)
-                {
-                    float value = db_data.at<float>(n) * M_SQRT2 + 64;
-                    value = ImClamp(value, -64.f, 63.f);
-                    float light = (value + 64) / 127.f;
-                    light = ImClamp(light, 0.f, 1.f);
-                    value = (int)((value + 64) + 170) % 255; 
-                    auto hue = value / 255.f;
-                    auto color = ImColor::HSV(hue, 1.0, light);
-                    out_mat.set_pixel(current_block, out_mat.h - n - 1, ImPixel(color.Value.x, color.Value.y, color.Value.z, color.Value.w));
-                }
-                current_block ++;
-            }
-            length += hope;
-        }
+int ImGui::ImSpectrogramBuilder::append(const float* samples, int count)
+{
+    assert(!m_finished && "reset() before appending to a finished spectrogram");
+    if (!samples || count <= 0 || m_finished)
+        return 0;
+    m_samples.insert(m_samples.end(), samples, samples + count);
+    m_total += count;
+    // a column is complete once its whole frame has been received
+    int ready = (int)(m_total / m_hope) - m_lead + 1;
+    if (ready <= m_columns)
+        return 0;
+    int first = m_columns;
+    compute(first, ready, m_total);
+    // keep only the samples the next frame still needs
+    int64_t next_start = (int64_t)(m_columns + m_lead) * m_hope - m_window;
+    if (next_start > m_offset)
+    {
+        size_t drop = (size_t)ImMin<int64_t>(next_start - m_offset, (int64_t)m_samples.size());
+        m_samples.erase(m_samples.begin(), m_samples.begin() + drop);
+        m_offset += drop;
     }
-    else
+    return m_columns - first;
+}
+
+int ImGui::ImSpectrogramBuilder::finish()
+{
+    if (m_finished)
+        return 0;
+    m_finished = true;
+    // stft keeps shifting zero hops through the window after the last full hop of signal
+    int blocks = m_stft ? (int)(m_total / m_hope) - 1 : (int)(m_total / m_window);
+    if (blocks <= m_columns)
+        return 0;
+    int first = m_columns;
+    compute(first, blocks, m_total / m_hope * m_hope);
+    return m_columns - first;
+}
+
+void ImGui::ImSpectrogramBuilder::reserve(int columns)
+{
+    if (columns <= m_mat.w)
+        return;
+    const int N_FRQ = (m_window >> 1) + 1;
+    int capacity = ImMax(ImMax(columns, m_mat.w * 2), 64);
+    ImGui::ImMat mat;
+    mat.create_type(capacity, N_FRQ, 4, IM_DT_INT8);
+    mat.elempack = 4;
+    mat.fill((int8_t)0);
+    if (!m_mat.empty() && m_columns > 0)
     {
-        ImGui::ImMat fft_data, db_data;
-        fft_data.create_type(window, IM_DT_FLOAT32);
-        db_data.create_type(N_FRQ, IM_DT_FLOAT32);
-        int current_block = 0;
-        while (pin < pin_end)
+        for (int y = 0; y < N_FRQ; y++)
+            memcpy((uint8_t *)mat.data + (size_t)y * capacity * 4, (const uint8_t *)m_mat.data + (size_t)y * m_mat.w * 4, (size_t)m_columns * 4);
+    }
+    m_mat = mat;
+}
+
+void ImGui::ImSpectrogramBuilder::get(ImGui::ImMat& out_mat) const
+{
+    const int N_FRQ = (m_window >> 1) + 1;
+    out_mat.create_type(m_columns, N_FRQ, 4, IM_DT_INT8);
+    out_mat.elempack = 4;
+    if (out_mat.empty())
+        return;
+    for (int y = 0; y < N_FRQ; y++)
+        memcpy((uint8_t *)out_mat.data + (size_t)y * m_columns * 4, (const uint8_t *)m_mat.data + (size_t)y * m_mat.w * 4, (size_t)m_columns * 4);
+}
+
+void ImGui::ImSpectrogramBuilder::compute(int first, int last, int64_t valid_end)
+{
+    reserve(last);
+    const int N = m_window >> 1;
+    const int stride = m_mat.w * 4;
+    const float* samples = m_samples.data();
+    const int64_t samples_end = m_offset + (int64_t)m_samples.size();
+    int threads = ImMin(m_threads, last - first);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (int column = first; column < last; column++)
+    {
+        float* frame = m_buffers.data() + (size_t)ImGui::get_omp_thread_num() * (m_window + 2);
+        // gather frame, zero before signal start and after valid_end
+        const int64_t start = (int64_t)(column + m_lead) * m_hope - m_window;
+        const int64_t end = ImMin(ImMin(start + m_window, valid_end), samples_end);
+        const int64_t begin = ImMax<int64_t>(start, 0);
+        int count = end > begin ? (int)(end - begin) : 0;
+        memset(frame, 0, sizeof(float) * (m_window + 2));
+        if (count > 0)
+            memcpy(frame + (begin - start), samples + (begin - m_offset), sizeof(float) * count);
+        if (m_stft)
         {
-            ImGui::ImRFFT(pin, (float*)fft_data.data, window, true);
-            ImGui::ImReComposeDB((float*)fft_data.data, (float *)db_data.data, fft_data.w, false);
-            for (int n = 0; n < out_mat.h; n++)
-            {
-                float value = db_data.at<float>(n) * M_SQRT2 + 64;
-                value = ImClamp(value, -64.f, 63.f);
-                float light = (value + 64) / 127.f;
-                value = (int)((value + 64) + 170) % 255; 
-                auto hue = value / 255.f;
-                auto color = ImColor::HSV(hue, 1.0, light);
-                out_mat.set_pixel(current_block, out_mat.h - n - 1, ImPixel(color.Value.x, color.Value.y, color.Value.z, color.Value.w));
-            }
-            pin += window;
-            current_block ++;
+            const float* hann = m_hann.data();
+            for (int i = 0; i < m_window; i++) frame[i] *= hann[i];
+        }
+        ImGui::ImRFFT(frame, m_window, true);
+        // packed real fft, Nyquist real part sits in frame[1], DC is skipped as in ImReComposeDB
+        frame[m_window] = frame[1];
+        frame[1] = 0;
+        // power to dB and color in place, 20*log10(sqrt(p)) == 10*log10(p)
+        const float zero_power = 1.0f / ((1 << 15) * (float)(1 << 15));
+        frame[0] = zero_power;
+        for (int n = 1; n <= N; n++)
+            frame[n] = frame[2 * n] * frame[2 * n] + frame[2 * n + 1] * frame[2 * n + 1];
+        uint8_t* pixel = (uint8_t *)m_mat.data + (size_t)column * 4 + (size_t)N * stride;
+        for (int n = 0; n <= N; n++, pixel -= stride)
+        {
+            float value = 10.f * log10f(frame[n]) * (float)M_SQRT2 + 64;
+            value = ImClamp(value, -64.f, 63.f) + 64;
+            const float light = value * (UINT8_MAX / 127.f);
+            const float* color = m_colormap + (int)value * 3;
+            pixel[0] = (uint8_t)(color[0] * light);
+            pixel[1] = (uint8_t)(color[1] * light);
+            pixel[2] = (uint8_t)(color[2] * light);
+            pixel[3] = UINT8_MAX;
         }
     }
+    m_columns = last;
 }
 
 // Start CheckboxFlags ==============================================================================================
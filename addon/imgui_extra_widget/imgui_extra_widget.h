@@ -387,6 +387,12 @@ IMGUI_API void ImageInspect(const int width,
                             ImVec2 displayedTextureSize,
                             bool histogram_full = false,
                             int zoom_size = 8);
+// RGBA packed mat, full histogram is cached on mat time_stamp
+IMGUI_API void ImageInspect(const ImMat& mat,
+                            ImVec2 mouseUVCoord,
+                            ImVec2 displayedTextureSize,
+                            bool histogram_full = false,
+                            int zoom_size = 8);
 
 // Show Digital number
 IMGUI_API void ShowDigitalTime(ImDrawList *draw_list, int64_t millisec, int show_millisec, ImVec2 pos, ImU32 color);
@@ -484,6 +490,45 @@ namespace ImGui
 
 IMGUI_API void  ImSpectrogram(const ImMat& in_mat, ImMat& out_mat, int window = 512, bool stft = false, int hope = 128);
 
+// Spectrogram engine, columns are computed in parallel with per thread FFT buffers.
+// append() only computes the columns completed by the new samples, so a recording or
+// a long file can be fed in pieces; finish() adds the zero padded tail columns of a stft.
+class IMGUI_API ImSpectrogramBuilder
+{
+public:
+    ImSpectrogramBuilder(int window = 512, bool stft = false, int hope = 128);
+    void reset();
+    int append(const float* samples, int count);    // return new columns
+    int append(const ImMat& in_mat);
+    int finish();
+    void get(ImMat& out_mat) const;                 // copy to RGBA mat with columns() width
+    const ImMat& data() const { return m_mat; }     // RGBA mat with capacity() width
+    int columns() const { return m_columns; }
+    int capacity() const { return m_mat.w; }
+    int window() const { return m_window; }
+    int hope() const { return m_hope; }
+
+private:
+    void compute(int first, int last, int64_t valid_end);
+    void reserve(int columns);
+
+private:
+    int m_window {512};
+    int m_hope {512};
+    int m_lead {1};
+    bool m_stft {false};
+    int m_threads {1};
+    int m_columns {0};
+    int64_t m_total {0};
+    int64_t m_offset {0};                           // signal index of m_samples[0]
+    bool m_finished {false};
+    std::vector<float> m_samples;
+    std::vector<float> m_hann;
+    std::vector<float> m_buffers;                   // window + 2 floats per thread
+    float m_colormap[128 * 3];
+    ImMat m_mat;
+};
+
 } // namespace ImGui
 
 // custom draw leader
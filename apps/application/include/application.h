@@ -45,6 +45,7 @@ typedef struct ApplicationWindowProperty
     bool full_screen{false};
     bool full_size  {false};
     bool using_setting_path {true};
+    bool font_cache {true};
     bool internationalize {false};
     bool top_most   {false};
     bool window_border {true};
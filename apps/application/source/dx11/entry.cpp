@@ -194,6 +194,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     ImGuiContext& g = *GImGui;
     io.ApplicationName = property.name.c_str();
+    auto font_cache_path = property.font_cache ? ImGuiHelper::cache_path(property.name) : "";
+    if (!font_cache_path.empty()) io.Fonts->CacheDir = font_cache_path.c_str();
     io.Fonts->AddFontDefault(property.font_scale);
     io.FontGlobalScale = 1.0f / property.font_scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnablePowerSavingMode;
@@ -285,14 +287,17 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             const float clear_color_with_alpha[4] = { clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w };
             g_pd3dDeviceContext->OMSetRenderTargets(1, &g_mainRenderTargetView, NULL);
             g_pd3dDeviceContext->ClearRenderTargetView(g_mainRenderTargetView, clear_color_with_alpha);
-            ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+            const bool frame_unchanged = ImGui::GetDrawData()->Unchanged;
+            if (!frame_unchanged)
+                ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
             // Update and Render additional Platform Windows
             if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
             {
                 ImGui::UpdatePlatformWindows();
                 ImGui::RenderPlatformWindowsDefault();
             }
-            g_pSwapChain->Present(1, 0);
+            if (!frame_unchanged) // nothing changed since last frame, keep the presented image
+                g_pSwapChain->Present(1, 0);
         }
     };
 
@@ -181,6 +181,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     ImGuiContext& g = *GImGui;
     io.ApplicationName = property.name.c_str();
+    auto font_cache_path = property.font_cache ? ImGuiHelper::cache_path(property.name) : "";
+    if (!font_cache_path.empty()) io.Fonts->CacheDir = font_cache_path.c_str();
     io.Fonts->AddFontDefault(property.font_scale);
     io.FontGlobalScale = 1.0f / property.font_scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnablePowerSavingMode;
@@ -291,7 +293,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             ImGui::RenderPlatformWindowsDefault();
         }
 
-        HRESULT result = g_pd3dDevice->Present(NULL, NULL, NULL, NULL);
+        // nothing changed since last frame, keep the presented image
+        HRESULT result = ImGui::GetDrawData()->Unchanged ? D3D_OK : g_pd3dDevice->Present(NULL, NULL, NULL, NULL);
 
         // Handle loss of D3D9 device
         if (result == D3DERR_DEVICELOST && g_pd3dDevice->TestCooperativeLevel() == D3DERR_DEVICENOTRESET)
@@ -171,6 +171,8 @@ int main(int argc, char** argv)
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     ImGuiContext& g = *GImGui;
     io.ApplicationName = property.name.c_str();
+    auto font_cache_path = property.font_cache ? ImGuiHelper::cache_path(property.name) : "";
+    if (!font_cache_path.empty()) io.Fonts->CacheDir = font_cache_path.c_str();
     io.Fonts->AddFontDefault(property.font_scale);
     io.FontGlobalScale = 1.0f / property.font_scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnablePowerSavingMode;
@@ -355,7 +357,9 @@ int main(int argc, char** argv)
 #endif
         // Rendering
         ImGui::Render();
-        ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
+        const bool frame_unchanged = ImGui::GetDrawData()->Unchanged;
+        if (!frame_unchanged)
+            ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
         // Update and Render additional Platform Windows
         // (Platform functions may change the current OpenGL context, so we save/restore it to make it easier to paste this code elsewhere.
         //  For this specific demo app we could also call glfwMakeContextCurrent(window) directly)
@@ -366,7 +370,8 @@ int main(int argc, char** argv)
             ImGui::RenderPlatformWindowsDefault();
             glfwMakeContextCurrent(backup_current_context);
         }
-        glfwSwapBuffers(window);
+        if (!frame_unchanged) // nothing changed since last frame, keep the presented image
+            glfwSwapBuffers(window);
     }
 
     if (property.application.Application_Finalize)
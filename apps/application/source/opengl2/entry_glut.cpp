@@ -49,8 +49,13 @@ void glut_display_func()
     glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
     glClear(GL_COLOR_BUFFER_BIT);
     //glUseProgram(0); // You may want this if using this code in an OpenGL 3+ context where shaders may be bound, but prefer using the GL3+ code.
-    ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
-    glutSwapBuffers();
+    const bool frame_unchanged = ImGui::GetDrawData()->Unchanged;
+    if (!frame_unchanged)
+        ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
+    if (!frame_unchanged) // nothing changed since last frame, keep the presented image
+        glutSwapBuffers();
+    else
+        ImGui::WaitUnchangedFrame(); // the skipped swap was the vsync throttle
     glutPostRedisplay();
 }
 
@@ -98,6 +103,8 @@ int main(int argc, char** argv)
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     ImGuiContext& g = *GImGui;
     io.ApplicationName = property.name.c_str();
+    auto font_cache_path = property.font_cache ? ImGuiHelper::cache_path(property.name) : "";
+    if (!font_cache_path.empty()) io.Fonts->CacheDir = font_cache_path.c_str();
     io.Fonts->AddFontDefault(property.font_scale);
     io.FontGlobalScale = 1.0f / property.font_scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnablePowerSavingMode;
@@ -185,6 +185,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     ImGuiIO& io = ImGui::GetIO(); (void)io;
     ImGuiContext& g = *GImGui;
     io.ApplicationName = property.name.c_str();
+    auto font_cache_path = property.font_cache ? ImGuiHelper::cache_path(property.name) : "";
+    if (!font_cache_path.empty()) io.Fonts->CacheDir = font_cache_path.c_str();
     io.Fonts->AddFontDefault(property.font_scale);
     io.FontGlobalScale = 1.0f / property.font_scale;
     if (property.power_save) io.ConfigFlags |= ImGuiConfigFlags_EnablePowerSavingMode;
@@ -290,7 +292,9 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
         // Rendering
         ImGui::Render();
         ImGui_ImplOpenGL2_ClearScreen(ImVec2(0, 0), io.DisplaySize, clear_color);
-        ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
+        const bool frame_unchanged = ImGui::GetDrawData()->Unchanged;
+        if (!frame_unchanged)
+            ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
 
         // Update and Render additional Platform Windows
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
@@ -301,7 +305,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             wglMakeCurrent(g_HDC, backup_context);
         }
 
-        SwapBuffers(g_HDC);
+        if (!frame_unchanged) // nothing changed since last frame, keep the presented image
+            SwapBuffers(g_HDC);
     }
 
     if (property.application.Application_Finalize)
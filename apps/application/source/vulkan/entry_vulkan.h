@@ -396,11 +396,12 @@ static void FrameRendering(ImGui_ImplVulkanH_Window* wd)
     ImVec4 clear_color = ImVec4(0.f, 0.f, 0.f, 1.f);
     ImDrawData* main_draw_data = ImGui::GetDrawData();
     const bool main_is_minimized = (main_draw_data->DisplaySize.x <= 0.0f || main_draw_data->DisplaySize.y <= 0.0f);
+    const bool main_is_unchanged = main_draw_data->Unchanged; // nothing changed since last frame, keep the presented image
     wd->ClearValue.color.float32[0] = clear_color.x * clear_color.w;
     wd->ClearValue.color.float32[1] = clear_color.y * clear_color.w;
     wd->ClearValue.color.float32[2] = clear_color.z * clear_color.w;
     wd->ClearValue.color.float32[3] = clear_color.w;
-    if (!main_is_minimized)
+    if (!main_is_minimized && !main_is_unchanged)
         FrameRender(wd, main_draw_data);
 
     // Update and Render additional Platform Windows
@@ -411,6 +412,6 @@ static void FrameRendering(ImGui_ImplVulkanH_Window* wd)
     }
 
     // Present Main Platform Window
-    if (!main_is_minimized)
+    if (!main_is_minimized && !main_is_unchanged)
         FramePresent(wd);
 }
@@ -181,6 +181,7 @@ struct ImGui_ImplGlfw_Data
     GLFWkeyfun              PrevUserCallbackKey;
     GLFWcharfun             PrevUserCallbackChar;
     GLFWmonitorfun          PrevUserCallbackMonitor;
+    GLFWwindowrefreshfun    PrevUserCallbackWindowRefresh;  // Add by Dicky
 #ifdef _WIN32
     WNDPROC                 PrevWndProc;
 #endif
@@ -463,6 +464,17 @@ void ImGui_ImplGlfw_WindowFocusCallback(GLFWwindow* window, int focused)
     io.AddFocusEvent(focused != 0);
 }
 
+// Add by Dicky: the window content was lost (exposed, restored), don't skip the next frame with io.ConfigSkipUnchangedFrames
+void ImGui_ImplGlfw_WindowRefreshCallback(GLFWwindow* window)
+{
+    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
+    if (bd->PrevUserCallbackWindowRefresh != nullptr && ImGui_ImplGlfw_ShouldChainCallback(window))
+        bd->PrevUserCallbackWindowRefresh(window);
+
+    if (ImGuiViewport* viewport = ImGui::FindViewportByPlatformHandle((void*)window))
+        ImGui::InvalidateViewportDrawData(viewport);
+}
+
 void ImGui_ImplGlfw_CursorPosCallback(GLFWwindow* window, double x, double y)
 {
     ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
@@ -557,6 +569,7 @@ void ImGui_ImplGlfw_InstallCallbacks(GLFWwindow* window)
     bd->PrevUserCallbackKey = glfwSetKeyCallback(window, ImGui_ImplGlfw_KeyCallback);
     bd->PrevUserCallbackChar = glfwSetCharCallback(window, ImGui_ImplGlfw_CharCallback);
     bd->PrevUserCallbackMonitor = glfwSetMonitorCallback(ImGui_ImplGlfw_MonitorCallback);
+    bd->PrevUserCallbackWindowRefresh = glfwSetWindowRefreshCallback(window, ImGui_ImplGlfw_WindowRefreshCallback); // Add by Dicky
     bd->InstalledCallbacks = true;
 }
 
@@ -574,6 +587,7 @@ void ImGui_ImplGlfw_RestoreCallbacks(GLFWwindow* window)
     glfwSetKeyCallback(window, bd->PrevUserCallbackKey);
     glfwSetCharCallback(window, bd->PrevUserCallbackChar);
     glfwSetMonitorCallback(bd->PrevUserCallbackMonitor);
+    glfwSetWindowRefreshCallback(window, bd->PrevUserCallbackWindowRefresh); // Add by Dicky
     bd->InstalledCallbacks = false;
     bd->PrevUserCallbackWindowFocus = nullptr;
     bd->PrevUserCallbackCursorEnter = nullptr;
@@ -583,6 +597,7 @@ void ImGui_ImplGlfw_RestoreCallbacks(GLFWwindow* window)
     bd->PrevUserCallbackKey = nullptr;
     bd->PrevUserCallbackChar = nullptr;
     bd->PrevUserCallbackMonitor = nullptr;
+    bd->PrevUserCallbackWindowRefresh = nullptr; // Add by Dicky
 }
 
 // Set to 'true' to enable chaining installed callbacks for all windows (including secondary viewports created by backends or by user.
@@ -1133,6 +1148,7 @@ static void ImGui_ImplGlfw_CreateWindow(ImGuiViewport* viewport)
     glfwSetWindowCloseCallback(vd->Window, ImGui_ImplGlfw_WindowCloseCallback);
     glfwSetWindowPosCallback(vd->Window, ImGui_ImplGlfw_WindowPosCallback);
     glfwSetWindowSizeCallback(vd->Window, ImGui_ImplGlfw_WindowSizeCallback);
+    glfwSetWindowRefreshCallback(vd->Window, ImGui_ImplGlfw_WindowRefreshCallback); // Add by Dicky
     if (bd->ClientApi == GlfwClientApi_OpenGL)
     {
         glfwMakeContextCurrent(vd->Window);
@@ -1430,11 +1446,18 @@ void ImGui_ImplGlfw_WaitForEvent()
     auto count = ImGui::GetIO().FrameCountSinceLastUpdate;
     auto delay_count = ImGui::GetIO().MaxDelayFrameCount;
     auto long_delay = 1000.0 / (ImGui::GetIO().MinFrameRate + FLT_EPSILON);
+    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
+    if (ImGui::GetIO().ConfigSkipUnchangedFrames)
+    {
+        // The skipped swap of an unchanged frame was the vsync throttle
+        GLFWmonitor* monitor = glfwGetWindowMonitor(bd->Window);
+        const GLFWvidmode* mode = glfwGetVideoMode(monitor ? monitor : glfwGetPrimaryMonitor());
+        ImGui::WaitUnchangedFrame(mode ? (float)mode->refreshRate : 0.0f);
+    }
     if (!(flags & ImGuiConfigFlags_EnablePowerSavingMode) &&
         !(flags & ImGuiConfigFlags_EnableLowRefreshMode))
         return;
 
-    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
     bool window_is_hidden = !glfwGetWindowAttrib(bd->Window, GLFW_VISIBLE) || glfwGetWindowAttrib(bd->Window, GLFW_ICONIFIED);
     if (window_is_hidden) glfwWaitEvents();
     else if (flags & ImGuiConfigFlags_EnableLowRefreshMode && !(flags & ImGuiConfigFlags_EnablePowerSavingMode))
@@ -1452,7 +1475,9 @@ void ImGui_ImplGlfw_WaitForEvent()
         else if (count > delay_count)
         {
             //glfwWaitEvents();
-            glfwWaitEventsTimeout(long_delay);
+            const double animation_wait = ImGui::GetAnimatedRegionWaitingTime();
+            const double wait = long_delay / 1000.0; // the idle timeout caps the animation wait (INFINITY when none), in seconds
+            glfwWaitEventsTimeout(animation_wait < wait ? animation_wait : wait);
         }
     }
 }
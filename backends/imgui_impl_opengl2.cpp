@@ -99,6 +99,7 @@ bool    ImGui_ImplOpenGL2_Init()
     io.BackendRendererUserData = (void*)bd;
     io.BackendRendererName = "imgui_impl_opengl2";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasViewports;    // We can create multi-viewports on the Renderer side (optional)
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasDynamicGlyphs; // We upload the rows of the dynamic glyph cache. // add by Dicky
 
     if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
         ImGui_ImplOpenGL2_InitPlatformInterface();
@@ -135,7 +136,7 @@ void    ImGui_ImplOpenGL2_Shutdown()
     ImGui_ImplOpenGL2_DestroyDeviceObjects();
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasViewports;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasViewports | ImGuiBackendFlags_RendererHasDynamicGlyphs); // modify by Dicky
     IM_DELETE(bd);
 }
 
@@ -197,6 +198,23 @@ static void ImGui_ImplOpenGL2_SetupRenderState(ImDrawData* draw_data, int fb_wid
 // OpenGL2 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
+// add by Dicky, upload the rows written by the dynamic glyph cache (ImFontAtlasFlags_DynamicGlyphs) since the last frame
+static void ImGui_ImplOpenGL2_UpdateFontsTexture()
+{
+    ImGui_ImplOpenGL2_Data* bd = ImGui_ImplOpenGL2_GetBackendData();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    int y = 0, h = 0;
+    if (!bd->FontTexture || !atlas->TexPixelsRGBA32 || !atlas->GetTexDataDirtyRows(&y, &h))
+        return;
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glBindTexture(GL_TEXTURE_2D, bd->FontTexture->gID);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, atlas->TexWidth, h, GL_RGBA, GL_UNSIGNED_BYTE, atlas->TexPixelsRGBA32 + (size_t)y * atlas->TexWidth);
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+}
+// add by Dicky end
+
 void ImGui_ImplOpenGL2_RenderDrawData(ImDrawData* draw_data)
 {
     // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
@@ -204,6 +222,7 @@ void ImGui_ImplOpenGL2_RenderDrawData(ImDrawData* draw_data)
     int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
     if (fb_width == 0 || fb_height == 0)
         return;
+    ImGui_ImplOpenGL2_UpdateFontsTexture(); // add by Dicky
 
     // Backup GL state
     GLint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
@@ -231,6 +231,7 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationTextSDF;   // add by Dicky
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -348,6 +349,7 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
 #endif
     io.BackendFlags |= ImGuiBackendFlags_RendererHasViewports;  // We can create multi-viewports on the Renderer side (optional)
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasDynamicGlyphs; // We upload the rows of the dynamic glyph cache. // add by Dicky
 
     // Store GLSL version string so we can refer to it later in case we recreate shaders.
     // Note: GLSL version is NOT the same as GL version. Leave this to nullptr if unsure.
@@ -367,6 +369,13 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     strcpy(bd->GlslVersionString, glsl_version);
     strcat(bd->GlslVersionString, "\n");
 
+    // add by Dicky, the SDF text shaders need derivatives, missing from GLSL ES 1.00
+    int glsl_version_num = 130;
+    sscanf(bd->GlslVersionString, "#version %d", &glsl_version_num);
+    if (glsl_version_num >= 130)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTextSDF;
+    // add by Dicky end
+
     // Make an arbitrary GL call (we don't actually need the result)
     // IF YOU GET A CRASH HERE: it probably means the OpenGL function loader didn't do its job. Let us know!
     GLint current_texture;
@@ -404,7 +413,7 @@ void    ImGui_ImplOpenGL3_Shutdown()
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasViewports);
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasViewports | ImGuiBackendFlags_RendererHasTextSDF | ImGuiBackendFlags_RendererHasDynamicGlyphs); // modify by Dicky
     IM_DELETE(bd);
 }
 
@@ -470,6 +479,8 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     };
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
+    if (bd->AttribLocationTextSDF != -1)
+        glUniform1i(bd->AttribLocationTextSDF, 0); // add by Dicky
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
@@ -496,6 +507,25 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
+// add by Dicky, upload the rows written by the dynamic glyph cache (ImFontAtlasFlags_DynamicGlyphs) since the last frame
+static void ImGui_ImplOpenGL3_UpdateFontsTexture()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    int y = 0, h = 0;
+    if (!bd->FontTexture || !atlas->TexPixelsRGBA32 || !atlas->GetTexDataDirtyRows(&y, &h))
+        return;
+    GLint last_texture;
+    GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, bd->FontTexture->gID));
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+    GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+    GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, atlas->TexWidth, h, GL_RGBA, GL_UNSIGNED_BYTE, atlas->TexPixelsRGBA32 + (size_t)y * atlas->TexWidth));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
+}
+// add by Dicky end
+
 void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 {
     // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
@@ -505,6 +535,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         return;
 
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImGui_ImplOpenGL3_UpdateFontsTexture(); // add by Dicky
 
     // Backup GL state
     GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
@@ -553,6 +584,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     GL_CALL(glGenVertexArrays(1, &vertex_array_object));
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+    bool text_sdf = false; // add by Dicky, TextSDF uniform value
 
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
@@ -602,7 +634,10 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    text_sdf = false; // add by Dicky
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
@@ -623,6 +658,12 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 ImTextureGl texture_id = (ImTextureGl)pcmd->GetTexID();
                 if (!texture_id) continue;
                 GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)texture_id->gID));
+                if (bd->AttribLocationTextSDF != -1 && (texture_id == bd->FontTexture) != text_sdf)
+                {
+                    // Only the font texture holds SDF glyphs, other textures may use any UV
+                    text_sdf = (texture_id == bd->FontTexture);
+                    GL_CALL(glUniform1i(bd->AttribLocationTextSDF, text_sdf ? 1 : 0));
+                }
                 // modify by Dicky end
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
@@ -855,36 +896,60 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
         "}\n";
 
+    // modify by Dicky for SDF text (ImGuiBackendFlags_RendererHasTextSDF)
+    // With the font texture (TextSDF), UVs of SDF glyphs are offset by 2 * k, k.x - 1 is the dilation and k.y the softness in 1/126 of the distance range (see IM_DRAWLIST_TEXT_SDF_UV)
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform int TextSDF;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec2 sdf = TextSDF != 0 ? floor(Frag_UV * 0.5) : vec2(0.0);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st - sdf * 2.0);\n"
+        "    float aa = length(vec2(dFdx(tex.a), dFdy(tex.a))) * 0.7071;\n"
+        "    float threshold = 0.5 - (sdf.x - 1.0) / 126.0;\n"
+        "    float softness = max(max(aa, sdf.y / 126.0), 0.001);\n"
+        "    float alpha = sdf.x >= 1.0 ? smoothstep(threshold - softness, threshold + softness, tex.a) : tex.a;\n"
+        "    Out_Color = Frag_Color * vec4(tex.rgb, alpha);\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
-        "in vec2 Frag_UV;\n"
+        "uniform int TextSDF;\n"
+        "in highp vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    highp vec2 sdf = TextSDF != 0 ? floor(Frag_UV * 0.5) : vec2(0.0);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st - sdf * 2.0);\n"
+        "    float aa = length(vec2(dFdx(tex.a), dFdy(tex.a))) * 0.7071;\n"
+        "    float threshold = 0.5 - (sdf.x - 1.0) / 126.0;\n"
+        "    float softness = max(max(aa, sdf.y / 126.0), 0.001);\n"
+        "    float alpha = sdf.x >= 1.0 ? smoothstep(threshold - softness, threshold + softness, tex.a) : tex.a;\n"
+        "    Out_Color = Frag_Color * vec4(tex.rgb, alpha);\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int TextSDF;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec2 sdf = TextSDF != 0 ? floor(Frag_UV * 0.5) : vec2(0.0);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st - sdf * 2.0);\n"
+        "    float aa = length(vec2(dFdx(tex.a), dFdy(tex.a))) * 0.7071;\n"
+        "    float threshold = 0.5 - (sdf.x - 1.0) / 126.0;\n"
+        "    float softness = max(max(aa, sdf.y / 126.0), 0.001);\n"
+        "    float alpha = sdf.x >= 1.0 ? smoothstep(threshold - softness, threshold + softness, tex.a) : tex.a;\n"
+        "    Out_Color = Frag_Color * vec4(tex.rgb, alpha);\n"
         "}\n";
+    // modify by Dicky end
 
     // Select shaders matching our GLSL versions
     const GLchar* vertex_shader = nullptr;
@@ -937,6 +1002,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationTextSDF = glGetUniformLocation(bd->ShaderHandle, "TextSDF"); // add by Dicky, -1 with the GLSL 1.20 shader
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
@@ -486,9 +486,12 @@ bool ImGui_ImplSDL2_ProcessEvent(const SDL_Event* event)
                 io.AddFocusEvent(true);
             else if (window_event == SDL_WINDOWEVENT_FOCUS_LOST)
                 io.AddFocusEvent(false);
-            if (window_event == SDL_WINDOWEVENT_CLOSE || window_event == SDL_WINDOWEVENT_MOVED || window_event == SDL_WINDOWEVENT_RESIZED)
+            if (window_event == SDL_WINDOWEVENT_CLOSE || window_event == SDL_WINDOWEVENT_MOVED || window_event == SDL_WINDOWEVENT_RESIZED ||
+                window_event == SDL_WINDOWEVENT_EXPOSED || window_event == SDL_WINDOWEVENT_RESTORED) // modify by Dicky
                 if (ImGuiViewport* viewport = ImGui::FindViewportByPlatformHandle((void*)SDL_GetWindowFromID(event->window.windowID)))
                 {
+                    if (window_event == SDL_WINDOWEVENT_EXPOSED || window_event == SDL_WINDOWEVENT_RESTORED) // Add by Dicky: the window content was lost, draw the next frame
+                        ImGui::InvalidateViewportDrawData(viewport);
                     if (window_event == SDL_WINDOWEVENT_CLOSE)
                         viewport->PlatformRequestClose = true;
                     if (window_event == SDL_WINDOWEVENT_MOVED)
@@ -1237,11 +1240,17 @@ void ImGui_ImplSDL2_WaitForEvent()
     auto count = ImGui::GetIO().FrameCountSinceLastUpdate;
     auto delay_count = ImGui::GetIO().MaxDelayFrameCount;
     auto long_delay = 1000.0 / (ImGui::GetIO().MinFrameRate + FLT_EPSILON);
+    ImGui_ImplSDL2_Data* bd = ImGui_ImplSDL2_GetBackendData();
+    if (ImGui::GetIO().ConfigSkipUnchangedFrames)
+    {
+        // The skipped swap of an unchanged frame was the vsync throttle
+        SDL_DisplayMode mode;
+        ImGui::WaitUnchangedFrame(SDL_GetWindowDisplayMode(bd->Window, &mode) == 0 ? (float)mode.refresh_rate : 0.0f);
+    }
     if (!(flags & ImGuiConfigFlags_EnablePowerSavingMode) &&
         !(flags & ImGuiConfigFlags_EnableLowRefreshMode))
         return;
 
-    ImGui_ImplSDL2_Data* bd = ImGui_ImplSDL2_GetBackendData();
     Uint32 window_flags = SDL_GetWindowFlags(bd->Window);
     bool window_is_hidden = window_flags & (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED);
 
@@ -1261,7 +1270,9 @@ void ImGui_ImplSDL2_WaitForEvent()
         else if (count > delay_count)
         {
             //SDL_WaitEvent(nullptr);
-            SDL_WaitEventTimeout(nullptr, long_delay);
+            const double animation_wait = ImGui::GetAnimatedRegionWaitingTime();
+            const double wait_ms = 1000.0 * animation_wait; // the idle timeout caps the animation wait (INFINITY when none)
+            SDL_WaitEventTimeout(nullptr, (int)(wait_ms < long_delay ? wait_ms : long_delay));
         }
     }
 }
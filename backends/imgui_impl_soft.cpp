@@ -0,0 +1,996 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer
+// - Rasterizes ImDrawData into an RGBA ImGui::ImMat, no GPU or windowing API needed.
+// - Meant for UI screenshots, regression images and server side previews on headless machines.
+// This needs to be used along with a Platform Backend, or a null platform which fills io.DisplaySize and io.DeltaTime.
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImTextureSoft' (see ImGui_ImplSoft_CreateTexture) as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Bilinear texture sampling, SRC_ALPHA/ONE_MINUS_SRC_ALPHA blending, same as the OpenGL backends.
+//  [X] Renderer: ImDrawCmd clip rectangles are applied exactly like glScissor() in the OpenGL backends.
+//  [X] Renderer: Screen is split into tiles rendered in parallel, output doesn't depend on the thread count.
+//  [ ] Renderer: Multi-viewport support.
+
+// How it works:
+//  - Every triangle is snapped to 1/16 pixel and set up once: integer edge functions with a top-left fill rule,
+//    so triangles sharing an edge never draw a pixel twice, and linear planes for color and UV.
+//  - Triangles are binned into 64x64 tiles in submission order. Tiles are independent, the worker threads pull
+//    them from a shared counter and draw their triangles in order, so blending order is the same as on a GPU.
+//  - Inside a tile a triangle is either rejected, fully covering (no edge tests) or rasterized 4 pixels at a
+//    time with SSE2 edge functions. Within a tile edge values fit in 32 bits.
+//  - Axis aligned quads (rectangles, glyphs, images) are recognized from their indices and filled as one
+//    rectangle, covering exactly the pixels their two triangles would.
+//  - Solid color triangles (the bulk of any UI) blend 4 pixels at a time, AA fringes only interpolate the color,
+//    glyphs and images sample the texture with bilinear filtering and clamp to edge addressing.
+//  - User callbacks flush the pending triangles and run on the calling thread.
+
+#include "imgui.h"
+#ifndef IMGUI_DISABLE
+#include "imgui_impl_soft.h"
+#include "imgui_internal.h"     // ImMin, ImMax, ImSwap
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMGUI_IMPL_SOFT_SSE2
+#endif
+
+#define IMGUI_IMPL_SOFT_TILE_SHIFT      6                               // 64x64 pixels tiles
+#define IMGUI_IMPL_SOFT_TILE_SIZE       (1 << IMGUI_IMPL_SOFT_TILE_SHIFT)
+#define IMGUI_IMPL_SOFT_SUBPIXEL_BITS   4                               // vertices are snapped to 1/16 pixel
+#define IMGUI_IMPL_SOFT_SUBPIXEL        (1 << IMGUI_IMPL_SOFT_SUBPIXEL_BITS)
+#define IMGUI_IMPL_SOFT_GUARD_BAND      (1 << 22)                       // triangles reaching farther than this (in pixels) are dropped
+
+enum ImGui_ImplSoft_TriangleFlags
+{
+    ImGui_ImplSoft_TriangleFlags_None       = 0,
+    ImGui_ImplSoft_TriangleFlags_ConstColor = 1 << 0,   // all vertices share the same color
+    ImGui_ImplSoft_TriangleFlags_ConstUV    = 1 << 1,   // all vertices share the same UV, the texel is sampled once
+    ImGui_ImplSoft_TriangleFlags_Flat       = ImGui_ImplSoft_TriangleFlags_ConstColor | ImGui_ImplSoft_TriangleFlags_ConstUV,
+    ImGui_ImplSoft_TriangleFlags_Wide       = 1 << 2,   // edge steps don't fit 32 bits, always use the 64 bits path
+    ImGui_ImplSoft_TriangleFlags_Rect       = 1 << 3,   // axis aligned quad (two triangles) covering its bounds, no edges
+};
+
+struct ImGui_ImplSoft_Triangle
+{
+    int64_t         EdgeA[3];   // E(x, y) = A * x + B * y + C, in sub pixel units, positive inside
+    int64_t         EdgeB[3];
+    int64_t         EdgeC[3];   // at the center of pixel (MinX, MinY), fill rule bias included
+    int             MinX, MinY, MaxX, MaxY; // pixel bounds clipped to the scissor rectangle, max exclusive
+    float           Attr[6][3]; // R, G, B, A (0..255), U, V planes: value at (MinX, MinY), d/dx, d/dy
+    ImU32           Color;      // flat source color, or vertex color when ConstColor
+    int             Flags;
+    ImTextureSOFT*  Texture;
+};
+
+// Software Renderer Data
+struct ImGui_ImplSoft_Data
+{
+    ImTextureSOFT*                  FontTexture;
+    int                             ThreadCount;
+    std::vector<std::thread>        Workers;
+    std::mutex                      Mutex;
+    std::condition_variable         WorkCond;
+    std::condition_variable         DoneCond;
+    int                             Generation;
+    int                             Busy;
+    bool                            Quit;
+    std::atomic<int>                NextTile;
+
+    // Per frame
+    ImGui::ImMat*                   Target;
+    int                             TilesX, TilesY;
+    ImVector<ImGui_ImplSoft_Triangle> Triangles;
+    std::vector<ImVector<int>>      Bins;
+    ImVector<int>                   ActiveTiles;
+
+    ImGui_ImplSoft_Data() : FontTexture(nullptr), ThreadCount(1), Generation(0), Busy(0), Quit(false), NextTile(0), Target(nullptr), TilesX(0), TilesY(0) {}
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+static ImGui_ImplSoft_Data* ImGui_ImplSoft_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoft_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Pixel helpers, colors are ImU32 (R in the low byte) which is also the byte order of the RGBA ImMat
+//-----------------------------------------------------------------------------
+
+// dst * (1 - a) + src * a for RGB, a + dst.a * (1 - a) for alpha, rounded
+static inline ImU32 ImGui_ImplSoft_Blend(ImU32 dst, ImU32 src)
+{
+    const ImU32 a = src >> 24;
+    if (a == 255) return src;
+    if (a == 0) return dst;
+    const ImU32 ia = 255 - a;
+    ImU32 rb = (dst & 0x00FF00FF) * ia + (src & 0x00FF00FF) * a + 0x00800080;
+    ImU32 ga = ((dst >> 8) & 0x00FF00FF) * ia + (((src >> 8) & 0xFF) | 0x00FF0000) * a + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    ga = (ga + ((ga >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+    return rb | ga;
+}
+
+static inline ImU32 ImGui_ImplSoft_Lerp(ImU32 a, ImU32 b, ImU32 w)
+{
+    const ImU32 iw = 256 - w;
+    const ImU32 rb = ((((a & 0x00FF00FF) * iw) + ((b & 0x00FF00FF) * w)) >> 8) & 0x00FF00FF;
+    const ImU32 ga = ((((a >> 8) & 0x00FF00FF) * iw) + (((b >> 8) & 0x00FF00FF) * w)) & 0xFF00FF00;
+    return rb | ga;
+}
+
+// Bilinear filtering with clamp to edge addressing, like GL_LINEAR. Coordinates are 16.16 fixed point in texel
+// space, with texel centers on integers.
+static inline ImU32 ImGui_ImplSoft_SampleFixed(const ImGui::ImMat& mat, int fu, int fv)
+{
+    const ImU32* texels = (const ImU32*)mat.data;
+    const int w = mat.w, h = mat.h;
+    const int ix = fu >> 16, iy = fv >> 16;
+    const ImU32 wx = (fu >> 8) & 0xFF, wy = (fv >> 8) & 0xFF;
+    if ((unsigned)ix < (unsigned)(w - 1) && (unsigned)iy < (unsigned)(h - 1))
+    {
+        const ImU32* p = texels + iy * w + ix;
+        if (!(wx | wy))
+            return p[0];
+        return ImGui_ImplSoft_Lerp(ImGui_ImplSoft_Lerp(p[0], p[1], wx), ImGui_ImplSoft_Lerp(p[w], p[w + 1], wx), wy);
+    }
+    const int x0 = ImClamp(ix, 0, w - 1), x1 = ImClamp(ix + 1, 0, w - 1);
+    const int y0 = ImClamp(iy, 0, h - 1), y1 = ImClamp(iy + 1, 0, h - 1);
+    const ImU32* row0 = texels + y0 * w;
+    const ImU32* row1 = texels + y1 * w;
+    return ImGui_ImplSoft_Lerp(ImGui_ImplSoft_Lerp(row0[x0], row0[x1], wx), ImGui_ImplSoft_Lerp(row1[x0], row1[x1], wx), wy);
+}
+
+// Texel space coordinate (u * size - 0.5) to 16.16, clamped far enough to keep the edge texels
+static inline int ImGui_ImplSoft_ToFixed(float t, int size)
+{
+    t = t > -1.f ? t : -1.f;
+    t = t < (float)size ? t : (float)size;
+    return (int)floorf(t * 65536.f);
+}
+
+static inline ImU32 ImGui_ImplSoft_Sample(const ImTextureSOFT* texture, float u, float v)
+{
+    const ImGui::ImMat& mat = texture->mat;
+    return ImGui_ImplSoft_SampleFixed(mat, ImGui_ImplSoft_ToFixed(u * mat.w - 0.5f, mat.w), ImGui_ImplSoft_ToFixed(v * mat.h - 0.5f, mat.h));
+}
+
+static inline ImU32 ImGui_ImplSoft_Div255(ImU32 x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// texel * color / 255, per channel
+static inline ImU32 ImGui_ImplSoft_Modulate(ImU32 texel, ImU32 color)
+{
+    if (color == 0xFFFFFFFF) return texel;
+    if (texel == 0xFFFFFFFF) return color;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= ImGui_ImplSoft_Div255(((texel >> shift) & 0xFF) * ((color >> shift) & 0xFF)) << shift;
+    return out;
+}
+
+static inline ImU32 ImGui_ImplSoft_PackColor(float r, float g, float b, float a)
+{
+    // + 0.5f rounds, planes are clamped because the extrapolation at pixel centers outside of the triangle edges
+    // (or float drift) can go slightly out of range
+    r = r < 0.f ? 0.f : r > 255.f ? 255.f : r;
+    g = g < 0.f ? 0.f : g > 255.f ? 255.f : g;
+    b = b < 0.f ? 0.f : b > 255.f ? 255.f : b;
+    a = a < 0.f ? 0.f : a > 255.f ? 255.f : a;
+    return (ImU32)(r + 0.5f) | ((ImU32)(g + 0.5f) << 8) | ((ImU32)(b + 0.5f) << 16) | ((ImU32)(a + 0.5f) << 24);
+}
+
+//-----------------------------------------------------------------------------
+// Rasterizer
+//-----------------------------------------------------------------------------
+
+// Shade and blend the covered pixels [x0, x1) of row y
+static void ImGui_ImplSoft_ShadeSpan(const ImGui_ImplSoft_Triangle& tri, ImU32* row, int x0, int x1, int y)
+{
+    int x = x0;
+    if ((tri.Flags & ImGui_ImplSoft_TriangleFlags_Flat) == ImGui_ImplSoft_TriangleFlags_Flat)
+    {
+        const ImU32 color = tri.Color;
+        const ImU32 a = color >> 24;
+        if (a == 255)
+        {
+            for (; x < x1; x++)
+                row[x] = color;
+            return;
+        }
+#ifdef IMGUI_IMPL_SOFT_SSE2
+        // Same math as ImGui_ImplSoft_Blend() on 16 bits lanes, 4 pixels at a time
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ia = _mm_set1_epi16((short)(255 - a));
+        const __m128i src = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)(color | 0xFF000000)), zero), _mm_set1_epi16((short)a));
+        const __m128i bias = _mm_add_epi16(_mm_unpacklo_epi64(src, src), _mm_set1_epi16(128));
+        for (; x + 4 <= x1; x += 4)
+        {
+            const __m128i d = _mm_loadu_si128((const __m128i*)(row + x));
+            __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), ia), bias);
+            __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), ia), bias);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            _mm_storeu_si128((__m128i*)(row + x), _mm_packus_epi16(lo, hi));
+        }
+#endif
+        for (; x < x1; x++)
+            row[x] = ImGui_ImplSoft_Blend(row[x], color);
+        return;
+    }
+
+    const float fx = (float)(x0 - tri.MinX), fy = (float)(y - tri.MinY);
+    float r = 0.f, g = 0.f, b = 0.f, a = 0.f;
+    if (!(tri.Flags & ImGui_ImplSoft_TriangleFlags_ConstColor) || (tri.Flags & ImGui_ImplSoft_TriangleFlags_ConstUV))
+    {
+        r = tri.Attr[0][0] + tri.Attr[0][1] * fx + tri.Attr[0][2] * fy;
+        g = tri.Attr[1][0] + tri.Attr[1][1] * fx + tri.Attr[1][2] * fy;
+        b = tri.Attr[2][0] + tri.Attr[2][1] * fx + tri.Attr[2][2] * fy;
+        a = tri.Attr[3][0] + tri.Attr[3][1] * fx + tri.Attr[3][2] * fy;
+    }
+    if (tri.Flags & ImGui_ImplSoft_TriangleFlags_ConstUV)
+    {
+        // AA fringes, color planes were premultiplied by the texel at setup
+        for (; x < x1; x++)
+        {
+            row[x] = ImGui_ImplSoft_Blend(row[x], ImGui_ImplSoft_PackColor(r, g, b, a));
+            r += tri.Attr[0][1]; g += tri.Attr[1][1]; b += tri.Attr[2][1]; a += tri.Attr[3][1];
+        }
+        return;
+    }
+    // Step the texel coordinates in 16.16 fixed point when they can't overflow, span is at most a tile wide
+    const ImGui::ImMat& mat = tri.Texture->mat;
+    float tu = (tri.Attr[4][0] + tri.Attr[4][1] * fx + tri.Attr[4][2] * fy) * mat.w - 0.5f, dtu = tri.Attr[4][1] * mat.w;
+    float tv = (tri.Attr[5][0] + tri.Attr[5][1] * fx + tri.Attr[5][2] * fy) * mat.h - 0.5f, dtv = tri.Attr[5][1] * mat.h;
+    const bool fixed = fabsf(tu) < 16384.f && fabsf(tv) < 16384.f && fabsf(dtu) < 128.f && fabsf(dtv) < 128.f;
+    int fu = 0, fv = 0, dfu = 0, dfv = 0;
+    if (fixed)
+    {
+        fu = (int)floorf(tu * 65536.f); dfu = (int)(dtu * 65536.f);
+        fv = (int)floorf(tv * 65536.f); dfv = (int)(dtv * 65536.f);
+    }
+    for (; x < x1; x++)
+    {
+        ImU32 texel;
+        if (fixed)
+        {
+            texel = ImGui_ImplSoft_SampleFixed(mat, fu, fv);
+            fu += dfu; fv += dfv;
+        }
+        else
+        {
+            texel = ImGui_ImplSoft_SampleFixed(mat, ImGui_ImplSoft_ToFixed(tu, mat.w), ImGui_ImplSoft_ToFixed(tv, mat.h));
+            tu += dtu; tv += dtv;
+        }
+        if (tri.Flags & ImGui_ImplSoft_TriangleFlags_ConstColor)
+        {
+            // Glyphs and images
+            if (texel >> 24)
+                row[x] = ImGui_ImplSoft_Blend(row[x], ImGui_ImplSoft_Modulate(texel, tri.Color));
+            continue;
+        }
+        row[x] = ImGui_ImplSoft_Blend(row[x], ImGui_ImplSoft_Modulate(texel, ImGui_ImplSoft_PackColor(r, g, b, a)));
+        r += tri.Attr[0][1]; g += tri.Attr[1][1]; b += tri.Attr[2][1]; a += tri.Attr[3][1];
+    }
+}
+
+// Triangle fully covers the rectangle, no edge tests
+static void ImGui_ImplSoft_FillRect(const ImGui_ImplSoft_Triangle& tri, ImU32* pixels, int stride, int x0, int y0, int x1, int y1)
+{
+    for (int y = y0; y < y1; y++)
+        ImGui_ImplSoft_ShadeSpan(tri, pixels + (size_t)y * stride, x0, x1, y);
+}
+
+// 64 bits edge functions, one pixel at a time, for triangles too wide for the 32 bits path
+static void ImGui_ImplSoft_RasterWide(const ImGui_ImplSoft_Triangle& tri, ImU32* pixels, int stride, int x0, int y0, int x1, int y1)
+{
+    const int64_t step_x[3] = { tri.EdgeA[0] * IMGUI_IMPL_SOFT_SUBPIXEL, tri.EdgeA[1] * IMGUI_IMPL_SOFT_SUBPIXEL, tri.EdgeA[2] * IMGUI_IMPL_SOFT_SUBPIXEL };
+    for (int y = y0; y < y1; y++)
+    {
+        int64_t e[3];
+        for (int i = 0; i < 3; i++)
+            e[i] = tri.EdgeC[i] + (tri.EdgeA[i] * (x0 - tri.MinX) + tri.EdgeB[i] * (y - tri.MinY)) * IMGUI_IMPL_SOFT_SUBPIXEL;
+        // Covered pixels of a row are contiguous
+        int span_x0 = x1, span_x1 = x1;
+        for (int x = x0; x < x1; x++)
+        {
+            const bool inside = (e[0] | e[1] | e[2]) >= 0;
+            if (inside && span_x0 == x1)
+                span_x0 = x;
+            else if (!inside && span_x0 != x1)
+            {
+                span_x1 = x;
+                break;
+            }
+            e[0] += step_x[0]; e[1] += step_x[1]; e[2] += step_x[2];
+        }
+        if (span_x0 < span_x1)
+            ImGui_ImplSoft_ShadeSpan(tri, pixels + (size_t)y * stride, span_x0, span_x1, y);
+    }
+}
+
+static inline int ImGui_ImplSoft_LowestBit(int mask)    { int i = 0; while (!(mask & (1 << i))) i++; return i; }
+static inline int ImGui_ImplSoft_HighestBit(int mask)   { int i = 3; while (!(mask & (1 << i))) i--; return i; }
+
+// 32 bits edge functions, 4 pixels at a time. Values at the rectangle corners must fit 31 bits.
+// Covered pixels of a row are contiguous, the edge tests only look for the first and the last one.
+static void ImGui_ImplSoft_RasterPartial(const ImGui_ImplSoft_Triangle& tri, ImU32* pixels, int stride, int x0, int y0, int x1, int y1, const int64_t* e_origin)
+{
+    int step_x[3], step_y[3], row_e[3];
+    for (int i = 0; i < 3; i++)
+    {
+        step_x[i] = (int)(tri.EdgeA[i] * IMGUI_IMPL_SOFT_SUBPIXEL);
+        step_y[i] = (int)(tri.EdgeB[i] * IMGUI_IMPL_SOFT_SUBPIXEL);
+        row_e[i] = (int)e_origin[i];
+    }
+#ifdef IMGUI_IMPL_SOFT_SSE2
+    const __m128i lane0 = _mm_setr_epi32(0, step_x[0], step_x[0] * 2, step_x[0] * 3);
+    const __m128i lane1 = _mm_setr_epi32(0, step_x[1], step_x[1] * 2, step_x[1] * 3);
+    const __m128i lane2 = _mm_setr_epi32(0, step_x[2], step_x[2] * 2, step_x[2] * 3);
+    const __m128i step0 = _mm_set1_epi32(step_x[0] * 4);
+    const __m128i step1 = _mm_set1_epi32(step_x[1] * 4);
+    const __m128i step2 = _mm_set1_epi32(step_x[2] * 4);
+#endif
+    for (int y = y0; y < y1; y++)
+    {
+        int span_x0 = x1, span_x1 = x1;
+#ifdef IMGUI_IMPL_SOFT_SSE2
+        __m128i e0 = _mm_add_epi32(_mm_set1_epi32(row_e[0]), lane0);
+        __m128i e1 = _mm_add_epi32(_mm_set1_epi32(row_e[1]), lane1);
+        __m128i e2 = _mm_add_epi32(_mm_set1_epi32(row_e[2]), lane2);
+        for (int x = x0; x < x1; x += 4)
+        {
+            // Sign bits of e0 | e1 | e2 are the pixels outside
+            int mask = ~_mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(_mm_or_si128(e0, e1), e2))) & 0xF;
+            e0 = _mm_add_epi32(e0, step0);
+            e1 = _mm_add_epi32(e1, step1);
+            e2 = _mm_add_epi32(e2, step2);
+#else
+        int e0 = row_e[0], e1 = row_e[1], e2 = row_e[2];
+        for (int x = x0; x < x1; x += 4)
+        {
+            int mask = 0;
+            for (int i = 0; i < 4; i++)
+                mask |= ((e0 + step_x[0] * i) | (e1 + step_x[1] * i) | (e2 + step_x[2] * i)) >= 0 ? 1 << i : 0;
+            e0 += step_x[0] * 4; e1 += step_x[1] * 4; e2 += step_x[2] * 4;
+#endif
+            if (x + 4 > x1)
+                mask &= (1 << (x1 - x)) - 1;
+            if (span_x0 == x1)
+            {
+                if (!mask)
+                    continue;
+                span_x0 = x + ImGui_ImplSoft_LowestBit(mask);
+            }
+            if (!(mask & 8))
+            {
+                span_x1 = mask ? x + ImGui_ImplSoft_HighestBit(mask) + 1 : x;
+                break;
+            }
+        }
+        if (span_x0 < span_x1)
+            ImGui_ImplSoft_ShadeSpan(tri, pixels + (size_t)y * stride, span_x0, span_x1, y);
+        row_e[0] += step_y[0]; row_e[1] += step_y[1]; row_e[2] += step_y[2];
+    }
+}
+
+static void ImGui_ImplSoft_RasterTriangle(const ImGui_ImplSoft_Triangle& tri, ImU32* pixels, int stride, int tile_x0, int tile_y0, int tile_x1, int tile_y1)
+{
+    const int x0 = ImMax(tri.MinX, tile_x0), y0 = ImMax(tri.MinY, tile_y0);
+    const int x1 = ImMin(tri.MaxX, tile_x1), y1 = ImMin(tri.MaxY, tile_y1);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+    if (tri.Flags & ImGui_ImplSoft_TriangleFlags_Rect)
+    {
+        ImGui_ImplSoft_FillRect(tri, pixels, stride, x0, y0, x1, y1);
+        return;
+    }
+    if (tri.Flags & ImGui_ImplSoft_TriangleFlags_Wide)
+    {
+        ImGui_ImplSoft_RasterWide(tri, pixels, stride, x0, y0, x1, y1);
+        return;
+    }
+
+    // Edge values at the centers of the corner pixels: an edge negative at all corners rejects the rectangle,
+    // all edges positive at all corners is a full cover
+    int64_t e_origin[3];
+    bool full = true, fits = true;
+    const int64_t dx = (int64_t)(x1 - 1 - x0) * IMGUI_IMPL_SOFT_SUBPIXEL;
+    const int64_t dy = (int64_t)(y1 - 1 - y0) * IMGUI_IMPL_SOFT_SUBPIXEL;
+    for (int i = 0; i < 3; i++)
+    {
+        const int64_t e00 = tri.EdgeC[i] + (tri.EdgeA[i] * (x0 - tri.MinX) + tri.EdgeB[i] * (y0 - tri.MinY)) * IMGUI_IMPL_SOFT_SUBPIXEL;
+        const int64_t e10 = e00 + tri.EdgeA[i] * dx;
+        const int64_t e01 = e00 + tri.EdgeB[i] * dy;
+        const int64_t e11 = e10 + tri.EdgeB[i] * dy;
+        if ((e00 & e10 & e01 & e11) < 0)
+            return;
+        if ((e00 | e10 | e01 | e11) < 0)
+            full = false;
+        // Leaves room for the steps past the last pixel, one group and one row
+        const int64_t limit = (int64_t)1 << 30;
+        if (e00 <= -limit || e00 >= limit || e10 <= -limit || e10 >= limit || e01 <= -limit || e01 >= limit || e11 <= -limit || e11 >= limit)
+            fits = false;
+        e_origin[i] = e00;
+    }
+    if (full)
+        ImGui_ImplSoft_FillRect(tri, pixels, stride, x0, y0, x1, y1);
+    else if (fits)
+        ImGui_ImplSoft_RasterPartial(tri, pixels, stride, x0, y0, x1, y1, e_origin);
+    else
+        ImGui_ImplSoft_RasterWide(tri, pixels, stride, x0, y0, x1, y1);
+}
+
+static void ImGui_ImplSoft_RenderTile(ImGui_ImplSoft_Data* bd, int tile)
+{
+    ImGui::ImMat& target = *bd->Target;
+    const int tx = tile % bd->TilesX, ty = tile / bd->TilesX;
+    const int x0 = tx << IMGUI_IMPL_SOFT_TILE_SHIFT, y0 = ty << IMGUI_IMPL_SOFT_TILE_SHIFT;
+    const int x1 = ImMin(x0 + IMGUI_IMPL_SOFT_TILE_SIZE, target.w), y1 = ImMin(y0 + IMGUI_IMPL_SOFT_TILE_SIZE, target.h);
+    const ImVector<int>& bin = bd->Bins[tile];
+    for (int i = 0; i < bin.Size; i++)
+        ImGui_ImplSoft_RasterTriangle(bd->Triangles[bin[i]], (ImU32*)target.data, target.w, x0, y0, x1, y1);
+}
+
+static void ImGui_ImplSoft_RenderTiles(ImGui_ImplSoft_Data* bd)
+{
+    for (;;)
+    {
+        const int i = bd->NextTile.fetch_add(1, std::memory_order_relaxed);
+        if (i >= bd->ActiveTiles.Size)
+            break;
+        ImGui_ImplSoft_RenderTile(bd, bd->ActiveTiles[i]);
+    }
+}
+
+static void ImGui_ImplSoft_WorkerThread(ImGui_ImplSoft_Data* bd)
+{
+    int generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(bd->Mutex);
+            bd->WorkCond.wait(lock, [&]() { return bd->Quit || bd->Generation != generation; });
+            if (bd->Quit)
+                return;
+            generation = bd->Generation;
+        }
+        ImGui_ImplSoft_RenderTiles(bd);
+        std::lock_guard<std::mutex> lock(bd->Mutex);
+        if (--bd->Busy == 0)
+            bd->DoneCond.notify_one();
+    }
+}
+
+// Draw all binned triangles, then reset the bins
+static void ImGui_ImplSoft_Flush(ImGui_ImplSoft_Data* bd)
+{
+    if (bd->ActiveTiles.Size > 0)
+    {
+        bd->NextTile.store(0, std::memory_order_relaxed);
+        const int workers = ImMin((int)bd->Workers.size(), bd->ActiveTiles.Size - 1);
+        if (workers > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(bd->Mutex);
+                bd->Busy = (int)bd->Workers.size();
+                bd->Generation++;
+            }
+            bd->WorkCond.notify_all();
+        }
+        ImGui_ImplSoft_RenderTiles(bd);
+        if (workers > 0)
+        {
+            std::unique_lock<std::mutex> lock(bd->Mutex);
+            bd->DoneCond.wait(lock, [&]() { return bd->Busy == 0; });
+        }
+        for (int i = 0; i < bd->ActiveTiles.Size; i++)
+            bd->Bins[bd->ActiveTiles[i]].resize(0);
+        bd->ActiveTiles.resize(0);
+    }
+    bd->Triangles.resize(0);
+}
+
+struct ImGui_ImplSoft_Scissor
+{
+    int X0, Y0, X1, Y1;
+};
+
+static void ImGui_ImplSoft_BinTriangle(ImGui_ImplSoft_Data* bd, const ImGui_ImplSoft_Triangle& tri)
+{
+    const int index = bd->Triangles.Size;
+    bd->Triangles.push_back(tri);
+    const int tx0 = tri.MinX >> IMGUI_IMPL_SOFT_TILE_SHIFT, tx1 = (tri.MaxX - 1) >> IMGUI_IMPL_SOFT_TILE_SHIFT;
+    const int ty0 = tri.MinY >> IMGUI_IMPL_SOFT_TILE_SHIFT, ty1 = (tri.MaxY - 1) >> IMGUI_IMPL_SOFT_TILE_SHIFT;
+    for (int ty = ty0; ty <= ty1; ty++)
+        for (int tx = tx0; tx <= tx1; tx++)
+        {
+            ImVector<int>& bin = bd->Bins[ty * bd->TilesX + tx];
+            if (bin.Size == 0)
+                bd->ActiveTiles.push_back(ty * bd->TilesX + tx);
+            bin.push_back(index);
+        }
+}
+
+// Vertex position to sub pixel units, false outside of the guard band
+static inline bool ImGui_ImplSoft_SnapVertex(const ImDrawVert* v, const ImVec2& clip_off, const ImVec2& clip_scale, int64_t& px, int64_t& py)
+{
+    const float x = (v->pos.x - clip_off.x) * clip_scale.x;
+    const float y = (v->pos.y - clip_off.y) * clip_scale.y;
+    if (!(x > -IMGUI_IMPL_SOFT_GUARD_BAND && x < IMGUI_IMPL_SOFT_GUARD_BAND && y > -IMGUI_IMPL_SOFT_GUARD_BAND && y < IMGUI_IMPL_SOFT_GUARD_BAND))
+        return false;
+    px = (int64_t)floorf(x * IMGUI_IMPL_SOFT_SUBPIXEL + 0.5f);
+    py = (int64_t)floorf(y * IMGUI_IMPL_SOFT_SUBPIXEL + 0.5f);
+    return true;
+}
+
+static void ImGui_ImplSoft_SetupTriangle(ImGui_ImplSoft_Data* bd, const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2, const ImGui_ImplSoft_Scissor& scissor, ImTextureSOFT* texture, const ImVec2& clip_off, const ImVec2& clip_scale)
+{
+    const ImDrawVert* v[3] = { v0, v1, v2 };
+    int64_t px[3], py[3];
+    for (int i = 0; i < 3; i++)
+        if (!ImGui_ImplSoft_SnapVertex(v[i], clip_off, clip_scale, px[i], py[i]))
+            return;
+
+    // Counter clockwise on screen makes the edge functions negative inside, swap to clockwise
+    int64_t area = (px[1] - px[0]) * (py[2] - py[0]) - (py[1] - py[0]) * (px[2] - px[0]);
+    if (area == 0)
+        return;
+    if (area < 0)
+    {
+        ImSwap(v[1], v[2]);
+        ImSwap(px[1], px[2]);
+        ImSwap(py[1], py[2]);
+        area = -area;
+    }
+
+    // Bounds, conservative on the pixel centers then clipped
+    const int half = IMGUI_IMPL_SOFT_SUBPIXEL / 2;
+    const int64_t min_x = ImMin(px[0], ImMin(px[1], px[2])), max_x = ImMax(px[0], ImMax(px[1], px[2]));
+    const int64_t min_y = ImMin(py[0], ImMin(py[1], py[2])), max_y = ImMax(py[0], ImMax(py[1], py[2]));
+    ImGui_ImplSoft_Triangle tri;
+    tri.MinX = ImMax((int)((min_x - half) >> IMGUI_IMPL_SOFT_SUBPIXEL_BITS), scissor.X0);
+    tri.MinY = ImMax((int)((min_y - half) >> IMGUI_IMPL_SOFT_SUBPIXEL_BITS), scissor.Y0);
+    tri.MaxX = ImMin((int)((max_x - half) >> IMGUI_IMPL_SOFT_SUBPIXEL_BITS) + 1, scissor.X1);
+    tri.MaxY = ImMin((int)((max_y - half) >> IMGUI_IMPL_SOFT_SUBPIXEL_BITS) + 1, scissor.Y1);
+    if (tri.MinX >= tri.MaxX || tri.MinY >= tri.MaxY)
+        return;
+
+    // Edge i is opposite to vertex i. Top-left fill rule: pixel centers exactly on an edge belong to the triangle
+    // only for top edges (horizontal, interior below) and left edges (interior to the right).
+    const int64_t cx = (int64_t)tri.MinX * IMGUI_IMPL_SOFT_SUBPIXEL + half;
+    const int64_t cy = (int64_t)tri.MinY * IMGUI_IMPL_SOFT_SUBPIXEL + half;
+    double e_origin[3];
+    tri.Flags = ImGui_ImplSoft_TriangleFlags_None;
+    for (int i = 0; i < 3; i++)
+    {
+        const int j = (i + 1) % 3, k = (i + 2) % 3;
+        const int64_t a = py[j] - py[k];
+        const int64_t b = px[k] - px[j];
+        const int64_t e = a * (cx - px[j]) + b * (cy - py[j]);
+        const bool top_left = a > 0 || (a == 0 && b > 0);
+        tri.EdgeA[i] = a;
+        tri.EdgeB[i] = b;
+        tri.EdgeC[i] = top_left ? e : e - 1;
+        e_origin[i] = (double)e;
+        if (a <= -(1 << 24) || a >= (1 << 24) || b <= -(1 << 24) || b >= (1 << 24))
+            tri.Flags |= ImGui_ImplSoft_TriangleFlags_Wide;
+    }
+
+    // Attribute planes from the barycentric weights, weight i = E(i) / area
+    const ImU32 col0 = v[0]->col;
+    if (col0 == v[1]->col && col0 == v[2]->col)
+        tri.Flags |= ImGui_ImplSoft_TriangleFlags_ConstColor;
+    if (v[0]->uv.x == v[1]->uv.x && v[0]->uv.x == v[2]->uv.x && v[0]->uv.y == v[1]->uv.y && v[0]->uv.y == v[2]->uv.y)
+        tri.Flags |= ImGui_ImplSoft_TriangleFlags_ConstUV;
+    const double inv_area = 1.0 / (double)area;
+    const double step = (double)IMGUI_IMPL_SOFT_SUBPIXEL * inv_area;
+    float texel_scale[4] = { 1.f, 1.f, 1.f, 1.f };
+    ImU32 texel = 0xFFFFFFFF;
+    if (tri.Flags & ImGui_ImplSoft_TriangleFlags_ConstUV)
+    {
+        texel = ImGui_ImplSoft_Sample(texture, v[0]->uv.x, v[0]->uv.y);
+        for (int c = 0; c < 4; c++)
+            texel_scale[c] = (float)((texel >> (c * 8)) & 0xFF) / 255.f;
+    }
+    // Flat triangles need no planes, AA fringes only need the color
+    const int plane_begin = (tri.Flags & ImGui_ImplSoft_TriangleFlags_Flat) == ImGui_ImplSoft_TriangleFlags_ConstColor ? 4 : 0;
+    const int plane_end = (tri.Flags & ImGui_ImplSoft_TriangleFlags_Flat) == ImGui_ImplSoft_TriangleFlags_Flat ? 0 : (tri.Flags & ImGui_ImplSoft_TriangleFlags_ConstUV) ? 4 : 6;
+    for (int c = plane_begin; c < plane_end; c++)
+    {
+        double a[3];
+        for (int i = 0; i < 3; i++)
+            a[i] = c < 4 ? (double)((v[i]->col >> (c * 8)) & 0xFF) * texel_scale[c] : c == 4 ? v[i]->uv.x : v[i]->uv.y;
+        tri.Attr[c][0] = (float)((e_origin[0] * a[0] + e_origin[1] * a[1] + e_origin[2] * a[2]) * inv_area);
+        tri.Attr[c][1] = (float)((tri.EdgeA[0] * a[0] + tri.EdgeA[1] * a[1] + tri.EdgeA[2] * a[2]) * step);
+        tri.Attr[c][2] = (float)((tri.EdgeB[0] * a[0] + tri.EdgeB[1] * a[1] + tri.EdgeB[2] * a[2]) * step);
+    }
+    tri.Color = col0;
+    tri.Texture = texture;
+    if ((tri.Flags & ImGui_ImplSoft_TriangleFlags_Flat) == ImGui_ImplSoft_TriangleFlags_Flat)
+    {
+        tri.Color = ImGui_ImplSoft_Modulate(texel, col0);
+        if ((tri.Color >> 24) == 0)
+            return;
+    }
+
+    ImGui_ImplSoft_BinTriangle(bd, tri);
+}
+
+// Rectangles and glyphs are drawn as the triangles (a, b, c) (a, c, d) of an axis aligned quad, with one color and
+// axis aligned UVs. Together the two triangles cover exactly the pixel centers inside the snapped rectangle, which
+// is rasterized as one primitive without edge functions. Returns false when the 6 indices aren't such a quad.
+static bool ImGui_ImplSoft_SetupRect(ImGui_ImplSoft_Data* bd, const ImDrawVert* vtx, const ImDrawIdx* idx, const ImGui_ImplSoft_Scissor& scissor, ImTextureSOFT* texture, const ImVec2& clip_off, const ImVec2& clip_scale)
+{
+    if (idx[3] != idx[0] || idx[4] != idx[2])
+        return false;
+    const ImDrawVert* a = &vtx[idx[0]];
+    const ImDrawVert* b = &vtx[idx[1]];
+    const ImDrawVert* c = &vtx[idx[2]];
+    const ImDrawVert* d = &vtx[idx[5]];
+    if (a->pos.y != b->pos.y || b->pos.x != c->pos.x || c->pos.y != d->pos.y || d->pos.x != a->pos.x ||
+        a->uv.y != b->uv.y || b->uv.x != c->uv.x || c->uv.y != d->uv.y || d->uv.x != a->uv.x ||
+        a->col != b->col || a->col != c->col || a->col != d->col)
+        return false;
+
+    // Degenerate or out of the guard band, the triangles would be dropped as well
+    int64_t ax, ay, cx, cy;
+    if (!ImGui_ImplSoft_SnapVertex(a, clip_off, clip_scale, ax, ay) || !ImGui_ImplSoft_SnapVertex(c, clip_off, clip_scale, cx, cy) || ax == cx || ay == cy)
+        return true;
+
+    // Pixel x is covered when min <= x * 16 + 8 < max
+    const int half = IMGUI_IMPL_SOFT_SUBPIXEL / 2;
+    ImGui_ImplSoft_Triangle tri;
+    tri.MinX = ImMax((int)((ImMin(ax, cx) + half - 1) >> IMGUI_IMPL_SOFT_SUBPIXEL_BITS), scissor.X0);
+    tri.MinY = ImMax((int)((ImMin(ay, cy) + half - 1) >> IMGUI_IMPL_SOFT_SUBPIXEL_BITS), scissor.Y0);
+    tri.MaxX = ImMin((int)((ImMax(ax, cx) + half - 1) >> IMGUI_IMPL_SOFT_SUBPIXEL_BITS), scissor.X1);
+    tri.MaxY = ImMin((int)((ImMax(ay, cy) + half - 1) >> IMGUI_IMPL_SOFT_SUBPIXEL_BITS), scissor.Y1);
+    if (tri.MinX >= tri.MaxX || tri.MinY >= tri.MaxY)
+        return true;
+
+    tri.Flags = ImGui_ImplSoft_TriangleFlags_Rect | ImGui_ImplSoft_TriangleFlags_ConstColor;
+    tri.Color = a->col;
+    tri.Texture = texture;
+    if (a->uv.x == c->uv.x && a->uv.y == c->uv.y)
+    {
+        tri.Flags |= ImGui_ImplSoft_TriangleFlags_ConstUV;
+        tri.Color = ImGui_ImplSoft_Modulate(ImGui_ImplSoft_Sample(texture, a->uv.x, a->uv.y), a->col);
+        if ((tri.Color >> 24) == 0)
+            return true;
+    }
+    else
+    {
+        // U only depends on x and V on y
+        const double du = (double)(c->uv.x - a->uv.x) * IMGUI_IMPL_SOFT_SUBPIXEL / (double)(cx - ax);
+        const double dv = (double)(c->uv.y - a->uv.y) * IMGUI_IMPL_SOFT_SUBPIXEL / (double)(cy - ay);
+        tri.Attr[4][0] = (float)(a->uv.x + du * (double)((int64_t)tri.MinX * IMGUI_IMPL_SOFT_SUBPIXEL + half - ax) / IMGUI_IMPL_SOFT_SUBPIXEL);
+        tri.Attr[4][1] = (float)du;
+        tri.Attr[4][2] = 0.f;
+        tri.Attr[5][0] = (float)(a->uv.y + dv * (double)((int64_t)tri.MinY * IMGUI_IMPL_SOFT_SUBPIXEL + half - ay) / IMGUI_IMPL_SOFT_SUBPIXEL);
+        tri.Attr[5][1] = 0.f;
+        tri.Attr[5][2] = (float)dv;
+    }
+    ImGui_ImplSoft_BinTriangle(bd, tri);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Public API
+//-----------------------------------------------------------------------------
+
+bool    ImGui_ImplSoft_Init(int num_threads)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    // Setup backend capabilities flags
+    ImGui_ImplSoft_Data* bd = IM_NEW(ImGui_ImplSoft_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_soft";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasDynamicGlyphs; // We copy the rows of the dynamic glyph cache. // add by Dicky
+
+    if (num_threads <= 0)
+        num_threads = (int)std::thread::hardware_concurrency();
+    bd->ThreadCount = ImMax(num_threads, 1);
+    for (int i = 1; i < bd->ThreadCount; i++)
+        bd->Workers.push_back(std::thread(ImGui_ImplSoft_WorkerThread, bd));
+    return true;
+}
+
+void    ImGui_ImplSoft_Shutdown()
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    {
+        std::lock_guard<std::mutex> lock(bd->Mutex);
+        bd->Quit = true;
+    }
+    bd->WorkCond.notify_all();
+    for (auto& worker : bd->Workers)
+        worker.join();
+    ImGui_ImplSoft_DestroyFontsTexture();
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasDynamicGlyphs); // modify by Dicky
+    IM_DELETE(bd);
+}
+
+void    ImGui_ImplSoft_NewFrame()
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoft_Init()?");
+
+    if (!bd->FontTexture)
+        ImGui_ImplSoft_CreateFontsTexture();
+}
+
+void    ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, ImGui::ImMat& target)
+{
+    // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
+    int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0)
+        return;
+
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplSoft_Init()?");
+
+    // add by Dicky, copy the rows written by the dynamic glyph cache (ImFontAtlasFlags_DynamicGlyphs) since the last frame
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    int dirty_y = 0, dirty_h = 0;
+    if (bd->FontTexture && atlas->TexPixelsRGBA32 && atlas->GetTexDataDirtyRows(&dirty_y, &dirty_h))
+        ImGui_ImplSoft_UpdateTexture(bd->FontTexture, atlas->TexPixelsRGBA32 + (size_t)dirty_y * atlas->TexWidth, atlas->TexWidth, dirty_h, 4, 8, 0, dirty_y);
+    // add by Dicky end
+
+    if (target.w != fb_width || target.h != fb_height || target.c != 4 || target.elemsize != 1 || target.elempack != 4 || target.device != IM_DD_CPU)
+    {
+        target.create(fb_width, fb_height, 4, (size_t)1, 4);
+        memset(target.data, 0, (size_t)fb_width * fb_height * 4);
+    }
+    bd->Target = &target;
+    bd->TilesX = (fb_width + IMGUI_IMPL_SOFT_TILE_SIZE - 1) >> IMGUI_IMPL_SOFT_TILE_SHIFT;
+    bd->TilesY = (fb_height + IMGUI_IMPL_SOFT_TILE_SIZE - 1) >> IMGUI_IMPL_SOFT_TILE_SHIFT;
+    if ((int)bd->Bins.size() != bd->TilesX * bd->TilesY)
+    {
+        bd->Bins.clear();
+        bd->Bins.resize(bd->TilesX * bd->TilesY);
+    }
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    // Render command lists
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != nullptr)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                // Callbacks draw in order with the triangles submitted before them.
+                ImGui_ImplSoft_Flush(bd);
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+            }
+            else
+            {
+                // Project scissor/clipping rectangles into framebuffer space
+                ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+                ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+                if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+                    continue;
+
+                // Same integer rectangle as glScissor() in the OpenGL backends (Y is inverted there)
+                ImGui_ImplSoft_Scissor scissor;
+                scissor.X0 = (int)clip_min.x;
+                scissor.X1 = scissor.X0 + (int)(clip_max.x - clip_min.x);
+                scissor.Y1 = fb_height - (int)((float)fb_height - clip_max.y);
+                scissor.Y0 = scissor.Y1 - (int)(clip_max.y - clip_min.y);
+                scissor.X0 = ImMax(scissor.X0, 0);
+                scissor.Y0 = ImMax(scissor.Y0, 0);
+                scissor.X1 = ImMin(scissor.X1, fb_width);
+                scissor.Y1 = ImMin(scissor.Y1, fb_height);
+                if (scissor.X0 >= scissor.X1 || scissor.Y0 >= scissor.Y1)
+                    continue;
+
+                ImTextureSoft texture = (ImTextureSoft)pcmd->GetTexID();
+                if (!texture || texture->mat.empty())
+                    continue;
+
+                const ImDrawVert* vtx = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+                const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+                for (unsigned int i = 0; i + 2 < pcmd->ElemCount; )
+                {
+                    if (i + 5 < pcmd->ElemCount && ImGui_ImplSoft_SetupRect(bd, vtx, idx + i, scissor, texture, clip_off, clip_scale))
+                    {
+                        i += 6;
+                        continue;
+                    }
+                    ImGui_ImplSoft_SetupTriangle(bd, &vtx[idx[i]], &vtx[idx[i + 1]], &vtx[idx[i + 2]], scissor, texture, clip_off, clip_scale);
+                    i += 3;
+                }
+            }
+        }
+    }
+    ImGui_ImplSoft_Flush(bd);
+    bd->Target = nullptr;
+}
+
+bool ImGui_ImplSoft_CreateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+
+    // Build texture atlas
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    bd->FontTexture = ImGui_ImplSoft_CreateTexture(pixels, width, height, 4);
+    if (!bd->FontTexture)
+        return false;
+
+    // Store our identifier
+    io.Fonts->SetTexID((ImTextureID)bd->FontTexture);
+    return true;
+}
+
+void ImGui_ImplSoft_DestroyFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    if (bd->FontTexture)
+    {
+        ImGui_ImplSoft_DestroyTexture(&bd->FontTexture);
+        io.Fonts->SetTexID(0);
+    }
+}
+
+// add by Dicky
+void ImGui_ImplSoft_ClearScreen(ImGui::ImMat& target, ImVec2 size, ImVec4 color)
+{
+    const int width = (int)size.x, height = (int)size.y;
+    if (width <= 0 || height <= 0)
+        return;
+    if (target.w != width || target.h != height || target.c != 4 || target.elemsize != 1 || target.elempack != 4 || target.device != IM_DD_CPU)
+        target.create(width, height, 4, (size_t)1, 4);
+    // Premultiplied like ImGui_ImplOpenGL3_ClearScreen()
+    const ImU32 clear = ImGui_ImplSoft_PackColor(color.x * color.w * 255.f, color.y * color.w * 255.f, color.z * color.w * 255.f, color.w * 255.f);
+    ImU32* pixels = (ImU32*)target.data;
+    const size_t count = (size_t)width * height;
+    for (size_t i = 0; i < count; i++)
+        pixels[i] = clear;
+}
+
+static inline unsigned char ImGui_ImplSoft_ToByte(const void* src, size_t index, int bit_depth)
+{
+    if (bit_depth == 32)
+    {
+        const float f = ((const float*)src)[index];
+        return (unsigned char)(f <= 0.f ? 0 : f >= 1.f ? 255 : (int)(f * 255.f + 0.5f));
+    }
+    if (bit_depth == 16)
+        return (unsigned char)(((const unsigned short*)src)[index] >> 8);
+    return ((const unsigned char*)src)[index];
+}
+
+// Channel c of pixel i is at element i * pixel_step + c * channel_step
+static void ImGui_ImplSoft_ConvertPixels(ImTextureSOFT* texture, int offset_x, int offset_y, const void* src, int width, int height, int channels, int bit_depth, size_t pixel_step, size_t channel_step)
+{
+    for (int y = 0; y < height; y++)
+    {
+        ImU32* dst = (ImU32*)texture->mat.data + (size_t)(offset_y + y) * texture->mat.w + offset_x;
+        if (channels == 4 && bit_depth == 8 && pixel_step == 4 && channel_step == 1)
+        {
+            memcpy(dst, (const unsigned char*)src + (size_t)y * width * 4, (size_t)width * 4);
+            continue;
+        }
+        for (int x = 0; x < width; x++)
+        {
+            const size_t i = ((size_t)y * width + x) * pixel_step;
+            ImU32 r = ImGui_ImplSoft_ToByte(src, i, bit_depth), g = r, b = r, a = 255;
+            if (channels == 2)
+                a = ImGui_ImplSoft_ToByte(src, i + channel_step, bit_depth);
+            else if (channels >= 3)
+            {
+                g = ImGui_ImplSoft_ToByte(src, i + channel_step, bit_depth);
+                b = ImGui_ImplSoft_ToByte(src, i + channel_step * 2, bit_depth);
+                if (channels == 4)
+                    a = ImGui_ImplSoft_ToByte(src, i + channel_step * 3, bit_depth);
+            }
+            dst[x] = r | (g << 8) | (b << 16) | (a << 24);
+        }
+    }
+}
+
+static bool ImGui_ImplSoft_MatLayout(const ImGui::ImMat& mat, int& bit_depth, size_t& pixel_step, size_t& channel_step)
+{
+    if (mat.empty() || mat.device != IM_DD_CPU || mat.c < 1 || mat.c > 4)
+        return false;
+    bit_depth = mat.type == IM_DT_INT8 ? 8 : mat.type == IM_DT_INT16 ? 16 : mat.type == IM_DT_FLOAT32 ? 32 : 0;
+    if (!bit_depth)
+        return false;
+    const bool planar = mat.c > 1 && mat.elempack == 1;
+    pixel_step = planar ? 1 : mat.c;
+    channel_step = planar ? mat.cstep : 1;
+    return true;
+}
+
+ImTextureSoft ImGui_ImplSoft_CreateTexture(const void* pixels, int width, int height, int channels, int bit_depth)
+{
+    if (!pixels || width <= 0 || height <= 0 || channels < 1 || channels > 4 || (bit_depth != 8 && bit_depth != 16 && bit_depth != 32))
+        return nullptr;
+    ImTextureSOFT* texture = IM_NEW(ImTextureSOFT)();
+    texture->mat.create(width, height, 4, (size_t)1, 4);
+    ImGui_ImplSoft_ConvertPixels(texture, 0, 0, pixels, width, height, channels, bit_depth, channels, 1);
+    return texture;
+}
+
+ImTextureSoft ImGui_ImplSoft_CreateTexture(const ImGui::ImMat& mat)
+{
+    int bit_depth = 0;
+    size_t pixel_step = 0, channel_step = 0;
+    if (!ImGui_ImplSoft_MatLayout(mat, bit_depth, pixel_step, channel_step))
+        return nullptr;
+    ImTextureSOFT* texture = IM_NEW(ImTextureSOFT)();
+    texture->mat.create(mat.w, mat.h, 4, (size_t)1, 4);
+    ImGui_ImplSoft_ConvertPixels(texture, 0, 0, mat.data, mat.w, mat.h, mat.c, bit_depth, pixel_step, channel_step);
+    return texture;
+}
+
+bool ImGui_ImplSoft_UpdateTexture(ImTextureSoft texture, const void* pixels, int width, int height, int channels, int bit_depth, int offset_x, int offset_y)
+{
+    if (!texture || !pixels || channels < 1 || channels > 4 || (bit_depth != 8 && bit_depth != 16 && bit_depth != 32))
+        return false;
+    if (offset_x < 0 || offset_y < 0 || width <= 0 || height <= 0 || offset_x + width > texture->mat.w || offset_y + height > texture->mat.h)
+        return false;
+    ImGui_ImplSoft_ConvertPixels(texture, offset_x, offset_y, pixels, width, height, channels, bit_depth, channels, 1);
+    return true;
+}
+
+bool ImGui_ImplSoft_UpdateTexture(ImTextureSoft texture, const ImGui::ImMat& mat, int offset_x, int offset_y)
+{
+    int bit_depth = 0;
+    size_t pixel_step = 0, channel_step = 0;
+    if (!texture || !ImGui_ImplSoft_MatLayout(mat, bit_depth, pixel_step, channel_step))
+        return false;
+    if (offset_x < 0 || offset_y < 0 || offset_x + mat.w > texture->mat.w || offset_y + mat.h > texture->mat.h)
+        return false;
+    ImGui_ImplSoft_ConvertPixels(texture, offset_x, offset_y, mat.data, mat.w, mat.h, mat.c, bit_depth, pixel_step, channel_step);
+    return true;
+}
+
+void ImGui_ImplSoft_DestroyTexture(ImTextureSoft* texture)
+{
+    if (!texture || !*texture)
+        return;
+    IM_DELETE(*texture);
+    *texture = nullptr;
+}
+
+int ImGui_ImplSoft_GetThreadCount()
+{
+    ImGui_ImplSoft_Data* bd = ImGui_ImplSoft_GetBackendData();
+    return bd ? bd->ThreadCount : 0;
+}
+// add by Dicky end
+
+//-----------------------------------------------------------------------------
+
+#endif // #ifndef IMGUI_DISABLE
@@ -0,0 +1,52 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer
+// - Rasterizes ImDrawData into an RGBA ImGui::ImMat, no GPU or windowing API needed.
+// - Meant for UI screenshots, regression images and server side previews on headless machines.
+// This needs to be used along with a Platform Backend, or a null platform which fills io.DisplaySize and io.DeltaTime.
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImTextureSoft' (see ImGui_ImplSoft_CreateTexture) as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Bilinear texture sampling, SRC_ALPHA/ONE_MINUS_SRC_ALPHA blending, same as the OpenGL backends.
+//  [X] Renderer: ImDrawCmd clip rectangles are applied exactly like glScissor() in the OpenGL backends.
+//  [X] Renderer: Screen is split into tiles rendered in parallel, output doesn't depend on the thread count.
+//  [ ] Renderer: Multi-viewport support.
+
+// About the render target:
+//  ImGui_ImplSoft_RenderDrawData() (re)creates the target as a w x h x 4 RGBA8 interleaved ImMat at framebuffer size
+//  and draws over its current content, clear it first with ImGui_ImplSoft_ClearScreen().
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+#ifndef IMGUI_DISABLE
+#include <immat.h>
+
+// add by Dicky
+typedef struct ImTextureSOFT
+{
+    ImGui::ImMat mat;       // RGBA8, interleaved
+} *ImTextureSoft;
+// add by Dicky end
+
+// Follow "Getting Started" link and check examples/ folder to learn about using backends!
+// num_threads <= 0 uses one thread per hardware thread
+IMGUI_IMPL_API bool     ImGui_ImplSoft_Init(int num_threads = 0);
+IMGUI_IMPL_API void     ImGui_ImplSoft_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoft_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoft_RenderDrawData(ImDrawData* draw_data, ImGui::ImMat& target);
+
+// (Optional) Called by NewFrame/Shutdown
+IMGUI_IMPL_API bool     ImGui_ImplSoft_CreateFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoft_DestroyFontsTexture();
+
+// add by Dicky
+IMGUI_IMPL_API void             ImGui_ImplSoft_ClearScreen(ImGui::ImMat& target, ImVec2 size, ImVec4 color);
+// pixels are 1 (gray), 2 (gray alpha), 3 (RGB) or 4 (RGBA) channels of 8/16 bits integer or 32 bits float, converted to RGBA8
+IMGUI_IMPL_API ImTextureSoft    ImGui_ImplSoft_CreateTexture(const void* pixels, int width, int height, int channels, int bit_depth = 8);
+IMGUI_IMPL_API ImTextureSoft    ImGui_ImplSoft_CreateTexture(const ImGui::ImMat& mat);
+IMGUI_IMPL_API bool             ImGui_ImplSoft_UpdateTexture(ImTextureSoft texture, const void* pixels, int width, int height, int channels, int bit_depth = 8, int offset_x = 0, int offset_y = 0);
+IMGUI_IMPL_API bool             ImGui_ImplSoft_UpdateTexture(ImTextureSoft texture, const ImGui::ImMat& mat, int offset_x = 0, int offset_y = 0);
+IMGUI_IMPL_API void             ImGui_ImplSoft_DestroyTexture(ImTextureSoft* texture);
+IMGUI_IMPL_API int              ImGui_ImplSoft_GetThreadCount();
+// add by Dicky end
+
+#endif // #ifndef IMGUI_DISABLE
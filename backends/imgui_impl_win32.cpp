@@ -838,6 +838,10 @@ IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hwnd, UINT msg, WPARA
     case WM_DISPLAYCHANGE:
         bd->WantUpdateMonitors = true;
         return 0;
+    case WM_PAINT: // Add by Dicky: the window content was lost (exposed, restored), don't skip the next frame with io.ConfigSkipUnchangedFrames
+        if (ImGuiViewport* viewport = ImGui::FindViewportByPlatformHandle((void*)hwnd))
+            ImGui::InvalidateViewportDrawData(viewport);
+        return 0;
     }
     return 0;
 }
@@ -1403,11 +1407,19 @@ static void ImGui_ImplWin32_ShutdownPlatformInterface()
 // Add By Dicky
 void ImGui_ImplWin32_WaitForEvent()
 {
+    ImGui_ImplWin32_Data* bd = ImGui_ImplWin32_GetBackendData();
+    if (!bd) return;
+    if (ImGui::GetIO().ConfigSkipUnchangedFrames)
+    {
+        // The skipped present of an unchanged frame was the vsync throttle
+        HDC hdc = ::GetDC(bd->hWnd);
+        int refresh_rate = hdc ? ::GetDeviceCaps(hdc, VREFRESH) : 0;
+        if (hdc) ::ReleaseDC(bd->hWnd, hdc);
+        ImGui::WaitUnchangedFrame((float)refresh_rate);
+    }
     if (!(ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_EnablePowerSavingMode) &&
         !(ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_EnableLowRefreshMode))
         return;
-    ImGui_ImplWin32_Data* bd = ImGui_ImplWin32_GetBackendData();
-    if (!bd) return;
     BOOL window_is_hidden = !IsWindowVisible(bd->hWnd) || IsIconic(bd->hWnd);
     double waiting_time = window_is_hidden ? INFINITE : ImGui::GetEventWaitingTime();
     if (waiting_time > 0.0)
@@ -1039,6 +1039,8 @@ CODE
 // System includes
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <stdint.h>     // intptr_t
+#include <atomic>       // add by Dicky for the threaded ImGuiTextFilter::Filter()
+#include <regex>        // add by Dicky for the ImGuiTextFilter regular expression terms
 
 // [Windows] On non-Visual Studio compilers, we default to IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS unless explicitly enabled
 #if defined(_WIN32) && !defined(_MSC_VER) && !defined(IMGUI_ENABLE_WIN32_DEFAULT_IME_FUNCTIONS) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS)
@@ -1469,6 +1471,8 @@ ImGuiIO::ImGuiIO()
     MaxDelayFrameCount = 2;
     MaxFrameRate = 30;
     MinFrameRate = 5;
+    ConfigSkipUnchangedFrames = false;
+    ConfigTextLayoutCache = false;
     // Add By Dicky end
 }
 
@@ -2682,18 +2686,145 @@ static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
     return (lhs_v > rhs_v ? +1 : lhs_v < rhs_v ? -1 : 0);
 }
 
+// add by Dicky
+#if IMGUI_STORAGE_HASHED
+// Hashed storage: Data in insertion order + Robin Hood index over it once it gets bigger than IMGUI_STORAGE_LINEAR_MAX pairs.
+// Slots hold the key next to the pair index so a probe doesn't touch Data, the pair is only read to confirm a hit:
+// when Data was reordered behind our back the index is rebuilt. Keys set doesn't change with a reorder so a miss stays valid.
+#define IMGUI_STORAGE_LINEAR_MAX    16
+
+static inline ImU32 ImGuiStorageHash(ImGuiID key)
+{
+    // IDs are usually hashes already, but user keys are often indices
+    ImU32 h = key * 0x9E3779B1u;
+    return h ^ (h >> 16);
+}
+
+static void ImGuiStorageIndexInsert(ImVector<ImGuiStorageSlot>& table, ImGuiID key, int index)
+{
+    const ImU32 mask = (ImU32)table.Size - 1;
+    ImGuiStorageSlot slot = { key, index };
+    ImU32 dist = 0;
+    for (ImU32 pos = ImGuiStorageHash(key) & mask; ; pos = (pos + 1) & mask, dist++)
+    {
+        ImGuiStorageSlot& cur = table.Data[pos];
+        if (cur.index < 0)
+        {
+            cur = slot;
+            return;
+        }
+        // Take the place of pairs closer to their home slot
+        ImU32 cur_dist = (pos - ImGuiStorageHash(cur.key)) & mask;
+        if (cur_dist < dist)
+        {
+            ImSwap(cur, slot);
+            dist = cur_dist;
+        }
+    }
+}
+
+static void ImGuiStorageIndexRebuild(const ImGuiStorage* storage)
+{
+    storage->_Index.resize(0);
+    storage->_IndexedSize = 0;
+    if (storage->Data.Size <= IMGUI_STORAGE_LINEAR_MAX)
+        return;
+    int capacity = 64;
+    while (capacity * 3 < storage->Data.Size * 4)
+        capacity <<= 1;
+    const ImGuiStorageSlot empty = { 0, -1 };
+    storage->_Index.resize(capacity, empty);
+    for (int n = 0; n < storage->Data.Size; n++)
+        ImGuiStorageIndexInsert(storage->_Index, storage->Data.Data[n].key, n);
+    storage->_IndexedSize = storage->Data.Size;
+}
+
+// Bring the index up to date with Data, indexing pairs appended since last access
+static void ImGuiStorageIndexSync(const ImGuiStorage* storage)
+{
+    if (storage->_IndexedSize == storage->Data.Size)
+        return;
+    if (storage->_Index.Size == 0 || storage->_IndexedSize > storage->Data.Size || storage->Data.Size * 4 > storage->_Index.Size * 3)
+    {
+        ImGuiStorageIndexRebuild(storage);
+        return;
+    }
+    for (int n = storage->_IndexedSize; n < storage->Data.Size; n++)
+        ImGuiStorageIndexInsert(storage->_Index, storage->Data.Data[n].key, n);
+    storage->_IndexedSize = storage->Data.Size;
+}
+
+static ImGuiStoragePair* ImGuiStorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStorageIndexSync(storage);
+    ImGuiStoragePair* data = const_cast<ImGuiStoragePair*>(storage->Data.Data);
+    if (storage->_Index.Size == 0)
+    {
+        for (int n = 0; n < storage->Data.Size; n++)
+            if (data[n].key == key)
+                return &data[n];
+        return NULL;
+    }
+    const ImGuiStorageSlot* table = storage->_Index.Data;
+    const ImU32 mask = (ImU32)storage->_Index.Size - 1;
+    ImU32 dist = 0;
+    for (ImU32 pos = ImGuiStorageHash(key) & mask; table[pos].index >= 0; pos = (pos + 1) & mask, dist++)
+    {
+        if (table[pos].key == key)
+        {
+            ImGuiStoragePair* it = &data[table[pos].index];
+            if (it->key == key)
+                return it;
+            ImGuiStorageIndexRebuild(storage); // Data was reordered
+            return ImGuiStorageFind(storage, key);
+        }
+        if (((pos - ImGuiStorageHash(table[pos].key)) & mask) < dist)
+            break; // Robin Hood invariant: key would have been stored before this slot
+    }
+    return NULL;
+}
+
+static ImGuiStoragePair* ImGuiStorageFindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& pair)
+{
+    if (ImGuiStoragePair* it = ImGuiStorageFind(storage, pair.key))
+        return it;
+    storage->Data.push_back(pair);
+    if (storage->_Index.Size > 0 || storage->Data.Size > IMGUI_STORAGE_LINEAR_MAX)
+        ImGuiStorageIndexSync(storage);
+    return &storage->Data.back();
+}
+#else
+// add by Dicky end
+static ImGuiStoragePair* ImGuiStorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStoragePair* it_end = const_cast<ImGuiStoragePair*>(storage->Data.Data + storage->Data.Size);
+    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(storage->Data.Data), it_end, key);
+    return (it == it_end || it->key != key) ? NULL : it;
+}
+
+// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
+static ImGuiStoragePair* ImGuiStorageFindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& pair)
+{
+    ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + storage->Data.Size, pair.key);
+    if (it == storage->Data.Data + storage->Data.Size || it->key != pair.key)
+        it = storage->Data.insert(it, pair);
+    return it;
+}
+#endif // add by Dicky
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
     ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), PairComparerByID);
+#if IMGUI_STORAGE_HASHED
+    ImGuiStorageIndexRebuild(this); // add by Dicky
+#endif
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = ImGuiStorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -2703,27 +2834,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = ImGuiStorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = ImLowerBound(const_cast<ImGuiStoragePair*>(Data.Data), const_cast<ImGuiStoragePair*>(Data.Data + Data.Size), key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = ImGuiStorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -2733,28 +2857,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_i = val;
+    ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -2764,20 +2877,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_f = val;
+    ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
-    if (it == Data.Data + Data.Size || it->key != key)
-        Data.insert(it, ImGuiStoragePair(key, val));
-    else
-        it->val_p = val;
+    ImGuiStorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -2792,10 +2897,20 @@ IM_MSVC_RUNTIME_CHECKS_RESTORE
 //-----------------------------------------------------------------------------
 
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
-ImGuiTextFilter::ImGuiTextFilter(const char* default_filter) //-V1077
+ImGuiTextFilter::ImGuiTextFilter(const char* default_filter, int flags) //-V1077
 {
     InputBuf[0] = 0;
     CountGrep = 0;
+    // add by Dicky
+    Flags = flags;
+    FilterThreads = 0;
+    BuildCount = 0;
+    CacheBuildCount = CacheItemsCount = 0;
+    CacheItemsVersion = 0;
+    CacheItemsGetter = NULL;
+    CacheUserData = NULL;
+    CacheOutIndices = NULL;
+    // add by Dicky end
     if (default_filter)
     {
         ImStrncpy(InputBuf, default_filter, IM_ARRAYSIZE(InputBuf));
@@ -2803,6 +2918,39 @@ ImGuiTextFilter::ImGuiTextFilter(const char* default_filter) //-V1077
     }
 }
 
+// add by Dicky
+// Filters point in InputBuf and the terms own their regular expressions: copies are built again
+ImGuiTextFilter::ImGuiTextFilter(const ImGuiTextFilter& src) : ImGuiTextFilter(src.InputBuf, src.Flags)
+{
+    FilterThreads = src.FilterThreads;
+}
+
+static void ImGuiTextFilterClearTerms(ImGuiTextFilter* filter)
+{
+    for (ImGuiTextFilter::ImGuiTextTerm& term : filter->Terms)
+        if (term.Regex)
+            IM_DELETE((std::regex*)term.Regex);
+    filter->Terms.resize(0);
+    filter->Needles.resize(0);
+}
+
+ImGuiTextFilter::~ImGuiTextFilter()
+{
+    ImGuiTextFilterClearTerms(this);
+}
+
+ImGuiTextFilter& ImGuiTextFilter::operator=(const ImGuiTextFilter& src)
+{
+    if (this == &src)
+        return *this;
+    memcpy(InputBuf, src.InputBuf, sizeof(InputBuf));
+    Flags = src.Flags;
+    FilterThreads = src.FilterThreads;
+    Build();
+    return *this;
+}
+// add by Dicky end
+
 bool ImGuiTextFilter::Draw(const char* label, float width)
 {
     if (width != 0.0f)
@@ -2849,33 +2997,167 @@ void ImGuiTextFilter::Build()
         if (f.b[0] != '-')
             CountGrep += 1;
     }
+
+    // add by Dicky
+    // Compile the terms: lower case needles, and when enabled by Flags globs searched anywhere in the text and regular expressions
+    ImGuiTextFilterClearTerms(this);
+    BuildCount++;
+    for (const ImGuiTextRange& f : Filters)
+    {
+        if (f.empty())
+            continue;
+        ImGuiTextTerm term;
+        term.Type = ImGuiTextTermType_Substring;
+        term.Exclude = (f.b[0] == '-');
+        term.Regex = NULL;
+        const char* b = term.Exclude ? f.b + 1 : f.b;
+        const char* e = f.e;
+        if (b == e)
+            continue; // "-" alone excludes nothing
+        if ((Flags & ImGuiTextFilterFlags_Regex) && e - b >= 3 && b[0] == '/' && e[-1] == '/')
+        {
+            // An invalid expression (e.g. while typing it) is searched as text
+            try
+            {
+                std::regex regex(b + 1, e - 1, std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+                term.Regex = IM_NEW(std::regex)(std::move(regex));
+                term.Type = ImGuiTextTermType_Regex;
+            }
+            catch (const std::regex_error&)
+            {
+            }
+        }
+        else if ((Flags & ImGuiTextFilterFlags_Glob) && (memchr(b, '*', e - b) || memchr(b, '?', e - b)))
+        {
+            term.Type = ImGuiTextTermType_Glob;
+        }
+        term.NeedleOffset = Needles.Size;
+        if (term.Type == ImGuiTextTermType_Glob)
+            Needles.push_back('*');
+        for (const char* c = b; c < e; c++)
+            Needles.push_back(ImToLower(*c));
+        if (term.Type == ImGuiTextTermType_Glob)
+            Needles.push_back('*');
+        term.NeedleLen = Needles.Size - term.NeedleOffset;
+        Needles.push_back(0);
+        Terms.push_back(term);
+    }
+    // add by Dicky end
 }
 
-bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
+// add by Dicky
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_TEXT_FILTER_SSE2
+static inline __m128i ImTextFilterToLower16(__m128i v)
 {
-    if (Filters.Size == 0)
-        return true;
+    const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
 
-    if (text == NULL)
-        text = text_end = "";
+static inline bool ImTextFilterMatchAt(const char* text, const char* needle, int needle_len)
+{
+    for (int n = 1; n < needle_len - 1; n++)
+        if (ImToLower(text[n]) != needle[n])
+            return false;
+    return true;
+}
 
-    for (const ImGuiTextRange& f : Filters)
+// Case insensitive search of a lower case needle. The candidates match the first and the last character of the needle, with SSE2 they
+// are found 16 positions at a time.
+static const char* ImTextFilterFind(const char* haystack, const char* haystack_end, const char* needle, int needle_len)
+{
+    if (needle_len > haystack_end - haystack)
+        return NULL;
+    const char* haystack_last = haystack_end - needle_len;
+    const char first_c = needle[0];
+    const char last_c = needle[needle_len - 1];
+#ifdef IMGUI_TEXT_FILTER_SSE2
+    const __m128i first_v = _mm_set1_epi8(first_c);
+    const __m128i last_v = _mm_set1_epi8(last_c);
+    for (; haystack + 15 <= haystack_last; haystack += 16)
+    {
+        const __m128i first_eq = _mm_cmpeq_epi8(ImTextFilterToLower16(_mm_loadu_si128((const __m128i*)haystack)), first_v);
+        const __m128i last_eq = _mm_cmpeq_epi8(ImTextFilterToLower16(_mm_loadu_si128((const __m128i*)(haystack + needle_len - 1))), last_v);
+        for (unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(first_eq, last_eq)), n = 0; mask != 0; mask >>= 1, n++)
+            if ((mask & 1) && ImTextFilterMatchAt(haystack + n, needle, needle_len))
+                return haystack + n;
+    }
+#endif
+    for (; haystack <= haystack_last; haystack++)
+        if (ImToLower(haystack[0]) == first_c && ImToLower(haystack[needle_len - 1]) == last_c && ImTextFilterMatchAt(haystack, needle, needle_len))
+            return haystack;
+    return NULL;
+}
+
+// Case insensitive glob of a lower case pattern: '*' matches any text, '?' one UTF-8 character. Backtracks to the last '*' only.
+static bool ImTextFilterMatchGlob(const char* text, const char* text_end, const char* pattern, const char* pattern_end)
+{
+    const char* star_pattern = NULL;
+    const char* star_text = NULL;
+    while (text < text_end)
     {
-        if (f.b == f.e)
-            continue;
-        if (f.b[0] == '-')
+        if (pattern < pattern_end && *pattern == '*')
         {
-            // Subtract
-            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
-                return false;
+            star_pattern = ++pattern;
+            star_text = text;
+        }
+        else if (pattern < pattern_end && *pattern == '?')
+        {
+            pattern++;
+            text++;
+            while (text < text_end && (*text & 0xC0) == 0x80)
+                text++;
+        }
+        else if (pattern < pattern_end && *pattern == ImToLower(*text))
+        {
+            pattern++;
+            text++;
+        }
+        else if (star_pattern)
+        {
+            pattern = star_pattern;
+            text = ++star_text;
         }
         else
         {
-            // Grep
-            if (ImStristr(text, text_end, f.b, f.e) != NULL)
-                return true;
+            return false;
         }
     }
+    while (pattern < pattern_end && *pattern == '*')
+        pattern++;
+    return pattern == pattern_end;
+}
+
+static bool ImGuiTextFilterMatchTerm(const ImGuiTextFilter* filter, const ImGuiTextFilter::ImGuiTextTerm& term, const char* text, const char* text_end)
+{
+    const char* needle = filter->Needles.Data + term.NeedleOffset;
+    switch (term.Type)
+    {
+    case ImGuiTextFilter::ImGuiTextTermType_Substring:  return ImTextFilterFind(text, text_end, needle, term.NeedleLen) != NULL;
+    case ImGuiTextFilter::ImGuiTextTermType_Glob:       return ImTextFilterMatchGlob(text, text_end, needle, needle + term.NeedleLen);
+    case ImGuiTextFilter::ImGuiTextTermType_Regex:      return std::regex_search(text, text_end, *(const std::regex*)term.Regex);
+    }
+    return false;
+}
+// add by Dicky end
+
+bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
+{
+    if (Filters.Size == 0)
+        return true;
+
+    if (text == NULL)
+        text = text_end = "";
+    // modify by Dicky
+    else if (text_end == NULL)
+        text_end = text + strlen(text);
+
+    // Compiled terms in the order of Filters: the first one matching includes or excludes the text
+    for (const ImGuiTextTerm& term : Terms)
+        if (ImGuiTextFilterMatchTerm(this, term, text, text_end))
+            return !term.Exclude;
+    // modify by Dicky end
 
     // Implicit * grep
     if (CountGrep == 0)
@@ -2884,6 +3166,98 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+// add by Dicky
+// Items are handed out to the threads by chunks, written to CachePass then compacted in order
+#ifndef IMGUI_TEXT_FILTER_CHUNK_SIZE
+#define IMGUI_TEXT_FILTER_CHUNK_SIZE 4096
+#endif
+
+bool ImGuiTextFilter::Filter(int items_count, const char* (*items_getter)(void* user_data, int idx, const char** out_text_end), void* user_data, ImVector<int>* out_indices, ImU64 items_version)
+{
+    IM_ASSERT(items_count >= 0 && items_getter != NULL && out_indices != NULL);
+    const bool same_items = CacheOutIndices == out_indices && CacheBuildCount == BuildCount && CacheItemsGetter == items_getter && CacheUserData == user_data && CacheItemsVersion == items_version;
+    if (same_items && CacheItemsCount == items_count)
+        return false;
+
+    // Appended items: the previous last item is filtered again with them
+    int first = 0;
+    if (same_items && items_count > CacheItemsCount && CacheItemsCount > 0)
+    {
+        first = CacheItemsCount - 1;
+        if (!out_indices->empty() && out_indices->back() == first)
+            out_indices->pop_back();
+    }
+    else
+    {
+        out_indices->resize(0);
+    }
+    CacheBuildCount = BuildCount;
+    CacheItemsCount = items_count;
+    CacheItemsVersion = items_version;
+    CacheItemsGetter = items_getter;
+    CacheUserData = user_data;
+    CacheOutIndices = out_indices;
+
+    const int count = items_count - first;
+    if (!IsActive())
+    {
+        if (out_indices->Capacity < out_indices->Size + count)
+            out_indices->reserve(out_indices->_grow_capacity(out_indices->Size + count));
+        for (int idx = first; idx < items_count; idx++)
+            out_indices->push_back(idx);
+        return true;
+    }
+
+    CachePass.resize(count);
+    const int chunks_count = (count + IMGUI_TEXT_FILTER_CHUNK_SIZE - 1) / IMGUI_TEXT_FILTER_CHUNK_SIZE;
+    const int threads_count = ImMin(ImMax((FilterThreads > 0) ? FilterThreads : (int)std::thread::hardware_concurrency(), 1), chunks_count);
+    std::atomic<int> next_chunk(0);
+    auto worker = [&]()
+    {
+        for (int chunk = next_chunk++; chunk < chunks_count; chunk = next_chunk++)
+        {
+            const int chunk_end = ImMin((chunk + 1) * IMGUI_TEXT_FILTER_CHUNK_SIZE, count);
+            for (int n = chunk * IMGUI_TEXT_FILTER_CHUNK_SIZE; n < chunk_end; n++)
+            {
+                const char* text_end = NULL;
+                const char* text = items_getter(user_data, first + n, &text_end);
+                CachePass.Data[n] = PassFilter(text, text_end) ? 1 : 0;
+            }
+        }
+    };
+    ImVector<std::thread*> threads;
+    for (int thread_n = 1; thread_n < threads_count; thread_n++)
+        threads.push_back(IM_NEW(std::thread)(worker));
+    worker();
+    for (std::thread* thread : threads)
+    {
+        thread->join();
+        IM_DELETE(thread);
+    }
+
+    int pass_count = 0;
+    for (int n = 0; n < count; n++)
+        pass_count += CachePass.Data[n];
+    if (out_indices->Capacity < out_indices->Size + pass_count)
+        out_indices->reserve(out_indices->_grow_capacity(out_indices->Size + pass_count));
+    for (int n = 0; n < count; n++)
+        if (CachePass.Data[n])
+            out_indices->push_back(first + n);
+    return true;
+}
+
+static const char* ImGuiTextFilterArrayGetter(void* user_data, int idx, const char** out_text_end)
+{
+    IM_UNUSED(out_text_end);
+    return ((const char* const*)user_data)[idx];
+}
+
+bool ImGuiTextFilter::Filter(const char* const items[], int items_count, ImVector<int>* out_indices, ImU64 items_version)
+{
+    return Filter(items_count, ImGuiTextFilterArrayGetter, (void*)items, out_indices, items_version);
+}
+// add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiTextBuffer, ImGuiTextIndex
 //-----------------------------------------------------------------------------
@@ -4011,10 +4385,13 @@ void ImGui::Shutdown()
     g.MultiSelectStorage.Clear();
     g.MultiSelectTempData.clear_destruct();
 
+    g.TextLayoutCache.Clear(); // add by Dicky
+
     g.ClipboardHandlerData.clear();
     g.MenusIdSubmittedThisFrame.clear();
     g.InputTextState.ClearFreeMemory();
     g.InputTextDeactivatedState.ClearFreeMemory();
+    g.InputTextLargeState.ClearFreeMemory(); // add by Dicky
 
     g.SettingsWindows.clear();
     g.SettingsHandlers.clear();
@@ -4963,12 +5340,18 @@ static void SetupDrawListSharedData()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextSDF)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowTextSDF; // add by Dicky
 }
 
 void ImGui::NewFrame()
 {
     IM_ASSERT(GImGui != NULL && "No current context. Did you call ImGui::CreateContext() and ImGui::SetCurrentContext() ?");
     ImGuiContext& g = *GImGui;
+#if IMGUI_PROFILER
+    ProfilerNewFrame();
+#endif
+    IMGUI_PROFILE_BEGIN("NewFrame", NULL);
 
     // Remove pending delete hooks before frame start.
     // This deferred removal avoid issues of removal while iterating the hook vector
@@ -4995,6 +5378,7 @@ void ImGui::NewFrame()
 
     // Add By Dicky for Power Saving
     g.MaxWaitBeforeNextFrame = 0;
+    g.AnimationWaitTime = INFINITY;
     g.WallClock = get_current_time();
     if (g.IO.ConfigFlags & ImGuiConfigFlags_EnableLowRefreshMode)
         g.MaxWaitBeforeNextFrame = 1.0 / g.IO.MaxFrameRate;
@@ -5017,6 +5401,8 @@ void ImGui::NewFrame()
     // Setup current font and draw list shared data
     // FIXME-VIEWPORT: the concept of a single ClipRectFullscreen is not ideal!
     g.IO.Fonts->Locked = true;
+    ImFontAtlasBuildDynamicNewFrame(g.IO.Fonts); // add by Dicky, glyph cache pages used from now on can't be evicted until the next frame
+    TextLayoutCacheGC(); // add by Dicky
     SetupDrawListSharedData();
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
@@ -5217,6 +5603,9 @@ void ImGui::NewFrame()
     }
 #endif
 
+    // The implicit window scope below lasts until EndFrame()
+    IMGUI_PROFILE_END();
+
     // Create implicit/fallback window - which we will only render it if the user has added something to it.
     // We don't use "Debug" to avoid colliding with user trying to create a "Debug" window with custom flags.
     // This fallback is particularly important as it prevents ImGui:: calls from crashing.
@@ -5515,6 +5904,7 @@ void ImGui::EndFrame()
     if (g.CurrentWindow && !g.CurrentWindow->WriteAccessed)
         g.CurrentWindow->Active = false;
     End();
+    IMGUI_PROFILE_SCOPE("EndFrame");
 
     // Update navigation: CTRL+Tab, wrap-around requests
     NavEndFrame();
@@ -5591,6 +5981,68 @@ void ImGui::EndFrame()
     CallContextHooks(&g, ImGuiContextHookType_EndFramePost);
 }
 
+// Add by Dicky for skipping unchanged frames
+// Change detection only, not a cryptographic hash. 8 bytes per step over 4 lanes so a full frame of vertices costs well under a millisecond.
+static inline ImU64 HashMix64(ImU64 h, ImU64 v)
+{
+    h ^= v * 0x9E3779B97F4A7C15ULL;
+    h = (h << 31) | (h >> 33);
+    return h * 0xBF58476D1CE4E5B9ULL;
+}
+
+static ImU64 HashDrawBytes(ImU64 seed, const void* data, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    ImU64 h0 = seed, h1 = seed ^ 0x6A09E667F3BCC909ULL, h2 = seed ^ 0xBB67AE8584CAA73BULL, h3 = seed ^ 0x3C6EF372FE94F82BULL;
+    for (; size >= 32; p += 32, size -= 32)
+    {
+        ImU64 v[4];
+        memcpy(v, p, 32);
+        h0 = HashMix64(h0, v[0]);
+        h1 = HashMix64(h1, v[1]);
+        h2 = HashMix64(h2, v[2]);
+        h3 = HashMix64(h3, v[3]);
+    }
+    ImU64 h = HashMix64(HashMix64(HashMix64(h0, h1), h2), h3);
+    for (; size >= 8; p += 8, size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, p, 8);
+        h = HashMix64(h, v);
+    }
+    if (size > 0)
+    {
+        ImU64 v = 0;
+        memcpy(&v, p, size);
+        h = HashMix64(h, v ^ ((ImU64)size << 56));
+    }
+    return h;
+}
+
+static ImU64 HashDrawData(const ImDrawData* draw_data)
+{
+    const float display[6] = { draw_data->DisplayPos.x, draw_data->DisplayPos.y, draw_data->DisplaySize.x, draw_data->DisplaySize.y, draw_data->FramebufferScale.x, draw_data->FramebufferScale.y };
+    ImU64 h = HashDrawBytes((ImU64)draw_data->CmdListsCount, display, sizeof(display));
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            // A user callback may render anything, only the reset state marker is known to be static
+            if (cmd.UserCallback != NULL && cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                return 0;
+            // Field by field, padding of ImDrawCmd is not guaranteed to be zero
+            h = HashDrawBytes(h, &cmd.ClipRect, sizeof(cmd.ClipRect));
+            h = HashMix64(h, (ImU64)(intptr_t)cmd.TextureId);
+            h = HashMix64(h, ((ImU64)cmd.VtxOffset << 32) | cmd.IdxOffset);
+            h = HashMix64(h, ((ImU64)cmd.ElemCount << 32) | (cmd.UserCallback != NULL ? 1 : 0));
+        }
+        h = HashDrawBytes(h, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes());
+        h = HashDrawBytes(h, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes());
+    }
+    return h != 0 ? h : 1; // 0 is reserved for 'always changed'
+}
+// Add by Dicky end
+
 // Prepare the data for rendering so you can call GetDrawData()
 // (As with anything within the ImGui:: namspace this doesn't touch your GPU or graphics API at all:
 // it is the role of the ImGui_ImplXXXX_RenderDrawData() function provided by the renderer backend)
@@ -5604,6 +6056,7 @@ void ImGui::Render()
     if (g.FrameCountRendered == g.FrameCount)
         return;
     g.FrameCountRendered = g.FrameCount;
+    IMGUI_PROFILE_SCOPE("Render");
 
     g.IO.MetricsRenderWindows = 0;
     CallContextHooks(&g, ImGuiContextHookType_RenderPre);
@@ -5658,6 +6111,19 @@ void ImGui::Render()
 
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
+
+        // Add by Dicky for skipping unchanged frames
+        if (g.IO.ConfigSkipUnchangedFrames)
+        {
+            ImU64 hash = HashDrawData(draw_data);
+            draw_data->Unchanged = hash != 0 && hash == viewport->LastDrawDataHash && viewport->LastAnimatedFrame != g.FrameCount;
+            viewport->LastDrawDataHash = hash;
+        }
+        else
+        {
+            viewport->LastDrawDataHash = 0;
+        }
+        // Add by Dicky end
     }
 
     CallContextHooks(&g, ImGuiContextHookType_RenderPost);
@@ -5690,11 +6156,12 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const char * _text_end = text_end ? text_end : text + strlen(text);
     if (g.Style.TextInternationalize)
     {
-        auto changed = ImGui::InternationalizedText(_text_begin, _text_end);
-        if (changed > 0)
+        const char* localized_end = NULL;
+        const char* localized = ImGui::FindInternationalizedText(_text_begin, _text_end, &localized_end);
+        if (localized)
         {
-            _text_begin = g.InternationalizedBuffer;
-            _text_end = _text_begin + changed;
+            _text_begin = localized;
+            _text_end = localized_end;
         }
     }
 
@@ -5708,7 +6175,20 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (_text_begin == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, _text_begin, text_display_end, NULL);
+    ImVec2 text_size;
+    if (ImGuiTextLayout* layout = TextLayoutCacheFind(font, font_size, wrap_width, _text_begin, text_display_end))
+    {
+        if (!layout->SizeValid)
+        {
+            layout->Size = font->CalcTextSizeA(font_size, FLT_MAX, layout->WrapWidth, _text_begin, text_display_end, NULL);
+            layout->SizeValid = true;
+        }
+        text_size = layout->Size;
+    }
+    else
+    {
+        text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, _text_begin, text_display_end, NULL);
+    }
     // Modify by Dicky end
 
     // Round
@@ -5722,53 +6202,173 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
 }
 
 // add by Dicky for multi-language support
-size_t ImGui::InternationalizedText(const char* text_begin, const char* text_end)
+void ImGuiLanguageTable::Add(const char* key, int key_len, const char* value, int value_len)
 {
-    ImGuiContext& g = *GImGui;
-    if (g.LanguagesLoaded && !g.LanguageName.empty() && !g.StringMap.empty())
+    if ((Count + 1) * 2 > Slots.Size)
     {
-        auto& map = g.StringMap[g.LanguageName];
-        if (map.empty())
-            return 0;
-        size_t buffer_size = ImMin((size_t)(text_end - text_begin), sizeof(g.InternationalizedBuffer));
-        memcpy(g.InternationalizedBuffer, text_begin, buffer_size);
-        std::string key(g.InternationalizedBuffer, buffer_size);
-        std::string name = map[key];
-        std::string name_prefix;
-        if (name.empty())
-        {
-            // search key which remove chars before first space in case we add icon before str
-            auto pos = key.find_first_of(" ");
-            if (pos == std::string::npos)
-                return 0;
-            // check before space is only a icon
-            auto headkey = key.substr(0, pos-1);
-            auto length = headkey.length();
-            if (length != 2)
-                return 0;
-            uint16_t char_data = *(uint16_t *)headkey.data();
-            char_data = (char_data << 8) | (char_data >> 8);
-            if (char_data < 0xe000)
-                return 0;
-            auto subkey = key.substr(pos+1);
-            name_prefix = key.substr(0, pos + 1);
-            name = map[subkey];
+        // Rehash into a table twice as large
+        ImVector<ImGuiLanguageEntry> old_slots;
+        old_slots.swap(Slots);
+        Slots.resize(ImMax(old_slots.Size * 2, 64));
+        memset(Slots.Data, 0, (size_t)Slots.size_in_bytes());
+        const int mask = Slots.Size - 1;
+        for (const ImGuiLanguageEntry& entry : old_slots)
+        {
+            if (entry.KeyHash == 0)
+                continue;
+            int idx = (int)(entry.KeyHash & mask);
+            while (Slots[idx].KeyHash != 0)
+                idx = (idx + 1) & mask;
+            Slots[idx] = entry;
         }
-        else
+    }
+
+    ImGuiID hash = ImHashStr(key, key_len);
+    if (hash == 0)
+        hash = 1;
+    const int mask = Slots.Size - 1;
+    int idx = (int)(hash & mask);
+    while (Slots[idx].KeyHash != 0)
+    {
+        const ImGuiLanguageEntry& entry = Slots[idx];
+        if (entry.KeyHash == hash && entry.KeyLen == key_len && memcmp(GetKey(&entry), key, key_len) == 0)
+            break;
+        idx = (idx + 1) & mask;
+    }
+    ImGuiLanguageEntry& entry = Slots[idx];
+    if (entry.KeyHash == 0)
+    {
+        entry.KeyHash = hash;
+        entry.KeyOffset = Strings.Size;
+        entry.KeyLen = key_len;
+        Strings.resize(Strings.Size + key_len + 1);
+        memcpy(Strings.Data + entry.KeyOffset, key, key_len);
+        Strings[entry.KeyOffset + key_len] = 0;
+        Count++;
+    }
+    // Duplicated key overrides the previous value, the old string is left unused
+    entry.ValueOffset = Strings.Size;
+    entry.ValueLen = value_len;
+    Strings.resize(Strings.Size + value_len + 1);
+    memcpy(Strings.Data + entry.ValueOffset, value, value_len);
+    Strings[entry.ValueOffset + value_len] = 0;
+}
+
+const ImGuiLanguageEntry* ImGuiLanguageTable::Find(const char* key, int key_len) const
+{
+    if (Count == 0)
+        return NULL;
+    ImGuiID hash = ImHashStr(key, key_len);
+    if (hash == 0)
+        hash = 1;
+    const int mask = Slots.Size - 1;
+    int idx = (int)(hash & mask);
+    while (Slots[idx].KeyHash != 0)
+    {
+        const ImGuiLanguageEntry& entry = Slots[idx];
+        if (entry.KeyHash == hash && entry.KeyLen == key_len && memcmp(GetKey(&entry), key, key_len) == 0)
+            return &entry;
+        idx = (idx + 1) & mask;
+    }
+    return NULL;
+}
+
+// Look up 'text' in the current language table, also try without a leading icon glyph (private use area, 3 bytes utf-8)
+// followed by a space, in which case the icon is kept in front of the translation.
+static const ImGuiLanguageEntry* FindLanguageEntry(const ImGuiLanguageTable* table, const char* text, int text_len, int* out_prefix_len)
+{
+    *out_prefix_len = 0;
+    const ImGuiLanguageEntry* entry = table->Find(text, text_len);
+    if (entry)
+        return entry;
+    const char* space = (const char*)memchr(text, ' ', (size_t)text_len);
+    if (space == NULL || space - text != 3 || (unsigned char)text[0] < 0xe0)
+        return NULL;
+    const int prefix_len = (int)(space - text) + 1;
+    entry = table->Find(text + prefix_len, text_len - prefix_len);
+    if (entry)
+        *out_prefix_len = prefix_len;
+    return entry;
+}
+
+const char* ImGui::FindInternationalizedText(const char* text_begin, const char* text_end, const char** out_text_end)
+{
+    ImGuiContext& g = *GImGui;
+    if (!g.LanguagesLoaded || g.LanguageName.empty() || g.LanguageTables.empty())
+        return NULL;
+    if (g.LanguageName != g.LanguageTableName)
+    {
+        // Language switched, resolve the table once and forget the cached labels
+        auto it = g.LanguageTables.find(g.LanguageName);
+        g.LanguageTable = (it != g.LanguageTables.end() && it->second.Count > 0) ? &it->second : NULL;
+        g.LanguageTableName = g.LanguageName;
+        g.LanguageCache.clear();
+    }
+    const ImGuiLanguageTable* table = g.LanguageTable;
+    if (table == NULL)
+        return NULL;
+    if (text_end == NULL)
+        text_end = text_begin + strlen(text_begin);
+    const int text_len = (int)(text_end - text_begin);
+
+    const ImGuiLanguageEntry* entry = NULL;
+    int prefix_len = 0;
+    ImGuiLanguageCacheEntry* cache = NULL;
+    if (text_len < IM_ARRAYSIZE(cache->Text))
+    {
+        if (g.LanguageCache.Size == 0)
         {
-            size_t new_size = ImMin(name.size(), sizeof(g.InternationalizedBuffer));
-            memcpy(g.InternationalizedBuffer, name.data(), new_size);
-            return new_size;
+            g.LanguageCache.resize(1024);
+            memset(g.LanguageCache.Data, 0, (size_t)g.LanguageCache.size_in_bytes());
         }
-        if (!name.empty())
+        ImU64 key = ((ImU64)(intptr_t)text_begin >> 2) ^ ((ImU64)text_len << 40);
+        cache = &g.LanguageCache[(int)((key * 0x9E3779B97F4A7C15ULL) >> 54) & (g.LanguageCache.Size - 1)];
+    }
+    if (cache && cache->Label == text_begin && cache->LabelLen == text_len && memcmp(cache->Text, text_begin, (size_t)text_len) == 0)
+    {
+        entry = cache->Entry;
+        prefix_len = cache->PrefixLen;
+    }
+    else
+    {
+        entry = FindLanguageEntry(table, text_begin, text_len, &prefix_len);
+        if (cache)
         {
-            std::string new_str = name_prefix + name;
-            size_t new_size = ImMin(new_str.size(), sizeof(g.InternationalizedBuffer));
-            memcpy(g.InternationalizedBuffer, new_str.data(), new_size);
-            return new_size;
+            cache->Label = text_begin;
+            cache->LabelLen = text_len;
+            cache->PrefixLen = prefix_len;
+            cache->Entry = entry;
+            memcpy(cache->Text, text_begin, (size_t)text_len);
         }
     }
-    return 0;
+    if (entry == NULL)
+        return NULL;
+
+    const char* value = table->GetValue(entry);
+    if (prefix_len == 0)
+    {
+        *out_text_end = value + entry->ValueLen;
+        return value;
+    }
+    // Only the icon case needs composing
+    const int value_len = ImMin(entry->ValueLen, (int)sizeof(g.InternationalizedBuffer) - prefix_len);
+    memcpy(g.InternationalizedBuffer, text_begin, (size_t)prefix_len);
+    memcpy(g.InternationalizedBuffer + prefix_len, value, (size_t)value_len);
+    *out_text_end = g.InternationalizedBuffer + prefix_len + value_len;
+    return g.InternationalizedBuffer;
+}
+
+size_t ImGui::InternationalizedText(const char* text_begin, const char* text_end)
+{
+    ImGuiContext& g = *GImGui;
+    const char* localized_end = NULL;
+    const char* localized = FindInternationalizedText(text_begin, text_end, &localized_end);
+    if (localized == NULL)
+        return 0;
+    size_t size = ImMin((size_t)(localized_end - localized), sizeof(g.InternationalizedBuffer));
+    if (localized != g.InternationalizedBuffer)
+        memcpy(g.InternationalizedBuffer, localized, size);
+    return size;
 }
 // add by Dicky end
 
@@ -7151,6 +7751,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     const bool window_just_created = (window == NULL);
     if (window_just_created)
         window = CreateNewWindow(name, flags);
+    IMGUI_PROFILE_BEGIN("Window", window->Name);    // ended by End()
 
     // [DEBUG] Debug break requested by user
     if (g.DebugBreakInWindow == window->ID)
@@ -8118,6 +8719,7 @@ void ImGui::End()
     SetCurrentWindow(g.CurrentWindowStack.Size == 0 ? NULL : g.CurrentWindowStack.back().Window);
     if (g.CurrentWindow)
         SetCurrentViewport(g.CurrentWindow, g.CurrentWindow->Viewport);
+    IMGUI_PROFILE_END();
 }
 
 void ImGui::BringWindowToFocusFront(ImGuiWindow* window)
@@ -10854,6 +11456,13 @@ static void ImGui::ErrorCheckNewFrameSanityChecks()
     IM_ASSERT((g.FrameCount == 0 || g.FrameCountEnded == g.FrameCount)  && "Forgot to call Render() or EndFrame() at the end of the previous frame?");
     IM_ASSERT(g.IO.DisplaySize.x >= 0.0f && g.IO.DisplaySize.y >= 0.0f  && "Invalid DisplaySize value!");
     IM_ASSERT(g.IO.Fonts->IsBuilt()                                     && "Font Atlas not built! Make sure you called ImGui_ImplXXXX_NewFrame() function for renderer backend, which should call io.Fonts->GetTexDataAsRGBA32() / GetTexDataAsAlpha8()");
+    IM_ASSERT((!(g.IO.Fonts->Flags & ImFontAtlasFlags_DynamicGlyphs) || (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasDynamicGlyphs)) && "ImFontAtlasFlags_DynamicGlyphs needs a renderer backend uploading ImFontAtlas::GetTexDataDirtyRows()!"); // add by Dicky
+    // add by Dicky, drawn as bitmaps the SDF glyphs show their raw distance field
+    bool fonts_sdf = false;
+    for (const ImFontConfig& font_cfg : g.IO.Fonts->ConfigData)
+        fonts_sdf |= font_cfg.SDF;
+    IM_ASSERT((!fonts_sdf || (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextSDF)) && "ImFontConfig::SDF needs a renderer backend decoding the SDF glyph UVs (imgui_impl_opengl3 only)!");
+    // add by Dicky end
     IM_ASSERT(g.Style.CurveTessellationTol > 0.0f                       && "Invalid style setting!");
     IM_ASSERT(g.Style.CircleTessellationMaxError > 0.0f                 && "Invalid style setting!");
     IM_ASSERT(g.Style.Alpha >= 0.0f && g.Style.Alpha <= 1.0f            && "Invalid style setting!"); // Allows us to avoid a few clamps in color computations
@@ -14815,7 +15424,7 @@ void ImGui::UpdateSettings()
     // Load Language file add by Dicky
     if (!g.LanguagesLoaded)
     {
-        IM_ASSERT(g.StringMap.empty());
+        IM_ASSERT(g.LanguageTables.empty());
         if (g.IO.LanguagePath)
             LoadIniLanguagesFromDisk(g.IO.LanguagePath);
         g.LanguagesLoaded = true;
@@ -15034,8 +15643,7 @@ void ImGui::LoadIniLanguagesFromMemory(const char* ini_data, size_t ini_size)
     buf_end[0] = 0;
 
     char* line_end = NULL;
-    std::map<std::string, std::string> locale_map;
-    std::string language_name;
+    ImGuiLanguageTable* table = NULL;
     for (char* line = buf; line < buf_end; line = line_end + 1)
     {
         // Skip new lines markers, then find end of the line
@@ -15049,41 +15657,30 @@ void ImGui::LoadIniLanguagesFromMemory(const char* ini_data, size_t ini_size)
             continue;
         if (line[0] == '[' && line_end > line && line_end[-1] == ']')
         {
+            // A language section replaces any previous one of the same name
             const char* type_start = line + 1;
-            char* type_end = line_end - 1; 
+            char* type_end = line_end - 1;
             *type_end = 0; // Overwrite ']'
-            if (language_name.empty())
-                language_name = std::string(type_start);
-            else
-            {
-                g.StringMap[language_name] = locale_map;
-                locale_map.clear();
-                language_name = std::string(type_start);
-            }
+            table = &g.LanguageTables[std::string(type_start)];
+            table->Clear();
         }
-        else
+        else if (table)
         {
-            // add StringMap
-            std::string str = std::string(line);
-            auto pos = str.find_first_of("=");
-            if (pos != std::string::npos)
-            {
-                std::string key = str.substr(0, pos);
-                std::string value = str.substr(pos + 1);
-                if (key[0] == '\"' && key[key.length() - 1] == '\"' &&
-                    value[0] == '\"' && value[value.length() - 1] == '\"')
-                {
-                    std::string key_name = key.substr(1, key.size() - 2);
-                    std::string value_name = value.substr(1, value.size() - 2);
-                    locale_map[key_name] = value_name;
-                }
-            }
+            // "key"="value"
+            const char* eq = strchr(line, '=');
+            if (eq == NULL || eq - line < 2 || line_end - eq < 3)
+                continue;
+            if (line[0] != '\"' || eq[-1] != '\"' || eq[1] != '\"' || line_end[-1] != '\"')
+                continue;
+            if (line_end - eq == 3)
+                continue; // empty translation keeps the source text
+            table->Add(line + 1, (int)(eq - line) - 2, eq + 2, (int)(line_end - eq) - 3);
         }
     }
-    if (!language_name.empty())
-    {
-        g.StringMap[language_name] = locale_map;
-    }
+    // Tables may have been rebuilt, resolve LanguageName again on next lookup
+    g.LanguageTableName.clear();
+    g.LanguageTable = NULL;
+    g.LanguageCache.clear();
 }
 
 void ImGui::SaveIniLanguagesToDisk(const char* ini_filename)
@@ -16189,6 +16786,8 @@ void ImGui::RenderPlatformWindowsDefault(void* platform_render_arg, void* render
         ImGuiViewport* viewport = platform_io.Viewports[i];
         if (viewport->Flags & ImGuiViewportFlags_IsMinimized)
             continue;
+        if (viewport->DrawData && viewport->DrawData->Unchanged) // Add by Dicky for skipping unchanged frames
+            continue;
         if (platform_io.Platform_RenderWindow) platform_io.Platform_RenderWindow(viewport, platform_render_arg);
         if (platform_io.Renderer_RenderWindow) platform_io.Renderer_RenderWindow(viewport, renderer_render_arg);
     }
@@ -16197,6 +16796,8 @@ void ImGui::RenderPlatformWindowsDefault(void* platform_render_arg, void* render
         ImGuiViewport* viewport = platform_io.Viewports[i];
         if (viewport->Flags & ImGuiViewportFlags_IsMinimized)
             continue;
+        if (viewport->DrawData && viewport->DrawData->Unchanged) // Add by Dicky for skipping unchanged frames
+            continue;
         if (platform_io.Platform_SwapBuffers) platform_io.Platform_SwapBuffers(viewport, platform_render_arg);
         if (platform_io.Renderer_SwapBuffers) platform_io.Renderer_SwapBuffers(viewport, renderer_render_arg);
     }
@@ -20525,6 +21126,14 @@ void ImGui::sleep(int ms_seconds)
 }
 
 // Power Save utils
+double ImGui::GetAnimatedRegionWaitingTime()
+{
+    ImGuiContext& g = *GImGui;
+    if (g.AnimationWaitTime == INFINITY)
+        return INFINITY;
+    return ImMax(0.0, g.AnimationWaitTime - (get_current_time() - g.WallClock));
+}
+
 double ImGui::GetEventWaitingTime()
 {
     ImGuiContext& g = *GImGui;
@@ -20535,12 +21144,515 @@ double ImGui::GetEventWaitingTime()
         double delta = g.MaxWaitBeforeNextFrame - deltaTime;
         if ((g.IO.ConfigFlags & ImGuiConfigFlags_EnablePowerSavingMode) && g.IO.FrameCountSinceLastUpdate > g.IO.MaxDelayFrameCount)
             delta = INFINITY;
-        return ImMax(0.0, delta);
+        return ImMax(0.0, ImMin(delta, GetAnimatedRegionWaitingTime()));
     }
     else if ((g.IO.ConfigFlags & ImGuiConfigFlags_EnablePowerSavingMode) && g.IO.FrameCountSinceLastUpdate > g.IO.MaxDelayFrameCount)
-        return ImMax(0.0, g.MaxWaitBeforeNextFrame);
+        return ImMax(0.0, ImMin(g.MaxWaitBeforeNextFrame, GetAnimatedRegionWaitingTime()));
     return 0.0;
 }
+
+void ImGui::MarkAnimatedRegion(const ImVec2& p_min, const ImVec2& p_max, double interval)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImRect rect(p_min, p_max);
+    if (window)
+        rect.ClipWith(window->ClipRect);
+    if (rect.Min.x >= rect.Max.x || rect.Min.y >= rect.Max.y)
+        return; // Clipped out, nothing to repaint
+    ImGuiViewportP* viewport = window ? window->Viewport : (ImGuiViewportP*)GetMainViewport();
+    if (viewport)
+        viewport->LastAnimatedFrame = g.FrameCount;
+    g.AnimationWaitTime = ImMin(g.AnimationWaitTime, ImMax(0.0, interval));
+}
+
+void ImGui::InvalidateViewportDrawData(ImGuiViewport* viewport)
+{
+    if (viewport == NULL)
+        viewport = GetMainViewport();
+    ((ImGuiViewportP*)viewport)->LastDrawDataHash = 0;
+}
+
+void ImGui::WaitUnchangedFrame(float refresh_rate)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawData* draw_data = GetDrawData();
+    if (draw_data == NULL || !draw_data->Unchanged)
+        return;
+    double frame_time = 1.0 / (refresh_rate > 1.0f ? refresh_rate : 60.0f);
+    double remaining = frame_time - (get_current_time() - g.WallClock);
+    if (remaining > 0.0)
+        sleep((float)remaining);
+}
+//-----------------------------------------------------------------------------
+// Profiler
+// Every thread owns a ring of completed scopes, written by that thread only and published with a release store of Head.
+// ProfilerNewFrame() drains the rings into the captured frames, events overwritten while being copied are dropped.
+#if IMGUI_PROFILER
+#include <atomic>
+#include <mutex>
+#include "imgui_json.h"
+
+#define IMGUI_PROFILER_THREAD_EVENTS    (1 << 15)   // ring size per thread, power of two
+#define IMGUI_PROFILER_MAX_DEPTH        64
+#define IMGUI_PROFILER_FRAMES           60
+
+struct ImGuiProfilerEvent
+{
+    const char*             Name;
+    const char*             Label;
+    int64_t                 Start;
+    int64_t                 End;
+    int                     Depth;
+};
+
+struct ImGuiProfilerThread
+{
+    ImGuiProfilerEvent*     Events;
+    std::atomic<uint32_t>   Head;                                   // completed events, stored by the owner thread
+    uint32_t                Tail;                                   // collected events, owned by ProfilerNewFrame()
+    int                     Index;
+    int                     Depth;
+    char                    Name[32];                               // guarded by ImGuiProfiler::Mutex
+    bool                    NameSet;
+    ImGuiProfilerEvent      Open[IMGUI_PROFILER_MAX_DEPTH];
+};
+
+struct ImGuiProfilerRecord
+{
+    const char*             Name;
+    int                     Label;                                  // offset in ImGuiProfilerFrame::Labels, -1 if none
+    short                   Thread;
+    short                   Depth;
+    int64_t                 Start;
+    int64_t                 End;
+};
+
+struct ImGuiProfilerFrame
+{
+    int64_t                 Start = 0;
+    int64_t                 End = 0;
+    ImVector<ImGuiProfilerRecord> Records;
+    ImVector<char>          Labels;
+};
+
+struct ImGuiProfilerStat
+{
+    const char*             Name;
+    const char*             Label;
+    int                     Calls;
+    double                  Total;                                  // in ms
+    double                  Self;
+};
+
+struct ImGuiProfiler
+{
+    std::mutex              Mutex;
+    ImVector<ImGuiProfilerThread*> Threads;
+    ImGuiProfilerFrame      Frames[IMGUI_PROFILER_FRAMES];
+    int                     FramesCount = 0;
+    int                     FramesHead = 0;                         // next frame to write
+    int64_t                 FrameStart = 0;
+    int64_t                 Dropped = 0;
+    bool                    Paused = false;
+    int                     ViewFrame = 0;                          // 0: latest
+    float                   ViewZoom = 1.0f;
+};
+
+static ImGuiProfiler& ProfilerGet()
+{
+    static ImGuiProfiler profiler;
+    return profiler;
+}
+
+static inline int64_t ProfilerNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImGuiProfilerThread* ProfilerGetThread()
+{
+    // Threads buffers are never freed, a thread may exit while its last events are still waiting for collection
+    static thread_local ImGuiProfilerThread* thread = NULL;
+    if (thread)
+        return thread;
+    ImGuiProfiler& profiler = ProfilerGet();
+    thread = IM_NEW(ImGuiProfilerThread)();
+    thread->Events = (ImGuiProfilerEvent*)IM_ALLOC(sizeof(ImGuiProfilerEvent) * IMGUI_PROFILER_THREAD_EVENTS);
+    thread->Head.store(0, std::memory_order_relaxed);
+    thread->Tail = 0;
+    thread->Depth = 0;
+    thread->NameSet = false;
+    std::lock_guard<std::mutex> lock(profiler.Mutex);
+    thread->Index = profiler.Threads.Size;
+    ImFormatString(thread->Name, IM_ARRAYSIZE(thread->Name), "Thread %d", thread->Index);
+    profiler.Threads.push_back(thread);
+    return thread;
+}
+
+void ImGui::ProfilerBeginScope(const char* name, const char* label)
+{
+    ImGuiProfilerThread* thread = ProfilerGetThread();
+    int depth = thread->Depth++;
+    if (depth >= IMGUI_PROFILER_MAX_DEPTH)
+        return; // Too deep, counted but not recorded
+    ImGuiProfilerEvent& event = thread->Open[depth];
+    event.Name = name;
+    event.Label = label;
+    event.Depth = depth;
+    event.Start = ProfilerNow();
+}
+
+void ImGui::ProfilerEndScope()
+{
+    ImGuiProfilerThread* thread = ProfilerGetThread();
+    if (thread->Depth <= 0)
+        return; // Unbalanced End
+    int depth = --thread->Depth;
+    if (depth >= IMGUI_PROFILER_MAX_DEPTH)
+        return;
+    uint32_t head = thread->Head.load(std::memory_order_relaxed);
+    ImGuiProfilerEvent& event = thread->Events[head & (IMGUI_PROFILER_THREAD_EVENTS - 1)];
+    event = thread->Open[depth];
+    event.End = ProfilerNow();
+    thread->Head.store(head + 1, std::memory_order_release);
+}
+
+void ImGui::ProfilerSetThreadName(const char* name)
+{
+    ImGuiProfilerThread* thread = ProfilerGetThread();
+    std::lock_guard<std::mutex> lock(ProfilerGet().Mutex);
+    ImStrncpy(thread->Name, name, IM_ARRAYSIZE(thread->Name));
+    thread->NameSet = true;
+}
+
+void ImGui::ProfilerPause(bool pause)
+{
+    ProfilerGet().Paused = pause;
+}
+
+void ImGui::ProfilerNewFrame()
+{
+    ImGuiProfiler& profiler = ProfilerGet();
+    ImGuiProfilerThread* main_thread = ProfilerGetThread();
+    int64_t now = ProfilerNow();
+    ImGuiProfilerFrame* frame = NULL;
+    if (!profiler.Paused && profiler.FrameStart != 0)
+    {
+        frame = &profiler.Frames[profiler.FramesHead];
+        frame->Start = profiler.FrameStart;
+        frame->End = now;
+        frame->Records.resize(0);
+        frame->Labels.resize(0);
+    }
+    profiler.FrameStart = now;
+
+    std::lock_guard<std::mutex> lock(profiler.Mutex);
+    if (!main_thread->NameSet)
+    {
+        ImStrncpy(main_thread->Name, "Main", IM_ARRAYSIZE(main_thread->Name));
+        main_thread->NameSet = true;
+    }
+    ImGuiStorage labels;
+    for (ImGuiProfilerThread* thread : profiler.Threads)
+    {
+        uint32_t head = thread->Head.load(std::memory_order_acquire);
+        uint32_t tail = thread->Tail;
+        if (head - tail > IMGUI_PROFILER_THREAD_EVENTS)
+        {
+            profiler.Dropped += head - tail - IMGUI_PROFILER_THREAD_EVENTS;
+            tail = head - IMGUI_PROFILER_THREAD_EVENTS;
+        }
+        thread->Tail = head;
+        if (!frame)
+            continue;
+        int first = frame->Records.Size;
+        for (uint32_t n = tail; n != head; n++)
+        {
+            const ImGuiProfilerEvent& event = thread->Events[n & (IMGUI_PROFILER_THREAD_EVENTS - 1)];
+            ImGuiProfilerRecord record;
+            record.Name = event.Name;
+            record.Label = -1;
+            record.Thread = (short)thread->Index;
+            record.Depth = (short)event.Depth;
+            record.Start = event.Start;
+            record.End = event.End;
+            if (event.Label)
+            {
+                // Labels are usually window names, only keep one copy of each per frame
+                ImGuiID id = ImHashStr(event.Label);
+                int offset = labels.GetInt(id, 0) - 1;
+                if (offset < 0 || strcmp(frame->Labels.Data + offset, event.Label) != 0)
+                {
+                    offset = frame->Labels.Size;
+                    int len = (int)strlen(event.Label) + 1;
+                    frame->Labels.resize(offset + len);
+                    memcpy(frame->Labels.Data + offset, event.Label, len);
+                    labels.SetInt(id, offset + 1);
+                }
+                record.Label = offset;
+            }
+            frame->Records.push_back(record);
+        }
+
+        // The owner thread may have lapped us while copying, drop what it may have overwritten
+        uint32_t head_after = thread->Head.load(std::memory_order_acquire);
+        if (head_after - tail > IMGUI_PROFILER_THREAD_EVENTS)
+        {
+            int overwritten = (int)ImMin(head_after - tail - IMGUI_PROFILER_THREAD_EVENTS, head - tail);
+            frame->Records.erase(frame->Records.Data + first, frame->Records.Data + first + overwritten);
+            profiler.Dropped += overwritten;
+        }
+    }
+    if (frame)
+    {
+        profiler.FramesHead = (profiler.FramesHead + 1) % IMGUI_PROFILER_FRAMES;
+        profiler.FramesCount = ImMin(profiler.FramesCount + 1, IMGUI_PROFILER_FRAMES);
+    }
+}
+
+static const ImGuiProfilerFrame* ProfilerGetFrame(int back)
+{
+    ImGuiProfiler& profiler = ProfilerGet();
+    if (back < 0 || back >= profiler.FramesCount)
+        return NULL;
+    return &profiler.Frames[(profiler.FramesHead - 1 - back + IMGUI_PROFILER_FRAMES) % IMGUI_PROFILER_FRAMES];
+}
+
+bool ImGui::ProfilerSaveTrace(const char* path)
+{
+    ImGuiProfiler& profiler = ProfilerGet();
+    const ImGuiProfilerFrame* oldest = ProfilerGetFrame(profiler.FramesCount - 1);
+    if (!oldest)
+        return false;
+    const int64_t origin = oldest->Start;
+
+    // Chrome trace event format: times in microseconds, 'X' complete events, 'i' instant events, 'M' metadata
+    imgui_json::array events;
+    {
+        std::lock_guard<std::mutex> lock(profiler.Mutex);
+        for (ImGuiProfilerThread* thread : profiler.Threads)
+        {
+            imgui_json::value event;
+            event["name"] = "thread_name";
+            event["ph"] = "M";
+            event["pid"] = 0.0;
+            event["tid"] = (double)thread->Index;
+            event["args"]["name"] = thread->Name;
+            events.push_back(std::move(event));
+        }
+    }
+    for (int back = profiler.FramesCount - 1; back >= 0; back--)
+    {
+        const ImGuiProfilerFrame* frame = ProfilerGetFrame(back);
+        imgui_json::value frame_event;
+        frame_event["name"] = "Frame";
+        frame_event["ph"] = "i";
+        frame_event["s"] = "g";
+        frame_event["pid"] = 0.0;
+        frame_event["tid"] = 0.0;
+        frame_event["ts"] = (frame->Start - origin) / 1000.0;
+        events.push_back(std::move(frame_event));
+        for (const ImGuiProfilerRecord& record : frame->Records)
+        {
+            imgui_json::value event;
+            event["name"] = record.Name;
+            event["ph"] = "X";
+            event["pid"] = 0.0;
+            event["tid"] = (double)record.Thread;
+            event["ts"] = (record.Start - origin) / 1000.0;
+            event["dur"] = (record.End - record.Start) / 1000.0;
+            if (record.Label >= 0)
+                event["args"]["label"] = frame->Labels.Data + record.Label;
+            events.push_back(std::move(event));
+        }
+    }
+    imgui_json::value trace;
+    trace["displayTimeUnit"] = "ms";
+    trace["traceEvents"] = std::move(events);
+    return trace.save(path, -1);
+}
+
+static const ImGuiTableSortSpecs* ProfilerSortSpecs = NULL;
+static int IMGUI_CDECL ProfilerCompareStats(const void* lhs, const void* rhs)
+{
+    const ImGuiProfilerStat* a = (const ImGuiProfilerStat*)lhs;
+    const ImGuiProfilerStat* b = (const ImGuiProfilerStat*)rhs;
+    for (int n = 0; n < ProfilerSortSpecs->SpecsCount; n++)
+    {
+        const ImGuiTableColumnSortSpecs* spec = &ProfilerSortSpecs->Specs[n];
+        int delta = 0;
+        switch (spec->ColumnIndex)
+        {
+        case 0: delta = strcmp(a->Name, b->Name); break;
+        case 1: delta = strcmp(a->Label ? a->Label : "", b->Label ? b->Label : ""); break;
+        case 2: delta = a->Calls - b->Calls; break;
+        case 3: delta = a->Total < b->Total ? -1 : a->Total > b->Total ? 1 : 0; break;
+        case 4: delta = a->Self < b->Self ? -1 : a->Self > b->Self ? 1 : 0; break;
+        }
+        if (delta != 0)
+            return spec->SortDirection == ImGuiSortDirection_Ascending ? delta : -delta;
+    }
+    return 0;
+}
+
+void ImGui::DebugNodeProfiler()
+{
+    ImGuiProfiler& profiler = ProfilerGet();
+    Checkbox("Pause", &profiler.Paused);
+    SameLine();
+    if (Button("Save trace"))
+        ProfilerSaveTrace("imgui_trace.json");
+    SameLine();
+    Text("%d frames captured, %d events dropped", profiler.FramesCount, (int)profiler.Dropped);
+    if (profiler.FramesCount == 0)
+        return;
+    SetNextItemWidth(GetFontSize() * 12);
+    SliderInt("Frame", &profiler.ViewFrame, 0, profiler.FramesCount - 1, profiler.ViewFrame == 0 ? "Latest" : "Latest - %d");
+    SameLine();
+    SetNextItemWidth(GetFontSize() * 12);
+    SliderFloat("Zoom", &profiler.ViewZoom, 1.0f, 100.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+    profiler.ViewFrame = ImClamp(profiler.ViewFrame, 0, profiler.FramesCount - 1);
+    const ImGuiProfilerFrame* frame = ProfilerGetFrame(profiler.ViewFrame);
+    const double frame_ms = (frame->End - frame->Start) / 1000000.0;
+    Text("Frame: %.3f ms, %d scopes", frame_ms, frame->Records.Size);
+
+    // Per thread depth, only threads with events get a lane
+    ImVector<int> thread_depth;
+    {
+        std::lock_guard<std::mutex> lock(profiler.Mutex);
+        thread_depth.resize(profiler.Threads.Size, -1);
+    }
+    for (const ImGuiProfilerRecord& record : frame->Records)
+        if (record.Thread < thread_depth.Size)
+            thread_depth[record.Thread] = ImMax(thread_depth[record.Thread], (int)record.Depth);
+
+    // Timeline
+    const float row_height = GetTextLineHeightWithSpacing();
+    float timeline_height = 0.0f;
+    for (int depth : thread_depth)
+        if (depth >= 0)
+            timeline_height += row_height * (depth + 2);
+    if (BeginChild("##timeline", ImVec2(0.0f, ImMin(timeline_height, row_height * 20.0f) + GetStyle().ScrollbarSize + GetStyle().WindowPadding.y * 2), ImGuiChildFlags_Border, ImGuiWindowFlags_HorizontalScrollbar))
+    {
+        ImDrawList* draw_list = GetWindowDrawList();
+        const float width = GetContentRegionAvail().x * profiler.ViewZoom;
+        const ImVec2 origin = GetCursorScreenPos();
+        const double scale = width / (double)(frame->End - frame->Start);
+        const ImVec2 clip_min = GetWindowPos();
+        const ImVec2 clip_max = clip_min + GetWindowSize();
+        ImVector<float> lane_y;
+        lane_y.resize(thread_depth.Size, 0.0f);
+        float y = 0.0f;
+        for (int n = 0; n < thread_depth.Size; n++)
+        {
+            if (thread_depth[n] < 0)
+                continue;
+            char name[32];
+            {
+                std::lock_guard<std::mutex> lock(profiler.Mutex);
+                ImStrncpy(name, profiler.Threads[n]->Name, IM_ARRAYSIZE(name));
+            }
+            draw_list->AddText(ImVec2(ImMax(origin.x, clip_min.x), origin.y + y), GetColorU32(ImGuiCol_TextDisabled), name);
+            lane_y[n] = y + row_height;
+            y += row_height * (thread_depth[n] + 2);
+        }
+        for (const ImGuiProfilerRecord& record : frame->Records)
+        {
+            float x0 = origin.x + (float)((record.Start - frame->Start) * scale);
+            float x1 = origin.x + (float)((record.End - frame->Start) * scale);
+            x0 = ImMax(x0, origin.x);
+            x1 = ImMax(x1, x0 + 1.0f);
+            if (x1 < clip_min.x || x0 > clip_max.x)
+                continue;
+            float y0 = origin.y + lane_y[record.Thread] + record.Depth * row_height;
+            if (y0 > clip_max.y || y0 + row_height < clip_min.y)
+                continue;
+            ImVec2 p_min(x0, y0), p_max(x1, y0 + row_height - 1.0f);
+            float hue = (ImHashStr(record.Name) & 0xFFFF) / 65535.0f;
+            draw_list->AddRectFilled(p_min, p_max, ImColor::HSV(hue, 0.5f, 0.7f));
+            const char* label = record.Label >= 0 ? frame->Labels.Data + record.Label : NULL;
+            if (x1 - x0 > GetFontSize())
+            {
+                ImVec4 text_clip(ImMax(x0, clip_min.x), y0, ImMin(x1, clip_max.x), y0 + row_height);
+                draw_list->AddText(NULL, 0.0f, ImVec2(x0 + 2.0f, y0), IM_COL32_WHITE, label ? label : record.Name, NULL, 0.0f, &text_clip);
+            }
+            if (IsMouseHoveringRect(p_min, p_max) && IsWindowHovered())
+            {
+                BeginTooltip();
+                Text("%s%s%s", record.Name, label ? ": " : "", label ? label : "");
+                Text("%.3f ms, at %.3f ms", (record.End - record.Start) / 1000000.0, (record.Start - frame->Start) / 1000000.0);
+                EndTooltip();
+            }
+        }
+        Dummy(ImVec2(width, timeline_height));
+    }
+    EndChild();
+
+    // Aggregates: records are stored in scope end order, so children come before their parent on each thread
+    ImVector<ImGuiProfilerStat> stats;
+    ImGuiStorage stats_index;
+    double children[IMGUI_PROFILER_MAX_DEPTH + 1];
+    int thread = -1;
+    for (const ImGuiProfilerRecord& record : frame->Records)
+    {
+        if (record.Thread != thread)
+        {
+            thread = record.Thread;
+            memset(children, 0, sizeof(children));
+        }
+        const char* label = record.Label >= 0 ? frame->Labels.Data + record.Label : NULL;
+        ImGuiID id = ImHashData(&record.Name, sizeof(record.Name), label ? ImHashStr(label) : 0);
+        int index = stats_index.GetInt(id, -1);
+        if (index < 0)
+        {
+            index = stats.Size;
+            stats_index.SetInt(id, index);
+            ImGuiProfilerStat stat = { record.Name, label, 0, 0.0, 0.0 };
+            stats.push_back(stat);
+        }
+        double duration = (record.End - record.Start) / 1000000.0;
+        ImGuiProfilerStat& stat = stats[index];
+        stat.Calls++;
+        stat.Total += duration;
+        stat.Self += duration - children[record.Depth + 1];
+        children[record.Depth + 1] = 0.0;
+        children[record.Depth] += duration;
+    }
+    const ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit;
+    if (BeginTable("##stats", 5, flags, ImVec2(0.0f, row_height * 16)))
+    {
+        TableSetupScrollFreeze(0, 1);
+        TableSetupColumn("Scope");
+        TableSetupColumn("Label", ImGuiTableColumnFlags_WidthStretch);
+        TableSetupColumn("Calls", ImGuiTableColumnFlags_PreferSortDescending);
+        TableSetupColumn("Total ms", ImGuiTableColumnFlags_PreferSortDescending);
+        TableSetupColumn("Self ms", ImGuiTableColumnFlags_PreferSortDescending | ImGuiTableColumnFlags_DefaultSort);
+        TableHeadersRow();
+        if (ImGuiTableSortSpecs* sort_specs = TableGetSortSpecs())
+            if (sort_specs->SpecsCount > 0)
+            {
+                ProfilerSortSpecs = sort_specs;
+                ImQsort(stats.Data, (size_t)stats.Size, sizeof(stats[0]), ProfilerCompareStats);
+                ProfilerSortSpecs = NULL;
+            }
+        ImGuiListClipper clipper;
+        clipper.Begin(stats.Size);
+        while (clipper.Step())
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+            {
+                const ImGuiProfilerStat& stat = stats[n];
+                TableNextRow();
+                TableNextColumn(); TextUnformatted(stat.Name);
+                TableNextColumn(); TextUnformatted(stat.Label ? stat.Label : "");
+                TableNextColumn(); Text("%d", stat.Calls);
+                TableNextColumn(); Text("%.3f", stat.Total);
+                TableNextColumn(); Text("%.3f", stat.Self);
+            }
+        EndTable();
+    }
+}
+#endif // IMGUI_PROFILER
 // Add By Dicky end
 
 // Win32 API IME support (for Asian languages, etc.)
@@ -21267,6 +22379,14 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         TreePop();
     }
 
+#if IMGUI_PROFILER
+    if (TreeNode("Profiler"))
+    {
+        DebugNodeProfiler();
+        TreePop();
+    }
+#endif
+
     // Settings
     if (TreeNode("Memory allocations"))
     {
@@ -21432,6 +22552,13 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         Text("NavWindowingTarget: '%s'", g.NavWindowingTarget ? g.NavWindowingTarget->Name : "NULL");
         Unindent();
 
+        // add by Dicky
+        Text("TEXT LAYOUT CACHE");
+        Indent();
+        Text("Enabled: %d, Layouts: %d, Hits/Misses last frame: %d/%d", g.IO.ConfigTextLayoutCache, g.TextLayoutCache.Layouts.GetAliveCount(), g.TextLayoutCache.LastFrameHits, g.TextLayoutCache.LastFrameMisses);
+        Unindent();
+        // add by Dicky end
+
         TreePop();
     }
 
@@ -21897,6 +23024,8 @@ void ImGui::DebugNodeFontGlyph(ImFont*, const ImFontGlyph* glyph)
     Text("Codepoint: U+%04X", glyph->Codepoint);
     Separator();
     Text("Visible: %d", glyph->Visible);
+    if (glyph->Dynamic) // add by Dicky
+        Text("Dynamic: %s", glyph->Page ? "cached" : "not rasterized");
     Text("AdvanceX: %.1f", glyph->AdvanceX);
     Text("Pos: (%.2f,%.2f)->(%.2f,%.2f)", glyph->X0, glyph->Y0, glyph->X1, glyph->Y1);
     Text("UV: (%.3f,%.3f)->(%.3f,%.3f)", glyph->U0, glyph->V0, glyph->U1, glyph->V1);
@@ -21905,8 +23034,13 @@ void ImGui::DebugNodeFontGlyph(ImFont*, const ImFontGlyph* glyph)
 // [DEBUG] Display contents of ImGuiStorage
 void ImGui::DebugNodeStorage(ImGuiStorage* storage, const char* label)
 {
+#if IMGUI_STORAGE_HASHED
+    if (!TreeNode(label, "%s: %d entries, %d bytes, %d bytes index", label, storage->Data.Size, storage->Data.size_in_bytes(), storage->_Index.size_in_bytes())) // add by Dicky
+        return;
+#else
     if (!TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, storage->Data.size_in_bytes()))
         return;
+#endif
     for (const ImGuiStoragePair& p : storage->Data)
     {
         BulletText("Key 0x%08X Value { i: %d }", p.key, p.val_i); // Important: we currently don't store a type, real value may not be integer.
@@ -165,11 +165,13 @@ struct ImDrawCmd;                   // A single draw command within a parent ImD
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
+struct ImDrawTextEffect;            // Outline, shadow and glow for ImDrawList::AddTextEffect() // add by Dicky
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
+struct ImFontAtlasDynamic;          // Opaque dynamic glyph cache of an ImFontAtlas (ImFontAtlasFlags_DynamicGlyphs) // add by Dicky
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
@@ -1183,7 +1185,8 @@ namespace ImGui
     // Text Utilities
     IMGUI_API ImVec2        CalcTextSize(const char* text, const char* text_end = NULL, bool hide_text_after_double_hash = false, float wrap_width = -1.0f);
     // add by Dicky to find internationalize text
-    IMGUI_API size_t        InternationalizedText(const char* text_begin, const char* text_end);
+    IMGUI_API size_t        InternationalizedText(const char* text_begin, const char* text_end);                                  // copy localized text into the context buffer, return its size or 0 when there is none
+    IMGUI_API const char*   FindInternationalizedText(const char* text_begin, const char* text_end, const char** out_text_end);    // return localized text without copy, NULL when there is none. valid until next call
     // add by Dicky end
 
     // Color Utilities
@@ -1435,6 +1438,9 @@ enum ImGuiInputTextFlags_
     ImGuiInputTextFlags_CallbackCharFilter  = 1 << 20,  // Callback on character inputs to replace or discard them. Modify 'EventChar' to replace or discard, or return 1 in callback to discard.
     ImGuiInputTextFlags_CallbackResize      = 1 << 21,  // Callback on buffer capacity changes request (beyond 'buf_size' parameter value), allowing the string to grow. Notify when the string wants to be resized (for string types which hold a cache of their Size). You will be provided a new BufSize in the callback and NEED to honor it. (see misc/cpp/imgui_stdlib.h for an example of using this)
     ImGuiInputTextFlags_CallbackEdit        = 1 << 22,  // Callback on any edit (note that InputText() already returns true on edit, the callback is useful mainly to manipulate the underlying buffer while focus is active)
+    // add by Dicky
+    ImGuiInputTextFlags_LargeText           = 1 << 23,  // InputTextMultiline() only: edit the UTF-8 text in place in a gap buffer indexed by lines, and only lay out the visible lines. For texts of several MB: editing and display skip the ImWchar conversion and the layout of the whole text, while a length-changing edit still copies the text after it back to 'buf' and the inactive widget scans 'buf' for its lines each frame (memcpy/memchr speed). Password, AlwaysOverwrite, CallbackCompletion and CallbackAlways are not supported, CallbackEdit reports each edit without allowing to modify the buffer (see ImGuiInputTextCallbackData::EditOffset)
+    // add by Dicky end
 
     // Obsolete names
     //ImGuiInputTextFlags_AlwaysInsertMode  = ImGuiInputTextFlags_AlwaysOverwrite   // [renamed in 1.82] name was not matching behavior
@@ -1915,6 +1921,8 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasTextSDF    = 1 << 4,   // Backend Renderer decodes the UVs of signed distance field glyphs (ImFontConfig::SDF), see ImDrawList::AddTextEffect(). Only imgui_impl_opengl3 sets it. // add by Dicky
+    ImGuiBackendFlags_RendererHasDynamicGlyphs = 1 << 5, // Backend Renderer uploads ImFontAtlas::GetTexDataDirtyRows() before rendering, required by ImFontAtlasFlags_DynamicGlyphs. // add by Dicky
 
     // [BETA] Viewports
     ImGuiBackendFlags_PlatformHasViewports  = 1 << 10,  // Backend Platform supports multiple viewports.
@@ -2777,6 +2785,8 @@ struct ImGuiIO
     int         MaxDelayFrameCount;                 // How many frames show if tiggle power saving mode, default is 2
     double      MaxFrameRate;                       // User custom maximum reflash rate 
     double      MinFrameRate;                       // User custom minimum reflash rate
+    bool        ConfigSkipUnchangedFrames;          // = false  // Hash each viewport draw data in Render() and set ImDrawData::Unchanged when nothing changed since last frame. Texture contents are not hashed, declare them with MarkAnimatedRegion().
+    bool        ConfigTextLayoutCache;              // = false  // Cache the size and the wrapped lines of texts submitted again in later frames (labels, log lines, table cells), CalcTextSize() then skips measuring and wrapped text skips word wrapping and hidden lines.
     ImVector<char> PreEditCharacters;               // IME PreEdit input characters, for MacOS it need show preEdit characters by user
     // Add By Dicky end
 
@@ -2827,6 +2837,14 @@ struct ImGuiInputTextCallbackData
     int                 CursorPos;      //                                      // Read-write   // [Completion,History,Always]
     int                 SelectionStart; //                                      // Read-write   // [Completion,History,Always] == to SelectionEnd when no selection)
     int                 SelectionEnd;   //                                      // Read-write   // [Completion,History,Always]
+    // add by Dicky
+    // - With ImGuiInputTextFlags_LargeText the Edit callback only reports the edits: it is called once per edit, in order, after all the edits of the frame were copied to Buf.
+    //   'EditDeletedLen' bytes at 'EditOffset' were replaced by the 'EditInsertedLen' bytes at 'EditInsertedText'. Changes to Buf are ignored.
+    int                 EditOffset;     // Byte offset of the edit              // Read-only    // [Edit + LargeText]
+    int                 EditDeletedLen; // Bytes removed at EditOffset          // Read-only    // [Edit + LargeText]
+    const char*         EditInsertedText; // Bytes inserted at EditOffset       // Read-only    // [Edit + LargeText] Not zero-terminated
+    int                 EditInsertedLen; //                                     // Read-only    // [Edit + LargeText]
+    // add by Dicky end
 
     // Helper functions for text manipulation.
     // Use those function to benefit from the CallbackResize behaviors. Calling those function reset the selection.
@@ -2914,14 +2932,35 @@ struct ImGuiOnceUponAFrame
 };
 
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
+// add by Dicky
+// - Build() compiles the terms: "-term" excludes, others are substrings. Opt in with Flags (call Build() after changing them):
+//   ImGuiTextFilterFlags_Glob makes a term with '*' or '?' a glob, ImGuiTextFilterFlags_Regex makes "/expr/" a regular expression.
+//   All terms are case insensitive (ASCII) and match anywhere in the text.
+// - Filter() applies the filter to a whole list on worker threads and keeps the indices of the passing items until the filter or the
+//   items change. Display them with ImGuiListClipper: clipper.Begin(indices.Size), then items[indices[n]].
+// add by Dicky end
 struct ImGuiTextFilter
 {
-    IMGUI_API           ImGuiTextFilter(const char* default_filter = "");
+    IMGUI_API           ImGuiTextFilter(const char* default_filter = "", int flags = 0); // modify by Dicky
+    // add by Dicky
+    IMGUI_API           ImGuiTextFilter(const ImGuiTextFilter& src);
+    IMGUI_API           ~ImGuiTextFilter();
+    IMGUI_API ImGuiTextFilter& operator=(const ImGuiTextFilter& src);
+    // add by Dicky end
     IMGUI_API bool      Draw(const char* label = "Filter (inc,-exc)", float width = 0.0f);  // Helper calling InputText+Build
     IMGUI_API bool      PassFilter(const char* text, const char* text_end = NULL) const;
     IMGUI_API void      Build();
     void                Clear()          { InputBuf[0] = 0; Build(); }
     bool                IsActive() const { return !Filters.empty(); }
+    // add by Dicky
+    // Store the indices of the items passing the filter in out_indices, returns true when they were recomputed. The result is kept while
+    // the filter, items_count, items_version, the getter, user_data and out_indices stay the same: bump items_version when items change.
+    // When only items_count grows, the new items and the previous last one (e.g. a log line being completed) are filtered alone.
+    // items_getter is called from the worker threads, it may leave out_text_end to NULL for zero-terminated text.
+    IMGUI_API bool      Filter(int items_count, const char* (*items_getter)(void* user_data, int idx, const char** out_text_end), void* user_data, ImVector<int>* out_indices, ImU64 items_version = 0);
+    IMGUI_API bool      Filter(const char* const items[], int items_count, ImVector<int>* out_indices, ImU64 items_version = 0);
+    void                ClearFilterCache()  { CacheOutIndices = NULL; }
+    // add by Dicky end
 
     // [Internal]
     struct ImGuiTextRange
@@ -2937,6 +2976,35 @@ struct ImGuiTextFilter
     char                    InputBuf[256];
     ImVector<ImGuiTextRange>Filters;
     int                     CountGrep;
+    // add by Dicky
+    enum ImGuiTextFilterFlags_
+    {
+        ImGuiTextFilterFlags_None   = 0,
+        ImGuiTextFilterFlags_Glob   = 1 << 0,   // A term with '*' (any characters) or '?' (one character) is a glob
+        ImGuiTextFilterFlags_Regex  = 1 << 1,   // A term written "/expr/" is a regular expression, searched as text when invalid
+    };
+    enum ImGuiTextTermType { ImGuiTextTermType_Substring, ImGuiTextTermType_Glob, ImGuiTextTermType_Regex };
+    struct ImGuiTextTerm
+    {
+        ImGuiTextTermType   Type;
+        bool                Exclude;
+        int                 NeedleOffset;       // Lower case needle in Needles, zero-terminated
+        int                 NeedleLen;
+        void*               Regex;              // std::regex for ImGuiTextTermType_Regex
+    };
+    int                     Flags;              // ImGuiTextFilterFlags_, none by default: every term is a substring
+    ImVector<ImGuiTextTerm> Terms;              // Compiled Filters, empty ones skipped
+    ImVector<char>          Needles;
+    int                     FilterThreads;      // Threads used by Filter(), 0 for one per hardware thread, 1 to filter on the calling thread only.
+    int                     BuildCount;         // Incremented by Build(), invalidates the Filter() result
+    int                     CacheBuildCount;
+    int                     CacheItemsCount;
+    ImU64                   CacheItemsVersion;
+    const char*           (*CacheItemsGetter)(void* user_data, int idx, const char** out_text_end);
+    void*                   CacheUserData;
+    ImVector<int>*          CacheOutIndices;
+    ImVector<ImU8>          CachePass;          // Per item result of the last Filter(), written by the worker threads
+    // add by Dicky end
 };
 
 // Helper: Growable text buffer for logging/accumulating text
@@ -2970,6 +3038,17 @@ struct ImGuiStoragePair
     ImGuiStoragePair(ImGuiID _key, void* _val)  { key = _key; val_p = _val; }
 };
 
+// add by Dicky
+#if IMGUI_STORAGE_HASHED
+// [Internal] Hash index slot for ImGuiStorage, index into ImGuiStorage::Data, -1 for an empty slot
+struct ImGuiStorageSlot
+{
+    ImGuiID     key;
+    int         index;
+};
+#endif
+// add by Dicky end
+
 // Helper: Key->Value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
@@ -2982,11 +3061,24 @@ struct ImGuiStorage
 {
     // [Internal]
     ImVector<ImGuiStoragePair>      Data;
+    // add by Dicky
+#if IMGUI_STORAGE_HASHED
+    // With IMGUI_STORAGE_HASHED, Data is kept in insertion order: small storages are scanned, bigger ones get an open addressing
+    // index (Robin Hood probing) making lookup and insertion O(1). Code writing Data directly may append or reorder pairs, they
+    // are indexed on next access. Anything else (removing or replacing pairs) must be followed by Clear() or BuildSortByKey().
+    mutable ImVector<ImGuiStorageSlot> _Index;
+    mutable int                     _IndexedSize = 0;   // Number of pairs of Data present in _Index
+#endif
+    // add by Dicky end
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+#if IMGUI_STORAGE_HASHED
+    void                Clear() { Data.clear(); _Index.clear(); _IndexedSize = 0; } // add by Dicky
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -3428,8 +3520,25 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AllowTextSDF            = 1 << 4,  // Can emit signed distance field glyph UVs. Set when 'ImGuiBackendFlags_RendererHasTextSDF' is enabled. // add by Dicky
 };
 
+// add by Dicky
+// Text effects for ImDrawList::AddTextEffect(), sizes are in pixels and limited by ImFontAtlas::TexSDFSpread.
+// Layers are drawn glow, shadow, outline then text. A layer is skipped when its color is transparent.
+struct ImDrawTextEffect
+{
+    float           OutlineWidth;       // 0.0f     // Outline around the glyphs
+    ImU32           OutlineColor;
+    ImVec2          ShadowOffset;       // 0, 0     // Shadow of the outlined text
+    ImU32           ShadowColor;
+    float           GlowWidth;          // 0.0f     // Soft halo fading out around the glyphs, SDF only
+    ImU32           GlowColor;
+
+    ImDrawTextEffect() { memset(this, 0, sizeof(*this)); }
+};
+// add by Dicky end
+
 // Draw command list
 // This is the low-level list of polygons that ImGui:: functions are filling. At the end of the frame,
 // all command lists are passed to your ImGuiIO::RenderDrawListFn function for rendering.
@@ -3506,6 +3615,9 @@ struct ImDrawList
     IMGUI_API void  AddConcavePolyFilled(const ImVec2* points, int num_points, ImU32 col);
 
     // add by Dicky for Complex Text
+    // AddTextEffect() draws each effect as one more quad per glyph when the font has SDF glyphs (ImFontConfig::SDF) and the renderer
+    // sets ImGuiBackendFlags_RendererHasTextSDF, otherwise it falls back to offset copies of the text (no glow).
+    IMGUI_API void AddTextEffect(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const ImDrawTextEffect& effect, const char* text_begin, const char* text_end = NULL);
     IMGUI_API void AddTextComplex(const ImVec2 pos, const char * str, float font_size, ImU32 text_color, float outline_w = 0.f, ImU32 outline_color = 0, ImVec2 shadow_offset = ImVec2(0, 0), ImU32 shadow_color = 0);
     IMGUI_API void AddTextComplex(const char * str, float font_size, ImU32 text_color, float outline_w = 0.f, ImU32 outline_color = 0, ImVec2 shadow_offset = ImVec2(0, 0), ImU32 shadow_color = 0);
     // add by Dicky End
@@ -3595,6 +3707,7 @@ struct ImDrawData
     ImVec2              DisplaySize;        // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
     ImVec2              FramebufferScale;   // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
     ImGuiViewport*      OwnerViewport;      // Viewport carrying the ImDrawData instance, might be of use to the renderer (generally not).
+    bool                Unchanged;          // Add by Dicky: same content as the previous frame of this viewport, the renderer may skip draw and swap. Only set with io.ConfigSkipUnchangedFrames.
 
     // Functions
     ImDrawData()    { Clear(); }
@@ -3628,6 +3741,7 @@ struct ImFontConfig
     float           RasterizerMultiply;     // 1.0f     // Linearly brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable. This is a silly thing we may remove in the future.
     float           RasterizerDensity;      // 1.0f     // DPI scale for rasterization, not altering other font metrics: make it easy to swap between e.g. a 100% and a 400% fonts for a zooming display. IMPORTANT: If you increase this it is expected that you increase font scale accordingly, otherwise quality may look lowered.
     ImWchar         EllipsisChar;           // -1       // Explicitly specify unicode codepoint of ellipsis character. When fonts are being merged first specified ellipsis will be used.
+    bool            SDF;                    // false    // Bake signed distance field glyphs, scaling without blur and drawing outline/shadow/glow in one quad each with ImDrawList::AddTextEffect(). Needs a renderer setting ImGuiBackendFlags_RendererHasTextSDF (asserted by NewFrame()). Forces OversampleH/V to 1, never rasterized on demand with ImFontAtlasFlags_DynamicGlyphs. // add by Dicky
 
     // [Internal]
     char            Name[40];               // Name (strictly to ease debugging)
@@ -3642,7 +3756,12 @@ struct ImFontGlyph
 {
     unsigned int    Colored : 1;        // Flag to indicate glyph is colored and should generally ignore tinting (make it usable with no shift on little-endian as this is used in loops)
     unsigned int    Visible : 1;        // Flag to indicate glyph has no visible pixels (e.g. space). Allow early out when rendering.
-    unsigned int    Codepoint : 30;     // 0x0000..0x10FFFF
+    // modify by Dicky for dynamic glyphs
+    unsigned int    Codepoint : 21;     // 0x0000..0x10FFFF
+    unsigned int    Dynamic : 1;        // Rasterized on demand by FindGlyph() (ImFontAtlasFlags_DynamicGlyphs), AdvanceX is always valid
+    unsigned int    Page : 7;           // Dynamic glyph cache page holding the pixels, 0 when not rasterized yet or evicted
+    unsigned int    SDF : 1;            // Signed distance field pixels (ImFontConfig::SDF), the quad includes ImFontAtlas::TexSDFSpread texels around the glyph
+    // modify by Dicky end
     float           AdvanceX;           // Distance to next character (= data from font + ImFontConfig::GlyphExtraSpacing.x baked in)
     float           X0, Y0, X1, Y1;     // Glyph corners
     float           U0, V0, U1, V1;     // Texture coordinates
@@ -3684,6 +3803,10 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    // add by Dicky
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 3,   // Only bake Latin-1 at Build(), rasterize other glyphs the first time they are drawn into pages of the texture, evicting the least recently used pages beyond TexDynamicPixels.
+                                                    // The backend uploads GetTexDataDirtyRows() before rendering. Font input and texture data are needed while rendering, don't call ClearInputData()/ClearTexData().
+    // add by Dicky end
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3732,6 +3855,9 @@ struct ImFontAtlas
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
     bool                        IsBuilt() const             { return Fonts.Size > 0 && TexReady; } // Bit ambiguous: used to detect when user didn't build texture but effectively we should check TexID != 0 except that would be backend dependent...
     void                        SetTexID(ImTextureID id)    { TexID = id; }
+    // add by Dicky for dynamic glyphs
+    IMGUI_API bool              GetTexDataDirtyRows(int* out_y, int* out_h);    // Rows of the texture data updated by ImFontAtlasFlags_DynamicGlyphs since the last call, false when nothing changed
+    // add by Dicky end
 
     //-------------------------------------------
     // Glyph Ranges
@@ -3784,10 +3910,15 @@ struct ImFontAtlas
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+    int                         TexDynamicPixels;   // Texture area in pixels of the dynamic glyph pages with ImFontAtlasFlags_DynamicGlyphs. Defaults to 1024*1024. // add by Dicky
+    int                         BuildThreads;       // Threads rasterizing glyphs in Build(), 0 for one per hardware thread, 1 to rasterize on the calling thread only. // add by Dicky
+    int                         TexSDFSpread;       // Distance in texels encoded around ImFontConfig::SDF glyphs, the widest outline/glow at the baked size. Defaults to 8. // add by Dicky
+    const char*                 CacheDir;           // Directory of the atlas cache (e.g. ImGuiHelper::cache_path()). Build() loads the atlas from it instead of rasterizing when the fonts and settings match a previous build. NULL to disable. // add by Dicky
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     bool                        TexReady;           // Set when texture was built matching current font input
+    int                         TexBuildId;         // Unique id of the last build, text layouts cached with io.ConfigTextLayoutCache are rebuilt when it changes // add by Dicky
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
@@ -3808,6 +3939,11 @@ struct ImFontAtlas
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
 
+    // [Internal] Dynamic glyph cache // add by Dicky
+    ImFontAtlasDynamic*         DynamicData;        // Pages and rasterizer state, NULL unless built with ImFontAtlasFlags_DynamicGlyphs
+    int                         TexDirtyMinY;       // Rows [TexDirtyMinY, TexDirtyMaxY) of the texture data changed since GetTexDataDirtyRows()
+    int                         TexDirtyMaxY;
+
     // [Obsolete]
     //typedef ImFontAtlasCustomRect    CustomRect;         // OBSOLETED in 1.72+
     //typedef ImFontGlyphRangesBuilder GlyphRangesBuilder; // OBSOLETED in 1.67+
@@ -3868,7 +4004,7 @@ struct ImFont
     IMGUI_API bool              IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last);
 
     // add By Dicky
-    IMGUI_API void              RenderTextEx(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false, float spacing = 1.0) const;
+    IMGUI_API void              RenderTextEx(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false, float spacing = 1.0, const ImVec2& sdf_uv = ImVec2(0.0f, 0.0f)) const; // sdf_uv: added to the UVs of SDF glyphs, see ImDrawList::AddTextEffect()
     // Modiaddfy By Dicky end
 };
 
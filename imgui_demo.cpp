@@ -8737,10 +8737,13 @@ struct ExampleAppLog
     ImGuiTextFilter     Filter;
     ImVector<int>       LineOffsets; // Index to lines offset. We maintain this with AddLog() calls.
     bool                AutoScroll;  // Keep scrolling if already at the bottom.
+    ImVector<int>       FilteredLines; // Lines passing Filter, kept by ImGuiTextFilter::Filter() until the filter or the log change. // add by Dicky
+    int                 ClearCount;    // Version of the lines given to ImGuiTextFilter::Filter(), appended lines don't change it. // add by Dicky
 
     ExampleAppLog()
     {
         AutoScroll = true;
+        ClearCount = 0; // add by Dicky
         Clear();
     }
 
@@ -8749,8 +8752,19 @@ struct ExampleAppLog
         Buf.clear();
         LineOffsets.clear();
         LineOffsets.push_back(0);
+        ClearCount++; // add by Dicky
     }
 
+    // add by Dicky
+    static const char* GetLine(void* user_data, int line_no, const char** out_line_end)
+    {
+        const ExampleAppLog* log = (const ExampleAppLog*)user_data;
+        const char* buf = log->Buf.begin();
+        *out_line_end = (line_no + 1 < log->LineOffsets.Size) ? (buf + log->LineOffsets[line_no + 1] - 1) : log->Buf.end();
+        return buf + log->LineOffsets[line_no];
+    }
+    // add by Dicky end
+
     void    AddLog(const char* fmt, ...) IM_FMTARGS(2)
     {
         int old_size = Buf.size();
@@ -8802,17 +8816,23 @@ struct ExampleAppLog
             const char* buf_end = Buf.end();
             if (Filter.IsActive())
             {
-                // In this example we don't use the clipper when Filter is enabled.
-                // This is because we don't have random access to the result of our filter.
-                // A real application processing logs with ten of thousands of entries may want to store the result of
-                // search/filter.. especially if the filtering function is not trivial (e.g. reg-exp).
-                for (int line_no = 0; line_no < LineOffsets.Size; line_no++)
+                // modify by Dicky
+                // ImGuiTextFilter::Filter() stores the lines passing the filter, on worker threads, and only filters them again when
+                // the filter changes or lines are added. With random access to the result we can use the clipper.
+                Filter.Filter(LineOffsets.Size, GetLine, this, &FilteredLines, (ImU64)ClearCount);
+                ImGuiListClipper clipper;
+                clipper.Begin(FilteredLines.Size);
+                while (clipper.Step())
                 {
-                    const char* line_start = buf + LineOffsets[line_no];
-                    const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
-                    if (Filter.PassFilter(line_start, line_end))
+                    for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+                    {
+                        const char* line_end = NULL;
+                        const char* line_start = GetLine(this, FilteredLines[n], &line_end);
                         ImGui::TextUnformatted(line_start, line_end);
+                    }
                 }
+                clipper.End();
+                // modify by Dicky end
             }
             else
             {
@@ -8826,9 +8846,8 @@ struct ExampleAppLog
                 // - A) random access into your data
                 // - B) items all being the  same height,
                 // both of which we can handle since we have an array pointing to the beginning of each line of text.
-                // When using the filter (in the block of code above) we don't have random access into the data to display
-                // anymore, which is why we don't use the clipper. Storing or skimming through the search result would make
-                // it possible (and would be recommended if you want to search through tens of thousands of entries).
+                // When using the filter (in the block of code above) we use the clipper on the indices of the lines stored
+                // by ImGuiTextFilter::Filter(). // modify by Dicky
                 ImGuiListClipper clipper;
                 clipper.Begin(LineOffsets.Size);
                 while (clipper.Step())
@@ -39,6 +39,8 @@ Index of this file:
 #endif
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
+#include <atomic>       // add by Dicky for the parallel font atlas build
+#include <thread>       // add by Dicky for the parallel font atlas build
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -130,8 +132,10 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// modify by Dicky, glyphs are rasterized by the build threads
+#define STBTT_malloc(x,u)   ((void)(u), ImFontAtlasBuildThreadAlloc(x))
+#define STBTT_free(x,u)     ((void)(u), ImFontAtlasBuildThreadFree(x))
+// modify by Dicky end
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -788,6 +792,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 {
     if (points_count < 2 || (col & IM_COL32_A_MASK) == 0)
         return;
+    IMGUI_PROFILE_SCOPE("AddPolyline");
 
     const bool closed = (flags & ImDrawFlags_Closed) != 0;
     const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
@@ -1046,6 +1051,7 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
 {
     if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
         return;
+    IMGUI_PROFILE_SCOPE("AddConvexPolyFilled");
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
 
@@ -1685,6 +1691,32 @@ void ImDrawList::AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const Im
     PathStroke(col, 0, thickness);
 }
 
+// add by Dicky for multi-language support
+static void ImDrawListLocalizeText(const char** text_begin, const char** text_end)
+{
+    ImGuiContext& g = *GImGui;
+    if (!g.Style.TextInternationalize)
+        return;
+    const char* localized_end = NULL;
+    const char* localized = ImGui::FindInternationalizedText(*text_begin, *text_end, &localized_end);
+    if (localized)
+    {
+        *text_begin = localized;
+        *text_end = localized_end;
+    }
+}
+// add by Dicky end
+
+// add by Dicky for SDF glyphs
+static bool ImFontHasSDF(const ImFont* font)
+{
+    for (int n = 0; n < font->ConfigDataCount; n++)
+        if (font->ConfigData[n].SDF)
+            return true;
+    return false;
+}
+// add by Dicky end
+
 void ImDrawList::AddText(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end, float wrap_width, const ImVec4* cpu_fine_clip_rect)
 {
     if ((col & IM_COL32_A_MASK) == 0)
@@ -1699,16 +1731,7 @@ void ImDrawList::AddText(const ImFont* font, float font_size, const ImVec2& pos,
     // add by Dicky for multi-language support
     const char * _text_begin = text_begin;
     const char * _text_end = text_end;
-    ImGuiContext& g = *GImGui;
-    if (g.Style.TextInternationalize)
-    {
-        auto changed = ImGui::InternationalizedText(_text_begin, _text_end);
-        if (changed > 0)
-        {
-            _text_begin = g.InternationalizedBuffer;
-            _text_end = _text_begin + changed;
-        }
-    }
+    ImDrawListLocalizeText(&_text_begin, &_text_end);
     // add by Dicky end
 
     // Pull default font/size from the shared ImDrawListSharedData instance
@@ -1738,28 +1761,74 @@ void ImDrawList::AddText(const ImVec2& pos, ImU32 col, const char* text_begin, c
 }
 
 // add by Dicky
-void ImDrawList::AddTextComplex(const ImVec2 pos, const char * str, float font_size, ImU32 text_color, float outline_w, ImU32 outline_color, ImVec2 shadow_offset, ImU32 shadow_color)
+void ImDrawList::AddTextEffect(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const ImDrawTextEffect& effect, const char* text_begin, const char* text_end)
 {
-    ImGui::SetWindowFontScale(font_size);
-    ImGui::PushStyleVar(ImGuiStyleVar_TexGlyphShadowOffset, shadow_offset);
-    ImGui::PushStyleColor(ImGuiCol_TexGlyphShadow, ImGui::ColorConvertU32ToFloat4(shadow_color));
-    if (outline_w > 0)
-    {
-        AddText(ImVec2(pos.x - outline_w, pos.y), outline_color, str);
-        AddText(ImVec2(pos.x, pos.y - outline_w), outline_color, str);
-        AddText(ImVec2(pos.x + outline_w, pos.y), outline_color, str);
-        AddText(ImVec2(pos.x, pos.y + outline_w), outline_color, str);
-        if (outline_w >= 4)
+    if (text_end == NULL)
+        text_end = text_begin + strlen(text_begin);
+    if (text_begin == text_end || text_begin[0] == 0)
+        return;
+    ImDrawListLocalizeText(&text_begin, &text_end);
+
+    if (font == NULL)
+        font = _Data->Font;
+    if (font_size == 0.0f)
+        font_size = _Data->FontSize;
+    IM_ASSERT(font->ContainerAtlas->TexID == _CmdHeader.TextureId);  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
+
+    const ImVec4 clip_rect = _CmdHeader.ClipRect;
+    const float spacing = GImGui->Style.TextSpacing;
+    const bool has_outline = effect.OutlineWidth > 0.0f && (effect.OutlineColor & IM_COL32_A_MASK) != 0;
+    const bool has_shadow = (effect.ShadowOffset.x != 0.0f || effect.ShadowOffset.y != 0.0f) && (effect.ShadowColor & IM_COL32_A_MASK) != 0;
+    const bool has_glow = effect.GlowWidth > 0.0f && (effect.GlowColor & IM_COL32_A_MASK) != 0;
+
+    if ((Flags & ImDrawListFlags_AllowTextSDF) && ImFontHasSDF(font))
+    {
+        // One quad per glyph and per layer, the renderer thresholds the distance field with the parameters encoded in the UVs
+        const float density = font->ConfigData ? font->ConfigData->RasterizerDensity : 1.0f;
+        const float steps_per_pixel = density * font->FontSize / font_size * IM_DRAWLIST_TEXT_SDF_STEPS / font->ContainerAtlas->TexSDFSpread;
+        const int outline = has_outline ? ImClamp((int)(effect.OutlineWidth * steps_per_pixel + 0.5f), 0, IM_DRAWLIST_TEXT_SDF_DILATION_MAX) : 0;
+        if (has_glow)
         {
-            AddText(ImVec2(pos.x - outline_w, pos.y - outline_w), outline_color, str);
-            AddText(ImVec2(pos.x + outline_w, pos.y - outline_w), outline_color, str);
-            AddText(ImVec2(pos.x + outline_w, pos.y - outline_w), outline_color, str);
-            AddText(ImVec2(pos.x - outline_w, pos.y + outline_w), outline_color, str);
+            // Half of the width grows the shape, the other half fades out
+            const int glow = ImMax((int)(effect.GlowWidth * 0.5f * steps_per_pixel + 0.5f), 1);
+            const int dilation = ImMin(outline + glow, IM_DRAWLIST_TEXT_SDF_DILATION_MAX);
+            const int softness = ImMin(glow, IM_DRAWLIST_TEXT_SDF_STEPS - 1 - dilation);
+            font->RenderTextEx(this, font_size, pos, effect.GlowColor, clip_rect, text_begin, text_end, 0.0f, false, spacing, IM_DRAWLIST_TEXT_SDF_UV(dilation, softness));
         }
+        if (has_shadow)
+            font->RenderTextEx(this, font_size, pos + effect.ShadowOffset, effect.ShadowColor, clip_rect, text_begin, text_end, 0.0f, false, spacing, IM_DRAWLIST_TEXT_SDF_UV(outline, 0));
+        if (has_outline)
+            font->RenderTextEx(this, font_size, pos, effect.OutlineColor, clip_rect, text_begin, text_end, 0.0f, false, spacing, IM_DRAWLIST_TEXT_SDF_UV(outline, 0));
+        if ((col & IM_COL32_A_MASK) != 0)
+            font->RenderTextEx(this, font_size, pos, col, clip_rect, text_begin, text_end, 0.0f, false, spacing, IM_DRAWLIST_TEXT_SDF_UV(0, 0));
+        return;
+    }
+
+    // Bitmap glyphs: the outline is made of offset copies of the text, no glow
+    if (has_shadow)
+        font->RenderTextEx(this, font_size, pos + effect.ShadowOffset, effect.ShadowColor, clip_rect, text_begin, text_end, 0.0f, false, spacing);
+    if (has_outline)
+    {
+        const float w = effect.OutlineWidth;
+        static const ImVec2 directions[8] = { ImVec2(-1, 0), ImVec2(0, -1), ImVec2(1, 0), ImVec2(0, 1), ImVec2(-1, -1), ImVec2(1, -1), ImVec2(1, 1), ImVec2(-1, 1) };
+        const int directions_count = (w >= 4.0f) ? 8 : 4;
+        for (int n = 0; n < directions_count; n++)
+            font->RenderTextEx(this, font_size, pos + directions[n] * w, effect.OutlineColor, clip_rect, text_begin, text_end, 0.0f, false, spacing);
     }
-    AddText(pos, text_color, str);
-    ImGui::PopStyleColor();
-    ImGui::PopStyleVar();
+    if ((col & IM_COL32_A_MASK) != 0)
+        font->RenderTextEx(this, font_size, pos, col, clip_rect, text_begin, text_end, 0.0f, false, spacing);
+}
+
+void ImDrawList::AddTextComplex(const ImVec2 pos, const char * str, float font_size, ImU32 text_color, float outline_w, ImU32 outline_color, ImVec2 shadow_offset, ImU32 shadow_color)
+{
+    // font_size is a scale of the window font
+    ImGui::SetWindowFontScale(font_size);
+    ImDrawTextEffect effect;
+    effect.OutlineWidth = outline_w;
+    effect.OutlineColor = outline_color;
+    effect.ShadowOffset = shadow_offset;
+    effect.ShadowColor = shadow_color;
+    AddTextEffect(NULL, 0.0f, pos, text_color, effect, str);
     ImGui::SetWindowFontScale(1.0);
 }
 
@@ -2299,6 +2368,7 @@ void ImDrawData::Clear()
     CmdLists.resize(0); // The ImDrawList are NOT owned by ImDrawData but e.g. by ImGuiContext, so we don't clear them.
     DisplayPos = DisplaySize = FramebufferScale = ImVec2(0.0f, 0.0f);
     OwnerViewport = NULL;
+    Unchanged = false;
 }
 
 // Important: 'out_list' is generally going to be draw_data->CmdLists, but may be another temporary list
@@ -2562,6 +2632,8 @@ ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    TexDynamicPixels = 1024 * 1024; // add by Dicky
+    TexSDFSpread = 8; // add by Dicky
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2574,6 +2646,7 @@ ImFontAtlas::~ImFontAtlas()
 void    ImFontAtlas::ClearInputData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasBuildDynamicShutdown(this); // add by Dicky, the glyph cache rasterizes from the font data
     for (ImFontConfig& font_cfg : ConfigData)
         if (font_cfg.FontData && font_cfg.FontDataOwnedByAtlas)
         {
@@ -2597,6 +2670,7 @@ void    ImFontAtlas::ClearInputData()
 void    ImFontAtlas::ClearTexData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasBuildDynamicShutdown(this); // add by Dicky
     if (TexPixelsAlpha8)
         IM_FREE(TexPixelsAlpha8);
     if (TexPixelsRGBA32)
@@ -2610,6 +2684,7 @@ void    ImFontAtlas::ClearTexData()
 void    ImFontAtlas::ClearFonts()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasBuildDynamicShutdown(this); // add by Dicky
     Fonts.clear_delete();
     TexReady = false;
 }
@@ -2657,6 +2732,18 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
     if (out_bytes_per_pixel) *out_bytes_per_pixel = 4;
 }
 
+// add by Dicky for dynamic glyphs
+bool    ImFontAtlas::GetTexDataDirtyRows(int* out_y, int* out_h)
+{
+    if (TexDirtyMinY >= TexDirtyMaxY)
+        return false;
+    *out_y = TexDirtyMinY;
+    *out_h = TexDirtyMaxY - TexDirtyMinY;
+    TexDirtyMinY = TexDirtyMaxY = 0;
+    return true;
+}
+// add by Dicky end
+
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
@@ -2673,6 +2760,8 @@ ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
     ImFontConfig& new_font_cfg = ConfigData.back();
     if (new_font_cfg.DstFont == NULL)
         new_font_cfg.DstFont = Fonts.back();
+    if (new_font_cfg.SDF) // add by Dicky, the distance field already positions the edges between texels
+        new_font_cfg.OversampleH = new_font_cfg.OversampleV = 1;
     if (!new_font_cfg.FontDataOwnedByAtlas)
     {
         new_font_cfg.FontData = IM_ALLOC(new_font_cfg.FontDataSize);
@@ -2794,6 +2883,7 @@ ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template, float
     ascii_config.PixelSnapH     = true;
     ascii_config.SizePixels     = ascii_font_size * 1.0f;
     ascii_config.EllipsisChar   = (ImWchar)'.'; //(ImWchar)0x0085;
+    ascii_config.SDF            = font_cfg.SDF; // add by Dicky, the merged Latin glyphs are baked like the font they are merged into
     //ascii_config.GlyphOffset.y  = -1.0f * IM_TRUNC(ascii_config.SizePixels / ascii_font_size);  // Add -1 offset per 14 units
 #if IMGUI_FONT_NO_UTF8
     ascii_config.MergeMode      = false;
@@ -2987,10 +3077,378 @@ bool    ImFontAtlas::Build()
 #endif
     }
 
+    // add by Dicky for the atlas cache, the dynamic glyph cache needs the builder so it is always built
+    const bool use_cache = CacheDir != NULL && (Flags & ImFontAtlasFlags_DynamicGlyphs) == 0;
+    if (use_cache && ImFontAtlasBuildLoadCache(this, builder_io))
+        return true;
+    // add by Dicky end
+
     // Build
-    return builder_io->FontBuilder_Build(this);
+    // modify by Dicky for the atlas cache
+    if (!builder_io->FontBuilder_Build(this))
+        return false;
+    if (use_cache)
+        ImFontAtlasBuildSaveCache(this, builder_io);
+    return true;
+    // modify by Dicky end
+}
+
+// add by Dicky for parallel build and atlas cache
+void* ImFontAtlasBuildThreadAlloc(size_t size)
+{
+    // ImGui::MemAlloc() updates the allocation statistics of the current context, which isn't thread-safe
+    ImGuiMemAllocFunc alloc_func;
+    ImGuiMemFreeFunc free_func;
+    void* user_data;
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data);
+    return alloc_func(size, user_data);
+}
+
+void ImFontAtlasBuildThreadFree(void* ptr)
+{
+    ImGuiMemAllocFunc alloc_func;
+    ImGuiMemFreeFunc free_func;
+    void* user_data;
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &user_data);
+    free_func(ptr, user_data);
+}
+
+int ImFontAtlasBuildGetThreadsCount(ImFontAtlas* atlas)
+{
+    return ImMax((atlas->BuildThreads > 0) ? atlas->BuildThreads : (int)std::thread::hardware_concurrency(), 1);
+}
+
+void ImFontAtlasBuildParallelFor(ImFontAtlas* atlas, int count, void (*func)(void* user_data, int index), void* user_data)
+{
+    if (count <= 0)
+        return;
+    const int threads_count = ImMin(ImFontAtlasBuildGetThreadsCount(atlas), count);
+
+    // Items are handed out one at a time, the builders make them big enough (a run of glyphs) to hide the atomic
+    std::atomic<int> next_index(0);
+    auto worker = [&]()
+    {
+        for (int index = next_index++; index < count; index = next_index++)
+            func(user_data, index);
+    };
+    ImVector<std::thread*> threads;
+    for (int thread_n = 1; thread_n < threads_count; thread_n++)
+        threads.push_back(IM_NEW(std::thread)(worker));
+    worker();
+    for (std::thread* thread : threads)
+    {
+        thread->join();
+        IM_DELETE(thread);
+    }
+}
+
+// 64-bit MurmurHash2 (MurmurHash64A), used for the font data hashed by the atlas cache on every launch and the text layout cache
+static ImU64 ImHashData64(const void* data, size_t size, ImU64 seed)
+{
+    const ImU64 m = 0xC6A4A7935BD1E995ull;
+    const int r = 47;
+    ImU64 h = seed ^ (size * m);
+    const unsigned char* p = (const unsigned char*)data;
+    for (const unsigned char* p_end = p + (size & ~(size_t)7); p < p_end; p += 8)
+    {
+        ImU64 k;
+        memcpy(&k, p, 8);
+        k *= m; k ^= k >> r; k *= m;
+        h ^= k; h *= m;
+    }
+    if (size & 7)
+    {
+        ImU64 k = 0;
+        memcpy(&k, p, size & 7);
+        h ^= k; h *= m;
+    }
+    h ^= h >> r; h *= m; h ^= h >> r;
+    return h;
+}
+
+// Unique over all atlases, a layout made with a destroyed atlas can't match a new one allocated at the same address
+static int ImFontAtlasBuildNextId()
+{
+    static std::atomic<int> last_id(0);
+    return ++last_id;
 }
 
+// The atlas cache stores the output of a build: texture pixels, custom rectangle positions and glyph tables. The file name
+// is a hash of everything the output depends on (font data contents, sizes, ranges, oversampling, flags...) so a changed
+// font or setting simply misses and writes a new file. The file is only valid for the machine and build that wrote it.
+#ifndef IMGUI_DISABLE_FILE_FUNCTIONS
+
+#define IMGUI_FONT_ATLAS_CACHE_VERSION  2
+
+struct ImFontAtlasCacheHeader
+{
+    char                Magic[4];           // "IMFA"
+    int                 Version;            // IMGUI_FONT_ATLAS_CACHE_VERSION, written last so an interrupted write is never loaded
+    ImU64               Key;
+    int                 TexWidth;
+    int                 TexHeight;
+    int                 TexBytesPerPixel;   // 1: TexPixelsAlpha8, 4: TexPixelsRGBA32
+    int                 TexPixelsUseColors;
+    int                 CustomRectsCount;
+    int                 FontsCount;
+    int                 GlyphsCount;        // Sum over all fonts
+    ImVec2              TexUvWhitePixel;
+    ImVec4              TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+};
+
+struct ImFontAtlasCacheFont
+{
+    float               FontSize;
+    float               Ascent;
+    float               Descent;
+    int                 MetricsTotalSurface;
+    int                 GlyphsCount;
+};
+
+static int ImFontAtlasCacheBuilderId(const ImFontBuilderIO* builder_io)
+{
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    if (builder_io == ImFontAtlasGetBuilderForStbTruetype())
+        return 1;
+#endif
+#if IMGUI_ENABLE_FREETYPE
+    if (builder_io == ImGuiFreeType::GetBuilderForFreeType())
+        return 2;
+#endif
+    return 0; // Custom builders aren't cached, their output may depend on anything
+}
+
+template<typename T>
+static void ImFontAtlasCacheKeyAdd(ImVector<unsigned char>& key_data, const T& value)
+{
+    const int offset = key_data.Size;
+    key_data.resize(offset + (int)sizeof(T));
+    memcpy(key_data.Data + offset, &value, sizeof(T));
+}
+
+static ImU64 ImFontAtlasCacheKey(ImFontAtlas* atlas, int builder_id)
+{
+    // Fields are added one by one, struct padding would make the key random
+    ImVector<unsigned char> key_data;
+    ImFontAtlasCacheKeyAdd(key_data, IMGUI_FONT_ATLAS_CACHE_VERSION);
+    ImFontAtlasCacheKeyAdd(key_data, IMGUI_VERSION_NUM);
+    ImFontAtlasCacheKeyAdd(key_data, (int)sizeof(ImWchar));
+    ImFontAtlasCacheKeyAdd(key_data, (int)sizeof(ImFontGlyph));
+    ImFontAtlasCacheKeyAdd(key_data, builder_id);
+    ImFontAtlasCacheKeyAdd(key_data, atlas->Flags);
+    ImFontAtlasCacheKeyAdd(key_data, atlas->TexDesiredWidth);
+    ImFontAtlasCacheKeyAdd(key_data, atlas->TexGlyphPadding);
+    ImFontAtlasCacheKeyAdd(key_data, atlas->TexSDFSpread);
+    ImFontAtlasCacheKeyAdd(key_data, atlas->FontBuilderFlags);
+    ImFontAtlasCacheKeyAdd(key_data, atlas->Fonts.Size);
+    for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        ImFontAtlasCacheKeyAdd(key_data, r.Width);
+        ImFontAtlasCacheKeyAdd(key_data, r.Height);
+        ImFontAtlasCacheKeyAdd(key_data, r.GlyphID);
+        ImFontAtlasCacheKeyAdd(key_data, r.GlyphAdvanceX);
+        ImFontAtlasCacheKeyAdd(key_data, r.GlyphOffset);
+        ImFontAtlasCacheKeyAdd(key_data, r.Font ? atlas->Fonts.index_from_ptr(atlas->Fonts.find(r.Font)) : -1);
+    }
+    for (const ImFontConfig& cfg : atlas->ConfigData)
+    {
+        ImFontAtlasCacheKeyAdd(key_data, ImHashData64(cfg.FontData, (size_t)cfg.FontDataSize, 0));
+        ImFontAtlasCacheKeyAdd(key_data, cfg.FontDataSize);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.FontNo);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.SizePixels);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.OversampleH);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.OversampleV);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.PixelSnapH);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.GlyphExtraSpacing);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.GlyphOffset);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.GlyphMinAdvanceX);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.GlyphMaxAdvanceX);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.MergeMode);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.FontBuilderFlags);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.RasterizerMultiply);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.RasterizerDensity);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.EllipsisChar);
+        ImFontAtlasCacheKeyAdd(key_data, cfg.SDF);
+        ImFontAtlasCacheKeyAdd(key_data, atlas->Fonts.index_from_ptr(atlas->Fonts.find(cfg.DstFont)));
+        const ImWchar* ranges = cfg.GlyphRanges ? cfg.GlyphRanges : atlas->GetGlyphRangesDefault();
+        for (; ranges[0] && ranges[1]; ranges += 2)
+        {
+            ImFontAtlasCacheKeyAdd(key_data, ranges[0]);
+            ImFontAtlasCacheKeyAdd(key_data, ranges[1]);
+        }
+        ImFontAtlasCacheKeyAdd(key_data, (ImWchar)0);
+    }
+    return ImHashData64(key_data.Data, (size_t)key_data.Size, 0);
+}
+
+static void ImFontAtlasCachePath(ImFontAtlas* atlas, ImU64 key, char* buf, int buf_size)
+{
+    const size_t dir_len = strlen(atlas->CacheDir);
+    const char* sep = (dir_len > 0 && atlas->CacheDir[dir_len - 1] != '/' && atlas->CacheDir[dir_len - 1] != '\\') ? "/" : "";
+    ImFormatString(buf, (size_t)buf_size, "%s%simgui_font_atlas_%08X%08X.bin", atlas->CacheDir, sep, (unsigned int)(key >> 32), (unsigned int)key);
+}
+
+bool ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const ImFontBuilderIO* builder_io)
+{
+    const int builder_id = ImFontAtlasCacheBuilderId(builder_io);
+    if (builder_id == 0 || atlas->CacheDir == NULL || atlas->ConfigData.Size == 0)
+        return false;
+    ImFontAtlasBuildInit(atlas); // Rounds the sizes and registers the default rectangles, as the builders do first
+    const ImU64 key = ImFontAtlasCacheKey(atlas, builder_id);
+    char path[1024];
+    ImFontAtlasCachePath(atlas, key, path, IM_ARRAYSIZE(path));
+    ImFileHandle f = ImFileOpen(path, "rb");
+    if (f == NULL)
+        return false;
+
+    // Everything is checked and read before touching the atlas, a bad file leaves it untouched for the builder
+    ImFontAtlasCacheHeader header;
+    bool ok = ImFileRead(&header, sizeof(header), 1, f) == 1;
+    ok = ok && memcmp(header.Magic, "IMFA", 4) == 0 && header.Version == IMGUI_FONT_ATLAS_CACHE_VERSION && header.Key == key;
+    ok = ok && header.CustomRectsCount == atlas->CustomRects.Size && header.FontsCount == atlas->Fonts.Size;
+    ok = ok && (header.TexBytesPerPixel == 1 || header.TexBytesPerPixel == 4) && header.TexWidth > 0 && header.TexHeight > 0 && header.GlyphsCount >= 0;
+    const size_t tex_size = ok ? (size_t)header.TexWidth * header.TexHeight * header.TexBytesPerPixel : 0;
+    ok = ok && ImFileGetSize(f) == sizeof(header) + sizeof(ImU16) * 2 * header.CustomRectsCount + sizeof(ImFontAtlasCacheFont) * header.FontsCount + sizeof(ImFontGlyph) * header.GlyphsCount + tex_size;
+    ImVector<ImU16> rects_pos;
+    ImVector<ImFontAtlasCacheFont> fonts;
+    ImVector<ImFontGlyph> glyphs;
+    if (ok)
+    {
+        rects_pos.resize(header.CustomRectsCount * 2);
+        fonts.resize(header.FontsCount);
+        glyphs.resize(header.GlyphsCount);
+        ok = (rects_pos.Size == 0 || ImFileRead(rects_pos.Data, (ImU64)rects_pos.size_in_bytes(), 1, f) == 1) && ImFileRead(fonts.Data, (ImU64)fonts.size_in_bytes(), 1, f) == 1;
+        ok = ok && (glyphs.Size == 0 || ImFileRead(glyphs.Data, (ImU64)glyphs.size_in_bytes(), 1, f) == 1);
+    }
+    int glyphs_total = 0;
+    for (int font_i = 0; ok && font_i < fonts.Size; font_i++)
+    {
+        ok = fonts[font_i].GlyphsCount > 0 && glyphs_total + fonts[font_i].GlyphsCount <= glyphs.Size;
+        glyphs_total += fonts[font_i].GlyphsCount;
+    }
+    void* pixels = ok ? IM_ALLOC(tex_size) : NULL;
+    ok = ok && ImFileRead(pixels, (ImU64)tex_size, 1, f) == 1;
+    ImFileClose(f);
+    if (!ok)
+    {
+        if (pixels)
+            IM_FREE(pixels);
+        return false;
+    }
+
+    atlas->TexID = (ImTextureID)NULL;
+    atlas->ClearTexData();
+    atlas->TexWidth = header.TexWidth;
+    atlas->TexHeight = header.TexHeight;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    atlas->TexUvWhitePixel = header.TexUvWhitePixel;
+    memcpy(atlas->TexUvLines, header.TexUvLines, sizeof(atlas->TexUvLines));
+    atlas->TexPixelsUseColors = header.TexPixelsUseColors != 0;
+    if (header.TexBytesPerPixel == 1)
+        atlas->TexPixelsAlpha8 = (unsigned char*)pixels;
+    else
+        atlas->TexPixelsRGBA32 = (unsigned int*)pixels;
+    for (int rect_i = 0; rect_i < atlas->CustomRects.Size; rect_i++)
+    {
+        atlas->CustomRects[rect_i].X = rects_pos[rect_i * 2];
+        atlas->CustomRects[rect_i].Y = rects_pos[rect_i * 2 + 1];
+    }
+    const ImFontGlyph* font_glyphs = glyphs.Data;
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+    {
+        ImFont* font = atlas->Fonts[font_i];
+        const ImFontAtlasCacheFont& cache_font = fonts[font_i];
+        font->ClearOutputData();
+        font->ContainerAtlas = atlas;
+        font->FontSize = cache_font.FontSize;
+        font->Ascent = cache_font.Ascent;
+        font->Descent = cache_font.Descent;
+        font->MetricsTotalSurface = cache_font.MetricsTotalSurface;
+        font->Glyphs.resize(cache_font.GlyphsCount);
+        memcpy(font->Glyphs.Data, font_glyphs, (size_t)font->Glyphs.size_in_bytes());
+        font_glyphs += cache_font.GlyphsCount;
+        font->BuildLookupTable();
+    }
+    atlas->TexReady = true;
+    atlas->TexBuildId = ImFontAtlasBuildNextId();
+    return true;
+}
+
+bool ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const ImFontBuilderIO* builder_io)
+{
+    const int builder_id = ImFontAtlasCacheBuilderId(builder_io);
+    if (builder_id == 0 || atlas->CacheDir == NULL || atlas->DynamicData != NULL || !atlas->TexReady)
+        return false;
+    for (ImFont* font : atlas->Fonts)
+        if (font->Glyphs.Size == 0)
+            return false;
+    const ImU64 key = ImFontAtlasCacheKey(atlas, builder_id);
+    char path[1024];
+    ImFontAtlasCachePath(atlas, key, path, IM_ARRAYSIZE(path));
+    ImFileHandle f = ImFileOpen(path, "wb");
+    if (f == NULL)
+        return false;
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, "IMFA", 4);
+    header.Key = key;
+    header.TexWidth = atlas->TexWidth;
+    header.TexHeight = atlas->TexHeight;
+    header.TexBytesPerPixel = atlas->TexPixelsAlpha8 ? 1 : 4;
+    header.TexPixelsUseColors = atlas->TexPixelsUseColors ? 1 : 0;
+    header.CustomRectsCount = atlas->CustomRects.Size;
+    header.FontsCount = atlas->Fonts.Size;
+    header.TexUvWhitePixel = atlas->TexUvWhitePixel;
+    memcpy(header.TexUvLines, atlas->TexUvLines, sizeof(header.TexUvLines));
+    ImVector<ImU16> rects_pos;
+    for (const ImFontAtlasCustomRect& r : atlas->CustomRects)
+    {
+        rects_pos.push_back(r.X);
+        rects_pos.push_back(r.Y);
+    }
+    ImVector<ImFontAtlasCacheFont> fonts;
+    for (ImFont* font : atlas->Fonts)
+    {
+        ImFontAtlasCacheFont cache_font;
+        memset(&cache_font, 0, sizeof(cache_font));
+        cache_font.FontSize = font->FontSize;
+        cache_font.Ascent = font->Ascent;
+        cache_font.Descent = font->Descent;
+        cache_font.MetricsTotalSurface = font->MetricsTotalSurface;
+        cache_font.GlyphsCount = font->Glyphs.Size;
+        fonts.push_back(cache_font);
+        header.GlyphsCount += font->Glyphs.Size;
+    }
+
+    // Header is written with a zero version first, then rewritten once the rest made it to the file
+#ifdef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
+    header.Version = IMGUI_FONT_ATLAS_CACHE_VERSION; // No seek on user file handles
+#endif
+    const void* pixels = atlas->TexPixelsAlpha8 ? (const void*)atlas->TexPixelsAlpha8 : (const void*)atlas->TexPixelsRGBA32;
+    bool ok = ImFileWrite(&header, sizeof(header), 1, f) == 1;
+    ok = ok && (rects_pos.Size == 0 || ImFileWrite(rects_pos.Data, (ImU64)rects_pos.size_in_bytes(), 1, f) == 1);
+    ok = ok && ImFileWrite(fonts.Data, (ImU64)fonts.size_in_bytes(), 1, f) == 1;
+    for (ImFont* font : atlas->Fonts)
+        ok = ok && ImFileWrite(font->Glyphs.Data, (ImU64)font->Glyphs.size_in_bytes(), 1, f) == 1;
+    ok = ok && ImFileWrite(pixels, (ImU64)atlas->TexWidth * atlas->TexHeight * header.TexBytesPerPixel, 1, f) == 1;
+#ifndef IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS
+    ok = ok && fflush(f) == 0 && fseek(f, 0, SEEK_SET) == 0;
+    header.Version = IMGUI_FONT_ATLAS_CACHE_VERSION;
+    ok = ok && ImFileWrite(&header, sizeof(header), 1, f) == 1;
+#endif
+    ok = ImFileClose(f) && ok;
+    return ok;
+}
+
+#else
+
+bool ImFontAtlasBuildLoadCache(ImFontAtlas*, const ImFontBuilderIO*) { return false; }
+bool ImFontAtlasBuildSaveCache(ImFontAtlas*, const ImFontBuilderIO*) { return false; }
+
+#endif // #ifndef IMGUI_DISABLE_FILE_FUNCTIONS
+// add by Dicky end
+
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
 {
     for (unsigned int i = 0; i < 256; i++)
@@ -3009,6 +3467,88 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             *data = table[*data];
 }
 
+// add by Dicky for SDF glyphs
+// 1D squared distance transform of a row or column (Felzenszwalb & Huttenlocher), f/v/z are scratch buffers of length+1
+static void ImFontAtlasBuildDistanceTransform1D(float* grid, int offset, int stride, int length, float* f, int* v, float* z)
+{
+    const float inf = 1e20f;
+    v[0] = 0;
+    z[0] = -inf;
+    z[1] = inf;
+    f[0] = grid[offset];
+    for (int q = 1, k = 0; q < length; q++)
+    {
+        f[q] = grid[offset + q * stride];
+        const float q2 = (float)(q * q);
+        float s;
+        do
+        {
+            const int r = v[k];
+            s = (f[q] - f[r] + q2 - (float)(r * r)) / (float)(q - r) * 0.5f;
+        } while (s <= z[k] && --k > -1);
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = inf;
+    }
+    for (int q = 0, k = 0; q < length; q++)
+    {
+        while (z[k + 1] < (float)q)
+            k++;
+        const float qr = (float)(q - v[k]);
+        grid[offset + q * stride] = f[v[k]] + qr * qr;
+    }
+}
+
+static void ImFontAtlasBuildDistanceTransform2D(float* grid, int w, int h, float* f, int* v, float* z)
+{
+    for (int x = 0; x < w; x++)
+        ImFontAtlasBuildDistanceTransform1D(grid, x, w, h, f, v, z);
+    for (int y = 0; y < h; y++)
+        ImFontAtlasBuildDistanceTransform1D(grid, y * w, 1, w, f, v, z);
+}
+
+// Replace the coverage of a rectangle by the distance to the glyph edge, stored as 0.5 - distance / (2 * spread) (0.5 on the edge, 0 at 'spread' texels outside).
+// Partially covered texels give the edge a sub-texel position. The rectangle must include 'spread' texels of margin around the glyph.
+void    ImFontAtlasBuildRenderSDF(unsigned char* pixels, int stride, int w, int h, int spread)
+{
+    if (w <= 0 || h <= 0 || spread <= 0)
+        return;
+    const float inf = 1e20f;
+    const int n = ImMax(w, h) + 1;
+    float* outer = (float*)ImFontAtlasBuildThreadAlloc(sizeof(float) * (size_t)(w * h * 2 + n * 2) + sizeof(int) * (size_t)n);
+    float* inner = outer + w * h;
+    float* f = inner + w * h;
+    float* z = f + n;
+    int* v = (int*)(z + n);
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+        {
+            const float a = pixels[x + y * stride] / 255.0f;
+            const int i = x + y * w;
+            if (a >= 1.0f)      { outer[i] = 0.0f; inner[i] = inf; }
+            else if (a <= 0.0f) { outer[i] = inf; inner[i] = 0.0f; }
+            else
+            {
+                const float d = 0.5f - a;
+                outer[i] = d > 0.0f ? d * d : 0.0f;
+                inner[i] = d < 0.0f ? d * d : 0.0f;
+            }
+        }
+    ImFontAtlasBuildDistanceTransform2D(outer, w, h, f, v, z);
+    ImFontAtlasBuildDistanceTransform2D(inner, w, h, f, v, z);
+    const float scale = 255.0f / (2.0f * spread);
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+        {
+            const int i = x + y * w;
+            const float d = ImSqrt(outer[i]) - ImSqrt(inner[i]);
+            pixels[x + y * stride] = (unsigned char)ImClamp(127.5f - d * scale + 0.5f, 0.0f, 255.0f);
+        }
+    ImFontAtlasBuildThreadFree(outer);
+}
+// add by Dicky end
+
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 // Temporary data for one source font (multiple source fonts can be merged into one destination ImFont)
 // (C++03 doesn't allow instancing ImVector<> with function-local types so we declare the type here.)
@@ -3024,6 +3564,7 @@ struct ImFontBuildSrcData
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<int>       GlyphsList;         // Glyph codepoints list (flattened version of GlyphsSet)
+    ImVector<int>       DynamicList;        // Glyph codepoints rasterized on demand (ImFontAtlasFlags_DynamicGlyphs) // add by Dicky
 };
 
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
@@ -3047,6 +3588,129 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// add by Dicky for dynamic glyphs
+// Rasterizer state kept by the dynamic glyph cache, stbtt_fontinfo only points into ImFontConfig::FontData
+struct ImFontBuildDynamicDataStb
+{
+    ImFontAtlas*            Atlas;
+    ImVector<stbtt_fontinfo> FontInfos;         // Per source font
+    ImVector<unsigned char> Bitmap;             // Last rasterized glyph
+};
+
+// Same rasterization as stbtt_PackFontRangesRenderIntoRects() and same quad as stbtt_GetPackedQuad(), for one glyph
+static bool ImFontAtlasRasterizeGlyphWithStbTruetype(void* builder_data, int src_index, ImWchar codepoint, ImFontAtlasGlyphBitmap* out_bitmap)
+{
+    ImFontBuildDynamicDataStb* data = (ImFontBuildDynamicDataStb*)builder_data;
+    const ImFontConfig& cfg = data->Atlas->ConfigData[src_index];
+    const stbtt_fontinfo* font_info = &data->FontInfos[src_index];
+    const int glyph_index_in_font = stbtt_FindGlyphIndex(font_info, codepoint);
+    if (glyph_index_in_font == 0)
+        return false;
+
+    const float scale = (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels * cfg.RasterizerDensity);
+    const float inv_rasterization_scale = 1.0f / cfg.RasterizerDensity;
+    int advance = 0, left_side_bearing = 0;
+    stbtt_GetGlyphHMetrics(font_info, glyph_index_in_font, &advance, &left_side_bearing);
+    out_bitmap->AdvanceX = advance * scale * inv_rasterization_scale;
+
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    if (x0 == x1 || y0 == y1)
+        return true;
+    const int w = x1 - x0 + cfg.OversampleH - 1;
+    const int h = y1 - y0 + cfg.OversampleV - 1;
+    data->Bitmap.resize(w * h);
+    memset(data->Bitmap.Data, 0, (size_t)data->Bitmap.size_in_bytes());
+    float sub_x = 0.0f, sub_y = 0.0f;
+    stbtt_MakeGlyphBitmapSubpixelPrefilter(font_info, data->Bitmap.Data, w, h, w, scale * cfg.OversampleH, scale * cfg.OversampleV, 0.0f, 0.0f, cfg.OversampleH, cfg.OversampleV, &sub_x, &sub_y, glyph_index_in_font);
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, data->Bitmap.Data, 0, 0, w, h, w);
+    }
+
+    const float recip_h = 1.0f / cfg.OversampleH;
+    const float recip_v = 1.0f / cfg.OversampleV;
+    out_bitmap->Width = w;
+    out_bitmap->Height = h;
+    out_bitmap->Pitch = w;
+    out_bitmap->Alpha8 = data->Bitmap.Data;
+    out_bitmap->X0 = (x0 * recip_h + sub_x) * inv_rasterization_scale;
+    out_bitmap->Y0 = (y0 * recip_v + sub_y) * inv_rasterization_scale;
+    out_bitmap->X1 = ((x0 + w) * recip_h + sub_x) * inv_rasterization_scale;
+    out_bitmap->Y1 = ((y0 + h) * recip_v + sub_y) * inv_rasterization_scale;
+    return true;
+}
+
+static void ImFontAtlasDestroyDataStbTruetype(void* builder_data)
+{
+    IM_DELETE((ImFontBuildDynamicDataStb*)builder_data);
+}
+// add by Dicky end
+
+// add by Dicky for parallel build
+// A run of glyphs of one source font. Runs render into their own rectangles so they are rasterized in parallel,
+// with a copy of the pack context since stbtt_PackFontRangesRenderIntoRects() changes its oversampling.
+#define FONT_ATLAS_BUILD_RUN_GLYPHS 128
+
+struct ImFontBuildRunStb
+{
+    int                     SrcIndex;
+    int                     GlyphBegin;
+    int                     GlyphEnd;
+};
+
+struct ImFontBuildRasterizeStb
+{
+    ImFontAtlas*            Atlas;
+    const stbtt_pack_context* PackContext;
+    ImFontBuildSrcData*     SrcTmp;
+    const ImFontBuildRunStb* Runs;
+};
+
+static void ImFontAtlasBuildRasterizeRunStb(void* user_data, int run_i)
+{
+    const ImFontBuildRasterizeStb* build = (const ImFontBuildRasterizeStb*)user_data;
+    const ImFontBuildRunStb& run = build->Runs[run_i];
+    const ImFontConfig& cfg = build->Atlas->ConfigData[run.SrcIndex];
+    ImFontBuildSrcData& src_tmp = build->SrcTmp[run.SrcIndex];
+    stbtt_pack_context spc = *build->PackContext;
+    stbtt_pack_range range = src_tmp.PackRange;
+    range.array_of_unicode_codepoints += run.GlyphBegin;
+    range.chardata_for_range += run.GlyphBegin;
+    range.num_chars = run.GlyphEnd - run.GlyphBegin;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &range, 1, src_tmp.Rects + run.GlyphBegin);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        ImFontAtlas* atlas = build->Atlas;
+        for (int glyph_i = run.GlyphBegin; glyph_i < run.GlyphEnd; glyph_i++)
+        {
+            const stbrp_rect* r = &src_tmp.Rects[glyph_i];
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+        }
+    }
+
+    // Distance field over the glyph and the margin kept around it when packing
+    if (cfg.SDF)
+    {
+        ImFontAtlas* atlas = build->Atlas;
+        const int spread = atlas->TexSDFSpread;
+        for (int glyph_i = run.GlyphBegin; glyph_i < run.GlyphEnd; glyph_i++)
+        {
+            const stbrp_rect* r = &src_tmp.Rects[glyph_i];
+            if (r->was_packed && r->w > 0 && r->h > 0)
+                ImFontAtlasBuildRenderSDF(atlas->TexPixelsAlpha8 + (r->x - spread) + (r->y - spread) * atlas->TexWidth, atlas->TexWidth, r->w + spread * 2, r->h + spread * 2, spread);
+        }
+    }
+}
+// add by Dicky end
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -3126,6 +3790,15 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
                 if (!stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint))    // It is actually in the font?
                     continue;
 
+                // add by Dicky for dynamic glyphs
+                if (!ImFontAtlasBuildIsGlyphBaked(atlas, &atlas->ConfigData[src_i], (ImWchar)codepoint))
+                {
+                    dst_tmp.GlyphsSet.SetBit(codepoint);
+                    src_tmp.DynamicList.push_back((int)codepoint);
+                    continue;
+                }
+                // add by Dicky end
+
                 // Add to avail set/counters
                 src_tmp.GlyphsCount++;
                 dst_tmp.GlyphsCount++;
@@ -3193,6 +3866,11 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
             src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
             src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+            if (cfg.SDF && x1 > x0 && y1 > y0) // add by Dicky, margin for the distance field
+            {
+                src_tmp.Rects[glyph_i].w += (stbrp_coord)(atlas->TexSDFSpread * 2);
+                src_tmp.Rects[glyph_i].h += (stbrp_coord)(atlas->TexSDFSpread * 2);
+            }
             total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
         }
     }
@@ -3231,10 +3909,41 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
             if (src_tmp.Rects[glyph_i].was_packed)
                 atlas->TexHeight = ImMax(atlas->TexHeight, src_tmp.Rects[glyph_i].y + src_tmp.Rects[glyph_i].h);
+
+        // add by Dicky for SDF glyphs, stb_truetype rasterizes in the middle of the margin
+        if (atlas->ConfigData[src_i].SDF)
+        {
+            const int spread = atlas->TexSDFSpread;
+            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
+            {
+                stbrp_rect& r = src_tmp.Rects[glyph_i];
+                if (r.was_packed && r.w > atlas->TexGlyphPadding && r.h > atlas->TexGlyphPadding)
+                {
+                    r.x += (stbrp_coord)spread;
+                    r.y += (stbrp_coord)spread;
+                    r.w -= (stbrp_coord)(spread * 2);
+                    r.h -= (stbrp_coord)(spread * 2);
+                }
+            }
+        }
+        // add by Dicky end
     }
 
+    // add by Dicky for dynamic glyphs, keep the font info to rasterize on demand into pages below the baked glyphs
+    if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+    {
+        ImFontBuildDynamicDataStb* dynamic_data = IM_NEW(ImFontBuildDynamicDataStb)();
+        dynamic_data->Atlas = atlas;
+        dynamic_data->FontInfos.resize(src_tmp_array.Size);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+            dynamic_data->FontInfos[src_i] = src_tmp_array[src_i].FontInfo;
+        ImFontAtlasBuildDynamicInit(atlas, ImFontAtlasGetBuilderForStbTruetype(), dynamic_data);
+    }
+    // add by Dicky end
+
     // 7. Allocate texture
-    atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
+    if (atlas->DynamicData == NULL) // add by Dicky, the dynamic glyph cache already sized the texture
+        atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
     memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
@@ -3242,27 +3951,22 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // modify by Dicky for parallel build
+    ImVector<ImFontBuildRunStb> runs;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_i = 0; glyph_i < src_tmp_array[src_i].GlyphsCount; glyph_i += FONT_ATLAS_BUILD_RUN_GLYPHS)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRunStb run;
+            run.SrcIndex = src_i;
+            run.GlyphBegin = glyph_i;
+            run.GlyphEnd = ImMin(glyph_i + FONT_ATLAS_BUILD_RUN_GLYPHS, src_tmp_array[src_i].GlyphsCount);
+            runs.push_back(run);
         }
-        src_tmp.Rects = NULL;
-    }
+    ImFontBuildRasterizeStb build = { atlas, &spc, src_tmp_array.Data, runs.Data };
+    ImFontAtlasBuildParallelFor(atlas, runs.Size, ImFontAtlasBuildRasterizeRunStb, &build);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
+    // modify by Dicky end
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -3298,12 +4002,32 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             stbtt_aligned_quad q;
             float unused_x = 0.0f, unused_y = 0.0f;
             stbtt_GetPackedQuad(src_tmp.PackedChars, atlas->TexWidth, atlas->TexHeight, glyph_i, &unused_x, &unused_y, &q, 0);
+            if (cfg.SDF && pc.x1 > pc.x0 && pc.y1 > pc.y0) // add by Dicky, the quad covers the distance field margin
+            {
+                const float spread = (float)atlas->TexSDFSpread;
+                q.x0 -= spread; q.y0 -= spread; q.x1 += spread; q.y1 += spread;
+                q.s0 -= spread * atlas->TexUvScale.x; q.t0 -= spread * atlas->TexUvScale.y;
+                q.s1 += spread * atlas->TexUvScale.x; q.t1 += spread * atlas->TexUvScale.y;
+            }
             float x0 = q.x0 * inv_rasterization_scale + font_off_x;
             float y0 = q.y0 * inv_rasterization_scale + font_off_y;
             float x1 = q.x1 * inv_rasterization_scale + font_off_x;
             float y1 = q.y1 * inv_rasterization_scale + font_off_y;
             dst_font->AddGlyph(&cfg, (ImWchar)codepoint, x0, y0, x1, y1, q.s0, q.t0, q.s1, q.t1, pc.xadvance * inv_rasterization_scale);
         }
+
+        // add by Dicky for dynamic glyphs, only the advance is needed until they are drawn
+        if (src_tmp.DynamicList.Size > 0)
+        {
+            const float scale = (cfg.SizePixels > 0.0f) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels * cfg.RasterizerDensity) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels * cfg.RasterizerDensity);
+            for (int codepoint : src_tmp.DynamicList)
+            {
+                int advance = 0, left_side_bearing = 0;
+                stbtt_GetGlyphHMetrics(&src_tmp.FontInfo, stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint), &advance, &left_side_bearing);
+                ImFontAtlasBuildAddDynamicGlyph(atlas, dst_font, &cfg, (ImWchar)codepoint, advance * scale * inv_rasterization_scale);
+            }
+        }
+        // add by Dicky end
     }
 
     // Cleanup
@@ -3317,6 +4041,8 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
 {
     static ImFontBuilderIO io;
     io.FontBuilder_Build = ImFontAtlasBuildWithStbTruetype;
+    io.FontBuilder_RasterizeGlyph = ImFontAtlasRasterizeGlyphWithStbTruetype; // add by Dicky
+    io.FontBuilder_DestroyData = ImFontAtlasDestroyDataStbTruetype; // add by Dicky
     return &io;
 }
 
@@ -3546,8 +4272,277 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
             font->BuildLookupTable();
 
     atlas->TexReady = true;
+    atlas->TexBuildId = ImFontAtlasBuildNextId(); // add by Dicky
 }
 
+// add by Dicky for dynamic glyphs
+// With ImFontAtlasFlags_DynamicGlyphs the builders only bake Latin-1 (and the tab/fallback/ellipsis glyphs), the other glyphs
+// are registered with their advance so text layout is exact, and rasterized by FindGlyph() the first time they are drawn.
+// The texture holds the baked glyphs then full width pages, each with its own rectangle packer. stb_rectpack can't free
+// a single rectangle so the least recently used page is evicted as a whole, except pages used in the current frame
+// since their glyphs are already in the draw lists.
+struct ImFontAtlasDynamicGlyphRef
+{
+    ImFont*                 Font;
+    int                     GlyphIndex;
+};
+
+struct ImFontAtlasDynamicPage
+{
+    stbrp_context           Pack;
+    ImVector<stbrp_node>    PackNodes;
+    int                     Y;                  // First texture row of the page
+    int                     LastUsedFrame;
+    ImVector<ImFontAtlasDynamicGlyphRef> Glyphs; // Glyphs to reset when the page is evicted
+};
+
+struct ImFontAtlasDynamic
+{
+    const ImFontBuilderIO*  BuilderIO;
+    void*                   BuilderData;
+    ImVector<ImFontAtlasDynamicPage> Pages;
+    int                     PageHeight;
+    int                     Frame;
+    int                     FullFrame;          // Every page was used by this frame, glyphs fall back until the next one
+    int                     GlyphsLoaded;
+    int                     PagesEvicted;
+
+    ImFontAtlasDynamic()    { memset((void*)this, 0, sizeof(*this)); }
+};
+
+bool ImFontAtlasBuildIsGlyphBaked(ImFontAtlas* atlas, const ImFontConfig* font_config, ImWchar codepoint)
+{
+    if (!(atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) || font_config->SDF)
+        return true;
+    if ((codepoint >= 0x20 && codepoint <= 0xFF) || codepoint == 0x2026 || codepoint == 0xFF0E || codepoint == IM_UNICODE_CODEPOINT_INVALID)
+        return true;
+    const ImFont* font = font_config->DstFont;
+    return codepoint == font->FallbackChar || codepoint == font->EllipsisChar;
+}
+
+void ImFontAtlasBuildAddDynamicGlyph(ImFontAtlas* atlas, ImFont* font, const ImFontConfig* font_config, ImWchar codepoint, float advance_x)
+{
+    IM_UNUSED(atlas);
+    font->AddGlyph(font_config, codepoint, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, advance_x);
+    font->Glyphs.back().Dynamic = 1;
+}
+
+static void ImFontAtlasBuildDynamicMarkDirty(ImFontAtlas* atlas, int y0, int y1)
+{
+    if (atlas->TexDirtyMinY >= atlas->TexDirtyMaxY)
+    {
+        atlas->TexDirtyMinY = y0;
+        atlas->TexDirtyMaxY = y1;
+    }
+    else
+    {
+        atlas->TexDirtyMinY = ImMin(atlas->TexDirtyMinY, y0);
+        atlas->TexDirtyMaxY = ImMax(atlas->TexDirtyMaxY, y1);
+    }
+}
+
+void ImFontAtlasBuildDynamicInit(ImFontAtlas* atlas, const ImFontBuilderIO* builder_io, void* builder_data)
+{
+    IM_ASSERT(atlas->DynamicData == NULL);
+    IM_ASSERT(builder_io->FontBuilder_RasterizeGlyph != NULL && builder_io->FontBuilder_DestroyData != NULL);
+    ImFontAtlasDynamic* dyn = IM_NEW(ImFontAtlasDynamic)();
+    dyn->BuilderIO = builder_io;
+    dyn->BuilderData = builder_data;
+    dyn->Frame = 1;
+    atlas->DynamicData = dyn;
+
+    // Pages fit glyphs up to twice the biggest font size
+    float max_size = 0.0f;
+    for (const ImFontConfig& cfg : atlas->ConfigData)
+        max_size = ImMax(max_size, ImFabs(cfg.SizePixels) * cfg.RasterizerDensity * cfg.OversampleV);
+    const int padding = atlas->TexGlyphPadding;
+    dyn->PageHeight = ImMax(128, (int)(max_size * 2.0f) + padding);
+
+    // Pages go below the baked glyphs, the power of two rounding space is given to the pages
+    const int pages_y = atlas->TexHeight;
+    int page_count = ImClamp(atlas->TexDynamicPixels / (atlas->TexWidth * dyn->PageHeight), 1, 127); // ImFontGlyph::Page is 7 bits, 0 is no page
+    atlas->TexHeight = pages_y + page_count * dyn->PageHeight;
+    if (!(atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight))
+    {
+        atlas->TexHeight = ImUpperPowerOfTwo(atlas->TexHeight);
+        page_count = ImMin((atlas->TexHeight - pages_y) / dyn->PageHeight, 127);
+    }
+    dyn->Pages.resize(page_count);
+    memset((void*)dyn->Pages.Data, 0, (size_t)dyn->Pages.size_in_bytes());
+    for (int page_n = 0; page_n < page_count; page_n++)
+    {
+        ImFontAtlasDynamicPage& page = dyn->Pages[page_n];
+        page.Y = pages_y + page_n * dyn->PageHeight;
+        page.PackNodes.resize(atlas->TexWidth);
+        stbrp_init_target(&page.Pack, atlas->TexWidth - padding, dyn->PageHeight - padding, page.PackNodes.Data, page.PackNodes.Size);
+    }
+    atlas->TexDirtyMinY = atlas->TexDirtyMaxY = 0;
+}
+
+void ImFontAtlasBuildDynamicShutdown(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamic* dyn = atlas->DynamicData;
+    if (dyn == NULL)
+        return;
+    dyn->BuilderIO->FontBuilder_DestroyData(dyn->BuilderData);
+    dyn->Pages.clear_destruct();
+    IM_DELETE(dyn);
+    atlas->DynamicData = NULL;
+    atlas->TexDirtyMinY = atlas->TexDirtyMaxY = 0;
+}
+
+void ImFontAtlasBuildDynamicNewFrame(ImFontAtlas* atlas)
+{
+    if (atlas->DynamicData)
+        atlas->DynamicData->Frame++;
+}
+
+static void ImFontAtlasBuildDynamicEvictPage(ImFontAtlas* atlas, ImFontAtlasDynamicPage& page, int page_id)
+{
+    ImFontAtlasDynamic* dyn = atlas->DynamicData;
+    for (const ImFontAtlasDynamicGlyphRef& ref : page.Glyphs)
+    {
+        ImFontGlyph* glyph = &ref.Font->Glyphs[ref.GlyphIndex];
+        if (glyph->Page == (unsigned int)page_id)
+        {
+            glyph->Page = 0;
+            glyph->Visible = 0;
+        }
+    }
+    page.Glyphs.resize(0);
+    const int padding = atlas->TexGlyphPadding;
+    stbrp_init_target(&page.Pack, atlas->TexWidth - padding, dyn->PageHeight - padding, page.PackNodes.Data, page.PackNodes.Size);
+
+    // Clear the old pixels so they don't bleed into the padding of the new glyphs
+    const size_t page_pixels = (size_t)atlas->TexWidth * dyn->PageHeight;
+    if (atlas->TexPixelsAlpha8)
+        memset(atlas->TexPixelsAlpha8 + (size_t)page.Y * atlas->TexWidth, 0, page_pixels);
+    if (atlas->TexPixelsRGBA32)
+        memset(atlas->TexPixelsRGBA32 + (size_t)page.Y * atlas->TexWidth, 0, page_pixels * 4);
+    ImFontAtlasBuildDynamicMarkDirty(atlas, page.Y, page.Y + dyn->PageHeight);
+    dyn->PagesEvicted++;
+}
+
+bool ImFontAtlasBuildDynamicLoadGlyph(ImFontAtlas* atlas, ImFont* font, ImFontGlyph* glyph)
+{
+    ImFontAtlasDynamic* dyn = atlas->DynamicData;
+    if (dyn == NULL)
+        return false;
+    if (glyph->Page != 0)
+    {
+        dyn->Pages[glyph->Page - 1].LastUsedFrame = dyn->Frame;
+        return true;
+    }
+    if (dyn->FullFrame == dyn->Frame)
+        return false;
+
+    // Rasterize with the first source which has the glyph, same priority as when building
+    ImFontAtlasGlyphBitmap bitmap;
+    const ImFontConfig* cfg = NULL;
+    for (int src_i = 0; src_i < atlas->ConfigData.Size && cfg == NULL; src_i++)
+        if (atlas->ConfigData[src_i].DstFont == font)
+        {
+            memset(&bitmap, 0, sizeof(bitmap));
+            if (dyn->BuilderIO->FontBuilder_RasterizeGlyph(dyn->BuilderData, src_i, (ImWchar)glyph->Codepoint, &bitmap))
+                cfg = &atlas->ConfigData[src_i];
+        }
+
+    // Nothing to draw (or too big for a page), keep it as an invisible glyph
+    const int padding = atlas->TexGlyphPadding;
+    if (cfg == NULL || bitmap.Width == 0 || bitmap.Height == 0 || bitmap.Width + padding * 2 > atlas->TexWidth || bitmap.Height + padding * 2 > dyn->PageHeight)
+    {
+        glyph->Dynamic = 0;
+        glyph->Visible = 0;
+        return true;
+    }
+
+    // Pack into the first page with room, else evict the least recently used page
+    stbrp_rect rect = {};
+    rect.w = (stbrp_coord)(bitmap.Width + padding);
+    rect.h = (stbrp_coord)(bitmap.Height + padding);
+    int page_n = -1;
+    for (int n = 0; n < dyn->Pages.Size && page_n == -1; n++)
+    {
+        stbrp_pack_rects(&dyn->Pages[n].Pack, &rect, 1);
+        if (rect.was_packed)
+            page_n = n;
+    }
+    if (page_n == -1)
+    {
+        for (int n = 0; n < dyn->Pages.Size; n++)
+            if (dyn->Pages[n].LastUsedFrame != dyn->Frame && (page_n == -1 || dyn->Pages[n].LastUsedFrame < dyn->Pages[page_n].LastUsedFrame))
+                page_n = n;
+        if (page_n == -1)
+        {
+            dyn->FullFrame = dyn->Frame;
+            return false;
+        }
+        ImFontAtlasBuildDynamicEvictPage(atlas, dyn->Pages[page_n], page_n + 1);
+        stbrp_pack_rects(&dyn->Pages[page_n].Pack, &rect, 1);
+        IM_ASSERT(rect.was_packed);
+    }
+    ImFontAtlasDynamicPage& page = dyn->Pages[page_n];
+    const int tx = rect.x + padding;
+    const int ty = page.Y + rect.y + padding;
+
+    // Copy pixels
+    for (int y = 0; y < bitmap.Height; y++)
+    {
+        const size_t dst_offset = (size_t)(ty + y) * atlas->TexWidth + tx;
+        const unsigned char* src_alpha8 = bitmap.Alpha8 ? bitmap.Alpha8 + (size_t)y * bitmap.Pitch : NULL;
+        const unsigned int* src_rgba32 = bitmap.RGBA32 ? bitmap.RGBA32 + (size_t)y * bitmap.Pitch : NULL;
+        if (unsigned char* dst = atlas->TexPixelsAlpha8 ? atlas->TexPixelsAlpha8 + dst_offset : NULL)
+        {
+            if (src_alpha8)
+                memcpy(dst, src_alpha8, (size_t)bitmap.Width);
+            else
+                for (int x = 0; x < bitmap.Width; x++)
+                    dst[x] = (unsigned char)((src_rgba32[x] >> IM_COL32_A_SHIFT) & 0xFF);
+        }
+        if (unsigned int* dst = atlas->TexPixelsRGBA32 ? atlas->TexPixelsRGBA32 + dst_offset : NULL)
+        {
+            if (src_rgba32)
+                memcpy(dst, src_rgba32, (size_t)bitmap.Width * 4);
+            else
+                for (int x = 0; x < bitmap.Width; x++)
+                    dst[x] = IM_COL32(255, 255, 255, (unsigned int)src_alpha8[x]);
+        }
+    }
+    ImFontAtlasBuildDynamicMarkDirty(atlas, ty, ty + bitmap.Height);
+
+    // Position as ImFont::AddGlyph() does, AdvanceX was set when building
+    float x0 = bitmap.X0 + cfg->GlyphOffset.x;
+    float x1 = bitmap.X1 + cfg->GlyphOffset.x;
+    const float advance_x = ImClamp(bitmap.AdvanceX, cfg->GlyphMinAdvanceX, cfg->GlyphMaxAdvanceX);
+    if (advance_x != bitmap.AdvanceX)
+    {
+        float char_off_x = cfg->PixelSnapH ? ImTrunc((advance_x - bitmap.AdvanceX) * 0.5f) : (advance_x - bitmap.AdvanceX) * 0.5f;
+        x0 += char_off_x;
+        x1 += char_off_x;
+    }
+    const float font_off_y = cfg->GlyphOffset.y + IM_ROUND(font->Ascent);
+    glyph->X0 = x0;
+    glyph->Y0 = bitmap.Y0 + font_off_y;
+    glyph->X1 = x1;
+    glyph->Y1 = bitmap.Y1 + font_off_y;
+    glyph->U0 = tx * atlas->TexUvScale.x;
+    glyph->V0 = ty * atlas->TexUvScale.y;
+    glyph->U1 = (tx + bitmap.Width) * atlas->TexUvScale.x;
+    glyph->V1 = (ty + bitmap.Height) * atlas->TexUvScale.y;
+    glyph->Visible = 1;
+    glyph->Colored = bitmap.Colored ? 1 : 0;
+    glyph->Page = (unsigned int)(page_n + 1);
+    if (bitmap.Colored)
+        atlas->TexPixelsUseColors = true;
+
+    ImFontAtlasDynamicGlyphRef ref = { font, (int)(glyph - font->Glyphs.Data) };
+    page.Glyphs.push_back(ref);
+    page.LastUsedFrame = dyn->Frame;
+    dyn->GlyphsLoaded++;
+    return true;
+}
+// add by Dicky end
+
 // Retrieve list of range (2 int per range, values are inclusive)
 const ImWchar*   ImFontAtlas::GetGlyphRangesDefault()
 {
@@ -4077,6 +5072,9 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
     glyph.Codepoint = (unsigned int)codepoint;
     glyph.Visible = (x0 != x1) && (y0 != y1);
     glyph.Colored = false;
+    glyph.Dynamic = 0; // add by Dicky
+    glyph.Page = 0; // add by Dicky
+    glyph.SDF = (cfg != NULL && cfg->SDF) ? 1 : 0; // add by Dicky
     glyph.X0 = x0;
     glyph.Y0 = y0;
     glyph.X1 = x1;
@@ -4116,7 +5114,12 @@ const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
     const ImWchar i = IndexLookup.Data[c];
     if (i == (ImWchar)-1)
         return FallbackGlyph;
-    return &Glyphs.Data[i];
+    // modify by Dicky for dynamic glyphs
+    const ImFontGlyph* glyph = &Glyphs.Data[i];
+    if (glyph->Dynamic && !ImFontAtlasBuildDynamicLoadGlyph(ContainerAtlas, (ImFont*)this, (ImFontGlyph*)glyph))
+        return FallbackGlyph;
+    return glyph;
+    // modify by Dicky end
 }
 
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
@@ -4126,7 +5129,12 @@ const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
     const ImWchar i = IndexLookup.Data[c];
     if (i == (ImWchar)-1)
         return NULL;
-    return &Glyphs.Data[i];
+    // modify by Dicky for dynamic glyphs, the glyph exists even when it can't be rasterized this frame
+    const ImFontGlyph* glyph = &Glyphs.Data[i];
+    if (glyph->Dynamic)
+        ImFontAtlasBuildDynamicLoadGlyph(ContainerAtlas, (ImFont*)this, (ImFontGlyph*)glyph);
+    return glyph;
+    // modify by Dicky end
 }
 
 // Wrapping skips upcoming blanks
@@ -4335,8 +5343,9 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
 
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 // modify by dicky, add RenderText to handle shadow text
-void ImFont::RenderTextEx(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip, float spacing) const
+void ImFont::RenderTextEx(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip, float spacing, const ImVec2& sdf_uv) const
 {
+    IMGUI_PROFILE_SCOPE("RenderText");
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // ImGui:: functions generally already provides a valid text_end, so this is merely to handle direct calls.
 
@@ -4492,6 +5501,14 @@ void ImFont::RenderTextEx(ImDrawList* draw_list, float size, const ImVec2& pos,
                     }
                 }
 
+                // add by Dicky, SDF parameters decoded by the renderer
+                if (glyph->SDF)
+                {
+                    u1 += sdf_uv.x; u2 += sdf_uv.x;
+                    v1 += sdf_uv.y; v2 += sdf_uv.y;
+                }
+                // add by Dicky end
+
                 // Support for untinted glyphs
                 ImU32 glyph_col = glyph->Colored ? col_untinted : col;
 
@@ -4521,17 +5538,185 @@ void ImFont::RenderTextEx(ImDrawList* draw_list, float size, const ImVec2& pos,
     draw_list->_VtxCurrentIdx = vtx_index;
 }
 
+// add by Dicky for the text layout cache
+// Same line breaks as the word wrapping of RenderTextEx(), which then only has to draw the visible lines
+static void ImFontBuildTextLayoutLines(const ImFont* font, ImGuiTextLayout* layout, const char* text_begin, const char* text_end, float spacing)
+{
+    const float scale = layout->FontSize / font->FontSize;
+    layout->Lines.resize(0);
+    layout->Spacing = spacing;
+    layout->LinesValid = true;
+
+    float x = 0.0f;
+    const char* s = text_begin;
+    const char* line_begin = text_begin;
+    const char* word_wrap_eol = NULL;
+    while (s < text_end)
+    {
+        if (!word_wrap_eol)
+            word_wrap_eol = font->CalcWordWrapPositionA(scale, s, text_end, layout->WrapWidth - x);
+
+        if (s >= word_wrap_eol)
+        {
+            layout->Lines.push_back({ (int)(line_begin - text_begin), (int)(s - text_begin) });
+            x = 0.0f;
+            word_wrap_eol = NULL;
+            s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
+            line_begin = s;
+            continue;
+        }
+
+        const char* prev_s = s;
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+
+        if (c < 32)
+        {
+            if (c == '\n')
+            {
+                layout->Lines.push_back({ (int)(line_begin - text_begin), (int)(prev_s - text_begin) });
+                x = 0.0f;
+                line_begin = s;
+                continue;
+            }
+            if (c == '\r')
+                continue;
+        }
+
+        x += ((int)c < font->IndexAdvanceX.Size ? font->IndexAdvanceX.Data[c] : font->FallbackAdvanceX) * scale * spacing;
+    }
+    if (line_begin < text_end)
+        layout->Lines.push_back({ (int)(line_begin - text_begin), (int)(text_end - text_begin) });
+}
+
+ImGuiTextLayout* ImGui::TextLayoutCacheFind(const ImFont* font, float size, float wrap_width, const char* text, const char* text_end)
+{
+    ImGuiContext& g = *GImGui;
+    if (!g.IO.ConfigTextLayoutCache)
+        return NULL;
+    if (!text_end)
+        text_end = text + strlen(text);
+    const int text_length = (int)(text_end - text);
+    if (text_length == 0 || text_length > IMGUI_TEXT_LAYOUT_CACHE_MAX_LENGTH)
+        return NULL;
+    if (wrap_width < 0.0f)
+        wrap_width = 0.0f;
+
+    // The pool key mixes all the parameters, the layout keeps them to tell a collision from a hit
+    const ImU64 text_hash = ImHashData64(text, (size_t)text_length, 0);
+    ImU64 key_data[3] = { text_hash, (ImU64)(intptr_t)font, 0 };
+    memcpy(&key_data[2], &size, sizeof(float));
+    memcpy((char*)&key_data[2] + sizeof(float), &wrap_width, sizeof(float));
+    const ImU64 key64 = ImHashData64(key_data, sizeof(key_data), 0);
+    const ImGuiID key = (ImGuiID)(key64 ^ (key64 >> 32));
+
+    ImGuiTextLayoutCache& cache = g.TextLayoutCache;
+    ImGuiTextLayout* layout = cache.Layouts.GetOrAddByKey(key);
+    const int build_id = font->ContainerAtlas ? font->ContainerAtlas->TexBuildId : 0;
+    if (layout->TextHash != text_hash || layout->Font != font || layout->FontSize != size || layout->WrapWidth != wrap_width || layout->TextLength != text_length || layout->BuildId != build_id)
+    {
+        // New text, colliding text or rebuilt atlas: only remember the text until it comes back
+        layout->TextHash = text_hash;
+        layout->Font = font;
+        layout->FontSize = size;
+        layout->WrapWidth = wrap_width;
+        layout->TextLength = text_length;
+        layout->BuildId = build_id;
+        layout->FirstFrame = g.FrameCount;
+        layout->SizeValid = layout->LinesValid = false;
+        layout->Lines.resize(0);
+    }
+    layout->LastFrame = g.FrameCount;
+    if (layout->FirstFrame == g.FrameCount)
+    {
+        cache.Misses++;
+        return NULL;
+    }
+    cache.Hits++;
+    return layout;
+}
+
+void ImGui::TextLayoutCacheGC()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTextLayoutCache& cache = g.TextLayoutCache;
+    cache.LastFrameHits = cache.Hits;
+    cache.LastFrameMisses = cache.Misses;
+    cache.Hits = cache.Misses = 0;
+    if (!g.IO.ConfigTextLayoutCache)
+    {
+        if (cache.Layouts.GetBufSize() > 0)
+            cache.Layouts.Clear();
+        return;
+    }
+    if ((g.FrameCount & 31) != 0)
+        return;
+
+    ImPool<ImGuiTextLayout>& layouts = cache.Layouts;
+    ImVector<ImGuiStoragePair>& pairs = layouts.Map.Data;
+    for (int n = 0; n < layouts.GetMapSize(); n++)
+        if (ImGuiTextLayout* layout = layouts.TryGetMapData(n))
+            if (g.FrameCount - layout->LastFrame > IMGUI_TEXT_LAYOUT_CACHE_FRAMES)
+                layouts.Remove(pairs[n].key, layout);
+
+    // Drop the keys of removed layouts too, text changing every frame would grow the map forever
+    int size = 0;
+    for (const ImGuiStoragePair& pair : pairs)
+        if (pair.val_i != -1)
+            pairs[size++] = pair;
+    if (size != pairs.Size)
+    {
+        pairs.resize(size);
+        layouts.Map.BuildSortByKey();
+    }
+}
+// add by Dicky end
+
 // add by Dicky to override old RenderText
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
 {
     ImGuiContext& g = *GImGui;
     ImVec2 offset = g.Style.TexGlyphShadowOffset;
     float spacing = g.Style.TextSpacing;
+    const bool sdf = ImFontHasSDF(this);
+    // SDF glyphs drawn as plain text: no dilation and no softness
+    const ImVec2 sdf_uv = (sdf && (draw_list->Flags & ImDrawListFlags_AllowTextSDF)) ? IM_DRAWLIST_TEXT_SDF_UV(0, 0) : ImVec2(0.0f, 0.0f);
+    // Cached wrapped lines: RenderTextEx() draws the visible ones without wrapping. It truncates its position, which only gives
+    // the same output as the uncached path for whole line heights
+    const float line_height = FontSize * (size / FontSize);
+    if (g.IO.ConfigTextLayoutCache && wrap_width > 0.0f && line_height == IM_TRUNC(line_height))
+    {
+        if (!text_end)
+            text_end = text_begin + strlen(text_begin);
+        if (ImGuiTextLayout* layout = ImGui::TextLayoutCacheFind(this, size, wrap_width, text_begin, text_end))
+        {
+            if (!layout->LinesValid || layout->Spacing != spacing)
+                ImFontBuildTextLayoutLines(this, layout, text_begin, text_end, spacing);
+            for (int pass = (FLOAT_IS_ZERO(offset.x) && FLOAT_IS_ZERO(offset.y)) ? 1 : 0; pass < 2; pass++)
+            {
+                const ImVec2 line_pos = pass == 0 ? pos + offset : pos;
+                const ImU32 line_col = pass == 0 ? ImGui::GetColorU32(ImGuiCol_TexGlyphShadow) : col;
+                float y = IM_TRUNC(line_pos.y);
+                for (const ImGuiTextLayoutLine& line : layout->Lines)
+                {
+                    if (y > clip_rect.w)
+                        break;
+                    if (y + line_height >= clip_rect.y && line.Begin < line.End)
+                        RenderTextEx(draw_list, size, ImVec2(line_pos.x, y), line_col, clip_rect, text_begin + line.Begin, text_begin + line.End, 0.0f, cpu_fine_clip, spacing, sdf_uv);
+                    y += line_height;
+                }
+            }
+            return;
+        }
+    }
     if (!FLOAT_IS_ZERO(offset.x) || !FLOAT_IS_ZERO(offset.y))
     {
-        RenderTextEx(draw_list, size, pos + offset, ImGui::GetColorU32(ImGuiCol_TexGlyphShadow), clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip, spacing);
+        RenderTextEx(draw_list, size, pos + offset, ImGui::GetColorU32(ImGuiCol_TexGlyphShadow), clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip, spacing, sdf_uv);
     }
-    RenderTextEx(draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip, spacing);
+    RenderTextEx(draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip, spacing, sdf_uv);
 }
 // add by Dicky end
 
@@ -4,6 +4,7 @@
 #include "imgui_helper.h"
 #include <errno.h>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
 #include <sstream>
 #include <iomanip>
@@ -806,10 +807,44 @@ static const char* FieldTypeNames[ImGui::FT_COUNT+1] = {"INT","UNSIGNED","FLOAT"
 static const char* FieldTypeFormats[ImGui::FT_COUNT]={"%d","%u","%f","%f","%s","%d","%d","%f","%s","%s"};
 static const char* FieldTypeFormatsWithCustomPrecision[ImGui::FT_COUNT]={"%.*d","%*u","%.*f","%.*f","%*s","%*d","%*d","%.*f","%*s","%*s"};
 
+// Binary format: a file header then one record per field. Everything is little-endian and records are 8 bytes aligned,
+// so values can be served in place. Record = BinaryFieldHeader, name + '\0' (padded), value (padded).
+// Value layout: FT_INT/FT_ENUM int32, FT_UNSIGNED uint32, FT_FLOAT/FT_COLOR float, FT_DOUBLE double, FT_BOOL one byte per element,
+// FT_STRING chars + '\0' (numArrayElements = length), FT_TEXTLINE one zero terminated string per line.
+struct BinaryFileHeader
+{
+    char magic[4];
+    ImU16 version;
+    ImU16 headerSize;
+    ImU32 reserved[2];
+};
+struct BinaryFieldHeader
+{
+    ImU32 recordSize;       // whole record, header and padding included
+    ImU8 fieldType;
+    ImU8 flags;
+    ImU16 nameSize;         // without the trailing zero
+    ImS32 numArrayElements;
+    ImU32 valueSize;
+};
+static const char BinaryMagic[4] = {'I','M','S','B'};
+static const ImU16 BinaryVersion = 1;
+static inline size_t BinaryAlign(size_t size) {return (size+7)&~(size_t)7;}
+static inline bool BinaryIsHostLittleEndian() {const ImU16 v=1;return *(const ImU8*)&v==1;}
+static inline bool BinaryHasMagic(const char* data,size_t size) {return data && size>=sizeof(BinaryFileHeader) && memcmp(data,BinaryMagic,4)==0;}
+
 void Deserializer::clear()
 {
-    if (f_data) ImGui::MemFree(f_data);
-    f_data = NULL;f_size=0;
+    if (f_data)
+    {
+#if !defined(__EMSCRIPTEN__)
+        if (f_mapped) munmap(f_data,f_size);
+        else
+#endif
+        ImGui::MemFree(f_data);
+    }
+    f_data = NULL;f_size=0;f_mapped=false;
+    f_index.Clear();f_indexBuilt=false;
 }
 
 bool Deserializer::loadFromFile(const char *filename)
@@ -817,6 +852,17 @@ bool Deserializer::loadFromFile(const char *filename)
     clear();
     if (!filename) return false;
     FILE* f;
+    // Binary files must not go through text mode conversions
+    if ((f = (FILE *)ImFileOpen(filename, "rb")) == NULL) return false;
+    char magic[4];
+    const bool binaryFile = fread(magic,1,4,f)==4 && memcmp(magic,BinaryMagic,4)==0;
+    fclose(f);
+    if (binaryFile)
+    {
+        ImVector<char> content;
+        if (!GetFileContent(filename,content,true,"rb") || !allocate((size_t)content.size(),content.Data,(size_t)content.size())) return false;
+        return true;
+    }
     if ((f = (FILE *)ImFileOpen(filename, "rt")) == NULL) return false;
     if (fseek(f, 0, SEEK_END))
     {
@@ -857,18 +903,133 @@ bool Deserializer::allocate(size_t sizeToAllocate, const char *optionalTextToCop
     if (optionalTextToCopy && optionalTextToCopySize>0) memcpy(f_data,optionalTextToCopy,optionalTextToCopySize>f_size ? f_size:optionalTextToCopySize);
     return true;
 }
-Deserializer::Deserializer(const char *filename) : f_data(NULL),f_size(0)
+Deserializer::Deserializer(const char *filename) : f_data(NULL),f_size(0),f_mapped(false),f_indexBuilt(false)
 {
     if (filename) loadFromFile(filename);
 }
-Deserializer::Deserializer(const char *text, size_t textSizeInBytes) : f_data(NULL),f_size(0)
+Deserializer::Deserializer(const char *text, size_t textSizeInBytes) : f_data(NULL),f_size(0),f_mapped(false),f_indexBuilt(false)
 {
     allocate(textSizeInBytes,text,textSizeInBytes);
 }
+bool Deserializer::isBinary() const
+{
+    return BinaryHasMagic(f_data,f_size);
+}
+bool Deserializer::mapFile(const char *filename)
+{
+    clear();
+    if (!filename) return false;
+#if !defined(__EMSCRIPTEN__)
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1) return false;
+    struct stat sb;
+    char magic[4];
+    if (fstat(fd, &sb)!=0 || (size_t)sb.st_size<sizeof(BinaryFileHeader) || read(fd,magic,4)!=4 || memcmp(magic,BinaryMagic,4)!=0)
+    {
+        // Text files need a trailing zero, they are loaded
+        close(fd);
+        return loadFromFile(filename);
+    }
+    void* data = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data != MAP_FAILED)
+    {
+        f_data = (char*)data;f_size = (size_t)sb.st_size;f_mapped = true;
+        return true;
+    }
+#endif
+    return loadFromFile(filename);
+}
+const char* Deserializer::parseBinary(bool (*cb)(FieldType,int,void*,const char*,void*),void* userPtr,const char* optionalBufferStart) const
+{
+    BinaryFileHeader header;
+    memcpy(&header,f_data,sizeof(header));
+    if (header.version>BinaryVersion || header.headerSize<sizeof(BinaryFileHeader) || header.headerSize>f_size || !BinaryIsHostLittleEndian())
+    {
+        fprintf(stderr,"ImGuiHelper::Deserializer::parse(...) Error unsupported binary version:%d\n",(int)header.version);
+        return NULL;
+    }
+    const char* buf_end = f_data + f_size;
+    const char* record = optionalBufferStart ? optionalBufferStart : f_data + BinaryAlign(header.headerSize);
+    while (record+sizeof(BinaryFieldHeader) <= buf_end)
+    {
+        const BinaryFieldHeader* h = (const BinaryFieldHeader*)record;
+        const char* name = record+sizeof(BinaryFieldHeader);
+        char* value = (char*)name+BinaryAlign((size_t)h->nameSize+1);
+        if (h->recordSize<sizeof(BinaryFieldHeader) || (size_t)(buf_end-record)<h->recordSize || value+h->valueSize>record+h->recordSize || h->fieldType>=ImGui::FT_COUNT)
+        {
+            fprintf(stderr,"ImGuiHelper::Deserializer::parse(...) Error corrupted binary record at offset:%d\n",(int)(record-f_data));
+            return buf_end;
+        }
+        const FieldType ft = (FieldType)h->fieldType;
+        bool quitParsing = false;
+        if (ft==ImGui::FT_TEXTLINE || ft==ImGui::FT_CUSTOM)
+        {
+            const char* line = value;
+            const char* value_end = value+h->valueSize;
+            for (int i=0;i<h->numArrayElements && line<value_end;i++)
+            {
+                quitParsing = cb(ft,i,(void*)line,name,userPtr);
+                if (quitParsing) break;
+                line += strlen(line)+1;
+            }
+        }
+        else quitParsing = cb(ft,h->numArrayElements,(void*)value,name,userPtr);
+        record += h->recordSize;
+        if (quitParsing) return record;
+    }
+    return buf_end;
+}
+void Deserializer::buildIndex() const
+{
+    f_indexBuilt = true;
+    if (!isBinary()) return;
+    BinaryFileHeader header;
+    memcpy(&header,f_data,sizeof(header));
+    const char* buf_end = f_data + f_size;
+    const char* record = f_data + BinaryAlign(header.headerSize);
+    ImVector<ImGuiStoragePair>& pairs = f_index.Data;
+    while (record+sizeof(BinaryFieldHeader) <= buf_end)
+    {
+        const BinaryFieldHeader* h = (const BinaryFieldHeader*)record;
+        if (h->recordSize<sizeof(BinaryFieldHeader) || (size_t)(buf_end-record)<h->recordSize) break;
+        const ImGuiID key = ImHashStr(record+sizeof(BinaryFieldHeader),h->nameSize);
+        pairs.push_back(ImGuiStoragePair(key,(int)(record-f_data)+1));
+        record += h->recordSize;
+    }
+    // Sorted by key then by offset, so the first field of a name wins, as with a sequential parse
+    ImQsort(pairs.Data,(size_t)pairs.Size,sizeof(ImGuiStoragePair),[](const void* lhs,const void* rhs) {
+        const ImGuiStoragePair* a = (const ImGuiStoragePair*)lhs;const ImGuiStoragePair* b = (const ImGuiStoragePair*)rhs;
+        if (a->key!=b->key) return a->key<b->key ? -1 : 1;
+        return a->val_i<b->val_i ? -1 : (a->val_i>b->val_i ? 1 : 0);
+    });
+}
+const void* Deserializer::find(const char* name,FieldType* pFieldTypeOut,int* pNumArrayElementsOut) const
+{
+    if (!name || !isBinary()) return NULL;
+    if (!f_indexBuilt) buildIndex();
+    const size_t nameSize = strlen(name);
+    const ImGuiID key = ImHashStr(name,nameSize);
+    const ImVector<ImGuiStoragePair>& pairs = f_index.Data;
+    // Lower bound, then walk the (rare) hash collisions
+    int lo = 0,hi = pairs.Size;
+    while (lo<hi) {const int mid = (lo+hi)>>1;if (pairs[mid].key<key) lo = mid+1;else hi = mid;}
+    for (;lo<pairs.Size && pairs[lo].key==key;lo++)
+    {
+        const char* record = f_data+pairs[lo].val_i-1;
+        const BinaryFieldHeader* h = (const BinaryFieldHeader*)record;
+        if (h->nameSize!=nameSize || memcmp(record+sizeof(BinaryFieldHeader),name,nameSize)!=0) continue;
+        if (pFieldTypeOut) *pFieldTypeOut = (FieldType)h->fieldType;
+        if (pNumArrayElementsOut) *pNumArrayElementsOut = h->numArrayElements;
+        return record+sizeof(BinaryFieldHeader)+BinaryAlign((size_t)h->nameSize+1);
+    }
+    return NULL;
+}
 
 const char* Deserializer::parse(Deserializer::ParseCallback cb, void *userPtr, const char *optionalBufferStart) const
 {
     if (!cb || !f_data || f_size==0) return NULL;
+    if (isBinary()) return parseBinary(cb,userPtr,optionalBufferStart);
     //------------------------------------------------
     // Parse file in memory
     char name[128];name[0]='\0';
@@ -1131,21 +1292,22 @@ public:
     virtual void close()=0;
     virtual bool isValid() const=0;
     virtual int print(const char* fmt, ...)=0;
+    virtual int write(const void* data,int size)=0;
     virtual int getTypeID() const=0;
 };
 class SerializeToFile : public ISerializable
 {
 public:
-    SerializeToFile(const char* filename) : f(NULL)
+    SerializeToFile(const char* filename,bool binary=false) : f(NULL)
     {
-        saveToFile(filename);
+        saveToFile(filename,binary);
     }
     SerializeToFile() : f(NULL) {}
     ~SerializeToFile() {close();}
-    bool saveToFile(const char* filename)
+    bool saveToFile(const char* filename,bool binary=false)
     {
         close();
-        f = (FILE *)ImFileOpen(filename,"w");
+        f = (FILE *)ImFileOpen(filename,binary ? "wb" : "w");
         return (f);
     }
     void close() {if (f) fclose(f);f=NULL;}
@@ -1157,6 +1319,7 @@ public:
         va_end(args);
         return rv;
     }
+    int write(const void* data,int size) {return f ? (int)fwrite(data,1,size,f) : 0;}
     int getTypeID() const {return 0;}
 protected:
     FILE* f;
@@ -1184,13 +1347,22 @@ public:
 
         const int startSz = b.size();
         b.resize(startSz+additionalSize);
-        const int rv = vsnprintf(&b[startSz-1],additionalSize,fmt,args2);
+        const int rv = vsnprintf(&b[startSz-1],additionalSize+1,fmt,args2);
         va_end(args2);
         //IM_ASSERT(additionalSize==rv);
         //IM_ASSERT(v[startSz+additionalSize-1]=='\0');
 
         return rv;
     }
+    int write(const void* data,int size)
+    {
+        // Keeps the trailing zero of the text mode
+        const int startSz = b.size();
+        b.resize(startSz+size);
+        memcpy(&b[startSz-1],data,size);
+        b[startSz+size-1]='\0';
+        return size;
+    }
     inline const char* getBuffer() const {return b.size()>0 ? &b[0] : NULL;}
     inline int getBufferSize() const {return b.size();}
     int getTypeID() const {return 1;}
@@ -1208,7 +1380,7 @@ int Serializer::getBufferSize() const
 bool Serializer::WriteBufferToFile(const char* filename,const char* buffer,int bufferSize)
 {
     if (!buffer) return false;
-    FILE* f = (FILE *)ImFileOpen(filename,"w");
+    FILE* f = (FILE *)ImFileOpen(filename,BinaryHasMagic(buffer,bufferSize) ? "wb" : "w");
     if (!f) return false;
     fwrite((void*) buffer,bufferSize,1,f);
     fclose(f);
@@ -1216,16 +1388,38 @@ bool Serializer::WriteBufferToFile(const char* filename,const char* buffer,int b
 }
 
 void Serializer::clear() {if (f) {f->close();}}
-Serializer::Serializer(const char *filename)
+Serializer::Serializer(const char *filename) : binary(false)
 {
     f=(SerializeToFile*) ImGui::MemAlloc(sizeof(SerializeToFile));
     IM_PLACEMENT_NEW((SerializeToFile*)f) SerializeToFile(filename);
 }
-Serializer::Serializer(int memoryBufferCapacity)
+Serializer::Serializer(int memoryBufferCapacity) : binary(false)
 {
     f=(SerializeToBuffer*) ImGui::MemAlloc(sizeof(SerializeToBuffer));
     IM_PLACEMENT_NEW((SerializeToBuffer*)f) SerializeToBuffer(memoryBufferCapacity);
 }
+static void WriteBinaryFileHeader(ISerializable* f)
+{
+    IM_ASSERT(BinaryIsHostLittleEndian());
+    BinaryFileHeader header;
+    memset(&header,0,sizeof(header));
+    memcpy(header.magic,BinaryMagic,4);
+    header.version = BinaryVersion;
+    header.headerSize = (ImU16)sizeof(BinaryFileHeader);
+    f->write(&header,(int)sizeof(header));
+}
+Serializer::Serializer(const char *filename,bool binaryMode) : binary(binaryMode)
+{
+    f=(SerializeToFile*) ImGui::MemAlloc(sizeof(SerializeToFile));
+    IM_PLACEMENT_NEW((SerializeToFile*)f) SerializeToFile(filename,binaryMode);
+    if (binary && f->isValid()) WriteBinaryFileHeader(f);
+}
+Serializer::Serializer(int memoryBufferCapacity,bool binaryMode) : binary(binaryMode)
+{
+    f=(SerializeToBuffer*) ImGui::MemAlloc(sizeof(SerializeToBuffer));
+    IM_PLACEMENT_NEW((SerializeToBuffer*)f) SerializeToBuffer(memoryBufferCapacity);
+    if (binary) WriteBinaryFileHeader(f);
+}
 Serializer::~Serializer()
 {
     if (f)
@@ -1235,6 +1429,39 @@ Serializer::~Serializer()
         f=NULL;
     }
 }
+static void WriteBinaryPadding(ISerializable* f,size_t size)
+{
+    static const char zeros[8] = {0,0,0,0,0,0,0,0};
+    if (BinaryAlign(size)>size) f->write(zeros,(int)(BinaryAlign(size)-size));
+}
+// The caller writes exactly 'valueSize' bytes of value after this, then WriteBinaryPadding(f,valueSize)
+static bool WriteBinaryFieldHeader(ISerializable* f,FieldType ft,const char* name,int numArrayElements,size_t valueSize)
+{
+    const size_t nameSize = strlen(name);
+    const size_t recordSize = sizeof(BinaryFieldHeader)+BinaryAlign(nameSize+1)+BinaryAlign(valueSize);
+    if (nameSize>0xFFFF || recordSize>0xFFFFFFFFu) return false;
+    BinaryFieldHeader h;
+    h.recordSize = (ImU32)recordSize;
+    h.fieldType = (ImU8)ft;
+    h.flags = 0;
+    h.nameSize = (ImU16)nameSize;
+    h.numArrayElements = numArrayElements;
+    h.valueSize = (ImU32)valueSize;
+    f->write(&h,(int)sizeof(h));
+    f->write(name,(int)nameSize+1);
+    WriteBinaryPadding(f,nameSize+1);
+    return true;
+}
+static bool SaveBinaryField(ISerializable* f,FieldType ft,const void* pValue,size_t elementSize,const char* name,int numArrayElements)
+{
+    if (!f || !pValue || !name || name[0]=='\0' || numArrayElements<0 || numArrayElements>4) return false;
+    if (numArrayElements==0) numArrayElements=1;
+    const size_t valueSize = elementSize*numArrayElements;
+    if (!WriteBinaryFieldHeader(f,ft,name,numArrayElements,valueSize)) return false;
+    f->write(pValue,(int)valueSize);
+    WriteBinaryPadding(f,valueSize);
+    return true;
+}
 template <typename T> inline static bool SaveTemplate(ISerializable* f,FieldType ft, const T* pValue, const char* name, int numArrayElements=1, int prec=-1)
 {
     if (!f || ft==ImGui::FT_COUNT  || ft==ImGui::FT_CUSTOM || numArrayElements<0 || numArrayElements>4 || !pValue || !name || name[0]=='\0') return false;
@@ -1256,15 +1483,24 @@ template <typename T> inline static bool SaveTemplate(ISerializable* f,FieldType
 bool Serializer::save(FieldType ft, const float* pValue, const char* name, int numArrayElements,  int prec)
 {
     IM_ASSERT(ft==ImGui::FT_FLOAT || ft==ImGui::FT_COLOR);
+    if (binary) return SaveBinaryField(f,ft,pValue,sizeof(float),name,numArrayElements);
     return SaveTemplate<float>(f,ft,pValue,name,numArrayElements,prec);
 }
 bool Serializer::save(const double* pValue,const char* name,int numArrayElements, int prec)
 {
+    if (binary) return SaveBinaryField(f,ImGui::FT_DOUBLE,pValue,sizeof(double),name,numArrayElements);
     return SaveTemplate<double>(f,ImGui::FT_DOUBLE,pValue,name,numArrayElements,prec);
 }
 bool Serializer::save(const bool* pValue,const char* name,int numArrayElements)
 {
     if (!pValue || numArrayElements<0 || numArrayElements>4) return false;
+    if (numArrayElements==0) numArrayElements=1;
+    if (binary)
+    {
+        ImU8 b[4] = {0};
+        for (int i=0;i<numArrayElements;i++) b[i] = pValue[i] ? 1 : 0;
+        return SaveBinaryField(f,ImGui::FT_BOOL,b,1,name,numArrayElements);
+    }
     static int tmp[4];
     for (int i=0;i<numArrayElements;i++) tmp[i] = pValue[i] ? 1 : 0;
     return SaveTemplate<int>(f,ImGui::FT_BOOL,tmp,name,numArrayElements);
@@ -1273,11 +1509,13 @@ bool Serializer::save(FieldType ft,const int* pValue,const char* name,int numArr
 {
     IM_ASSERT(ft==ImGui::FT_INT || ft==ImGui::FT_BOOL || ft==ImGui::FT_ENUM);
     if (prec==0) prec=-1;
+    if (binary) return SaveBinaryField(f,ft,pValue,sizeof(int),name,numArrayElements);
     return SaveTemplate<int>(f,ft,pValue,name,numArrayElements,prec);
 }
 bool Serializer::save(const unsigned* pValue,const char* name,int numArrayElements, int prec)
 {
     if (prec==0) prec=-1;
+    if (binary) return SaveBinaryField(f,ImGui::FT_UNSIGNED,pValue,sizeof(unsigned),name,numArrayElements);
     return SaveTemplate<unsigned>(f,ImGui::FT_UNSIGNED,pValue,name,numArrayElements,prec);
 }
 bool Serializer::save(const char* pValue,const char* name,int pValueSize)
@@ -1288,6 +1526,14 @@ bool Serializer::save(const char* pValue,const char* name,int pValueSize)
     numArrayElements = pValueSize;
     pValueSize=(int)strlen(pValue);if (numArrayElements>pValueSize || numArrayElements<=0) numArrayElements=pValueSize;
     if (numArrayElements<0) numArrayElements=0;
+    if (binary)
+    {
+        if (!WriteBinaryFieldHeader(f,ft,name,numArrayElements,(size_t)numArrayElements+1)) return false;
+        f->write(pValue,numArrayElements);
+        f->write("",1);
+        WriteBinaryPadding(f,(size_t)numArrayElements+1);
+        return true;
+    }
 
     // name
     f->print( "[%s",FieldTypeNames[ft]);
@@ -1313,6 +1559,26 @@ bool Serializer::saveTextLines(const char* pValue,const char* name)
     }
     if (left>0) ++numArrayElements;
     if (numArrayElements==0) return false;
+    if (binary)
+    {
+        // Same lines, '\n' replaced by the terminating zero of each one
+        const size_t len = strlen(pValue);
+        const size_t valueSize = len+(endsWithNewLine ? 0 : 1);
+        int numLines = 0;
+        for (size_t i=0;i<len;i++) if (pValue[i]=='\n') ++numLines;
+        if (!endsWithNewLine) ++numLines;
+        if (!WriteBinaryFieldHeader(f,ft,name,numLines,valueSize)) return false;
+        for (const char* line = pValue;line<pValue+len;)
+        {
+            const char* line_end = strchr(line,'\n');
+            if (!line_end) line_end = pValue+len;
+            f->write(line,(int)(line_end-line));
+            f->write("",1);
+            line = line_end+1;
+        }
+        WriteBinaryPadding(f,valueSize);
+        return true;
+    }
 
     // name
     f->print( "[%s",FieldTypeNames[ft]);
@@ -1330,6 +1596,31 @@ bool Serializer::saveTextLines(int numValues,bool (*items_getter)(void* data, in
     FieldType ft = ImGui::FT_TEXTLINE;
     if (!items_getter || !f || ft==ImGui::FT_COUNT || numValues<=0 || !name || name[0]=='\0') return false;
     int numArrayElements =numValues;  // numLines
+    if (binary)
+    {
+        ImVector<const char*> lines;
+        lines.resize(numValues);
+        size_t valueSize = 0;
+        for (int i=0;i<numValues;i++)
+        {
+            const char* text=NULL;
+            if (!items_getter(data,i,&text) || !text) text="";
+            size_t len = strlen(text);
+            if (len>0 && text[len-1]=='\n') --len;
+            lines[i] = text;
+            valueSize += len+1;
+        }
+        if (!WriteBinaryFieldHeader(f,ft,name,numValues,valueSize)) return false;
+        for (int i=0;i<numValues;i++)
+        {
+            size_t len = strlen(lines[i]);
+            if (len>0 && lines[i][len-1]=='\n') --len;
+            f->write(lines[i],(int)len);
+            f->write("",1);
+        }
+        WriteBinaryPadding(f,valueSize);
+        return true;
+    }
 
     // name
     f->print( "[%s",FieldTypeNames[ft]);
@@ -1353,6 +1644,7 @@ bool Serializer::saveTextLines(int numValues,bool (*items_getter)(void* data, in
 }
 bool Serializer::saveCustomFieldTypeHeader(const char* name, int numTextLines)
 {
+    if (binary) return false;   // Lines written after the header can't be sized, use saveTextLines(...) in binary mode
     // name
     f->print( "[%s",FieldTypeNames[ImGui::FT_CUSTOM]);
     if (numTextLines==0) numTextLines=1;
@@ -1772,6 +2064,17 @@ std::string settings_path(std::string app_name)
     }
 }
 
+std::string cache_path(std::string app_name)
+{
+    std::string path = getCacheDir() + PATH_SEP + app_name;
+    if (!create_directory(path))
+        return "";
+    path += PATH_SEP + std::string("cache");
+    if (!create_directory(path))
+        return "";
+    return path + PATH_SEP;
+}
+
 std::string temp_path()
 {
     std::string temp;
@@ -1957,340 +2260,520 @@ std::string MillisecToString(int64_t millisec, int show_millisec)
 }
 
 #if !defined(__EMSCRIPTEN__)
+// Reads and decrypts 'path' chunk by chunk: a worker thread reads the next chunk while the current one is decrypted.
+// Plain data goes to out[0, capacity) when out is set, to consumer otherwise.
+static size_t DecryptFilePipelined(const std::string& path, const std::string& key, size_t chunk_size, uint8_t* out, size_t capacity, const std::function<bool(const uint8_t* data, size_t size)>* consumer)
+{
+    ImFileHandle f = ImFileOpen(path.c_str(), "rb");
+    if (!f)
+    {
+        std::cout << "out file can't open data file" << path << std::endl;
+        return 0;
+    }
+    if (chunk_size < 4096) chunk_size = 4096;
+    chunk_size &= ~(size_t)(EVP_MAX_BLOCK_LENGTH - 1);
+    std::vector<uint8_t> buffers[2];
+    size_t sizes[2] = {0, 0};
+    bool ready[2] = {false, false};
+    bool read_error = false, stop = false;
+    std::mutex mutex;
+    std::condition_variable cv;
+    buffers[0].resize(chunk_size);
+    buffers[1].resize(chunk_size);
+    std::thread reader([&]()
+    {
+        for (int slot = 0; ; slot ^= 1)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]{ return !ready[slot] || stop; });
+                if (stop) return;
+            }
+            const size_t n = (size_t)ImFileRead(buffers[slot].data(), 1, chunk_size, f);
+            const bool error = n < chunk_size && ferror(f);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                sizes[slot] = n;
+                ready[slot] = true;
+                read_error = error;
+            }
+            cv.notify_all();
+            // A short chunk is the last one
+            if (n < chunk_size) return;
+        }
+    });
+
+    std::vector<uint8_t> plain(chunk_size + EVP_MAX_BLOCK_LENGTH);
+    size_t total = 0;
+    bool ok = true;
+    // Plain data lands in 'out' directly, through 'plain' when it could overflow
+    auto emit = [&](const uint8_t* src, size_t n) -> bool
+    {
+        if (consumer) return (*consumer)(src, n);
+        if (src != out + total && n > 0)
+        {
+            if (n > capacity - total) return false;
+            memcpy(out + total, src, n);
+        }
+        return true;
+    };
+    try
+    {
+        ImGuiHelper::Encrypt::Stream stream((const uint8_t*)key.c_str(), true);
+        for (int slot = 0; ok; slot ^= 1)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]{ return ready[slot]; });
+                if (read_error) { ok = false; break; }
+            }
+            const size_t n = sizes[slot];
+            const bool direct = !consumer && out && capacity - total >= n + EVP_MAX_BLOCK_LENGTH;
+            uint8_t* dst = direct ? out + total : plain.data();
+            const size_t len = stream.update(buffers[slot].data(), n, dst);
+            ok = emit(dst, len);
+            total += len;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ready[slot] = false;
+            }
+            cv.notify_all();
+            if (n < chunk_size)
+            {
+                uint8_t last[EVP_MAX_BLOCK_LENGTH];
+                const size_t last_len = stream.finish(last);
+                ok = ok && emit(last, last_len);
+                total += last_len;
+                break;
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "decrypt file failed: " << e.what() << std::endl;
+        ok = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    reader.join();
+    ImFileClose(f);
+    return ok ? total : 0;
+}
+
 void ImDecryptFile(const std::string path, const std::string key, std::vector<uint8_t>& data)
 {
     data.clear();
-    struct stat sb_enc;
-    const uint8_t *memblock_enc;
-    int fd_enc = open(path.c_str(), O_RDONLY);
-    if (fd_enc == -1)
+    ImFileHandle f = ImFileOpen(path.c_str(), "rb");
+    if (!f)
     {
         std::cout << "out file can't open data file" << path << std::endl;
         return;
     }
-    fstat(fd_enc, &sb_enc);
-    memblock_enc = (const uint8_t *)mmap(NULL, sb_enc.st_size, PROT_READ, MAP_PRIVATE, fd_enc, 0);
-    close(fd_enc);
-    if (memblock_enc == MAP_FAILED)
+    const ImU64 file_size = ImFileGetSize(f);
+    ImFileClose(f);
+    // The plain data is never larger than the encrypted one
+    data.resize((size_t)file_size);
+    auto check_len = DecryptFilePipelined(path, key, 4 * 1024 * 1024, data.data(), data.size(), nullptr);
+    data.resize(check_len);
+    std::cout << "decrypt length:" << check_len << std::endl;
+}
+
+size_t ImDecryptFile(const std::string& path, const std::string& key, const std::function<bool(const uint8_t* data, size_t size)>& consumer, size_t chunk_size)
+{
+    if (!consumer) return 0;
+    return DecryptFilePipelined(path, key, chunk_size, nullptr, 0, &consumer);
+}
+
+size_t ImDecryptFile(const std::string& path, const std::string& key, uint8_t* out, size_t capacity, size_t chunk_size)
+{
+    if (!out) return 0;
+    return DecryptFilePipelined(path, key, chunk_size, out, capacity, nullptr);
+}
+
+size_t ImDecryptFile(const std::string& path, const std::string& key, ImGui::ImMat& mat, size_t chunk_size)
+{
+    if (mat.empty())
     {
-        std::cout << "out file can't map data file" << path << std::endl;
-        return;
+        std::cout << "decrypt file needs a created mat" << std::endl;
+        return 0;
     }
-    auto& instance = ImGuiHelper::Encrypt::Instance();
-    auto check_len = instance.decrypt(memblock_enc, data, sb_enc.st_size, (uint8_t*)key.c_str());
-    std::cout << "decrypt length:" << check_len << std::endl;
-    munmap((void *)memblock_enc, sb_enc.st_size);
+    // The plain data is packed, the channels of a 3D mat are cstep apart and can have padding between them
+    const size_t plane_size = (size_t)mat.w * mat.h * mat.elemsize;
+    if (mat.dims < 3 || mat.c == 1 || mat.cstep * mat.elemsize == plane_size)
+        return DecryptFilePipelined(path, key, chunk_size, (uint8_t*)mat.data, mat.total() * mat.elemsize, nullptr);
+    const size_t capacity = plane_size * mat.c;
+    size_t offset = 0;
+    std::function<bool(const uint8_t* data, size_t size)> scatter = [&](const uint8_t* data, size_t size)
+    {
+        if (size > capacity - offset) return false;
+        while (size > 0)
+        {
+            const size_t plane = offset / plane_size, pos = offset % plane_size;
+            const size_t n = ImMin(size, plane_size - pos);
+            memcpy((uint8_t*)mat.data + plane * mat.cstep * mat.elemsize + pos, data, n);
+            data += n;
+            size -= n;
+            offset += n;
+        }
+        return true;
+    };
+    return DecryptFilePipelined(path, key, chunk_size, nullptr, 0, &scatter);
+}
+
+size_t ImEncryptFile(const std::string& path, const std::string& key, const uint8_t* data, size_t size, size_t chunk_size)
+{
+    if (!data && size > 0) return 0;
+    ImFileHandle f = ImFileOpen(path.c_str(), "wb");
+    if (!f)
+    {
+        std::cout << "can't create encrypted file" << path << std::endl;
+        return 0;
+    }
+    if (chunk_size < 4096) chunk_size = 4096;
+    std::vector<uint8_t> buffer(chunk_size + EVP_MAX_BLOCK_LENGTH);
+    size_t total = 0;
+    bool ok = true;
+    try
+    {
+        ImGuiHelper::Encrypt::Stream stream((const uint8_t*)key.c_str(), false);
+        for (size_t pos = 0; pos < size && ok; pos += chunk_size)
+        {
+            const size_t len = stream.update(data + pos, std::min(chunk_size, size - pos), buffer.data());
+            ok = ImFileWrite(buffer.data(), 1, len, f) == len;
+            total += len;
+        }
+        const size_t len = stream.finish(buffer.data());
+        ok = ok && ImFileWrite(buffer.data(), 1, len, f) == len;
+        total += len;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "encrypt file failed: " << e.what() << std::endl;
+        ok = false;
+    }
+    ImFileClose(f);
+    return ok ? total : 0;
 }
 #endif
 } //namespace ImGuiHelper
 
-namespace base64 
+// Base64/Base85 codecs. Base64 encodes 12 (SSSE3), 24 (AVX2) or 48 (NEON) bytes per step and falls back to the scalar
+// loop for the tail and for any block holding characters out of the alphabet (newlines, '=', quotes...),
+// which are skipped as the former libb64 decoder did.
+#if defined(__AVX2__)
+#define IMGUI_BASE64_AVX2
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+#define IMGUI_BASE64_SSSE3
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define IMGUI_BASE64_NEON
+#include <arm_neon.h>
+#endif
+
+namespace ImGui
 {
-// Decoder here
-extern "C"
+namespace Stringifier
 {
-typedef enum {step_a, step_b, step_c, step_d} base64_decodestep;
-typedef struct {base64_decodestep step;char plainchar;} base64_decodestate;
-
-inline int base64_decode_value(char value_in)
+static const char Base64Chars[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+struct Base64DecodeTable
+{
+    signed char Value[256];   // -1: not in the alphabet
+    Base64DecodeTable()
+    {
+        memset(Value,-1,sizeof(Value));
+        for (int i=0;i<64;i++) Value[(unsigned char)Base64Chars[i]] = (signed char)i;
+    }
+};
+static const Base64DecodeTable Base64Table;
+// Decoding state, so that streams can be split anywhere
+struct Base64DecodeState
 {
-	static const char decoding[] = {62,-1,-1,-1,63,52,53,54,55,56,57,58,59,60,61,-1,-1,-1,-2,-1,-1,-1,0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,-1,-1,-1,-1,-1,-1,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48,49,50,51};
-	static const char decoding_size = sizeof(decoding);
-	value_in -= 43;
-	if (value_in < 0 || value_in > decoding_size) return -1;
-	return decoding[(int)value_in];
+    ImU32 Bits;
+    int NumChars;   // characters in Bits, 0 to 3
+    Base64DecodeState() : Bits(0),NumChars(0) {}
+};
+// Output size of Base64EncodeFast(), without padding: 4*ceil(n/3)
+static inline size_t Base64EncodedSize(size_t inputSize) {return (inputSize+2)/3*4;}
+// Upper bound of the Base64DecodeFast() output, with the slack the vector stores need
+static inline size_t Base64DecodedSizeBound(size_t inputSize) {return inputSize/4*3+3+16;}
+
+#if defined(IMGUI_BASE64_SSSE3)
+// 12 bytes in 16 lanes -> 16 indices (Muła's method, as in aklomp/base64)
+static inline __m128i Base64EncodeReshuffle(__m128i in)
+{
+    in = _mm_shuffle_epi8(in,_mm_set_epi8(10,11,9,10,7,8,6,7,4,5,3,4,1,2,0,1));
+    const __m128i t0 = _mm_and_si128(in,_mm_set1_epi32(0x0FC0FC00));
+    const __m128i t1 = _mm_mulhi_epu16(t0,_mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in,_mm_set1_epi32(0x003F03F0));
+    const __m128i t3 = _mm_mullo_epi16(t2,_mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1,t3);
+}
+static inline __m128i Base64EncodeTranslate(__m128i in)
+{
+    const __m128i lut = _mm_setr_epi8(65,71,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-19,-16,0,0);
+    __m128i indices = _mm_subs_epu8(in,_mm_set1_epi8(51));
+    indices = _mm_sub_epi8(indices,_mm_cmpgt_epi8(in,_mm_set1_epi8(25)));
+    return _mm_add_epi8(in,_mm_shuffle_epi8(lut,indices));
+}
+// 16 characters -> 12 bytes in the low lanes, false if a character is not in the alphabet
+static inline bool Base64DecodeTranslate(__m128i& str)
+{
+    const __m128i lut_lo = _mm_setr_epi8(0x15,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x13,0x1A,0x1B,0x1B,0x1B,0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10,0x10,0x01,0x02,0x04,0x08,0x04,0x08,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0,16,19,4,-65,-65,-71,-71,0,0,0,0,0,0,0,0);
+    const __m128i mask_2F = _mm_set1_epi8(0x2F);
+    const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str,4),mask_2F);
+    const __m128i lo_nibbles = _mm_and_si128(str,mask_2F);
+    const __m128i hi = _mm_shuffle_epi8(lut_hi,hi_nibbles);
+    const __m128i lo = _mm_shuffle_epi8(lut_lo,lo_nibbles);
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo,hi),_mm_setzero_si128()))!=0) return false;
+    const __m128i roll = _mm_shuffle_epi8(lut_roll,_mm_add_epi8(_mm_cmpeq_epi8(str,mask_2F),hi_nibbles));
+    str = _mm_add_epi8(str,roll);
+    const __m128i merge_ab_and_bc = _mm_maddubs_epi16(str,_mm_set1_epi32(0x01400140));
+    str = _mm_madd_epi16(merge_ab_and_bc,_mm_set1_epi32(0x00011000));
+    str = _mm_shuffle_epi8(str,_mm_setr_epi8(2,1,0,6,5,4,10,9,8,14,13,12,-1,-1,-1,-1));
+    return true;
 }
-inline void base64_init_decodestate(base64_decodestate* state_in)
+#endif
+#if defined(IMGUI_BASE64_AVX2)
+// Same as above on two 128 bits lanes
+static inline __m256i Base64EncodeReshuffle(__m256i in)
+{
+    in = _mm256_shuffle_epi8(in,_mm256_broadcastsi128_si256(_mm_set_epi8(10,11,9,10,7,8,6,7,4,5,3,4,1,2,0,1)));
+    const __m256i t0 = _mm256_and_si256(in,_mm256_set1_epi32(0x0FC0FC00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0,_mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in,_mm256_set1_epi32(0x003F03F0));
+    const __m256i t3 = _mm256_mullo_epi16(t2,_mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(t1,t3);
+}
+static inline __m256i Base64EncodeTranslate(__m256i in)
+{
+    const __m256i lut = _mm256_broadcastsi128_si256(_mm_setr_epi8(65,71,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-19,-16,0,0));
+    __m256i indices = _mm256_subs_epu8(in,_mm256_set1_epi8(51));
+    indices = _mm256_sub_epi8(indices,_mm256_cmpgt_epi8(in,_mm256_set1_epi8(25)));
+    return _mm256_add_epi8(in,_mm256_shuffle_epi8(lut,indices));
+}
+static inline bool Base64DecodeTranslate(__m256i& str)
+{
+    const __m256i lut_lo = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x11,0x13,0x1A,0x1B,0x1B,0x1B,0x1A));
+    const __m256i lut_hi = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10,0x10,0x01,0x02,0x04,0x08,0x04,0x08,0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10));
+    const __m256i lut_roll = _mm256_broadcastsi128_si256(_mm_setr_epi8(0,16,19,4,-65,-65,-71,-71,0,0,0,0,0,0,0,0));
+    const __m256i mask_2F = _mm256_set1_epi8(0x2F);
+    const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str,4),mask_2F);
+    const __m256i lo_nibbles = _mm256_and_si256(str,mask_2F);
+    const __m256i hi = _mm256_shuffle_epi8(lut_hi,hi_nibbles);
+    const __m256i lo = _mm256_shuffle_epi8(lut_lo,lo_nibbles);
+    if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(lo,hi),_mm256_setzero_si256()))!=0) return false;
+    const __m256i roll = _mm256_shuffle_epi8(lut_roll,_mm256_add_epi8(_mm256_cmpeq_epi8(str,mask_2F),hi_nibbles));
+    str = _mm256_add_epi8(str,roll);
+    const __m256i merge_ab_and_bc = _mm256_maddubs_epi16(str,_mm256_set1_epi32(0x01400140));
+    str = _mm256_madd_epi16(merge_ab_and_bc,_mm256_set1_epi32(0x00011000));
+    str = _mm256_shuffle_epi8(str,_mm256_broadcastsi128_si256(_mm_setr_epi8(2,1,0,6,5,4,10,9,8,14,13,12,-1,-1,-1,-1)));
+    return true;
+}
+#endif
+#if defined(IMGUI_BASE64_NEON)
+static inline uint8x16x4_t Base64LoadTable(const unsigned char* t)
 {
-	state_in->step = step_a;
-	state_in->plainchar = 0;
+    uint8x16x4_t r;
+    r.val[0] = vld1q_u8(t);r.val[1] = vld1q_u8(t+16);r.val[2] = vld1q_u8(t+32);r.val[3] = vld1q_u8(t+48);
+    return r;
 }
-inline int base64_decode_block(const char* code_in, const int length_in, char* plaintext_out, base64_decodestate* state_in)
+#endif
+
+// Encodes the whole input, with '=' padding
+static char* Base64EncodeFast(const unsigned char* src,size_t len,char* dst)
 {
-	const char* codechar = code_in;
-	char* plainchar = plaintext_out;
-	char fragment;
-	
-	*plainchar = state_in->plainchar;
-	
-	switch (state_in->step)
-	{
-		while (1)
-		{
-        case step_a:
-			do
+    const unsigned char* src_end = src+len;
+#if defined(IMGUI_BASE64_AVX2)
+    // 2x12 bytes per step, the second 16 bytes load reads up to src+28
+    while (src_end-src>=28)
+    {
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)src)),_mm_loadu_si128((const __m128i*)(src+12)),1);
+        _mm256_storeu_si256((__m256i*)dst,Base64EncodeTranslate(Base64EncodeReshuffle(in)));
+        src+=24;dst+=32;
+    }
+#endif
+#if defined(IMGUI_BASE64_SSSE3)
+    while (src_end-src>=16)
+    {
+        _mm_storeu_si128((__m128i*)dst,Base64EncodeTranslate(Base64EncodeReshuffle(_mm_loadu_si128((const __m128i*)src))));
+        src+=12;dst+=16;
+    }
+#elif defined(IMGUI_BASE64_NEON)
+    if (src_end-src>=48)
+    {
+        const uint8x16x4_t table = Base64LoadTable((const unsigned char*)Base64Chars);
+        const uint8x16_t mask = vdupq_n_u8(0x3F);
+        while (src_end-src>=48)
+        {
+            const uint8x16x3_t in = vld3q_u8(src);
+            uint8x16x4_t out;
+            out.val[0] = vshrq_n_u8(in.val[0],2);
+            out.val[1] = vandq_u8(vorrq_u8(vshrq_n_u8(in.val[1],4),vshlq_n_u8(in.val[0],4)),mask);
+            out.val[2] = vandq_u8(vorrq_u8(vshrq_n_u8(in.val[2],6),vshlq_n_u8(in.val[1],2)),mask);
+            out.val[3] = vandq_u8(in.val[2],mask);
+            for (int i=0;i<4;i++) out.val[i] = vqtbl4q_u8(table,out.val[i]);
+            vst4q_u8((unsigned char*)dst,out);
+            src+=48;dst+=64;
+        }
+    }
+#endif
+    while (src_end-src>=3)
+    {
+        const ImU32 v = ((ImU32)src[0]<<16) | ((ImU32)src[1]<<8) | (ImU32)src[2];
+        dst[0] = Base64Chars[v>>18];dst[1] = Base64Chars[(v>>12)&0x3F];dst[2] = Base64Chars[(v>>6)&0x3F];dst[3] = Base64Chars[v&0x3F];
+        src+=3;dst+=4;
+    }
+    if (src_end-src>0)
+    {
+        const ImU32 v = ((ImU32)src[0]<<16) | (src_end-src>1 ? ((ImU32)src[1]<<8) : 0);
+        dst[0] = Base64Chars[v>>18];dst[1] = Base64Chars[(v>>12)&0x3F];
+        dst[2] = src_end-src>1 ? Base64Chars[(v>>6)&0x3F] : '=';
+        dst[3] = '=';
+        dst+=4;
+    }
+    return dst;
+}
+// Characters out of the alphabet are skipped. dst must hold Base64DecodedSizeBound(len) bytes.
+// The last 1-2 bytes of an incomplete quad stay in 'state' until Base64DecodeFinish().
+static unsigned char* Base64DecodeFast(const char* src,size_t len,unsigned char* dst,Base64DecodeState& state)
+{
+    const unsigned char* s = (const unsigned char*)src;
+    const unsigned char* s_end = s+len;
+    const signed char* table = Base64Table.Value;
+    while (s<s_end)
+    {
+        if (state.NumChars==0)
+        {
+#if defined(IMGUI_BASE64_AVX2)
+            while (s_end-s>=32)
             {
-				if (codechar == code_in+length_in)
-				{
-					state_in->step = step_a;
-					state_in->plainchar = *plainchar;
-					return plainchar - plaintext_out;
-				}
-				fragment = (char)base64_decode_value(*codechar++);
-			} while (fragment < 0);
-			*plainchar    = (fragment & 0x03f) << 2;
-        case step_b:
-			do
+                __m256i str = _mm256_loadu_si256((const __m256i*)s);
+                if (!Base64DecodeTranslate(str)) break;
+                _mm_storeu_si128((__m128i*)dst,_mm256_castsi256_si128(str));
+                _mm_storeu_si128((__m128i*)(dst+12),_mm256_extracti128_si256(str,1));
+                s+=32;dst+=24;
+            }
+#endif
+#if defined(IMGUI_BASE64_SSSE3)
+            while (s_end-s>=16)
             {
-				if (codechar == code_in+length_in)
-				{
-					state_in->step = step_b;
-					state_in->plainchar = *plainchar;
-					return plainchar - plaintext_out;
-				}
-				fragment = (char)base64_decode_value(*codechar++);
-			} while (fragment < 0);
-			*plainchar++ |= (fragment & 0x030) >> 4;
-			*plainchar    = (fragment & 0x00f) << 4;
-        case step_c:
-			do
+                __m128i str = _mm_loadu_si128((const __m128i*)s);
+                if (!Base64DecodeTranslate(str)) break;
+                _mm_storeu_si128((__m128i*)dst,str);
+                s+=16;dst+=12;
+            }
+#elif defined(IMGUI_BASE64_NEON)
+            if (s_end-s>=64)
             {
-				if (codechar == code_in+length_in)
-				{
-					state_in->step = step_c;
-					state_in->plainchar = *plainchar;
-					return plainchar - plaintext_out;
-				}
-				fragment = (char)base64_decode_value(*codechar++);
-			} while (fragment < 0);
-			*plainchar++ |= (fragment & 0x03c) >> 2;
-			*plainchar    = (fragment & 0x003) << 6;
-        case step_d:
-			do
+                unsigned char loTable[64],hiTable[64];
+                memcpy(loTable,table,64);memcpy(hiTable,table+64,64);
+                const uint8x16x4_t lo = Base64LoadTable(loTable);
+                const uint8x16x4_t hi = Base64LoadTable(hiTable);
+                const uint8x16_t offset = vdupq_n_u8(64);
+                while (s_end-s>=64)
+                {
+                    uint8x16x4_t in = vld4q_u8(s);
+                    uint8x16_t error = vdupq_n_u8(0);
+                    for (int i=0;i<4;i++)
+                    {
+                        // 0xFF for characters out of the alphabet, 0x80 for the 8 bits ones
+                        const uint8x16_t v = vqtbx4q_u8(vqtbl4q_u8(lo,in.val[i]),hi,vsubq_u8(in.val[i],offset));
+                        error = vorrq_u8(error,vorrq_u8(v,vandq_u8(in.val[i],vdupq_n_u8(0x80))));
+                        in.val[i] = v;
+                    }
+                    if (vmaxvq_u8(error)>63) break;
+                    uint8x16x3_t out;
+                    out.val[0] = vorrq_u8(vshlq_n_u8(in.val[0],2),vshrq_n_u8(in.val[1],4));
+                    out.val[1] = vorrq_u8(vshlq_n_u8(in.val[1],4),vshrq_n_u8(in.val[2],2));
+                    out.val[2] = vorrq_u8(vshlq_n_u8(in.val[2],6),in.val[3]);
+                    vst3q_u8(dst,out);
+                    s+=64;dst+=48;
+                }
+            }
+#endif
+            // Whole quads without skipped characters
+            while (s_end-s>=4)
             {
-				if (codechar == code_in+length_in)
-				{
-					state_in->step = step_d;
-					state_in->plainchar = *plainchar;
-					return plainchar - plaintext_out;
-				}
-				fragment = (char)base64_decode_value(*codechar++);
-			} while (fragment < 0);
-			*plainchar++   |= (fragment & 0x03f);
-		}
-	}
-	/* control should not reach here */
-	return plainchar - plaintext_out;
-}
-}	// extern "C"
-struct decoder
-{
-	base64_decodestate _state;
-	int _buffersize;
-	
-	decoder(int buffersize_in = 4096) : _buffersize(buffersize_in) {}
-	int decode(char value_in) {return base64_decode_value(value_in);}
-	int decode(const char* code_in, const int length_in, char* plaintext_out)	{return base64_decode_block(code_in, length_in, plaintext_out, &_state);}
-};
-
-// Encoder Here
-extern "C"
-{
-typedef enum {step_A, step_B, step_C} base64_encodestep;
-typedef struct {base64_encodestep step;char result;int stepcount;} base64_encodestate;
-
-const int CHARS_PER_LINE = 2147483647;//72; // This was hard coded to 72 originally. But here we add '\n' at a later step. So we use MAX_INT here.
-inline void base64_init_encodestate(base64_encodestate* state_in)
-{
-	state_in->step = step_A;
-	state_in->result = 0;
-	state_in->stepcount = 0;
-}
-inline char base64_encode_value(char value_in)
-{
-	static const char* encoding = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-	if (value_in > 63) return '=';
-	return encoding[(int)value_in];
-}
-inline int base64_encode_block(const char* plaintext_in, int length_in, char* code_out, base64_encodestate* state_in)
-{
-	const char* plainchar = plaintext_in;
-	const char* const plaintextend = plaintext_in + length_in;
-	char* codechar = code_out;
-    char result = '\0';
-    char fragment = '\0';
-	
-	result = state_in->result;
-	
-	switch (state_in->step)
-	{
-		while (1)
-		{
-        case step_A:
-			if (plainchar == plaintextend)
-			{
-				state_in->result = result;
-				state_in->step = step_A;
-				return codechar - code_out;
-			}
-			fragment = *plainchar++;
-			result = (fragment & 0x0fc) >> 2;
-			*codechar++ = base64_encode_value(result);
-			result = (fragment & 0x003) << 4;
-        case step_B:
-			if (plainchar == plaintextend)
-			{
-				state_in->result = result;
-				state_in->step = step_B;
-				return codechar - code_out;
-			}
-			fragment = *plainchar++;
-			result |= (fragment & 0x0f0) >> 4;
-			*codechar++ = base64_encode_value(result);
-			result = (fragment & 0x00f) << 2;
-        case step_C:
-			if (plainchar == plaintextend)
-			{
-				state_in->result = result;
-				state_in->step = step_C;
-				return codechar - code_out;
-			}
-			fragment = *plainchar++;
-			result |= (fragment & 0x0c0) >> 6;
-			*codechar++ = base64_encode_value(result);
-			result  = (fragment & 0x03f) >> 0;
-			*codechar++ = base64_encode_value(result);
-			
-			++(state_in->stepcount);
-			if (state_in->stepcount == CHARS_PER_LINE/4)
-			{
-				*codechar++ = '\n';
-				state_in->stepcount = 0;
-			}
-		}
-	}
-	/* control should not reach here */
-	return codechar - code_out;
-}
-
-inline int base64_encode_blockend(char* code_out, base64_encodestate* state_in)
-{
-	char* codechar = code_out;
-	
-	switch (state_in->step)
-	{
-	case step_B:
-		*codechar++ = base64_encode_value(state_in->result);
-		*codechar++ = '=';
-		*codechar++ = '=';
-		break;
-	case step_C:
-		*codechar++ = base64_encode_value(state_in->result);
-		*codechar++ = '=';
-		break;
-	case step_A:
-		break;
-	}
-	*codechar++ = '\n';
-	
-	return codechar - code_out;
-}	
-} // extern "C"
-struct encoder
-{
-	base64_encodestate _state;
-	int _buffersize;
-	
-	encoder(int buffersize_in = 4096)
-	: _buffersize(buffersize_in)
-	{}
-	int encode(char value_in)
-	{
-		return base64_encode_value(value_in);
-	}
-	int encode(const char* code_in, const int length_in, char* plaintext_out)
-	{
-		return base64_encode_block(code_in, length_in, plaintext_out, &_state);
-	}
-	int encode_end(char* plaintext_out)
-	{
-		return base64_encode_blockend(plaintext_out, &_state);
-	}
-};
-} // namespace base64
-
-namespace ImGui
-{
-namespace Stringifier
+                const int a = table[s[0]],b = table[s[1]],c = table[s[2]],d = table[s[3]];
+                if ((a|b|c|d)<0) break;
+                const ImU32 v = ((ImU32)a<<18) | ((ImU32)b<<12) | ((ImU32)c<<6) | (ImU32)d;
+                dst[0] = (unsigned char)(v>>16);dst[1] = (unsigned char)(v>>8);dst[2] = (unsigned char)v;
+                s+=4;dst+=3;
+            }
+            if (s==s_end) break;
+        }
+        const int v = table[*s++];
+        if (v<0) continue;
+        state.Bits = (state.Bits<<6) | (ImU32)v;
+        if (++state.NumChars==4)
+        {
+            dst[0] = (unsigned char)(state.Bits>>16);dst[1] = (unsigned char)(state.Bits>>8);dst[2] = (unsigned char)state.Bits;
+            dst+=3;state.Bits = 0;state.NumChars = 0;
+        }
+    }
+    return dst;
+}
+// Flushes an incomplete last quad ("xx==" or "xxx=")
+static unsigned char* Base64DecodeFinish(unsigned char* dst,Base64DecodeState& state)
 {
+    if (state.NumChars>=2) *dst++ = (unsigned char)(state.Bits>>(6*state.NumChars-8));
+    if (state.NumChars==3) *dst++ = (unsigned char)(state.Bits>>2);
+    state.Bits = 0;state.NumChars = 0;
+    return dst;
+}
+
 template <typename VectorChar> static bool Base64Decode(const char* input,VectorChar& output)
 {
     output.clear();if (!input) return false;
-    const int N = 4096;
-    base64::decoder d(N);
-    base64_init_decodestate(&d._state);
-
-    int outputStart=0,outputlength = 0;
-    int codelength = strlen(input);
-    const char* pIn = input;
-    int stepCodeLength = 0;
-    do
-    {
-        output.resize(outputStart+N);
-        stepCodeLength = codelength>=N?N:codelength;
-        outputlength = d.decode(pIn, stepCodeLength, &output[outputStart]);
-        outputStart+=outputlength;
-        pIn+=stepCodeLength;
-        codelength-=stepCodeLength;
-    }
-    while (codelength>0);
-
-    output.resize(outputStart);
-    //
-    base64_init_decodestate(&d._state);
+    const size_t len = strlen(input);
+    output.resize((int)Base64DecodedSizeBound(len));
+    Base64DecodeState state;
+    unsigned char* dst = (unsigned char*)&output[0];
+    dst = Base64DecodeFast(input,len,dst,state);
+    dst = Base64DecodeFinish(dst,state);
+    output.resize((int)(dst-(unsigned char*)&output[0]));
     return true;
 }
 
 template <typename VectorChar> static bool Base64Encode(const char* input,int inputSize,VectorChar& output)
 {
 	output.clear();if (!input || inputSize==0) return false;
-
-    const int N=4096;
-    base64::encoder e(N);
-    base64_init_encodestate(&e._state);
-
-    int outputStart=0,outputlength = 0;
-    int codelength = inputSize;
-    const char* pIn = input;
-    int stepCodeLength = 0;
-
-    do
-    {
-        output.resize(outputStart+2*N);
-        stepCodeLength = codelength>=N?N:codelength;
-        outputlength = e.encode(pIn, stepCodeLength,&output[outputStart]);
-        outputStart+=outputlength;
-        pIn+=stepCodeLength;
-        codelength-=stepCodeLength;
-    }
-    while (codelength>0);
-
-    output.resize(outputStart+2*N);
-    outputlength = e.encode_end(&output[outputStart]);
-    outputStart+=outputlength;
-    output.resize(outputStart);
-    //
-    base64_init_encodestate(&e._state);
-
+    output.resize((int)Base64EncodedSize((size_t)inputSize)+1);
+    char* end = Base64EncodeFast((const unsigned char*)input,(size_t)inputSize,&output[0]);
+    *end = '\n';
 	return true;
 }
 inline static unsigned int Decode85Byte(char c)   { return c >= '\\' ? c-36 : c-35; }
-static void Decode85(const unsigned char* src, unsigned char* dst)
+// Base85 needs a division by 85 per character: it stays scalar, but runs on raw pointers in an exactly sized output.
+// A last incomplete group decodes as if padded with zero digits.
+static void Decode85(const unsigned char* src, size_t len, unsigned char* dst)
 {
-    while (*src)
+    const unsigned char* src_end = src+len;
+    for (;src_end-src>=5;src+=5,dst+=4)
     {
-        unsigned int tmp = Decode85Byte(src[0]) + 85*(Decode85Byte(src[1]) + 85*(Decode85Byte(src[2]) + 85*(Decode85Byte(src[3]) + 85*Decode85Byte(src[4]))));
+        const unsigned int tmp = Decode85Byte(src[0]) + 85*(Decode85Byte(src[1]) + 85*(Decode85Byte(src[2]) + 85*(Decode85Byte(src[3]) + 85*Decode85Byte(src[4]))));
         dst[0] = ((tmp >> 0) & 0xFF); dst[1] = ((tmp >> 8) & 0xFF); dst[2] = ((tmp >> 16) & 0xFF); dst[3] = ((tmp >> 24) & 0xFF);   // We can't assume little-endianness.
-        src += 5;
-        dst += 4;
+    }
+    if (src<src_end)
+    {
+        unsigned int tmp = 0;
+        for (const unsigned char* p=src_end;p>src;) tmp = tmp*85 + Decode85Byte(*--p);
+        dst[0] = ((tmp >> 0) & 0xFF); dst[1] = ((tmp >> 8) & 0xFF); dst[2] = ((tmp >> 16) & 0xFF); dst[3] = ((tmp >> 24) & 0xFF);
     }
 }
 template <typename VectorChar> static bool Base85Decode(const char* input,VectorChar& output)
 {
 	output.clear();if (!input) return false;
-	const int outputSize = (((int)strlen(input) + 4) / 5) * 4;
+    const size_t len = strlen(input);
+	const int outputSize = (((int)len + 4) / 5) * 4;
 	output.resize(outputSize);
-    Decode85((const unsigned char*)input,(unsigned char*)&output[0]);
+    if (outputSize>0) Decode85((const unsigned char*)input,len,(unsigned char*)&output[0]);
     return true;
 }
 
@@ -2299,20 +2782,46 @@ inline static char Encode85Byte(unsigned int x)
     x = (x % 85) + 35;
     return (x>='\\') ? x+1 : x;
 }
+static char* Encode85(const unsigned char* src, size_t len, char* dst)
+{
+    for (size_t i=0;i<len;i+=4,dst+=5)
+    {
+        // A last incomplete group is padded with zeros
+        unsigned int d = src[i];
+        if (i+1<len) d |= (unsigned int)src[i+1]<<8;
+        if (i+2<len) d |= (unsigned int)src[i+2]<<16;
+        if (i+3<len) d |= (unsigned int)src[i+3]<<24;
+        dst[0] = Encode85Byte(d);d/=85;
+        dst[1] = Encode85Byte(d);d/=85;
+        dst[2] = Encode85Byte(d);d/=85;
+        dst[3] = Encode85Byte(d);d/=85;
+        dst[4] = Encode85Byte(d);
+    }
+    return dst;
+}
 template <typename VectorChar> static bool Base85Encode(const char* input,int inputSize,VectorChar& output,bool outputStringifiedMode,int numCharsPerLineInStringifiedMode=112)	
 {
     // Adapted from binary_to_compressed_c(...) inside imgui_draw.cpp
     output.clear();if (!input || inputSize==0) return false;
+    if (!outputStringifiedMode)
+    {
+        const int outputSize = (inputSize+3)/4*5;
+        output.resize(outputSize+1);
+        Encode85((const unsigned char*)input,(size_t)inputSize,&output[0]);
+        output[outputSize] = '\0';	// End character
+        return true;
+    }
     output.reserve((int)((float)inputSize*1.3f));
     if (numCharsPerLineInStringifiedMode<=12) numCharsPerLineInStringifiedMode = 12;
     if (outputStringifiedMode) output.push_back('"');
     char prev_c = 0;int cnt=0;
     for (int src_i = 0; src_i < inputSize; src_i += 4)
     {
-        unsigned int d = *(unsigned int*)(input + src_i);
-        for (unsigned int n5 = 0; n5 < 5; n5++, d /= 85)
+        char group[5];
+        Encode85((const unsigned char*)input+src_i,(size_t)(inputSize-src_i<4 ? inputSize-src_i : 4),group);
+        for (unsigned int n5 = 0; n5 < 5; n5++)
         {
-            char c = Encode85Byte(d);
+            char c = group[n5];
             if (outputStringifiedMode && c == '?' && prev_c == '?') output.push_back('\\');	// This is made a little more complicated by the fact that ??X sequences are interpreted as trigraphs by old C/C++ compilers. So we need to escape pairs of ??.
             output.push_back(c);
             prev_c = c;
@@ -2506,124 +3015,473 @@ bool TextStringify(const char* input, ImVector<char>& output, int numCharsPerLin
 #include <zlib.h>
 namespace ImGui
 {
-bool GzDecompressFromFile(const char* filePath,ImVector<char>& rv,bool clearRvBeforeUsage)
+//------------------------------------------------------------------------------
+// Streaming gzip
+//------------------------------------------------------------------------------
+static const int GzWindowSize = 32*1024;    // deflate window, used as dictionary between parallel blocks
+static inline bool IsBase85Char(unsigned char c) {return c>=35 && c<=120 && c!='\\';}
+static inline void PutLE32(unsigned char* p,ImU32 v) {p[0]=(unsigned char)v;p[1]=(unsigned char)(v>>8);p[2]=(unsigned char)(v>>16);p[3]=(unsigned char)(v>>24);}
+
+struct GzDecompressStreamState
 {
-    if (clearRvBeforeUsage) rv.clear();
-    ImVector<char> f_data;
-    if (!ImGuiHelper::GetFileContent(filePath,f_data,true,"rb",false)) return false;
-    //----------------------------------------------------
-    return GzDecompressFromMemory(&f_data[0],f_data.size(),rv,clearRvBeforeUsage);
-    //----------------------------------------------------
+    z_stream Z;
+    bool ZInit,MemberEnded,IgnoreTail,AnyMemberEnded,Error;
+    GzStreamWriteCallback WriteCb;void* UserPtr;
+    GzStreamEncoding Encoding;
+    Stringifier::Base64DecodeState B64;
+    unsigned char B85[5];int B85Count;
+    ImVector<char> Out;int OutUsed;      // bounded output chunk
+    ImVector<char> Decoded;int DecodedUsed;  // Base64/Base85 decoded bytes not yet inflated
+
+    bool FlushOutput()
+    {
+        if (OutUsed>0 && !Error && !WriteCb(Out.Data,OutUsed,UserPtr)) Error = true;
+        OutUsed = 0;
+        return !Error;
+    }
+    bool Inflate(const char* data,int size)
+    {
+        Z.next_in = (Bytef*)data;Z.avail_in = (uInt)size;
+        bool outputFull = false;
+        while (!Error && (Z.avail_in>0 || outputFull))
+        {
+            if (IgnoreTail) {Z.avail_in=0;break;}
+            if (MemberEnded)
+            {
+                if (Z.avail_in==0) break;
+                // Another gzip member, or the zero padding of a Base85 tail
+                if (*Z.next_in!=0x1f) {IgnoreTail=true;Z.avail_in=0;break;}
+                if (inflateReset(&Z)!=Z_OK) {Error=true;break;}
+                MemberEnded = false;
+            }
+            Z.next_out = (Bytef*)(Out.Data+OutUsed);Z.avail_out = (uInt)(Out.Size-OutUsed);
+            const int err = inflate(&Z,Z_NO_FLUSH);
+            OutUsed = Out.Size-(int)Z.avail_out;
+            if (err==Z_STREAM_END) MemberEnded = AnyMemberEnded = true;
+            else if (err!=Z_OK && err!=Z_BUF_ERROR) {Error=true;break;}
+            else if (err==Z_BUF_ERROR && Z.avail_in==0) break;
+            outputFull = Z.avail_out==0;
+            if (outputFull && !FlushOutput()) break;
+        }
+        return !Error;
+    }
+    bool FlushDecoded()
+    {
+        const bool ok = DecodedUsed==0 || Inflate(Decoded.Data,DecodedUsed);
+        DecodedUsed = 0;
+        return ok;
+    }
+};
+
+GzDecompressStream::GzDecompressStream(GzStreamWriteCallback writeCb,void* userPtr,GzStreamEncoding encoding,int outputChunkSize)
+{
+    State = IM_NEW(GzDecompressStreamState)();
+    GzDecompressStreamState& s = *State;
+    memset(&s.Z,0,sizeof(s.Z));
+    s.MemberEnded = s.IgnoreTail = s.AnyMemberEnded = false;
+    s.WriteCb = writeCb;s.UserPtr = userPtr;s.Encoding = encoding;
+    s.B85Count = 0;
+    s.Out.resize(outputChunkSize>=1024 ? outputChunkSize : 1024);s.OutUsed = 0;
+    if (encoding!=GzStreamEncoding_None) s.Decoded.resize(16*1024);
+    s.DecodedUsed = 0;
+    s.ZInit = inflateInit2(&s.Z,16+MAX_WBITS)==Z_OK;
+    s.Error = !s.ZInit || !writeCb;
 }
-bool GzBase64DecompressFromFile(const char* filePath,ImVector<char>& rv)
+GzDecompressStream::~GzDecompressStream()
 {
-    ImVector<char> f_data;
-    if (!ImGuiHelper::GetFileContent(filePath,f_data,true,"r",true)) return false;
-    return ImGui::GzBase64DecompressFromMemory(&f_data[0],rv);
+    if (State->ZInit) inflateEnd(&State->Z);
+    IM_DELETE(State);
 }
-bool GzBase85DecompressFromFile(const char* filePath,ImVector<char>& rv)
+bool GzDecompressStream::HasError() const {return State->Error;}
+bool GzDecompressStream::Push(const char* data,int size)
 {
-    ImVector<char> f_data;
-    if (!ImGuiHelper::GetFileContent(filePath,f_data,true,"r",true)) return false;
-    return ImGui::GzBase85DecompressFromMemory(&f_data[0],rv);
+    GzDecompressStreamState& s = *State;
+    if (s.Error) return false;
+    if (!data || size<=0) return true;
+    switch (s.Encoding)
+    {
+    case GzStreamEncoding_Base64:
+    {
+        // Keeps the room of Base64DecodedSizeBound()
+        const int maxCodeLength = (s.Decoded.Size-19)/3*4;
+        unsigned char* decoded = (unsigned char*)s.Decoded.Data;
+        for (int pos=0;pos<size && !s.Error;pos+=maxCodeLength)
+        {
+            const int length = size-pos<maxCodeLength ? size-pos : maxCodeLength;
+            s.DecodedUsed = (int)(Stringifier::Base64DecodeFast(data+pos,(size_t)length,decoded,s.B64)-decoded);
+            s.FlushDecoded();
+        }
+    }
+    break;
+    case GzStreamEncoding_Base85:
+    {
+        const unsigned char* p = (const unsigned char*)data;
+        const unsigned char* p_end = p+size;
+        while (p<p_end && !s.Error)
+        {
+            if (s.B85Count==0)
+            {
+                // Whole groups of a run of valid characters are decoded in one go
+                const unsigned char* run = p;
+                const unsigned char* run_max = p+(s.Decoded.Size-s.DecodedUsed)/4*5;
+                if (run_max>p_end) run_max = p_end;
+                while (run<run_max && IsBase85Char(*run)) ++run;
+                const int numGroups = (int)(run-p)/5;
+                if (numGroups>0)
+                {
+                    Stringifier::Decode85(p,(size_t)numGroups*5,(unsigned char*)s.Decoded.Data+s.DecodedUsed);
+                    s.DecodedUsed+=numGroups*4;p+=numGroups*5;
+                    if (s.DecodedUsed+4>s.Decoded.Size) s.FlushDecoded();
+                    continue;
+                }
+            }
+            const unsigned char c = *p++;
+            if (!IsBase85Char(c)) continue;
+            s.B85[s.B85Count++] = c;
+            if (s.B85Count<5) continue;
+            s.B85Count = 0;
+            Stringifier::Decode85(s.B85,5,(unsigned char*)s.Decoded.Data+s.DecodedUsed);
+            s.DecodedUsed+=4;
+            if (s.DecodedUsed+4>s.Decoded.Size) s.FlushDecoded();
+        }
+        s.FlushDecoded();
+    }
+    break;
+    default:
+        s.Inflate(data,size);
+    break;
+    }
+    return !s.Error;
 }
-
-bool GzDecompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage)
+bool GzDecompressStream::Pull(GzStreamReadCallback readCb,void* readUserPtr)
 {
-    if (clearRvBeforeUsage) rv.clear();
-    const int startRv = rv.size();
-
-    if (memoryBufferSize == 0  || !memoryBuffer) return false;
-    const int memoryChunk = memoryBufferSize > (16*1024) ? (16*1024) : memoryBufferSize;
-    rv.resize(startRv+memoryChunk);  // we start using the memoryChunk length
-
-    z_stream myZStream;
-    myZStream.next_in = (Bytef *) memoryBuffer;
-    myZStream.avail_in = memoryBufferSize;
-    myZStream.total_out = 0;
-    myZStream.zalloc = Z_NULL;
-    myZStream.zfree = Z_NULL;
+    if (!readCb) return false;
+    ImVector<char> buffer;buffer.resize(64*1024);
+    int n = 0;
+    while (!State->Error && (n = readCb(buffer.Data,buffer.Size,readUserPtr))>0) Push(buffer.Data,n);
+    if (n<0) State->Error = true;
+    return !State->Error;
+}
+bool GzDecompressStream::Finish()
+{
+    GzDecompressStreamState& s = *State;
+    if (s.Encoding==GzStreamEncoding_Base64 && !s.Error)
+    {
+        // Incomplete last quad
+        unsigned char* decoded = (unsigned char*)s.Decoded.Data;
+        s.DecodedUsed = (int)(Stringifier::Base64DecodeFinish(decoded,s.B64)-decoded);
+        s.FlushDecoded();
+    }
+    s.FlushOutput();
+    return !s.Error && s.AnyMemberEnded && s.MemberEnded;
+}
 
-    bool done = false;
-    if (inflateInit2(&myZStream, (16+MAX_WBITS)) == Z_OK)
+struct GzCompressBlock
+{
+    const char* In;int InSize;
+    const char* Dict;int DictSize;
+    bool Last,Ok;
+    uLong Crc;
+    ImVector<char> Out;
+};
+static void GzCompressBlockProc(GzCompressBlock* b,int level)
+{
+    b->Ok = false;
+    b->Crc = crc32(crc32(0L,Z_NULL,0),(const Bytef*)b->In,(uInt)b->InSize);
+    z_stream z;memset(&z,0,sizeof(z));
+    // Raw deflate: the gzip header and trailer are written once for the whole stream
+    if (deflateInit2(&z,level,Z_DEFLATED,-MAX_WBITS,8,Z_DEFAULT_STRATEGY)!=Z_OK) return;
+    if (b->DictSize>0) deflateSetDictionary(&z,(const Bytef*)b->Dict,(uInt)b->DictSize);
+    b->Out.resize((int)deflateBound(&z,(uLong)b->InSize)+16);   // +16: the sync flush marker
+    z.next_in = (Bytef*)b->In;z.avail_in = (uInt)b->InSize;
+    z.next_out = (Bytef*)b->Out.Data;z.avail_out = (uInt)b->Out.Size;
+    // Z_SYNC_FLUSH ends the block on a byte boundary, so the next one can be appended as is
+    const int err = deflate(&z,b->Last ? Z_FINISH : Z_SYNC_FLUSH);
+    b->Ok = (b->Last ? err==Z_STREAM_END : err==Z_OK) && z.avail_in==0;
+    b->Out.resize(b->Ok ? (int)z.total_out : 0);
+    deflateEnd(&z);
+}
+
+struct GzCompressStreamState
+{
+    GzStreamWriteCallback WriteCb;void* UserPtr;
+    GzStreamEncoding Encoding;
+    int NumThreads,Level,BlockSize,OutputChunkSize;
+    ImVector<char> In;int DictSize;     // In starts with the last DictSize bytes of the previous batch
+    std::vector<GzCompressBlock> Blocks;
+    uLong Crc,TotalIn;
+    bool HeaderWritten,Finished,Error;
+    unsigned char Carry[4];int CarryCount;  // incomplete Base64/Base85 group
+    ImVector<char> Encoded;int EncodedUsed;
+
+    bool Write(const char* data,int size)
+    {
+        if (!Error && size>0 && !WriteCb(data,size,UserPtr)) Error = true;
+        return !Error;
+    }
+    bool FlushEncoded()
+    {
+        const bool ok = Write(Encoded.Data,EncodedUsed);
+        EncodedUsed = 0;
+        return ok;
+    }
+    // 'size' is a multiple of the group size, except for the last call
+    bool Encode(const unsigned char* data,int size)
+    {
+        char* end = Encoding==GzStreamEncoding_Base64 ? Stringifier::Base64EncodeFast(data,(size_t)size,Encoded.Data) : Stringifier::Encode85(data,(size_t)size,Encoded.Data);
+        EncodedUsed = (int)(end-Encoded.Data);
+        return FlushEncoded();
+    }
+    // Compressed bytes go through here
+    bool Emit(const char* data,int size)
+    {
+        if (Encoding==GzStreamEncoding_None)
+        {
+            for (int pos=0;pos<size && !Error;pos+=OutputChunkSize) Write(data+pos,size-pos<OutputChunkSize ? size-pos : OutputChunkSize);
+            return !Error;
+        }
+        const int group = Encoding==GzStreamEncoding_Base64 ? 3 : 4;
+        while (CarryCount>0 && size>0)
+        {
+            Carry[CarryCount++] = (unsigned char)*data++;--size;
+            if (CarryCount==group) {CarryCount = 0;Encode(Carry,group);}
+        }
+        // Slices of whole groups that fit in Encoded
+        const int maxLength = Encoded.Size/5*group;
+        while (size>=group && !Error)
+        {
+            const int length = size<maxLength ? size/group*group : maxLength;
+            Encode((const unsigned char*)data,length);
+            data+=length;size-=length;
+        }
+        for (;size>0;--size) Carry[CarryCount++] = (unsigned char)*data++;
+        return !Error;
+    }
+    bool CompressBatch(bool last)
     {
-        int err = Z_OK;
-        while (!done)
+        if (!HeaderWritten)
         {
-            if (myZStream.total_out >= (uLong)(rv.size()-startRv)) rv.resize(rv.size()+memoryChunk);    // not enough space: we add the memoryChunk each step
-
-            myZStream.next_out = (Bytef *) (&rv[startRv] + myZStream.total_out);
-            myZStream.avail_out = rv.size() - startRv - myZStream.total_out;
-
-            if ((err = inflate (&myZStream, Z_SYNC_FLUSH))==Z_STREAM_END) done = true;
-            else if (err != Z_OK)  break;
+            const unsigned char header[10] = {0x1f,0x8b,8,0,0,0,0,0,(unsigned char)(Level>=9 ? 2 : (Level==1 ? 4 : 0)),3};
+            HeaderWritten = true;
+            if (!Emit((const char*)header,10)) return false;
+        }
+        const int pending = In.Size-DictSize;
+        int numBlocks = (pending+BlockSize-1)/BlockSize;
+        if (numBlocks==0 && !last) return true;
+        if (numBlocks==0) numBlocks = 1;    // an empty final block ends the deflate stream
+        Blocks.resize(numBlocks);
+        for (int i=0;i<numBlocks;i++)
+        {
+            GzCompressBlock& b = Blocks[i];
+            const int start = DictSize+i*BlockSize;
+            b.In = In.Data+start;
+            b.InSize = pending-i*BlockSize<BlockSize ? pending-i*BlockSize : BlockSize;
+            b.DictSize = start<GzWindowSize ? start : GzWindowSize;
+            b.Dict = b.In-b.DictSize;
+            b.Last = last && i==numBlocks-1;
         }
-        if ((err=inflateEnd(&myZStream))!= Z_OK) done = false;
+        if (numBlocks>1 && NumThreads>1)
+        {
+            std::vector<std::thread> threads;
+            for (int i=1;i<numBlocks;i++) threads.push_back(std::thread(GzCompressBlockProc,&Blocks[i],Level));
+            GzCompressBlockProc(&Blocks[0],Level);
+            for (auto& t : threads) t.join();
+        }
+        else for (int i=0;i<numBlocks;i++) GzCompressBlockProc(&Blocks[i],Level);
+        for (int i=0;i<numBlocks && !Error;i++)
+        {
+            GzCompressBlock& b = Blocks[i];
+            if (!b.Ok) {Error=true;break;}
+            Crc = crc32_combine(Crc,b.Crc,(z_off_t)b.InSize);
+            TotalIn += (uLong)b.InSize;
+            Emit(b.Out.Data,b.Out.Size);
+            b.Out.clear();
+        }
+        // Keep the end of this batch as the dictionary of the next one
+        const int keep = In.Size<GzWindowSize ? In.Size : GzWindowSize;
+        memmove(In.Data,In.Data+In.Size-keep,(size_t)keep);
+        In.resize(keep);DictSize = keep;
+        return !Error;
     }
-    rv.resize(startRv+(done ? myZStream.total_out : 0));
+};
 
-    return done;
+GzCompressStream::GzCompressStream(GzStreamWriteCallback writeCb,void* userPtr,GzStreamEncoding encoding,int numThreads,int level,int blockSize,int outputChunkSize)
+{
+    State = IM_NEW(GzCompressStreamState)();
+    GzCompressStreamState& s = *State;
+    s.WriteCb = writeCb;s.UserPtr = userPtr;s.Encoding = encoding;
+    if (numThreads<=0) numThreads = (int)std::thread::hardware_concurrency();
+    s.NumThreads = numThreads>0 ? numThreads : 1;
+    s.Level = (level<0 || level>9) ? Z_DEFAULT_COMPRESSION : level;
+    s.BlockSize = blockSize>=GzWindowSize ? blockSize : GzWindowSize;
+    s.OutputChunkSize = outputChunkSize>=1024 ? outputChunkSize : 1024;
+    s.In.reserve(GzWindowSize+s.NumThreads*s.BlockSize);s.DictSize = 0;
+    s.Crc = crc32(0L,Z_NULL,0);s.TotalIn = 0;
+    s.HeaderWritten = s.Finished = false;
+    s.Error = !writeCb;
+    s.CarryCount = 0;
+    if (encoding!=GzStreamEncoding_None) s.Encoded.resize(s.OutputChunkSize);
+    s.EncodedUsed = 0;
+}
+GzCompressStream::~GzCompressStream() {IM_DELETE(State);}
+bool GzCompressStream::HasError() const {return State->Error;}
+bool GzCompressStream::Push(const char* data,int size)
+{
+    GzCompressStreamState& s = *State;
+    if (s.Error || s.Finished) return false;
+    if (!data || size<=0) return true;
+    const int batchSize = s.NumThreads*s.BlockSize;
+    while (size>0 && !s.Error)
+    {
+        const int room = batchSize-(s.In.Size-s.DictSize);
+        const int n = size<room ? size : room;
+        const int start = s.In.Size;
+        s.In.resize(start+n);
+        memcpy(s.In.Data+start,data,(size_t)n);
+        data+=n;size-=n;
+        if (s.In.Size-s.DictSize==batchSize) s.CompressBatch(false);
+    }
+    return !s.Error;
+}
+bool GzCompressStream::Pull(GzStreamReadCallback readCb,void* readUserPtr)
+{
+    if (!readCb) return false;
+    ImVector<char> buffer;buffer.resize(64*1024);
+    int n = 0;
+    while (!State->Error && (n = readCb(buffer.Data,buffer.Size,readUserPtr))>0) Push(buffer.Data,n);
+    if (n<0) State->Error = true;
+    return !State->Error;
+}
+bool GzCompressStream::Finish()
+{
+    GzCompressStreamState& s = *State;
+    if (s.Error || s.Finished) return false;
+    s.Finished = true;
+    if (!s.CompressBatch(true)) return false;
+    unsigned char trailer[8];
+    PutLE32(trailer,(ImU32)s.Crc);PutLE32(trailer+4,(ImU32)s.TotalIn);
+    s.Emit((const char*)trailer,8);
+    if (s.Encoding!=GzStreamEncoding_None)
+    {
+        // Padded last group
+        if (s.CarryCount>0) s.Encode(s.Carry,s.CarryCount);
+        if (s.Encoding==GzStreamEncoding_Base64) s.Write("\n",1);
+    }
+    return !s.Error;
+}
+
+static bool GzAppendToVector(const char* data,int size,void* userPtr)
+{
+    ImVector<char>& rv = *(ImVector<char>*)userPtr;
+    const int start = rv.size();
+    rv.resize(start+size);
+    memcpy(&rv[start],data,(size_t)size);
+    return true;
 }
-bool GzCompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage) 
+static int GzReadFromFile(char* data,int maxSize,void* userPtr)
+{
+    FILE* f = (FILE*)userPtr;
+    const size_t n = fread(data,1,(size_t)maxSize,f);
+    return (n==0 && ferror(f)) ? -1 : (int)n;
+}
+// The gzip trailer ends with the uncompressed size (modulo 4GB), a good hint to reserve the output once
+static void GzReserveFromTrailer(const unsigned char* trailer,ImVector<char>& rv)
+{
+    const ImU32 size = (ImU32)trailer[0] | ((ImU32)trailer[1]<<8) | ((ImU32)trailer[2]<<16) | ((ImU32)trailer[3]<<24);
+    if (size>0 && size<(1u<<30)) rv.reserve(rv.size()+(int)size);
+}
+static bool GzDecompressFromFile(const char* filePath,const char* mode,GzStreamEncoding encoding,ImVector<char>& rv)
 {
-    if (clearRvBeforeUsage) rv.clear();
     const int startRv = rv.size();
-
-    if (memoryBufferSize == 0  || !memoryBuffer) return false;
-    const int memoryChunk = memoryBufferSize/3 > (16*1024) ? (16*1024) : memoryBufferSize/3;
-    rv.resize(startRv+memoryChunk);  // we start using the memoryChunk length
-
-    z_stream myZStream;
-    myZStream.next_in =  (Bytef *) memoryBuffer;
-    myZStream.avail_in = memoryBufferSize;
-    myZStream.total_out = 0;
-    myZStream.zalloc = Z_NULL;
-    myZStream.zfree = Z_NULL;
-
-    bool done = false;
-    if (deflateInit2(&myZStream,Z_BEST_COMPRESSION,Z_DEFLATED,(16+MAX_WBITS),8,Z_DEFAULT_STRATEGY) == Z_OK)
+    FILE* f = filePath ? (FILE*)ImFileOpen(filePath,mode) : NULL;
+    if (!f) return false;
+    if (encoding==GzStreamEncoding_None)
     {
-        int err = Z_OK;
-        while (!done)
-        {
-            if (myZStream.total_out >= (uLong)(rv.size()-startRv)) rv.resize(rv.size()+memoryChunk);    // not enough space: we add the full memoryChunk each step
-
-            myZStream.next_out = (Bytef *) (&rv[startRv] + myZStream.total_out);
-            myZStream.avail_out = rv.size() - startRv - myZStream.total_out;
-
-            if ((err = deflate (&myZStream, Z_FINISH))==Z_STREAM_END) done = true;
-            else if (err != Z_OK)  break;
-        }
-        if ((err=deflateEnd(&myZStream))!= Z_OK) done=false;
+        unsigned char trailer[4];
+        if (fseek(f,-4,SEEK_END)==0 && fread(trailer,1,4,f)==4) GzReserveFromTrailer(trailer,rv);
+        if (fseek(f,0,SEEK_SET)!=0) {fclose(f);return false;}
     }
-    rv.resize(startRv+(done ? myZStream.total_out : 0));
+    GzDecompressStream stream(GzAppendToVector,&rv,encoding);
+    const bool done = stream.Pull(GzReadFromFile,f) && stream.Finish();
+    fclose(f);
+    if (!done) rv.resize(startRv);
+    return done;
+}
+
+bool GzDecompressFromFile(const char* filePath,ImVector<char>& rv,bool clearRvBeforeUsage)
+{
+    if (clearRvBeforeUsage) rv.clear();
+    return GzDecompressFromFile(filePath,"rb",GzStreamEncoding_None,rv);
+}
+bool GzBase64DecompressFromFile(const char* filePath,ImVector<char>& rv)
+{
+    rv.clear();
+    return GzDecompressFromFile(filePath,"r",GzStreamEncoding_Base64,rv);
+}
+bool GzBase85DecompressFromFile(const char* filePath,ImVector<char>& rv)
+{
+    rv.clear();
+    return GzDecompressFromFile(filePath,"r",GzStreamEncoding_Base85,rv);
+}
 
+static bool GzDecompressFromMemory(const char* memoryBuffer,int memoryBufferSize,GzStreamEncoding encoding,ImVector<char>& rv)
+{
+    const int startRv = rv.size();
+    if (memoryBufferSize<=0 || !memoryBuffer) return false;
+    if (encoding==GzStreamEncoding_None && memoryBufferSize>=18) GzReserveFromTrailer((const unsigned char*)memoryBuffer+memoryBufferSize-4,rv);
+    GzDecompressStream stream(GzAppendToVector,&rv,encoding);
+    const bool done = stream.Push(memoryBuffer,memoryBufferSize) && stream.Finish();
+    if (!done) rv.resize(startRv);
     return done;
 }
+bool GzDecompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage)
+{
+    if (clearRvBeforeUsage) rv.clear();
+    return GzDecompressFromMemory(memoryBuffer,memoryBufferSize,GzStreamEncoding_None,rv);
+}
+static bool GzCompressFromMemory(const char* memoryBuffer,int memoryBufferSize,GzStreamEncoding encoding,int numThreads,ImVector<char>& rv)
+{
+    const int startRv = rv.size();
+    if (memoryBufferSize<=0 || !memoryBuffer) return false;
+    GzCompressStream stream(GzAppendToVector,&rv,encoding,numThreads,Z_BEST_COMPRESSION);
+    const bool done = stream.Push(memoryBuffer,memoryBufferSize) && stream.Finish();
+    if (!done) rv.resize(startRv);
+    return done;
+}
+bool GzCompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage,int numThreads)
+{
+    if (clearRvBeforeUsage) rv.clear();
+    return GzCompressFromMemory(memoryBuffer,memoryBufferSize,GzStreamEncoding_None,numThreads,rv);
+}
 
 bool GzBase64DecompressFromMemory(const char* input,ImVector<char>& rv)
 {
-    rv.clear();ImVector<char> v;
-    if (ImGui::Base64Decode(input,v)) return false;
-    if (v.size()==0) return false;
-    return GzDecompressFromMemory(&v[0],v.size(),rv);
+    rv.clear();
+    return input && GzDecompressFromMemory(input,(int)strlen(input),GzStreamEncoding_Base64,rv);
 }
 bool GzBase85DecompressFromMemory(const char* input,ImVector<char>& rv)
 {
-    rv.clear();ImVector<char> v;
-    if (ImGui::Base85Decode(input,v)) return false;
-    if (v.size()==0) return false;
-    return GzDecompressFromMemory(&v[0],v.size(),rv);
+    rv.clear();
+    return input && GzDecompressFromMemory(input,(int)strlen(input),GzStreamEncoding_Base85,rv);
 }
 bool GzBase64CompressFromMemory(const char* input,int inputSize,ImVector<char>& output,bool stringifiedMode,int numCharsPerLineInStringifiedMode)
 {
-    output.clear();ImVector<char> output1;
+    output.clear();
+    if (!stringifiedMode) return GzCompressFromMemory(input,inputSize,GzStreamEncoding_Base64,1,output);
+    ImVector<char> output1;
     if (!ImGui::GzCompressFromMemory(input,inputSize,output1)) return false;
     return ImGui::Base64Encode(&output1[0],output1.size(),output,stringifiedMode,numCharsPerLineInStringifiedMode);
 }
 bool GzBase85CompressFromMemory(const char* input,int inputSize,ImVector<char>& output,bool stringifiedMode,int numCharsPerLineInStringifiedMode)
 {
-    output.clear();ImVector<char> output1;
+    output.clear();
+    if (!stringifiedMode)
+    {
+        if (!GzCompressFromMemory(input,inputSize,GzStreamEncoding_Base85,1,output)) return false;
+        output.push_back('\0');	// End character
+        return true;
+    }
+    ImVector<char> output1;
     if (!ImGui::GzCompressFromMemory(input,inputSize,output1)) return false;
     return ImGui::Base85Encode(&output1[0],output1.size(),output,stringifiedMode,numCharsPerLineInStringifiedMode);
 }
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <algorithm>
 #if !defined(__EMSCRIPTEN__)
 #include <openssl/evp.h>
@@ -91,11 +92,57 @@ IMGUI_API bool GzDecompressFromFile(const char* filePath,ImVector<char>& rv,bool
 IMGUI_API bool GzBase64DecompressFromFile(const char* filePath,ImVector<char>& rv);
 IMGUI_API bool GzBase85DecompressFromFile(const char* filePath,ImVector<char>& rv);
 IMGUI_API bool GzDecompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage=true);
-IMGUI_API bool GzCompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage=true);
+IMGUI_API bool GzCompressFromMemory(const char* memoryBuffer,int memoryBufferSize,ImVector<char>& rv,bool clearRvBeforeUsage=true,int numThreads=1);
 IMGUI_API bool GzBase64DecompressFromMemory(const char* input,ImVector<char>& rv);
 IMGUI_API bool GzBase85DecompressFromMemory(const char* input,ImVector<char>& rv);
 IMGUI_API bool GzBase64CompressFromMemory(const char* input,int inputSize,ImVector<char>& output,bool stringifiedMode=false,int numCharsPerLineInStringifiedMode=112);
 IMGUI_API bool GzBase85CompressFromMemory(const char* input,int inputSize,ImVector<char>& output,bool stringifiedMode=false,int numCharsPerLineInStringifiedMode=112);
+
+// Streaming gzip: the input is pushed in chunks (or pulled through a read callback) and the output is handed to a
+// write callback at most 'outputChunkSize' bytes at a time, so neither side of the stream is ever held as a whole.
+// With an encoding, the compressed side of the stream is Base64/Base85 text, encoded and decoded on the fly.
+// Base85 decoding skips anything outside of the Base85 alphabet, so stringified sources can be pushed as they are.
+enum GzStreamEncoding
+{
+    GzStreamEncoding_None = 0,
+    GzStreamEncoding_Base64,
+    GzStreamEncoding_Base85
+};
+typedef bool (*GzStreamWriteCallback)(const char* data,int size,void* userPtr);  // return false to abort the stream
+typedef int (*GzStreamReadCallback)(char* data,int maxSize,void* userPtr);       // return the number of bytes read, 0 at the end, -1 on error
+struct GzDecompressStreamState;
+struct GzCompressStreamState;
+class IMGUI_API GzDecompressStream
+{
+public:
+    GzDecompressStream(GzStreamWriteCallback writeCb,void* userPtr,GzStreamEncoding encoding=GzStreamEncoding_None,int outputChunkSize=64*1024);
+    ~GzDecompressStream();
+    bool Push(const char* data,int size);
+    bool Pull(GzStreamReadCallback readCb,void* readUserPtr);  // Push() until readCb returns 0
+    bool Finish();                                              // flushes the output, true if the gzip stream was complete
+    bool HasError() const;
+private:
+    GzDecompressStream(const GzDecompressStream&);
+    GzDecompressStream& operator=(const GzDecompressStream&);
+    GzDecompressStreamState* State;
+};
+// With numThreads!=1 (<=0: one per core) the input is cut into 'blockSize' blocks deflated in parallel, each one primed
+// with the last 32KB of the previous block as pigz does: the output is still a single, standard gzip member.
+// At most numThreads*blockSize bytes of input are buffered.
+class IMGUI_API GzCompressStream
+{
+public:
+    GzCompressStream(GzStreamWriteCallback writeCb,void* userPtr,GzStreamEncoding encoding=GzStreamEncoding_None,int numThreads=1,int level=9,int blockSize=128*1024,int outputChunkSize=64*1024);
+    ~GzCompressStream();
+    bool Push(const char* data,int size);
+    bool Pull(GzStreamReadCallback readCb,void* readUserPtr);
+    bool Finish();                                              // writes the gzip trailer (and the Base64/Base85 tail)
+    bool HasError() const;
+private:
+    GzCompressStream(const GzCompressStream&);
+    GzCompressStream& operator=(const GzCompressStream&);
+    GzCompressStreamState* State;
+};
 #endif //IMGUI_USE_ZLIB
 
 // IMPORTANT: FT_INT,FT_UNSIGNED,FT_FLOAT,FT_DOUBLE,FT_BOOL support from 1 to 4 components.
@@ -376,6 +423,8 @@ IMGUI_API std::string exec_path();
 IMGUI_API bool create_directory(const std::string& path);
 // get the OS dependent path where to store settings
 IMGUI_API std::string settings_path(std::string app_name);
+// get the OS dependent path where to store cache files of 'app_name' (getCacheDir()/app_name/cache/), created if missing, empty on failure
+IMGUI_API std::string cache_path(std::string app_name);
 // get the OS dependent path where to store temporary files
 IMGUI_API std::string temp_path();
 // try to execute a command
@@ -472,18 +521,28 @@ IMGUI_API std::string getVideoFolder();
 
 IMGUI_API std::string MillisecToString(int64_t millisec, int show_millisec = 0);
 
+// Binary mode (Serializer(...,true)): versioned, little-endian, one length-prefixed record per field, 8 bytes aligned so that
+// values are served in place by the Deserializer. The Deserializer detects the format by itself, so the same ParseCallback
+// reads both. In binary mode a memory mapped file is parsed without any copy and fields can be fetched by name with find().
 class IMGUI_API Deserializer {
     char* f_data;
     size_t f_size;
+    bool f_mapped;
+    mutable ImGuiStorage f_index;   // field name hash -> record offset+1 (binary mode only), built on first find()
+    mutable bool f_indexBuilt;
     void clear();
     bool loadFromFile(const char* filename);
     bool allocate(size_t sizeToAllocate,const char* optionalTextToCopy=NULL,size_t optionalTextToCopySize=0);
+    const char* parseBinary(bool (*cb)(FieldType,int,void*,const char*,void*),void* userPtr,const char* optionalBufferStart) const;
+    void buildIndex() const;
     public:
-    IMGUI_API Deserializer() : f_data(NULL),f_size(0) {}
+    IMGUI_API Deserializer() : f_data(NULL),f_size(0),f_mapped(false),f_indexBuilt(false) {}
     IMGUI_API Deserializer(const char* filename);                     // From file
     IMGUI_API Deserializer(const char* text,size_t textSizeInBytes);  // From memory (and optionally from file through GetFileContent(...))
     IMGUI_API ~Deserializer() {clear();}
     IMGUI_API bool isValid() const {return (f_data && f_size>0);}
+    IMGUI_API bool isBinary() const;
+    IMGUI_API bool mapFile(const char* filename);                     // Binary files are memory mapped read-only and parsed in place (callbacks must not write to pValue), text files are loaded as usual
 
     // returns whether to stop parsing or not
     typedef bool (*ParseCallback)(FieldType ft,int numArrayElements,void* pValue,const char* name,void* userPtr);   // (*)
@@ -491,6 +550,10 @@ class IMGUI_API Deserializer {
     // returned value can be refeed as optionalBufferStart
     const char *parse(ParseCallback cb,void* userPtr,const char* optionalBufferStart=NULL) const;
 
+    // Binary mode only: returns the value of the (first) field called 'name', laid out as served to ParseCallback, or NULL.
+    // FT_TEXTLINE and FT_CUSTOM return the first line, the following ones are packed after it, each one zero terminated.
+    IMGUI_API const void* find(const char* name,FieldType* pFieldTypeOut=NULL,int* pNumArrayElementsOut=NULL) const;
+
     // (*)
     /*
     FT_CUSTOM and FT_TEXTLINE are served multiple times (one per text line) with numArrayElements that goes from 0 to numTextLines-1.
@@ -506,13 +569,17 @@ class ISerializable;
 class Serializer {
 
     ISerializable* f;
+    bool binary;
     void clear();
 
     public:
     IMGUI_API Serializer(const char* filename);               // To file
     IMGUI_API Serializer(int memoryBufferCapacity=2048);      // To memory (and optionally to file through WriteBufferToFile(...))
+    IMGUI_API Serializer(const char* filename,bool binaryMode);
+    IMGUI_API Serializer(int memoryBufferCapacity,bool binaryMode);
     IMGUI_API ~Serializer();
     bool isValid() const {return (f);}
+    bool isBinary() const {return binary;}
 
     IMGUI_API bool save(FieldType ft, const float* pValue, const char* name, int numArrayElements=1,int prec=3);
     IMGUI_API bool save(FieldType ft, const int* pValue, const char* name, int numArrayElements=1,int prec=-1);
@@ -529,7 +596,7 @@ class Serializer {
     IMGUI_API bool saveTextLines(const char* pValue,const char* name); // Splits the string into N lines: each line is passed by the deserializer into a single element in the callback
     IMGUI_API bool saveTextLines(int numValues,bool (*items_getter)(void* data, int idx, const char** out_text),void* data,const char* name);
 
-    // To serialize FT_CUSTOM:
+    // To serialize FT_CUSTOM (text mode only):
     IMGUI_API bool saveCustomFieldTypeHeader(const char* name, int numTextLines=1); //e.g. for 4 lines "[CUSTOM-4:MyCustomFieldTypeName]\n". Then add 4 lines using getPointer() below.
 
     // These 2 are only available when this class is constructed with the
@@ -561,6 +628,14 @@ IMGUI_API void ThemeGenerator(const char* name, bool* p_open = NULL, ImGuiWindow
 class Encrypt {
 private:
     Encrypt() {}
+    ~Encrypt()
+    {
+        for (auto& it : m_contexts)
+        {
+            EVP_CIPHER_CTX_free(it.second.enc);
+            EVP_CIPHER_CTX_free(it.second.dec);
+        }
+    }
 
 public:
     static Encrypt& Instance() {
@@ -571,216 +646,180 @@ public:
     Encrypt(const Encrypt&) = delete;
     Encrypt& operator=(const Encrypt&) = delete;
 
-    size_t encrypt(const uint8_t *in, uint8_t **out, size_t size, uint8_t * passwd)
+    // Contexts initialized with the key and iv of a password. The key derivation and the AES key schedule are done
+    // once per password, operations copy these contexts (thread safe, the returned context must not be modified).
+    const EVP_CIPHER_CTX* context(const uint8_t * passwd, bool decrypt)
     {
-        int ret = 0;
-        if (!in || !out)
-            return 0;
-
-        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-        if (!ctx)
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_contexts.find((const char *)passwd);
+        if (it == m_contexts.end())
         {
-            throw std::runtime_error("Failed to create cipher context");
+            unsigned char key[EVP_MAX_KEY_LENGTH];
+            unsigned char iv[EVP_MAX_IV_LENGTH];
+            if (EVP_BytesToKey(EVP_aes_256_cbc(), EVP_get_digestbyname("md5"), salt, passwd, strlen((const char *)passwd), 1, key, iv) <= 0)
+                throw std::runtime_error("Failed to get key");
+            Contexts contexts;
+            contexts.enc = EVP_CIPHER_CTX_new();
+            contexts.dec = EVP_CIPHER_CTX_new();
+            if (!contexts.enc || !contexts.dec ||
+                EVP_EncryptInit_ex(contexts.enc, EVP_aes_256_cbc(), NULL, key, iv) != 1 ||
+                EVP_DecryptInit_ex(contexts.dec, EVP_aes_256_cbc(), NULL, key, iv) != 1)
+            {
+                EVP_CIPHER_CTX_free(contexts.enc);
+                EVP_CIPHER_CTX_free(contexts.dec);
+                throw std::runtime_error("Failed to initialize cipher context");
+            }
+            it = m_contexts.emplace((const char *)passwd, contexts).first;
         }
+        return decrypt ? it->second.dec : it->second.enc;
+    }
 
-        int key_len = 0;
-        if ((key_len = EVP_BytesToKey(EVP_aes_256_cbc(), EVP_get_digestbyname("md5"), salt, passwd, strlen((const char *)passwd), 1, key, iv)) <= 0)
+    // Chunked encryption/decryption, for data that doesn't fit in memory at once.
+    // update() writes at most size + EVP_MAX_BLOCK_LENGTH bytes, finish() at most EVP_MAX_BLOCK_LENGTH (the padding block).
+    class Stream
+    {
+    public:
+        Stream(const uint8_t * passwd, bool decrypt) : m_decrypt(decrypt)
         {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to get key");
+            m_ctx = EVP_CIPHER_CTX_new();
+            if (!m_ctx)
+                throw std::runtime_error("Failed to create cipher context");
+            if (EVP_CIPHER_CTX_copy(m_ctx, Encrypt::Instance().context(passwd, decrypt)) != 1)
+            {
+                EVP_CIPHER_CTX_free(m_ctx);
+                throw std::runtime_error(decrypt ? "Failed to initialize decryption" : "Failed to initialize encryption");
+            }
         }
+        ~Stream() { EVP_CIPHER_CTX_free(m_ctx); }
+        Stream(const Stream&) = delete;
+        Stream& operator=(const Stream&) = delete;
 
-        if (EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), NULL, key, iv) != 1)
+        size_t update(const uint8_t *in, size_t size, uint8_t *out)
         {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to initialize encryption");
+            size_t out_size = 0;
+            while (size > 0)
+            {
+                // EVP takes int sizes
+                const int in_len = size > (1 << 30) ? (1 << 30) : (int)size;
+                int len = 0;
+                const int ret = m_decrypt ? EVP_DecryptUpdate(m_ctx, out + out_size, &len, in, in_len) : EVP_EncryptUpdate(m_ctx, out + out_size, &len, in, in_len);
+                if (ret != 1)
+                    throw std::runtime_error(m_decrypt ? "Failed to decrypt data" : "Failed to encrypt data");
+                in += in_len;
+                size -= in_len;
+                out_size += len;
+            }
+            return out_size;
+        }
+        size_t finish(uint8_t *out)
+        {
+            int len = 0;
+            const int ret = m_decrypt ? EVP_DecryptFinal_ex(m_ctx, out, &len) : EVP_EncryptFinal_ex(m_ctx, out, &len);
+            if (ret != 1)
+                throw std::runtime_error(m_decrypt ? "Failed to finalize decryption" : "Failed to finalize encryption");
+            return len;
         }
 
-        int len;
+    private:
+        EVP_CIPHER_CTX* m_ctx;
+        bool m_decrypt;
+    };
+
+    size_t encrypt(const uint8_t *in, uint8_t **out, size_t size, uint8_t * passwd)
+    {
+        if (!in || !out)
+            return 0;
+        Stream stream(passwd, false);
         size_t out_size = size + EVP_CIPHER_block_size(EVP_aes_256_cbc());
         *out = (uint8_t *)malloc(out_size);
-        if (EVP_EncryptUpdate(ctx, *out, &len, reinterpret_cast<const unsigned char*>(in), size) != 1)
+        try
         {
-            free(*out);
-            *out = NULL;
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to encrypt data");
-            return 0;
+            size_t len = stream.update(in, size, *out);
+            return len + stream.finish(*out + len);
         }
-
-        int padding_len;
-        if (EVP_EncryptFinal_ex(ctx, *out + len, &padding_len) != 1)
+        catch (...)
         {
             free(*out);
             *out = NULL;
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to finalize encryption");
-            return 0;
+            throw;
         }
-
-        EVP_CIPHER_CTX_free(ctx);
-        //fprintf(stderr, "salt:"); for (int i=0; i<PKCS5_SALT_LEN; i++) { fprintf(stderr, "%02X", salt[i]); } fprintf(stderr, "\n");
-        //fprintf(stderr, " key:"); for (int i=0; i<key_len; i++) { fprintf(stderr, "%02X", key[i]); } fprintf(stderr, "\n");
-        //fprintf(stderr, "  iv:"); for (int i=0; i<EVP_MAX_IV_LENGTH; i++) { fprintf(stderr, "%02X", iv[i]); } fprintf(stderr, "\n");
-        return len + padding_len;
     }
 
     size_t encrypt(const uint8_t *in, std::vector<uint8_t>& out, size_t size, uint8_t * passwd)
     {
-        int ret = 0;
         if (!in)
             return 0;
-
-        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-        if (!ctx)
-        {
-            throw std::runtime_error("Failed to create cipher context");
-        }
-
-        int key_len = 0;
-        if ((key_len = EVP_BytesToKey(EVP_aes_256_cbc(), EVP_get_digestbyname("md5"), salt, passwd, strlen((const char *)passwd), 1, key, iv)) <= 0)
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to get key");
-        }
-
-        if (EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), NULL, key, iv) != 1)
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to initialize encryption");
-        }
-
-        int len;
+        Stream stream(passwd, false);
         size_t out_size = size + EVP_CIPHER_block_size(EVP_aes_256_cbc());
-        //*out = (uint8_t *)malloc(out_size);
         out.resize(out_size);
-        if (EVP_EncryptUpdate(ctx, out.data(), &len, reinterpret_cast<const unsigned char*>(in), size) != 1)
+        try
         {
-            out.clear();
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to encrypt data");
-            return 0;
+            size_t len = stream.update(in, size, out.data());
+            return len + stream.finish(out.data() + len);
         }
-
-        int padding_len;
-        if (EVP_EncryptFinal_ex(ctx, out.data() + len, &padding_len) != 1)
+        catch (...)
         {
             out.clear();
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to finalize encryption");
-            return 0;
+            throw;
         }
-
-        EVP_CIPHER_CTX_free(ctx);
-        //fprintf(stderr, "salt:"); for (int i=0; i<PKCS5_SALT_LEN; i++) { fprintf(stderr, "%02X", salt[i]); } fprintf(stderr, "\n");
-        //fprintf(stderr, " key:"); for (int i=0; i<key_len; i++) { fprintf(stderr, "%02X", key[i]); } fprintf(stderr, "\n");
-        //fprintf(stderr, "  iv:"); for (int i=0; i<EVP_MAX_IV_LENGTH; i++) { fprintf(stderr, "%02X", iv[i]); } fprintf(stderr, "\n");
-        return len + padding_len;
     }
 
     size_t decrypt(const uint8_t *in, uint8_t **out, size_t size, uint8_t * passwd)
     {
         if (!in || !out)
             return 0;
-
-        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-        if (!ctx)
-        {
-            throw std::runtime_error("Failed to create cipher context");
-        }
-        int key_len = 0;
-        if ((key_len = EVP_BytesToKey(EVP_aes_256_cbc(), EVP_get_digestbyname("md5"), salt, passwd, strlen((const char *)passwd), 1, key, iv)) <= 0)
+        Stream stream(passwd, true);
+        *out = (uint8_t *)malloc(size);
+        try
         {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to get key");
+            size_t len = stream.update(in, size, *out);
+            return len + stream.finish(*out + len);
         }
-
-        if (EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), NULL, key, iv) != 1)
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to initialize decryption");
-        }
-
-        int len;
-        size_t out_size = size;
-        *out = (uint8_t *)malloc(out_size);
-        if (EVP_DecryptUpdate(ctx, *out, &len, in, size) != 1)
+        catch (...)
         {
             free(*out);
             *out = NULL;
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to decrypt data");
-            return 0;
+            throw;
         }
-
-        int padding_len;
-        if (EVP_DecryptFinal_ex(ctx, *out + len, &padding_len) != 1)
-        {
-            free(*out);
-            *out = NULL;
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to finalize decryption");
-            return 0;
-        }
-
-        EVP_CIPHER_CTX_free(ctx);
-        //fprintf(stderr, "salt:"); for (int i=0; i<PKCS5_SALT_LEN; i++) { fprintf(stderr, "%02X", salt[i]); } fprintf(stderr, "\n");
-        //fprintf(stderr, " key:"); for (int i=0; i<key_len; i++) { fprintf(stderr, "%02X", key[i]); } fprintf(stderr, "\n");
-        //fprintf(stderr, "  iv:"); for (int i=0; i<EVP_MAX_IV_LENGTH; i++) { fprintf(stderr, "%02X", iv[i]); } fprintf(stderr, "\n");
-        return len + padding_len;
     }
 
     size_t decrypt(const uint8_t *in, std::vector<uint8_t>& out, size_t size, uint8_t * passwd)
     {
         if (!in)
             return 0;
-        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-        if (!ctx)
-        {
-            throw std::runtime_error("Failed to create cipher context");
-        }
-        int key_len = 0;
-        if ((key_len = EVP_BytesToKey(EVP_aes_256_cbc(), EVP_get_digestbyname("md5"), salt, passwd, strlen((const char *)passwd), 1, key, iv)) <= 0)
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to get key");
-        }
-
-        if (EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), NULL, key, iv) != 1)
+        Stream stream(passwd, true);
+        out.resize(size);
+        try
         {
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to initialize decryption");
+            size_t len = stream.update(in, size, out.data());
+            return len + stream.finish(out.data() + len);
         }
-
-        int len;
-        size_t out_size = size;
-        out.resize(out_size);
-        if (EVP_DecryptUpdate(ctx, out.data(), &len, in, size) != 1)
+        catch (...)
         {
             out.clear();
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to decrypt data");
-            return 0;
+            throw;
         }
-
-        int padding_len;
-        if (EVP_DecryptFinal_ex(ctx, out.data() + len, &padding_len) != 1)
-        {
-            out.clear();
-            EVP_CIPHER_CTX_free(ctx);
-            throw std::runtime_error("Failed to finalize decryption");
-            return 0;
-        }
-
-        EVP_CIPHER_CTX_free(ctx);
-        return len + padding_len;
     }
 private:
-    unsigned char key[EVP_MAX_KEY_LENGTH];
-    unsigned char iv[EVP_MAX_IV_LENGTH];
+    struct Contexts
+    {
+        EVP_CIPHER_CTX* enc;
+        EVP_CIPHER_CTX* dec;
+    };
+    std::mutex m_mutex;
+    std::map<std::string, Contexts> m_contexts;
     unsigned char salt[PKCS5_SALT_LEN] = "CodeWin";
 };
 IMGUI_API void ImDecryptFile(const std::string path, const std::string key, std::vector<uint8_t>& data);
+// Pipelined file decryption: a worker thread reads the next chunk while the current one is decrypted (double buffering).
+// The consumer gets the plain data chunk by chunk and returns false to stop. All return the decrypted size, 0 on failure.
+IMGUI_API size_t ImDecryptFile(const std::string& path, const std::string& key, const std::function<bool(const uint8_t* data, size_t size)>& consumer, size_t chunk_size = 4 * 1024 * 1024);
+// Decrypts straight into a caller buffer, or into the data of an already created ImMat, which must be large enough for the plain data.
+// The plain data of a 3D mat is its channels one after the other, without the cstep padding
+IMGUI_API size_t ImDecryptFile(const std::string& path, const std::string& key, uint8_t* out, size_t capacity, size_t chunk_size = 4 * 1024 * 1024);
+IMGUI_API size_t ImDecryptFile(const std::string& path, const std::string& key, ImGui::ImMat& mat, size_t chunk_size = 4 * 1024 * 1024);
+// Chunked file encryption, the output never needs the whole encrypted data in memory
+IMGUI_API size_t ImEncryptFile(const std::string& path, const std::string& key, const uint8_t* data, size_t size, size_t chunk_size = 4 * 1024 * 1024);
 #endif
 } // ImGuiHelper
 
@@ -405,6 +405,7 @@ IMGUI_API int           ImStrlenW(const ImWchar* str);
 IMGUI_API const ImWchar*ImStrbolW(const ImWchar* buf_mid_line, const ImWchar* buf_begin);   // Find beginning-of-line (ImWchar string)
 IM_MSVC_RUNTIME_CHECKS_OFF
 static inline char      ImToUpper(char c)               { return (c >= 'a' && c <= 'z') ? c &= ~32 : c; }
+static inline char      ImToLower(char c)               { return (c >= 'A' && c <= 'Z') ? (char)(c | 32) : c; } // add by Dicky
 static inline bool      ImCharIsBlankA(char c)          { return c == ' ' || c == '\t'; }
 static inline bool      ImCharIsBlankW(unsigned int c)  { return c == ' ' || c == '\t' || c == 0x3000; }
 static inline bool      ImCharIsXdigitA(char c)         { return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f'); }
@@ -792,6 +793,15 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// add by Dicky
+// ImDrawList: SDF glyph parameters are encoded in the UVs, renderers with ImGuiBackendFlags_RendererHasTextSDF decode k = floor(uv / 2):
+// k.x >= 1 marks a SDF glyph, (k.x - 1) is the dilation and k.y the edge softness in 1/IM_DRAWLIST_TEXT_SDF_STEPS of ImFontAtlas::TexSDFSpread.
+// The distance is stored as 0.5 - distance / (2 * TexSDFSpread), so the shader threshold is 0.5 - (k.x - 1) / (2 * STEPS) and the softness k.y / (2 * STEPS).
+#define IM_DRAWLIST_TEXT_SDF_STEPS                              63
+#define IM_DRAWLIST_TEXT_SDF_DILATION_MAX                       56 // Keeps the texels beyond the spread (0) transparent
+#define IM_DRAWLIST_TEXT_SDF_UV(_DILATION,_SOFTNESS)            ImVec2(2.0f * (1 + (_DILATION)), 2.0f * (_SOFTNESS))
+// add by Dicky end
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
 struct IMGUI_API ImDrawListSharedData
@@ -1187,6 +1197,90 @@ struct IMGUI_API ImGuiInputTextState
 
 };
 
+// add by Dicky
+#ifndef IMGUI_INPUT_TEXT_LARGE_UNDO_SIZE
+#define IMGUI_INPUT_TEXT_LARGE_UNDO_SIZE    (4 * 1024 * 1024)   // bytes of text kept by the undo stack of ImGuiInputTextFlags_LargeText
+#endif
+
+// Text of an InputTextMultiline() with ImGuiInputTextFlags_LargeText: UTF-8 bytes with a gap at the last edit position.
+// Text before the gap is Data[0, GapBegin), text after the gap is Data[GapEnd, Data.Size). An edit moves the gap to its position,
+// so it costs the size of the edit plus the distance from the previous edit.
+struct IMGUI_API ImGuiTextGapBuffer
+{
+    ImVector<char>      Data;
+    int                 GapBegin;
+    int                 GapEnd;
+
+    ImGuiTextGapBuffer()                    { GapBegin = GapEnd = 0; }
+    int         size() const                { return Data.Size - (GapEnd - GapBegin); }
+    char        operator[](int pos) const   { return Data.Data[pos < GapBegin ? pos : pos + GapEnd - GapBegin]; }
+    void        clear()                     { Data.clear(); GapBegin = GapEnd = 0; }
+    void        assign(const char* text, int len);
+    bool        Equals(const char* text, int len) const;
+    void        MoveGap(int pos);
+    void        Replace(int pos, int erase_len, const char* text, int text_len);    // 'text' must not point into Data
+    void        CopyTo(char* dst, int begin, int end) const;
+    const char* GetRange(int begin, int end, ImVector<char>* temp) const;          // Contiguous [begin, end), copied to 'temp' when the range spans the gap
+};
+
+// One edit of a ImGuiInputTextFlags_LargeText text: 'DeletedLen' bytes at 'Offset' replaced by 'InsertedLen' bytes.
+// The bytes are stored at 'TextOffset' in the owner vector: deleted bytes (undo records only) then inserted bytes.
+struct ImGuiInputTextLargeEdit
+{
+    int                 Offset;
+    int                 DeletedLen;
+    int                 InsertedLen;
+    int                 TextOffset;
+};
+
+// Internal state of the currently edited InputTextMultiline() with ImGuiInputTextFlags_LargeText
+// Positions are byte offsets in the UTF-8 text. Access with ImGui::GetInputTextLargeState()
+struct IMGUI_API ImGuiInputTextLargeState
+{
+    ImGuiID                 ID;                     // widget id owning the text state
+    ImGuiInputTextFlags     Flags;                  // copy of InputText() flags
+    int                     BufCapacity;            // end-user buffer capacity
+    ImGuiTextGapBuffer      Text;                   // edit buffer, copied back to the user buffer once per frame (dirty range only)
+    ImVector<int>           LineStarts;             // offset of each line start. entries after PendingLine don't include PendingDelta yet, so an edit only updates the entries between it and the previous edit
+    int                     PendingLine;
+    int                     PendingDelta;
+    int                     Cursor;
+    int                     SelectStart;            // selection anchor
+    int                     SelectEnd;              // == Cursor when there is a selection
+    float                   PreferredX;             // x position kept by up/down moves, < 0.0f when unset
+    float                   ScrollX;                // horizontal scrolling/offset
+    float                   CursorAnim;             // timer for cursor blink, reset on every user action so the cursor reappears immediately
+    bool                    CursorFollow;           // set when we want scrolling to follow the current cursor position
+    bool                    DirtyResized;           // text length changed since the last copy to the user buffer: copy from DirtyBegin to the end
+    int                     DirtyBegin;             // range changed since the last copy to the user buffer (DirtyBegin == INT_MAX when none)
+    int                     DirtyEnd;
+    ImVector<ImGuiInputTextLargeEdit> UndoEdits;    // UndoEdits[0, UndoPoint) can be undone, the others redone
+    ImVector<char>          UndoText;
+    int                     UndoPoint;
+    int                     RevertUndoPoint;        // undo point at activation, Escape undoes back to it (-1 when trimmed by IMGUI_INPUT_TEXT_LARGE_UNDO_SIZE)
+    ImVector<ImGuiInputTextLargeEdit> FrameEdits;   // edits of the current frame, for ImGuiInputTextFlags_CallbackEdit
+    ImVector<char>          FrameEditsText;
+    ImVector<char>          TempText;               // lines spanning the gap, clipboard
+
+    ImGuiInputTextLargeState()              { memset(this, 0, sizeof(*this)); }
+    void        ClearFreeMemory()           { Text.clear(); LineStarts.clear(); UndoEdits.clear(); UndoText.clear(); FrameEdits.clear(); FrameEditsText.clear(); TempText.clear(); }
+    void        Load(const char* text, int len);                                     // set text, build line index, clamp cursor
+    void        Replace(int pos, int erase_len, const char* text, int text_len);    // edit text, line index and dirty range
+    int         GetLineCount() const        { return LineStarts.Size; }
+    int         GetLineStart(int line) const { return LineStarts.Data[line] + (line > PendingLine ? PendingDelta : 0); }
+    int         GetLineEnd(int line) const  { return line + 1 < LineStarts.Size ? GetLineStart(line + 1) - 1 : Text.size(); } // excluding '\n'
+    int         FindLine(int pos) const;
+    void        SetPendingLine(int line);
+
+    void        CursorAnimReset()           { CursorAnim = -0.30f; }
+    bool        HasSelection() const        { return SelectStart != SelectEnd; }
+    int         GetSelectionMin() const     { return ImMin(SelectStart, SelectEnd); }
+    int         GetSelectionMax() const     { return ImMax(SelectStart, SelectEnd); }
+    void        ClearSelection()            { SelectStart = SelectEnd = Cursor; }
+    void        SelectAll()                 { SelectStart = 0; Cursor = SelectEnd = Text.size(); PreferredX = -1.0f; }
+};
+// add by Dicky end
+
 enum ImGuiWindowRefreshFlags_
 {
     ImGuiWindowRefreshFlags_None                = 0,
@@ -2071,6 +2165,8 @@ struct ImGuiViewportP : public ImGuiViewport
     ImVec2              LastPlatformPos;
     ImVec2              LastPlatformSize;
     ImVec2              LastRendererSize;
+    ImU64               LastDrawDataHash;       // Add by Dicky: hash of DrawDataP at the last Render(), for io.ConfigSkipUnchangedFrames
+    int                 LastAnimatedFrame;      // Add by Dicky: last frame MarkAnimatedRegion() hit this viewport
 
     // Per-viewport work area
     // - Insets are >= 0.0f values, distance from viewport corners to work area.
@@ -2081,7 +2177,7 @@ struct ImGuiViewportP : public ImGuiViewport
     ImVec2              BuildWorkInsetMin;      // Work Area inset accumulator for current frame, to become next frame's WorkInset
     ImVec2              BuildWorkInsetMax;      // "
 
-    ImGuiViewportP()                    { Window = NULL; Idx = -1; LastFrameActive = BgFgDrawListsLastFrame[0] = BgFgDrawListsLastFrame[1] = LastFocusedStampCount = -1; LastNameHash = 0; Alpha = LastAlpha = 1.0f; LastFocusedHadNavWindow = false; PlatformMonitor = -1; BgFgDrawLists[0] = BgFgDrawLists[1] = NULL; LastPlatformPos = LastPlatformSize = LastRendererSize = ImVec2(FLT_MAX, FLT_MAX); }
+    ImGuiViewportP()                    { Window = NULL; Idx = -1; LastFrameActive = BgFgDrawListsLastFrame[0] = BgFgDrawListsLastFrame[1] = LastFocusedStampCount = -1; LastNameHash = 0; Alpha = LastAlpha = 1.0f; LastFocusedHadNavWindow = false; PlatformMonitor = -1; BgFgDrawLists[0] = BgFgDrawLists[1] = NULL; LastPlatformPos = LastPlatformSize = LastRendererSize = ImVec2(FLT_MAX, FLT_MAX); LastDrawDataHash = 0; LastAnimatedFrame = -1; }
     ~ImGuiViewportP()                   { if (BgFgDrawLists[0]) IM_DELETE(BgFgDrawLists[0]); if (BgFgDrawLists[1]) IM_DELETE(BgFgDrawLists[1]); }
     void    ClearRequestFlags()         { PlatformRequestClose = PlatformRequestMove = PlatformRequestResize = false; }
 
@@ -2249,6 +2345,85 @@ struct ImGuiIDStackTool
     ImGuiIDStackTool()      { memset(this, 0, sizeof(*this)); CopyToClipboardLastTime = -FLT_MAX; }
 };
 
+// Add by Dicky Multi-language support
+// Localized strings of one language, compiled by LoadIniLanguagesFromMemory().
+// Open addressing hash table keyed by ImHashStr() of the source string, keys and values are stored zero-terminated in Strings.
+struct ImGuiLanguageEntry
+{
+    ImGuiID                 KeyHash;                    // 0: empty slot
+    int                     KeyOffset, KeyLen;
+    int                     ValueOffset, ValueLen;
+};
+
+struct IMGUI_API ImGuiLanguageTable
+{
+    ImVector<char>                  Strings;
+    ImVector<ImGuiLanguageEntry>    Slots;              // Power of 2 size, kept under 50% load
+    int                             Count;
+
+    ImGuiLanguageTable()            { Count = 0; }
+    void                            Clear()             { Strings.clear(); Slots.clear(); Count = 0; }
+    void                            Add(const char* key, int key_len, const char* value, int value_len);
+    const ImGuiLanguageEntry*       Find(const char* key, int key_len) const;
+    const char*                     GetKey(const ImGuiLanguageEntry* entry) const   { return Strings.Data + entry->KeyOffset; }
+    const char*                     GetValue(const ImGuiLanguageEntry* entry) const { return Strings.Data + entry->ValueOffset; }
+};
+
+// Direct mapped cache in front of ImGuiLanguageTable, keyed by label pointer. Most labels are string literals submitted
+// every frame, the copy in Text[] guards against reused buffers so a hit never returns a stale translation.
+struct ImGuiLanguageCacheEntry
+{
+    const char*                 Label;                  // NULL: empty
+    int                         LabelLen;
+    int                         PrefixLen;              // Icon prefix kept in front of the translation
+    const ImGuiLanguageEntry*   Entry;                  // NULL: cached miss
+    char                        Text[40];
+};
+// Add by Dicky end
+
+// Add by Dicky text layout cache
+// Layout of a text for a font, size and wrap width, kept by io.ConfigTextLayoutCache and looked up by TextLayoutCacheFind().
+// A text seen for the first time only gets its key, the size and the wrapped lines are built when it comes back in a later frame
+// so text changing every frame (counters, timers) costs little. Glyph quads aren't kept, copying them measured slower than
+// RenderTextEx(). Layouts unused for IMGUI_TEXT_LAYOUT_CACHE_FRAMES frames are evicted by NewFrame().
+#define IMGUI_TEXT_LAYOUT_CACHE_FRAMES      120
+#define IMGUI_TEXT_LAYOUT_CACHE_MAX_LENGTH  2048                // Longer texts aren't cached, they're rarely visible in full
+
+struct ImGuiTextLayoutLine
+{
+    int                     Begin, End;                         // Byte offsets of the line in the text, without the '\n' or the blanks skipped by wrapping
+};
+
+struct ImGuiTextLayout
+{
+    ImU64                   TextHash;
+    const ImFont*           Font;
+    float                   FontSize;
+    float                   WrapWidth;                          // 0.0f: no wrapping
+    int                     TextLength;
+    int                     BuildId;                            // Font->ContainerAtlas->TexBuildId when the layout was made
+    int                     FirstFrame;
+    int                     LastFrame;
+    bool                    SizeValid;
+    bool                    LinesValid;
+    ImVec2                  Size;                               // CalcTextSizeA(FontSize, FLT_MAX, WrapWidth)
+    float                   Spacing;                            // Style.TextSpacing the lines were wrapped with
+    ImVector<ImGuiTextLayoutLine> Lines;                        // Lines after '\n' and wrapping, only made for wrapped text
+
+    ImGuiTextLayout()       { memset(this, 0, sizeof(*this)); }
+};
+
+struct ImGuiTextLayoutCache
+{
+    ImPool<ImGuiTextLayout> Layouts;
+    int                     Hits, Misses;                       // Lookups of the current frame, a hit returned a layout
+    int                     LastFrameHits, LastFrameMisses;
+
+    ImGuiTextLayoutCache()  { Hits = Misses = LastFrameHits = LastFrameMisses = 0; }
+    void                    Clear() { Layouts.Clear(); Hits = Misses = LastFrameHits = LastFrameMisses = 0; }
+};
+// Add by Dicky end
+
 //-----------------------------------------------------------------------------
 // [SECTION] Generic context hooks
 //-----------------------------------------------------------------------------
@@ -2536,6 +2711,7 @@ struct ImGuiContext
     // Widget state
     ImGuiInputTextState     InputTextState;
     ImGuiInputTextDeactivatedState InputTextDeactivatedState;
+    ImGuiInputTextLargeState InputTextLargeState;               // add by Dicky, ImGuiInputTextFlags_LargeText
     ImFont                  InputTextPasswordFont;
     ImGuiID                 TempInputId;                        // Temporary text input when CTRL+clicking on a slider, etc.
     ImGuiDataTypeStorage    DataTypeZeroValue;                  // 0 for all data types
@@ -2638,13 +2814,20 @@ struct ImGuiContext
     // Add By Dicky Power saving mode
     double                  MaxWaitBeforeNextFrame;             // How much time, in seconds, can we wait for events before starting the next frame
     double                  WallClock;                          // System Clock
+    double                  AnimationWaitTime;                  // Shortest MarkAnimatedRegion() interval of the current frame, INFINITY if none
 
     // Add by Dicky Multi-language support
     bool                    LanguagesLoaded;
-    std::map<std::string, std::map<std::string, std::string>> StringMap; // language map, first = language, second->first = string second->second = localized string
+    std::map<std::string, ImGuiLanguageTable> LanguageTables;   // language name -> localized strings
     std::string             LanguageName;
+    std::string             LanguageTableName;                  // LanguageName resolved into LanguageTable
+    const ImGuiLanguageTable* LanguageTable;                    // NULL when LanguageName has no table
+    ImVector<ImGuiLanguageCacheEntry> LanguageCache;            // Label pointer cache for LanguageTable
     char                    InternationalizedBuffer[4096];      // Internationalized convert buffer
 
+    // Add by Dicky text layout cache
+    ImGuiTextLayoutCache    TextLayoutCache;                    // io.ConfigTextLayoutCache
+
     // Add by Dicky thread safe
     std::thread::id         MainThreadID;
     // Add by Dicky end
@@ -2865,10 +3048,12 @@ struct ImGuiContext
 		// Add by Dicky for power saving
         MaxWaitBeforeNextFrame = 0.0;
         WallClock = ImGui::get_current_time();
+        AnimationWaitTime = INFINITY;
 
         // Add by Dicky Multi-language support
         LanguagesLoaded = false;
         LanguageName = "";
+        LanguageTable = NULL;
 
         // add by Dicky
         MainThreadID = std::this_thread::get_id();
@@ -3949,6 +4134,8 @@ namespace ImGui
     IMGUI_API void          RenderNavHighlight(const ImRect& bb, ImGuiID id, ImGuiNavHighlightFlags flags = ImGuiNavHighlightFlags_None); // Navigation highlight
     IMGUI_API const char*   FindRenderedTextEnd(const char* text, const char* text_end = NULL); // Find the optional ## from which we stop displaying text.
     IMGUI_API void          RenderMouseCursor(ImVec2 pos, float scale, ImGuiMouseCursor mouse_cursor, ImU32 col_fill, ImU32 col_border, ImU32 col_shadow);
+    IMGUI_API ImGuiTextLayout* TextLayoutCacheFind(const ImFont* font, float size, float wrap_width, const char* text, const char* text_end); // add by Dicky: NULL when disabled or the text wasn't seen in a previous frame
+    IMGUI_API void          TextLayoutCacheGC();                // add by Dicky: evict unused layouts, called by NewFrame()
 
     // Render helpers (those functions don't access any ImGui state!)
     IMGUI_API void          RenderArrow(ImDrawList* draw_list, ImVec2 pos, ImU32 col, ImGuiDir dir, float scale = 1.0f);
@@ -4013,11 +4200,13 @@ namespace ImGui
 
     // InputText
     IMGUI_API bool          InputTextEx(const char* label, const char* hint, char* buf, int buf_size, const ImVec2& size_arg, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback = NULL, void* user_data = NULL);
+    IMGUI_API bool          InputTextLargeEx(const char* label, const char* hint, char* buf, int buf_size, const ImVec2& size_arg, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback = NULL, void* user_data = NULL); // add by Dicky, called by InputTextEx() for ImGuiInputTextFlags_LargeText
     IMGUI_API void          InputTextDeactivateHook(ImGuiID id);
     IMGUI_API bool          TempInputText(const ImRect& bb, ImGuiID id, const char* label, char* buf, int buf_size, ImGuiInputTextFlags flags);
     IMGUI_API bool          TempInputScalar(const ImRect& bb, ImGuiID id, const char* label, ImGuiDataType data_type, void* p_data, const char* format, const void* p_clamp_min = NULL, const void* p_clamp_max = NULL);
     inline bool             TempInputIsActive(ImGuiID id)       { ImGuiContext& g = *GImGui; return (g.ActiveId == id && g.TempInputId == id); }
     inline ImGuiInputTextState* GetInputTextState(ImGuiID id)   { ImGuiContext& g = *GImGui; return (id != 0 && g.InputTextState.ID == id) ? &g.InputTextState : NULL; } // Get input text state if active
+    inline ImGuiInputTextLargeState* GetInputTextLargeState(ImGuiID id) { ImGuiContext& g = *GImGui; return (id != 0 && g.InputTextLargeState.ID == id) ? &g.InputTextLargeState : NULL; } // add by Dicky, ImGuiInputTextFlags_LargeText
     IMGUI_API void          SetNextItemRefVal(ImGuiDataType data_type, void* p_data);
 
     // Color
@@ -4099,10 +4288,28 @@ namespace ImGui
 // [SECTION] ImFontAtlas internal API
 //-----------------------------------------------------------------------------
 
+// add by Dicky for dynamic glyphs
+// One glyph rasterized on demand by a font builder, pixels stay valid until the next rasterization.
+struct ImFontAtlasGlyphBitmap
+{
+    int                     Width, Height;      // In texture pixels (including oversampling)
+    int                     Pitch;              // In pixels
+    const unsigned char*    Alpha8;             // One of Alpha8/RGBA32 is set
+    const unsigned int*     RGBA32;
+    float                   X0, Y0, X1, Y1;     // Glyph corners relative to the pen position on the baseline, before ImFontConfig::GlyphOffset
+    float                   AdvanceX;           // Before ImFontConfig::GlyphMinAdvanceX/GlyphMaxAdvanceX/GlyphExtraSpacing
+    bool                    Colored;
+};
+// add by Dicky end
+
 // This structure is likely to evolve as we add support for incremental atlas updates
 struct ImFontBuilderIO
 {
     bool    (*FontBuilder_Build)(ImFontAtlas* atlas);
+    // add by Dicky for dynamic glyphs, optional. 'builder_data' is the rasterizer state passed to ImFontAtlasBuildDynamicInit() by FontBuilder_Build.
+    bool    (*FontBuilder_RasterizeGlyph)(void* builder_data, int src_index, ImWchar codepoint, ImFontAtlasGlyphBitmap* out_bitmap); // false when atlas->ConfigData[src_index] doesn't have the glyph
+    void    (*FontBuilder_DestroyData)(void* builder_data);
+    // add by Dicky end
 };
 
 // Helper for font builder
@@ -4118,6 +4325,23 @@ IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas,
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
+// add by Dicky for dynamic glyphs
+IMGUI_API bool      ImFontAtlasBuildIsGlyphBaked(ImFontAtlas* atlas, const ImFontConfig* font_config, ImWchar codepoint);  // With ImFontAtlasFlags_DynamicGlyphs, the other glyphs are added with ImFontAtlasBuildAddDynamicGlyph()
+IMGUI_API void      ImFontAtlasBuildAddDynamicGlyph(ImFontAtlas* atlas, ImFont* font, const ImFontConfig* font_config, ImWchar codepoint, float advance_x);
+IMGUI_API void      ImFontAtlasBuildDynamicInit(ImFontAtlas* atlas, const ImFontBuilderIO* builder_io, void* builder_data);       // Call after packing the baked glyphs (TexHeight), before allocating the texture. Takes ownership of builder_data
+IMGUI_API void      ImFontAtlasBuildDynamicShutdown(ImFontAtlas* atlas);
+IMGUI_API void      ImFontAtlasBuildDynamicNewFrame(ImFontAtlas* atlas);
+IMGUI_API bool      ImFontAtlasBuildDynamicLoadGlyph(ImFontAtlas* atlas, ImFont* font, ImFontGlyph* glyph);                      // Called by FindGlyph() for ImFontGlyph::Dynamic glyphs
+// add by Dicky end
+// add by Dicky for parallel build and atlas cache
+IMGUI_API int       ImFontAtlasBuildGetThreadsCount(ImFontAtlas* atlas);
+IMGUI_API void      ImFontAtlasBuildParallelFor(ImFontAtlas* atlas, int count, void (*func)(void* user_data, int index), void* user_data); // Runs func(0..count-1) on atlas->BuildThreads threads, the calling thread included
+IMGUI_API void*     ImFontAtlasBuildThreadAlloc(size_t size);   // Allocator usable from the build threads, skips the debug hook of the current context
+IMGUI_API void      ImFontAtlasBuildThreadFree(void* ptr);
+IMGUI_API bool      ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const ImFontBuilderIO* builder_io);
+IMGUI_API bool      ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const ImFontBuilderIO* builder_io);
+// add by Dicky end
+IMGUI_API void      ImFontAtlasBuildRenderSDF(unsigned char* pixels, int stride, int w, int h, int spread); // add by Dicky, coverage to signed distance field in place, thread-safe
 
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
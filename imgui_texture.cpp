@@ -13,6 +13,15 @@
 #endif
 #endif
 
+// add by Dicky, OpenGL can be found without being the renderer, the soft textures don't need its loader
+#if IMGUI_RENDERING_SOFT
+#ifdef IMGUI_OPENGL
+#undef IMGUI_OPENGL
+#define IMGUI_OPENGL 0
+#endif
+#endif
+// add by Dicky end
+
 #if IMGUI_OPENGL
 #if defined(IMGUI_IMPL_OPENGL_ES2) || defined(__EMSCRIPTEN__)
 #ifndef IMGUI_IMPL_OPENGL_ES2
@@ -93,6 +102,17 @@ struct ImTexture
     std::thread::id CreateThread;
     bool NeedDestroy  = false;
 };
+#elif IMGUI_RENDERING_SOFT
+#include <imgui_impl_soft.h>
+struct ImTexture
+{
+    ImTextureSoft TextureID = nullptr;
+    int    Width     = 0;
+    int    Height    = 0;
+    double  TimeStamp = NAN;
+    std::thread::id CreateThread;
+    bool NeedDestroy  = false;
+};
 #elif IMGUI_OPENGL
 struct ImTexture
 {
@@ -118,6 +138,7 @@ struct ImTexture
 namespace ImGui {
 static std::vector<ImTexture> g_Textures;
 std::mutex g_tex_mutex;
+static std::vector<ImTexture>::iterator ImFindTexture(ImTextureID texture);
 
 void ImGenerateOrUpdateTexture(ImTextureID& imtexid,int width,int height,int channels,const unsigned char* pixels,bool useMipmapsIfPossible,bool wraps,bool wrapt,bool minFilterNearest,bool magFilterNearest,bool is_immat)
 {
@@ -225,6 +246,36 @@ void ImGenerateOrUpdateTexture(ImTextureID& imtexid,int width,int height,int cha
         }
     }
     texid->UnlockRect(0);
+#elif IMGUI_RENDERING_SOFT
+    if (is_immat && ((ImGui::ImMat*)pixels)->device != IM_DD_CPU)
+        return;
+    if (imtexid != 0 && (ImGetTextureWidth(imtexid) != width || ImGetTextureHeight(imtexid) != height))
+    {
+        // A soft texture is a buffer of its creation size, recreate it for the new size
+        ImDestroyTexture(&imtexid);
+        imtexid = 0;
+    }
+    if (imtexid == 0)
+    {
+        ImTextureSoft texture_soft = is_immat ? ImGui_ImplSoft_CreateTexture(*(ImGui::ImMat*)pixels) : ImGui_ImplSoft_CreateTexture(pixels, width, height, channels);
+        if (!texture_soft)
+            return;
+        g_tex_mutex.lock();
+        g_Textures.resize(g_Textures.size() + 1);
+        ImTexture& texture = g_Textures.back();
+        texture.TextureID = texture_soft;
+        texture.CreateThread = std::this_thread::get_id();
+        texture.NeedDestroy = false;
+        texture.Width  = width;
+        texture.Height = height;
+        imtexid = texture.TextureID;
+        g_tex_mutex.unlock();
+        return;
+    }
+    if (is_immat)
+        ImGui_ImplSoft_UpdateTexture((ImTextureSoft)imtexid, *(ImGui::ImMat*)pixels);
+    else
+        ImGui_ImplSoft_UpdateTexture((ImTextureSoft)imtexid, pixels, width, height, channels);
 #elif IMGUI_OPENGL
     glEnable(GL_TEXTURE_2D);
     GLint last_texture = 0;
@@ -406,6 +457,16 @@ void ImCopyToTexture(ImTextureID& imtexid, unsigned char* pixels, int width, int
         ImGui_ImplVulkan_UpdateTexture(imtexid, data, width, height, channels, bit_depth, offset_x, offset_y);
 #elif IMGUI_RENDERING_DX11
 #elif IMGUI_RENDERING_DX9
+#elif IMGUI_RENDERING_SOFT
+    if (is_immat)
+    {
+        ImGui::ImMat* mat = (ImGui::ImMat*)pixels;
+        if (mat->empty() || mat->device != IM_DD_CPU)
+            return;
+        ImGui_ImplSoft_UpdateTexture((ImTextureSoft)imtexid, *mat, offset_x, offset_y);
+    }
+    else
+        ImGui_ImplSoft_UpdateTexture((ImTextureSoft)imtexid, pixels, width, height, channels, 8, offset_x, offset_y);
 #elif IMGUI_OPENGL
     glEnable(GL_TEXTURE_2D);
     GLint last_texture = 0;
@@ -557,6 +618,21 @@ ImTextureID ImCreateTexture(const void* data, int width, int height, int channel
     texture.TimeStamp = time_stamp;
     g_tex_mutex.unlock();
     return (ImTextureID)texture.TextureID;
+#elif IMGUI_RENDERING_SOFT
+    ImTextureSoft texture_soft = ImGui_ImplSoft_CreateTexture(data, width, height, channels, bit_depth);
+    if (!texture_soft)
+        return (ImTextureID)nullptr;
+    g_tex_mutex.lock();
+    g_Textures.resize(g_Textures.size() + 1);
+    ImTexture& texture = g_Textures.back();
+    texture.TextureID = texture_soft;
+    texture.CreateThread = std::this_thread::get_id();
+    texture.NeedDestroy = false;
+    texture.Width  = width;
+    texture.Height = height;
+    texture.TimeStamp = time_stamp;
+    g_tex_mutex.unlock();
+    return (ImTextureID)texture.TextureID;
 #elif IMGUI_OPENGL
     g_tex_mutex.lock();
     g_Textures.resize(g_Textures.size() + 1);
@@ -592,6 +668,8 @@ static std::vector<ImTexture>::iterator ImFindTexture(ImTextureID texture)
     auto textureID = (ID3D11ShaderResourceView *)texture;
 #elif IMGUI_RENDERING_DX9
     auto textureID = reinterpret_cast<LPDIRECT3DTEXTURE9>(texture);
+#elif IMGUI_RENDERING_SOFT
+    auto textureID = reinterpret_cast<ImTextureSoft>(texture);
 #elif IMGUI_OPENGL
     auto textureID = reinterpret_cast<ImTextureGl>(texture);
 #else
@@ -623,6 +701,9 @@ static void destroy_texture(ImTexture* tex)
         tex->TextureID->Release();
         tex->TextureID = nullptr;
     }
+#elif IMGUI_RENDERING_SOFT
+    if (tex->TextureID)
+        ImGui_ImplSoft_DestroyTexture(&tex->TextureID);
 #elif IMGUI_OPENGL
     if (tex->TextureID)
     {
@@ -778,6 +859,12 @@ int ImGetTextureData(ImTextureID texture, void* data)
 
 #if IMGUI_RENDERING_VULKAN
     ret = ImGui_ImplVulkan_GetTextureData(textureIt->TextureID, data, width, height, channels);
+#elif IMGUI_RENDERING_SOFT
+    const ImGui::ImMat& mat = textureIt->TextureID->mat;
+    if (mat.w != width || mat.h != height)
+        return -1;
+    memcpy(data, mat.data, (size_t)width * height * channels);
+    ret = 0;
 #elif !IMGUI_EMSCRIPTEN && (IMGUI_RENDERING_GL3 || IMGUI_RENDERING_GL2)
     glEnable(GL_TEXTURE_2D);
     GLint last_texture = 0;
@@ -820,6 +907,16 @@ ImPixel ImGetTexturePixel(ImTextureID texture, float x, float y)
 #if IMGUI_RENDERING_VULKAN
     auto color = ImGui_ImplVulkan_GetTexturePixel(textureIt->TextureID, x, y);
     pixel = {color.x, color.y, color.z, color.w};
+#elif IMGUI_RENDERING_SOFT
+    const ImGui::ImMat& mat = textureIt->TextureID->mat;
+    if ((int)x < mat.w && (int)y < mat.h)
+    {
+        const unsigned char * pixels = (const unsigned char *)mat.data + ((int)y * mat.w + (int)x) * channels;
+        pixel.r = pixels[0] / 255.f;
+        pixel.g = pixels[1] / 255.f;
+        pixel.b = pixels[2] / 255.f;
+        pixel.a = pixels[3] / 255.f;
+    }
 #elif !IMGUI_EMSCRIPTEN && (IMGUI_RENDERING_GL3 || IMGUI_RENDERING_GL2)
     // ulgy using full texture data to pick one pixel
     // if GlVersion is greater then 4.5, maybe we can using glGetTextureSubImage
@@ -978,6 +1075,7 @@ void ImShowVideoWindowCompare(ImDrawList *draw_list, ImTextureID texture1, ImTex
         return;
     }
     ImRect video_rc(pos, pos + size);
+    ImGui::MarkAnimatedRegion(pos, pos + size); // Add by Dicky: video textures are updated in place
     std::string dialog_id = "##TextureFileDlgKey" + std::to_string((long long)(texture1 ? texture1 : texture2));
     float texture_width = texture1 ? ImGui::ImGetTextureWidth(texture1) : size.x;
     float texture_height = texture1 ? ImGui::ImGetTextureHeight(texture1) : size.y;
@@ -1189,6 +1287,7 @@ void ImShowVideoWindow(ImDrawList *draw_list, ImTextureID texture, ImVec2 pos, I
     draw_list->AddRectFilled(pos, pos + size, back_color);
     if (texture)
     {
+        ImGui::MarkAnimatedRegion(pos, pos + size); // Add by Dicky: video textures are updated in place
         ImGuiIO& io = ImGui::GetIO();
         float _tf_x, _tf_y, _offset_x, _offset_y;
         float texture_width = ImGui::ImGetTextureWidth(texture);
@@ -32,6 +32,14 @@ namespace ImGui
 // Requires platform binding support.
 // When enabled and supported, ImGui will wait for events before starting new frames, instead of continuously polling, thereby helping to reduce power consumption.
 IMGUI_API double    GetEventWaitingTime();                      // in seconds; note that it can be zero (in which case you might want to peek/poll) or infinity (in which case you may have to use a non-timeout event waiting method).
+// Declare a region whose content changes without its draw commands changing (video, texture updated in place, shader callback).
+// While visible it forces the viewport to repaint with io.ConfigSkipUnchangedFrames, and wakes up the event loop every 'interval' seconds (0: as fast as allowed).
+IMGUI_API void      MarkAnimatedRegion(const ImVec2& p_min, const ImVec2& p_max, double interval = 0.0);
+IMGUI_API double    GetAnimatedRegionWaitingTime();             // in seconds until the next animated region repaint is due, infinity when none was visible last frame.
+// With io.ConfigSkipUnchangedFrames, force the next Render() of a viewport to be drawn (NULL: main viewport). Call it when the platform lost the window content (exposed, restored).
+IMGUI_API void      InvalidateViewportDrawData(ImGuiViewport* viewport = NULL);
+// With io.ConfigSkipUnchangedFrames, an unchanged frame skips the vsync'd present: sleep for the rest of a 'refresh_rate' frame instead of spinning (<= 1: 60Hz).
+IMGUI_API void      WaitUnchangedFrame(float refresh_rate = 60.0f);
 } // namespace ImGui
 
 namespace ImGui
@@ -43,6 +51,41 @@ IMGUI_API void      sleep(float seconds);
 IMGUI_API void      sleep(int ms_seconds);
 } // namespace ImGui
 
+// Profiler, compiled to nothing unless IMGUI_PROFILER is enabled.
+// IMGUI_PROFILE_SCOPE("name") times the enclosing C++ scope on the calling thread, IMGUI_PROFILE_SCOPE_LABEL adds a label
+// (window name, file...) which must stay valid until the next NewFrame(). Names must be string literals.
+// Events go to a lock-free buffer per thread and are collected by NewFrame(), the captured frames show in
+// Metrics/Debugger > Profiler as a timeline per thread and can be saved as Chrome trace json (chrome://tracing, Perfetto).
+#if IMGUI_PROFILER
+namespace ImGui
+{
+IMGUI_API void      ProfilerBeginScope(const char* name, const char* label = NULL);
+IMGUI_API void      ProfilerEndScope();
+IMGUI_API void      ProfilerSetThreadName(const char* name);    // shown in the timeline and the trace, "Thread N" by default
+IMGUI_API void      ProfilerNewFrame();                         // called by NewFrame(), collects the events of the previous frame
+IMGUI_API void      ProfilerPause(bool pause);
+IMGUI_API bool      ProfilerSaveTrace(const char* path);        // captured frames as Chrome trace json
+IMGUI_API void      DebugNodeProfiler();                        // Metrics/Debugger > Profiler content
+} // namespace ImGui
+
+struct ImGuiProfileScope
+{
+    ImGuiProfileScope(const char* name, const char* label = NULL) { ImGui::ProfilerBeginScope(name, label); }
+    ~ImGuiProfileScope() { ImGui::ProfilerEndScope(); }
+};
+#define IMGUI_PROFILE_CONCAT_(a, b)             a##b
+#define IMGUI_PROFILE_CONCAT(a, b)              IMGUI_PROFILE_CONCAT_(a, b)
+#define IMGUI_PROFILE_SCOPE(name)               ImGuiProfileScope IMGUI_PROFILE_CONCAT(imgui_profile_scope_, __LINE__)(name)
+#define IMGUI_PROFILE_SCOPE_LABEL(name, label)  ImGuiProfileScope IMGUI_PROFILE_CONCAT(imgui_profile_scope_, __LINE__)(name, label)
+#define IMGUI_PROFILE_BEGIN(name, label)        ImGui::ProfilerBeginScope(name, label)
+#define IMGUI_PROFILE_END()                     ImGui::ProfilerEndScope()
+#else
+#define IMGUI_PROFILE_SCOPE(name)               ((void)0)
+#define IMGUI_PROFILE_SCOPE_LABEL(name, label)  ((void)0)
+#define IMGUI_PROFILE_BEGIN(name, label)        ((void)0)
+#define IMGUI_PROFILE_END()                     ((void)0)
+#endif
+
 #include <imgui_texture.h>
 
 #if IMGUI_ICONS
@@ -4415,6 +4415,8 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     IM_ASSERT(buf != NULL && buf_size >= 0);
     IM_ASSERT(!((flags & ImGuiInputTextFlags_CallbackHistory) && (flags & ImGuiInputTextFlags_Multiline)));        // Can't use both together (they both use up/down keys)
     IM_ASSERT(!((flags & ImGuiInputTextFlags_CallbackCompletion) && (flags & ImGuiInputTextFlags_AllowTabInput))); // Can't use both together (they both use tab key)
+    if ((flags & ImGuiInputTextFlags_LargeText) && (flags & ImGuiInputTextFlags_Multiline)) // add by Dicky
+        return InputTextLargeEx(label, hint, buf, buf_size, size_arg, flags, callback, callback_user_data);
 
     ImGuiContext& g = *GImGui;
     ImGuiIO& io = g.IO;
@@ -5447,6 +5449,969 @@ void ImGui::DebugNodeInputTextState(ImGuiInputTextState* state)
 #endif
 }
 
+// add by Dicky
+//-------------------------------------------------------------------------
+// InputTextMultiline() with ImGuiInputTextFlags_LargeText
+//-------------------------------------------------------------------------
+// - ImGuiTextGapBuffer
+// - ImGuiInputTextLargeState
+// - InputTextLargeEx() [Internal]
+//-------------------------------------------------------------------------
+
+void ImGuiTextGapBuffer::assign(const char* text, int len)
+{
+    Data.resize(len + 256);
+    memcpy(Data.Data, text, (size_t)len);
+    GapBegin = len;
+    GapEnd = Data.Size;
+}
+
+bool ImGuiTextGapBuffer::Equals(const char* text, int len) const
+{
+    if (len != size())
+        return false;
+    return len == 0 || (memcmp(Data.Data, text, (size_t)GapBegin) == 0 && memcmp(Data.Data + GapEnd, text + GapBegin, (size_t)(len - GapBegin)) == 0);
+}
+
+void ImGuiTextGapBuffer::MoveGap(int pos)
+{
+    IM_ASSERT(pos >= 0 && pos <= size());
+    const int gap = GapEnd - GapBegin;
+    if (pos < GapBegin)
+        memmove(Data.Data + pos + gap, Data.Data + pos, (size_t)(GapBegin - pos));
+    else if (pos > GapBegin)
+        memmove(Data.Data + GapBegin, Data.Data + GapEnd, (size_t)(pos - GapBegin));
+    GapBegin = pos;
+    GapEnd = pos + gap;
+}
+
+void ImGuiTextGapBuffer::Replace(int pos, int erase_len, const char* text, int text_len)
+{
+    IM_ASSERT(erase_len >= 0 && pos + erase_len <= size());
+    MoveGap(pos);
+    GapEnd += erase_len;
+    if (GapEnd - GapBegin < text_len)
+    {
+        // Grow the gap geometrically, moving the text after it to the end of the new storage
+        const int after_len = Data.Size - GapEnd;
+        const int gap = ImMax(text_len, size() / 2) + 256;
+        Data.resize(GapBegin + gap + after_len);
+        memmove(Data.Data + GapBegin + gap, Data.Data + GapEnd, (size_t)after_len);
+        GapEnd = GapBegin + gap;
+    }
+    if (text_len > 0)
+        memcpy(Data.Data + GapBegin, text, (size_t)text_len);
+    GapBegin += text_len;
+}
+
+void ImGuiTextGapBuffer::CopyTo(char* dst, int begin, int end) const
+{
+    if (begin >= end)
+        return;
+    if (begin < GapBegin)
+    {
+        const int len = ImMin(end, GapBegin) - begin;
+        memcpy(dst, Data.Data + begin, (size_t)len);
+        dst += len;
+        begin += len;
+    }
+    if (begin < end)
+        memcpy(dst, Data.Data + begin + GapEnd - GapBegin, (size_t)(end - begin));
+}
+
+const char* ImGuiTextGapBuffer::GetRange(int begin, int end, ImVector<char>* temp) const
+{
+    if (end <= GapBegin)
+        return Data.Data + begin;
+    if (begin >= GapBegin)
+        return Data.Data + begin + GapEnd - GapBegin;
+    temp->resize(end - begin);
+    CopyTo(temp->Data, begin, end);
+    return temp->Data;
+}
+
+void ImGuiInputTextLargeState::Load(const char* text, int len)
+{
+    Text.assign(text, len);
+    LineStarts.resize(0);
+    LineStarts.push_back(0);
+    for (const char* p = text, *p_end = text + len; (p = (const char*)memchr(p, '\n', (size_t)(p_end - p))) != NULL; p++)
+        LineStarts.push_back((int)(p - text) + 1);
+    PendingLine = LineStarts.Size - 1;
+    PendingDelta = 0;
+    DirtyBegin = INT_MAX;
+    DirtyEnd = 0;
+    DirtyResized = false;
+    Cursor = ImMin(Cursor, len);
+    SelectStart = ImMin(SelectStart, len);
+    SelectEnd = ImMin(SelectEnd, len);
+}
+
+// Make the entries up to 'line' include PendingDelta
+void ImGuiInputTextLargeState::SetPendingLine(int line)
+{
+    for (; PendingLine < line; PendingLine++)
+        LineStarts.Data[PendingLine + 1] += PendingDelta;
+    for (; PendingLine > line; PendingLine--)
+        LineStarts.Data[PendingLine] -= PendingDelta;
+}
+
+int ImGuiInputTextLargeState::FindLine(int pos) const
+{
+    int line_min = 0, line_max = LineStarts.Size - 1;
+    while (line_min < line_max)
+    {
+        const int line = (line_min + line_max + 1) / 2;
+        if (GetLineStart(line) <= pos)
+            line_min = line;
+        else
+            line_max = line - 1;
+    }
+    return line_min;
+}
+
+void ImGuiInputTextLargeState::Replace(int pos, int erase_len, const char* text, int text_len)
+{
+    // Line starts inside the erased range go away, the inserted ones are exact, the following ones are shifted lazily
+    const int line = FindLine(pos);
+    int erased_lines = 0, inserted_lines = 0;
+    for (int n = pos; n < pos + erase_len; n++)
+        erased_lines += (Text[n] == '\n');
+    for (const char* p = text, *p_end = text + text_len; p < p_end && (p = (const char*)memchr(p, '\n', (size_t)(p_end - p))) != NULL; p++)
+        inserted_lines++;
+    SetPendingLine(line);
+    if (inserted_lines != erased_lines)
+    {
+        const int move_count = LineStarts.Size - (line + 1 + erased_lines);
+        if (inserted_lines > erased_lines)
+            LineStarts.resize(LineStarts.Size + inserted_lines - erased_lines);
+        memmove(LineStarts.Data + line + 1 + inserted_lines, LineStarts.Data + line + 1 + erased_lines, (size_t)move_count * sizeof(int));
+        if (inserted_lines < erased_lines)
+            LineStarts.resize(LineStarts.Size + inserted_lines - erased_lines);
+    }
+    int* line_start = LineStarts.Data + line + 1;
+    for (const char* p = text, *p_end = text + text_len; p < p_end && (p = (const char*)memchr(p, '\n', (size_t)(p_end - p))) != NULL; p++)
+        *line_start++ = pos + (int)(p - text) + 1;
+    PendingLine = line + inserted_lines;
+    PendingDelta += text_len - erase_len;
+
+    Text.Replace(pos, erase_len, text, text_len);
+    DirtyBegin = ImMin(DirtyBegin, pos);
+    DirtyEnd = ImMax(DirtyEnd, pos + text_len);
+    DirtyResized |= (text_len != erase_len);
+}
+
+static unsigned int InputTextLargeGetChar(const ImGuiTextGapBuffer& text, int pos)
+{
+    const int len = ImMin(4, text.size() - pos);
+    if (len <= 0)
+        return 0;
+    char s[4];
+    for (int n = 0; n < len; n++)
+        s[n] = text[pos + n];
+    unsigned int c;
+    ImTextCharFromUtf8(&c, s, s + len);
+    return c;
+}
+
+static int InputTextLargeNextChar(const ImGuiTextGapBuffer& text, int pos)
+{
+    const int len = text.size();
+    if (pos < len)
+        pos++;
+    while (pos < len && (text[pos] & 0xC0) == 0x80)
+        pos++;
+    return pos;
+}
+
+static int InputTextLargePrevChar(const ImGuiTextGapBuffer& text, int pos)
+{
+    if (pos > 0)
+        pos--;
+    while (pos > 0 && (text[pos] & 0xC0) == 0x80)
+        pos--;
+    return pos;
+}
+
+// Same rules as is_word_boundary_from_right() and is_word_boundary_from_left() for stb_textedit
+static bool InputTextLargeIsWordBoundary(const ImGuiTextGapBuffer& text, int pos, bool from_right)
+{
+    if (pos <= 0)
+        return false;
+    const unsigned int c_prev = InputTextLargeGetChar(text, InputTextLargePrevChar(text, pos));
+    const unsigned int c_curr = InputTextLargeGetChar(text, pos);
+    if (from_right)
+        return ((ImCharIsBlankW(c_prev) || ImStb::is_separator(c_prev)) && !(ImStb::is_separator(c_curr) || ImCharIsBlankW(c_curr))) || (ImStb::is_separator(c_curr) && !ImStb::is_separator(c_prev));
+    return (ImCharIsBlankW(c_curr) && !(ImStb::is_separator(c_prev) || ImCharIsBlankW(c_prev))) || (ImStb::is_separator(c_prev) && !ImStb::is_separator(c_curr));
+}
+
+static int InputTextLargeMoveWordLeft(const ImGuiTextGapBuffer& text, int pos)
+{
+    pos = InputTextLargePrevChar(text, pos);
+    while (pos > 0 && !InputTextLargeIsWordBoundary(text, pos, true))
+        pos = InputTextLargePrevChar(text, pos);
+    return pos;
+}
+
+static int InputTextLargeMoveWordRight(const ImGuiTextGapBuffer& text, int pos, bool is_osx)
+{
+    const int len = text.size();
+    pos = InputTextLargeNextChar(text, pos);
+    while (pos < len && !InputTextLargeIsWordBoundary(text, pos, !is_osx)) // Same as STB_TEXTEDIT_MOVEWORDRIGHT_MAC / _WIN
+        pos = InputTextLargeNextChar(text, pos);
+    return pos;
+}
+
+// Width of a single line of text
+static float InputTextLargeCalcWidth(ImGuiContext* ctx, const char* text, const char* text_end)
+{
+    ImGuiContext& g = *ctx;
+    float line_width = 0.0f;
+    for (const char* s = text; s < text_end; )
+    {
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+        line_width += g.Font->GetCharAdvance((ImWchar)c);
+    }
+    return line_width * g.FontScale;
+}
+
+// Character boundary of a single line of text at 'x': the closest one when 'round', else the last one before 'x'
+static const char* InputTextLargeFindX(ImGuiContext* ctx, const char* text, const char* text_end, float x, bool round, float* out_x)
+{
+    ImGuiContext& g = *ctx;
+    float line_width = 0.0f;
+    const char* s = text;
+    while (s < text_end)
+    {
+        unsigned int c = (unsigned int)*s;
+        const int bytes = (c < 0x80) ? 1 : ImTextCharFromUtf8(&c, s, text_end);
+        const float char_width = g.Font->GetCharAdvance((ImWchar)c) * g.FontScale;
+        if (line_width + (round ? char_width * 0.5f : char_width) > x)
+            break;
+        line_width += char_width;
+        s += bytes;
+    }
+    if (out_x)
+        *out_x = line_width;
+    return s;
+}
+
+static float InputTextLargeGetX(ImGuiContext* ctx, ImGuiInputTextLargeState* state, int pos)
+{
+    const int line_start = state->GetLineStart(state->FindLine(pos));
+    const char* text = state->Text.GetRange(line_start, pos, &state->TempText);
+    return InputTextLargeCalcWidth(ctx, text, text + pos - line_start);
+}
+
+static int InputTextLargeFindPos(ImGuiContext* ctx, ImGuiInputTextLargeState* state, int line, float x)
+{
+    line = ImClamp(line, 0, state->GetLineCount() - 1);
+    const int line_start = state->GetLineStart(line);
+    const int line_end = state->GetLineEnd(line);
+    const char* text = state->Text.GetRange(line_start, line_end, &state->TempText);
+    return line_start + (int)(InputTextLargeFindX(ctx, text, text + line_end - line_start, x, true, NULL) - text);
+}
+
+static void InputTextLargeMoveCursor(ImGuiInputTextLargeState* state, int pos, bool select)
+{
+    if (select && !state->HasSelection())
+        state->SelectStart = state->Cursor;
+    state->Cursor = state->SelectEnd = pos;
+    if (!select)
+        state->SelectStart = pos;
+    state->PreferredX = -1.0f;
+    state->CursorFollow = true;
+    state->CursorAnimReset();
+}
+
+static void InputTextLargeMoveCursorLines(ImGuiContext* ctx, ImGuiInputTextLargeState* state, int line_delta, bool select)
+{
+    const float x = (state->PreferredX >= 0.0f) ? state->PreferredX : InputTextLargeGetX(ctx, state, state->Cursor);
+    const int line = state->FindLine(state->Cursor) + line_delta;
+    int pos = (line < 0) ? 0 : (line >= state->GetLineCount()) ? state->Text.size() : InputTextLargeFindPos(ctx, state, line, x);
+    InputTextLargeMoveCursor(state, pos, select);
+    state->PreferredX = x;
+}
+
+// Apply an edit to the text, and record it for ImGuiInputTextFlags_CallbackEdit
+static void InputTextLargeReplace(ImGuiInputTextLargeState* state, int pos, int erase_len, const char* text, int text_len)
+{
+    if (state->Flags & ImGuiInputTextFlags_CallbackEdit)
+    {
+        ImGuiInputTextLargeEdit edit = { pos, erase_len, text_len, state->FrameEditsText.Size };
+        state->FrameEdits.push_back(edit);
+        state->FrameEditsText.resize(state->FrameEditsText.Size + text_len);
+        if (text_len > 0)
+            memcpy(state->FrameEditsText.Data + edit.TextOffset, text, (size_t)text_len);
+    }
+    state->Replace(pos, erase_len, text, text_len);
+}
+
+static void InputTextLargePushUndo(ImGuiInputTextLargeState* state, int pos, int erase_len, const char* text, int text_len, bool merge)
+{
+    // A new edit drops the redo records
+    if (state->UndoPoint < state->UndoEdits.Size)
+    {
+        state->UndoText.resize(state->UndoEdits[state->UndoPoint].TextOffset);
+        state->UndoEdits.resize(state->UndoPoint);
+        if (state->RevertUndoPoint > state->UndoPoint)
+            state->RevertUndoPoint = -1;
+    }
+
+    // Typing merges into the previous insertion, unless that one was made before activation
+    ImGuiInputTextLargeEdit* last = state->UndoEdits.Size > 0 ? &state->UndoEdits.back() : NULL;
+    if (merge && erase_len == 0 && last && last->DeletedLen == 0 && last->Offset + last->InsertedLen == pos && state->UndoEdits.Size > state->RevertUndoPoint)
+    {
+        last->InsertedLen += text_len;
+    }
+    else
+    {
+        ImGuiInputTextLargeEdit edit = { pos, erase_len, text_len, state->UndoText.Size };
+        state->UndoEdits.push_back(edit);
+        state->UndoText.resize(state->UndoText.Size + erase_len);
+        state->Text.CopyTo(state->UndoText.Data + edit.TextOffset, pos, pos + erase_len);
+    }
+    state->UndoText.resize(state->UndoText.Size + text_len);
+    if (text_len > 0)
+        memcpy(state->UndoText.Data + state->UndoText.Size - text_len, text, (size_t)text_len);
+    state->UndoPoint = state->UndoEdits.Size;
+
+    // Drop the oldest records over the size limit
+    int drop_count = 0, drop_size = 0;
+    while (drop_count < state->UndoEdits.Size && state->UndoText.Size - drop_size > IMGUI_INPUT_TEXT_LARGE_UNDO_SIZE)
+    {
+        drop_size += state->UndoEdits[drop_count].DeletedLen + state->UndoEdits[drop_count].InsertedLen;
+        drop_count++;
+    }
+    if (drop_count > 0)
+    {
+        memmove(state->UndoText.Data, state->UndoText.Data + drop_size, (size_t)(state->UndoText.Size - drop_size));
+        state->UndoText.resize(state->UndoText.Size - drop_size);
+        state->UndoEdits.erase(state->UndoEdits.Data, state->UndoEdits.Data + drop_count);
+        for (ImGuiInputTextLargeEdit& edit : state->UndoEdits)
+            edit.TextOffset -= drop_size;
+        state->UndoPoint -= drop_count;
+        state->RevertUndoPoint = (state->RevertUndoPoint >= drop_count) ? state->RevertUndoPoint - drop_count : -1;
+    }
+}
+
+// Replace the selection (or insert at the cursor), the text is cut to the user buffer capacity unless it can be resized
+static void InputTextLargeEdit(ImGuiInputTextLargeState* state, const char* text, int text_len, bool merge_undo = false)
+{
+    const int pos = state->HasSelection() ? state->GetSelectionMin() : state->Cursor;
+    const int erase_len = state->HasSelection() ? state->GetSelectionMax() - pos : 0;
+    if (!(state->Flags & ImGuiInputTextFlags_CallbackResize))
+    {
+        const int text_len_max = ImMax(state->BufCapacity - 1 - (state->Text.size() - erase_len), 0);
+        if (text_len > text_len_max)
+        {
+            text_len = text_len_max;
+            while (text_len > 0 && (text[text_len] & 0xC0) == 0x80)
+                text_len--;
+        }
+    }
+    if (erase_len == 0 && text_len == 0)
+        return;
+    InputTextLargePushUndo(state, pos, erase_len, text, text_len, merge_undo);
+    InputTextLargeReplace(state, pos, erase_len, text, text_len);
+    InputTextLargeMoveCursor(state, pos + text_len, false);
+}
+
+static void InputTextLargeUndo(ImGuiInputTextLargeState* state, bool redo)
+{
+    if (redo ? (state->UndoPoint >= state->UndoEdits.Size) : (state->UndoPoint <= 0))
+        return;
+    const ImGuiInputTextLargeEdit edit = state->UndoEdits[redo ? state->UndoPoint++ : --state->UndoPoint];
+    const char* deleted_text = state->UndoText.Data + edit.TextOffset;
+    const char* inserted_text = deleted_text + edit.DeletedLen;
+    if (redo)
+        InputTextLargeReplace(state, edit.Offset, edit.DeletedLen, inserted_text, edit.InsertedLen);
+    else
+        InputTextLargeReplace(state, edit.Offset, edit.InsertedLen, deleted_text, edit.DeletedLen);
+    InputTextLargeMoveCursor(state, edit.Offset + (redo ? edit.InsertedLen : edit.DeletedLen), false);
+}
+
+static void InputTextLargeInsertChar(ImGuiContext* ctx, ImGuiInputTextLargeState* state, unsigned int c, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* user_data)
+{
+    if (!InputTextFilterCharacter(ctx, &c, flags, callback, user_data))
+        return;
+    char utf8[5];
+    ImTextCharToUtf8(utf8, c);
+    InputTextLargeEdit(state, utf8, (int)strlen(utf8), c != '\n');
+}
+
+// Draw a single line of text, skipping the characters outside of [clip_x0, clip_x1)
+static void InputTextLargeRenderLine(ImGuiContext* ctx, ImDrawList* draw_list, ImVec2 pos, ImU32 col, const char* text, const char* text_end, float clip_x0, float clip_x1)
+{
+    float skip_width = 0.0f;
+    const char* visible_begin = InputTextLargeFindX(ctx, text, text_end, clip_x0 - pos.x, false, &skip_width);
+    pos.x += skip_width;
+    const char* visible_end = InputTextLargeFindX(ctx, visible_begin, text_end, clip_x1 - pos.x + ctx->FontSize, false, NULL);
+    if (visible_begin < visible_end)
+        draw_list->AddText(ctx->Font, ctx->FontSize, pos, col, visible_begin, visible_end);
+}
+
+// InputTextMultiline() with ImGuiInputTextFlags_LargeText: the regular path converts the whole text to ImWchar and lays it out from the start
+// for each edit, here we keep the UTF-8 text in a gap buffer indexed by line starts.
+// - In the gap buffer an edit costs its size plus the distance from the previous edit (gap move, pending line starts).
+// - Only the visible lines are laid out, and only their visible part.
+// - The changed range is copied back to 'buf' once per frame, ImGuiInputTextFlags_CallbackEdit then reports each edit. 'buf' is a flat
+//   string: when the length changes, everything from the first edit to the end is copied, so typing near the start of a big text
+//   costs a copy of the text per frame (memcpy speed).
+// - Linear scans left, all at memcpy/memchr speed: activation copies 'buf' and builds the line index, a read-only active widget compares
+//   'buf' with its copy every frame (strlen + memcmp), and the inactive display walks the whole of 'buf' every frame with memchr to
+//   find the visible lines and count the others.
+// - Escape undoes back to the activation text (unless the undo stack was trimmed, see IMGUI_INPUT_TEXT_LARGE_UNDO_SIZE).
+bool ImGui::InputTextLargeEx(const char* label, const char* hint, char* buf, int buf_size, const ImVec2& size_arg, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* callback_user_data)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+
+    IM_ASSERT(buf != NULL && buf_size >= 0);
+    IM_ASSERT((flags & ImGuiInputTextFlags_Multiline) && !(flags & ImGuiInputTextFlags_Password)); // Only for InputTextMultiline(), without password display
+
+    ImGuiContext& g = *GImGui;
+    ImGuiIO& io = g.IO;
+    const ImGuiStyle& style = g.Style;
+
+    BeginGroup(); // Open group before calling GetID() because groups tracks id created within their scope (including the scrollbar)
+    const ImGuiID id = window->GetID(label);
+    const ImVec2 label_size = CalcTextSize(label, NULL, true);
+    const ImVec2 frame_size = CalcItemSize(size_arg, CalcItemWidth(), g.FontSize * 8.0f + style.FramePadding.y * 2.0f);
+    const ImVec2 total_size = ImVec2(frame_size.x + (label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f), frame_size.y);
+    const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + frame_size);
+    const ImRect total_bb(frame_bb.Min, frame_bb.Min + total_size);
+
+    // Same child window as InputTextEx()
+    ImVec2 backup_pos = window->DC.CursorPos;
+    ItemSize(total_bb, style.FramePadding.y);
+    if (!ItemAdd(total_bb, id, &frame_bb, ImGuiItemFlags_Inputable))
+    {
+        EndGroup();
+        return false;
+    }
+    ImGuiLastItemData item_data_backup = g.LastItemData;
+    window->DC.CursorPos = backup_pos;
+    if (g.NavActivateId == id && (g.NavActivateFlags & ImGuiActivateFlags_FromTabbing) && (flags & ImGuiInputTextFlags_AllowTabInput))
+        g.NavActivateId = 0;
+    const ImGuiID backup_activate_id = g.NavActivateId;
+    if (g.ActiveId == id) // Prevent reactivation
+        g.NavActivateId = 0;
+    PushStyleColor(ImGuiCol_ChildBg, style.Colors[ImGuiCol_FrameBg]);
+    PushStyleVar(ImGuiStyleVar_ChildRounding, style.FrameRounding);
+    PushStyleVar(ImGuiStyleVar_ChildBorderSize, style.FrameBorderSize);
+    PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
+    bool child_visible = BeginChildEx(label, id, frame_bb.GetSize(), ImGuiChildFlags_Border, ImGuiWindowFlags_NoMove);
+    g.NavActivateId = backup_activate_id;
+    PopStyleVar(3);
+    PopStyleColor();
+    if (!child_visible)
+    {
+        EndChild();
+        EndGroup();
+        return false;
+    }
+    ImGuiWindow* draw_window = g.CurrentWindow;
+    draw_window->DC.NavLayersActiveMaskNext |= (1 << draw_window->DC.NavLayerCurrent);
+    draw_window->DC.CursorPos += style.FramePadding;
+    const ImVec2 inner_size(frame_size.x - draw_window->ScrollbarSizes.x, frame_size.y);
+
+    const bool hovered = ItemHoverable(frame_bb, id, g.LastItemData.InFlags);
+    if (hovered)
+        g.MouseCursor = ImGuiMouseCursor_TextInput;
+
+    // We are only allowed to access the state if we are already the active widget.
+    ImGuiInputTextLargeState* state = GetInputTextLargeState(id);
+
+    if (g.LastItemData.InFlags & ImGuiItemFlags_ReadOnly)
+        flags |= ImGuiInputTextFlags_ReadOnly;
+    const bool is_readonly = (flags & ImGuiInputTextFlags_ReadOnly) != 0;
+    const bool is_undoable = (flags & ImGuiInputTextFlags_NoUndoRedo) == 0;
+    const bool is_resizable = (flags & ImGuiInputTextFlags_CallbackResize) != 0;
+    if (is_resizable)
+        IM_ASSERT(callback != NULL); // Must provide a callback if you set the ImGuiInputTextFlags_CallbackResize flag!
+
+    const bool input_requested_by_nav = (g.ActiveId != id) && ((g.NavActivateId == id) && ((g.NavActivateFlags & ImGuiActivateFlags_PreferInput) || (g.NavInputSource == ImGuiInputSource_Keyboard)));
+    const bool user_clicked = hovered && io.MouseClicked[0];
+    const bool user_scroll_finish = state != NULL && g.ActiveId == 0 && g.ActiveIdPreviousFrame == GetWindowScrollbarID(draw_window, ImGuiAxis_Y);
+    const bool init_make_active = (user_clicked || user_scroll_finish || input_requested_by_nav);
+    bool clear_active_id = false;
+    float scroll_y = draw_window->Scroll.y;
+
+    if (init_make_active && g.ActiveId != id)
+    {
+        // Preserve cursor position and undo/redo stack if we come back to same widget with the same text
+        state = &g.InputTextLargeState;
+        const int buf_len = (int)strlen(buf);
+        if (state->ID != id || !state->Text.Equals(buf, buf_len))
+        {
+            state->Cursor = state->SelectStart = state->SelectEnd = 0;
+            state->Load(buf, buf_len);
+            state->UndoEdits.resize(0);
+            state->UndoText.resize(0);
+            state->UndoPoint = 0;
+            state->ScrollX = 0.0f;
+        }
+        state->ID = id;
+        state->PreferredX = -1.0f;
+        state->RevertUndoPoint = state->UndoPoint;
+        state->CursorAnimReset();
+        SetActiveID(id, window);
+        SetFocusID(id, window);
+        FocusWindow(window);
+    }
+    const bool is_osx = io.ConfigMacOSXBehaviors;
+    if (g.ActiveId == id)
+    {
+        if (user_clicked)
+            SetKeyOwner(ImGuiKey_MouseLeft, id);
+        g.ActiveIdUsingNavDirMask |= (1 << ImGuiDir_Left) | (1 << ImGuiDir_Right) | (1 << ImGuiDir_Up) | (1 << ImGuiDir_Down);
+        SetKeyOwner(ImGuiKey_Enter, id);
+        SetKeyOwner(ImGuiKey_KeypadEnter, id);
+        SetKeyOwner(ImGuiKey_Home, id);
+        SetKeyOwner(ImGuiKey_End, id);
+        SetKeyOwner(ImGuiKey_PageUp, id);
+        SetKeyOwner(ImGuiKey_PageDown, id);
+        if (is_osx)
+            SetKeyOwner(ImGuiMod_Alt, id);
+    }
+    if (g.ActiveId == id && state == NULL)
+        ClearActiveID();
+    if (g.ActiveId == id && io.MouseClicked[0] && !init_make_active)
+        clear_active_id = true;
+
+    // Read-only text may change while we display it
+    if (g.ActiveId == id && is_readonly)
+    {
+        const int buf_len = (int)strlen(buf);
+        if (!state->Text.Equals(buf, buf_len))
+            state->Load(buf, buf_len);
+    }
+
+    bool render_cursor = (g.ActiveId == id);
+    bool value_changed = false;
+    bool validated = false;
+
+    // Process mouse inputs and character inputs
+    if (g.ActiveId == id)
+    {
+        state->Flags = flags;
+        state->BufCapacity = buf_size;
+        state->FrameEdits.resize(0);
+        state->FrameEditsText.resize(0);
+        g.ActiveIdAllowOverlap = !io.MouseDown[0];
+
+        const float mouse_x = (io.MousePos.x - draw_window->DC.CursorPos.x) + state->ScrollX;
+        const int mouse_line = (int)ImFloor(ImClamp((io.MousePos.y - draw_window->DC.CursorPos.y) / g.FontSize, -1.0f, (float)state->GetLineCount()));
+        if (hovered && io.MouseClickedCount[0] >= 2 && !io.KeyShift)
+        {
+            const int pos = InputTextLargeFindPos(&g, state, mouse_line, mouse_x);
+            const int line = state->FindLine(pos);
+            if (((io.MouseClickedCount[0] - 2) % 2) == 0)
+            {
+                // Double-click: Select word
+                int word_begin = pos;
+                if (word_begin > state->GetLineStart(line) && !InputTextLargeIsWordBoundary(state->Text, word_begin, true))
+                    word_begin = InputTextLargeMoveWordLeft(state->Text, word_begin);
+                InputTextLargeMoveCursor(state, word_begin, false);
+                InputTextLargeMoveCursor(state, InputTextLargeMoveWordRight(state->Text, word_begin, true), true);
+            }
+            else
+            {
+                // Triple-click: Select line
+                InputTextLargeMoveCursor(state, state->GetLineStart(line), false);
+                InputTextLargeMoveCursor(state, line + 1 < state->GetLineCount() ? state->GetLineStart(line + 1) : state->Text.size(), true);
+                state->CursorFollow = false;
+            }
+        }
+        else if (io.MouseClicked[0] && hovered)
+        {
+            InputTextLargeMoveCursor(state, InputTextLargeFindPos(&g, state, mouse_line, mouse_x), io.KeyShift);
+        }
+        else if (io.MouseDown[0] && !init_make_active && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f))
+        {
+            InputTextLargeMoveCursor(state, InputTextLargeFindPos(&g, state, mouse_line, mouse_x), true);
+        }
+
+        if ((flags & ImGuiInputTextFlags_AllowTabInput) && !is_readonly && Shortcut(ImGuiKey_Tab, ImGuiInputFlags_Repeat, id))
+            InputTextLargeInsertChar(&g, state, '\t', flags, callback, callback_user_data);
+
+        // Process regular text input (before we check for Return because using some IME will effectively send a Return?)
+        const bool ignore_char_inputs = (io.KeyCtrl && !io.KeyAlt) || (is_osx && io.KeyCtrl);
+        if (io.InputQueueCharacters.Size > 0)
+        {
+            if (!ignore_char_inputs && !is_readonly && !input_requested_by_nav)
+                for (int n = 0; n < io.InputQueueCharacters.Size; n++)
+                    if (io.InputQueueCharacters[n] != '\t') // Skip Tab, see InputTextEx()
+                        InputTextLargeInsertChar(&g, state, (unsigned int)io.InputQueueCharacters[n], flags, callback, callback_user_data);
+            io.InputQueueCharacters.resize(0);
+        }
+    }
+
+    // Process other shortcuts/key-presses
+    if (g.ActiveId == id && !g.ActiveIdIsJustActivated && !clear_active_id)
+    {
+        const int row_count_per_page = ImMax((int)((inner_size.y - style.FramePadding.y) / g.FontSize), 1);
+        const bool is_shift = io.KeyShift;
+        const bool is_wordmove_key_down = is_osx ? io.KeyAlt : io.KeyCtrl;
+        const bool is_startend_key_down = is_osx && io.KeyCtrl && !io.KeySuper && !io.KeyAlt;
+
+        const ImGuiInputFlags f_repeat = ImGuiInputFlags_Repeat;
+        const bool is_cut   = (Shortcut(ImGuiMod_Ctrl | ImGuiKey_X, f_repeat, id) || Shortcut(ImGuiMod_Shift | ImGuiKey_Delete, f_repeat, id)) && !is_readonly && state->HasSelection();
+        const bool is_copy  = (Shortcut(ImGuiMod_Ctrl | ImGuiKey_C, 0,        id) || Shortcut(ImGuiMod_Ctrl  | ImGuiKey_Insert, 0,        id)) && state->HasSelection();
+        const bool is_paste = (Shortcut(ImGuiMod_Ctrl | ImGuiKey_V, f_repeat, id) || Shortcut(ImGuiMod_Shift | ImGuiKey_Insert, f_repeat, id)) && !is_readonly;
+        const bool is_undo  = (Shortcut(ImGuiMod_Ctrl | ImGuiKey_Z, f_repeat, id)) && !is_readonly && is_undoable;
+        const bool is_redo =  (Shortcut(ImGuiMod_Ctrl | ImGuiKey_Y, f_repeat, id) || (is_osx && Shortcut(ImGuiMod_Ctrl | ImGuiMod_Shift | ImGuiKey_Z, f_repeat, id))) && !is_readonly && is_undoable;
+        const bool is_select_all = Shortcut(ImGuiMod_Ctrl | ImGuiKey_A, 0, id);
+
+        const bool nav_gamepad_active = (io.ConfigFlags & ImGuiConfigFlags_NavEnableGamepad) != 0 && (io.BackendFlags & ImGuiBackendFlags_HasGamepad) != 0;
+        const bool is_enter_pressed = IsKeyPressed(ImGuiKey_Enter, true) || IsKeyPressed(ImGuiKey_KeypadEnter, true);
+        const bool is_gamepad_validate = nav_gamepad_active && (IsKeyPressed(ImGuiKey_NavGamepadActivate, false) || IsKeyPressed(ImGuiKey_NavGamepadInput, false));
+        const bool is_cancel = Shortcut(ImGuiKey_Escape, f_repeat, id) || (nav_gamepad_active && Shortcut(ImGuiKey_NavGamepadCancel, f_repeat, id));
+
+        const ImGuiTextGapBuffer& text = state->Text;
+        const int cursor_line = state->FindLine(state->Cursor);
+        if (IsKeyPressed(ImGuiKey_LeftArrow))
+        {
+            if (state->HasSelection() && !is_shift && !is_startend_key_down && !is_wordmove_key_down)
+                InputTextLargeMoveCursor(state, state->GetSelectionMin(), false);
+            else
+                InputTextLargeMoveCursor(state, is_startend_key_down ? state->GetLineStart(cursor_line) : is_wordmove_key_down ? InputTextLargeMoveWordLeft(text, state->Cursor) : InputTextLargePrevChar(text, state->Cursor), is_shift);
+        }
+        else if (IsKeyPressed(ImGuiKey_RightArrow))
+        {
+            if (state->HasSelection() && !is_shift && !is_startend_key_down && !is_wordmove_key_down)
+                InputTextLargeMoveCursor(state, state->GetSelectionMax(), false);
+            else
+                InputTextLargeMoveCursor(state, is_startend_key_down ? state->GetLineEnd(cursor_line) : is_wordmove_key_down ? InputTextLargeMoveWordRight(text, state->Cursor, is_osx) : InputTextLargeNextChar(text, state->Cursor), is_shift);
+        }
+        else if (IsKeyPressed(ImGuiKey_UpArrow))
+        {
+            if (io.KeyCtrl) SetScrollY(draw_window, ImMax(draw_window->Scroll.y - g.FontSize, 0.0f));
+            else if (is_startend_key_down) InputTextLargeMoveCursor(state, 0, is_shift);
+            else InputTextLargeMoveCursorLines(&g, state, -1, is_shift);
+        }
+        else if (IsKeyPressed(ImGuiKey_DownArrow))
+        {
+            if (io.KeyCtrl) SetScrollY(draw_window, ImMin(draw_window->Scroll.y + g.FontSize, GetScrollMaxY()));
+            else if (is_startend_key_down) InputTextLargeMoveCursor(state, text.size(), is_shift);
+            else InputTextLargeMoveCursorLines(&g, state, +1, is_shift);
+        }
+        else if (IsKeyPressed(ImGuiKey_PageUp))                      { InputTextLargeMoveCursorLines(&g, state, -row_count_per_page, is_shift); scroll_y -= row_count_per_page * g.FontSize; }
+        else if (IsKeyPressed(ImGuiKey_PageDown))                    { InputTextLargeMoveCursorLines(&g, state, +row_count_per_page, is_shift); scroll_y += row_count_per_page * g.FontSize; }
+        else if (IsKeyPressed(ImGuiKey_Home))                        { InputTextLargeMoveCursor(state, io.KeyCtrl ? 0 : state->GetLineStart(cursor_line), is_shift); }
+        else if (IsKeyPressed(ImGuiKey_End))                         { InputTextLargeMoveCursor(state, io.KeyCtrl ? text.size() : state->GetLineEnd(cursor_line), is_shift); }
+        else if (IsKeyPressed(ImGuiKey_Delete) && !is_readonly && !is_cut)
+        {
+            if (!state->HasSelection())
+                InputTextLargeMoveCursor(state, is_wordmove_key_down ? InputTextLargeMoveWordRight(text, state->Cursor, is_osx) : InputTextLargeNextChar(text, state->Cursor), true);
+            InputTextLargeEdit(state, NULL, 0);
+        }
+        else if (IsKeyPressed(ImGuiKey_Backspace) && !is_readonly)
+        {
+            if (!state->HasSelection())
+            {
+                if (is_wordmove_key_down)
+                    InputTextLargeMoveCursor(state, InputTextLargeMoveWordLeft(text, state->Cursor), true);
+                else if (is_osx && io.KeyCtrl && !io.KeyAlt && !io.KeySuper)
+                    InputTextLargeMoveCursor(state, state->GetLineStart(cursor_line), true);
+                else
+                    InputTextLargeMoveCursor(state, InputTextLargePrevChar(text, state->Cursor), true);
+            }
+            InputTextLargeEdit(state, NULL, 0);
+        }
+        else if (is_enter_pressed || is_gamepad_validate)
+        {
+            // Determine if we turn Enter into a \n character
+            bool ctrl_enter_for_new_line = (flags & ImGuiInputTextFlags_CtrlEnterForNewLine) != 0;
+            if (is_gamepad_validate || (ctrl_enter_for_new_line && !io.KeyCtrl) || (!ctrl_enter_for_new_line && io.KeyCtrl))
+                validated = clear_active_id = true;
+            else if (!is_readonly)
+                InputTextLargeInsertChar(&g, state, '\n', flags, callback, callback_user_data);
+        }
+        else if (is_cancel)
+        {
+            if ((flags & ImGuiInputTextFlags_EscapeClearsAll) && text.size() > 0 && !is_readonly)
+            {
+                state->SelectAll();
+                InputTextLargeEdit(state, NULL, 0);
+            }
+            else
+            {
+                // Revert by undoing the edits made since activation, they can be redone
+                if (!is_readonly && state->RevertUndoPoint >= 0)
+                    while (state->UndoPoint > state->RevertUndoPoint)
+                        InputTextLargeUndo(state, false);
+                clear_active_id = true;
+                render_cursor = false;
+            }
+        }
+        else if (is_undo || is_redo)
+        {
+            InputTextLargeUndo(state, is_redo);
+        }
+        else if (is_select_all)
+        {
+            state->SelectAll();
+            state->CursorFollow = true;
+        }
+        else if (is_cut || is_copy)
+        {
+            if (io.SetClipboardTextFn)
+            {
+                const int ib = state->GetSelectionMin();
+                const int ie = state->GetSelectionMax();
+                state->TempText.resize(ie - ib + 1);
+                text.CopyTo(state->TempText.Data, ib, ie);
+                state->TempText[ie - ib] = 0;
+                SetClipboardText(state->TempText.Data);
+            }
+            if (is_cut)
+                InputTextLargeEdit(state, NULL, 0);
+        }
+        else if (is_paste)
+        {
+            if (const char* clipboard = GetClipboardText())
+            {
+                // Filter pasted buffer
+                ImVector<char>& clipboard_filtered = state->TempText;
+                clipboard_filtered.resize(0);
+                for (const char* s = clipboard; *s != 0; )
+                {
+                    unsigned int c;
+                    s += ImTextCharFromUtf8(&c, s, NULL);
+                    if (!InputTextFilterCharacter(&g, &c, flags, callback, callback_user_data, true))
+                        continue;
+                    char utf8[5];
+                    ImTextCharToUtf8(utf8, c);
+                    for (const char* p = utf8; *p != 0; p++)
+                        clipboard_filtered.push_back(*p);
+                }
+                if (clipboard_filtered.Size > 0) // If everything was filtered, ignore the pasting operation
+                    InputTextLargeEdit(state, clipboard_filtered.Data, clipboard_filtered.Size);
+            }
+        }
+    }
+
+    // Copy the changed range back to user's buffer, then report the edits
+    if (g.ActiveId == id && !is_readonly && (state->DirtyBegin < state->DirtyEnd || state->DirtyResized))
+    {
+        const int text_len = state->Text.size();
+        if (is_resizable && state->DirtyResized)
+        {
+            ImGuiInputTextCallbackData callback_data;
+            callback_data.Ctx = &g;
+            callback_data.EventFlag = ImGuiInputTextFlags_CallbackResize;
+            callback_data.Flags = flags;
+            callback_data.Buf = buf;
+            callback_data.BufTextLen = text_len;
+            callback_data.BufSize = ImMax(buf_size, text_len + 1);
+            callback_data.UserData = callback_user_data;
+            callback(&callback_data);
+            buf = callback_data.Buf;
+            buf_size = callback_data.BufSize;
+        }
+
+        // If the underlying buffer resize was denied, the text is cut like in InputTextEx()
+        const int copy_end = ImMin(state->DirtyResized ? text_len : state->DirtyEnd, buf_size - 1);
+        if (state->DirtyBegin < copy_end)
+            state->Text.CopyTo(buf + state->DirtyBegin, state->DirtyBegin, copy_end);
+        if (state->DirtyResized && buf_size > 0)
+            buf[ImMin(text_len, buf_size - 1)] = 0;
+        state->DirtyBegin = INT_MAX;
+        state->DirtyEnd = 0;
+        state->DirtyResized = false;
+        value_changed = true;
+
+        if (flags & ImGuiInputTextFlags_CallbackEdit)
+            for (const ImGuiInputTextLargeEdit& edit : state->FrameEdits)
+            {
+                ImGuiInputTextCallbackData callback_data;
+                callback_data.Ctx = &g;
+                callback_data.EventFlag = ImGuiInputTextFlags_CallbackEdit;
+                callback_data.Flags = flags;
+                callback_data.UserData = callback_user_data;
+                callback_data.Buf = buf;
+                callback_data.BufTextLen = ImMin(text_len, buf_size - 1);
+                callback_data.BufSize = buf_size;
+                callback_data.CursorPos = state->Cursor;
+                callback_data.SelectionStart = state->SelectStart;
+                callback_data.SelectionEnd = state->SelectEnd;
+                callback_data.EditOffset = edit.Offset;
+                callback_data.EditDeletedLen = edit.DeletedLen;
+                callback_data.EditInsertedText = state->FrameEditsText.Data + edit.TextOffset;
+                callback_data.EditInsertedLen = edit.InsertedLen;
+                callback(&callback_data);
+            }
+    }
+
+    // Release active ID at the end of the function (so e.g. pressing Return still does a final application of the value)
+    if (g.ActiveId == id && clear_active_id)
+        ClearActiveID();
+    else if (g.ActiveId == id)
+        g.WantTextInputNextFrame = 1;
+
+    // Render only the visible lines
+    const ImRect clip_rect = draw_window->ClipRect;
+    const ImU32 col = GetColorU32(ImGuiCol_Text);
+    ImVec2 draw_pos = draw_window->DC.CursorPos;
+    int line_count = 0;
+    PushStyleVar(ImGuiStyleVar_TextInternationalize, 0);
+    if (render_cursor)
+    {
+        line_count = state->GetLineCount();
+        const int cursor_line = state->FindLine(state->Cursor);
+        const ImVec2 cursor_offset(InputTextLargeGetX(&g, state, state->Cursor), (cursor_line + 1) * g.FontSize);
+
+        // Scroll
+        if (state->CursorFollow)
+        {
+            // Horizontal scroll in chunks of quarter width
+            if (!(flags & ImGuiInputTextFlags_NoHorizontalScroll))
+            {
+                const float scroll_increment_x = inner_size.x * 0.25f;
+                const float visible_width = inner_size.x - style.FramePadding.x;
+                if (cursor_offset.x < state->ScrollX)
+                    state->ScrollX = IM_TRUNC(ImMax(0.0f, cursor_offset.x - scroll_increment_x));
+                else if (cursor_offset.x - visible_width >= state->ScrollX)
+                    state->ScrollX = IM_TRUNC(cursor_offset.x - visible_width + scroll_increment_x);
+            }
+            else
+            {
+                state->ScrollX = 0.0f;
+            }
+
+            // Vertical scroll
+            if (cursor_offset.y - g.FontSize < scroll_y)
+                scroll_y = ImMax(0.0f, cursor_offset.y - g.FontSize);
+            else if (cursor_offset.y - (inner_size.y - style.FramePadding.y * 2.0f) >= scroll_y)
+                scroll_y = cursor_offset.y - inner_size.y + style.FramePadding.y * 2.0f;
+            state->CursorFollow = false;
+        }
+        const float scroll_max_y = ImMax((line_count * g.FontSize + style.FramePadding.y * 2.0f) - inner_size.y, 0.0f);
+        scroll_y = ImClamp(scroll_y, 0.0f, scroll_max_y);
+        draw_pos.y += (draw_window->Scroll.y - scroll_y);   // Manipulate cursor pos immediately avoid a frame of lag
+        draw_window->Scroll.y = scroll_y;
+
+        // Draw selection and text
+        const int line_visible_begin = ImClamp((int)((clip_rect.Min.y - draw_pos.y) / g.FontSize), 0, line_count);
+        const int line_visible_end = ImClamp((int)((clip_rect.Max.y - draw_pos.y) / g.FontSize) + 1, line_visible_begin, line_count);
+        const int select_min = state->GetSelectionMin();
+        const int select_max = state->GetSelectionMax();
+        const ImU32 bg_color = GetColorU32(ImGuiCol_TextSelectedBg);
+        for (int line = line_visible_begin; line < line_visible_end; line++)
+        {
+            const int line_start = state->GetLineStart(line);
+            const int line_end = state->GetLineEnd(line);
+            const char* line_text = state->Text.GetRange(line_start, line_end, &state->TempText);
+            const ImVec2 line_pos(draw_pos.x - state->ScrollX, draw_pos.y + line * g.FontSize);
+            if (select_min < select_max && select_min <= line_end && select_max > line_start)
+            {
+                float x0 = InputTextLargeCalcWidth(&g, line_text, line_text + ImMax(select_min - line_start, 0));
+                float x1 = InputTextLargeCalcWidth(&g, line_text, line_text + ImMin(select_max, line_end) - line_start);
+                if (select_max > line_end)
+                    x1 += IM_TRUNC(g.Font->GetCharAdvance((ImWchar)' ') * 0.50f); // So we can see selected new lines
+                ImRect rect(line_pos + ImVec2(x0, 0.0f), line_pos + ImVec2(x1, g.FontSize));
+                rect.ClipWith(clip_rect);
+                if (rect.Overlaps(clip_rect))
+                    draw_window->DrawList->AddRectFilled(rect.Min, rect.Max, bg_color);
+            }
+            InputTextLargeRenderLine(&g, draw_window->DrawList, line_pos, col, line_text, line_text + line_end - line_start, clip_rect.Min.x, clip_rect.Max.x);
+        }
+
+        // Draw blinking cursor
+        state->CursorAnim += io.DeltaTime;
+        bool cursor_is_visible = (!g.IO.ConfigInputTextCursorBlink) || (state->CursorAnim <= 0.0f) || ImFmod(state->CursorAnim, 1.20f) <= 0.80f;
+        ImVec2 cursor_screen_pos = ImTrunc(draw_pos + cursor_offset - ImVec2(state->ScrollX, 0.0f));
+        ImRect cursor_screen_rect(cursor_screen_pos.x, cursor_screen_pos.y - g.FontSize + 0.5f, cursor_screen_pos.x + 1.0f, cursor_screen_pos.y - 1.5f);
+        if (cursor_screen_rect.Overlaps(clip_rect))
+        {
+            if (g.IO.ConfigInputTextCursorBlink)
+                ImGui::UpdateData();
+            if (cursor_is_visible)
+                draw_window->DrawList->AddLine(cursor_screen_rect.Min + ImVec2(1, 0), cursor_screen_rect.GetBL() + ImVec2(1, 0), GetColorU32(ImGuiCol_Text, 0.7), 2.5);
+        }
+#if defined(__APPLE__) || defined(_WIN32)
+        // we need display IME preedit character by ourself for MacOS and Windows
+        if (io.PreEditCharacters.Size)
+        {
+            ImGui::SetNextWindowViewport(GetWindowViewport()->ID);
+            ImGui::SetNextWindowPos(cursor_screen_pos - ImVec2(0, g.FontSize));
+            ImGui::SetNextWindowBgAlpha(0.5);
+            if (BeginTooltip())
+            {
+                TextEx(io.PreEditCharacters.Data, io.PreEditCharacters.Data + io.PreEditCharacters.Size);
+                EndTooltip();
+            }
+        }
+#endif
+        if (!is_readonly)
+        {
+            g.PlatformImeData.WantVisible = true;
+            g.PlatformImeData.InputPos = ImVec2(cursor_screen_pos.x - 1.0f, cursor_screen_pos.y - g.FontSize);
+            g.PlatformImeData.InputLineHeight = g.FontSize;
+            g.PlatformImeViewport = window->Viewport->ID;
+        }
+    }
+    else
+    {
+        // Scan the user buffer for the visible lines, the others are only counted
+        const char* buf_end = buf + strlen(buf);
+        const int line_visible_begin = ImMax((int)((clip_rect.Min.y - draw_pos.y) / g.FontSize), 0);
+        const int line_visible_end = (int)((clip_rect.Max.y - draw_pos.y) / g.FontSize) + 1;
+        for (const char* line_text = buf; ; line_count++)
+        {
+            const char* line_text_end = (const char*)memchr(line_text, '\n', (size_t)(buf_end - line_text));
+            if (line_count >= line_visible_begin && line_count < line_visible_end)
+                InputTextLargeRenderLine(&g, draw_window->DrawList, ImVec2(draw_pos.x, draw_pos.y + line_count * g.FontSize), col, line_text, line_text_end ? line_text_end : buf_end, clip_rect.Min.x, clip_rect.Max.x);
+            if (line_text_end == NULL)
+                break;
+            line_text = line_text_end + 1;
+        }
+        line_count++;
+    }
+    PopStyleVar();
+    if (hint != NULL && (render_cursor ? state->Text.size() : (int)strlen(buf)) == 0)
+        draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos, GetColorU32(ImGuiCol_TextDisabled), hint);
+
+    // For focus requests to work on our multiline we need to ensure our child ItemAdd() call specifies the ImGuiItemFlags_Inputable (see InputTextEx())
+    Dummy(ImVec2(inner_size.x, line_count * g.FontSize + style.FramePadding.y));
+    g.NextItemData.ItemFlags |= ImGuiItemFlags_Inputable | ImGuiItemFlags_NoTabStop;
+    EndChild();
+    item_data_backup.StatusFlags |= (g.LastItemData.StatusFlags & ImGuiItemStatusFlags_HoveredWindow);
+    EndGroup();
+    if (g.LastItemData.ID == 0)
+    {
+        g.LastItemData.ID = id;
+        g.LastItemData.InFlags = item_data_backup.InFlags;
+        g.LastItemData.StatusFlags = item_data_backup.StatusFlags;
+    }
+
+    if (g.LogEnabled)
+    {
+        LogSetNextTextDecoration("{", "}");
+        LogRenderedText(&draw_pos, buf, NULL);
+    }
+
+    if (label_size.x > 0)
+        RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, frame_bb.Min.y + style.FramePadding.y), label);
+
+    if (value_changed && !(flags & ImGuiInputTextFlags_NoMarkEdited))
+        MarkItemEdited(id);
+
+    IMGUI_TEST_ENGINE_ITEM_INFO(id, label, g.LastItemData.StatusFlags | ImGuiItemStatusFlags_Inputable);
+    if ((flags & ImGuiInputTextFlags_EnterReturnsTrue) != 0)
+        return validated;
+    else
+        return value_changed;
+}
+// add by Dicky end
+
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: ColorEdit, ColorPicker, ColorButton, etc.
 //-------------------------------------------------------------------------
@@ -8094,6 +9059,10 @@ void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
     ImSwap(Size, r.Size);
     ImSwap(_SelectionOrder, r._SelectionOrder);
     _Storage.Data.swap(r._Storage.Data);
+#if IMGUI_STORAGE_HASHED
+    _Storage._Index.swap(r._Storage._Index); // add by Dicky
+    ImSwap(_Storage._IndexedSize, r._Storage._IndexedSize);
+#endif
 }
 
 bool ImGuiSelectionBasicStorage::Contains(ImGuiID id) const
@@ -8141,6 +9110,16 @@ void ImGuiSelectionBasicStorage::SetItemSelected(ImGuiID id, bool selected)
 static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicStorage* selection, ImGuiID id, bool selected, int size_before_amends, int selection_order)
 {
     ImGuiStorage* storage = &selection->_Storage;
+    // add by Dicky
+#if IMGUI_STORAGE_HASHED
+    // Hashed storage inserts in O(1), no need for the unsorted append + sort pass
+    IM_UNUSED(size_before_amends);
+    if (selected == (storage->GetInt(id, 0) != 0))
+        return;
+    storage->SetInt(id, selected ? selection_order : 0);
+    selection->Size += selected ? +1 : -1;
+#else
+    // add by Dicky end
     ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + size_before_amends, id);
     const bool is_contained = (it != storage->Data.Data + size_before_amends) && (it->key == id);
     if (selected == (is_contained && it->val_i != 0))
@@ -8150,6 +9129,7 @@ static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicS
     else if (is_contained)
         it->val_i = selected ? selection_order : 0; // Modify in-place.
     selection->Size += selected ? +1 : -1;
+#endif // add by Dicky
 }
 
 static void ImGuiSelectionBasicStorage_BatchFinish(ImGuiSelectionBasicStorage* selection, bool selected, int size_before_amends)
@@ -1,6 +1,12 @@
 #include <immat.h>
 #include <imgui.h>
 #include <imgui_internal.h>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <type_traits>
+#include "imgui_cpu.h"
 
 #if __ARM_NEON
 #include <arm_neon.h>
@@ -357,28 +363,366 @@ void ImMat::alphablend(int x, int y, ImPixel color)
     }
 }
 
-void ImMat::draw_line(float x1, float y1, float x2, float y2, float t, ImPixel color)
+// scanline rasterizer
+// Polygon edges are accumulated as signed area into a per-row cell buffer (the same analytic
+// coverage scheme as stb_truetype's v2 rasterizer), a running sum over the row gives the exact
+// pixel coverage, fully covered runs are blended as one span.
+// Pixel centers sit on integer coordinates, same as draw_line(t)'s capsule SDF.
+struct ImRasterEdge
 {
-    assert(dims == 3);
+    float x0, y0, x1, y1;   // y0 < y1
+    float dir;              // +1 edge goes down, -1 edge goes up
+};
 
-    int _x0 = CLAMP((int)floorf(fminf(x1, x2) - t), 0, w - 1);
-    int _x1 = CLAMP((int) ceilf(fmaxf(x1, x2) + t), 0, w - 1);
-    int _y0 = CLAMP((int)floorf(fminf(y1, y2) - t), 0, h - 1);
-    int _y1 = CLAMP((int) ceilf(fmaxf(y1, y2) + t), 0, h - 1);
-    #pragma omp parallel for num_threads(OMP_THREADS)
-    for (int y = _y0; y <= _y1; y++)
+static int raster_arc_segments(float r)
+{
+    // same error bound ImDrawList uses for auto circle tessellation
+    const float max_error = 0.3f;
+    if (r <= max_error) return 4;
+    int n = (int)ceilf(M_PI / acosf(1.f - max_error / r));
+    return CLAMP(n, 4, 512);
+}
+
+// orientation: 0 keep, 1 force positive signed area, -1 force negative signed area
+static void raster_add_poly(std::vector<ImRasterEdge>& edges, const ImPoint* pts, int count, int orientation = 0)
+{
+    if (count < 3)
+        return;
+    bool reverse = false;
+    if (orientation != 0)
+    {
+        float area = 0;
+        for (int i = 0, j = count - 1; i < count; j = i++)
+            area += (pts[j].x - pts[i].x) * (pts[j].y + pts[i].y);
+        reverse = (area < 0) == (orientation > 0);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        ImPoint a = pts[i], b = pts[(i + 1) % count];
+        if (reverse) std::swap(a, b);
+        if (a.y == b.y)
+            continue;
+        ImRasterEdge e;
+        e.dir = a.y < b.y ? 1.f : -1.f;
+        if (a.y > b.y) std::swap(a, b);
+        e.x0 = a.x + 0.5f; e.y0 = a.y + 0.5f;
+        e.x1 = b.x + 0.5f; e.y1 = b.y + 0.5f;
+        edges.push_back(e);
+    }
+}
+
+static void raster_add_circle(std::vector<ImRasterEdge>& edges, float x, float y, float r, int orientation)
+{
+    if (r <= 0)
+        return;
+    int n = raster_arc_segments(r);
+    std::vector<ImPoint> pts(n);
+    for (int i = 0; i < n; i++)
+    {
+        float a = (float)i / (float)n * M_PI * 2.f;
+        pts[i] = ImPoint(x + cosf(a) * r, y + sinf(a) * r);
+    }
+    raster_add_poly(edges, pts.data(), n, orientation);
+}
+
+// capsule with radius t around segment p1-p2, the shape draw_line(t) has always drawn
+static void raster_add_capsule(std::vector<ImRasterEdge>& edges, float x1, float y1, float x2, float y2, float t)
+{
+    float dx = x2 - x1, dy = y2 - y1;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len < 1e-6f)
+    {
+        raster_add_circle(edges, x1, y1, t, 1);
+        return;
+    }
+    int n = std::max(raster_arc_segments(t) / 2, 2);
+    float a0 = atan2f(dy, dx) - M_PI * 0.5f;
+    std::vector<ImPoint> pts((n + 1) * 2);
+    for (int i = 0; i <= n; i++)
+    {
+        float a = a0 + (float)i / (float)n * M_PI;
+        pts[i] = ImPoint(x2 + cosf(a) * t, y2 + sinf(a) * t);
+        pts[n + 1 + i] = ImPoint(x1 - cosf(a) * t, y1 - sinf(a) * t);
+    }
+    raster_add_poly(edges, pts.data(), (int)pts.size(), 1);
+}
+
+// accumulate a piece of edge that lies inside one row and inside [0, cells - 1] horizontally
+static inline void raster_cell_line(float* a, float xa, float xb, float d)
+{
+    float x0 = std::min(xa, xb), x1 = std::max(xa, xb);
+    int x0i = (int)floorf(x0);
+    int x1i = (int)ceilf(x1);
+    if (x1i <= x0i + 1)
+    {
+        float xmf = 0.5f * (xa + xb) - (float)x0i;
+        a[x0i] += d - d * xmf;
+        a[x0i + 1] += d * xmf;
+    }
+    else
+    {
+        float s = 1.f / (x1 - x0);
+        float x0f = x0 - (float)x0i;
+        float a0 = 0.5f * s * (1.f - x0f) * (1.f - x0f);
+        float x1f = x1 - (float)x1i + 1.f;
+        float am = 0.5f * s * x1f * x1f;
+        a[x0i] += d * a0;
+        if (x1i == x0i + 2)
+            a[x0i + 1] += d * (1.f - a0 - am);
+        else
+        {
+            float a1 = s * (1.5f - x0f);
+            a[x0i + 1] += d * (a1 - a0);
+            for (int xi = x0i + 2; xi < x1i - 1; xi++) a[xi] += d * s;
+            float a2 = a1 + (float)(x1i - x0i - 3) * s;
+            a[x1i - 1] += d * (1.f - a2 - am);
+        }
+        a[x1i] += d * am;
+    }
+}
+
+// split the row piece where it leaves [0, width], parts outside collapse onto the border
+static inline void raster_row_piece(float* a, int width, float xa, float ya, float xb, float yb, float dir)
+{
+    float d = (yb - ya) * dir;
+    if (d == 0)
+        return;
+    float bounds[2] = { 0.f, (float)width };
+    float ts[4] = { 0.f, 1.f, 1.f, 1.f };
+    int nt = 1;
+    if (xa != xb)
+    {
+        for (int b = 0; b < 2; b++)
+        {
+            float t = (bounds[b] - xa) / (xb - xa);
+            if (t > 0.f && t < 1.f) ts[nt++] = t;
+        }
+        if (nt == 3 && ts[1] > ts[2]) std::swap(ts[1], ts[2]);
+    }
+    ts[nt] = 1.f;
+    for (int i = 0; i < nt; i++)
     {
-        for (int x = _x0; x <= _x1; x++)
+        float x0 = xa + (xb - xa) * ts[i];
+        float x1 = xa + (xb - xa) * ts[i + 1];
+        raster_cell_line(a, CLAMP(x0, 0.f, (float)width), CLAMP(x1, 0.f, (float)width), d * (ts[i + 1] - ts[i]));
+    }
+}
+
+template<typename T>
+static inline void raster_blend_span_typed(ImMat& mat, int x, int y, int count, const float* cov, float alpha, const ImPixel& color, float scale)
+{
+    const size_t pixel_step = mat.elempack == 1 ? 1 : mat.c;
+    const float cv[3] = { color.r * scale, color.g * scale, color.b * scale };
+    for (int k = 0; k < mat.c && k < 4; k++)
+    {
+        T* ptr = mat.elempack == 1 ? (T*)mat.data + k * mat.cstep + (size_t)y * mat.w + x
+                                   : (T*)mat.data + ((size_t)y * mat.w + x) * mat.c + k;
+        if (k == 3)
+        {
+            for (int i = 0; i < count; i++, ptr += pixel_step)
+            {
+                float a = cov ? cov[i] * alpha : alpha;
+                *ptr = (T)(CLAMP(color.a * a + (float)*ptr / scale, 0.f, 1.f) * scale);
+            }
+        }
+        else if (!cov && alpha >= 1.f)
+        {
+            T v = (T)cv[k];
+            for (int i = 0; i < count; i++, ptr += pixel_step) *ptr = v;
+        }
+        else
         {
-            // capsuleSDF
-            float pax = (float)x - x1, pay = (float)y - y1, bax = x2 - x1, bay = y2 - y1;
-            float _h = CLAMP((pax * bax + pay * bay) / (bax * bax + bay * bay), 0.0f, 1.0f);
-            float dx = pax - bax * _h, dy = pay - bay * _h;
-            float sdf = sqrtf(dx * dx + dy * dy) - t;
-            float alpha = CLAMP(0.5f - sdf, 0.f, 1.f);
-            alphablend(x, y, alpha, color);
+            for (int i = 0; i < count; i++, ptr += pixel_step)
+            {
+                float a = cov ? cov[i] * alpha : alpha;
+                *ptr = (T)((float)*ptr * (1.f - a) + cv[k] * a);
+            }
+        }
+    }
+}
+
+static void raster_blend_span(ImMat& mat, int x, int y, int count, const float* cov, float alpha, const ImPixel& color)
+{
+    if (count <= 0)
+        return;
+    switch (mat.type)
+    {
+        case IM_DT_INT8: raster_blend_span_typed<uint8_t>(mat, x, y, count, cov, alpha, color, UINT8_MAX); break;
+        case IM_DT_FLOAT32: raster_blend_span_typed<float>(mat, x, y, count, cov, alpha, color, 1.f); break;
+        default:
+            for (int i = 0; i < count; i++)
+                mat.alphablend(x + i, y, cov ? cov[i] * alpha : alpha, color);
+        break;
+    }
+}
+
+// fill rows [y_begin, y_end) of the bounding box, edges sorted by y0. Edges above y_begin are
+// dropped by the first row so a band of rows doesn't depend on the rows before it
+static void raster_fill_rows(ImMat& mat, const std::vector<ImRasterEdge>& edges, int ix0, int width, int y_begin, int y_end, const ImPixel& color, float alpha)
+{
+    std::vector<float> acc(width + 2, 0.f);
+    std::vector<float> cov(width);
+    std::vector<int> active;
+    size_t next = 0;
+    for (int y = y_begin; y < y_end; y++)
+    {
+        const float row_top = (float)y, row_bottom = (float)(y + 1);
+        while (next < edges.size() && edges[next].y0 < row_bottom)
+            active.push_back((int)next++);
+        // cells left and right of everything touched in this row have zero winding
+        int touch_min = width, touch_max = -1;
+        for (size_t i = 0; i < active.size();)
+        {
+            const ImRasterEdge& e = edges[active[i]];
+            if (e.y1 <= row_top)
+            {
+                active[i] = active.back();
+                active.pop_back();
+                continue;
+            }
+            float ya = std::max(e.y0, row_top), yb = std::min(e.y1, row_bottom);
+            if (yb > ya)
+            {
+                float dxdy = (e.x1 - e.x0) / (e.y1 - e.y0);
+                float xa = e.x0 + (ya - e.y0) * dxdy - ix0;
+                float xb = e.x0 + (yb - e.y0) * dxdy - ix0;
+                touch_min = std::min(touch_min, (int)floorf(CLAMP(std::min(xa, xb), 0.f, (float)width)));
+                touch_max = std::max(touch_max, (int)ceilf(CLAMP(std::max(xa, xb), 0.f, (float)width)) + 1);
+                raster_row_piece(acc.data(), width, xa, ya, xb, yb, e.dir);
+            }
+            i++;
         }
+        // running sum gives coverage, emit solid runs as one span and partial runs with coverage
+        if (touch_max < 0)
+            continue;
+        const int x_end = std::min(touch_max, width);
+        float sum = 0;
+        int x = touch_min;
+        while (x < x_end)
+        {
+            sum += acc[x];
+            float c = std::min(fabsf(sum), 1.f);
+            if (c < 1.f / 512.f) { x++; continue; }
+            int start = x;
+            if (c > 1.f - 1.f / 512.f)
+            {
+                while (++x < x_end)
+                {
+                    float s = sum + acc[x];
+                    if (fabsf(s) <= 1.f - 1.f / 512.f) break;
+                    sum = s;
+                }
+                raster_blend_span(mat, ix0 + start, y, x - start, nullptr, alpha, color);
+            }
+            else
+            {
+                cov[x] = c;
+                while (++x < x_end)
+                {
+                    float s = sum + acc[x];
+                    float cs = std::min(fabsf(s), 1.f);
+                    if (cs < 1.f / 512.f || cs > 1.f - 1.f / 512.f) break;
+                    sum = s;
+                    cov[x] = cs;
+                }
+                raster_blend_span(mat, ix0 + start, y, x - start, &cov[start], alpha, color);
+            }
+        }
+        std::fill(acc.begin() + touch_min, acc.begin() + std::min(touch_max + 1, width + 2), 0.f);
+    }
+}
+
+// coverage from overlapping parts is clamped to 1, so a union of shapes with the same
+// orientation is blended once and shapes with opposite orientation cut holes
+static void raster_fill(ImMat& mat, std::vector<ImRasterEdge>& edges, const ImPixel& color, float alpha)
+{
+    if (edges.empty() || mat.empty() || alpha <= 0)
+        return;
+    float min_x = FLT_MAX, max_x = -FLT_MAX, min_y = FLT_MAX, max_y = -FLT_MAX;
+    for (auto& e : edges)
+    {
+        min_x = std::min(min_x, std::min(e.x0, e.x1));
+        max_x = std::max(max_x, std::max(e.x0, e.x1));
+        min_y = std::min(min_y, e.y0);
+        max_y = std::max(max_y, e.y1);
+    }
+    int ix0 = std::max(0, (int)floorf(min_x));
+    int ix1 = std::min(mat.w, (int)ceilf(max_x));
+    int iy0 = std::max(0, (int)floorf(min_y));
+    int iy1 = std::min(mat.h, (int)ceilf(max_y));
+    if (ix0 >= ix1 || iy0 >= iy1)
+        return;
+    const int width = ix1 - ix0;
+    std::sort(edges.begin(), edges.end(), [](const ImRasterEdge& a, const ImRasterEdge& b) { return a.y0 < b.y0; });
+    // rows are independent, big shapes are filled in bands of rows
+    const int rows = iy1 - iy0;
+    const int bands = (int64_t)rows * width >= 256 * 256 ? std::min(OMP_THREADS, rows) : 1;
+    #pragma omp parallel for num_threads(bands) schedule(static, 1)
+    for (int i = 0; i < bands; i++)
+        raster_fill_rows(mat, edges, ix0, width, iy0 + (int)((int64_t)rows * i / bands), iy0 + (int)((int64_t)rows * (i + 1) / bands), color, alpha);
+}
+
+void ImMat::draw_polygon(const ImPoint* points, int num_points, ImPixel color)
+{
+    assert(dims == 3 || dims == 2);
+    std::vector<ImRasterEdge> edges;
+    raster_add_poly(edges, points, num_points);
+    raster_fill(*this, edges, color, 1.f);
+}
+
+void ImMat::draw_polygon(const std::vector<ImPoint>& points, ImPixel color)
+{
+    draw_polygon(points.data(), (int)points.size(), color);
+}
+
+void ImMat::draw_polyline(const ImPoint* points, int num_points, ImPixel color, float thickness, bool closed)
+{
+    assert(dims == 3 || dims == 2);
+    if (num_points < 2 || thickness <= 0)
+        return;
+    const float half = thickness * 0.5f;
+    const int count = closed ? num_points : num_points - 1;
+    std::vector<ImRasterEdge> edges;
+    std::vector<ImPoint> normals(count);
+    for (int i = 0; i < count; i++)
+    {
+        const ImPoint& p0 = points[i];
+        const ImPoint& p1 = points[(i + 1) % num_points];
+        float dx = p1.x - p0.x, dy = p1.y - p0.y;
+        float len = sqrtf(dx * dx + dy * dy);
+        normals[i] = len > 0 ? ImPoint(-dy / len * half, dx / len * half) : ImPoint(0, 0);
+        if (len <= 0)
+            continue;
+        const ImPoint quad[4] = {
+            ImPoint(p0.x + normals[i].x, p0.y + normals[i].y), ImPoint(p1.x + normals[i].x, p1.y + normals[i].y),
+            ImPoint(p1.x - normals[i].x, p1.y - normals[i].y), ImPoint(p0.x - normals[i].x, p0.y - normals[i].y) };
+        raster_add_poly(edges, quad, 4, 1);
+    }
+    // bevel joins, the inner side of a join is already covered and gets clamped
+    for (int i = closed ? 0 : 1; i < count; i++)
+    {
+        const ImPoint& v = points[i];
+        const ImPoint& n0 = normals[(i + count - 1) % count];
+        const ImPoint& n1 = normals[i];
+        const ImPoint outer[3] = { v, ImPoint(v.x + n0.x, v.y + n0.y), ImPoint(v.x + n1.x, v.y + n1.y) };
+        const ImPoint inner[3] = { v, ImPoint(v.x - n0.x, v.y - n0.y), ImPoint(v.x - n1.x, v.y - n1.y) };
+        raster_add_poly(edges, outer, 3, 1);
+        raster_add_poly(edges, inner, 3, 1);
     }
+    raster_fill(*this, edges, color, 1.f);
+}
+
+void ImMat::draw_polyline(const std::vector<ImPoint>& points, ImPixel color, float thickness, bool closed)
+{
+    draw_polyline(points.data(), (int)points.size(), color, thickness, closed);
+}
+
+void ImMat::draw_line(float x1, float y1, float x2, float y2, float t, ImPixel color)
+{
+    assert(dims == 3);
+    std::vector<ImRasterEdge> edges;
+    raster_add_capsule(edges, x1, y1, x2, y2, t);
+    raster_fill(*this, edges, color, 1.f);
 }
 
 void ImMat::draw_line(ImPoint p1, ImPoint p2, float t, ImPixel color)
@@ -455,10 +799,13 @@ void ImMat::draw_rectangle(ImPoint p1, ImPoint p2, ImPixel color, int weight)
 
 void ImMat::draw_rectangle(float x1, float y1, float x2, float y2, float t, ImPixel color)
 {
-    draw_line(x1, y1, x1, y2, t, color);
-    draw_line(x1, y2, x2, y2, t, color);
-    draw_line(x2, y2, x2, y1, t, color);
-    draw_line(x2, y1, x1, y1, t, color);
+    // one pass for all four sides, corners are not blended twice
+    std::vector<ImRasterEdge> edges;
+    raster_add_capsule(edges, x1, y1, x1, y2, t);
+    raster_add_capsule(edges, x1, y2, x2, y2, t);
+    raster_add_capsule(edges, x2, y2, x2, y1, t);
+    raster_add_capsule(edges, x2, y1, x1, y1, t);
+    raster_fill(*this, edges, color, 1.f);
 }
 
 void ImMat::draw_rectangle(ImPoint p1, ImPoint p2, float t, ImPixel color)
@@ -499,37 +846,10 @@ void ImMat::draw_circle(ImPoint p, float r, ImPixel color)
 
 void ImMat::draw_circle_filled(float x, float y, float r, ImPixel color)
 {
-    // Bresenham circle
-    int tx = 0, ty = r, d = 3 - 2 * r, i;
-	while( tx < ty)
-	{
-		for (i = x - ty; i <= x + ty; i++)
-		{
-			set_pixel(i, y - tx, color);
-			if (tx != 0) set_pixel(i, y + tx, color);
-		}
-
-		if (d < 0) d += 4 * tx + 6;
-		else
-		{
-			for (i = x - tx; i <= x + tx; i++)
-			{
-				set_pixel(i, y - ty, color);
-				set_pixel(i, y + ty, color);
-			}
-			d += 4 * (tx - ty) + 10, ty--;
-		}
-		tx++;
-	}
-
-	if (tx == ty)
-    {
-		for (i = x - ty; i <= x + ty; i++)
-		{
-			set_pixel(i, y - tx, color);
-			set_pixel(i, y + tx, color);
-		}
-    }
+    // disc covers every pixel whose center is within r, anti-aliased edge
+    std::vector<ImRasterEdge> edges;
+    raster_add_circle(edges, x, y, r + 0.5f, 1);
+    raster_fill(*this, edges, color, 1.f);
 }
 
 void ImMat::draw_circle_filled(ImPoint p, float r, ImPixel color)
@@ -539,30 +859,11 @@ void ImMat::draw_circle_filled(ImPoint p, float r, ImPixel color)
 
 void ImMat::draw_circle(float x1, float y1, float r, float t, ImPixel color)
 {
-    float perimeter = 2 * M_PI * r;
-    int num_segments = perimeter / 8 / t;
-    const float a_max = (M_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
-    const float a_min = 0;
-    float x, y, x0, y0, _x, _y;
-    num_segments--;
-    for (int i = 0; i <= num_segments; i++)
-    {
-        const float a = a_min + ((float)i / (float)num_segments) * (a_max - a_min);
-        x = x1 + cos(a) * r;
-        y = y1 + sin(a) * r;
-        if (i == 0)
-        {
-            x0 = _x = x;
-            y0 = _y = y;
-        }
-        else
-        {
-            draw_line(_x, _y, x, y, t, color);
-            _x = x;
-            _y = y;
-        }
-    }
-    draw_line(x, y, x0, y0, t, color);
+    // ring with half width t, the same footprint as the capsule chain it replaces
+    std::vector<ImRasterEdge> edges;
+    raster_add_circle(edges, x1, y1, r + t, 1);
+    raster_add_circle(edges, x1, y1, r - t, -1);
+    raster_fill(*this, edges, color, 1.f);
 }
 
 void ImMat::draw_circle(ImPoint p, float r, float t, ImPixel color)
@@ -1691,8 +1992,8 @@ void ImKalman::initiate(int state_size,int mea_size)
     K.create_type(mea_size, state_size, IM_DT_FLOAT32);
 
     measurementMatrix.eye(1.f);     // 观测矩阵的初始化
-    processNoiseCov.eye(1e-5);      // 模型本身噪声协方差矩阵初始化
-    measurementNoiseCov.eye(1e-1);  // 测量噪声的协方差矩阵初始化
+    processNoiseCov.eye(1e-5f);     // 模型本身噪声协方差矩阵初始化
+    measurementNoiseCov.eye(1e-1f); // 测量噪声的协方差矩阵初始化
     errorCovPost.eye(1.f);          // 转移噪声修正矩阵初始化
     statePost.randn(0.f, 5.0f);     // kalaman状态估计修正矩阵初始化
     transitionMatrix.eye(1.f);      // 状态转移矩阵/增益矩阵的初始化
@@ -1726,6 +2027,239 @@ void ImKalman::update(ImMat& Y)
     errorCovPost = errorCovPre - K * measurementMatrix * errorCovPre;
 }
 
+// image statistics
+template<typename T> static inline int stats_bin(T v);
+template<> inline int stats_bin(uint8_t v) { return v; }
+template<> inline int stats_bin(uint16_t v) { return v >> 8; }
+template<> inline int stats_bin(float v) { return (int)(ImClamp(v, 0.f, 1.f) * 255.f + 0.5f); }
+template<typename T> static inline float stats_norm(T v);
+template<> inline float stats_norm(uint8_t v) { return v / (float)UINT8_MAX; }
+template<> inline float stats_norm(uint16_t v) { return v / (float)UINT16_MAX; }
+template<> inline float stats_norm(float v) { return v; }
+
+static inline void stats_accumulate(uint32_t* dst, const uint32_t* src, size_t n)
+{
+    size_t i = 0;
+#if __ARM_NEON
+    for (; i + 4 <= n; i += 4) vst1q_u32(dst + i, vaddq_u32(vld1q_u32(dst + i), vld1q_u32(src + i)));
+#elif __SSE2__
+    for (; i + 4 <= n; i += 4) _mm_storeu_si128((__m128i*)(dst + i), _mm_add_epi32(_mm_loadu_si128((const __m128i*)(dst + i)), _mm_loadu_si128((const __m128i*)(src + i))));
+#endif
+    for (; i < n; i++) dst[i] += src[i];
+}
+
+// count rows [y0, y1) into private bins, min/max/sum are only tracked when bins aren't exact
+template<typename T>
+static void stats_band(const ImMat& mat, int y0, int y1, int flags, int ww, int vs, uint32_t* hist, uint32_t* wave, uint32_t* scope, float* vmin, float* vmax, double* vsum)
+{
+    const bool exact = std::is_same<T, uint8_t>::value;
+    const int cn = ImMin(mat.c, 4);
+    const bool packed = mat.elempack > 1;
+    const bool color = cn >= 3;
+    const float kb = (vs - 1) / (255.f * 1.8556f);
+    const float kr = (vs - 1) / (255.f * 1.5748f);
+    const float half = (vs - 1) * 0.5f;
+    for (int k = 0; k < 4; k++) { vmin[k] = FLT_MAX; vmax[k] = -FLT_MAX; vsum[k] = 0; }
+    if (exact && packed && cn == 4 && flags == IM_STATS_HISTOGRAM)
+    {
+        // RGBA8 histogram only, the common case for image inspect, two sets of bins
+        // for even and odd pixels halve the store to load stalls on flat areas
+        uint32_t* hist2 = hist + 4 * 256;
+        for (int y = y0; y < y1; y++)
+        {
+            const uint8_t* ptr = (const uint8_t*)mat.data + (size_t)y * mat.w * 4;
+            int x = 0;
+            for (; x + 1 < mat.w; x += 2, ptr += 8)
+            {
+                hist[0 * 256 + ptr[0]]++; hist2[0 * 256 + ptr[4]]++;
+                hist[1 * 256 + ptr[1]]++; hist2[1 * 256 + ptr[5]]++;
+                hist[2 * 256 + ptr[2]]++; hist2[2 * 256 + ptr[6]]++;
+                hist[3 * 256 + ptr[3]]++; hist2[3 * 256 + ptr[7]]++;
+            }
+            for (; x < mat.w; x++, ptr += 4)
+            {
+                hist[0 * 256 + ptr[0]]++;
+                hist[1 * 256 + ptr[1]]++;
+                hist[2 * 256 + ptr[2]]++;
+                hist[3 * 256 + ptr[3]]++;
+            }
+        }
+        for (int i = 0; i < 4 * 256; i++) hist[i] += hist2[i];
+        return;
+    }
+    for (int y = y0; y < y1; y++)
+    {
+        const T* p[4];
+        int step = packed ? mat.c : 1;
+        for (int k = 0; k < cn; k++)
+            p[k] = packed ? (const T*)mat.data + (size_t)y * mat.w * mat.c + k : (const T*)((const uint8_t*)mat.data + k * mat.cstep * mat.elemsize) + (size_t)y * mat.w;
+        float rmin[4] = { FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX }, rmax[4] = { -FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX }, rsum[4] = { 0, 0, 0, 0 };
+        for (int x = 0; x < mat.w; x++)
+        {
+            int b[4] = { 0, 0, 0, 0 };
+            for (int k = 0; k < cn; k++)
+            {
+                T v = p[k][x * step];
+                b[k] = stats_bin(v);
+                if (!exact)
+                {
+                    float f = stats_norm(v);
+                    rmin[k] = ImMin(rmin[k], f);
+                    rmax[k] = ImMax(rmax[k], f);
+                    rsum[k] += f;
+                }
+            }
+            if (flags & IM_STATS_HISTOGRAM)
+            {
+                for (int k = 0; k < cn; k++) hist[k * 256 + b[k]]++;
+            }
+            if (!(flags & (IM_STATS_WAVEFORM | IM_STATS_VECTORSCOPE)))
+                continue;
+            const int luma = color ? (54 * b[0] + 183 * b[1] + 19 * b[2] + 128) >> 8 : b[0];
+            if (flags & IM_STATS_WAVEFORM)
+            {
+                uint32_t* col = wave + x * ww / mat.w;
+                if (color)
+                {
+                    col[(0 * 256 + b[0]) * ww]++;
+                    col[(1 * 256 + b[1]) * ww]++;
+                    col[(2 * 256 + b[2]) * ww]++;
+                }
+                col[(3 * 256 + luma) * ww]++;
+            }
+            if ((flags & IM_STATS_VECTORSCOPE) && color)
+            {
+                const int sx = ImClamp((int)((b[2] - luma) * kb + half + 0.5f), 0, vs - 1);
+                const int sy = ImClamp((int)(half - (b[0] - luma) * kr + 0.5f), 0, vs - 1);
+                scope[sy * vs + sx]++;
+            }
+        }
+        if (!exact)
+        {
+            for (int k = 0; k < cn; k++)
+            {
+                vmin[k] = ImMin(vmin[k], rmin[k]);
+                vmax[k] = ImMax(vmax[k], rmax[k]);
+                vsum[k] += rsum[k];
+            }
+        }
+    }
+}
+
+bool ImMatStats::update(const ImMat& mat, int flags, int waveform_width, int vectorscope_size)
+{
+    if (mat.empty() || mat.device != IM_DD_CPU || mat.dims < 2 || mat.c > 4)
+        return false;
+    if (mat.type != IM_DT_INT8 && mat.type != IM_DT_INT16 && mat.type != IM_DT_FLOAT32)
+        return false;
+    if (mat.elempack > 1 && mat.elempack != mat.c)
+        return false;
+    waveform_width = ImClamp(waveform_width, 1, mat.w);
+    vectorscope_size = ImMax(vectorscope_size, 2);
+    if (!std::isnan(mat.time_stamp) && mat.time_stamp == m_time_stamp && mat.data == m_data &&
+        mat.w == m_w && mat.h == m_h && mat.c == m_c && (flags & ~m_flags) == 0 &&
+        waveform_width == m_waveform_width && vectorscope_size == m_vectorscope_size)
+        return true;
+
+    const int cn = mat.c;
+    const int ww = (flags & IM_STATS_WAVEFORM) ? waveform_width : 0;
+    const int vs = (flags & IM_STATS_VECTORSCOPE) ? vectorscope_size : 0;
+    const size_t hist_size = 8 * 256;             // second half is scratch for the RGBA8 fast path
+    const size_t wave_size = (size_t)4 * 256 * ww;
+    const size_t scope_size = (size_t)vs * vs;
+    const size_t band_size = hist_size + wave_size + scope_size;
+    // each band gets enough rows to amortize clearing its private bins
+    const int bands = ImClamp(ImMin(get_big_cpu_count(), (int)((int64_t)mat.w * mat.h / (band_size * 4) + 1)), 1, mat.h);
+    m_bins.resize(band_size * bands);
+    std::fill(m_bins.begin(), m_bins.end(), 0);
+    std::vector<float> band_min(bands * 4), band_max(bands * 4);
+    std::vector<double> band_sum(bands * 4);
+
+    #pragma omp parallel for num_threads(bands) schedule(static, 1)
+    for (int i = 0; i < bands; i++)
+    {
+        uint32_t* hist = m_bins.data() + band_size * i;
+        uint32_t* wave = hist + hist_size;
+        uint32_t* scope = wave + wave_size;
+        const int y0 = (int)((int64_t)mat.h * i / bands);
+        const int y1 = (int)((int64_t)mat.h * (i + 1) / bands);
+        float* vmin = &band_min[i * 4];
+        float* vmax = &band_max[i * 4];
+        double* vsum = &band_sum[i * 4];
+        switch (mat.type)
+        {
+            case IM_DT_INT8:    stats_band<uint8_t>(mat, y0, y1, flags, ww, vs, hist, wave, scope, vmin, vmax, vsum); break;
+            case IM_DT_INT16:   stats_band<uint16_t>(mat, y0, y1, flags, ww, vs, hist, wave, scope, vmin, vmax, vsum); break;
+            case IM_DT_FLOAT32: stats_band<float>(mat, y0, y1, flags, ww, vs, hist, wave, scope, vmin, vmax, vsum); break;
+            default: break;
+        }
+    }
+
+    // merge private bins into band 0
+    uint32_t* bins = m_bins.data();
+    for (int i = 1; i < bands; i++)
+        stats_accumulate(bins, bins + band_size * i, band_size);
+
+    channels = cn;
+    pixels = (int64_t)mat.w * mat.h;
+    memcpy(histogram, bins, sizeof(histogram));
+    histogram_max = 0;
+    for (int k = 0; k < ImMin(cn, 3); k++)
+        for (int j = 0; j < 256; j++) histogram_max = ImMax(histogram_max, histogram[k][j]);
+    for (int k = 0; k < 4; k++)
+    {
+        min[k] = max[k] = mean[k] = 0;
+        if (k >= cn) continue;
+        if (mat.type == IM_DT_INT8)
+        {
+            // 8 bits bins are exact, so min/max/mean come from the histogram
+            if (!(flags & IM_STATS_HISTOGRAM))
+                continue;
+            int lo = 0, hi = 255;
+            double sum = 0;
+            while (lo < 255 && histogram[k][lo] == 0) lo++;
+            while (hi > 0 && histogram[k][hi] == 0) hi--;
+            for (int j = 0; j < 256; j++) sum += (double)histogram[k][j] * j;
+            min[k] = lo / 255.f;
+            max[k] = hi / 255.f;
+            mean[k] = sum / pixels / 255.f;
+        }
+        else
+        {
+            double sum = 0;
+            min[k] = FLT_MAX; max[k] = -FLT_MAX;
+            for (int i = 0; i < bands; i++)
+            {
+                min[k] = ImMin(min[k], band_min[i * 4 + k]);
+                max[k] = ImMax(max[k], band_max[i * 4 + k]);
+                sum += band_sum[i * 4 + k];
+            }
+            mean[k] = sum / pixels;
+        }
+    }
+    if (ww > 0)
+    {
+        waveform.create_type(ww, 256, 4, IM_DT_INT32);
+        for (int k = 0; k < 4; k++)
+            memcpy((uint8_t*)waveform.data + k * waveform.cstep * waveform.elemsize, bins + hist_size + (size_t)k * 256 * ww, sizeof(uint32_t) * 256 * ww);
+    }
+    if (vs > 0)
+    {
+        vectorscope.create_type(vs, vs, IM_DT_INT32);
+        memcpy(vectorscope.data, bins + hist_size + wave_size, sizeof(uint32_t) * scope_size);
+    }
+
+    m_time_stamp = mat.time_stamp;
+    m_data = mat.data;
+    m_w = mat.w;
+    m_h = mat.h;
+    m_c = mat.c;
+    m_flags = flags;
+    m_waveform_width = waveform_width;
+    m_vectorscope_size = vectorscope_size;
+    return true;
+}
+
 // warp Affine help
 static inline int LU(float* A, size_t astep, int m, float* b, size_t bstep, int n, float eps)
 {
@@ -3430,53 +3964,150 @@ ImMat GrayInfernoMap(const ImMat& mat)
     return dst;
 }
 
-static const ImVec2 GetTextSize(const ImWchar c)
+// text to mat glyph cache
+// Each glyph is rasterized once per font/size/scale from the ImFontAtlas alpha texture into a
+// cached mask, laid out strings are cached by string hash, so burning the same caption or a
+// timecode again only blends cached masks into the destination.
+struct ImTextMatGlyph
+{
+    int width {0};              // mask size after scaling
+    int height {0};
+    size_t offset {0};          // mask offset in ImTextMatFont::pixels
+    float advance {0};          // pen advance in destination pixels
+    float measure {0};          // unscaled width used to size CreateTextMat
+    bool valid {false};
+};
+
+struct ImTextMatFont
+{
+    ImFont* font {nullptr};
+    float font_size {0};
+    float scale {0};
+    int build_id {0};           // ImFontAtlas::TexBuildId the masks were copied from
+    std::unordered_map<ImWchar, ImTextMatGlyph> glyphs;
+    std::vector<uint8_t> pixels;
+};
+
+struct ImTextMatLayout
 {
+    struct Item { const ImTextMatGlyph* glyph; int x, y; };
+    std::string text;
+    float max_line_width {0};
+    int lines {1};
+    std::vector<Item> items;
+};
+
+#define TEXT_MAT_MAX_FONTS      16
+#define TEXT_MAT_MAX_LAYOUTS    1024
+static std::mutex g_text_mat_mutex;
+static std::vector<std::unique_ptr<ImTextMatFont>> g_text_mat_fonts;
+static std::unordered_map<ImGuiID, ImTextMatLayout> g_text_mat_layouts;
+
+static ImTextMatFont* GetTextMatFont(float scale)
+{
+    ImFont* font = GetCurrentContext()->Font;
     ImFontAtlas* atlas = GetIO().Fonts;
-    const ImFontGlyph* glyph = GetCurrentContext()->Font->FindGlyph(c);
-    if (glyph == NULL)
-        return ImVec2(0, 0);
-    const int V1 = (int)(glyph->V1 * atlas->TexHeight);
-    const int V0 = (int)(glyph->V0 * atlas->TexHeight);
-    float scale_x = c < 0x80 ? 4.0 : 2.0;
-    float scale_y = 2.0; //c < 0x80 ? 2.0 : 1.0;
-    float width = glyph->X0 * scale_x + glyph->AdvanceX * scale_x;
-    float height = glyph->Y0 * scale_y + V1 - V0;
-    return ImVec2(width, height);
+    const float font_size = GetFontSize();
+    for (auto& f : g_text_mat_fonts)
+    {
+        if (f->font == font && f->font_size == font_size && f->scale == scale)
+        {
+            if (f->build_id != atlas->TexBuildId)
+            {
+                // atlas was rebuilt, even at the same size, cached masks and every layout pointing at them are stale
+                f->glyphs.clear();
+                f->pixels.clear();
+                f->build_id = atlas->TexBuildId;
+                g_text_mat_layouts.clear();
+            }
+            return f.get();
+        }
+    }
+    if (g_text_mat_fonts.size() >= TEXT_MAT_MAX_FONTS)
+    {
+        g_text_mat_fonts.clear();
+        g_text_mat_layouts.clear();
+    }
+    g_text_mat_fonts.emplace_back(new ImTextMatFont());
+    ImTextMatFont* f = g_text_mat_fonts.back().get();
+    f->font = font;
+    f->font_size = font_size;
+    f->scale = scale;
+    f->build_id = atlas->TexBuildId;
+    return f;
 }
 
-static const unsigned char* GetTextData(const ImWchar c, ImVec2& size, ImVec4& rect, int& output_stride, int& char_width, int& char_height)
+static const ImTextMatGlyph* GetTextMatGlyph(ImTextMatFont* f, const ImWchar c)
 {
+    auto it = f->glyphs.find(c);
+    if (it != f->glyphs.end())
+        return &it->second;
+    ImTextMatGlyph& g = f->glyphs[c];
+    const ImFontGlyph* glyph = f->font->FindGlyph(c);
+    if (glyph == NULL)
+        return &g;
     ImFontAtlas* atlas = GetIO().Fonts;
-    float scale_x = c < 0x80 ? 4.0 : 2.0;
-    float scale_y = 2.0; //c < 0x80 ? 2.0 : 1.0;
     unsigned char* bitmap;
-    int _out_width, _out_height;
-    atlas->GetTexDataAsAlpha8(&bitmap, &_out_width, &_out_height);
-    const ImFontGlyph* glyph = GetCurrentContext()->Font->FindGlyph(c);
-    if (glyph == NULL)
-        return nullptr;
-    const int U1 = (int)(glyph->U1 * _out_width);
-    const int U0 = (int)(glyph->U0 * _out_width);
-    const int V1 = (int)(glyph->V1 * _out_height);
-    const int V0 = (int)(glyph->V0 * _out_height);
-    const unsigned char * ptr = &bitmap[_out_width * V0 + U0];
-    output_stride = _out_width;
-    size.x = U1 - U0;
-    size.y = V1 - V0;
-    rect.x = glyph->X0 * scale_x;
-    rect.y = glyph->Y0 * scale_y;
-    rect.z = glyph->X1 * scale_x;
-    rect.w = glyph->Y1 * scale_y;
-    char_width = rect.x + glyph->AdvanceX * scale_x;
-    char_height = glyph->Y0 * scale_y + V1 - V0;
-    return ptr;
+    int tex_width, tex_height;
+    atlas->GetTexDataAsAlpha8(&bitmap, &tex_width, &tex_height);
+    f->build_id = atlas->TexBuildId; // the first glyph may build the atlas
+    // internal fonts bake latin at 4x and the rest at 2x, scale_internal brings both back to 1x
+    const float scale_x = c < 0x80 ? 4.0 : 2.0;
+    const float scale_y = 2.0;
+    const float scale_internal = c < 0x80 ? 0.25 : 0.5;
+    const int U1 = (int)(glyph->U1 * tex_width);
+    const int U0 = (int)(glyph->U0 * tex_width);
+    const int V1 = (int)(glyph->V1 * tex_height);
+    const int V0 = (int)(glyph->V0 * tex_height);
+    const int char_width = glyph->X0 * scale_x + glyph->AdvanceX * scale_x;
+    const int char_height = glyph->Y0 * scale_y + V1 - V0;
+    g.measure = ceil(glyph->X0 * scale_x + glyph->AdvanceX * scale_x) * scale_internal;
+    g.advance = ceil(char_width) * f->scale * scale_internal;
+    g.valid = true;
+    if (char_width <= 0 || char_height <= 0)
+        return &g;
+    ImMat char_mat;
+    char_mat.create(char_width, char_height, 1, 1u, 1);
+    char_mat.fill((int8_t)0);
+    const int x1 = glyph->X0 * scale_x;
+    const int y1 = glyph->Y0 * scale_y;
+    uint8_t* dst = (uint8_t*)char_mat.data;
+    for (int y = 0; y < V1 - V0; y++)
+    {
+        const unsigned char* src = &bitmap[tex_width * (V0 + y) + U0];
+        const int dy = ImClamp(y + y1, 0, char_height - 1);
+        for (int x = 0; x < U1 - U0; x++)
+        {
+            const int dx = ImClamp(x + x1, 0, char_width - 1);
+            dst[dy * char_width + dx] = src[x] > 32 ? src[x] : 0;
+        }
+    }
+    ImMat scale_mat = MatResize(char_mat, ImSize(char_width * f->scale * scale_internal, f->font_size * f->scale));
+    if (scale_mat.empty())
+        return &g;
+    g.width = scale_mat.w;
+    g.height = scale_mat.h;
+    g.offset = f->pixels.size();
+    f->pixels.insert(f->pixels.end(), (const uint8_t*)scale_mat.data, (const uint8_t*)scale_mat.data + (size_t)g.width * g.height);
+    return &g;
 }
 
-void DrawTextToMat(ImMat& mat, const ImPoint pos, const char* str, const ImPixel& color, float scale)
+static const ImTextMatLayout* GetTextMatLayout(ImTextMatFont* f, const char* str)
 {
-    int start_x = pos.x;
-    int start_y = pos.y;
+    const ImGuiID key = ImHashStr(str, 0, ImHashData(&f, sizeof(f)));
+    auto it = g_text_mat_layouts.find(key);
+    if (it != g_text_mat_layouts.end() && it->second.text == str)
+        return &it->second;
+    if (g_text_mat_layouts.size() >= TEXT_MAT_MAX_LAYOUTS)
+        g_text_mat_layouts.clear();
+    ImTextMatLayout& layout = g_text_mat_layouts[key];
+    layout.text = str;
+    layout.items.clear();
+    layout.lines = 1;
+    layout.max_line_width = -1;
+    int start_x = 0;
+    int start_y = 0;
+    float line_width = 0;
     const char* str_ptr = str;
     const char* str_end = str_ptr + strlen(str);
     while (str_ptr < str_end)
@@ -3490,41 +4121,149 @@ void DrawTextToMat(ImMat& mat, const ImPoint pos, const char* str, const ImPixel
         {
             if (c == '\n')
             {
-                start_x = pos.x;
-                start_y += GetFontSize() * scale;
+                if (layout.max_line_width < line_width) layout.max_line_width = line_width;
+                line_width = 0;
+                layout.lines++;
+                start_x = 0;
+                start_y += f->font_size * f->scale;
                 continue;
             }
             if (c == '\r')
                 continue;
         }
-        float scale_internal = c < 0x80 ? 0.25 : 0.5;
-        int output_stride = 0, char_width = 0, char_height = 0;
-        ImVec2 size = {0, 0};
-        ImVec4 rect = {0, 0, 0, 0};
-        const unsigned char* out_data = GetTextData(c, size, rect, output_stride, char_width, char_height);
-        if (out_data && output_stride)
-        {
-            ImMat char_mat(char_width, char_height, 4, 1u, 4);
-            float x1 = rect.x;
-            float x2 = rect.z;
-            float y1 = rect.y;
-            float y2 = rect.w;
-            
-            for (int x = 0; x < size.x; x++)
+        const ImTextMatGlyph* glyph = GetTextMatGlyph(f, (ImWchar)c);
+        line_width += glyph->measure;
+        if (layout.max_line_width < line_width) layout.max_line_width = line_width;
+        if (!glyph->valid)
+            continue;
+        if (glyph->width > 0 && glyph->height > 0)
+            layout.items.push_back({glyph, start_x, start_y});
+        start_x += glyph->advance;
+    }
+    return &layout;
+}
+
+// blend a coverage mask with a solid color, 'over' operator on mats with alpha
+static void BlendTextMask(ImMat& mat, int px, int py, const uint8_t* mask, int mw, int mh, const ImPixel& color)
+{
+    const int x0 = std::max(0, -px), y0 = std::max(0, -py);
+    const int x1 = std::min(mw, mat.w - px), y1 = std::min(mh, mat.h - py);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+    if (mat.type == IM_DT_INT8 && mat.c <= 4 && (mat.elempack == mat.c || mat.elempack == 1))
+    {
+        // packed pixels are cn bytes apart, planar channels are cstep bytes apart
+        const int cn = mat.c;
+        const bool packed = mat.elempack == cn;
+        const size_t pstep = packed ? cn : 1;
+        const size_t kstep = packed ? 1 : mat.cstep;
+        const uint8_t cv[4] = { (uint8_t)(CLAMP(color.r, 0.f, 1.f) * UINT8_MAX), (uint8_t)(CLAMP(color.g, 0.f, 1.f) * UINT8_MAX),
+                                (uint8_t)(CLAMP(color.b, 0.f, 1.f) * UINT8_MAX), UINT8_MAX };
+        for (int y = y0; y < y1; y++)
+        {
+            const uint8_t* m = mask + (size_t)y * mw;
+            uint8_t* d = (uint8_t*)mat.data + ((size_t)(py + y) * mat.w + px) * pstep;
+            int x = x0;
+            while (x < x1)
             {
-                for (int y = 0; y < size.y; y++)
+#if __SSE2__
+                // glyph masks are mostly empty or solid, test 16 coverage values at once
+                if (x + 16 <= x1)
+                {
+                    __m128i M = _mm_loadu_si128((const __m128i*)(m + x));
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi8(M, _mm_setzero_si128())) == 0xFFFF) { x += 16; continue; }
+                    if ((cn == 4 || !packed) && _mm_movemask_epi8(_mm_cmpeq_epi8(M, _mm_set1_epi8((char)0xFF))) == 0xFFFF)
+                    {
+                        if (packed)
+                        {
+                            __m128i C = _mm_set1_epi32((int)((uint32_t)cv[0] | ((uint32_t)cv[1] << 8) | ((uint32_t)cv[2] << 16) | ((uint32_t)cv[3] << 24)));
+                            for (int k = 0; k < 4; k++) _mm_storeu_si128((__m128i*)(d + (x + k * 4) * 4), C);
+                        }
+                        else
+                        {
+                            for (int k = 0; k < cn; k++) _mm_storeu_si128((__m128i*)(d + k * kstep + x), _mm_set1_epi8((char)cv[k]));
+                        }
+                        x += 16;
+                        continue;
+                    }
+                }
+#elif __ARM_NEON && __aarch64__
+                if (x + 16 <= x1)
                 {
-                    const unsigned char alpha = out_data[y * output_stride + x] > 32 ? out_data[y * output_stride + x] : 0;
-                    char_mat.set_pixel(ImPoint(x + x1, y + y1), ImPixel(color.r, color.g, color.b, alpha / 255.0));
+                    uint8x16_t M = vld1q_u8(m + x);
+                    if (vmaxvq_u8(M) == 0) { x += 16; continue; }
+                }
+#endif
+                const unsigned a = m[x];
+                uint8_t* p = d + x * pstep;
+                if (a == 0) { x++; continue; }
+                if (a == UINT8_MAX)
+                {
+                    for (int k = 0; k < cn; k++) p[k * kstep] = cv[k];
+                    x++;
+                    continue;
                 }
+                if (cn == 4)
+                {
+                    const unsigned da = p[3 * kstep];
+                    const unsigned oa = a * 255 + da * (255 - a);    // out alpha * 255
+                    for (int k = 0; k < 3; k++)
+                        p[k * kstep] = (uint8_t)((cv[k] * a * 255 + p[k * kstep] * da * (255 - a) + oa / 2) / oa);
+                    p[3 * kstep] = (uint8_t)((oa + 127) / 255);
+                }
+                else
+                {
+                    for (int k = 0; k < cn; k++)
+                        p[k * kstep] = (uint8_t)((cv[k] * a + p[k * kstep] * (255 - a) + 127) / 255);
+                }
+                x++;
+            }
+        }
+        return;
+    }
+    for (int y = y0; y < y1; y++)
+    {
+        for (int x = x0; x < x1; x++)
+        {
+            const float a = mask[(size_t)y * mw + x] / 255.f;
+            if (a <= 0)
+                continue;
+            ImPixel d = mat.get_pixel(px + x, py + y);
+            if (mat.c > 3)
+            {
+                const float oa = a + d.a * (1 - a);
+                d.r = (color.r * a + d.r * d.a * (1 - a)) / oa;
+                d.g = (color.g * a + d.g * d.a * (1 - a)) / oa;
+                d.b = (color.b * a + d.b * d.a * (1 - a)) / oa;
+                d.a = oa;
+            }
+            else
+            {
+                d.r = color.r * a + d.r * (1 - a);
+                d.g = color.g * a + d.g * (1 - a);
+                d.b = color.b * a + d.b * (1 - a);
             }
-            auto scale_mat = MatResize(char_mat, ImSize(char_width * scale * scale_internal, GetFontSize() * scale));
-            ImageMatCopyTo(scale_mat, mat, ImPoint(start_x, start_y));
-            start_x += ceil(char_width) * scale * scale_internal;
+            mat.set_pixel(px + x, py + y, d);
         }
     }
 }
 
+void DrawTextToMat(ImMat& mat, const ImPoint pos, const char* str, const ImPixel& color, float scale)
+{
+    if (!str || mat.empty())
+        return;
+    std::lock_guard<std::mutex> lock(g_text_mat_mutex);
+    ImTextMatFont* font = GetTextMatFont(scale);
+    const ImTextMatLayout* layout = GetTextMatLayout(font, str);
+    const int start_x = pos.x;
+    const int start_y = pos.y;
+    for (auto& item : layout->items)
+    {
+        const ImTextMatGlyph* glyph = item.glyph;
+        BlendTextMask(mat, start_x + item.x, start_y + item.y, font->pixels.data() + glyph->offset, glyph->width, glyph->height, color);
+    }
+}
+
 ImMat CreateTextMat(const char* str, const ImPixel& color, const ImPixel& bk_color, float scale, bool square)
 {
     ImMat dst;
@@ -3532,33 +4271,12 @@ ImMat CreateTextMat(const char* str, const ImPixel& color, const ImPixel& bk_col
         return dst;
 
     int lines = 1;
-    float line_width = 0;
     float max_line_width = -1;
-    const char* str_ptr = str;
-    const char* str_end = str_ptr + strlen(str);
-    while (str_ptr < str_end)
     {
-        unsigned int c = *str_ptr;
-        if (c < 0x80)
-            str_ptr += 1;
-        else
-            str_ptr += ImTextCharFromUtf8(&c, str_ptr, str_end);
-        if (c < 32)
-        {
-            if (c == '\n')
-            {
-                if (max_line_width < line_width) max_line_width = line_width;
-                line_width = 0;
-                lines++;
-                continue;
-            }
-            if (c == '\r')
-                continue;
-        }
-        float scale_internal = c < 0x80 ? 0.25 : 0.5;
-        auto char_size = GetTextSize(c);
-        line_width += ceil(char_size.x) * scale_internal;
-        if (max_line_width < line_width) max_line_width = line_width;
+        std::lock_guard<std::mutex> lock(g_text_mat_mutex);
+        const ImTextMatLayout* layout = GetTextMatLayout(GetTextMatFont(scale), str);
+        lines = layout->lines;
+        max_line_width = layout->max_line_width;
     }
 
     float text_height = GetFontSize() * lines * scale;
@@ -3573,13 +4291,13 @@ ImMat CreateTextMat(const char* str, const ImPixel& color, const ImPixel& bk_col
         text_height = text_width = length;
     }
     dst.create(ceil(text_width), ceil(text_height), 4, 1u, 4);
-    for (int y = 0; y < text_height; y++)
-    {
-        for (int x = 0; x < text_width; x++)
-        {
-            dst.set_pixel(x, y, bk_color);
-        }
-    }
+    if (dst.empty())
+        return dst;
+    const uint8_t bk[4] = { (uint8_t)(CLAMP(bk_color.r, 0.f, 1.f) * UINT8_MAX), (uint8_t)(CLAMP(bk_color.g, 0.f, 1.f) * UINT8_MAX),
+                            (uint8_t)(CLAMP(bk_color.b, 0.f, 1.f) * UINT8_MAX), (uint8_t)(CLAMP(bk_color.a, 0.f, 1.f) * UINT8_MAX) };
+    uint32_t bk_value;
+    memcpy(&bk_value, bk, 4);
+    dst.fill((int32_t)bk_value);
     DrawTextToMat(dst, ImPoint(x_offset, y_offset), str, color, scale);
     return dst;
 }
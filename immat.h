@@ -12,6 +12,7 @@
 #include <mutex>
 #include <random>
 #include <functional>
+#include <chrono>
 // the alignment of all the allocated buffers
 #if __AVX__
 #define IM_MALLOC_ALIGN 32
@@ -798,6 +799,11 @@ public:
     IMMAT_API void draw_circle(ImPoint p, float r, float t, ImPixel color);
     IMMAT_API void draw_circle(float x, float y, float r, float t, std::function<ImPixel(float)> const &color);
     IMMAT_API void draw_circle(ImPoint p, float r, float t, std::function<ImPixel(float)> const &color);
+    // anti-aliased scanline fill, points follow ImDrawList path order, thickness is the full line width like ImDrawList::AddPolyline
+    IMMAT_API void draw_polygon(const ImPoint* points, int num_points, ImPixel color);
+    IMMAT_API void draw_polygon(const std::vector<ImPoint>& points, ImPixel color);
+    IMMAT_API void draw_polyline(const ImPoint* points, int num_points, ImPixel color, float thickness = 1.f, bool closed = false);
+    IMMAT_API void draw_polyline(const std::vector<ImPoint>& points, ImPixel color, float thickness = 1.f, bool closed = false);
 
     // simple filters for gray
     IMMAT_API ImMat lowpass(float lambda);
@@ -5574,6 +5580,492 @@ public:
     ImMat errorCovPost;        //转移噪声修正矩阵(p(k)) p(k) = (I - K(k) * H) * p'(k)  ： 8 * 8
 };
 
+// Fixed-size Kalman filter
+// Same model and same predicted()/update() semantics as ImKalman, but all matrices are
+// compile-time sized members, so stepping the filter never touches the heap.
+// Matrices are row-major [row][col], the same layout as ImMat::at<float>(col, row).
+template<int S, int M>
+class ImKalmanN
+{
+public:
+    ImKalmanN() { initiate(); };
+    ~ImKalmanN() {};
+
+public:
+    void initiate(int seed = -1);
+    void covariance(float noise_covariance, float measurement_noise_covariance);
+    void update(const float* Y);
+    void update(const ImMat& Y) { assert(Y.type == IM_DT_FLOAT32 && Y.total() >= M); update((const float *)Y.data); }
+    const float* predicted();
+
+public:
+    float statePre[S];                  // x'(k) = A * x(k - 1)
+    float statePost[S];                 // x(k) = x'(k) + K(k) * (z(k) - H * x'(k))
+    float transitionMatrix[S][S];       // A
+    float measurementMatrix[M][S];      // H
+    float processNoiseCov[S][S];        // Q
+    float measurementNoiseCov[M][M];    // R
+    float errorCovPre[S][S];            // P'(k) = A * P(k - 1) * At + Q
+    float K[S][M];                      // K = P'(k) * Ht * inv(H * P'(k) * Ht + R)
+    float errorCovPost[S][S];           // P(k) = (I - K(k) * H) * P'(k)
+
+private:
+    static bool invert(float (&a)[M][M], float (&out)[M][M]);
+};
+
+template<int S, int M>
+inline void ImKalmanN<S, M>::initiate(int seed)
+{
+    unsigned int useed = seed < 0 ? std::chrono::system_clock::now().time_since_epoch().count() : seed;
+    std::default_random_engine gen(useed);
+    std::normal_distribution<float> dis(0.f, 5.f);
+    memset(transitionMatrix, 0, sizeof(transitionMatrix));
+    memset(measurementMatrix, 0, sizeof(measurementMatrix));
+    memset(errorCovPre, 0, sizeof(errorCovPre));
+    memset(errorCovPost, 0, sizeof(errorCovPost));
+    memset(K, 0, sizeof(K));
+    memset(statePre, 0, sizeof(statePre));
+    for (int i = 0; i < S; i++)
+    {
+        transitionMatrix[i][i] = 1.f;
+        if (i + (S + 1) / 2 < S) transitionMatrix[i][i + (S + 1) / 2] = 1.f;
+        errorCovPost[i][i] = 1.f;
+        statePost[i] = dis(gen);
+    }
+    for (int i = 0; i < M && i < S; i++)
+        measurementMatrix[i][i] = 1.f;
+    covariance(1e-5, 1e-1);
+}
+
+template<int S, int M>
+inline void ImKalmanN<S, M>::covariance(float noise_covariance, float measurement_noise_covariance)
+{
+    memset(processNoiseCov, 0, sizeof(processNoiseCov));
+    memset(measurementNoiseCov, 0, sizeof(measurementNoiseCov));
+    for (int i = 0; i < S; i++) processNoiseCov[i][i] = noise_covariance;
+    for (int i = 0; i < M; i++) measurementNoiseCov[i][i] = measurement_noise_covariance;
+}
+
+template<int S, int M>
+inline const float* ImKalmanN<S, M>::predicted()
+{
+    float AP[S][S];
+    for (int i = 0; i < S; i++)
+    {
+        float x = 0;
+        for (int k = 0; k < S; k++) x += transitionMatrix[i][k] * statePost[k];
+        statePre[i] = x;
+        for (int j = 0; j < S; j++)
+        {
+            float v = 0;
+            for (int k = 0; k < S; k++) v += transitionMatrix[i][k] * errorCovPost[k][j];
+            AP[i][j] = v;
+        }
+    }
+    for (int i = 0; i < S; i++)
+    {
+        for (int j = 0; j < S; j++)
+        {
+            float v = processNoiseCov[i][j];
+            for (int k = 0; k < S; k++) v += AP[i][k] * transitionMatrix[j][k];
+            errorCovPre[i][j] = v;
+        }
+    }
+    return statePost;
+}
+
+template<int S, int M>
+inline void ImKalmanN<S, M>::update(const float* Y)
+{
+    float HP[M][S], PHt[S][M], HPHt[M][M], HPHt_inv[M][M], innov[M];
+    for (int i = 0; i < M; i++)
+    {
+        for (int j = 0; j < S; j++)
+        {
+            float v = 0;
+            for (int k = 0; k < S; k++) v += measurementMatrix[i][k] * errorCovPre[k][j];
+            HP[i][j] = v;
+        }
+        float hx = 0;
+        for (int k = 0; k < S; k++) hx += measurementMatrix[i][k] * statePre[k];
+        innov[i] = Y[i] - hx;
+    }
+    for (int i = 0; i < S; i++)
+    {
+        for (int j = 0; j < M; j++)
+        {
+            float v = 0;
+            for (int k = 0; k < S; k++) v += errorCovPre[i][k] * measurementMatrix[j][k];
+            PHt[i][j] = v;
+        }
+    }
+    for (int i = 0; i < M; i++)
+    {
+        for (int j = 0; j < M; j++)
+        {
+            float v = measurementNoiseCov[i][j];
+            for (int k = 0; k < S; k++) v += HP[i][k] * measurementMatrix[j][k];
+            HPHt[i][j] = v;
+        }
+    }
+    if (!invert(HPHt, HPHt_inv))
+        return;
+    for (int i = 0; i < S; i++)
+    {
+        float x = statePre[i];
+        for (int j = 0; j < M; j++)
+        {
+            float v = 0;
+            for (int k = 0; k < M; k++) v += PHt[i][k] * HPHt_inv[k][j];
+            K[i][j] = v;
+            x += v * innov[j];
+        }
+        statePost[i] = x;
+    }
+    for (int i = 0; i < S; i++)
+    {
+        for (int j = 0; j < S; j++)
+        {
+            float v = errorCovPre[i][j];
+            for (int k = 0; k < M; k++) v -= K[i][k] * HP[k][j];
+            errorCovPost[i][j] = v;
+        }
+    }
+}
+
+template<int S, int M>
+inline bool ImKalmanN<S, M>::invert(float (&a)[M][M], float (&out)[M][M])
+{
+    // Gauss-Jordan with partial pivoting, M is tiny so the compiler fully unrolls it
+    for (int i = 0; i < M; i++)
+        for (int j = 0; j < M; j++)
+            out[i][j] = i == j ? 1.f : 0.f;
+    for (int c = 0; c < M; c++)
+    {
+        int p = c;
+        for (int r = c + 1; r < M; r++) if (fabsf(a[r][c]) > fabsf(a[p][c])) p = r;
+        if (fabsf(a[p][c]) < FLT_EPSILON) return false;
+        if (p != c)
+        {
+            for (int j = 0; j < M; j++) { std::swap(a[p][j], a[c][j]); std::swap(out[p][j], out[c][j]); }
+        }
+        float d = 1.f / a[c][c];
+        for (int j = 0; j < M; j++) { a[c][j] *= d; out[c][j] *= d; }
+        for (int r = 0; r < M; r++)
+        {
+            if (r == c) continue;
+            float f = a[r][c];
+            for (int j = 0; j < M; j++) { a[r][j] -= f * a[c][j]; out[r][j] -= f * out[c][j]; }
+        }
+    }
+    return true;
+}
+
+// Batched Kalman filter
+// Steps count independent ImKalmanN<S, M> filters at once. Every state/covariance element is
+// stored as one row of count(padded) floats (SoA), so each arithmetic op covers a full SIMD
+// register of filters. A, H, Q and R are shared by all filters.
+// Fill measurement(i)[n] for every filter n, then call predicted()/update() like ImKalmanN.
+struct ImKalmanLanes
+{
+#if __AVX__
+    enum { size = 8 };
+    typedef __m256 type;
+    static inline type load(const float* p) { return _mm256_loadu_ps(p); }
+    static inline void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+    static inline type set1(float v) { return _mm256_set1_ps(v); }
+    static inline type add(type a, type b) { return _mm256_add_ps(a, b); }
+    static inline type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+    static inline type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+    static inline type div(type a, type b) { return _mm256_div_ps(a, b); }
+#elif __SSE__
+    enum { size = 4 };
+    typedef __m128 type;
+    static inline type load(const float* p) { return _mm_loadu_ps(p); }
+    static inline void store(float* p, type v) { _mm_storeu_ps(p, v); }
+    static inline type set1(float v) { return _mm_set1_ps(v); }
+    static inline type add(type a, type b) { return _mm_add_ps(a, b); }
+    static inline type sub(type a, type b) { return _mm_sub_ps(a, b); }
+    static inline type mul(type a, type b) { return _mm_mul_ps(a, b); }
+    static inline type div(type a, type b) { return _mm_div_ps(a, b); }
+#elif __ARM_NEON
+    enum { size = 4 };
+    typedef float32x4_t type;
+    static inline type load(const float* p) { return vld1q_f32(p); }
+    static inline void store(float* p, type v) { vst1q_f32(p, v); }
+    static inline type set1(float v) { return vdupq_n_f32(v); }
+    static inline type add(type a, type b) { return vaddq_f32(a, b); }
+    static inline type sub(type a, type b) { return vsubq_f32(a, b); }
+    static inline type mul(type a, type b) { return vmulq_f32(a, b); }
+#if __aarch64__
+    static inline type div(type a, type b) { return vdivq_f32(a, b); }
+#else
+    static inline type div(type a, type b)
+    {
+        float32x4_t r = vrecpeq_f32(b);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        return vmulq_f32(a, r);
+    }
+#endif
+#else
+    enum { size = 1 };
+    typedef float type;
+    static inline type load(const float* p) { return *p; }
+    static inline void store(float* p, type v) { *p = v; }
+    static inline type set1(float v) { return v; }
+    static inline type add(type a, type b) { return a + b; }
+    static inline type sub(type a, type b) { return a - b; }
+    static inline type mul(type a, type b) { return a * b; }
+    static inline type div(type a, type b) { return a / b; }
+#endif
+};
+
+template<int S, int M>
+class ImKalmanBatch
+{
+public:
+    ImKalmanBatch() {};
+    ImKalmanBatch(int count, int seed = -1) { initiate(count, seed); };
+    ~ImKalmanBatch() {};
+
+public:
+    void initiate(int count, int seed = -1);
+    void covariance(float noise_covariance, float measurement_noise_covariance);
+    void update();
+    void predicted();
+    int count() const { return m_count; }
+    int stride() const { return m_stride; }
+    float* measurement(int i) { return row(MEASUREMENT + i); }
+    float* state_pre(int i) { return row(STATE_PRE + i); }
+    float* state_post(int i) { return row(STATE_POST + i); }
+
+public:
+    float transitionMatrix[S][S];       // A
+    float measurementMatrix[M][S];      // H
+    float processNoiseCov[S][S];        // Q
+    float measurementNoiseCov[M][M];    // R
+
+private:
+    enum
+    {
+        STATE_PRE = 0,
+        STATE_POST = STATE_PRE + S,
+        COV_PRE = STATE_POST + S,
+        COV_POST = COV_PRE + S * S,
+        MEASUREMENT = COV_POST + S * S,
+        ROWS = MEASUREMENT + M,
+    };
+    float* row(int r) { return (float *)m_data.data + (size_t)r * m_stride; }
+    int m_count {0};
+    int m_stride {0};
+    ImMat m_data;
+};
+
+template<int S, int M>
+inline void ImKalmanBatch<S, M>::initiate(int count, int seed)
+{
+    ImKalmanN<S, M> proto;
+    proto.initiate(seed);
+    memcpy(transitionMatrix, proto.transitionMatrix, sizeof(transitionMatrix));
+    memcpy(measurementMatrix, proto.measurementMatrix, sizeof(measurementMatrix));
+    memcpy(processNoiseCov, proto.processNoiseCov, sizeof(processNoiseCov));
+    memcpy(measurementNoiseCov, proto.measurementNoiseCov, sizeof(measurementNoiseCov));
+    m_count = count;
+    m_stride = (count + ImKalmanLanes::size - 1) / ImKalmanLanes::size * ImKalmanLanes::size;
+    m_data.create_type(m_stride, ROWS, IM_DT_FLOAT32);
+    m_data.fill(0.f);
+    unsigned int useed = seed < 0 ? std::chrono::system_clock::now().time_since_epoch().count() : seed;
+    std::default_random_engine gen(useed);
+    std::normal_distribution<float> dis(0.f, 5.f);
+    for (int i = 0; i < S; i++)
+    {
+        float* post = state_post(i);
+        for (int n = 0; n < m_count; n++) post[n] = dis(gen);
+        float* cov = row(COV_POST + i * S + i);
+        for (int n = 0; n < m_stride; n++) cov[n] = 1.f;
+    }
+}
+
+template<int S, int M>
+inline void ImKalmanBatch<S, M>::covariance(float noise_covariance, float measurement_noise_covariance)
+{
+    memset(processNoiseCov, 0, sizeof(processNoiseCov));
+    memset(measurementNoiseCov, 0, sizeof(measurementNoiseCov));
+    for (int i = 0; i < S; i++) processNoiseCov[i][i] = noise_covariance;
+    for (int i = 0; i < M; i++) measurementNoiseCov[i][i] = measurement_noise_covariance;
+}
+
+template<int S, int M>
+inline void ImKalmanBatch<S, M>::predicted()
+{
+    typedef ImKalmanLanes L;
+    for (int n = 0; n < m_stride; n += L::size)
+    {
+        L::type P[S][S], AP[S][S];
+        for (int i = 0; i < S; i++)
+            for (int j = 0; j < S; j++)
+                P[i][j] = L::load(row(COV_POST + i * S + j) + n);
+        for (int i = 0; i < S; i++)
+        {
+            L::type x = L::set1(0.f);
+            for (int j = 0; j < S; j++) AP[i][j] = L::set1(0.f);
+            for (int k = 0; k < S; k++)
+            {
+                // A is shared by all lanes, skipping its zeros is a uniform branch
+                if (transitionMatrix[i][k] == 0.f) continue;
+                L::type a = L::set1(transitionMatrix[i][k]);
+                x = L::add(x, L::mul(a, L::load(state_post(k) + n)));
+                for (int j = 0; j < S; j++) AP[i][j] = L::add(AP[i][j], L::mul(a, P[k][j]));
+            }
+            L::store(state_pre(i) + n, x);
+        }
+        for (int i = 0; i < S; i++)
+        {
+            for (int j = 0; j < S; j++)
+            {
+                L::type v = L::set1(processNoiseCov[i][j]);
+                for (int k = 0; k < S; k++)
+                {
+                    if (transitionMatrix[j][k] == 0.f) continue;
+                    v = L::add(v, L::mul(AP[i][k], L::set1(transitionMatrix[j][k])));
+                }
+                L::store(row(COV_PRE + i * S + j) + n, v);
+            }
+        }
+    }
+}
+
+template<int S, int M>
+inline void ImKalmanBatch<S, M>::update()
+{
+    typedef ImKalmanLanes L;
+    for (int n = 0; n < m_stride; n += L::size)
+    {
+        L::type P[S][S], HP[M][S], PHt[S][M], B[M][M], Binv[M][M], Kg[S][M], innov[M];
+        for (int i = 0; i < S; i++)
+            for (int j = 0; j < S; j++)
+                P[i][j] = L::load(row(COV_PRE + i * S + j) + n);
+        for (int i = 0; i < M; i++)
+        {
+            L::type hx = L::set1(0.f);
+            for (int j = 0; j < S; j++) HP[i][j] = L::set1(0.f);
+            for (int k = 0; k < S; k++)
+            {
+                if (measurementMatrix[i][k] == 0.f) continue;
+                L::type h = L::set1(measurementMatrix[i][k]);
+                hx = L::add(hx, L::mul(h, L::load(state_pre(k) + n)));
+                for (int j = 0; j < S; j++) HP[i][j] = L::add(HP[i][j], L::mul(h, P[k][j]));
+            }
+            innov[i] = L::sub(L::load(measurement(i) + n), hx);
+        }
+        for (int i = 0; i < S; i++)
+        {
+            for (int j = 0; j < M; j++)
+            {
+                PHt[i][j] = L::set1(0.f);
+                for (int k = 0; k < S; k++)
+                {
+                    if (measurementMatrix[j][k] == 0.f) continue;
+                    PHt[i][j] = L::add(PHt[i][j], L::mul(P[i][k], L::set1(measurementMatrix[j][k])));
+                }
+            }
+        }
+        for (int i = 0; i < M; i++)
+        {
+            for (int j = 0; j < M; j++)
+            {
+                B[i][j] = L::set1(measurementNoiseCov[i][j]);
+                for (int k = 0; k < S; k++)
+                {
+                    if (measurementMatrix[j][k] == 0.f) continue;
+                    B[i][j] = L::add(B[i][j], L::mul(HP[i][k], L::set1(measurementMatrix[j][k])));
+                }
+                Binv[i][j] = L::set1(i == j ? 1.f : 0.f);
+            }
+        }
+        // H * P' * Ht + R is symmetric positive definite, Gauss-Jordan needs no pivoting,
+        // which keeps every lane on the same path
+        for (int c = 0; c < M; c++)
+        {
+            L::type d = L::div(L::set1(1.f), B[c][c]);
+            for (int j = 0; j < M; j++) { B[c][j] = L::mul(B[c][j], d); Binv[c][j] = L::mul(Binv[c][j], d); }
+            for (int r = 0; r < M; r++)
+            {
+                if (r == c) continue;
+                L::type f = B[r][c];
+                for (int j = 0; j < M; j++)
+                {
+                    B[r][j] = L::sub(B[r][j], L::mul(f, B[c][j]));
+                    Binv[r][j] = L::sub(Binv[r][j], L::mul(f, Binv[c][j]));
+                }
+            }
+        }
+        for (int i = 0; i < S; i++)
+        {
+            L::type x = L::load(state_pre(i) + n);
+            for (int j = 0; j < M; j++)
+            {
+                L::type v = L::set1(0.f);
+                for (int k = 0; k < M; k++) v = L::add(v, L::mul(PHt[i][k], Binv[k][j]));
+                Kg[i][j] = v;
+                x = L::add(x, L::mul(v, innov[j]));
+            }
+            L::store(state_post(i) + n, x);
+        }
+        for (int i = 0; i < S; i++)
+        {
+            for (int j = 0; j < S; j++)
+            {
+                L::type v = P[i][j];
+                for (int k = 0; k < M; k++) v = L::sub(v, L::mul(Kg[i][k], HP[k][j]));
+                L::store(row(COV_POST + i * S + j) + n, v);
+            }
+        }
+    }
+}
+
+// Image statistics for histogram, waveform and vectorscope scopes.
+// Rows are split into bands which are counted in parallel into private bins and merged at the end,
+// results are cached on ImMat::time_stamp so a scope redrawn with the same frame costs nothing.
+// Levels are normalized to 256 bins, min/max/mean are normalized to [0, 1].
+enum ImMatStatsFlags
+{
+    IM_STATS_HISTOGRAM      = 1 << 0,   // per channel histogram, min, max and mean
+    IM_STATS_WAVEFORM       = 1 << 1,   // per column level counts, rgb parade and luma
+    IM_STATS_VECTORSCOPE    = 1 << 2,   // BT.709 CbCr counts
+    IM_STATS_ALL            = IM_STATS_HISTOGRAM | IM_STATS_WAVEFORM | IM_STATS_VECTORSCOPE,
+};
+
+class IMMAT_API ImMatStats
+{
+public:
+    // support IM_DT_INT8, IM_DT_INT16 and IM_DT_FLOAT32 mat with 1 to 4 channels, packed or planar
+    // return false if mat isn't support, recompute only when time stamp, mat shape or flags changed
+    bool update(const ImMat& mat, int flags = IM_STATS_HISTOGRAM, int waveform_width = 256, int vectorscope_size = 256);
+    void invalidate() { m_time_stamp = NAN; }
+
+public:
+    int channels {0};
+    int64_t pixels {0};
+    uint32_t histogram[4][256];
+    uint32_t histogram_max {0};         // largest bin of color channels, for scaling plots
+    float min[4] {0};
+    float max[4] {0};
+    float mean[4] {0};
+    ImMat waveform;                     // IM_DT_INT32 waveform_width x 256 levels, channel 0-2 rgb parade, 3 luma
+    ImMat vectorscope;                  // IM_DT_INT32 size x size, Cb along x, Cr up along y
+
+private:
+    double m_time_stamp {NAN};
+    const void* m_data {nullptr};
+    int m_w {0}, m_h {0}, m_c {0};
+    int m_flags {0};
+    int m_waveform_width {0};
+    int m_vectorscope_size {0};
+    std::vector<uint32_t> m_bins;       // private bins per band
+};
+
 IMMAT_API ImMat getPerspectiveTransform(const ImPoint src[], const ImPoint dst[]);
 IMMAT_API ImMat getPerspectiveTransform(const ImMat src, const ImMat dst);
 IMMAT_API ImMat getAffineTransform(const ImPoint src[], const ImPoint dst[]);
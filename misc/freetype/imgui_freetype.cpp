@@ -74,8 +74,10 @@
 //-------------------------------------------------------------------------
 
 // Default memory allocators
-static void* ImGuiFreeTypeDefaultAllocFunc(size_t size, void* user_data) { IM_UNUSED(user_data); return IM_ALLOC(size); }
-static void  ImGuiFreeTypeDefaultFreeFunc(void* ptr, void* user_data) { IM_UNUSED(user_data); IM_FREE(ptr); }
+// modify by Dicky, glyphs are rendered by the atlas build threads
+static void* ImGuiFreeTypeDefaultAllocFunc(size_t size, void* user_data) { IM_UNUSED(user_data); return ImFontAtlasBuildThreadAlloc(size); }
+static void  ImGuiFreeTypeDefaultFreeFunc(void* ptr, void* user_data) { IM_UNUSED(user_data); ImFontAtlasBuildThreadFree(ptr); }
+// modify by Dicky end
 
 // Current memory allocators
 static void* (*GImGuiFreeTypeAllocFunc)(size_t size, void* user_data) = ImGuiFreeTypeDefaultAllocFunc;
@@ -419,6 +421,7 @@ struct ImFontBuildSrcDataFT
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<ImFontBuildSrcGlyphFT>   GlyphsList;
+    ImVector<uint32_t>  DynamicList;        // Glyph codepoints rasterized on demand (ImFontAtlasFlags_DynamicGlyphs) // add by Dicky
 };
 
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
@@ -430,6 +433,189 @@ struct ImFontBuildDstDataFT
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// add by Dicky for dynamic glyphs
+// Rasterizer state kept by the dynamic glyph cache, holds a reference on the FreeType library
+struct ImFontBuildDynamicDataFT
+{
+    ImFontAtlas*            Atlas;
+    FT_Library              Library;
+    ImVector<FreeTypeFont>  Fonts;              // Per source font, Face is null for the sources skipped by the builder
+    ImVector<uint32_t>      Bitmap;             // Last rasterized glyph
+};
+
+static bool ImFontAtlasRasterizeGlyphWithFreeType(void* builder_data, int src_index, ImWchar codepoint, ImFontAtlasGlyphBitmap* out_bitmap)
+{
+    ImFontBuildDynamicDataFT* data = (ImFontBuildDynamicDataFT*)builder_data;
+    FreeTypeFont& font = data->Fonts[src_index];
+    if (font.Face == nullptr || font.LoadGlyph(codepoint) == nullptr)
+        return false;
+    GlyphInfo info;
+    const FT_Bitmap* ft_bitmap = font.RenderGlyphAndGetInfo(&info);
+    if (ft_bitmap == nullptr)
+        return false;
+    out_bitmap->AdvanceX = info.AdvanceX * font.InvRasterizationDensity;
+    if (info.Width == 0 || info.Height == 0)
+        return true;
+
+    const ImFontConfig& cfg = data->Atlas->ConfigData[src_index];
+    const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
+    unsigned char multiply_table[256];
+    if (multiply_enabled)
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+    data->Bitmap.resize(info.Width * info.Height);
+    font.BlitGlyph(ft_bitmap, data->Bitmap.Data, info.Width, multiply_enabled ? multiply_table : nullptr);
+
+    out_bitmap->Width = info.Width;
+    out_bitmap->Height = info.Height;
+    out_bitmap->Pitch = info.Width;
+    out_bitmap->RGBA32 = data->Bitmap.Data;
+    out_bitmap->X0 = info.OffsetX * font.InvRasterizationDensity;
+    out_bitmap->Y0 = info.OffsetY * font.InvRasterizationDensity;
+    out_bitmap->X1 = out_bitmap->X0 + info.Width * font.InvRasterizationDensity;
+    out_bitmap->Y1 = out_bitmap->Y0 + info.Height * font.InvRasterizationDensity;
+    out_bitmap->Colored = info.IsColored;
+    return true;
+}
+
+static void ImFontAtlasDestroyDataFreeType(void* builder_data)
+{
+    ImFontBuildDynamicDataFT* data = (ImFontBuildDynamicDataFT*)builder_data;
+    data->Fonts.clear_destruct();
+    FT_Done_Library(data->Library);
+    IM_DELETE(data);
+}
+// add by Dicky end
+
+// add by Dicky for parallel build
+// A run of glyphs of one source font rendered by one thread. A face can't be used by two threads at the same time,
+// the first run of a source uses the source font and the next ones their own face.
+// Bitmaps go to chunks chained by their first bytes, allocated with ImFontAtlasBuildThreadAlloc() since ImVector isn't usable here.
+#define FONT_ATLAS_BUILD_RUN_GLYPHS_FT      512
+#define FONT_ATLAS_BUILD_BUFFER_CHUNK_SIZE  (256 * 1024)
+
+struct ImFontBuildRunFT
+{
+    int                 SrcIndex;
+    int                 GlyphBegin;
+    int                 GlyphEnd;
+    FreeTypeFont*       Font;
+    FreeTypeFont*       OwnFont;            // Face opened for this run, null for the first run of a source
+    unsigned char*      Buffer;             // Current bitmap chunk, starts with a pointer to the previous one
+    int                 BufferUsed;
+    int                 BufferSize;
+    int                 TotalSurface;
+};
+
+struct ImFontBuildRenderFT
+{
+    ImFontAtlas*        Atlas;
+    ImFontBuildSrcDataFT* SrcTmp;
+    ImFontBuildRunFT*   Runs;
+};
+
+static unsigned int* ImFontBuildRunAllocBitmapFT(ImFontBuildRunFT* run, int size_in_bytes)
+{
+    if (run->Buffer == nullptr || run->BufferUsed + size_in_bytes > run->BufferSize)
+    {
+        const int header_size = (int)sizeof(ImU64); // Keeps the bitmaps aligned
+        const int chunk_size = ImMax(FONT_ATLAS_BUILD_BUFFER_CHUNK_SIZE, header_size + size_in_bytes);
+        unsigned char* chunk = (unsigned char*)ImFontAtlasBuildThreadAlloc((size_t)chunk_size);
+        memcpy(chunk, &run->Buffer, sizeof(run->Buffer));
+        run->Buffer = chunk;
+        run->BufferUsed = header_size;
+        run->BufferSize = chunk_size;
+    }
+    unsigned int* bitmap = (unsigned int*)(run->Buffer + run->BufferUsed);
+    run->BufferUsed += (size_in_bytes + 3) & ~3;
+    return bitmap;
+}
+
+static void ImFontBuildRunFreeBuffersFT(ImFontBuildRunFT* run)
+{
+    while (run->Buffer != nullptr)
+    {
+        unsigned char* prev_chunk;
+        memcpy(&prev_chunk, run->Buffer, sizeof(prev_chunk));
+        ImFontAtlasBuildThreadFree(run->Buffer);
+        run->Buffer = prev_chunk;
+    }
+}
+
+// add by Dicky for SDF glyphs
+// The bitmap grows by 'spread' pixels on each side to hold the distance field around the glyph
+static void ImFontBuildRunRenderSDFGlyphFT(ImFontBuildRunFT* run, int spread, const FT_Bitmap* ft_bitmap, ImFontBuildSrcGlyphFT* src_glyph, unsigned char* multiply_table)
+{
+    GlyphInfo& info = src_glyph->Info;
+    const int w = info.Width + spread * 2;
+    const int h = info.Height + spread * 2;
+    unsigned int* bitmap = ImFontBuildRunAllocBitmapFT(run, w * h * 4);
+    memset(bitmap, 0, (size_t)(w * h * 4));
+    run->Font->BlitGlyph(ft_bitmap, bitmap + spread * w + spread, w, multiply_table);
+
+    unsigned char* alpha = (unsigned char*)ImFontAtlasBuildThreadAlloc((size_t)(w * h));
+    for (int n = 0; n < w * h; n++)
+        alpha[n] = (unsigned char)((bitmap[n] >> IM_COL32_A_SHIFT) & 0xFF);
+    ImFontAtlasBuildRenderSDF(alpha, w, w, h, spread);
+    for (int n = 0; n < w * h; n++)
+        bitmap[n] = IM_COL32(255, 255, 255, alpha[n]);
+    ImFontAtlasBuildThreadFree(alpha);
+
+    src_glyph->BitmapData = bitmap;
+    info.Width = w;
+    info.Height = h;
+    info.OffsetX -= spread;
+    info.OffsetY -= spread;
+}
+// add by Dicky end
+
+static void ImFontAtlasBuildRenderRunFT(void* user_data, int run_i)
+{
+    ImFontBuildRenderFT* build = (ImFontBuildRenderFT*)user_data;
+    ImFontBuildRunFT& run = build->Runs[run_i];
+    ImFontBuildSrcDataFT& src_tmp = build->SrcTmp[run.SrcIndex];
+    const ImFontConfig& cfg = build->Atlas->ConfigData[run.SrcIndex];
+    if (run.Font->Face == nullptr)
+        return;
+
+    // Compute multiply table if requested
+    const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
+    unsigned char multiply_table[256];
+    if (multiply_enabled)
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+
+    // Gather the sizes of all rectangles we will need to pack
+    const int padding = build->Atlas->TexGlyphPadding;
+    for (int glyph_i = run.GlyphBegin; glyph_i < run.GlyphEnd; glyph_i++)
+    {
+        ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
+
+        const FT_Glyph_Metrics* metrics = run.Font->LoadGlyph(src_glyph.Codepoint);
+        if (metrics == nullptr)
+            continue;
+
+        // Render glyph into a bitmap (currently held by FreeType)
+        const FT_Bitmap* ft_bitmap = run.Font->RenderGlyphAndGetInfo(&src_glyph.Info);
+        if (ft_bitmap == nullptr)
+            continue;
+
+        // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
+        // modify by Dicky for SDF glyphs
+        if (cfg.SDF && !src_glyph.Info.IsColored && src_glyph.Info.Width > 0 && src_glyph.Info.Height > 0)
+            ImFontBuildRunRenderSDFGlyphFT(&run, build->Atlas->TexSDFSpread, ft_bitmap, &src_glyph, multiply_enabled ? multiply_table : nullptr);
+        else
+        {
+            src_glyph.BitmapData = ImFontBuildRunAllocBitmapFT(&run, src_glyph.Info.Width * src_glyph.Info.Height * 4);
+            run.Font->BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, multiply_enabled ? multiply_table : nullptr);
+        }
+        // modify by Dicky end
+
+        src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
+        src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
+        run.TotalSurface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+    }
+}
+// add by Dicky end
+
 bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, unsigned int extra_flags)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -521,6 +707,15 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
                 if (glyph_index == 0)
                     continue;
 
+                // add by Dicky for dynamic glyphs
+                if (!ImFontAtlasBuildIsGlyphBaked(atlas, &atlas->ConfigData[src_i], (ImWchar)codepoint))
+                {
+                    dst_tmp.GlyphsSet.SetBit(codepoint);
+                    src_tmp.DynamicList.push_back((uint32_t)codepoint);
+                    continue;
+                }
+                // add by Dicky end
+
                 // Add to avail set/counters
                 src_tmp.GlyphsCount++;
                 dst_tmp.GlyphsCount++;
@@ -573,65 +768,57 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
     // We could not find a way to retrieve accurate glyph size without rendering them.
     // (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
     // We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't mind the temporary allocations.
-    const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
-    int buf_bitmap_current_used_bytes = 0;
-    ImVector<unsigned char*> buf_bitmap_buffers;
-    buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
     // 8. Render/rasterize font characters into the texture
-    int total_surface = 0;
+    // modify by Dicky for parallel build, the glyphs of each source are split in runs rendered in parallel
+    const int threads_count = ImFontAtlasBuildGetThreadsCount(atlas);
+    ImVector<ImFontBuildRunFT> runs;
     int buf_rects_out_n = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcDataFT& src_tmp = src_tmp_array[src_i];
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
 
         src_tmp.Rects = &buf_rects[buf_rects_out_n];
         buf_rects_out_n += src_tmp.GlyphsCount;
 
-        // Compute multiply table if requested
-        const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
-        unsigned char multiply_table[256];
-        if (multiply_enabled)
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-
-        // Gather the sizes of all rectangles we will need to pack
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+        // Enough runs to keep the threads busy, each one after the first needs a face
+        const int runs_count = ImClamp((src_tmp.GlyphsCount + FONT_ATLAS_BUILD_RUN_GLYPHS_FT - 1) / FONT_ATLAS_BUILD_RUN_GLYPHS_FT, 1, threads_count);
+        for (int run_n = 0; run_n < runs_count; run_n++)
         {
-            ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
-
-            const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
-            if (metrics == nullptr)
-                continue;
-
-            // Render glyph into a bitmap (currently held by FreeType)
-            const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
-            if (ft_bitmap == nullptr)
-                continue;
-
-            // Allocate new temporary chunk if needed
-            const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height * 4;
-            if (buf_bitmap_current_used_bytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
+            ImFontBuildRunFT run;
+            memset((void*)&run, 0, sizeof(run));
+            run.SrcIndex = src_i;
+            run.GlyphBegin = src_tmp.GlyphsCount * run_n / runs_count;
+            run.GlyphEnd = src_tmp.GlyphsCount * (run_n + 1) / runs_count;
+            run.Font = &src_tmp.Font;
+            if (run_n > 0)
             {
-                buf_bitmap_current_used_bytes = 0;
-                buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
+                // FT_New_Face() isn't thread-safe, faces are opened here. Without one the glyphs go to the previous run
+                FreeTypeFont* font = IM_NEW(FreeTypeFont)();
+                if (!font->InitFont(ft_library, atlas->ConfigData[src_i], extra_flags))
+                {
+                    IM_DELETE(font);
+                    runs.back().GlyphEnd = run.GlyphEnd;
+                    continue;
+                }
+                run.Font = run.OwnFont = font;
             }
-            IM_ASSERT(buf_bitmap_current_used_bytes + bitmap_size_in_bytes <= BITMAP_BUFFERS_CHUNK_SIZE); // We could probably allocate custom-sized buffer instead.
-
-            // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
-            src_glyph.BitmapData = (unsigned int*)(buf_bitmap_buffers.back() + buf_bitmap_current_used_bytes);
-            buf_bitmap_current_used_bytes += bitmap_size_in_bytes;
-            src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, multiply_enabled ? multiply_table : nullptr);
-
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+            runs.push_back(run);
         }
     }
+    ImFontBuildRenderFT build = { atlas, src_tmp_array.Data, runs.Data };
+    ImFontAtlasBuildParallelFor(atlas, runs.Size, ImFontAtlasBuildRenderRunFT, &build);
+    int total_surface = 0;
+    for (ImFontBuildRunFT& run : runs)
+    {
+        total_surface += run.TotalSurface;
+        if (run.OwnFont)
+            IM_DELETE(run.OwnFont);
+        run.Font = run.OwnFont = nullptr;
+    }
+    // modify by Dicky end
 
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
@@ -669,8 +856,23 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
                 atlas->TexHeight = ImMax(atlas->TexHeight, src_tmp.Rects[glyph_i].y + src_tmp.Rects[glyph_i].h);
     }
 
+    // add by Dicky for dynamic glyphs, the faces move to the glyph cache once the fonts are set up
+    ImFontBuildDynamicDataFT* dynamic_data = nullptr;
+    if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+    {
+        dynamic_data = IM_NEW(ImFontBuildDynamicDataFT)();
+        dynamic_data->Atlas = atlas;
+        dynamic_data->Library = ft_library;
+        FT_Reference_Library(ft_library);
+        dynamic_data->Fonts.resize(src_tmp_array.Size);
+        memset((void*)dynamic_data->Fonts.Data, 0, (size_t)dynamic_data->Fonts.size_in_bytes());
+        ImFontAtlasBuildDynamicInit(atlas, ImGuiFreeType::GetBuilderForFreeType(), dynamic_data);
+    }
+    // add by Dicky end
+
     // 7. Allocate texture
-    atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
+    if (dynamic_data == nullptr) // add by Dicky, the dynamic glyph cache already sized the texture
+        atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     if (src_load_color)
     {
@@ -691,7 +893,7 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcDataFT& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
+        if (src_tmp.GlyphsCount == 0 && src_tmp.DynamicList.Size == 0) // modify by Dicky
             continue;
 
         // When merging fonts with MergeMode=true:
@@ -735,7 +937,10 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
             ImFontGlyph* dst_glyph = &dst_font->Glyphs.back();
             IM_ASSERT(dst_glyph->Codepoint == src_glyph.Codepoint);
             if (src_glyph.Info.IsColored)
+            {
                 dst_glyph->Colored = tex_use_colors = true;
+                dst_glyph->SDF = 0; // add by Dicky, color glyphs are kept as bitmaps
+            }
 
             // Blit from temporary buffer to final texture
             size_t blit_src_stride = (size_t)src_glyph.Info.Width;
@@ -757,13 +962,28 @@ bool ImFontAtlasBuildWithFreeTypeEx(FT_Library ft_library, ImFontAtlas* atlas, u
             }
         }
 
+        // add by Dicky for dynamic glyphs, only the advance is needed until they are drawn
+        for (uint32_t codepoint : src_tmp.DynamicList)
+            if (src_tmp.Font.LoadGlyph(codepoint) != nullptr)
+                ImFontAtlasBuildAddDynamicGlyph(atlas, dst_font, &cfg, (ImWchar)codepoint, (float)FT_CEIL(src_tmp.Font.Face->glyph->advance.x) * src_tmp.Font.InvRasterizationDensity);
+        // add by Dicky end
+
         src_tmp.Rects = nullptr;
     }
     atlas->TexPixelsUseColors = tex_use_colors;
 
+    // add by Dicky for dynamic glyphs
+    if (dynamic_data != nullptr)
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        {
+            dynamic_data->Fonts[src_i] = src_tmp_array[src_i].Font;
+            src_tmp_array[src_i].Font.Face = nullptr;
+        }
+    // add by Dicky end
+
     // Cleanup
-    for (int buf_i = 0; buf_i < buf_bitmap_buffers.Size; buf_i++)
-        IM_FREE(buf_bitmap_buffers[buf_i]);
+    for (ImFontBuildRunFT& run : runs) // modify by Dicky for parallel build
+        ImFontBuildRunFreeBuffersFT(&run);
     src_tmp_array.clear_destruct();
 
     ImFontAtlasBuildFinish(atlas);
@@ -808,7 +1028,7 @@ static void* FreeType_Realloc(FT_Memory /*memory*/, long cur_size, long new_size
 static bool ImFontAtlasBuildWithFreeType(ImFontAtlas* atlas)
 {
     // FreeType memory management: https://www.freetype.org/freetype2/docs/design/design-4.html
-    FT_MemoryRec_ memory_rec = {};
+    static FT_MemoryRec_ memory_rec = {}; // modify by Dicky, static since the dynamic glyph cache keeps the library alive after returning
     memory_rec.user = nullptr;
     memory_rec.alloc = &FreeType_Alloc;
     memory_rec.free = &FreeType_Free;
@@ -841,6 +1061,8 @@ const ImFontBuilderIO* ImGuiFreeType::GetBuilderForFreeType()
 {
     static ImFontBuilderIO io;
     io.FontBuilder_Build = ImFontAtlasBuildWithFreeType;
+    io.FontBuilder_RasterizeGlyph = ImFontAtlasRasterizeGlyphWithFreeType; // add by Dicky
+    io.FontBuilder_DestroyData = ImFontAtlasDestroyDataFreeType; // add by Dicky
     return &io;
 }
 
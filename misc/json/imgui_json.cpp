@@ -5,14 +5,27 @@
 # include <clocale>
 # include <cmath>
 # include <cstring>
+# include <algorithm>
 # if JSON_IO
 #     include <stdio.h>
 #     include <memory>
+#     include <fcntl.h>
+#     include <sys/stat.h>
+#     if defined(_WIN32)
+#         include <io.h>
+#         include "mman_win.h"
+#     else
+#         include <unistd.h>
+#         include <sys/mman.h>
+#     endif
+# endif
+# if defined(__APPLE__)
+#     include <xlocale.h>
 # endif
 
 namespace imgui_json {
 
-value::value(value&& other)
+value::value(value&& other) noexcept
     : m_Type(other.m_Type)
 {
     switch (m_Type)
@@ -192,15 +205,244 @@ void value::swap(value& other)
     }
 }
 
+// Shortest round trip number formatting with Grisu2 (F. Loitsch, "Printing Floating-Point Numbers
+// Quickly and Accurately with Integers"), output always parses back to the same value.
+struct diy_fp
+{
+    diy_fp(uint64_t f, int e): f(f), e(e) {}
+
+    diy_fp operator-(const diy_fp& rhs) const
+    {
+        return diy_fp(f - rhs.f, e);
+    }
+
+    diy_fp operator*(const diy_fp& rhs) const
+    {
+        const uint64_t m32 = 0xFFFFFFFFu;
+        const uint64_t a = f >> 32, b = f & m32, c = rhs.f >> 32, d = rhs.f & m32;
+        const uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+        uint64_t tmp = (bd >> 32) + (ad & m32) + (bc & m32);
+        tmp += uint64_t(1) << 31; // round
+        return diy_fp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), e + rhs.e + 64);
+    }
+
+    diy_fp normalize() const
+    {
+        diy_fp r = *this;
+        while (!(r.f & (uint64_t(1) << 63)))
+        {
+            r.f <<= 1;
+            --r.e;
+        }
+        return r;
+    }
+
+    uint64_t f;
+    int      e;
+};
+
+static const uint64_t powers_of_ten_u64[] =
+{
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+    10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+    1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+};
+
+// 10^k for k = -348, -340, ..., 340 with a normalized significand, k is returned negated.
+static diy_fp cached_power(int e, int& k)
+{
+    static const uint64_t significands[] =
+    {
+        0xfa8fd5a0081c0288, 0xbaaee17fa23ebf76, 0x8b16fb203055ac76, 0xcf42894a5dce35ea,
+        0x9a6bb0aa55653b2d, 0xe61acf033d1a45df, 0xab70fe17c79ac6ca, 0xff77b1fcbebcdc4f,
+        0xbe5691ef416bd60c, 0x8dd01fad907ffc3c, 0xd3515c2831559a83, 0x9d71ac8fada6c9b5,
+        0xea9c227723ee8bcb, 0xaecc49914078536d, 0x823c12795db6ce57, 0xc21094364dfb5637,
+        0x9096ea6f3848984f, 0xd77485cb25823ac7, 0xa086cfcd97bf97f4, 0xef340a98172aace5,
+        0xb23867fb2a35b28e, 0x84c8d4dfd2c63f3b, 0xc5dd44271ad3cdba, 0x936b9fcebb25c996,
+        0xdbac6c247d62a584, 0xa3ab66580d5fdaf6, 0xf3e2f893dec3f126, 0xb5b5ada8aaff80b8,
+        0x87625f056c7c4a8b, 0xc9bcff6034c13053, 0x964e858c91ba2655, 0xdff9772470297ebd,
+        0xa6dfbd9fb8e5b88f, 0xf8a95fcf88747d94, 0xb94470938fa89bcf, 0x8a08f0f8bf0f156b,
+        0xcdb02555653131b6, 0x993fe2c6d07b7fac, 0xe45c10c42a2b3b06, 0xaa242499697392d3,
+        0xfd87b5f28300ca0e, 0xbce5086492111aeb, 0x8cbccc096f5088cc, 0xd1b71758e219652c,
+        0x9c40000000000000, 0xe8d4a51000000000, 0xad78ebc5ac620000, 0x813f3978f8940984,
+        0xc097ce7bc90715b3, 0x8f7e32ce7bea5c70, 0xd5d238a4abe98068, 0x9f4f2726179a2245,
+        0xed63a231d4c4fb27, 0xb0de65388cc8ada8, 0x83c7088e1aab65db, 0xc45d1df942711d9a,
+        0x924d692ca61be758, 0xda01ee641a708dea, 0xa26da3999aef774a, 0xf209787bb47d6b85,
+        0xb454e4a179dd1877, 0x865b86925b9bc5c2, 0xc83553c5c8965d3d, 0x952ab45cfa97a0b3,
+        0xde469fbd99a05fe3, 0xa59bc234db398c25, 0xf6c69a72a3989f5c, 0xb7dcbf5354e9bece,
+        0x88fcf317f22241e2, 0xcc20ce9bd35c78a5, 0x98165af37b2153df, 0xe2a0b5dc971f303a,
+        0xa8d9d1535ce3b396, 0xfb9b7cd9a4a7443c, 0xbb764c4ca7a44410, 0x8bab8eefb6409c1a,
+        0xd01fef10a657842c, 0x9b10a4e5e9913129, 0xe7109bfba19c0c9d, 0xac2820d9623bf429,
+        0x80444b5e7aa7cf85, 0xbf21e44003acdd2d, 0x8e679c2f5e44ff8f, 0xd433179d9c8cb841,
+        0x9e19db92b4e31ba9, 0xeb96bf6ebadf77d9, 0xaf87023b9bf0ee6b,
+    };
+    static const int16_t exponents[] =
+    {
+        -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007,  -980,  -954,
+         -927,  -901,  -874,  -847,  -821,  -794,  -768,  -741,  -715,  -688,  -661,
+         -635,  -608,  -582,  -555,  -529,  -502,  -475,  -449,  -422,  -396,  -369,
+         -343,  -316,  -289,  -263,  -236,  -210,  -183,  -157,  -130,  -103,   -77,
+          -50,   -24,     3,    30,    56,    83,   109,   136,   162,   189,   216,
+          242,   269,   295,   322,   348,   375,   402,   428,   455,   481,   508,
+          534,   561,   588,   614,   641,   667,   694,   720,   747,   774,   800,
+          827,   853,   880,   907,   933,   960,   986,  1013,  1039,  1066,
+    };
+
+    const double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = static_cast<int>(dk);
+    if (dk - ik > 0.0)
+        ++ik;
+    const unsigned index = static_cast<unsigned>((ik >> 3) + 1);
+    k = -(-348 + static_cast<int>(index << 3));
+    return diy_fp(significands[index], exponents[index]);
+}
+
+static void grisu_round(char* buffer, int length, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w))
+    {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static int digit_gen(const diy_fp& w, const diy_fp& mp, uint64_t delta, char* buffer, int& k)
+{
+    const diy_fp one(uint64_t(1) << -mp.e, mp.e);
+    const diy_fp wp_w = mp - w;
+    uint32_t p1 = static_cast<uint32_t>(mp.f >> -one.e);
+    uint64_t p2 = mp.f & (one.f - 1);
+    int kappa = 1;
+    while (kappa < 9 && p1 >= powers_of_ten_u64[kappa])
+        ++kappa;
+
+    int length = 0;
+    while (kappa > 0)
+    {
+        const uint32_t divisor = static_cast<uint32_t>(powers_of_ten_u64[kappa - 1]);
+        const uint32_t d = p1 / divisor;
+        p1 %= divisor;
+        if (d || length)
+            buffer[length++] = static_cast<char>('0' + d);
+        --kappa;
+        const uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+        if (rest <= delta)
+        {
+            k += kappa;
+            grisu_round(buffer, length, delta, rest, powers_of_ten_u64[kappa] << -one.e, wp_w.f);
+            return length;
+        }
+    }
+
+    while (true)
+    {
+        p2 *= 10;
+        delta *= 10;
+        const char d = static_cast<char>(p2 >> -one.e);
+        if (d || length)
+            buffer[length++] = static_cast<char>('0' + d);
+        p2 &= one.f - 1;
+        --kappa;
+        if (p2 < delta)
+        {
+            k += kappa;
+            const int index = -kappa;
+            grisu_round(buffer, length, delta, p2, one.f, wp_w.f * (index < 20 ? powers_of_ten_u64[index] : 0));
+            return length;
+        }
+    }
+}
+
+// Value is f * 2^e, lower_closer when f is a power of two so the lower neighbour is closer.
+// Writes the digits and returns their count, value is digits * 10^k.
+static int grisu2(uint64_t f, int e, bool lower_closer, char* buffer, int& k)
+{
+    const diy_fp v(f, e);
+    const diy_fp plus = diy_fp((f << 1) + 1, e - 1).normalize();
+    diy_fp minus = lower_closer ? diy_fp((f << 2) - 1, e - 2) : diy_fp((f << 1) - 1, e - 1);
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    const diy_fp c = cached_power(plus.e, k);
+    const diy_fp w = v.normalize() * c;
+    diy_fp wp = plus * c;
+    diy_fp wm = minus * c;
+    ++wm.f;
+    --wp.f;
+    return digit_gen(w, wp, wp.f - wm.f, buffer, k);
+}
+
+// Lays out digits * 10^k in place, fixed notation for [1e-5, 1e21), exponent otherwise.
+static int format_digits(char* buffer, int length, int k)
+{
+    const int kk = length + k; // 10^(kk-1) <= v < 10^kk
+    if (k >= 0 && kk <= 21)
+    {
+        // 1234e3 -> 1234000
+        for (int i = length; i < kk; ++i)
+            buffer[i] = '0';
+        return kk;
+    }
+    else if (kk > 0 && kk <= 21)
+    {
+        // 1234e-2 -> 12.34
+        memmove(buffer + kk + 1, buffer + kk, length - kk);
+        buffer[kk] = '.';
+        return length + 1;
+    }
+    else if (kk > -5 && kk <= 0)
+    {
+        // 1234e-6 -> 0.001234
+        const int offset = 2 - kk;
+        memmove(buffer + offset, buffer, length);
+        buffer[0] = '0';
+        buffer[1] = '.';
+        for (int i = 2; i < offset; ++i)
+            buffer[i] = '0';
+        return length + offset;
+    }
+
+    // 1234e30 -> 1.234e+33
+    int n = 1;
+    if (length > 1)
+    {
+        memmove(buffer + 2, buffer + 1, length - 1);
+        buffer[1] = '.';
+        n = length + 1;
+    }
+    buffer[n++] = 'e';
+    int exponent = kk - 1;
+    buffer[n++] = exponent < 0 ? '-' : '+';
+    if (exponent < 0)
+        exponent = -exponent;
+    if (exponent >= 100)
+    {
+        buffer[n++] = static_cast<char>('0' + exponent / 100);
+        exponent %= 100;
+        buffer[n++] = static_cast<char>('0' + exponent / 10);
+    }
+    else if (exponent >= 10)
+        buffer[n++] = static_cast<char>('0' + exponent / 10);
+    buffer[n++] = static_cast<char>('0' + exponent % 10);
+    return n;
+}
+
 string value::dump(const int indent, const char indent_char) const
 {
     dump_context_t context(indent, indent_char);
+    dump(context, 0);
+    return std::move(context.out);
+}
 
-    context.out.precision(std::numeric_limits<double>::max_digits10 + 1);
-    context.out << std::defaultfloat;
+void value::dump_context_t::flush()
+{
+    if (!file || out.empty())
+        return;
 
-    dump(context, 0);
-    return context.out.str();
+    if (fwrite(out.data(), 1, out.size(), file) != out.size())
+        failed = true;
+    out.clear();
 }
 
 void value::dump_context_t::write_indent(int level)
@@ -208,10 +450,9 @@ void value::dump_context_t::write_indent(int level)
     if (indent <= 0 || level == 0)
         return;
 
-    out.fill(indent_char);
-    out.width(indent * level);
-    out << indent_char;
-    out.width(0);
+    out.append(static_cast<size_t>(indent * level), indent_char);
+    if (file && out.size() >= flush_size)
+        flush();
 }
 
 void value::dump_context_t::write_separator()
@@ -219,7 +460,7 @@ void value::dump_context_t::write_separator()
     if (indent < 0)
         return;
 
-    out.put(' ');
+    put(' ');
 }
 
 void value::dump_context_t::write_newline()
@@ -227,7 +468,133 @@ void value::dump_context_t::write_newline()
     if (indent < 0)
         return;
 
-    out.put('\n');
+    put('\n');
+}
+
+void value::dump_context_t::write_string(const string& str)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    put('\"');
+    auto p = str.data();
+    auto end = p + str.size();
+    auto run = p;
+    for (; p < end; ++p)
+    {
+        const auto c = static_cast<unsigned char>(*p);
+        if (c >= 0x20 && c != '\"' && c != '\\' && c != '/')
+            continue;
+
+        write(run, p - run);
+        run = p + 1;
+        switch (c)
+        {
+            case '\"': write("\\\"", 2); break;
+            case '\\': write("\\\\", 2); break;
+            case '/':  write("\\/", 2);  break;
+            case '\b': write("\\b", 2);  break;
+            case '\f': write("\\f", 2);  break;
+            case '\n': write("\\n", 2);  break;
+            case '\r': write("\\r", 2);  break;
+            case '\t': write("\\t", 2);  break;
+            default:
+            {
+                const char escape[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 15] };
+                write(escape, 6);
+                break;
+            }
+        }
+    }
+    write(run, p - run);
+    put('\"');
+}
+
+void value::dump_context_t::write_integer(int64_t v)
+{
+    char buffer[24];
+    auto p = buffer + sizeof(buffer);
+    uint64_t u = v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+    do
+    {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (v < 0)
+        *--p = '-';
+    write(p, buffer + sizeof(buffer) - p);
+}
+
+// Infinity and NaN have no JSON representation and are written as null.
+void value::dump_context_t::write_number(number v)
+{
+    if (!std::isfinite(v))
+    {
+        write("null", 4);
+        return;
+    }
+
+    // Integers are the common case
+    if (v >= -9007199254740992.0 && v <= 9007199254740992.0 && v == static_cast<double>(static_cast<int64_t>(v)) && !(v == 0 && std::signbit(v)))
+    {
+        write_integer(static_cast<int64_t>(v));
+        return;
+    }
+
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    char buffer[32];
+    auto p = buffer;
+    if (bits >> 63)
+        *p++ = '-';
+    if (v == 0)
+        *p++ = '0';
+    else
+    {
+        const int biased_e = static_cast<int>((bits >> 52) & 0x7FF);
+        const uint64_t significand = bits & ((uint64_t(1) << 52) - 1);
+        int k = 0;
+        const int length = biased_e != 0
+            ? grisu2(significand | (uint64_t(1) << 52), biased_e - 1075, significand == 0 && biased_e > 1, p, k)
+            : grisu2(significand, -1074, false, p, k);
+        p += format_digits(p, length, k);
+    }
+    write(buffer, p - buffer);
+}
+
+// Shortest digits for the float itself, so 0.1f is written as 0.1.
+void value::dump_context_t::write_float(float v)
+{
+    if (!std::isfinite(v))
+    {
+        write("null", 4);
+        return;
+    }
+
+    if (v >= -16777216.0f && v <= 16777216.0f && v == static_cast<float>(static_cast<int32_t>(v)) && !(v == 0 && std::signbit(v)))
+    {
+        write_integer(static_cast<int32_t>(v));
+        return;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    char buffer[32];
+    auto p = buffer;
+    if (bits >> 31)
+        *p++ = '-';
+    if (v == 0)
+        *p++ = '0';
+    else
+    {
+        const int biased_e = static_cast<int>((bits >> 23) & 0xFF);
+        const uint32_t significand = bits & ((1u << 23) - 1);
+        int k = 0;
+        const int length = biased_e != 0
+            ? grisu2(significand | (1u << 23), biased_e - 150, significand == 0 && biased_e > 1, p, k)
+            : grisu2(significand, -149, false, p, k);
+        p += format_digits(p, length, k);
+    }
+    write(buffer, p - buffer);
 }
 
 void value::dump(dump_context_t& context, int level) const
@@ -237,19 +604,20 @@ void value::dump(dump_context_t& context, int level) const
     switch (m_Type)
     {
         case type_t::null:
-            context.out << "null";
+            context.write("null", 4);
             break;
 
         case type_t::object:
-            context.out << '{';
+            context.put('{');
             {
                 context.write_newline();
                 bool first = true;
                 for (auto& entry : *object_ptr(m_Storage))
                 {
-                    if (!first) { context.out << ','; context.write_newline(); } else first = false;
+                    if (!first) { context.put(','); context.write_newline(); } else first = false;
                     context.write_indent(level + 1);
-                    context.out << '\"' << entry.first << "\":";
+                    context.write_string(entry.first);
+                    context.put(':');
                     if (!entry.second.is_structured())
                     {
                         context.write_separator();
@@ -265,17 +633,17 @@ void value::dump(dump_context_t& context, int level) const
                     context.write_newline();
             }
             context.write_indent(level);
-            context.out << '}';
+            context.put('}');
             break;
 
         case type_t::array:
-            context.out << '[';
+            context.put('[');
             {
                 context.write_newline();
                 bool first = true;
                 for (auto& entry : *array_ptr(m_Storage))
                 {
-                    if (!first) { context.out << ','; context.write_newline(); } else first = false;
+                    if (!first) { context.put(','); context.write_newline(); } else first = false;
                     if (!entry.is_structured())
                     {
                         context.write_indent(level + 1);
@@ -290,71 +658,46 @@ void value::dump(dump_context_t& context, int level) const
                     context.write_newline();
             }
             context.write_indent(level);
-            context.out << ']';
+            context.put(']');
             break;
 
         case type_t::string:
-            context.out << '\"';
-
-            if (string_ptr(m_Storage)->find_first_of("\"\\/\b\f\n\r") != string::npos || string_ptr(m_Storage)->find('\0') != string::npos)
-            {
-                for (auto c : *string_ptr(m_Storage))
-                {
-                         if (c == '\"')  context.out << "\\\"";
-                    else if (c == '\\')  context.out << "\\\\";
-                    else if (c == '/')   context.out << "\\/";
-                    else if (c == '\b')  context.out << "\\b";
-                    else if (c == '\f')  context.out << "\\f";
-                    else if (c == '\n')  context.out << "\\n";
-                    else if (c == '\r')  context.out << "\\r";
-                    else if (c == '\t')  context.out << "\\t";
-                    else if (c == 0)     context.out << "\\u0000";
-                    else                 context.out << c;
-                }
-            }
-            else
-                context.out << *string_ptr(m_Storage);
-            context.out << '\"';
+            context.write_string(*string_ptr(m_Storage));
             break;
 
-
         case type_t::boolean:
             if (*boolean_ptr(m_Storage))
-                context.out << "true";
+                context.write("true", 4);
             else
-                context.out << "false";
+                context.write("false", 5);
             break;
 
         case type_t::number:
-            context.out << *number_ptr(m_Storage);
+            context.write_number(*number_ptr(m_Storage));
             break;
 
         case type_t::point:
-            context.out << *point_ptr(m_Storage);
+            context.write_integer(static_cast<int64_t>(*point_ptr(m_Storage)));
             break;
 
         case type_t::vec2:
-            context.out << '(';
-            {
-                context.out << (*vec2_ptr(m_Storage)).x;
-                context.out << ',' << ' ';
-                context.out << (*vec2_ptr(m_Storage)).y;
-            }
-            context.out << ')';
+            context.put('(');
+            context.write_float((*vec2_ptr(m_Storage)).x);
+            context.write(", ", 2);
+            context.write_float((*vec2_ptr(m_Storage)).y);
+            context.put(')');
             break;
 
         case type_t::vec4:
-            context.out << '(';
-            {
-                context.out << (*vec4_ptr(m_Storage)).x;
-                context.out << ',' << ' ';
-                context.out << (*vec4_ptr(m_Storage)).y;
-                context.out << ',' << ' ';
-                context.out << (*vec4_ptr(m_Storage)).z;
-                context.out << ',' << ' ';
-                context.out << (*vec4_ptr(m_Storage)).w;
-            }
-            context.out << ')';
+            context.put('(');
+            context.write_float((*vec4_ptr(m_Storage)).x);
+            context.write(", ", 2);
+            context.write_float((*vec4_ptr(m_Storage)).y);
+            context.write(", ", 2);
+            context.write_float((*vec4_ptr(m_Storage)).z);
+            context.write(", ", 2);
+            context.write_float((*vec4_ptr(m_Storage)).w);
+            context.put(')');
             break;
 
         default:
@@ -362,642 +705,1279 @@ void value::dump(dump_context_t& context, int level) const
     }
 }
 
-struct value::parser
+# if JSON_IO
+static bool read_file(const string& path, string& data)
 {
-    parser(const char* begin, const char* end)
-        : m_Cursor(begin)
-        , m_End(end)
-    {
-    }
+    // Modern C++, so beautiful...
+    std::unique_ptr<FILE, void(*)(FILE*)> file{nullptr, [](FILE* file) { if (file) fclose(file); }};
+# if defined(_MSC_VER) || (defined(__STDC_LIB_EXT1__) && __STDC_WANT_LIB_EXT1__)
+    FILE* handle = nullptr;
+    if (fopen_s(&handle, path.c_str(), "rb") != 0)
+        return false;
+    file.reset(handle);
+# else
+    file.reset(fopen(path.c_str(), "rb"));
+# endif
 
-    value parse()
-    {
-        value v;
+    if (!file)
+        return false;
+
+    fseek(file.get(), 0, SEEK_END);
+    auto size = static_cast<size_t>(ftell(file.get()));
+    fseek(file.get(), 0, SEEK_SET);
 
-        // Switch to C locale to make strtod and strtol work as expected
-        auto previous_locale = std::setlocale(LC_NUMERIC, "C");
+    data.resize(size);
+    if (fread(const_cast<char*>(data.data()), size, 1, file.get()) != 1)
+        return false;
 
-        // Accept single value only when end of the stream is reached.
-        if (!accept_element(v) || !eof())
-            v = value(type_t::discarded);
+    return true;
+}
 
-        if (previous_locale && strcmp(previous_locale, "C") != 0)
-            std::setlocale(LC_NUMERIC, previous_locale);
+// Returns false when the file can't be opened, data is null when it can't be mapped and
+// has to be read instead.
+static bool map_file(const string& path, void*& data, size_t& size)
+{
+    data = nullptr;
+    size = 0;
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
 
-        return v;
+    struct stat sb;
+    if (fstat(fd, &sb) != 0)
+    {
+        close(fd);
+        return false;
     }
 
-private:
-    struct cursor_state
+# if !defined(__EMSCRIPTEN__)
+    if (sb.st_size > 0)
     {
-        cursor_state(parser* p)
-            : m_Owner(p)
-            , m_LastCursor(p->m_Cursor)
+        auto mapped = mmap(nullptr, static_cast<size_t>(sb.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED)
         {
+            data = mapped;
+            size = static_cast<size_t>(sb.st_size);
+#     if defined(MADV_SEQUENTIAL)
+            madvise(mapped, size, MADV_SEQUENTIAL);
+#     endif
         }
+    }
+# endif
 
-        void reset()
-        {
-            m_Owner->m_Cursor = m_LastCursor;
-        }
+    close(fd);
+    return true;
+}
 
-        bool operator()(bool accept)
-        {
-            if (!accept)
-                reset();
-            else
-                m_LastCursor = m_Owner->m_Cursor;
-            return accept;
-        }
+static void unmap_file(void* data, size_t size)
+{
+    munmap(data, size);
+}
+# endif
 
-    private:
-        parser*     m_Owner;
-        const char* m_LastCursor;
-    };
+// Number parsing doesn't depend on the current locale. Up to 19 significant digits with a small
+// exponent convert exactly with one multiplication or division, anything else goes through strtod
+// in the C locale.
+static double strtod_c(char* str, char** end)
+{
+# if defined(_WIN32)
+    static _locale_t c_locale = _create_locale(LC_NUMERIC, "C");
+    return _strtod_l(str, end, c_locale);
+# elif defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+    static locale_t c_locale = newlocale(LC_NUMERIC_MASK, "C", (locale_t)0);
+    return strtod_l(str, end, c_locale);
+# else
+    const char decimal_point = *localeconv()->decimal_point;
+    if (decimal_point != '.')
+        if (auto point = strchr(str, '.'))
+            *point = decimal_point;
+    return std::strtod(str, end);
+# endif
+}
 
-    cursor_state state()
-    {
-        return cursor_state(this);
-    }
+static inline bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
 
-    bool accept_value(value& result)
+static bool parse_number(const char*& cursor, const char* end, number& result)
+{
+    static const double powers_of_ten[] =
     {
-        return accept_object(result)
-            || accept_array(result)
-            || accept_string(result)
-            || accept_number(result)
-            || accept_boolean(result)
-            || accept_point(result)
-            || accept_vec2(result)
-            || accept_vec4(result)
-            || accept_null(result);
-    }
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
 
-    bool accept_object(value& result)
-    {
-        auto s = state();
+    auto p = cursor;
+    const bool negative = p < end && *p == '-';
+    if (negative)
+        ++p;
+    if (p == end || !is_digit(*p))
+        return false;
 
-        object o;
-        if (s(accept('{') && accept_ws() && accept('}')))
-        {
-            result = o;
-            return true;
-        }
-        else if (s(accept('{') && accept_members(o) && accept('}')))
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool exact = true;
+    if (*p == '0')
+        ++p;
+    else
+    {
+        for (; p < end && is_digit(*p); ++p)
         {
-            result = std::move(o);
-            return true;
+            if (digits < 19) { mantissa = mantissa * 10 + (*p - '0'); ++digits; }
+            else             { ++exponent; exact = false; }
         }
-
-        return false;
     }
 
-    bool accept_members(object& o)
+    if (p < end && *p == '.')
     {
-        if (!accept_member(o))
+        if (++p == end || !is_digit(*p))
             return false;
-
-        while (true)
+        for (; p < end && is_digit(*p); ++p)
         {
-            auto s = state();
-            if (!s(accept(',') && accept_member(o)))
-                break;
+            if (digits >= 19)
+            {
+                exact = false;
+                continue;
+            }
+            // Leading zeros of the fraction are not significant
+            if (mantissa != 0 || *p != '0')
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                ++digits;
+            }
+            --exponent;
         }
-
-        return true;
     }
 
-    bool accept_member(object& o)
+    if (p < end && (*p == 'e' || *p == 'E'))
     {
-        auto s = state();
-
-        value key;
-        value v;
-        if (s(accept_ws() && accept_string(key) && accept_ws() && accept(':') && accept_element(v)))
-        {
-            o.emplace(std::move(key.get<string>()), std::move(v));
-            return true;
-        }
-
-        return false;
+        ++p;
+        bool negative_exponent = false;
+        if (p < end && (*p == '+' || *p == '-'))
+            negative_exponent = *p++ == '-';
+        if (p == end || !is_digit(*p))
+            return false;
+        int e = 0;
+        for (; p < end && is_digit(*p); ++p)
+            if (e < 100000)
+                e = e * 10 + (*p - '0');
+        exponent += negative_exponent ? -e : e;
     }
 
-    bool accept_array(value& result)
+    double v;
+    if (exact && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
     {
-        auto s = state();
-
-        if (s(accept('[') && accept_ws() && accept(']')))
+        v = static_cast<double>(mantissa);
+        v = exponent < 0 ? v / powers_of_ten[-exponent] : v * powers_of_ten[exponent];
+        if (negative)
+            v = -v;
+    }
+    else
+    {
+        const size_t length = p - cursor;
+        char buffer[64];
+        string long_buffer;
+        char* str = buffer;
+        if (length < sizeof(buffer))
         {
-            result = array();
-            return true;
+            memcpy(buffer, cursor, length);
+            buffer[length] = '\0';
         }
-
-        array a;
-        if (s(accept('[') && accept_elements(a) && accept(']')))
+        else
         {
-            result = std::move(a);
-            return true;
+            long_buffer.assign(cursor, length);
+            str = &long_buffer[0];
         }
-
-        return false;
+        char* str_end = nullptr;
+        v = strtod_c(str, &str_end);
+        if (str_end != str + length)
+            return false;
     }
 
-    bool accept_elements(array& a)
-    {
-        value v;
-        if (!accept_element(v))
-            return false;
+    if (v != 0 && !std::isnormal(v))
+        return false;
 
-        a.emplace_back(std::move(v));
-        while (true)
-        {
-            auto s = state();
-            v = nullptr;
-            if (!s(accept(',') && accept_element(v)))
-                break;
-            a.emplace_back(std::move(v));
-        }
+    result = v;
+    cursor = p;
+    return true;
+}
 
-        return true;
-    }
+static bool parse_hex(const char* p, const char* end, unsigned& result)
+{
+    if (end - p < 4)
+        return false;
 
-    bool accept_elements(vec2& a)
+    result = 0;
+    for (int i = 0; i < 4; ++i, ++p)
     {
-        value v = nullptr;
-        auto s = state();
-        if (s(accept_number(v) && accept(',')))
-            a.x = v.get<number>();
-        else
-            return false;
-        s = state();
-        if (s(accept(' ') && accept_number(v)))
-            a.y = v.get<number>();
-        else
-            return false;
-
-        return true;
+        unsigned digit;
+             if (*p >= '0' && *p <= '9') digit = *p - '0';
+        else if (*p >= 'A' && *p <= 'F') digit = *p - 'A' + 10;
+        else if (*p >= 'a' && *p <= 'f') digit = *p - 'a' + 10;
+        else return false;
+        result = (result << 4) | digit;
     }
 
-    bool accept_elements(vec4& a)
-    {
-        value v = nullptr;
-        auto s = state();
-        if (s(accept_number(v) && accept(',')))
-            a.x = v.get<number>();
-        else
-            return false;
-        s = state();
-        if (s(accept(' ') && accept_number(v) && accept(',')))
-            a.y = v.get<number>();
-        else
-            return false;
-
-        s = state();
-        if (s(accept(' ') && accept_number(v) && accept(',')))
-            a.z = v.get<number>();
-        else
-            return false;
-        
-        s = state();
-        if (s(accept(' ') && accept_number(v)))
-            a.w = v.get<number>();
-        else
-            return false;
+    return true;
+}
 
-        return true;
+static void append_utf8(string& result, unsigned code)
+{
+    if (code < 0x80)
+        result.push_back(static_cast<char>(code));
+    else if (code < 0x800)
+    {
+        result.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
     }
-
-    bool accept_element(value& result)
+    else if (code < 0x10000)
     {
-        auto s = state();
-        return s(accept_ws() && accept_value(result) && accept_ws());
+        result.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
     }
-
-    bool accept_string(value& result)
+    else
     {
-        auto s = state();
+        result.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        result.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
 
-        string v;
-        if (s(accept('\"') && accept_characters(v) && accept('\"')))
-        {
-            result = std::move(v);
-            return true;
-        }
-        else
-            return false;
+// Single pass, non recursive reader shared by the SAX interface, value and document builders.
+// Grammar is the one dump() writes: JSON plus "(x, y)" and "(x, y, z, w)" vectors and "point".
+template <typename Handler>
+struct reader
+{
+    reader(const char* begin, const char* end, Handler& handler)
+        : m_Cursor(begin)
+        , m_End(end)
+        , m_Handler(handler)
+    {
     }
 
-    bool accept_characters(string& result)
+    bool parse()
     {
-        int c;
-        while (accept_character(c))
+        // '{' or '[' and element count of every open container
+        std::vector<std::pair<char, size_t>> stack;
+
+        skip_ws();
+        while (true)
         {
-            //JSON_ASSERT(c < 128);
-            // disable check character is ascii in case we using UTF-8
-            // this will cause problem when UTF-8 character contain '"'
-            // TODO::Dicky json accept_characters for UTF-8
-            result.push_back(static_cast<char>(c));
-        }
+            if (eof())
+                return false;
 
-        return true;
+            if (*m_Cursor == '{')
+            {
+                ++m_Cursor;
+                if (!m_Handler.on_start_object())
+                    return false;
+                skip_ws();
+                if (!accept('}'))
+                {
+                    stack.emplace_back('{', 0);
+                    if (!read_key())
+                        return false;
+                    continue;
+                }
+                if (!m_Handler.on_end_object(0))
+                    return false;
+            }
+            else if (*m_Cursor == '[')
+            {
+                ++m_Cursor;
+                if (!m_Handler.on_start_array())
+                    return false;
+                skip_ws();
+                if (!accept(']'))
+                {
+                    stack.emplace_back('[', 0);
+                    continue;
+                }
+                if (!m_Handler.on_end_array(0))
+                    return false;
+            }
+            else if (!read_scalar())
+                return false;
+
+            // Value is complete, close containers until one has more elements
+            skip_ws();
+            while (true)
+            {
+                if (stack.empty())
+                    return eof();
+
+                auto& top = stack.back();
+                ++top.second;
+                if (accept(','))
+                {
+                    skip_ws();
+                    if (top.first == '{' && !read_key())
+                        return false;
+                    break;
+                }
+
+                const bool is_object = top.first == '{';
+                const size_t count = top.second;
+                if (!accept(is_object ? '}' : ']'))
+                    return false;
+                stack.pop_back();
+                if (!(is_object ? m_Handler.on_end_object(count) : m_Handler.on_end_array(count)))
+                    return false;
+                skip_ws();
+            }
+        }
     }
 
-    bool accept_character(int& c)
+private:
+    bool eof() const
     {
-        auto s = state();
+        return m_Cursor == m_End;
+    }
 
-        if (accept('\\'))
-        {
-            return accept_escape(c);
-        }
-        else if (expect('\"'))
+    bool accept(char c)
+    {
+        if (eof() || *m_Cursor != c)
             return false;
+        ++m_Cursor;
+        return true;
+    }
 
-        // Handle UTF-8 sequences. only eof will return -1.
-        return s((c = peek()) != -1) && advance();
+    bool accept(const char* literal, size_t length)
+    {
+        if (static_cast<size_t>(m_End - m_Cursor) < length || memcmp(m_Cursor, literal, length) != 0)
+            return false;
+        m_Cursor += length;
+        return true;
     }
 
-    bool accept_escape(int& c)
+    void skip_ws()
     {
-        if (accept('\"')) { c = '\"'; return true; }
-        if (accept('\\')) { c = '\\'; return true; }
-        if (accept('/'))  { c = '/';  return true; }
-        if (accept('b'))  { c = '\b'; return true; }
-        if (accept('f'))  { c = '\f'; return true; }
-        if (accept('n'))  { c = '\n'; return true; }
-        if (accept('r'))  { c = '\r'; return true; }
-        if (accept('t'))  { c = '\t'; return true; }
+        while (m_Cursor < m_End && (*m_Cursor == '\x20' || *m_Cursor == '\x0A' || *m_Cursor == '\x0D' || *m_Cursor == '\x09'))
+            ++m_Cursor;
+    }
 
-        auto s = state();
+    // Cursor is past ':' and following whitespace on success.
+    bool read_key()
+    {
+        const char* str = nullptr;
+        size_t length = 0;
+        if (eof() || *m_Cursor != '\"' || !read_string(str, length) || !m_Handler.on_key(str, length))
+            return false;
+        skip_ws();
+        if (!accept(':'))
+            return false;
+        skip_ws();
+        return true;
+    }
 
-        string hex;
-        hex.reserve(4);
-        if (s(accept('u') && accept_hex(hex) && accept_hex(hex) && accept_hex(hex) && accept_hex(hex)))
+    bool read_scalar()
+    {
+        switch (*m_Cursor)
         {
-            char* end = nullptr;
-            auto v = std::strtol(hex.c_str(), &end, 16);
-            if (end != hex.c_str() + hex.size())
-                return false;
-
-            c = v;
-            return true;
+            case '\"':
+            {
+                const char* str = nullptr;
+                size_t length = 0;
+                return read_string(str, length) && m_Handler.on_string(str, length);
+            }
+            case 't': return accept("true", 4)  && m_Handler.on_boolean(true);
+            case 'f': return accept("false", 5) && m_Handler.on_boolean(false);
+            case 'n': return accept("null", 4)  && m_Handler.on_null();
+            case 'p': return accept("point", 5) && m_Handler.on_null(); // pointers are not restored
+            case '(': return read_vector();
+            default:
+            {
+                number v;
+                return parse_number(m_Cursor, m_End, v) && m_Handler.on_number(v);
+            }
         }
-
-        return false;
     }
 
-    bool accept_hex(string& result)
+    bool read_vector()
     {
-        if (accept_digit(result))
-            return true;
-
-        auto c = peek();
-        if ((c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f'))
+        float v[4];
+        int count = 0;
+        ++m_Cursor;
+        while (true)
         {
-            advance();
-            result.push_back(static_cast<char>(c));
-            return true;
+            number n;
+            if (!parse_number(m_Cursor, m_End, n))
+                return false;
+            v[count++] = static_cast<float>(n);
+            if (accept(')'))
+                break;
+            if (count == 4 || !accept(", ", 2))
+                return false;
         }
 
+        if (count == 2)
+            return m_Handler.on_vec2(vec2(v[0], v[1]));
+        else if (count == 4)
+            return m_Handler.on_vec4(vec4(v[0], v[1], v[2], v[3]));
+
         return false;
     }
 
-    bool accept_number(value& result)
+    // Strings without escapes are returned in place, others are decoded to m_Scratch.
+    bool read_string(const char*& str, size_t& length)
     {
-        auto s = state();
+        auto begin = ++m_Cursor;
+        auto quote = static_cast<const char*>(memchr(begin, '\"', m_End - begin));
+        if (!quote)
+            return false;
+        auto escape = static_cast<const char*>(memchr(begin, '\\', quote - begin));
+        if (!escape)
+        {
+            str = begin;
+            length = quote - begin;
+            m_Cursor = quote + 1;
+            return true;
+        }
 
-        string n;
-        if (s(accept_int(n) && accept_frac(n) && accept_exp(n)))
+        m_Scratch.assign(begin, escape);
+        auto p = escape;
+        while (true)
         {
-            char* end = nullptr;
-            auto v = std::strtod(n.c_str(), &end);
-            if (end != n.c_str() + n.size())
+            if (p == m_End)
                 return false;
+            if (*p == '\"')
+                break;
+            if (*p != '\\')
+            {
+                auto run = p;
+                while (p < m_End && *p != '\"' && *p != '\\')
+                    ++p;
+                m_Scratch.append(run, p);
+                continue;
+            }
 
-            if (v != 0 && !std::isnormal(v))
+            if (++p == m_End)
                 return false;
-
-            result = v;
-            return true;
+            switch (*p++)
+            {
+                case '\"': m_Scratch.push_back('\"'); break;
+                case '\\': m_Scratch.push_back('\\'); break;
+                case '/':  m_Scratch.push_back('/');  break;
+                case 'b':  m_Scratch.push_back('\b'); break;
+                case 'f':  m_Scratch.push_back('\f'); break;
+                case 'n':  m_Scratch.push_back('\n'); break;
+                case 'r':  m_Scratch.push_back('\r'); break;
+                case 't':  m_Scratch.push_back('\t'); break;
+                case 'u':
+                {
+                    unsigned code;
+                    if (!parse_hex(p, m_End, code))
+                        return false;
+                    p += 4;
+                    // Surrogate pair
+                    unsigned low;
+                    if (code >= 0xD800 && code < 0xDC00 && m_End - p >= 6 && p[0] == '\\' && p[1] == 'u' &&
+                        parse_hex(p + 2, m_End, low) && low >= 0xDC00 && low < 0xE000)
+                    {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        p += 6;
+                    }
+                    append_utf8(m_Scratch, code);
+                    break;
+                }
+                default:
+                    return false;
+            }
         }
 
-        return false;
+        str = m_Scratch.data();
+        length = m_Scratch.size();
+        m_Cursor = p + 1;
+        return true;
     }
 
-    bool accept_int(string& result)
+    const char* m_Cursor;
+    const char* m_End;
+    Handler&    m_Handler;
+    string      m_Scratch;
+};
+
+// Builds values directly, object keys arrive sorted when reading dump() output so they are
+// appended at the end of the map.
+struct value::parser
+{
+    bool on_null()                                  { return add(value()); }
+    bool on_boolean(boolean v)                      { return add(value(v)); }
+    bool on_number(number v)                        { return add(value(v)); }
+    bool on_string(const char* str, size_t length)  { return add(value(string(str, length))); }
+    bool on_vec2(const vec2& v)                     { return add(value(v)); }
+    bool on_vec4(const vec4& v)                     { return add(value(v)); }
+    bool on_key(const char* str, size_t length)     { m_Keys.emplace_back(str, length); return true; }
+    bool on_start_object()                          { m_Stack.emplace_back(type_t::object); return true; }
+    bool on_start_array()                           { m_Stack.emplace_back(type_t::array); return true; }
+    bool on_end_object(size_t)                      { return close(); }
+    bool on_end_array(size_t)                       { return close(); }
+
+    bool close()
     {
-        auto s = state();
+        value v(std::move(m_Stack.back()));
+        m_Stack.pop_back();
+        return add(std::move(v));
+    }
 
-        string part;
-        if (s(accept_onenine(part) && accept_digits(part)))
+    bool add(value&& v)
+    {
+        if (m_Stack.empty())
         {
-            result += std::move(part);
+            m_Result = std::move(v);
             return true;
         }
 
-        part.resize(0);
-        if (accept_digit(part))
+        auto& parent = m_Stack.back();
+        if (parent.is_array())
+            array_ptr(parent.m_Storage)->emplace_back(std::move(v));
+        else
         {
-            result += std::move(part);
-            return true;
+            // Like emplace() the first of duplicated keys is kept
+            auto& o = *object_ptr(parent.m_Storage);
+            o.emplace_hint(o.end(), std::move(m_Keys.back()), std::move(v));
+            m_Keys.pop_back();
         }
+        return true;
+    }
 
-        part.resize(0);
-        if (s(accept('-') && accept_onenine(part) && accept_digits(part)))
-        {
-            result += '-';
-            result += std::move(part);
-            return true;
-        }
+    std::vector<value>  m_Stack;
+    std::vector<string> m_Keys;
+    value               m_Result;
+};
 
-        part.resize(0);
-        if (s(accept('-') && accept_digit(part)))
-        {
-            result += '-';
-            result += std::move(part);
-            return true;
-        }
+value value::parse(const string& data)
+{
+    return parse(data.c_str(), data.size());
+}
 
-        return false;
-    }
+value value::parse(const char* data, size_t size)
+{
+    parser builder;
+    reader<parser> r(data, data + size, builder);
+    if (!r.parse())
+        return value(type_t::discarded);
 
-    bool accept_digits(string& result)
-    {
-        string part;
-        if (!accept_digit(part))
-            return false;
+    return std::move(builder.m_Result);
+}
 
-        while (accept_digit(part))
-            ;
+bool parse_sax(const char* data, size_t size, sax_handler& handler)
+{
+    reader<sax_handler> r(data, data + size, handler);
+    return r.parse();
+}
 
-        result += std::move(part);
+template <typename Context>
+static void pack_be(Context& context, uint8_t prefix, uint64_t v, int bytes)
+{
+    char buffer[9];
+    buffer[0] = static_cast<char>(prefix);
+    for (int i = 0; i < bytes; ++i)
+        buffer[1 + i] = static_cast<char>(v >> ((bytes - 1 - i) * 8));
+    context.write(buffer, 1 + bytes);
+}
 
-        return true;
+// fix format for small sizes, then 16 and 32 bit sizes
+template <typename Context>
+static void pack_size(Context& context, uint8_t fix, size_t fix_limit, uint8_t prefix16, size_t size)
+{
+    if (size < fix_limit)
+        context.put(static_cast<char>(fix | size));
+    else if (size <= 0xFFFF)
+        pack_be(context, prefix16, size, 2);
+    else
+        pack_be(context, prefix16 + 1, size, 4);
+}
+
+template <typename Context>
+static void pack_string(Context& context, const string& str)
+{
+    if (str.size() < 32)
+        context.put(static_cast<char>(0xA0 | str.size()));
+    else if (str.size() <= 0xFF)
+        pack_be(context, 0xD9, str.size(), 1);
+    else
+        pack_size(context, 0, 0, 0xDA, str.size());
+    context.write(str.data(), str.size());
+}
+
+template <typename Context>
+static void pack_integer(Context& context, int64_t v)
+{
+    if (v >= 0)
+    {
+        if (v < 0x80)
+            context.put(static_cast<char>(v));
+        else if (v <= 0xFF)
+            pack_be(context, 0xCC, v, 1);
+        else if (v <= 0xFFFF)
+            pack_be(context, 0xCD, v, 2);
+        else if (v <= 0xFFFFFFFFll)
+            pack_be(context, 0xCE, v, 4);
+        else
+            pack_be(context, 0xCF, v, 8);
+    }
+    else
+    {
+        if (v >= -32)
+            context.put(static_cast<char>(v));
+        else if (v >= INT8_MIN)
+            pack_be(context, 0xD0, static_cast<uint64_t>(v), 1);
+        else if (v >= INT16_MIN)
+            pack_be(context, 0xD1, static_cast<uint64_t>(v), 2);
+        else if (v >= INT32_MIN)
+            pack_be(context, 0xD2, static_cast<uint64_t>(v), 4);
+        else
+            pack_be(context, 0xD3, static_cast<uint64_t>(v), 8);
     }
+}
+
+template <typename Context>
+static void pack_float(Context& context, float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    pack_be(context, 0xCA, bits, 4);
+}
 
-    bool accept_digit(string& result)
+template <typename Context>
+static void pack_number(Context& context, number v)
+{
+    if (v >= -9223372036854775808.0 && v < 9223372036854775808.0 && v == static_cast<double>(static_cast<int64_t>(v)) && !(v == 0 && std::signbit(v)))
+        pack_integer(context, static_cast<int64_t>(v));
+    else if (static_cast<double>(static_cast<float>(v)) == v)
+        pack_float(context, static_cast<float>(v));
+    else
     {
-        if (accept('0'))
-        {
-            result.push_back('0');
-            return true;
-        }
-        else if (accept_onenine(result))
-            return true;
+        uint64_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+        pack_be(context, 0xCB, bits, 8);
+    }
+}
 
-        return false;
+template <typename Context>
+static void pack_vector(Context& context, const float* v, int count)
+{
+    // fixext 8 type 1 or fixext 16 type 2
+    context.put(static_cast<char>(count == 2 ? 0xD7 : 0xD8));
+    context.put(static_cast<char>(count == 2 ? 1 : 2));
+    for (int i = 0; i < count; ++i)
+    {
+        uint32_t bits;
+        memcpy(&bits, &v[i], sizeof(bits));
+        char buffer[4] = { static_cast<char>(bits >> 24), static_cast<char>(bits >> 16), static_cast<char>(bits >> 8), static_cast<char>(bits) };
+        context.write(buffer, 4);
     }
+}
 
-    bool accept_onenine(string& result)
+void value::pack(dump_context_t& context) const
+{
+    switch (m_Type)
     {
-        auto c = peek();
-        if (c >= '1' && c <= '9')
-        {
-            result.push_back(static_cast<char>(c));
-            return advance();
-        }
+        case type_t::object:
+            pack_size(context, 0x80, 16, 0xDE, object_ptr(m_Storage)->size());
+            for (auto& entry : *object_ptr(m_Storage))
+            {
+                pack_string(context, entry.first);
+                entry.second.pack(context);
+            }
+            break;
 
-        return false;
+        case type_t::array:
+            pack_size(context, 0x90, 16, 0xDC, array_ptr(m_Storage)->size());
+            for (auto& entry : *array_ptr(m_Storage))
+                entry.pack(context);
+            break;
+
+        case type_t::string:    pack_string(context, *string_ptr(m_Storage)); break;
+        case type_t::boolean:   context.put(static_cast<char>(*boolean_ptr(m_Storage) ? 0xC3 : 0xC2)); break;
+        case type_t::number:    pack_number(context, *number_ptr(m_Storage)); break;
+        case type_t::point:     pack_integer(context, static_cast<int64_t>(*point_ptr(m_Storage))); break;
+        case type_t::vec2:      pack_vector(context, &vec2_ptr(m_Storage)->x, 2); break;
+        case type_t::vec4:      pack_vector(context, &vec4_ptr(m_Storage)->x, 4); break;
+        default:                context.put(static_cast<char>(0xC0)); break;
     }
+}
+
+std::vector<uint8_t> value::to_msgpack() const
+{
+    dump_context_t context(-1, ' ');
+    pack(context);
+    return std::vector<uint8_t>(context.out.begin(), context.out.end());
+}
 
-    bool accept_frac(string& result)
+struct unpacker
+{
+    unpacker(const uint8_t* begin, const uint8_t* end)
+        : m_Cursor(begin)
+        , m_End(end)
+    {
+    }
+
+    bool read(value& result, int depth)
     {
-        auto s = state();
+        if (depth > max_depth || m_Cursor == m_End)
+            return false;
 
-        string part;
-        if (s(accept('.') && accept_digits(part)))
+        const uint8_t c = *m_Cursor++;
+        if (c <= 0x7F)          { result = static_cast<number>(c); return true; }
+        if (c >= 0xE0)          { result = static_cast<number>(static_cast<int8_t>(c)); return true; }
+        if ((c & 0xF0) == 0x80) return read_object(result, c & 0x0F, depth);
+        if ((c & 0xF0) == 0x90) return read_array(result, c & 0x0F, depth);
+        if ((c & 0xE0) == 0xA0) return read_string(result, c & 0x1F);
+
+        uint64_t n = 0;
+        switch (c)
         {
-            result += '.';
-            result += std::move(part);
-        }
+            case 0xC0: result = nullptr; return true;
+            case 0xC2: result = false;   return true;
+            case 0xC3: result = true;    return true;
 
-        return true;
+            // bin is read as string
+            case 0xC4: case 0xD9: return read_be(1, n) && read_string(result, n);
+            case 0xC5: case 0xDA: return read_be(2, n) && read_string(result, n);
+            case 0xC6: case 0xDB: return read_be(4, n) && read_string(result, n);
+
+            case 0xCA: { float  v; if (!read_float(v)) return false; result = static_cast<number>(v); return true; }
+            case 0xCB:
+            {
+                if (!read_be(8, n))
+                    return false;
+                double v;
+                memcpy(&v, &n, sizeof(v));
+                result = v;
+                return true;
+            }
+
+            case 0xCC: if (!read_be(1, n)) return false; result = static_cast<number>(n); return true;
+            case 0xCD: if (!read_be(2, n)) return false; result = static_cast<number>(n); return true;
+            case 0xCE: if (!read_be(4, n)) return false; result = static_cast<number>(n); return true;
+            case 0xCF: if (!read_be(8, n)) return false; result = static_cast<number>(n); return true;
+            case 0xD0: if (!read_be(1, n)) return false; result = static_cast<number>(static_cast<int8_t>(n));  return true;
+            case 0xD1: if (!read_be(2, n)) return false; result = static_cast<number>(static_cast<int16_t>(n)); return true;
+            case 0xD2: if (!read_be(4, n)) return false; result = static_cast<number>(static_cast<int32_t>(n)); return true;
+            case 0xD3: if (!read_be(8, n)) return false; result = static_cast<number>(static_cast<int64_t>(n)); return true;
+
+            case 0xD7:
+            {
+                vec2 v;
+                if (!read_be(1, n) || n != 1 || !read_float(v.x) || !read_float(v.y))
+                    return false;
+                result = v;
+                return true;
+            }
+            case 0xD8:
+            {
+                vec4 v;
+                if (!read_be(1, n) || n != 2 || !read_float(v.x) || !read_float(v.y) || !read_float(v.z) || !read_float(v.w))
+                    return false;
+                result = v;
+                return true;
+            }
+
+            case 0xDC: return read_be(2, n) && read_array(result, n, depth);
+            case 0xDD: return read_be(4, n) && read_array(result, n, depth);
+            case 0xDE: return read_be(2, n) && read_object(result, n, depth);
+            case 0xDF: return read_be(4, n) && read_object(result, n, depth);
+
+            default:
+                return false;
+        }
     }
 
-    bool accept_exp(string& result)
+    bool eof() const
     {
-        auto s = state();
+        return m_Cursor == m_End;
+    }
 
-        string part;
-        if (s(accept('e') && accept_sign(part) && accept_digits(part)))
-        {
-            result += 'e';
-            result += std::move(part);
-            return true;
-        }
-        part.resize(0);
-        if (s(accept('E') && accept_sign(part) && accept_digits(part)))
-        {
-            result += 'E';
-            result += std::move(part);
-        }
+private:
+    enum { max_depth = 1024 };
 
+    bool read_be(int bytes, uint64_t& result)
+    {
+        if (m_End - m_Cursor < bytes)
+            return false;
+        result = 0;
+        for (int i = 0; i < bytes; ++i)
+            result = (result << 8) | *m_Cursor++;
         return true;
     }
 
-    bool accept_sign(string& result)
+    bool read_float(float& result)
     {
-        if (accept('+'))
-            result.push_back('+');
-        else if (accept('-'))
-            result.push_back('-');
+        uint64_t n;
+        if (!read_be(4, n))
+            return false;
+        const uint32_t bits = static_cast<uint32_t>(n);
+        memcpy(&result, &bits, sizeof(result));
+        return true;
+    }
 
+    bool read_string(value& result, uint64_t size)
+    {
+        if (static_cast<uint64_t>(m_End - m_Cursor) < size)
+            return false;
+        result = string(reinterpret_cast<const char*>(m_Cursor), static_cast<size_t>(size));
+        m_Cursor += size;
         return true;
     }
 
-    bool accept_ws()
+    bool read_array(value& result, uint64_t count, int depth)
     {
-        while (expect('\x09') || expect('\x0A') || expect('\x0D') || expect('\x20'))
-            advance();
+        // Every element takes at least one byte
+        if (static_cast<uint64_t>(m_End - m_Cursor) < count)
+            return false;
+
+        array a;
+        a.resize(static_cast<size_t>(count));
+        for (auto& element : a)
+            if (!read(element, depth + 1))
+                return false;
+        result = std::move(a);
         return true;
     }
 
-    bool accept_boolean(value& result)
+    bool read_object(value& result, uint64_t count, int depth)
     {
-        if (accept("true"))
-        {
-            result = true;
-            return true;
-        }
-        else if (accept("false"))
+        if (static_cast<uint64_t>(m_End - m_Cursor) < count * 2)
+            return false;
+
+        object o;
+        for (uint64_t i = 0; i < count; ++i)
         {
-            result = false;
-            return true;
+            value key, v;
+            if (!read(key, depth + 1) || !key.is_string() || !read(v, depth + 1))
+                return false;
+            o.emplace_hint(o.end(), std::move(key.get<string>()), std::move(v));
         }
+        result = std::move(o);
+        return true;
+    }
 
-        return false;
+    const uint8_t* m_Cursor;
+    const uint8_t* m_End;
+};
+
+value value::from_msgpack(const void* data, size_t size)
+{
+    auto begin = static_cast<const uint8_t*>(data);
+    unpacker u(begin, begin + size);
+    value result;
+    if (!u.read(result, 0) || !u.eof())
+        return value(type_t::discarded);
+
+    return result;
+}
+
+struct document_builder
+{
+    document_builder(document& doc, const char* begin, const char* end)
+        : m_Document(doc)
+        , m_Begin(begin)
+        , m_End(end)
+    {
     }
 
-    bool accept_point(value& result)
+    bool on_null()
     {
-        if (accept("point"))
-        {
-            result = nullptr;
-            return true;
-        }
+        return add(document_node());
+    }
 
-        return false;
+    bool on_boolean(boolean v)
+    {
+        document_node n;
+        n.m_Type = type_t::boolean;
+        n.m_Boolean = v;
+        return add(n);
     }
 
-    bool accept_vec2(value& result)
+    bool on_number(number v)
     {
-        auto s = state();
-        vec2 v;
-        if (s(accept('(') && accept_elements(v) && accept(')')))
-        {
-            result = v;
-            return true;
-        }
+        document_node n;
+        n.m_Type = type_t::number;
+        n.m_Number = v;
+        return add(n);
+    }
 
-        return false;
+    bool on_string(const char* str, size_t length)
+    {
+        document_node n;
+        n.m_Type = type_t::string;
+        n.m_String = keep(str, length);
+        n.m_Size = static_cast<uint32_t>(length);
+        return length <= UINT32_MAX && add(n);
     }
 
-    bool accept_vec4(value& result)
+    bool on_vec2(const vec2& v)
     {
-        auto s = state();
-        vec4 v;
-        if (s(accept('(') && accept_elements(v) && accept(')')))
-        {
-            result = v;
-            return true;
-        }
+        document_node n;
+        n.m_Type = type_t::vec2;
+        n.m_Vector[0] = v.x; n.m_Vector[1] = v.y;
+        return add(n);
+    }
 
-        return false;
+    bool on_vec4(const vec4& v)
+    {
+        document_node n;
+        n.m_Type = type_t::vec4;
+        n.m_Vector[0] = v.x; n.m_Vector[1] = v.y; n.m_Vector[2] = v.z; n.m_Vector[3] = v.w;
+        return add(n);
     }
 
-    bool accept_null(value& result)
+    bool on_key(const char* str, size_t length)
     {
-        if (accept("null"))
-        {
-            result = nullptr;
-            return true;
-        }
+        document_member m;
+        m.key.data = keep(str, length);
+        m.key.size = length;
+        m_Members.push_back(m);
+        return true;
+    }
 
-        return false;
+    bool on_start_object()
+    {
+        m_Starts.emplace_back(m_Members.size(), true);
+        return true;
     }
 
-    bool accept(char c)
+    bool on_start_array()
     {
-        if (expect(c))
-            return advance();
-        else
-            return false;
+        m_Starts.emplace_back(m_Elements.size(), false);
+        return true;
     }
 
-    bool accept(const char* str)
+    bool on_end_object(size_t)
     {
-        auto last = m_Cursor;
+        const size_t start = m_Starts.back().first;
+        m_Starts.pop_back();
+
+        size_t count = m_Members.size() - start;
+        auto members = static_cast<document_member*>(m_Document.allocate(count * sizeof(document_member)));
+        std::copy(m_Members.begin() + start, m_Members.end(), members);
+        m_Members.resize(start);
+
+        auto less = [](const document_member& lhs, const document_member& rhs) { return lhs.key.compare(rhs.key.data, rhs.key.size) < 0; };
+        if (!std::is_sorted(members, members + count, less))
+            std::stable_sort(members, members + count, less);
+        // Keep first of duplicated keys, like value does
+        auto equal = [](const document_member& lhs, const document_member& rhs) { return lhs.key.compare(rhs.key.data, rhs.key.size) == 0; };
+        count = std::unique(members, members + count, equal) - members;
+
+        document_node n;
+        n.m_Type = type_t::object;
+        n.m_Members = members;
+        n.m_Size = static_cast<uint32_t>(count);
+        return count <= UINT32_MAX && add(n);
+    }
 
-        while (*str)
-        {
-            if (eof() || *str != *m_Cursor)
-            {
-                m_Cursor = last;
-                return false;
-            }
+    bool on_end_array(size_t)
+    {
+        const size_t start = m_Starts.back().first;
+        m_Starts.pop_back();
+
+        const size_t count = m_Elements.size() - start;
+        auto elements = static_cast<document_node*>(m_Document.allocate(count * sizeof(document_node)));
+        std::copy(m_Elements.begin() + start, m_Elements.end(), elements);
+        m_Elements.resize(start);
+
+        document_node n;
+        n.m_Type = type_t::array;
+        n.m_Elements = elements;
+        n.m_Size = static_cast<uint32_t>(count);
+        return count <= UINT32_MAX && add(n);
+    }
 
-            advance();
-            ++str;
-        }
+    // Strings decoded to the reader scratch buffer are copied to the arena.
+    const char* keep(const char* str, size_t length)
+    {
+        if (str >= m_Begin && str <= m_End)
+            return str;
+        auto copy = static_cast<char*>(m_Document.allocate(length));
+        memcpy(copy, str, length);
+        return copy;
+    }
 
+    bool add(const document_node& n)
+    {
+        if (m_Starts.empty())
+            m_Root = n;
+        else if (m_Starts.back().second)
+            m_Members.back().value = n;
+        else
+            m_Elements.push_back(n);
         return true;
     }
 
-    int peek() const
+    document&                       m_Document;
+    const char*                     m_Begin;
+    const char*                     m_End;
+    document_node                   m_Root;
+    std::vector<std::pair<size_t, bool>> m_Starts; // first member or element, is object
+    std::vector<document_member>    m_Members;
+    std::vector<document_node>      m_Elements;
+};
+
+const document_node* document_node::find(const char* key, size_t length) const
+{
+    if (!is_object())
+        return nullptr;
+
+    auto first = m_Members;
+    size_t count = m_Size;
+    while (count > 0)
     {
-        if (!eof())
-            return *m_Cursor;
+        const size_t half = count / 2;
+        if (first[half].key.compare(key, length) < 0)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
         else
-            return -1;
+            count = half;
     }
 
-    bool expect(char c)
+    if (first != m_Members + m_Size && first->key.compare(key, length) == 0)
+        return &first->value;
+
+    return nullptr;
+}
+
+const document_node& document_node::operator[](const char* key) const
+{
+    static const document_node null_node;
+    auto n = find(key);
+    return n ? *n : null_node;
+}
+
+value document_node::to_value() const
+{
+    switch (m_Type)
     {
-        return peek() == c;
+        case type_t::object:
+        {
+            object o;
+            for (uint32_t i = 0; i < m_Size; ++i)
+                o.emplace_hint(o.end(), m_Members[i].key.str(), m_Members[i].value.to_value());
+            return value(std::move(o));
+        }
+        case type_t::array:
+        {
+            array a;
+            a.reserve(m_Size);
+            for (uint32_t i = 0; i < m_Size; ++i)
+                a.push_back(m_Elements[i].to_value());
+            return value(std::move(a));
+        }
+        case type_t::string:    return value(string(m_String, m_Size));
+        case type_t::boolean:   return value(m_Boolean);
+        case type_t::number:    return value(m_Number);
+        case type_t::vec2:      return value(get_vec2());
+        case type_t::vec4:      return value(get_vec4());
+        default:                return value();
     }
+}
 
-    bool advance(int count = 1)
+void* document::allocate(size_t size)
+{
+    size = (size + 7) & ~size_t(7);
+    if (size > static_cast<size_t>(m_BlockEnd - m_BlockCursor))
     {
-        if (m_Cursor + count > m_End)
+        // Large arrays get their own block, the current one stays in use
+        if (size > block_size / 4)
         {
-            m_Cursor = m_End;
-            return false;
+            auto large = ::operator new(size);
+            m_Blocks.push_back(large);
+            m_ArenaSize += size;
+            return large;
         }
 
-        m_Cursor += count;
-
-        return true;
+        auto block = static_cast<char*>(::operator new(block_size));
+        m_Blocks.push_back(block);
+        m_ArenaSize += block_size;
+        m_BlockCursor = block;
+        m_BlockEnd = block + block_size;
     }
 
-    bool eof() const
+    auto result = m_BlockCursor;
+    m_BlockCursor += size;
+    return result;
+}
+
+bool document::build(const char* data, size_t size)
+{
+    document_builder builder(*this, data, data + size);
+    reader<document_builder> r(data, data + size, builder);
+    if (!r.parse())
     {
-        return m_Cursor == m_End;
+        clear();
+        return false;
     }
 
-    const char* m_Cursor;
-    const char* m_End;
-};
+    m_Root = builder.m_Root;
+    return true;
+}
 
-value value::parse(const string& data)
+bool document::parse(const char* data, size_t size)
 {
-    auto p = parser(data.c_str(), data.c_str() + data.size());
+    clear();
+    return build(data, size);
+}
 
-    auto v = p.parse();
+void document::clear()
+{
+    for (auto block : m_Blocks)
+        ::operator delete(block);
+    m_Blocks.clear();
+    m_BlockCursor = nullptr;
+    m_BlockEnd = nullptr;
+    m_ArenaSize = 0;
+# if JSON_IO
+    if (m_Mapped)
+        unmap_file(m_Mapped, m_MappedSize);
+# endif
+    m_Mapped = nullptr;
+    m_MappedSize = 0;
+    m_Root = document_node();
+}
 
-    return v;
+void document::swap(document& other)
+{
+    using std::swap;
+    swap(m_Root,        other.m_Root);
+    swap(m_Blocks,      other.m_Blocks);
+    swap(m_BlockCursor, other.m_BlockCursor);
+    swap(m_BlockEnd,    other.m_BlockEnd);
+    swap(m_ArenaSize,   other.m_ArenaSize);
+    swap(m_Mapped,      other.m_Mapped);
+    swap(m_MappedSize,  other.m_MappedSize);
 }
 
 # if JSON_IO
-std::pair<value, bool> value::load(const string& path)
+bool document::load(const string& path)
 {
-    // Modern C++, so beautiful...
-    std::unique_ptr<FILE, void(*)(FILE*)> file{nullptr, [](FILE* file) { if (file) fclose(file); }};
-# if defined(_MSC_VER) || (defined(__STDC_LIB_EXT1__) && __STDC_WANT_LIB_EXT1__)
-    FILE* handle = nullptr;
-    if (fopen_s(&handle, path.c_str(), "rb") != 0)
-        return {value{}, false};
-    file.reset(handle);
-# else
-    file.reset(fopen(path.c_str(), "rb"));
-# endif
+    clear();
 
-    if (!file)
+    void* data = nullptr;
+    size_t size = 0;
+    if (!map_file(path, data, size))
+        return false;
+
+    if (data)
+    {
+        m_Mapped = data;
+        m_MappedSize = size;
+        return build(static_cast<const char*>(data), size);
+    }
+
+    // Not mappable, strings point into a copy kept in the arena
+    string buffer;
+    if (!read_file(path, buffer))
+        return false;
+    auto copy = static_cast<char*>(allocate(buffer.size()));
+    memcpy(copy, buffer.data(), buffer.size());
+    return build(copy, buffer.size());
+}
+
+bool load_sax(const string& path, sax_handler& handler)
+{
+    void* data = nullptr;
+    size_t size = 0;
+    if (!map_file(path, data, size))
+        return false;
+
+    if (data)
+    {
+        const bool result = parse_sax(static_cast<const char*>(data), size, handler);
+        unmap_file(data, size);
+        return result;
+    }
+
+    string buffer;
+    return read_file(path, buffer) && parse_sax(buffer.data(), buffer.size(), handler);
+}
+
+std::pair<value, bool> value::load(const string& path)
+{
+    void* data = nullptr;
+    size_t size = 0;
+    if (!map_file(path, data, size))
         return {value{}, false};
 
-    fseek(file.get(), 0, SEEK_END);
-    auto size = static_cast<size_t>(ftell(file.get()));
-    fseek(file.get(), 0, SEEK_SET);
+    if (data)
+    {
+        auto v = parse(static_cast<const char*>(data), size);
+        unmap_file(data, size);
+        return {std::move(v), true};
+    }
 
-    string data;
-    data.resize(size);
-    if (fread(const_cast<char*>(data.data()), size, 1, file.get()) != 1)
+    string buffer;
+    if (!read_file(path, buffer))
         return {value{}, false};
 
-    return {parse(data), true};
+    return {parse(buffer), true};
 }
 
-bool value::save(const string& path, const int indent, const char indent_char) const
+static FILE* open_for_write(const string& path)
 {
-    // Modern C++, so beautiful...
-    std::unique_ptr<FILE, void(*)(FILE*)> file{nullptr, [](FILE* file) { if (file) fclose(file); }};
 # if defined(_MSC_VER) || (defined(__STDC_LIB_EXT1__) && __STDC_WANT_LIB_EXT1__)
     FILE* handle = nullptr;
     if (fopen_s(&handle, path.c_str(), "wb") != 0)
-        return false;
-    file.reset(handle);
+        return nullptr;
+    return handle;
 # else
-    file.reset(fopen(path.c_str(), "wb"));
+    return fopen(path.c_str(), "wb");
 # endif
+}
 
+bool value::save(const string& path, const int indent, const char indent_char) const
+{
+    // Modern C++, so beautiful...
+    std::unique_ptr<FILE, void(*)(FILE*)> file{open_for_write(path), [](FILE* file) { if (file) fclose(file); }};
     if (!file)
         return false;
 
-    auto data = dump(indent, indent_char);
+    dump_context_t context(indent, indent_char, file.get());
+    dump(context, 0);
+    context.flush();
+
+    return !context.failed;
+}
+
+std::pair<value, bool> value::load_msgpack(const string& path)
+{
+    void* data = nullptr;
+    size_t size = 0;
+    if (!map_file(path, data, size))
+        return {value{}, false};
 
-    if (fwrite(data.data(), data.size(), 1, file.get()) != 1)
+    if (data)
+    {
+        auto v = from_msgpack(data, size);
+        unmap_file(data, size);
+        return {std::move(v), true};
+    }
+
+    string buffer;
+    if (!read_file(path, buffer))
+        return {value{}, false};
+
+    return {from_msgpack(buffer.data(), buffer.size()), true};
+}
+
+bool value::save_msgpack(const string& path) const
+{
+    std::unique_ptr<FILE, void(*)(FILE*)> file{open_for_write(path), [](FILE* file) { if (file) fclose(file); }};
+    if (!file)
         return false;
 
-    return true;
+    dump_context_t context(-1, ' ', file.get());
+    pack(context);
+    context.flush();
+
+    return !context.failed;
 }
 
 # endif
@@ -9,6 +9,8 @@
 # include <cstdint>
 # include <algorithm>
 # include <sstream>
+# include <cstdio>
+# include <cstring>
 
 # ifndef JSON_ASSERT
 #     include <cassert>
@@ -50,7 +52,7 @@ enum class type_t
 struct IMGUI_API value
 {
     value(type_t type = type_t::null): m_Type(construct(m_Storage, type)) {}
-    value(value&& other);
+    value(value&& other) noexcept;
     value(const value& other);
 
     value(      null)      : m_Type(construct(m_Storage,      null()))  {}
@@ -132,10 +134,20 @@ struct IMGUI_API value
 
     // Returns discarded value for invalid inputs.
     static value parse(const string& data);
+    static value parse(const char* data, size_t size);
+
+    // MessagePack encoding of the same model. Numbers are packed as integers or float32 when
+    // that is exact, vec2 and vec4 as fixext 8 and fixext 16 of type 1 and 2, pointers as integers.
+    std::vector<uint8_t> to_msgpack() const;
+    // Returns discarded value for invalid inputs.
+    static value from_msgpack(const void* data, size_t size);
 
 # if JSON_IO
     static std::pair<value, bool> load(const string& path);
+    // Output is written in chunks while it is generated.
     bool save(const string& path, const int indent = 4, const char indent_char = ' ') const;
+    static std::pair<value, bool> load_msgpack(const string& path);
+    bool save_msgpack(const string& path) const;
 # endif
 
 private:
@@ -225,23 +237,38 @@ private:
 
     struct dump_context_t
     {
-        std::ostringstream out;
-        const int  indent = -1;
-        const char indent_char = ' ';
+        string      out;
+        FILE*       file = nullptr;
+        bool        failed = false;
+        const int   indent = -1;
+        const char  indent_char = ' ';
 
         // VS2015: Aggregate initialization isn't a thing yet.
-        dump_context_t(const int indent, const char indent_char)
-            : indent(indent)
+        dump_context_t(const int indent, const char indent_char, FILE* file = nullptr)
+            : file(file)
+            , indent(indent)
             , indent_char(indent_char)
         {
         }
 
+        // Output goes to file every flush_size bytes when there is one.
+        enum { flush_size = 1 << 20 };
+
+        void write(const char* data, size_t size) { out.append(data, size); if (file && out.size() >= flush_size) flush(); }
+        void put(char c)                          { out.push_back(c);       if (file && out.size() >= flush_size) flush(); }
+        void flush();
+
         void write_indent(int level);
         void write_separator();
         void write_newline();
+        void write_string(const string& str);
+        void write_number(number v);
+        void write_float(float v);
+        void write_integer(int64_t v);
     };
 
     void dump(dump_context_t& context, int level) const;
+    void pack(dump_context_t& context) const;
 
     storage_t m_Storage;
     type_t    m_Type;
@@ -306,6 +333,155 @@ inline bool GetTo(const imgui_json::value& value, std::string key, V& result)
     return true;
 };
 
+// SAX style parsing, handler is called for every token while the input is scanned once.
+// Strings and keys point into the input when they have no escapes, into a scratch buffer
+// otherwise, both are only valid during the call. Returning false stops parsing.
+struct IMGUI_API sax_handler
+{
+    virtual ~sax_handler() {}
+
+    virtual bool on_null()                                  { return true; }
+    virtual bool on_boolean(boolean v)                      { (void)v; return true; }
+    virtual bool on_number(number v)                        { (void)v; return true; }
+    virtual bool on_string(const char* str, size_t length)  { (void)str; (void)length; return true; }
+    virtual bool on_vec2(const vec2& v)                     { (void)v; return true; }
+    virtual bool on_vec4(const vec4& v)                     { (void)v; return true; }
+    virtual bool on_key(const char* str, size_t length)     { (void)str; (void)length; return true; }
+    virtual bool on_start_object()                          { return true; }
+    virtual bool on_end_object(size_t count)                { (void)count; return true; }
+    virtual bool on_start_array()                           { return true; }
+    virtual bool on_end_array(size_t count)                 { (void)count; return true; }
+};
+
+// Returns false for invalid inputs or when handler stopped parsing.
+IMGUI_API bool parse_sax(const char* data, size_t size, sax_handler& handler);
+# if JSON_IO
+// File is mapped to memory and parsed in place.
+IMGUI_API bool load_sax(const string& path, sax_handler& handler);
+# endif
+
+struct string_ref
+{
+    const char* data = nullptr;
+    size_t      size = 0;
+
+    string str() const { return string(data, size); }
+    int compare(const char* str, size_t length) const
+    {
+        int r = memcmp(data, str, size < length ? size : length);
+        return r != 0 ? r : (size < length ? -1 : (size > length ? 1 : 0));
+    }
+    bool operator==(const char* str) const { return compare(str, strlen(str)) == 0; }
+    bool operator!=(const char* str) const { return !(*this == str); }
+};
+
+struct document_member;
+struct document_builder;
+
+// Read only value of a document, cheap to copy.
+struct IMGUI_API document_node
+{
+    type_t type() const { return m_Type; }
+
+    bool is_primitive()  const { return is_string() || is_number() || is_boolean() || is_null(); }
+    bool is_structured() const { return is_object() || is_array();   }
+    bool is_null()       const { return m_Type == type_t::null;      }
+    bool is_object()     const { return m_Type == type_t::object;    }
+    bool is_array()      const { return m_Type == type_t::array;     }
+    bool is_string()     const { return m_Type == type_t::string;    }
+    bool is_boolean()    const { return m_Type == type_t::boolean;   }
+    bool is_number()     const { return m_Type == type_t::number;    }
+    bool is_vec2()       const { return m_Type == type_t::vec2;      }
+    bool is_vec4()       const { return m_Type == type_t::vec4;      }
+
+    // Number of elements of arrays and members of objects, 0 otherwise.
+    size_t size() const { return is_structured() ? m_Size : 0; }
+
+    // Array elements, index must be in range.
+    const document_node& operator[](size_t index) const { JSON_ASSERT(is_array() && index < m_Size); return m_Elements[index]; }
+    const document_node* begin() const { return is_array() ? m_Elements : nullptr; }
+    const document_node* end()   const { return is_array() ? m_Elements + m_Size : nullptr; }
+
+    // Object members sorted by key, lookup is a binary search. Missing keys return a null node.
+    const document_member* members() const { return is_object() ? m_Members : nullptr; }
+    const document_node* find(const char* key, size_t length) const;
+    const document_node* find(const char* key) const { return find(key, strlen(key)); }
+    const document_node* find(const string& key) const { return find(key.data(), key.size()); }
+    const document_node& operator[](const char* key) const;
+    const document_node& operator[](const string& key) const { return (*this)[key.c_str()]; }
+    bool contains(const char* key) const { return find(key) != nullptr; }
+    bool contains(const string& key) const { return find(key) != nullptr; }
+
+    boolean    get_boolean() const { JSON_ASSERT(is_boolean()); return m_Boolean; }
+    number     get_number()  const { JSON_ASSERT(is_number());  return m_Number;  }
+    string_ref get_string()  const { JSON_ASSERT(is_string());  string_ref r; r.data = m_String; r.size = m_Size; return r; }
+    vec2       get_vec2()    const { JSON_ASSERT(is_vec2());    return vec2(m_Vector[0], m_Vector[1]); }
+    vec4       get_vec4()    const { JSON_ASSERT(is_vec4());    return vec4(m_Vector[0], m_Vector[1], m_Vector[2], m_Vector[3]); }
+
+    // Deep copy to a regular value.
+    value to_value() const;
+
+private:
+    friend struct document_builder;
+
+    type_t   m_Type = type_t::null;
+    uint32_t m_Size = 0;
+    union
+    {
+        boolean                 m_Boolean;
+        number                  m_Number = 0;
+        const char*             m_String;
+        const document_node*    m_Elements;
+        const document_member*  m_Members;
+        float                   m_Vector[4];
+    };
+};
+
+struct document_member
+{
+    string_ref      key;
+    document_node   value;
+};
+
+// Read only DOM built in a single pass. Nodes and escaped strings are allocated from one arena,
+// other strings are views into the input, so the input must outlive the document unless it was
+// loaded from a file, in which case the document keeps the file mapped. Inputs are limited to 4 GB.
+struct IMGUI_API document
+{
+    document() = default;
+    document(document&& other) noexcept { swap(other); }
+    document& operator=(document&& other) noexcept { if (this != &other) { document(std::move(other)).swap(*this); } return *this; }
+    document(const document&) = delete;
+    document& operator=(const document&) = delete;
+    ~document() { clear(); }
+
+    // Returns false for invalid inputs, root is null then.
+    bool parse(const char* data, size_t size);
+# if JSON_IO
+    bool load(const string& path);
+# endif
+    void clear();
+    void swap(document& other);
+
+    const document_node& root() const { return m_Root; }
+    size_t memory_usage() const { return m_ArenaSize; }
+
+private:
+    friend struct document_builder;
+    enum { block_size = 1 << 20 };
+
+    bool build(const char* data, size_t size);
+    void* allocate(size_t size);
+
+    document_node       m_Root;
+    std::vector<void*>  m_Blocks;
+    char*               m_BlockCursor = nullptr;
+    char*               m_BlockEnd = nullptr;
+    size_t              m_ArenaSize = 0;
+    void*               m_Mapped = nullptr;
+    size_t              m_MappedSize = 0;
+};
+
 } // namespace imgui_json
 
 # endif // __IMGUI_JSON_H__
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <Logger.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Check the async mode of Logger: records of several threads through a small blocking ring, the records formatted by
+// the writer thread, StopAsyncLogging() while a producer is blocked on a full ring, and a process exiting without
+// StopAsyncLogging().
+// Usage: async_logger_test [records_per_thread]
+static int g_errors = 0;
+
+static void check(bool ok, const char* what)
+{
+    fprintf(stderr, "    %-52s: %s\n", what, ok ? "OK" : "FAILED");
+    g_errors += ok ? 0 : 1;
+}
+
+struct CountingSink : public Logger::LogSink
+{
+    void Write(const char* data, size_t size) override
+    {
+        std::lock_guard<std::mutex> lk(m_lock);
+        for (size_t i = 0; i < size; i++)
+            m_lines += data[i] == '\n' ? 1 : 0;
+        if (m_writeDelayMs > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(m_writeDelayMs));
+    }
+
+    void Flush() override {}
+
+    int GetLines()
+    {
+        std::lock_guard<std::mutex> lk(m_lock);
+        return m_lines;
+    }
+
+    std::mutex m_lock;
+    int m_lines{0};
+    int m_writeDelayMs{0};
+};
+
+struct TextSink : public Logger::LogSink
+{
+    void Write(const char* data, size_t size) override
+    {
+        std::lock_guard<std::mutex> lk(m_lock);
+        m_text.append(data, size);
+    }
+
+    void Flush() override {}
+
+    std::mutex m_lock;
+    std::string m_text;
+};
+
+// Stop in another thread, a deadlock is reported instead of hanging the test
+static bool stop_within(int seconds)
+{
+    auto stopped = std::async(std::launch::async, [] { Logger::StopAsyncLogging(); });
+    if (stopped.wait_for(std::chrono::seconds(seconds)) == std::future_status::ready)
+        return true;
+    fprintf(stderr, "    StopAsyncLogging() did not return\n");
+    fflush(stderr);
+    _Exit(1);
+}
+
+static int exit_without_stop(const char* path, int records)
+{
+    Logger::StartAsyncLogging(Logger::CreateRotatingFileLogSink(path), 4096, Logger::BLOCK_WHEN_FULL);
+    for (int i = 0; i < records; i++)
+        Logger::GetLogger("Exit")->Log(Logger::INFO, "record %d", i);
+    return 0;
+}
+
+int main(int argc, char ** argv)
+{
+    if (argc > 3 && std::string(argv[1]) == "--exit-without-stop")
+        return exit_without_stop(argv[2], atoi(argv[3]));
+    int records = argc > 1 ? atoi(argv[1]) : 20000;
+    if (records <= 0)
+        return -1;
+    fprintf(stderr, "Async logging, %d records per thread\n", records);
+
+    // Start, push from several threads through a ring smaller than the records, stop
+    const int threads_count = 4;
+    auto sink = std::make_shared<CountingSink>();
+    check(Logger::StartAsyncLogging(sink, 4096, Logger::BLOCK_WHEN_FULL), "start");
+    check(!Logger::StartAsyncLogging(sink, 4096, Logger::BLOCK_WHEN_FULL), "second start refused");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threads_count; t++)
+        threads.emplace_back([t, records] {
+            Logger::ALogger* logger = Logger::GetLogger("Thread" + std::to_string(t));
+            for (int i = 0; i < records; i++)
+                logger->Log(Logger::INFO, "record %d of thread %d", i, t);
+        });
+    for (auto& thread : threads)
+        thread.join();
+    Logger::FlushAsyncLogging();
+    check(sink->GetLines() == threads_count * records, "flush writes every record");
+    check(stop_within(10), "stop");
+    check(sink->GetLines() == threads_count * records && Logger::GetDroppedLogCount() == 0, "blocking ring drops nothing");
+
+    // The writer thread formats the records the same way as snprintf()
+    auto text_sink = std::make_shared<TextSink>();
+    Logger::StartAsyncLogging(text_sink, 64 * 1024, Logger::BLOCK_WHEN_FULL);
+    Logger::ALogger* format_logger = Logger::GetLogger("Format");
+    format_logger->SetShowTime(false)->SetShowLevelName(false);
+    std::string expected;
+    char line[512];
+#define LOG_AND_EXPECT(...) \
+    format_logger->Log(Logger::INFO, __VA_ARGS__); \
+    snprintf(line, sizeof(line), __VA_ARGS__); \
+    expected += std::string("[Format] ") + line + "\n";
+    std::string temporary = "temporary string";
+    LOG_AND_EXPECT("%d %i %5d|%-5d|%05d %+d % d", -42, 7, 3, 4, 5, 6, 8);
+    LOG_AND_EXPECT("%hhd %hd %hhu %hu %ld %lld %llu", 300, 70000, 300, 70000, -1234567890L, -123456789012345LL, 18446744073709551615ULL);
+    LOG_AND_EXPECT("%zu %zd %td %jd %x %X %#o %#x", (size_t)12345, (ptrdiff_t)-3, (ptrdiff_t)-4, (intmax_t)-5, 0xbeefu, 0xcafeu, 8u, 255u);
+    LOG_AND_EXPECT("%f %.2f %10.3e %g %G %a %Lf", 3.14159, 2.71828, 12345.678, 0.0001, 1e20, 1.0, (long double)1.5);
+    LOG_AND_EXPECT("%*d|%-*d|%.*f|%*.*s|", 6, 1, 4, 2, 3, 1.23456, 8, 3, "abcdef");
+    LOG_AND_EXPECT("%c%c %s %.4s %10s %-10s| %s %p 100%%", 'o', 'k', temporary.c_str(), "truncated", "right", "left", (const char*)nullptr, (void*)0x1234);
+    temporary.assign(temporary.size(), 'x');
+    LOG_AND_EXPECT("no arguments");
+    LOG_AND_EXPECT("%1$d positional arguments are formatted by the caller", 9);
+    Logger::FlushAsyncLogging();
+    check(stop_within(10), "stop after formatting");
+    check(text_sink->m_text == expected, "records formatted by the writer thread");
+    if (text_sink->m_text != expected)
+        fprintf(stderr, "%s\n-- expected --\n%s", text_sink->m_text.c_str(), expected.c_str());
+
+    // Stop while a producer is blocked on its full ring behind a slow sink
+    auto slow_sink = std::make_shared<CountingSink>();
+    slow_sink->m_writeDelayMs = 5;
+    Logger::StartAsyncLogging(slow_sink, 4096, Logger::BLOCK_WHEN_FULL);
+    std::atomic<bool> producing{true};
+    std::atomic<int> pushed{0};
+    std::thread producer([&] {
+        Logger::ALogger* logger = Logger::GetLogger("Blocked");
+        while (producing)
+        {
+            logger->Log(Logger::INFO, "a long enough record to fill the ring quickly, number %d", (int)pushed);
+            pushed++;
+        }
+    });
+    while (pushed < 1000)
+        std::this_thread::yield();
+    check(stop_within(10), "stop with a blocked producer");
+    producing = false;
+    producer.join();
+
+    // Exit without StopAsyncLogging(), the records are written when the writer is destroyed
+    const std::string path = "async_logger_test.log";
+    remove(path.c_str());
+    const std::string command = std::string(argv[0]) + " --exit-without-stop " + path + " " + std::to_string(records);
+    const int status = system(command.c_str());
+    int lines = 0;
+    if (FILE* file = fopen(path.c_str(), "rb"))
+    {
+        for (int c = fgetc(file); c != EOF; c = fgetc(file))
+            lines += c == '\n' ? 1 : 0;
+        fclose(file);
+    }
+    remove(path.c_str());
+    check(status == 0 && lines == records, "exit without stop");
+
+    fprintf(stderr, "%s\n", g_errors ? "FAILED" : "OK");
+    return g_errors ? 1 : 0;
+}
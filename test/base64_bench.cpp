@@ -0,0 +1,106 @@
+#include <imgui.h>
+#include <imgui_helper.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Benchmark ImGui::Base64Encode/Decode and ImGui::Base85Encode/Decode on a random blob.
+// Usage: base64_bench [megabytes] [rounds]
+static inline int64_t now_usec()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Byte at a time reference
+static void reference_base64_encode(const unsigned char* src, int len, ImVector<char>& out)
+{
+    static const char chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    out.clear();
+    for (int i = 0; i < len; i += 3)
+    {
+        unsigned int v = src[i] << 16;
+        if (i + 1 < len) v |= src[i + 1] << 8;
+        if (i + 2 < len) v |= src[i + 2];
+        out.push_back(chars[v >> 18]);
+        out.push_back(chars[(v >> 12) & 0x3F]);
+        out.push_back(i + 1 < len ? chars[(v >> 6) & 0x3F] : '=');
+        out.push_back(i + 2 < len ? chars[v & 0x3F] : '=');
+    }
+    out.push_back('\n');
+}
+
+static double gbps(int64_t bytes, int64_t usec)
+{
+    return (double)bytes / 1e3 / (double)(usec > 0 ? usec : 1);
+}
+
+int main(int argc, char ** argv)
+{
+    int megabytes = argc > 1 ? atoi(argv[1]) : 64;
+    int rounds = argc > 2 ? atoi(argv[2]) : 5;
+    if (megabytes <= 0 || rounds <= 0)
+        return -1;
+    const int size = megabytes * 1024 * 1024 + 7;   // not a multiple of the SIMD steps
+    ImVector<char> blob;
+    blob.resize(size);
+    srand(1234);
+    for (int i = 0; i < size; i++)
+        blob[i] = (char)(rand() & 0xFF);
+
+    ImVector<char> encoded, decoded, reference;
+    int64_t t = now_usec();
+    reference_base64_encode((const unsigned char*)blob.Data, size, reference);
+    int64_t reference_time = now_usec() - t;
+
+    int64_t encode_time = 0, decode_time = 0;
+    for (int r = 0; r < rounds; r++)
+    {
+        t = now_usec();
+        ImGui::Base64Encode(blob.Data, size, encoded);
+        encode_time += now_usec() - t;
+        encoded.push_back('\0');
+        t = now_usec();
+        ImGui::Base64Decode(encoded.Data, decoded);
+        decode_time += now_usec() - t;
+        encoded.pop_back();
+    }
+    const bool base64_ok = encoded.size() == reference.size() && memcmp(encoded.Data, reference.Data, encoded.size()) == 0 &&
+                           decoded.size() == size && memcmp(decoded.Data, blob.Data, size) == 0;
+
+    // Line breaks in the input take the scalar path
+    ImVector<char> wrapped;
+    for (int i = 0; i < encoded.size(); i++)
+    {
+        wrapped.push_back(encoded[i]);
+        if (i % 76 == 75) wrapped.push_back('\n');
+    }
+    wrapped.push_back('\0');
+    t = now_usec();
+    ImGui::Base64Decode(wrapped.Data, decoded);
+    int64_t wrapped_time = now_usec() - t;
+    const bool wrapped_ok = decoded.size() == size && memcmp(decoded.Data, blob.Data, size) == 0;
+
+    int64_t encode85_time = 0, decode85_time = 0;
+    for (int r = 0; r < rounds; r++)
+    {
+        t = now_usec();
+        ImGui::Base85Encode(blob.Data, size, encoded);
+        encode85_time += now_usec() - t;
+        t = now_usec();
+        ImGui::Base85Decode(encoded.Data, decoded);
+        decode85_time += now_usec() - t;
+    }
+    // Base85 decodes whole groups of 4 bytes
+    const bool base85_ok = decoded.size() >= size && memcmp(decoded.Data, blob.Data, size) == 0;
+
+    const int64_t total = (int64_t)size * rounds;
+    fprintf(stderr, "Base64/Base85, %d MB, %d rounds\n", megabytes, rounds);
+    fprintf(stderr, "    base64 reference encode : %8.3f GB/s\n", gbps(size, reference_time));
+    fprintf(stderr, "    base64 encode           : %8.3f GB/s %s\n", gbps(total, encode_time), base64_ok ? "" : "MISMATCH");
+    fprintf(stderr, "    base64 decode           : %8.3f GB/s\n", gbps(total, decode_time));
+    fprintf(stderr, "    base64 decode (wrapped) : %8.3f GB/s %s\n", gbps(size, wrapped_time), wrapped_ok ? "" : "MISMATCH");
+    fprintf(stderr, "    base85 encode           : %8.3f GB/s\n", gbps(total, encode85_time));
+    fprintf(stderr, "    base85 decode           : %8.3f GB/s %s\n", gbps(total, decode85_time), base85_ok ? "" : "MISMATCH");
+    return (base64_ok && wrapped_ok && base85_ok) ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Check the glyph cache of ImFontAtlasFlags_DynamicGlyphs: glyphs rasterized on first use with their rows reported dirty,
+// least recently used pages evicted when the cache is full, and pages used by the current frame never evicted.
+// Usage: dynamic_glyphs_test [glyphs_per_frame]
+static int g_errors = 0;
+
+static void check(bool ok, const char* what)
+{
+    fprintf(stderr, "    %-52s: %s\n", what, ok ? "OK" : "FAILED");
+    g_errors += ok ? 0 : 1;
+}
+
+// The glyph entry without FindGlyph(), which would rasterize it
+static ImFontGlyph* peek_glyph(ImFont* font, ImWchar c)
+{
+    if (c >= (ImWchar)font->IndexLookup.Size || font->IndexLookup[c] == (ImWchar)-1)
+        return NULL;
+    return &font->Glyphs[font->IndexLookup[c]];
+}
+
+struct LoadedGlyph
+{
+    ImFontGlyph*    Glyph;
+    float           U0, V0;
+};
+
+// Rasterize the next 'count' dynamic glyphs, false when the font has no more
+static bool load_glyphs(ImFont* font, ImWchar& next, int count, std::vector<LoadedGlyph>& loaded, int* fallbacks)
+{
+    for (; count > 0 && next < 0xA000; next++)
+    {
+        ImFontGlyph* glyph = peek_glyph(font, next);
+        if (glyph == NULL || !glyph->Dynamic)
+            continue;
+        if (font->FindGlyph(next) != glyph)
+            (*fallbacks)++;
+        else if (glyph->Page != 0)
+            loaded.push_back({ glyph, glyph->U0, glyph->V0 });
+        count--;
+    }
+    return count == 0;
+}
+
+static bool still_loaded(const std::vector<LoadedGlyph>& loaded)
+{
+    for (const LoadedGlyph& l : loaded)
+        if (l.Glyph->Page == 0 || l.Glyph->U0 != l.U0 || l.Glyph->V0 != l.V0)
+            return false;
+    return true;
+}
+
+int main(int argc, char ** argv)
+{
+    int glyphs_per_frame = argc > 1 ? atoi(argv[1]) : 64;
+    if (glyphs_per_frame < 1)
+        return -1;
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.f / 60.f;
+    io.IniFilename = nullptr;
+    io.Fonts->Flags |= ImFontAtlasFlags_DynamicGlyphs;
+    io.Fonts->TexDynamicPixels = 1; // as few pages as possible
+    ImFont* font = io.Fonts->AddFontDefault();
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasDynamicGlyphs; // this test uploads nothing
+    int dirty_y = 0, dirty_h = 0;
+
+    const ImWchar first = 0x4E2D;
+    ImFontGlyph* glyph = peek_glyph(font, first);
+    if (glyph == NULL)
+    {
+        fprintf(stderr, "The default font has no CJK glyphs, nothing to check\n");
+        ImGui::DestroyContext();
+        return 0;
+    }
+    fprintf(stderr, "Dynamic glyphs, atlas %dx%d, %d glyphs per frame\n", width, height, glyphs_per_frame);
+    const ImFontGlyph* latin = peek_glyph(font, 'A');
+    check(latin && !latin->Dynamic && latin->Visible && glyph->Dynamic && glyph->Page == 0 && !glyph->Visible, "Latin-1 baked, others registered");
+    check(!io.Fonts->GetTexDataDirtyRows(&dirty_y, &dirty_h), "nothing dirty after build");
+
+    // First use rasterizes into a page and reports its rows
+    ImGui::NewFrame();
+    check(font->FindGlyph(first) == glyph && glyph->Page != 0 && glyph->Visible, "rasterized on first use");
+    const int glyph_y0 = (int)(glyph->V0 * height + 0.5f), glyph_y1 = (int)(glyph->V1 * height + 0.5f);
+    const int glyph_x0 = (int)(glyph->U0 * width + 0.5f), glyph_x1 = (int)(glyph->U1 * width + 0.5f);
+    bool dirty = io.Fonts->GetTexDataDirtyRows(&dirty_y, &dirty_h);
+    check(dirty && dirty_y <= glyph_y0 && dirty_y + dirty_h >= glyph_y1 && !io.Fonts->GetTexDataDirtyRows(&dirty_y, &dirty_h), "dirty rows reported once");
+    int coverage = 0;
+    for (int y = glyph_y0; y < glyph_y1; y++)
+        for (int x = glyph_x0; x < glyph_x1; x++)
+            coverage += (pixels[(y * width + x) * 4 + 3] > 128) ? 1 : 0;
+    check(coverage > 0, "glyph pixels written");
+    ImGui::Render();
+
+    // Fill the cache frame after frame until the first glyph is evicted, the glyphs of the current frame stay
+    ImWchar next = first + 1;
+    bool current_kept = true, more = true;
+    int frames = 0, fallbacks = 0;
+    for (; frames < 1000 && glyph->Page != 0 && more; frames++)
+    {
+        ImGui::NewFrame();
+        std::vector<LoadedGlyph> loaded;
+        more = load_glyphs(font, next, glyphs_per_frame, loaded, &fallbacks);
+        current_kept &= still_loaded(loaded);
+        dirty = io.Fonts->GetTexDataDirtyRows(&dirty_y, &dirty_h); // as a backend uploads them
+        ImGui::Render();
+    }
+    fprintf(stderr, "Evicted after %d frames, %d glyphs\n", frames, (int)(next - first));
+    check(glyph->Page == 0 && !glyph->Visible, "least recently used page evicted");
+    check(current_kept && fallbacks == 0, "glyphs of the current frame kept");
+    check(dirty && dirty_y <= glyph_y0 && dirty_y + dirty_h >= glyph_y1, "evicted page rows dirty");
+
+    // Evicted glyphs come back on use
+    ImGui::NewFrame();
+    check(font->FindGlyph(first) == glyph && glyph->Page != 0 && glyph->Visible, "evicted glyph rasterized again");
+    ImGui::Render();
+
+    // More glyphs in one frame than the cache holds: the rest falls back, nothing drawn this frame is evicted
+    ImGui::NewFrame();
+    std::vector<LoadedGlyph> loaded;
+    fallbacks = 0;
+    load_glyphs(font, next, 4000, loaded, &fallbacks);
+    fprintf(stderr, "Full frame, %d glyphs loaded, %d fallbacks\n", (int)loaded.size(), fallbacks);
+    check(fallbacks > 0 && still_loaded(loaded), "full cache falls back in the frame");
+    ImGui::Render();
+    ImGui::NewFrame();
+    glyph = peek_glyph(font, first);
+    check(font->FindGlyph(first) == glyph && glyph->Page != 0, "next frame evicts again");
+    ImGui::Render();
+
+    ImGui::DestroyContext();
+    fprintf(stderr, "%s\n", g_errors ? "FAILED" : "OK");
+    return g_errors ? 1 : 0;
+}
@@ -0,0 +1,487 @@
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_json.h>
+#include <implot.h>
+#include <imgui_node_editor.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Headless frame time benchmark of core ImGui with a null platform and renderer, nothing is drawn on screen.
+// Each workload runs in a fresh context and reports the NewFrame -> Render CPU time percentiles, draw data size
+// and ImGui allocations per frame (node editor containers use the C++ heap and are not counted).
+// Results are written as json, given a baseline json any workload slower or allocating more fails the run.
+// Usage: imgui_bench [-f frames] [-w workload] [-o result.json] [-b baseline.json] [-t tolerance_percent]
+namespace ed = ax::NodeEditor;
+
+static inline int64_t now_nsec()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Counting allocator, installed before any context is created
+struct AllocStats
+{
+    int64_t Allocs = 0;
+    int64_t Frees = 0;
+    int64_t Bytes = 0;
+};
+static AllocStats g_AllocStats;
+
+static void* bench_alloc(size_t size, void* user_data)
+{
+    AllocStats* stats = (AllocStats*)user_data;
+    stats->Allocs++;
+    stats->Bytes += (int64_t)size;
+    return malloc(size);
+}
+
+static void bench_free(void* ptr, void* user_data)
+{
+    if (ptr)
+        ((AllocStats*)user_data)->Frees++;
+    free(ptr);
+}
+
+//-----------------------------------------------------------------------------
+// Workloads
+//-----------------------------------------------------------------------------
+
+struct Workload
+{
+    const char* Name;
+    void (*Setup)();
+    void (*Frame)(int frame);
+    void (*Teardown)();
+};
+
+static void full_screen_window(const char* name)
+{
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(viewport->WorkPos);
+    ImGui::SetNextWindowSize(viewport->WorkSize);
+    ImGui::Begin(name, nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+}
+
+static void demo_frame(int frame)
+{
+    (void)frame;
+    ImGui::ShowDemoWindow();
+    ImGui::SetNextWindowPos(ImVec2(950, 60), ImGuiCond_FirstUseEver);
+    ImGui::ShowMetricsWindow();
+    ImGui::SetNextWindowPos(ImVec2(950, 500), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(700, 500), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Style Editor");
+    ImGui::ShowStyleEditor();
+    ImGui::End();
+}
+
+// 10k rows, only the visible ones are submitted through the clipper, scrolled every frame
+static void table_frame(int frame)
+{
+    full_screen_window("Table");
+    const int rows = 10000;
+    const ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable;
+    if (ImGui::BeginTable("rows", 6, flags))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Value");
+        ImGui::TableSetupColumn("Progress");
+        ImGui::TableSetupColumn("Flag", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("Action", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(rows);
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                ImGui::PushID(row);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%05d", row);
+                ImGui::TableNextColumn();
+                ImGui::Text("Item %d of the long list", row);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", sinf(row * 0.01f) * 1000.f);
+                ImGui::TableNextColumn();
+                ImGui::ProgressBar((row % 100) / 100.f, ImVec2(-FLT_MIN, 0));
+                ImGui::TableNextColumn();
+                bool flag = (row & 1) != 0;
+                ImGui::Checkbox("##flag", &flag);
+                ImGui::TableNextColumn();
+                ImGui::SmallButton("Edit");
+                ImGui::PopID();
+            }
+        }
+        ImGui::SetScrollY((float)((frame * 37) % (rows / 2)) * ImGui::GetTextLineHeightWithSpacing());
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static void text_frame(int frame)
+{
+    full_screen_window("Text");
+    static const char* paragraph =
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore "
+        "magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo "
+        "consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur.";
+    if (ImGui::BeginTable("text", 4))
+    {
+        for (int row = 0; row < 60; row++)
+        {
+            ImGui::TableNextRow();
+            for (int column = 0; column < 4; column++)
+            {
+                ImGui::TableNextColumn();
+                if (row % 10 == 9)
+                    ImGui::TextWrapped("%s", paragraph);
+                else if (column == 3)
+                    ImGui::TextColored(ImVec4(1.f, 0.8f, 0.4f, 1.f), "%d: %08X %.4f", row, (unsigned)(row * 2654435761u + frame), row * 0.125f);
+                else
+                    ImGui::Text("%04d The quick brown fox jumps over the lazy dog", row * 4 + column + frame % 7);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+// 48 windows tabbed into a 6 nodes dock space
+static const int dock_windows = 48;
+
+static void docking_setup()
+{
+    ImGui::GetIO().ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+}
+
+static void docking_frame(int frame)
+{
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    const ImGuiID dockspace_id = ImGui::GetID("BenchDockSpace");
+    if (frame == 0)
+    {
+        ImGui::DockBuilderRemoveNode(dockspace_id);
+        ImGui::DockBuilderAddNode(dockspace_id, ImGuiDockNodeFlags_DockSpace);
+        ImGui::DockBuilderSetNodeSize(dockspace_id, viewport->WorkSize);
+        ImGuiID nodes[6];
+        ImGuiID left, right;
+        ImGui::DockBuilderSplitNode(dockspace_id, ImGuiDir_Left, 0.5f, &left, &right);
+        nodes[0] = ImGui::DockBuilderSplitNode(left, ImGuiDir_Up, 0.33f, nullptr, &left);
+        nodes[1] = ImGui::DockBuilderSplitNode(left, ImGuiDir_Up, 0.5f, nullptr, &nodes[2]);
+        nodes[3] = ImGui::DockBuilderSplitNode(right, ImGuiDir_Up, 0.33f, nullptr, &right);
+        nodes[4] = ImGui::DockBuilderSplitNode(right, ImGuiDir_Up, 0.5f, nullptr, &nodes[5]);
+        char name[32];
+        for (int i = 0; i < dock_windows; i++)
+        {
+            snprintf(name, sizeof(name), "Window %d", i);
+            ImGui::DockBuilderDockWindow(name, nodes[i % 6]);
+        }
+        ImGui::DockBuilderFinish(dockspace_id);
+    }
+    ImGui::DockSpaceOverViewport(dockspace_id, viewport);
+    static float values[dock_windows];
+    static bool checks[dock_windows];
+    char name[32];
+    for (int i = 0; i < dock_windows; i++)
+    {
+        snprintf(name, sizeof(name), "Window %d", i);
+        if (ImGui::Begin(name))
+        {
+            ImGui::Text("Docked window %d, frame %d", i, frame);
+            ImGui::SliderFloat("Value", &values[i], 0.f, 1.f);
+            ImGui::Checkbox("Check", &checks[i]);
+            ImGui::Button("Apply");
+            ImGui::SameLine();
+            ImGui::Button("Cancel");
+            ImGui::Separator();
+            for (int line = 0; line < 8; line++)
+                ImGui::BulletText("Line %d of window %d", line, i);
+        }
+        ImGui::End();
+    }
+}
+
+// 4 plots of 10k points lines, scatter and bars
+static std::vector<float> g_PlotX, g_PlotY;
+
+static void implot_setup()
+{
+    ImPlot::CreateContext();
+    g_PlotX.resize(10000);
+    g_PlotY.resize(10000);
+    for (int i = 0; i < 10000; i++)
+    {
+        g_PlotX[i] = i * 0.001f;
+        g_PlotY[i] = sinf(i * 0.01f) + 0.2f * sinf(i * 0.37f);
+    }
+}
+
+static void implot_frame(int frame)
+{
+    full_screen_window("Plots");
+    if (ImPlot::BeginSubplots("Signals", 2, 2, ImVec2(-1, -1)))
+    {
+        for (int plot = 0; plot < 4; plot++)
+        {
+            char title[16];
+            snprintf(title, sizeof(title), "Plot %d", plot);
+            if (ImPlot::BeginPlot(title))
+            {
+                const int offset = (frame * 50 + plot * 1000) % 5000;
+                if (plot == 2)
+                    ImPlot::PlotScatter("scatter", g_PlotX.data(), g_PlotY.data() + offset, 2000);
+                else if (plot == 3)
+                    ImPlot::PlotBars("bars", g_PlotY.data() + offset, 200);
+                else
+                    ImPlot::PlotLine("line", g_PlotX.data(), g_PlotY.data(), (int)g_PlotX.size(), 0, offset);
+                ImPlot::EndPlot();
+            }
+        }
+        ImPlot::EndSubplots();
+    }
+    ImGui::End();
+}
+
+static void implot_teardown()
+{
+    ImPlot::DestroyContext();
+}
+
+// 200 nodes chained by their pins
+static ed::EditorContext* g_NodeEditor = nullptr;
+static const int graph_nodes = 200;
+
+static void node_editor_setup()
+{
+    ed::Config config;
+    config.SettingsFile = nullptr;
+    g_NodeEditor = ed::CreateEditor(&config);
+}
+
+static void node_editor_frame(int frame)
+{
+    full_screen_window("Graph");
+    ed::SetCurrentEditor(g_NodeEditor);
+    ed::Begin("Bench Graph");
+    for (int i = 0; i < graph_nodes; i++)
+    {
+        const int id = i * 4 + 1;
+        if (frame == 0)
+            ed::SetNodePosition(id, ImVec2((float)(i % 20) * 180.f, (float)(i / 20) * 120.f));
+        ed::BeginNode(id);
+        ImGui::Text("Node %d", i);
+        ed::BeginPin(id + 1, ed::PinKind::Input);
+        ImGui::Text("-> In");
+        ed::EndPin();
+        ImGui::SameLine();
+        ed::BeginPin(id + 2, ed::PinKind::Output);
+        ImGui::Text("Out ->");
+        ed::EndPin();
+        ed::EndNode();
+    }
+    for (int i = 0; i + 1 < graph_nodes; i++)
+        ed::Link(i * 4 + 4, i * 4 + 3, (i + 1) * 4 + 2);
+    ed::End();
+    ed::SetCurrentEditor(nullptr);
+    ImGui::End();
+}
+
+static void node_editor_teardown()
+{
+    ed::DestroyEditor(g_NodeEditor);
+    g_NodeEditor = nullptr;
+}
+
+static const Workload g_Workloads[] =
+{
+    { "demo",           nullptr,            demo_frame,         nullptr },
+    { "table",          nullptr,            table_frame,        nullptr },
+    { "text",           nullptr,            text_frame,         nullptr },
+    { "docking",        docking_setup,      docking_frame,      nullptr },
+    { "implot",         implot_setup,       implot_frame,       implot_teardown },
+    { "node_editor",    node_editor_setup,  node_editor_frame,  node_editor_teardown },
+};
+
+//-----------------------------------------------------------------------------
+// Runner
+//-----------------------------------------------------------------------------
+
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    const size_t index = (size_t)ceil(p / 100.0 * sorted.size());
+    return sorted[index > 0 ? index - 1 : 0];
+}
+
+static imgui_json::value run_workload(const Workload& workload, int frames)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.f / 60.f;
+    io.IniFilename = nullptr;
+    io.LogFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;     // nothing is drawn, large meshes are fine
+    io.Fonts->Build();
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+    if (workload.Setup)
+        workload.Setup();
+
+    // Warm up frames settle the layout and the caches, then the mouse sweeps the screen to trigger hovering
+    const int warmup = 10;
+    std::vector<double> times;
+    times.reserve(frames);
+    double vertices = 0, indices = 0, commands = 0, lists = 0;
+    int64_t allocs = 0, bytes = 0;
+    for (int frame = 0; frame < warmup + frames; frame++)
+    {
+        io.AddMousePosEvent((float)((frame * 23) % 1920), (float)((frame * 17) % 1080));
+        const AllocStats before = g_AllocStats;
+        const int64_t t0 = now_nsec();
+        ImGui::NewFrame();
+        workload.Frame(frame);
+        ImGui::Render();
+        const int64_t t1 = now_nsec();
+        if (frame < warmup)
+            continue;
+        times.push_back((t1 - t0) / 1000.0);
+        allocs += g_AllocStats.Allocs - before.Allocs;
+        bytes += g_AllocStats.Bytes - before.Bytes;
+        const ImDrawData* draw_data = ImGui::GetDrawData();
+        vertices += draw_data->TotalVtxCount;
+        indices += draw_data->TotalIdxCount;
+        lists += draw_data->CmdListsCount;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+            commands += draw_data->CmdLists[n]->CmdBuffer.Size;
+    }
+    if (workload.Teardown)
+        workload.Teardown();
+    ImGui::DestroyContext();
+
+    std::vector<double> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0;
+    for (double t : times)
+        sum += t;
+    imgui_json::value frame_us;
+    frame_us["min"] = sorted.front();
+    frame_us["mean"] = sum / frames;
+    frame_us["p50"] = percentile(sorted, 50);
+    frame_us["p90"] = percentile(sorted, 90);
+    frame_us["p99"] = percentile(sorted, 99);
+    frame_us["max"] = sorted.back();
+    imgui_json::value result;
+    result["name"] = workload.Name;
+    result["frames"] = (double)frames;
+    result["frame_us"] = frame_us;
+    result["vertices"] = vertices / frames;
+    result["indices"] = indices / frames;
+    result["draw_lists"] = lists / frames;
+    result["draw_cmds"] = commands / frames;
+    result["allocs_per_frame"] = (double)allocs / frames;
+    result["alloc_bytes_per_frame"] = (double)bytes / frames;
+    return result;
+}
+
+// Median frame time over the tolerance or more allocations than the baseline are regressions
+static int compare_baseline(const imgui_json::value& results, const imgui_json::value& baseline, double tolerance)
+{
+    int regressions = 0;
+    const imgui_json::array* current = results["workloads"].get_ptr<imgui_json::array>();
+    const imgui_json::array* previous = baseline["workloads"].get_ptr<imgui_json::array>();
+    if (!current || !previous)
+        return 0;
+    for (auto& workload : *current)
+    {
+        const std::string& name = workload["name"].get<imgui_json::string>();
+        for (auto& base : *previous)
+        {
+            if (!base["name"].is_string() || base["name"].get<imgui_json::string>() != name)
+                continue;
+            if (!base["frame_us"]["p50"].is_number() || !base["allocs_per_frame"].is_number())
+                break;
+            const double p50 = workload["frame_us"]["p50"].get<double>();
+            const double base_p50 = base["frame_us"]["p50"].get<double>();
+            const double allocs = workload["allocs_per_frame"].get<double>();
+            const double base_allocs = base["allocs_per_frame"].get<double>();
+            const bool slower = p50 > base_p50 * (1.0 + tolerance / 100.0);
+            const bool allocating = allocs > base_allocs + 0.5;
+            fprintf(stderr, "    %-12s p50 %9.1f us (baseline %9.1f, %+6.1f%%) allocs %8.1f (baseline %8.1f) %s\n",
+                    name.c_str(), p50, base_p50, base_p50 > 0 ? (p50 / base_p50 - 1.0) * 100.0 : 0.0, allocs, base_allocs,
+                    slower || allocating ? "REGRESSION" : "");
+            if (slower || allocating)
+                regressions++;
+            break;
+        }
+    }
+    return regressions;
+}
+
+int main(int argc, char ** argv)
+{
+    int frames = 300;
+    const char* only = nullptr;
+    const char* output = nullptr;
+    const char* baseline_path = nullptr;
+    double tolerance = 10.0;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "-f")) frames = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "-w")) only = argv[i + 1];
+        else if (!strcmp(argv[i], "-o")) output = argv[i + 1];
+        else if (!strcmp(argv[i], "-b")) baseline_path = argv[i + 1];
+        else if (!strcmp(argv[i], "-t")) tolerance = atof(argv[i + 1]);
+        else return -1;
+    }
+    if (frames <= 0)
+        return -1;
+
+    IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(bench_alloc, bench_free, &g_AllocStats);
+    imgui_json::value results;
+    results["imgui_version"] = IMGUI_VERSION;
+    results["imgui_version_num"] = (double)IMGUI_VERSION_NUM;
+    results["display_width"] = 1920.0;
+    results["display_height"] = 1080.0;
+    results["workloads"] = imgui_json::array();
+    fprintf(stderr, "ImGui %s headless, 1920x1080, %d frames\n", IMGUI_VERSION, frames);
+    for (const Workload& workload : g_Workloads)
+    {
+        if (only && strcmp(only, workload.Name))
+            continue;
+        imgui_json::value result = run_workload(workload, frames);
+        const imgui_json::value& frame_us = result["frame_us"];
+        fprintf(stderr, "    %-12s p50 %9.1f us  p90 %9.1f  p99 %9.1f  max %9.1f  vtx %8.0f  idx %8.0f  allocs %8.1f (%.0f bytes)\n",
+                workload.Name, frame_us["p50"].get<double>(), frame_us["p90"].get<double>(), frame_us["p99"].get<double>(),
+                frame_us["max"].get<double>(), result["vertices"].get<double>(), result["indices"].get<double>(),
+                result["allocs_per_frame"].get<double>(), result["alloc_bytes_per_frame"].get<double>());
+        results["workloads"].push_back(std::move(result));
+    }
+
+    if (output)
+        results.save(output);
+    else
+        fprintf(stdout, "%s\n", results.dump(4).c_str());
+
+    int regressions = 0;
+    if (baseline_path)
+    {
+        auto baseline = imgui_json::value::load(baseline_path);
+        if (!baseline.second)
+        {
+            fprintf(stderr, "Can't load baseline %s\n", baseline_path);
+            return 1;
+        }
+        fprintf(stderr, "Compared to %s, tolerance %.1f%%\n", baseline_path, tolerance);
+        regressions = compare_baseline(results, baseline.first, tolerance);
+    }
+    return regressions ? 1 : 0;
+}
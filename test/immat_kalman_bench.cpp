@@ -0,0 +1,99 @@
+#include <immat.h>
+#include <chrono>
+#include <vector>
+#include <iostream>
+
+// Benchmark ImKalman against the fixed-size ImKalmanN and the batched ImKalmanBatch.
+// Usage: immat_kalman_bench [points] [steps]
+#define STATE_SIZE 4
+#define MEASUREMENT_SIZE 2
+
+static inline int64_t now_usec()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static inline float track_x(int p, int s) { return 100.f + p * 0.5f + s * 1.5f + sinf(s * 0.1f + p) * 3.f; }
+static inline float track_y(int p, int s) { return 200.f - p * 0.25f + s * 0.75f + cosf(s * 0.1f + p) * 3.f; }
+
+int main(int argc, char ** argv)
+{
+    int points = argc > 1 ? atoi(argv[1]) : 4096;
+    int steps = argc > 2 ? atoi(argv[2]) : 100;
+    if (points <= 0 || steps <= 0)
+        return -1;
+
+    // ImKalman, heap ImMat per step
+    std::vector<ImGui::ImKalman> kalman(points);
+    for (auto& k : kalman)
+    {
+        k.initiate(STATE_SIZE, MEASUREMENT_SIZE);
+        k.statePost.fill(0.f);
+    }
+    ImGui::ImMat measurement;
+    measurement.create_type(1, MEASUREMENT_SIZE, IM_DT_FLOAT32);
+    int64_t t = now_usec();
+    for (int s = 0; s < steps; s++)
+    {
+        for (int p = 0; p < points; p++)
+        {
+            kalman[p].predicted();
+            measurement.at<float>(0, 0) = track_x(p, s);
+            measurement.at<float>(0, 1) = track_y(p, s);
+            kalman[p].update(measurement);
+        }
+    }
+    int64_t kalman_time = now_usec() - t;
+
+    // ImKalmanN, fixed size on stack
+    std::vector<ImGui::ImKalmanN<STATE_SIZE, MEASUREMENT_SIZE>> kalman_n(points);
+    for (auto& k : kalman_n)
+        memset(k.statePost, 0, sizeof(k.statePost));
+    t = now_usec();
+    for (int s = 0; s < steps; s++)
+    {
+        for (int p = 0; p < points; p++)
+        {
+            float Y[MEASUREMENT_SIZE] = { track_x(p, s), track_y(p, s) };
+            kalman_n[p].predicted();
+            kalman_n[p].update(Y);
+        }
+    }
+    int64_t kalman_n_time = now_usec() - t;
+
+    // ImKalmanBatch, all points per SIMD step
+    ImGui::ImKalmanBatch<STATE_SIZE, MEASUREMENT_SIZE> kalman_batch(points);
+    for (int i = 0; i < STATE_SIZE; i++)
+        memset(kalman_batch.state_post(i), 0, sizeof(float) * kalman_batch.stride());
+    t = now_usec();
+    for (int s = 0; s < steps; s++)
+    {
+        float* mx = kalman_batch.measurement(0);
+        float* my = kalman_batch.measurement(1);
+        for (int p = 0; p < points; p++)
+        {
+            mx[p] = track_x(p, s);
+            my[p] = track_y(p, s);
+        }
+        kalman_batch.predicted();
+        kalman_batch.update();
+    }
+    int64_t kalman_batch_time = now_usec() - t;
+
+    float max_diff_n = 0, max_diff_batch = 0;
+    for (int p = 0; p < points; p++)
+    {
+        for (int i = 0; i < STATE_SIZE; i++)
+        {
+            float ref = kalman[p].statePost.at<float>(0, i);
+            max_diff_n = std::max(max_diff_n, fabsf(ref - kalman_n[p].statePost[i]));
+            max_diff_batch = std::max(max_diff_batch, fabsf(ref - kalman_batch.state_post(i)[p]));
+        }
+    }
+
+    fprintf(stderr, "Kalman %dx%d, %d points, %d steps\n", STATE_SIZE, MEASUREMENT_SIZE, points, steps);
+    fprintf(stderr, "    ImKalman      : %10.3f ms\n", kalman_time / 1000.f);
+    fprintf(stderr, "    ImKalmanN     : %10.3f ms (x%.1f) max diff %f\n", kalman_n_time / 1000.f, (float)kalman_time / std::max<int64_t>(kalman_n_time, 1), max_diff_n);
+    fprintf(stderr, "    ImKalmanBatch : %10.3f ms (x%.1f) max diff %f\n", kalman_batch_time / 1000.f, (float)kalman_time / std::max<int64_t>(kalman_batch_time, 1), max_diff_batch);
+    return (max_diff_n < 1e-1f && max_diff_batch < 1e-1f) ? 0 : 1;
+}
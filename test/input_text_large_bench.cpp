@@ -0,0 +1,213 @@
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Benchmark InputTextMultiline() with ImGuiInputTextFlags_LargeText against the regular mode on a big text: activation,
+// edits spread over the text and idle frames. Also checks the text, the line index, the reported edits, undo and revert.
+// Usage: input_text_large_bench [text_mb] [edits]
+static inline int64_t now_usec()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImGuiID g_id = 0;
+static std::string g_replay; // original text with the edits reported by ImGuiInputTextFlags_CallbackEdit applied
+static int g_errors = 0;
+
+static void check(bool ok, const char* what)
+{
+    fprintf(stderr, "    %-40s: %s\n", what, ok ? "OK" : "FAILED");
+    g_errors += ok ? 0 : 1;
+}
+
+static int text_callback(ImGuiInputTextCallbackData* data)
+{
+    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
+    {
+        ImVector<char>* buf = (ImVector<char>*)data->UserData;
+        buf->resize(data->BufSize);
+        data->Buf = buf->Data;
+    }
+    else if (data->EventFlag == ImGuiInputTextFlags_CallbackEdit && (data->Flags & ImGuiInputTextFlags_LargeText))
+    {
+        g_replay.replace(data->EditOffset, data->EditDeletedLen, data->EditInsertedText, data->EditInsertedLen);
+    }
+    return 0;
+}
+
+static int64_t text_frame(ImVector<char>* buf, ImGuiInputTextFlags flags, bool focus = false)
+{
+    int64_t t0 = now_usec();
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1000, 800));
+    ImGui::Begin("Editor");
+    if (focus)
+        ImGui::SetKeyboardFocusHere();
+    ImGui::InputTextMultiline("##text", buf->Data, buf->Size, ImVec2(-1, -1), flags | ImGuiInputTextFlags_CallbackResize | ImGuiInputTextFlags_CallbackEdit, text_callback, buf);
+    g_id = ImGui::GetItemID();
+    ImGui::End();
+    ImGui::Render();
+    return now_usec() - t0;
+}
+
+static int64_t key_frames(ImVector<char>* buf, ImGuiInputTextFlags flags, ImGuiKey key, bool ctrl = false)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.AddKeyEvent(ImGuiMod_Ctrl, ctrl);
+    io.AddKeyEvent(key, true);
+    int64_t time = text_frame(buf, flags);
+    io.AddKeyEvent(key, false);
+    io.AddKeyEvent(ImGuiMod_Ctrl, false);
+    text_frame(buf, flags);
+    return time;
+}
+
+static int64_t activate(ImVector<char>* buf, ImGuiInputTextFlags flags)
+{
+    ImGuiContext& g = *ImGui::GetCurrentContext();
+    text_frame(buf, flags, true);
+    int64_t time = 0;
+    for (int n = 0; n < 5 && g.ActiveId != g_id; n++)
+        time = text_frame(buf, flags);
+    return g.ActiveId == g_id ? time : -1;
+}
+
+// Edits spread over the text: type a character, a new line every 8 edits, a backspace every 13 edits
+static int64_t edit_frames(ImVector<char>* buf, ImGuiInputTextFlags flags, int edits, std::string* model)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    const bool large = (flags & ImGuiInputTextFlags_LargeText) != 0;
+    int64_t time = 0;
+    for (int n = 0; n < edits; n++)
+    {
+        int pos = (int)(((long long)n * 7919 * 1031) % (long long)model->size());
+        while (pos > 0 && ((*model)[pos] & 0xC0) == 0x80)
+            pos--;
+        if (large)
+        {
+            ImGuiInputTextLargeState* state = ImGui::GetInputTextLargeState(g_id);
+            state->Cursor = state->SelectStart = state->SelectEnd = pos;
+            state->CursorFollow = true;
+        }
+        else
+        {
+            ImGuiInputTextState* state = ImGui::GetInputTextState(g_id);
+            state->Stb.cursor = state->Stb.select_start = state->Stb.select_end = ImTextCountCharsFromUtf8(model->c_str(), model->c_str() + pos);
+        }
+        if (n % 13 == 12 && pos > 0)
+        {
+            int prev = pos - 1;
+            while (prev > 0 && ((*model)[prev] & 0xC0) == 0x80)
+                prev--;
+            model->erase(prev, pos - prev);
+            time += key_frames(buf, flags, ImGuiKey_Backspace);
+        }
+        else if (n % 8 == 7)
+        {
+            model->insert(pos, 1, '\n');
+            time += key_frames(buf, flags, ImGuiKey_Enter);
+        }
+        else
+        {
+            model->insert(pos, 1, (char)('a' + n % 26));
+            io.AddInputCharacter('a' + n % 26);
+            time += text_frame(buf, flags);
+        }
+    }
+    return time / edits;
+}
+
+static int64_t idle_frames(ImVector<char>* buf, ImGuiInputTextFlags flags, int frames)
+{
+    int64_t time = 0;
+    for (int n = 0; n < frames; n++)
+        time += text_frame(buf, flags);
+    return time / frames;
+}
+
+static bool check_line_index(const ImGuiInputTextLargeState* state, const std::string& text)
+{
+    int line = 0;
+    if (state->GetLineStart(0) != 0)
+        return false;
+    for (size_t pos = text.find('\n'); pos != std::string::npos; pos = text.find('\n', pos + 1))
+        if (++line >= state->GetLineCount() || state->GetLineStart(line) != (int)pos + 1)
+            return false;
+    return line + 1 == state->GetLineCount();
+}
+
+int main(int argc, char ** argv)
+{
+    int text_mb = argc > 1 ? atoi(argv[1]) : 10;
+    int edits = argc > 2 ? atoi(argv[2]) : 200;
+    if (text_mb <= 0 || edits < 20)
+        return -1;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.f / 60.f;
+    io.IniFilename = nullptr;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    std::string original;
+    char line[128];
+    for (int n = 0; (int)original.size() < text_mb * 1024 * 1024; n++)
+    {
+        snprintf(line, sizeof(line), "%07d: The quick brown fox jumps over the lazy dog, d\xC3\xA9j\xC3\xA0 vu %d\n", n, n * 37);
+        original += line;
+    }
+    ImVector<char> buf;
+    buf.resize((int)original.size() + 1);
+    memcpy(buf.Data, original.c_str(), original.size() + 1);
+    fprintf(stderr, "InputTextMultiline, %.1f MB, %d edits\n", original.size() / (1024.0 * 1024.0), edits);
+
+    // Large text mode
+    const ImGuiInputTextFlags large_flags = ImGuiInputTextFlags_LargeText;
+    std::string model = original;
+    g_replay = original;
+    int64_t large_activate = activate(&buf, large_flags);
+    int64_t large_edit = edit_frames(&buf, large_flags, edits, &model);
+    int64_t large_idle = idle_frames(&buf, large_flags, 20);
+    ImGuiInputTextLargeState* state = ImGui::GetInputTextLargeState(g_id);
+    check(large_activate >= 0 && state != NULL, "activation");
+    if (state == NULL)
+        return 1;
+    check(model == buf.Data, "text");
+    check(g_replay == buf.Data, "edit callbacks");
+    check(check_line_index(state, model), "line index");
+    const std::string before_undo = model;
+    key_frames(&buf, large_flags, ImGuiKey_Z, true);
+    const bool undone = before_undo != buf.Data;
+    key_frames(&buf, large_flags, ImGuiKey_Y, true);
+    check(undone && before_undo == buf.Data, "undo, redo");
+    key_frames(&buf, large_flags, ImGuiKey_Escape);
+    check(original == buf.Data && g_replay == original && ImGui::GetActiveID() != g_id, "escape reverts");
+    check(check_line_index(state, original), "line index after revert");
+    int64_t large_inactive = idle_frames(&buf, large_flags, 20);
+
+    // Regular mode, fewer edits
+    const int regular_edits = ImMin(edits, 20);
+    model = original;
+    int64_t regular_activate = activate(&buf, 0);
+    int64_t regular_edit = edit_frames(&buf, 0, regular_edits, &model);
+    int64_t regular_idle = idle_frames(&buf, 0, 5);
+    check(regular_activate >= 0 && model == buf.Data, "regular mode text");
+
+    fprintf(stderr, "    large   : activate %8.2f ms, edit %8.3f ms/frame, idle %8.3f ms/frame, inactive %8.3f ms/frame\n",
+        large_activate / 1000.0, large_edit / 1000.0, large_idle / 1000.0, large_inactive / 1000.0);
+    fprintf(stderr, "    regular : activate %8.2f ms, edit %8.3f ms/frame, idle %8.3f ms/frame\n",
+        regular_activate / 1000.0, regular_edit / 1000.0, regular_idle / 1000.0);
+    ImGui::DestroyContext();
+    fprintf(stderr, "%s\n", g_errors ? "FAILED" : "OK");
+    return g_errors ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+#include <imgui.h>
+#include <imgui_json.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+// Check ImGui::ProfilerSaveTrace(): the saved Chrome trace parses back with imgui_json, and the thread names, scope
+// names and labels survive the escaping.
+// Usage: profiler_trace_test [frames]
+static int g_errors = 0;
+
+static void check(bool ok, const char* what)
+{
+    fprintf(stderr, "    %-52s: %s\n", what, ok ? "OK" : "FAILED");
+    g_errors += ok ? 0 : 1;
+}
+
+#if IMGUI_PROFILER
+static const char* const LABEL = "a \"quoted\" \\label\\ with\ta tab";
+
+static void render_frame()
+{
+    ImGui::NewFrame();
+    {
+        IMGUI_PROFILE_SCOPE_LABEL("TestScope", LABEL);
+        ImGui::Begin("Trace");
+        ImGui::Text("Trace");
+        ImGui::End();
+    }
+    std::thread worker([] {
+        ImGui::ProfilerSetThreadName("Worker \"1\"");
+        IMGUI_PROFILE_SCOPE("WorkerScope");
+    });
+    worker.join();
+    ImGui::Render();
+}
+#endif
+
+int main(int argc, char ** argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 10;
+    if (frames <= 1)
+        return -1;
+#if IMGUI_PROFILER
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.f / 60.f;
+    io.IniFilename = nullptr;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    fprintf(stderr, "Profiler trace, %d frames\n", frames);
+    for (int n = 0; n < frames; n++)
+        render_frame();
+    const std::string path = "profiler_trace_test.json";
+    check(ImGui::ProfilerSaveTrace(path.c_str()), "save");
+    auto loaded = imgui_json::value::load(path);
+    remove(path.c_str());
+    const imgui_json::value& trace = loaded.first;
+    check(loaded.second && trace.is_object() && trace.contains("traceEvents") && trace["traceEvents"].is_array(), "trace parses");
+
+    int frame_events = 0, scope_events = 0, worker_events = 0, labels = 0, names = 0;
+    bool times_valid = true;
+    if (trace.is_object() && trace.contains("traceEvents") && trace["traceEvents"].is_array())
+    {
+        for (const imgui_json::value& event : trace["traceEvents"].get<imgui_json::array>())
+        {
+            const std::string& name = event["name"].get<imgui_json::string>();
+            const std::string& ph = event["ph"].get<imgui_json::string>();
+            if (ph == "M" && event["args"]["name"].get<imgui_json::string>() == "Worker \"1\"")
+                names++;
+            if (ph == "i" && name == "Frame")
+                frame_events++;
+            if (ph != "X")
+                continue;
+            times_valid = times_valid && event["ts"].get<imgui_json::number>() >= 0.0 && event["dur"].get<imgui_json::number>() >= 0.0;
+            if (name == "TestScope")
+            {
+                scope_events++;
+                labels += event.contains("args") && event["args"]["label"].get<imgui_json::string>() == LABEL ? 1 : 0;
+            }
+            worker_events += name == "WorkerScope" ? 1 : 0;
+        }
+    }
+    // The events of the last frame are collected by the next NewFrame()
+    check(frame_events >= frames - 1 && scope_events >= frames - 1 && worker_events >= frames - 1, "every captured frame and scope");
+    check(labels == scope_events && names > 0, "labels and thread names escaped");
+    check(times_valid, "times");
+    ImGui::DestroyContext();
+#else
+    fprintf(stderr, "Profiler trace: IMGUI_PROFILER is disabled\n");
+#endif
+    fprintf(stderr, "%s\n", g_errors ? "FAILED" : "OK");
+    return g_errors ? 1 : 0;
+}
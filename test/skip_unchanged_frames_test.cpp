@@ -0,0 +1,94 @@
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <cstdio>
+#include <cstdlib>
+
+// Check io.ConfigSkipUnchangedFrames: ImDrawData::Unchanged of identical frames, MarkAnimatedRegion(), InvalidateViewportDrawData()
+// and the WaitUnchangedFrame() throttle.
+// Usage: skip_unchanged_frames_test [refresh_rate]
+static int g_errors = 0;
+
+static void check(bool ok, const char* what)
+{
+    fprintf(stderr, "    %-52s: %s\n", what, ok ? "OK" : "FAILED");
+    g_errors += ok ? 0 : 1;
+}
+
+enum FrameContent { Frame_Static, Frame_Changed, Frame_Animated, Frame_AnimatedClipped };
+
+static bool render_frame(FrameContent content, int value = 0)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(10, 10));
+    ImGui::SetNextWindowSize(ImVec2(300, 200));
+    ImGui::Begin("Frame");
+    ImGui::Text("Value %d", content == Frame_Changed ? value : 0);
+    ImVec2 pos = ImGui::GetCursorScreenPos();
+    ImGui::Dummy(ImVec2(64, 64));
+    if (content == Frame_Animated)
+        ImGui::MarkAnimatedRegion(pos, pos + ImVec2(64, 64), 0.1);
+    else if (content == Frame_AnimatedClipped)
+        ImGui::MarkAnimatedRegion(ImVec2(1000, 1000), ImVec2(1064, 1064), 0.1);
+    ImGui::End();
+    ImGui::Render();
+    return ImGui::GetDrawData()->Unchanged;
+}
+
+int main(int argc, char ** argv)
+{
+    float refresh_rate = argc > 1 ? (float)atof(argv[1]) : 20.0f;
+    if (refresh_rate < 2.0f)
+        return -1;
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.f / 60.f;
+    io.IniFilename = nullptr;
+    io.ConfigSkipUnchangedFrames = true;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+
+    fprintf(stderr, "Skip unchanged frames\n");
+    for (int n = 0; n < 4; n++)
+        render_frame(Frame_Static);
+    check(render_frame(Frame_Static), "identical frame unchanged");
+    check(!render_frame(Frame_Changed, 1) && !render_frame(Frame_Changed, 2), "changed frame drawn");
+    render_frame(Frame_Static);
+    check(render_frame(Frame_Static), "back to unchanged");
+
+    // Animated regions: a visible one forces the repaint and bounds the event wait, a clipped one doesn't
+    const bool animated = render_frame(Frame_Animated);
+    const double animation_wait = ImGui::GetAnimatedRegionWaitingTime();
+    check(!animated && animation_wait <= 0.1, "visible animated region drawn");
+    check(!render_frame(Frame_Animated), "animated region drawn every frame");
+    render_frame(Frame_Static);
+    check(render_frame(Frame_AnimatedClipped) && ImGui::GetAnimatedRegionWaitingTime() == INFINITY, "clipped animated region unchanged");
+
+    // Lost window content
+    check(render_frame(Frame_Static), "unchanged before invalidate");
+    ImGui::InvalidateViewportDrawData();
+    check(!render_frame(Frame_Static) && render_frame(Frame_Static), "invalidated viewport drawn once");
+
+    // Throttle: an unchanged frame lasts one refresh interval, a drawn frame doesn't wait
+    ImGuiContext& g = *ImGui::GetCurrentContext();
+    render_frame(Frame_Static);
+    ImGui::WaitUnchangedFrame(refresh_rate);
+    const double unchanged_time = ImGui::get_current_time() - g.WallClock;
+    render_frame(Frame_Changed, 3);
+    double t0 = ImGui::get_current_time();
+    ImGui::WaitUnchangedFrame(refresh_rate);
+    const double changed_wait = ImGui::get_current_time() - t0;
+    fprintf(stderr, "WaitUnchangedFrame, %.0f Hz: unchanged frame %.2f ms, drawn frame waited %.3f ms\n", refresh_rate, unchanged_time * 1000.0, changed_wait * 1000.0);
+    check(unchanged_time >= 0.9 / refresh_rate, "unchanged frame throttled");
+    check(changed_wait < 0.5 / refresh_rate, "drawn frame not throttled");
+
+    io.ConfigSkipUnchangedFrames = false;
+    check(!render_frame(Frame_Static) && !render_frame(Frame_Static), "disabled");
+
+    ImGui::DestroyContext();
+    fprintf(stderr, "%s\n", g_errors ? "FAILED" : "OK");
+    return g_errors ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+#include <imgui.h>
+#include <imgui_impl_soft.h>
+#include <imgui_texture.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Benchmark the software rasterizer backend rendering the demo and metrics windows at 1080p, no platform needed.
+// Also checks that a jittered mesh sharing all its edges blends every covered pixel exactly once.
+// Usage: soft_render_bench [threads] [frames] [output.png]
+static inline int64_t now_usec()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Grid of quads split along random diagonals, translucent white over black: covered pixels must all be 128
+static bool coverage_test(ImTextureSoft white, int seed, float jitter)
+{
+    const int N = 24;
+    const float cell = 400.f / N;
+    ImVec2 grid[N + 1][N + 1];
+    srand(seed);
+    for (int y = 0; y <= N; y++)
+        for (int x = 0; x <= N; x++)
+        {
+            float jx = (x > 0 && x < N) ? ((float)rand() / RAND_MAX - 0.5f) * cell * jitter : 0.f;
+            float jy = (y > 0 && y < N) ? ((float)rand() / RAND_MAX - 0.5f) * cell * jitter : 0.f;
+            grid[y][x] = ImVec2(50.3f + x * cell + jx, 50.7f + y * cell + jy);
+        }
+
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    draw_list._ResetForNewFrame();
+    draw_list.PushClipRect(ImVec2(0, 0), ImVec2(512, 512));
+    draw_list.PushTextureID((ImTextureID)white);
+    const ImU32 col = IM_COL32(255, 255, 255, 128);
+    const ImVec2 uv(0.5f, 0.5f);
+    for (int y = 0; y < N; y++)
+        for (int x = 0; x < N; x++)
+        {
+            draw_list.PrimReserve(6, 4);
+            ImDrawIdx base = (ImDrawIdx)draw_list._VtxCurrentIdx;
+            draw_list.PrimWriteVtx(grid[y][x], uv, col);
+            draw_list.PrimWriteVtx(grid[y][x + 1], uv, col);
+            draw_list.PrimWriteVtx(grid[y + 1][x + 1], uv, col);
+            draw_list.PrimWriteVtx(grid[y + 1][x], uv, col);
+            static const int split[2][6] = { { 0, 1, 2, 0, 2, 3 }, { 0, 1, 3, 1, 2, 3 } };
+            const int* idx = split[rand() & 1];
+            for (int i = 0; i < 6; i++)
+                draw_list.PrimWriteIdx((ImDrawIdx)(base + idx[i]));
+        }
+
+    ImDrawData draw_data;
+    draw_data.Valid = true;
+    draw_data.DisplayPos = ImVec2(0, 0);
+    draw_data.DisplaySize = ImVec2(512, 512);
+    draw_data.FramebufferScale = ImVec2(1, 1);
+    draw_data.CmdLists.push_back(&draw_list);
+    draw_data.CmdListsCount = 1;
+    draw_data.TotalVtxCount = draw_list.VtxBuffer.Size;
+    draw_data.TotalIdxCount = draw_list.IdxBuffer.Size;
+    ImGui::ImMat target;
+    ImGui_ImplSoft_ClearScreen(target, ImVec2(512, 512), ImVec4(0, 0, 0, 1));
+    ImGui_ImplSoft_RenderDrawData(&draw_data, target);
+
+    // Inside the grid border, away from the jittered outline
+    int bad = 0;
+    const unsigned char* pixels = (const unsigned char*)target.data;
+    for (int y = 52; y < 448; y++)
+        for (int x = 52; x < 448; x++)
+            if (pixels[(y * 512 + x) * 4] != 128)
+                bad++;
+    if (bad)
+        fprintf(stderr, "    coverage seed %d: %d pixels not blended exactly once\n", seed, bad);
+    return bad == 0;
+}
+
+int main(int argc, char ** argv)
+{
+    int threads = argc > 1 ? atoi(argv[1]) : 0;
+    int frames = argc > 2 ? atoi(argv[2]) : 200;
+    const char* output = argc > 3 ? argv[3] : nullptr;
+    if (frames <= 2)
+        return -1;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.f / 60.f;
+    io.IniFilename = nullptr;
+    ImGui_ImplSoft_Init(threads);
+    ImGui_ImplSoft_NewFrame();
+
+    unsigned int white_pixel = 0xFFFFFFFF;
+    ImTextureSoft white = ImGui_ImplSoft_CreateTexture(&white_pixel, 1, 1, 4);
+    bool coverage_ok = true;
+    for (int seed = 0; seed < 4; seed++)
+        coverage_ok &= coverage_test(white, seed, seed & 1 ? 0.5f : 0.f);
+    ImGui_ImplSoft_DestroyTexture(&white);
+
+    // First frames settle the window layout
+    ImGui::ImMat target;
+    int64_t imgui_time = 0, clear_time = 0, render_time = 0, best_time = INT64_MAX;
+    int triangles = 0;
+    for (int f = 0; f < frames; f++)
+    {
+        int64_t t0 = now_usec();
+        ImGui_ImplSoft_NewFrame();
+        ImGui::NewFrame();
+        ImGui::ShowDemoWindow();
+        ImGui::SetNextWindowPos(ImVec2(950, 60), ImGuiCond_Always);
+        ImGui::ShowMetricsWindow();
+        ImGui::Render();
+        int64_t t1 = now_usec();
+        ImGui_ImplSoft_ClearScreen(target, io.DisplaySize, ImVec4(0.45f, 0.55f, 0.60f, 1.00f));
+        int64_t t2 = now_usec();
+        ImGui_ImplSoft_RenderDrawData(ImGui::GetDrawData(), target);
+        int64_t t3 = now_usec();
+        if (f < 2)
+            continue;
+        imgui_time += t1 - t0;
+        clear_time += t2 - t1;
+        render_time += t3 - t2;
+        if (t3 - t2 < best_time) best_time = t3 - t2;
+        triangles = ImGui::GetDrawData()->TotalIdxCount / 3;
+    }
+    const int n = frames - 2;
+    fprintf(stderr, "Software rasterizer, 1920x1080, %d threads, %d frames, %d triangles\n", ImGui_ImplSoft_GetThreadCount(), n, triangles);
+    fprintf(stderr, "    coverage    : %s\n", coverage_ok ? "OK" : "MISMATCH");
+    fprintf(stderr, "    imgui frame : %8.3f ms\n", imgui_time / 1000.0 / n);
+    fprintf(stderr, "    clear       : %8.3f ms\n", clear_time / 1000.0 / n);
+    fprintf(stderr, "    render      : %8.3f ms (best %.3f ms)\n", render_time / 1000.0 / n, best_time / 1000.0);
+    fprintf(stderr, "    total       : %8.1f fps\n", 1e6 * n / (double)(imgui_time + clear_time + render_time));
+    if (output)
+        ImGui::ImMatToFile(target, output);
+
+    ImGui_ImplSoft_Shutdown();
+    ImGui::DestroyContext();
+    return coverage_ok ? 0 : 1;
+}
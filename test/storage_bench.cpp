@@ -0,0 +1,122 @@
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Benchmark ImGuiStorage insertion and lookup, and the first frame of a window opening a big tree.
+// Build with IMGUI_STORAGE_HASHED ON and OFF to compare the hashed and the sorted storage.
+// Usage: storage_bench [keys] [tree_nodes]
+static inline int64_t now_usec()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Bijective mix (murmur3 finalizer), distinct inputs give distinct ids like the ones produced by GetID()
+static ImGuiID mix_id(ImU32 h)
+{
+    h ^= h >> 16; h *= 0x85EBCA6Bu;
+    h ^= h >> 13; h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static bool bench_storage(const char* name, const ImVector<ImGuiID>& keys, const ImVector<ImGuiID>& missing)
+{
+    ImGuiStorage storage;
+    int64_t t0 = now_usec();
+    for (int n = 0; n < keys.Size; n++)
+        storage.SetInt(keys[n], n);
+    int64_t t1 = now_usec();
+    int errors = 0;
+    for (int n = 0; n < keys.Size; n++)
+        errors += storage.GetInt(keys[n], -1) != n;
+    int64_t t2 = now_usec();
+    for (int n = 0; n < missing.Size; n++)
+        errors += storage.GetInt(missing[n], -1) != -1;
+    int64_t t3 = now_usec();
+    for (int n = 0; n < keys.Size; n++)
+        (*storage.GetIntRef(keys[n]))++;
+    int64_t t4 = now_usec();
+    for (int n = 0; n < keys.Size; n++)
+        errors += storage.GetInt(keys[n], -1) != n + 1;
+    errors += storage.Data.Size != keys.Size;
+
+    fprintf(stderr, "    %-10s: insert %8.2f ms, hit %6.2f ms, miss %6.2f ms, update %6.2f ms%s\n", name,
+        (t1 - t0) / 1000.0, (t2 - t1) / 1000.0, (t3 - t2) / 1000.0, (t4 - t3) / 1000.0, errors ? ", MISMATCH" : "");
+    return errors == 0;
+}
+
+// Every tree node stores its open state in the window storage the first time it is submitted
+static void bench_tree(int nodes)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.f / 60.f;
+    io.IniFilename = nullptr;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    int64_t frame_time[3] = {};
+    for (int f = 0; f < 3; f++)
+    {
+        int64_t t0 = now_usec();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(ImVec2(800, 1000));
+        ImGui::Begin("Inspector");
+        for (int n = 0; n < nodes; n += 10)
+        {
+            ImGui::SetNextItemOpen(true, ImGuiCond_Once);
+            if (ImGui::TreeNode((void*)(intptr_t)n, "Object %d", n))
+            {
+                for (int child = 1; child < 10; child++)
+                {
+                    ImGui::SetNextItemOpen((child & 1) != 0, ImGuiCond_Once);
+                    if (ImGui::TreeNode((void*)(intptr_t)(n + child), "Property %d", child))
+                        ImGui::TreePop();
+                }
+                ImGui::TreePop();
+            }
+        }
+        ImGui::End();
+        ImGui::Render();
+        frame_time[f] = now_usec() - t0;
+    }
+    fprintf(stderr, "    tree      : %d nodes, first frame %8.2f ms, next frames %6.2f ms, %d storage entries\n",
+        nodes, frame_time[0] / 1000.0, (frame_time[1] + frame_time[2]) / 2000.0, ImGui::FindWindowByName("Inspector")->StateStorage.Data.Size);
+    ImGui::DestroyContext();
+}
+
+int main(int argc, char ** argv)
+{
+    int count = argc > 1 ? atoi(argv[1]) : 100000;
+    int nodes = argc > 2 ? atoi(argv[2]) : 20000;
+    if (count <= 0)
+        return -1;
+
+    // Hashed ids, and indices like the ones stored by the selection
+    ImVector<ImGuiID> hashed, hashed_missing, indices, indices_missing;
+    for (int n = 0; n < count; n++)
+    {
+        hashed.push_back(mix_id((ImU32)n));
+        hashed_missing.push_back(mix_id((ImU32)(count + n)));
+        indices.push_back((ImGuiID)n);
+        indices_missing.push_back((ImGuiID)(count + n));
+    }
+
+#if IMGUI_STORAGE_HASHED
+    fprintf(stderr, "ImGuiStorage, hashed, %d keys\n", count);
+#else
+    fprintf(stderr, "ImGuiStorage, sorted, %d keys\n", count);
+#endif
+    bool ok = bench_storage("hashed ids", hashed, hashed_missing);
+    ok &= bench_storage("indices", indices, indices_missing);
+    if (nodes > 0)
+        bench_tree(nodes);
+    return ok ? 0 : 1;
+}
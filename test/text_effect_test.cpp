@@ -0,0 +1,110 @@
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <cstdio>
+#include <cstdlib>
+
+// Check the signed distance field glyphs of ImFontConfig::SDF and the vertices of ImDrawList::AddTextEffect().
+// Usage: text_effect_test [font_size]
+static int g_errors = 0;
+
+static void check(bool ok, const char* what)
+{
+    fprintf(stderr, "    %-52s: %s\n", what, ok ? "OK" : "FAILED");
+    g_errors += ok ? 0 : 1;
+}
+
+static int count_glyphs(const ImFont* font, const char* text)
+{
+    int count = 0;
+    for (const char* s = text; *s; s++)
+        if (const ImFontGlyph* glyph = font->FindGlyphNoFallback((ImWchar)*s))
+            count += glyph->Visible ? 1 : 0;
+    return count;
+}
+
+static int effect_vertices(ImDrawList* draw_list, const ImFont* font, float font_size, const ImDrawTextEffect& effect, const char* text, bool* sdf_uv)
+{
+    const int vtx_begin = draw_list->VtxBuffer.Size;
+    draw_list->AddTextEffect(font, font_size, ImVec2(100, 100), IM_COL32_WHITE, effect, text);
+    *sdf_uv = true;
+    for (int n = vtx_begin; n < draw_list->VtxBuffer.Size; n++)
+        *sdf_uv &= draw_list->VtxBuffer[n].uv.x >= 2.0f;
+    return draw_list->VtxBuffer.Size - vtx_begin;
+}
+
+int main(int argc, char ** argv)
+{
+    float font_size = argc > 1 ? (float)atof(argv[1]) : 32.0f;
+    if (font_size < 8.0f)
+        return -1;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.f / 60.f;
+    io.IniFilename = nullptr;
+    ImFontConfig font_cfg;
+    font_cfg.SizePixels = font_size;
+    ImFont* bitmap_font = io.Fonts->AddFontDefault(&font_cfg);
+    font_cfg.SDF = true;
+    ImFont* sdf_font = io.Fonts->AddFontDefault(&font_cfg);
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextSDF;
+    const int spread = io.Fonts->TexSDFSpread;
+
+    // Atlas: same advance, quads grown by the spread, inside above the 0.5 edge value, transparent border
+    fprintf(stderr, "SDF glyphs, %.0f px, spread %d, atlas %dx%d\n", font_size, spread, width, height);
+    const ImFontGlyph* bitmap_glyph = bitmap_font->FindGlyphNoFallback('H');
+    const ImFontGlyph* sdf_glyph = sdf_font->FindGlyphNoFallback('H');
+    if (!bitmap_glyph || !sdf_glyph)
+        return 1;
+    check(!bitmap_glyph->SDF && sdf_glyph->SDF, "glyph flags");
+    check(bitmap_glyph->AdvanceX == sdf_glyph->AdvanceX, "advance");
+    const float grow_x = (sdf_glyph->X1 - sdf_glyph->X0) - (bitmap_glyph->X1 - bitmap_glyph->X0);
+    const float grow_y = (sdf_glyph->Y1 - sdf_glyph->Y0) - (bitmap_glyph->Y1 - bitmap_glyph->Y0);
+    check(ImAbs(grow_y - spread * 2) <= 1.0f && ImAbs(grow_x - spread * 2) <= 1.0f, "quad size"); // the bitmap font may be oversampled
+    const int x0 = (int)(sdf_glyph->U0 * width + 0.5f), y0 = (int)(sdf_glyph->V0 * height + 0.5f);
+    const int x1 = (int)(sdf_glyph->U1 * width + 0.5f), y1 = (int)(sdf_glyph->V1 * height + 0.5f);
+    int border_max = 0;
+    for (int x = x0; x < x1; x++)
+        border_max = ImMax(border_max, (int)ImMax(pixels[x + y0 * width], pixels[x + (y1 - 1) * width]));
+    for (int y = y0; y < y1; y++)
+        border_max = ImMax(border_max, (int)ImMax(pixels[x0 + y * width], pixels[x1 - 1 + y * width]));
+    check(border_max < 32, "field fades out at the border");
+    int stem_max = 0; // left stem of the H, in the left half right of the margin
+    for (int x = x0 + spread; x < x0 + spread + ImMax(1, (x1 - x0 - spread * 2) / 2); x++)
+        stem_max = ImMax(stem_max, (int)pixels[x + (y0 + y1) / 2 * width]);
+    check(stem_max > 128, "glyph inside above the edge value");
+    check(pixels[(x0 + x1) / 2 + (y0 + spread / 2) * width] < 128, "field outside below the edge value");
+
+    // Vertices: one quad per glyph and per layer with SDF, offset copies without
+    ImGui::NewFrame();
+    ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+    const char* text = "Subtitle: The quick brown fox!";
+    ImDrawTextEffect effect;
+    effect.OutlineWidth = 2.0f;
+    effect.OutlineColor = IM_COL32_BLACK;
+    effect.ShadowOffset = ImVec2(2.0f, 2.0f);
+    effect.ShadowColor = IM_COL32(0, 0, 0, 128);
+    effect.GlowWidth = 4.0f;
+    effect.GlowColor = IM_COL32(255, 200, 0, 255);
+    const int glyphs = count_glyphs(sdf_font, text);
+    bool sdf_uv = false;
+    fprintf(stderr, "AddTextEffect, %d glyphs\n", glyphs);
+    check(effect_vertices(draw_list, sdf_font, font_size, ImDrawTextEffect(), text, &sdf_uv) == glyphs * 4 && sdf_uv, "SDF text");
+    check(effect_vertices(draw_list, sdf_font, font_size, effect, text, &sdf_uv) == glyphs * 4 * 4 && sdf_uv, "SDF glow, shadow, outline");
+    check(effect_vertices(draw_list, bitmap_font, font_size, effect, text, &sdf_uv) == glyphs * 4 * (1 + 4 + 1) && !sdf_uv, "bitmap shadow, outline");
+    effect.OutlineWidth = 4.0f;
+    check(effect_vertices(draw_list, bitmap_font, font_size, effect, text, &sdf_uv) == glyphs * 4 * (1 + 8 + 1), "bitmap shadow, wide outline");
+    draw_list->Flags &= ~ImDrawListFlags_AllowTextSDF;
+    check(effect_vertices(draw_list, sdf_font, font_size, effect, text, &sdf_uv) == glyphs * 4 * (1 + 8 + 1) && !sdf_uv, "SDF font, renderer without SDF");
+    ImGui::Render();
+
+    ImGui::DestroyContext();
+    fprintf(stderr, "%s\n", g_errors ? "FAILED" : "OK");
+    return g_errors ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Benchmark ImGuiTextFilter on a big log: PassFilter() per line, the threaded Filter() and its cached result.
+// Also checks the substring terms against the former ImStristr() filtering, the opt-in globs against regular expressions and appended lines.
+// Usage: text_filter_bench [lines] [threads]
+static inline int64_t now_usec()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::vector<std::string> g_lines;
+static int g_errors = 0;
+
+static void check(bool ok, const char* what)
+{
+    fprintf(stderr, "    %-52s: %s\n", what, ok ? "OK" : "FAILED");
+    g_errors += ok ? 0 : 1;
+}
+
+static const char* get_line(void* user_data, int idx, const char** out_text_end)
+{
+    const std::string& line = (*(const std::vector<std::string>*)user_data)[idx];
+    *out_text_end = line.c_str() + line.size();
+    return line.c_str();
+}
+
+// ImGuiTextFilter::PassFilter() before the compiled terms
+static bool reference_pass(const ImGuiTextFilter& filter, const char* text, const char* text_end)
+{
+    if (filter.Filters.Size == 0)
+        return true;
+    for (const ImGuiTextFilter::ImGuiTextRange& f : filter.Filters)
+    {
+        if (f.b == f.e)
+            continue;
+        if (f.b[0] == '-')
+        {
+            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
+                return false;
+        }
+        else if (ImStristr(text, text_end, f.b, f.e) != NULL)
+        {
+            return true;
+        }
+    }
+    return filter.CountGrep == 0;
+}
+
+static bool same_indices(const ImVector<int>& a, const ImVector<int>& b)
+{
+    return a.Size == b.Size && (a.Size == 0 || memcmp(a.Data, b.Data, a.size_in_bytes()) == 0);
+}
+
+static void bench(const char* filter_text, int threads)
+{
+    ImGuiTextFilter filter(filter_text);
+    filter.FilterThreads = threads;
+    const int count = (int)g_lines.size();
+
+    int64_t t0 = now_usec();
+    ImVector<int> reference;
+    for (int n = 0; n < count; n++)
+        if (reference_pass(filter, g_lines[n].c_str(), g_lines[n].c_str() + g_lines[n].size()))
+            reference.push_back(n);
+    int64_t reference_time = now_usec() - t0;
+
+    t0 = now_usec();
+    ImVector<int> pass;
+    for (int n = 0; n < count; n++)
+        if (filter.PassFilter(g_lines[n].c_str(), g_lines[n].c_str() + g_lines[n].size()))
+            pass.push_back(n);
+    int64_t pass_time = now_usec() - t0;
+
+    t0 = now_usec();
+    ImVector<int> indices;
+    bool computed = filter.Filter(count, get_line, &g_lines, &indices);
+    int64_t filter_time = now_usec() - t0;
+
+    t0 = now_usec();
+    bool cached = !filter.Filter(count, get_line, &g_lines, &indices);
+    int64_t cached_time = now_usec() - t0;
+
+    char what[128];
+    snprintf(what, sizeof(what), "\"%s\", %d lines", filter_text, indices.Size);
+    check(computed && cached && same_indices(pass, reference) && same_indices(indices, reference), what);
+    fprintf(stderr, "        ImStristr %8.2f ms, PassFilter %8.2f ms, Filter %8.2f ms, cached %8.3f ms\n",
+        reference_time / 1000.0, pass_time / 1000.0, filter_time / 1000.0, cached_time / 1000.0);
+}
+
+static bool same_result(const char* filter_text_a, const char* filter_text_b, int count)
+{
+    const int flags = ImGuiTextFilter::ImGuiTextFilterFlags_Glob | ImGuiTextFilter::ImGuiTextFilterFlags_Regex;
+    ImGuiTextFilter filter_a(filter_text_a, flags), filter_b(filter_text_b, flags);
+    ImVector<int> indices_a, indices_b;
+    filter_a.Filter(count, get_line, &g_lines, &indices_a);
+    filter_b.Filter(count, get_line, &g_lines, &indices_b);
+    return indices_a.Size > 0 && same_indices(indices_a, indices_b);
+}
+
+int main(int argc, char ** argv)
+{
+    int lines = argc > 1 ? atoi(argv[1]) : 1000000;
+    int threads = argc > 2 ? atoi(argv[2]) : 0;
+    if (lines < 1000)
+        return -1;
+
+    // The filter doesn't need a context, ImGuiTextFilter::Draw() does
+    static const char* levels[] = { "DEBUG", "INFO", "Warning", "ERROR" };
+    static const char* messages[] = { "decoded packet", "disk full", "cache miss", "d\xC3\xA9j\xC3\xA0 vu", "connection reset by peer" };
+    char line[256];
+    for (int n = 0; n < lines; n++)
+    {
+        snprintf(line, sizeof(line), "[%07d] %s worker %d: %s %d, pts %.3f, %s", n, levels[(n * 7) % 4], n % 8, messages[(n * 13) % 5], n * 3, n / 25.0,
+            n & 1 ? "key frame" : "delta frame");
+        g_lines.push_back(line);
+    }
+    fprintf(stderr, "ImGuiTextFilter, %d lines, %d threads\n", lines, threads);
+
+    bench("error", threads);
+    bench("ERROR,-disk", threads);
+    bench("worker 3, key", threads);
+    bench("-debug,-info", threads);
+    bench("D\xC3\xA9J\xC3\xA0 VU", threads);
+    bench("connection reset by peer", threads);
+    bench("no such text", threads);
+    bench("", threads);
+
+    // Globs and regular expressions, the regex is slow and runs on a part of the lines
+    const int count = ImMin(lines, 50000);
+    check(same_result("worker ?: *key", "/worker .: .*key/", count), "glob and regex");
+    check(same_result("-error,[00012*", "-/error/,/\\[00012/", count), "glob, exclude");
+    check(same_result("-info", "-/INFO/", count), "regex exclude");
+
+    ImGuiTextFilter invalid_regex("/[/", ImGuiTextFilter::ImGuiTextFilterFlags_Regex);
+    check(invalid_regex.Terms.Size == 1 && invalid_regex.Terms[0].Type == ImGuiTextFilter::ImGuiTextTermType_Substring && invalid_regex.PassFilter("a/[/b"), "invalid regex searched as text");
+
+    // Without flags, '*', '?' and "/expr/" are plain text as before
+    ImGuiTextFilter plain("what?,/src/,a*b");
+    bool all_substrings = plain.Terms.Size == 3;
+    for (const ImGuiTextFilter::ImGuiTextTerm& term : plain.Terms)
+        all_substrings &= term.Type == ImGuiTextFilter::ImGuiTextTermType_Substring;
+    check(all_substrings && plain.PassFilter("so WHAT?") && plain.PassFilter("/usr/src/imgui") && plain.PassFilter("a*b") && !plain.PassFilter("whats")
+        && !plain.PassFilter("usr src") && !plain.PassFilter("aab") && reference_pass(plain, "usr/src/imgui", "usr/src/imgui" + 13), "substrings by default");
+
+    // Copies, appended lines with the previous last line completed, version change
+    ImGuiTextFilter filter("error");
+    ImGuiTextFilter copy = filter;
+    ImVector<int> indices, full;
+    copy.Filter((int)g_lines.size(), get_line, &g_lines, &full);
+    const int half = lines / 2;
+    filter.Filter(half, get_line, &g_lines, &indices);
+    const std::string last_line = g_lines[half - 1];
+    g_lines[half - 1] += "ERROR";
+    bool appended = filter.Filter((int)g_lines.size(), get_line, &g_lines, &indices);
+    g_lines[half - 1] = last_line;
+    bool last_included = indices.contains(half - 1);
+    ImVector<int> expected = full;
+    indices.find_erase(half - 1);
+    expected.find_erase(half - 1);
+    check(appended && last_included && same_indices(indices, expected), "appended lines");
+    check(!filter.Filter((int)g_lines.size(), get_line, &g_lines, &indices) && filter.Filter((int)g_lines.size(), get_line, &g_lines, &indices, 1), "items version");
+    filter = copy;
+    check(filter.Filter((int)g_lines.size(), get_line, &g_lines, &indices) && same_indices(indices, full), "assignment");
+
+    fprintf(stderr, "%s\n", g_errors ? "FAILED" : "OK");
+    return g_errors ? 1 : 0;
+}
@@ -0,0 +1,238 @@
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Benchmark io.ConfigTextLayoutCache on a text heavy frame: a clipped log view, a table and wrapped text.
+// Then times CalcTextSize(), AddText() and wrapped AddText() calls on their own, the frame is too short to tell them apart.
+// Also checks that the cached layouts draw the same vertices and indices as the uncached text rendering.
+// Usage: text_layout_bench [frames] [log_lines]
+static inline int64_t now_usec()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ImVector<ImDrawVert> g_vtx;
+static ImVector<ImDrawIdx> g_idx;
+
+static void text_frame(int frame, int log_lines)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(900, 1000));
+    ImGui::Begin("Log");
+    ImGui::Text("Frame %d", frame % 10); // text changing every frame
+    ImGui::BeginChild("lines", ImVec2(320, 500), ImGuiChildFlags_Border); // log lines cross the clip rect
+    ImGuiListClipper clipper;
+    clipper.Begin(log_lines);
+    while (clipper.Step())
+        for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+            ImGui::Text("[%05d] worker %d: decoded packet %d, pts %.3f, %s", n, n % 8, n * 3, n / 25.0, n & 1 ? "key frame" : "delta frame");
+    ImGui::EndChild();
+    if (ImGui::BeginTable("table", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        for (int row = 0; row < 30; row++)
+        {
+            ImGui::TableNextRow();
+            for (int column = 0; column < 5; column++)
+            {
+                ImGui::TableSetColumnIndex(column);
+                ImGui::Text("Cell %d,%d \xC3\xA9t\xC3\xA9", row, column);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(910, 0));
+    ImGui::SetNextWindowSize(ImVec2(400, 600));
+    ImGui::Begin("Wrapped");
+    for (int n = 0; n < 8; n++)
+        ImGui::TextWrapped("Paragraph %d. The quick brown fox jumps over the lazy dog, lorem ipsum dolor sit amet, consectetur adipiscing elit.\nSecond line of the paragraph.", n);
+    ImGui::End();
+    ImGui::Render();
+}
+
+static void capture_draw_list(const ImDrawList* draw_list)
+{
+    for (const ImDrawVert& v : draw_list->VtxBuffer)
+        g_vtx.push_back(v);
+    for (ImDrawIdx i : draw_list->IdxBuffer)
+        g_idx.push_back(i);
+}
+
+static void capture()
+{
+    g_vtx.resize(0);
+    g_idx.resize(0);
+    for (ImDrawList* draw_list : ImGui::GetDrawData()->CmdLists)
+        capture_draw_list(draw_list);
+}
+
+// Labels and paragraphs drawn one under the other, the clip rect hides the second half of the paragraphs
+static std::vector<std::string> g_labels, g_paragraphs;
+
+enum TextCall { TextCall_CalcTextSize, TextCall_AddText, TextCall_AddTextWrapped, TextCall_COUNT };
+
+static void text_calls(ImDrawList* draw_list, int repeat, int64_t time[TextCall_COUNT])
+{
+    ImGui::NewFrame();
+    ImFont* font = ImGui::GetFont();
+    const float font_size = ImGui::GetFontSize();
+    const ImVec4 clip_rect(0.0f, 0.0f, 1920.0f, 600.0f);
+    float width = 0.0f;
+    for (int r = 0; r < repeat; r++)
+    {
+        draw_list->_ResetForNewFrame();
+        draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+        draw_list->PushClipRect(ImVec2(clip_rect.x, clip_rect.y), ImVec2(clip_rect.z, clip_rect.w));
+        int64_t t0 = now_usec();
+        for (const std::string& label : g_labels)
+            width += ImGui::CalcTextSize(label.c_str(), label.c_str() + label.size()).x;
+        int64_t t1 = now_usec();
+        float y = 0.0f;
+        for (const std::string& label : g_labels)
+        {
+            draw_list->AddText(font, font_size, ImVec2(10.0f, y), IM_COL32_WHITE, label.c_str(), label.c_str() + label.size());
+            y += font_size;
+        }
+        int64_t t2 = now_usec();
+        y = 0.0f;
+        for (const std::string& paragraph : g_paragraphs)
+        {
+            draw_list->AddText(font, font_size, ImVec2(800.0f, y), IM_COL32_WHITE, paragraph.c_str(), paragraph.c_str() + paragraph.size(), 300.0f, &clip_rect);
+            y += 150.0f;
+        }
+        int64_t t3 = now_usec();
+        if (r > 0) // the first calls of the frame build the layouts
+        {
+            time[TextCall_CalcTextSize] += t1 - t0;
+            time[TextCall_AddText] += t2 - t1;
+            time[TextCall_AddTextWrapped] += t3 - t2;
+        }
+    }
+    ImGui::Render();
+    if (width <= 0.0f)
+        fprintf(stderr, "    no text measured\n");
+}
+
+static bool compare(const ImVector<ImDrawVert>& vtx, const ImVector<ImDrawIdx>& idx)
+{
+    if (vtx.Size != g_vtx.Size || idx.Size != g_idx.Size)
+    {
+        fprintf(stderr, "    %d/%d vertices, %d/%d indices\n", vtx.Size, g_vtx.Size, idx.Size, g_idx.Size);
+        return false;
+    }
+    int bad = 0;
+    for (int n = 0; n < vtx.Size; n++)
+        if (fabsf(vtx[n].pos.x - g_vtx[n].pos.x) > 0.001f || fabsf(vtx[n].pos.y - g_vtx[n].pos.y) > 0.001f ||
+            vtx[n].uv.x != g_vtx[n].uv.x || vtx[n].uv.y != g_vtx[n].uv.y || vtx[n].col != g_vtx[n].col)
+            bad++;
+    for (int n = 0; n < idx.Size; n++)
+        bad += idx[n] != g_idx[n];
+    if (bad)
+        fprintf(stderr, "    %d mismatches\n", bad);
+    return bad == 0;
+}
+
+int main(int argc, char ** argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 200;
+    int log_lines = argc > 2 ? atoi(argv[2]) : 10000;
+    if (frames < 10)
+        return -1;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.f / 60.f;
+    io.IniFilename = nullptr;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    io.Fonts->SetTexID((ImTextureID)1);
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    // Same content every 10 frames, the first frames settle the layout
+    int64_t time[2] = {};
+    ImVector<ImDrawVert> vtx;
+    ImVector<ImDrawIdx> idx;
+    int frame = 0;
+    for (int cached = 0; cached < 2; cached++)
+    {
+        io.ConfigTextLayoutCache = cached != 0;
+        for (int f = 0; f < 10; f++)
+            text_frame(frame++, log_lines);
+        for (int f = 0; f < frames; f++)
+        {
+            int64_t t0 = now_usec();
+            text_frame(frame++, log_lines);
+            time[cached] += now_usec() - t0;
+        }
+        while (frame % 10 != 0)
+            text_frame(frame++, log_lines);
+        text_frame(frame++, log_lines);
+        capture();
+        if (!cached)
+        {
+            vtx = g_vtx;
+            idx = g_idx;
+        }
+    }
+    bool ok = compare(vtx, idx);
+    const ImGuiTextLayoutCache& cache = ImGui::GetCurrentContext()->TextLayoutCache;
+    const int layouts = cache.Layouts.GetAliveCount(), hits = cache.LastFrameHits, misses = cache.LastFrameMisses;
+
+    // The calls on their own, a text is cached from the frame after it was first seen
+    char text[256];
+    for (int n = 0; n < 200; n++)
+    {
+        snprintf(text, sizeof(text), "[%05d] worker %d: decoded packet %d, pts %.3f, %s", n, n % 8, n * 3, n / 25.0, n & 1 ? "key frame" : "delta frame");
+        g_labels.push_back(text);
+    }
+    for (int n = 0; n < 8; n++)
+    {
+        snprintf(text, sizeof(text), "Paragraph %d. The quick brown fox jumps over the lazy dog, lorem ipsum dolor sit amet, consectetur adipiscing elit.\n"
+            "Second line of the paragraph, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.", n);
+        g_paragraphs.push_back(text);
+    }
+    const int repeat = ImMax(frames / 4, 10);
+    int64_t call_time[2][TextCall_COUNT] = {};
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    ImVector<ImDrawVert> call_vtx;
+    ImVector<ImDrawIdx> call_idx;
+    for (int cached = 0; cached < 2; cached++)
+    {
+        io.ConfigTextLayoutCache = cached != 0;
+        int64_t warm_up[TextCall_COUNT] = {};
+        text_calls(&draw_list, 2, warm_up);
+        text_calls(&draw_list, repeat, call_time[cached]);
+        g_vtx.resize(0);
+        g_idx.resize(0);
+        capture_draw_list(&draw_list);
+        if (!cached)
+        {
+            call_vtx = g_vtx;
+            call_idx = g_idx;
+        }
+    }
+    bool calls_ok = compare(call_vtx, call_idx);
+    draw_list._ClearFreeMemory();
+
+    fprintf(stderr, "Text layout cache, %d frames, %d log lines, %d vertices\n", frames, log_lines, vtx.Size);
+    fprintf(stderr, "    output   : %s\n", ok ? "OK" : "MISMATCH");
+    fprintf(stderr, "    uncached : %8.3f ms/frame\n", time[0] / 1000.0 / frames);
+    fprintf(stderr, "    cached   : %8.3f ms/frame, %d layouts, %d hits, %d misses last frame\n", time[1] / 1000.0 / frames, layouts, hits, misses);
+    static const char* call_names[TextCall_COUNT] = { "CalcTextSize", "AddText", "AddText wrapped" };
+    fprintf(stderr, "Text calls, %d labels, %d paragraphs, %d times\n", (int)g_labels.size(), (int)g_paragraphs.size(), repeat - 1);
+    fprintf(stderr, "    output   : %s\n", calls_ok ? "OK" : "MISMATCH");
+    for (int call = 0; call < TextCall_COUNT; call++)
+        fprintf(stderr, "    %-16s: uncached %8.3f ms, cached %8.3f ms\n", call_names[call], call_time[0][call] / 1000.0 / (repeat - 1), call_time[1][call] / 1000.0 / (repeat - 1));
+    ImGui::DestroyContext();
+    return ok && calls_ok ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+#include <ThreadUtils.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+// Benchmark SysUtils::ThreadPoolExecutor with tiny tasks.
+// Usage: threadpool_bench [tasks] [threads]
+static inline int64_t now_usec()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class TinyTask : public SysUtils::BaseAsyncTask
+{
+public:
+    TinyTask(std::atomic<int64_t>* pCounter) : m_pCounter(pCounter) {}
+
+protected:
+    bool _TaskProc() override
+    {
+        m_pCounter->fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    std::atomic<int64_t>* m_pCounter;
+};
+
+class SleepTask : public SysUtils::BaseAsyncTask
+{
+protected:
+    bool _TaskProc() override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return true;
+    }
+};
+
+int main(int argc, char ** argv)
+{
+    int tasks = argc > 1 ? atoi(argv[1]) : 1000000;
+    int threads = argc > 2 ? atoi(argv[2]) : 0;
+    if (tasks <= 0)
+        return -1;
+    auto hPool = SysUtils::ThreadPoolExecutor::CreateInstance("BenchPool");
+    hPool->SetMaxThreadCount(threads);
+    hPool->SetMinThreadCount(threads);
+    hPool->SetMaxWaitingTaskCount(0);
+    std::atomic<int64_t> counter{0};
+
+    // throughput, enqueue all then wait for the last one
+    std::vector<SysUtils::AsyncTask::Holder> aTasks(tasks);
+    for (auto& hTask : aTasks)
+        hTask = SysUtils::AsyncTask::Holder(new TinyTask(&counter));
+    int64_t t = now_usec();
+    for (auto& hTask : aTasks)
+        hPool->EnqueueTask(hTask);
+    for (auto& hTask : aTasks)
+        hTask->WaitDone();
+    int64_t throughput_time = now_usec() - t;
+    aTasks.clear();
+
+    // latency, one task in flight at a time
+    const int rounds = std::min(tasks, 10000);
+    t = now_usec();
+    for (int i = 0; i < rounds; i++)
+    {
+        SysUtils::AsyncTask::Holder hTask(new TinyTask(&counter));
+        hPool->EnqueueTask(hTask);
+        hTask->WaitDone();
+    }
+    int64_t latency_time = now_usec() - t;
+
+    // continuation chain, every task waits for the previous one
+    SysUtils::AsyncTask::Holder hPrev(new TinyTask(&counter));
+    t = now_usec();
+    hPool->EnqueueTask(hPrev);
+    for (int i = 1; i < rounds; i++)
+    {
+        SysUtils::AsyncTask::Holder hTask(new TinyTask(&counter));
+        hPool->EnqueueTaskAfter(hTask, {hPrev});
+        hPrev = hTask;
+    }
+    hPrev->WaitDone();
+    int64_t chain_time = now_usec() - t;
+    hPool->Terminate(true);
+
+    // terminate without waiting, the queued tasks are cancelled
+    auto hStopPool = SysUtils::ThreadPoolExecutor::CreateInstance("StopPool");
+    hStopPool->SetMaxThreadCount(1);
+    SysUtils::AsyncTask::Holder hSleep(new SleepTask());
+    hStopPool->EnqueueTask(hSleep);
+    hSleep->WaitState(SysUtils::AsyncTask::PROCESSING, 1000);
+    std::vector<SysUtils::AsyncTask::Holder> aQueued(100);
+    for (auto& hTask : aQueued)
+    {
+        hTask = SysUtils::AsyncTask::Holder(new TinyTask(&counter));
+        hStopPool->EnqueueTask(hTask);
+    }
+    hStopPool->Terminate(false);
+    int cancelled = 0;
+    for (auto& hTask : aQueued)
+        cancelled += hTask->IsCancelled() ? 1 : 0;
+
+    const int64_t expected = (int64_t)tasks + rounds * 2;
+    fprintf(stderr, "ThreadPoolExecutor, %d threads\n", threads);
+    fprintf(stderr, "    throughput : %d tasks in %10.3f ms, %.0f tasks/s\n", tasks, throughput_time / 1000.f, tasks * 1e6 / std::max<int64_t>(throughput_time, 1));
+    fprintf(stderr, "    latency    : %10.3f us per enqueue and wait\n", (float)latency_time / rounds);
+    fprintf(stderr, "    chain      : %10.3f us per continuation\n", (float)chain_time / rounds);
+    fprintf(stderr, "    executed   : %lld of %lld\n", (long long)counter.load(), (long long)expected);
+    fprintf(stderr, "    terminate  : %d of %d queued tasks cancelled\n", cancelled, (int)aQueued.size());
+    return counter.load() == expected && cancelled == (int)aQueued.size() ? 0 : 1;
+}
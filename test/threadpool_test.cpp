@@ -0,0 +1,128 @@
+#include <ThreadUtils.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <thread>
+#include <vector>
+
+// Check SysUtils::ThreadPoolExecutor termination: queued tasks cancelled by Terminate(false), dependent tasks released
+// by a dependency finishing while the pool terminates, and dependent tasks run by Terminate(true).
+// Usage: threadpool_test [rounds]
+static int g_errors = 0;
+
+static void check(bool ok, const char* what)
+{
+    fprintf(stderr, "    %-52s: %s\n", what, ok ? "OK" : "FAILED");
+    g_errors += ok ? 0 : 1;
+}
+
+class SpinTask : public SysUtils::BaseAsyncTask
+{
+public:
+    SpinTask(int iSpinUs, std::atomic<int>* pCounter) : m_iSpinUs(iSpinUs), m_pCounter(pCounter) {}
+
+protected:
+    bool _TaskProc() override
+    {
+        const auto tEnd = std::chrono::steady_clock::now() + std::chrono::microseconds(m_iSpinUs);
+        while (std::chrono::steady_clock::now() < tEnd)
+            std::this_thread::yield();
+        m_pCounter->fetch_add(1);
+        return true;
+    }
+
+private:
+    int m_iSpinUs;
+    std::atomic<int>* m_pCounter;
+};
+
+// Wait in another thread, a task that is never run nor cancelled is reported instead of hanging the test
+static bool stopped_within(const std::vector<SysUtils::AsyncTask::Holder>& aTasks, int seconds)
+{
+    auto stopped = std::async(std::launch::async, [&aTasks] {
+        for (auto& hTask : aTasks)
+            hTask->WaitDone();
+    });
+    if (stopped.wait_for(std::chrono::seconds(seconds)) == std::future_status::ready)
+        return true;
+    fprintf(stderr, "    a task was neither run nor cancelled\n");
+    fflush(stderr);
+    _Exit(1);
+}
+
+int main(int argc, char ** argv)
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 200;
+    if (rounds <= 0)
+        return -1;
+    fprintf(stderr, "ThreadPoolExecutor termination, %d rounds\n", rounds);
+    std::atomic<int> counter{0};
+
+    // Terminate(false) cancels the queued tasks
+    {
+        auto hPool = SysUtils::ThreadPoolExecutor::CreateInstance("TestPool");
+        hPool->SetMaxThreadCount(1);
+        std::vector<SysUtils::AsyncTask::Holder> aTasks;
+        for (int i = 0; i < 100; i++)
+        {
+            aTasks.push_back(SysUtils::AsyncTask::Holder(new SpinTask(1000, &counter)));
+            hPool->EnqueueTask(aTasks.back());
+        }
+        hPool->Terminate(false);
+        int cancelled = 0;
+        for (auto& hTask : aTasks)
+            cancelled += hTask->IsCancelled() ? 1 : 0;
+        check(stopped_within(aTasks, 10) && cancelled >= 90, "queued tasks cancelled");
+    }
+
+    // A dependency finishing on a worker while Terminate(false) runs: its dependent tasks are run or cancelled
+    int run = 0, cancelled = 0;
+    for (int round = 0; round < rounds; round++)
+    {
+        auto hPool = SysUtils::ThreadPoolExecutor::CreateInstance("TestPool");
+        hPool->SetMaxThreadCount(2);
+        SysUtils::AsyncTask::Holder hDependency(new SpinTask(round % 50, &counter));
+        std::vector<SysUtils::AsyncTask::Holder> aTasks;
+        for (int i = 0; i < 8; i++)
+        {
+            aTasks.push_back(SysUtils::AsyncTask::Holder(new SpinTask(0, &counter)));
+            hPool->EnqueueTaskAfter(aTasks.back(), { hDependency });
+        }
+        hPool->EnqueueTask(hDependency);
+        hPool->Terminate(false);
+        aTasks.push_back(hDependency);
+        stopped_within(aTasks, 10);
+        for (auto& hTask : aTasks)
+        {
+            run += hTask->IsDone() ? 1 : 0;
+            cancelled += hTask->IsCancelled() ? 1 : 0;
+        }
+    }
+    fprintf(stderr, "    %d tasks run, %d cancelled\n", run, cancelled);
+    check(run + cancelled == rounds * 9, "dependent tasks run or cancelled");
+
+    // Terminate(true) runs the dependent tasks released while it waits
+    {
+        auto hPool = SysUtils::ThreadPoolExecutor::CreateInstance("TestPool");
+        hPool->SetMaxThreadCount(2);
+        SysUtils::AsyncTask::Holder hDependency(new SpinTask(20000, &counter));
+        std::vector<SysUtils::AsyncTask::Holder> aTasks;
+        for (int i = 0; i < 8; i++)
+        {
+            aTasks.push_back(SysUtils::AsyncTask::Holder(new SpinTask(0, &counter)));
+            hPool->EnqueueTaskAfter(aTasks.back(), { hDependency });
+        }
+        hPool->EnqueueTask(hDependency);
+        hPool->Terminate(true);
+        int done = 0;
+        for (auto& hTask : aTasks)
+            done += hTask->IsDone() ? 1 : 0;
+        check(stopped_within(aTasks, 10) && done == 8, "dependent tasks run by Terminate(true)");
+        check(!hPool->EnqueueTask(SysUtils::AsyncTask::Holder(new SpinTask(0, &counter))), "no task queued after Terminate()");
+    }
+
+    fprintf(stderr, "%s\n", g_errors ? "FAILED" : "OK");
+    return g_errors ? 1 : 0;
+}